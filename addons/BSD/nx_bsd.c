@@ -3524,6 +3524,7 @@ USHORT               peer_port = 0;
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    nx_tcp_socket_data_receive            Copy TCP data to buffer       */
 /*    nx_tcp_socket_receive                 Receive a Packet              */
 /*    nx_packet_allocate                    Allocate packet for receive   */
 /*    nx_packet_release                     Free the nx_packet after use  */
@@ -3544,6 +3545,9 @@ USHORT               peer_port = 0;
 /*  09-30-2020     Yuxin Zhou               Modified comment(s), and      */
 /*                                            verified memcpy use cases,  */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), copied   */
+/*                                            TCP data across packets,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 INT  recv(INT sockID, VOID *rcvBuffer, INT bufferLength, INT flags)
@@ -3683,9 +3687,33 @@ ULONG               start_time = nx_bsd_system_clock;
             /* Determine if this is a TCP BSD socket.  */
             if (tcp_socket_ptr)
             {
-            
-                /* It is, check the socket TCP receive queue with a zero wait option (no suspension).  */
-                status =  nx_tcp_socket_receive(tcp_socket_ptr, &packet_ptr, TX_NO_WAIT);
+
+                /* Determine if the data is to be consumed into a buffer.  */
+                if (((flags & MSG_PEEK) == 0) && (bufferLength > 0))
+                {
+
+                    /* Yes, copy the data straight from the TCP receive queue with a zero wait option
+                       (no suspension).  Data that does not fit stays on the receive queue.  */
+                    status =  nx_tcp_socket_data_receive(tcp_socket_ptr, rcvBuffer, (ULONG)bufferLength, &bytes_received, TX_NO_WAIT);
+
+                    /* Check for received data.  */
+                    if (status == NX_SUCCESS)
+                    {
+
+                        /* Release the protection mutex.  */
+                        tx_mutex_put(nx_bsd_protection_ptr);
+
+                        /* Return the number of bytes copied to buffer.  */
+                        return((INT)bytes_received);
+                    }
+                }
+                else
+                {
+
+                    /* No, check the socket TCP receive queue with a zero wait option (no suspension).
+                       The packet is kept by the BSD socket until its data is consumed.  */
+                    status =  nx_tcp_socket_receive(tcp_socket_ptr, &packet_ptr, TX_NO_WAIT);
+                }
                 
                 /* Check for no packet on the queue.  */
                 if (status == NX_NOT_CONNECTED)
@@ -5714,6 +5742,7 @@ ULONG           ticks;
 /*                                                                        */  
 /*  CALLS                                                                 */  
 /*                                                                        */
+/*    _nx_tcp_socket_keepalive_set          Set socket keepalive          */
 /*    tx_mutex_get                          Get protection                */
 /*    tx_mutex_put                          Release protection            */ 
 /*                                                                        */  
@@ -5728,6 +5757,10 @@ ULONG           ticks;
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), updated  */
+/*                                            keepalive through the TCP   */
+/*                                            timer wheel, resulting in   */
+/*                                            version 6.x                 */
 /*                                                                        */
 /**************************************************************************/
 INT  setsockopt(INT sockID, INT option_level, INT option_name, const VOID *option_value, INT option_length)
@@ -5843,21 +5876,8 @@ UINT            status;
                 /* Determine if NetX supports keepalive. */
 
                 /* Update the BSD socket with this attribute. */
-                bsd_socket_ptr -> nx_bsd_socket_tcp_socket -> nx_tcp_socket_keepalive_enabled = 
-                                        (UINT)(((struct sock_keepalive *)option_value) -> keepalive_enabled);
-
-                if (bsd_socket_ptr -> nx_bsd_socket_tcp_socket -> nx_tcp_socket_keepalive_enabled == NX_TRUE)
-                {
-
-                    /* Set the keep alive timeout for this socket with the NetX configurable keep alive timeout. */
-                    bsd_socket_ptr -> nx_bsd_socket_tcp_socket -> nx_tcp_socket_keepalive_timeout =  NX_TCP_KEEPALIVE_INITIAL;
-                }
-                else
-                {
-
-                    /* Clear the socket keep alive timeout. */
-                    bsd_socket_ptr -> nx_bsd_socket_tcp_socket -> nx_tcp_socket_keepalive_timeout =  0;
-                }
+                _nx_tcp_socket_keepalive_set(bsd_socket_ptr -> nx_bsd_socket_tcp_socket,
+                                             (UINT)(((struct sock_keepalive *)option_value) -> keepalive_enabled));
 #endif /* NX_ENABLE_TCP_KEEPALIVE */
             }
             else
@@ -6602,7 +6622,7 @@ struct sockaddr_in  *soc_struct_ptr = NX_NULL;
 /*    FD_ZERO                               Clear a socket ready list     */
 /*    FD_ISSET                              Check a socket is ready       */
 /*    FD_SET                                Set a socket to check         */ 
-/*    nx_tcp_socket_receive                 Receive TCP packet            */ 
+/*    nx_tcp_socket_bytes_available         Check for TCP data            */ 
 /*    nx_udp_source_extract                 Extract source IP and port    */ 
 /*    tx_event_flags_get                    Get events                    */ 
 /*    tx_mutex_get                          Get protection                */ 
@@ -6621,6 +6641,9 @@ struct sockaddr_in  *soc_struct_ptr = NX_NULL;
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), left TCP */
+/*                                            data on the receive queue,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 INT  select(INT nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds, struct timeval *timeout)
@@ -6629,7 +6652,7 @@ INT  select(INT nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds, stru
 INT                     i;
 UINT                    status;
 NX_BSD_SOCKET_SUSPEND   suspend_request;
-NX_PACKET               *packet_ptr;
+ULONG                   bytes_available;
 fd_set                  readfds_found;
 fd_set                  writefds_found;
 fd_set                  exceptfds_found;
@@ -6800,23 +6823,14 @@ INT                     ret;
                 else if(nx_bsd_socket_array[i].nx_bsd_socket_status_flags & NX_BSD_SOCKET_CONNECTED)
                 {
 
-                    /* Yes; attempt to perform a non-blocking read.  */
-                    status =  nx_tcp_socket_receive(nx_bsd_socket_array[i].nx_bsd_socket_tcp_socket, &packet_ptr, TX_NO_WAIT);
+                    /* Yes; check for data on the TCP receive queue.  The data stays on the queue
+                       for recv to copy.  */
+                    status =  nx_tcp_socket_bytes_available(nx_bsd_socket_array[i].nx_bsd_socket_tcp_socket, &bytes_available);
 
-                    /* Check for success.  */
-                    if (status == NX_SUCCESS)
+                    /* Check for data.  */
+                    if ((status == NX_SUCCESS) && (bytes_available))
                     {
 
-                        /* Save the received packet in the TCP BSD socket packet pointer.  */
-                        nx_bsd_socket_array[i].nx_bsd_socket_received_packet =  packet_ptr;
-                    
-                        /* Reset the packet offset.  */
-                        nx_bsd_socket_array[i].nx_bsd_socket_received_packet_offset =  0;
-
-                        /* Increase the received count. */
-                        nx_bsd_socket_array[i].nx_bsd_socket_received_byte_count += packet_ptr -> nx_packet_length;
-                        nx_bsd_socket_array[i].nx_bsd_socket_received_packet_count++;
-
                         /* Add this socket to the read ready list.  */
                         FD_SET(i + NX_BSD_SOCKFD_START, &readfds_found);
                     }
@@ -9598,6 +9612,9 @@ NX_PACKET          *packet_ptr = NX_NULL;
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), cloned   */
+/*                                            packets when enabled,       */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 static VOID  _nx_bsd_hardware_packet_received(NX_PACKET *packet_ptr, UCHAR *consumed)
@@ -9638,7 +9655,11 @@ NX_BSD_SOCKET *bsd_ptr;
 
 #ifndef NX_DISABLE_BSD_RAW_PACKET_DUPLICATE
     /* Duplicate the packet. */
+#ifdef NX_ENABLE_PACKET_CLONE
+    if (nx_packet_clone(packet_ptr, &packet_ptr, nx_bsd_default_packet_pool, NX_NO_WAIT) != NX_SUCCESS)
+#else
     if (nx_packet_copy(packet_ptr, &packet_ptr, nx_bsd_default_packet_pool, NX_NO_WAIT) != NX_SUCCESS)
+#endif /* NX_ENABLE_PACKET_CLONE */
     {
         return;
     }
@@ -408,6 +408,74 @@ VOID _nx_trace_event_update(TX_TRACE_BUFFER_ENTRY *event, ULONG timestamp, ULONG
 #endif /* NX_PACKET_HEADER_PAD_SIZE */
 #endif /* NX_PACKET_HEADER_PAD */
 
+/* If NX_ENABLE_PACKET_POOL_CACHE is defined, define the number of per-thread packet caches of
+   each packet pool and the number of packets each cache holds.  */
+
+#ifdef NX_ENABLE_PACKET_POOL_CACHE
+#ifndef NX_PACKET_POOL_CACHE_COUNT
+#define NX_PACKET_POOL_CACHE_COUNT 4
+#endif /* NX_PACKET_POOL_CACHE_COUNT */
+
+#ifndef NX_PACKET_POOL_CACHE_SIZE
+#define NX_PACKET_POOL_CACHE_SIZE 16
+#endif /* NX_PACKET_POOL_CACHE_SIZE */
+#endif /* NX_ENABLE_PACKET_POOL_CACHE */
+
+/* If NX_ENABLE_IP_RECEIVE_RING is defined, define the number of packets each receive ring of
+   an IP instance holds, which must be a power of two, and the memory barrier that orders the
+   accesses of the driver and the IP helper thread to a ring.  Ports that run NetX on more than
+   one core with a compiler that is not GCC compatible must define the barrier.  */
+
+#ifdef NX_ENABLE_IP_RECEIVE_RING
+#ifndef NX_IP_RECEIVE_RING_SIZE
+#define NX_IP_RECEIVE_RING_SIZE 64
+#endif /* NX_IP_RECEIVE_RING_SIZE */
+
+#if (NX_IP_RECEIVE_RING_SIZE & (NX_IP_RECEIVE_RING_SIZE - 1))
+#error "NX_IP_RECEIVE_RING_SIZE must be a power of two."
+#endif
+
+#ifndef NX_IP_RECEIVE_RING_BARRIER
+#ifdef __GNUC__
+#define NX_IP_RECEIVE_RING_BARRIER __sync_synchronize();
+#else
+#define NX_IP_RECEIVE_RING_BARRIER
+#endif /* __GNUC__ */
+#endif /* NX_IP_RECEIVE_RING_BARRIER */
+#endif /* NX_ENABLE_IP_RECEIVE_RING */
+
+/* If NX_ENABLE_IP_FRAGMENT_HASH is defined, define the number of buckets of the fragment
+   re-assembly hash table, which must be a power of two, the number of datagrams each IP
+   instance re-assembles at the same time, the number of fragments it holds overall and from
+   one source, and the number of periodic events after which an incomplete datagram is
+   discarded.  */
+
+#ifdef NX_ENABLE_IP_FRAGMENT_HASH
+#ifndef NX_IP_FRAGMENT_HASH_SIZE
+#define NX_IP_FRAGMENT_HASH_SIZE 16
+#endif /* NX_IP_FRAGMENT_HASH_SIZE */
+
+#if (NX_IP_FRAGMENT_HASH_SIZE & (NX_IP_FRAGMENT_HASH_SIZE - 1))
+#error "NX_IP_FRAGMENT_HASH_SIZE must be a power of two."
+#endif
+
+#ifndef NX_IP_FRAGMENT_MAX_ASSEMBLIES
+#define NX_IP_FRAGMENT_MAX_ASSEMBLIES 8
+#endif /* NX_IP_FRAGMENT_MAX_ASSEMBLIES */
+
+#ifndef NX_IP_FRAGMENT_MAX_PACKETS
+#define NX_IP_FRAGMENT_MAX_PACKETS 64
+#endif /* NX_IP_FRAGMENT_MAX_PACKETS */
+
+#ifndef NX_IP_FRAGMENT_MAX_SOURCE_PACKETS
+#define NX_IP_FRAGMENT_MAX_SOURCE_PACKETS 32
+#endif /* NX_IP_FRAGMENT_MAX_SOURCE_PACKETS */
+
+#ifndef NX_IP_FRAGMENT_TIMEOUT
+#define NX_IP_FRAGMENT_TIMEOUT 2
+#endif /* NX_IP_FRAGMENT_TIMEOUT */
+#endif /* NX_ENABLE_IP_FRAGMENT_HASH */
+
 /* Define basic constants for the NetX TCP/IP Stack.  */
 #define AZURE_RTOS_NETX
 #define NETX_MAJOR_VERSION        6
@@ -493,10 +561,69 @@ VOID _nx_trace_event_update(TX_TRACE_BUFFER_ENTRY *event, ULONG timestamp, ULONG
 #endif
 
 
+/* If NX_ENABLE_ARP_PENDING_QUEUE is defined, define the total number of packets that can be queued
+   while waiting for ARP resolution of any IP address.  Zero means half of the packets of the
+   default packet pool.  Define the interval in ticks of the first ARP retransmit of a new entry and
+   the number of such retransmits, each sent after twice the previous interval, before the retries
+   fall back to the periodic ARP update.  */
+
+#ifdef NX_ENABLE_ARP_PENDING_QUEUE
+#ifndef NX_ARP_PENDING_PACKETS_MAXIMUM
+#define NX_ARP_PENDING_PACKETS_MAXIMUM 0
+#endif /* NX_ARP_PENDING_PACKETS_MAXIMUM */
+
+#ifndef NX_ARP_RETRANSMIT_INTERVAL
+#define NX_ARP_RETRANSMIT_INTERVAL ((NX_IP_PERIODIC_RATE / 4) ? (NX_IP_PERIODIC_RATE / 4) : 1)
+#endif /* NX_ARP_RETRANSMIT_INTERVAL */
+
+#ifndef NX_ARP_RETRANSMIT_MAXIMUM
+#define NX_ARP_RETRANSMIT_MAXIMUM 3
+#endif /* NX_ARP_RETRANSMIT_MAXIMUM */
+#endif /* NX_ENABLE_ARP_PENDING_QUEUE */
+
+
+/* If NX_ENABLE_ARP_CACHE_HASH is defined, define the number of slots in the ARP timer wheel.
+   Each slot is one second.  Entries whose timer expires beyond the wheel are revisited once
+   per revolution.  The value must be a power of two.  */
+
+#ifdef NX_ENABLE_ARP_CACHE_HASH
+#ifndef NX_ARP_TIMER_WHEEL_SIZE
+#define NX_ARP_TIMER_WHEEL_SIZE   64
+#endif /* NX_ARP_TIMER_WHEEL_SIZE */
+#define NX_ARP_TIMER_WHEEL_MASK   (NX_ARP_TIMER_WHEEL_SIZE - 1)
+
+#if (NX_ARP_TIMER_WHEEL_SIZE & NX_ARP_TIMER_WHEEL_MASK)
+#error "NX_ARP_TIMER_WHEEL_SIZE must be a power of two."
+#endif
+#endif /* NX_ENABLE_ARP_CACHE_HASH */
+
+
+/* If NX_ENABLE_IP_ROUTE_TRIE is defined, static routes are kept in a prefix trie.  This
+   requires static routing.  */
+
+#ifdef NX_ENABLE_IP_ROUTE_TRIE
+#ifndef NX_ENABLE_IP_STATIC_ROUTING
+#define NX_ENABLE_IP_STATIC_ROUTING
+#endif /* NX_ENABLE_IP_STATIC_ROUTING */
+#endif /* NX_ENABLE_IP_ROUTE_TRIE */
+
 #ifndef NX_IP_ROUTING_TABLE_SIZE
 #define NX_IP_ROUTING_TABLE_SIZE  8
 #endif /* NX_IP_ROUTING_TABLE_SIZE */
 
+/* If NX_ENABLE_IP_ROUTE_TRIE is defined, define the number of entries of the cache of recent
+   destinations and their routes, which must be a power of two.  */
+
+#ifdef NX_ENABLE_IP_ROUTE_TRIE
+#ifndef NX_IP_ROUTE_CACHE_SIZE
+#define NX_IP_ROUTE_CACHE_SIZE    16
+#endif /* NX_IP_ROUTE_CACHE_SIZE */
+
+#if (NX_IP_ROUTE_CACHE_SIZE & (NX_IP_ROUTE_CACHE_SIZE - 1))
+#error "NX_IP_ROUTE_CACHE_SIZE must be a power of two."
+#endif
+#endif /* NX_ENABLE_IP_ROUTE_TRIE */
+
 
 #ifdef NX_ENABLE_EXTENDED_NOTIFY_SUPPORT
 #ifdef NX_DISABLE_EXTENDED_NOTIFY_SUPPORT
@@ -507,6 +634,28 @@ VOID _nx_trace_event_update(TX_TRACE_BUFFER_ENTRY *event, ULONG timestamp, ULONG
 #endif /* !NX_ENABLE_EXTENDED_NOTIFY_SUPPORT */
 
 
+/* Zero copy send references the application buffers through packet clones.  */
+#ifdef NX_ENABLE_ZERO_COPY_SEND
+#ifndef NX_ENABLE_PACKET_CLONE
+#define NX_ENABLE_PACKET_CLONE
+#endif /* NX_ENABLE_PACKET_CLONE */
+#endif /* NX_ENABLE_ZERO_COPY_SEND */
+
+/* TCP receive coalescing marks the segments it verified through the packet capability flags.  */
+#ifdef NX_ENABLE_TCP_GRO
+#ifndef NX_ENABLE_INTERFACE_CAPABILITY
+#define NX_ENABLE_INTERFACE_CAPABILITY
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+#endif /* NX_ENABLE_TCP_GRO */
+
+/* Generic segmentation offload builds TCP super-segments, which need the packet capability fields.  */
+#ifdef NX_ENABLE_TCP_GSO
+#ifndef NX_ENABLE_INTERFACE_CAPABILITY
+#define NX_ENABLE_INTERFACE_CAPABILITY
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+#endif /* NX_ENABLE_TCP_GSO */
+
+
 /* For backward compatibility, convert map NX_ARP_MAC_CHANGE_NOTIFICATION_ENABLE to NX_ENABLE_ARP_MAC_CHANGE_NOTIFICATION */
 #ifdef NX_ARP_MAC_CHANGE_NOTIFICATION_ENABLE
 #ifndef NX_ENABLE_ARP_MAC_CHANGE_NOTIFICATION
@@ -638,6 +787,21 @@ VOID _nx_trace_event_update(TX_TRACE_BUFFER_ENTRY *event, ULONG timestamp, ULONG
 #define NX_UDP_PORT_TABLE_SIZE       32
 #define NX_UDP_PORT_TABLE_MASK       (NX_UDP_PORT_TABLE_SIZE - 1)
 
+#ifdef NX_ENABLE_UDP_PORT_CACHE
+
+/* Define the size of the exact match cache of UDP sockets, indexed by port.  The value
+   must be a power of two, so subtracting one gives us the mask.  */
+
+#ifndef NX_UDP_PORT_CACHE_SIZE
+#define NX_UDP_PORT_CACHE_SIZE       256
+#endif
+#define NX_UDP_PORT_CACHE_MASK       (NX_UDP_PORT_CACHE_SIZE - 1)
+
+#if (NX_UDP_PORT_CACHE_SIZE & (NX_UDP_PORT_CACHE_SIZE - 1))
+#error "NX_UDP_PORT_CACHE_SIZE must be a power of two."
+#endif
+#endif /* NX_ENABLE_UDP_PORT_CACHE */
+
 
 /* Define the constants that determine how big the hash table is for TCP ports.  The
    value must be a power of two, so subtracting one gives us the mask.  */
@@ -646,6 +810,65 @@ VOID _nx_trace_event_update(TX_TRACE_BUFFER_ENTRY *event, ULONG timestamp, ULONG
 #define NX_TCP_PORT_TABLE_MASK       (NX_TCP_PORT_TABLE_SIZE - 1)
 
 
+/* Define the default number of buckets in the hash table used to find the socket of an
+   established TCP connection from the local port, peer IP address and peer port.  The
+   value must be a power of two.  A larger table can be supplied at run time with
+   nx_tcp_connection_table_resize.  */
+
+#ifndef NX_TCP_CONNECTION_TABLE_SIZE
+#define NX_TCP_CONNECTION_TABLE_SIZE 64
+#endif
+
+
+/* Define the number of buckets in the hash table of active TCP listen requests.  The
+   value must be a power of two, so subtracting one gives us the mask.  */
+
+#ifndef NX_TCP_LISTEN_TABLE_SIZE
+#define NX_TCP_LISTEN_TABLE_SIZE     16
+#endif
+#define NX_TCP_LISTEN_TABLE_MASK     (NX_TCP_LISTEN_TABLE_SIZE - 1)
+
+
+/* Define the number of slots in the TCP timer wheel.  Each slot is one period of the
+   fast TCP timer.  Sockets whose next timer expires beyond the wheel are revisited once
+   per revolution.  The value must be a power of two.  */
+
+#ifndef NX_TCP_TIMER_WHEEL_SIZE
+#define NX_TCP_TIMER_WHEEL_SIZE      256
+#endif
+#define NX_TCP_TIMER_WHEEL_MASK      (NX_TCP_TIMER_WHEEL_SIZE - 1)
+
+
+/* Define the number of ranges of data acknowledged selectively by the peer that each TCP
+   socket remembers when NX_ENABLE_TCP_SACK is defined.  */
+
+#ifndef NX_TCP_SACK_SCOREBOARD_SIZE
+#define NX_TCP_SACK_SCOREBOARD_SIZE  8
+#endif
+
+
+/* Define the number of runs of contiguous out-of-order data that the reassembly index of
+   each TCP socket holds when NX_ENABLE_TCP_REASSEMBLY_INDEX is defined.  Each run holds at
+   least one out-of-order packet, and the receive queue holds at most
+   NX_TCP_MAX_OUT_OF_ORDER_PACKETS of them plus the packet being placed, so the index never
+   overflows.  */
+
+#ifdef NX_ENABLE_TCP_REASSEMBLY_INDEX
+#ifndef NX_TCP_MAX_OUT_OF_ORDER_PACKETS
+#error "NX_TCP_MAX_OUT_OF_ORDER_PACKETS must be defined to use NX_ENABLE_TCP_REASSEMBLY_INDEX."
+#endif /* NX_TCP_MAX_OUT_OF_ORDER_PACKETS */
+#define NX_TCP_REASSEMBLY_INDEX_SIZE (NX_TCP_MAX_OUT_OF_ORDER_PACKETS + 1)
+#endif /* NX_ENABLE_TCP_REASSEMBLY_INDEX */
+
+
+/* Define the number of ULONG words of per-socket state available to the TCP congestion
+   control algorithm.  The CUBIC algorithm needs 6 words.  */
+
+#ifndef NX_TCP_CONGESTION_CONTROL_DATA_SIZE
+#define NX_TCP_CONGESTION_CONTROL_DATA_SIZE 8
+#endif
+
+
 /* Define the maximum number of multicast groups the system can support.  This might
    be further limited by the underlying physical hardware.  */
 
@@ -690,6 +913,15 @@ VOID _nx_trace_event_update(TX_TRACE_BUFFER_ENTRY *event, ULONG timestamp, ULONG
 #define NX_TCP_LAST_ACK              11             /* Last ACK state               */
 
 
+/* Define the events passed to the TCP congestion control algorithm.  */
+
+#define NX_TCP_CONGESTION_CONTROL_INIT    1         /* Algorithm takes over socket  */
+#define NX_TCP_CONGESTION_CONTROL_ACK     2         /* New data acknowledged        */
+#define NX_TCP_CONGESTION_CONTROL_LOSS    3         /* Fast retransmit of a loss    */
+#define NX_TCP_CONGESTION_CONTROL_TIMEOUT 4         /* Retransmission timeout       */
+#define NX_TCP_CONGESTION_CONTROL_IDLE    5         /* Send after all data is ACKed */
+
+
 /* API return values.  */
 
 #define NX_SUCCESS                   0x00
@@ -779,9 +1011,23 @@ VOID _nx_trace_event_update(TX_TRACE_BUFFER_ENTRY *event, ULONG timestamp, ULONG
 #define NX_LINK_UNINITIALIZE         17
 #define NX_LINK_DEFERRED_PROCESSING  18
 #define NX_LINK_INTERFACE_ATTACH     19
+#define NX_LINK_GET_CAPABILITY       20
 #define NX_LINK_USER_COMMAND         50     /* Values after this value are reserved for application.  */
 
 
+/* Define the interface capability flags.  A link driver reports the work its hardware can take over from
+   NetX in response to the NX_LINK_GET_CAPABILITY command.  The same flags are recorded in a packet for
+   the checksums NetX left for the hardware to compute.  */
+
+#define NX_INTERFACE_CAPABILITY_IPV4_TX_CHECKSUM    0x00000001  /* IPv4 header checksum on transmit   */
+#define NX_INTERFACE_CAPABILITY_IPV4_RX_CHECKSUM    0x00000002  /* IPv4 header checksum on receive    */
+#define NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM     0x00000004  /* TCP checksum on transmit           */
+#define NX_INTERFACE_CAPABILITY_TCP_RX_CHECKSUM     0x00000008  /* TCP checksum on receive            */
+#define NX_INTERFACE_CAPABILITY_UDP_TX_CHECKSUM     0x00000010  /* UDP checksum on transmit           */
+#define NX_INTERFACE_CAPABILITY_UDP_RX_CHECKSUM     0x00000020  /* UDP checksum on receive            */
+#define NX_INTERFACE_CAPABILITY_TCP_SEGMENTATION    0x00000100  /* TCP segmentation offload (TSO)     */
+
+
 /* Define the macro for building IP addresses.  */
 
 #define IP_ADDRESS(a, b, c, d)       ((((ULONG)a) << 24) | (((ULONG)b) << 16) | (((ULONG)c) << 8) | ((ULONG)d))
@@ -848,6 +1094,35 @@ typedef  struct NX_PACKET_STRUCT
     /* Define the pointer to the byte after the last character written in the buffer.  */
     UCHAR *nx_packet_append_ptr;
 
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+    /* Define the checksums NetX left for the link driver to compute.  On receive, define the
+       checksums already verified.  */
+    ULONG nx_packet_interface_capability_flag;
+
+    /* Define the segment size the link driver uses to split a TCP packet larger than the
+       MTU.  Zero means the packet is not a TCP super-segment.  */
+    ULONG nx_packet_tcp_segment_size;
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
+#ifdef NX_ENABLE_PACKET_CLONE
+    /* Define the packet that owns the data buffer this packet references, or NULL if this
+       packet uses its own data buffer.  */
+    struct NX_PACKET_STRUCT
+        *nx_packet_clone_source;
+
+    /* Define the number of references to the data buffer of this packet while it is shared
+       with clones: one for this packet and one for each clone.  Zero means not shared.  */
+    ULONG nx_packet_reference_count;
+#endif /* NX_ENABLE_PACKET_CLONE */
+
+#ifdef NX_ENABLE_ZERO_COPY_SEND
+    /* Define the application function called when this packet is released, and its context.
+       This is set on the packet that owns application buffers referenced by a zero copy send,
+       which is released when the last packet referencing the buffers is released.  */
+    VOID (*nx_packet_release_notify)(VOID *context);
+    VOID  *nx_packet_release_context;
+#endif /* NX_ENABLE_ZERO_COPY_SEND */
+
 #ifdef NX_PACKET_HEADER_PAD
 
     /* Define a pad word for 16-byte alignment, if necessary.  */
@@ -856,6 +1131,42 @@ typedef  struct NX_PACKET_STRUCT
 } NX_PACKET;
 
 
+/* Define the descriptor of an application buffer sent without copying it into packets.  */
+
+typedef struct NX_PACKET_VECTOR_STRUCT
+{
+
+    /* Define the start and the length of the buffer.  */
+    VOID *nx_packet_vector_data;
+    ULONG nx_packet_vector_length;
+} NX_PACKET_VECTOR;
+
+
+#ifdef NX_ENABLE_PACKET_POOL_CACHE
+
+/* Define the per-thread packet cache.  A cache is owned by one thread, which is the
+   only one that takes packets from and returns packets to its list, so the list is
+   accessed without disabling interrupts.  Packets move between the cache and the
+   available list of the pool in batches.  */
+
+typedef struct NX_PACKET_POOL_CACHE_STRUCT
+{
+
+    /* Define the thread that owns this cache, NULL if the cache is unused.  */
+    TX_THREAD *nx_packet_pool_cache_thread;
+
+    /* Define the list of free packets in this cache, linked by nx_packet_next.  */
+    struct NX_PACKET_STRUCT
+        *nx_packet_pool_cache_list;
+    ULONG nx_packet_pool_cache_count;
+
+    /* Define statistics for this cache.  */
+    ULONG nx_packet_pool_cache_hits;
+    ULONG nx_packet_pool_cache_misses;
+} NX_PACKET_POOL_CACHE;
+#endif /* NX_ENABLE_PACKET_POOL_CACHE */
+
+
 /* Define the Packet Pool control block that will be used to manage each individual
    packet pool.  */
 
@@ -896,6 +1207,11 @@ typedef struct NX_PACKET_POOL_STRUCT
     TX_THREAD *nx_packet_pool_suspension_list;
     ULONG      nx_packet_pool_suspended_count;
 
+#ifdef NX_ENABLE_PACKET_POOL_CACHE
+    /* Define the per-thread packet caches.  */
+    NX_PACKET_POOL_CACHE nx_packet_pool_cache[NX_PACKET_POOL_CACHE_COUNT];
+#endif /* NX_ENABLE_PACKET_POOL_CACHE */
+
     /* Define the created list next and previous pointers.  */
     struct NX_PACKET_POOL_STRUCT
         *nx_packet_pool_created_next,
@@ -952,6 +1268,26 @@ typedef struct NX_ARP_STRUCT
        the oldest packet is discarded in favor of keeping the newer packet.  */
     struct NX_PACKET_STRUCT
         *nx_arp_packets_waiting;
+
+#ifdef NX_ENABLE_ARP_CACHE_HASH
+    /* Define the state of a dynamic entry: incomplete, reachable, stale or probe.  */
+    UINT nx_arp_state;
+
+    /* Define the links and the second of the ARP timer wheel slot this entry is on.
+       The update counter above then holds the seconds left after that slot.  */
+    struct NX_ARP_STRUCT
+        *nx_arp_timer_next,
+        *nx_arp_timer_previous;
+    ULONG nx_arp_timer_expiration;
+#endif /* NX_ENABLE_ARP_CACHE_HASH */
+
+#ifdef NX_ENABLE_ARP_PENDING_QUEUE
+    /* Define the number of packets queued on this entry, the number of fast ARP
+       retransmits left and the time the next one is due.  */
+    UINT  nx_arp_packets_queued;
+    UINT  nx_arp_retransmit_remaining;
+    ULONG nx_arp_retransmit_time;
+#endif /* NX_ENABLE_ARP_PENDING_QUEUE */
 } NX_ARP;
 
 
@@ -1045,6 +1381,50 @@ typedef struct NX_UDP_SOCKET_STRUCT
 } NX_UDP_SOCKET;
 
 
+/* Define the entry returned for each datagram by a UDP socket batch receive.  */
+
+typedef struct NX_UDP_RECEIVE_ENTRY_STRUCT
+{
+
+    /* Define the received datagram, with the prepend pointer at the UDP payload.  */
+    NX_PACKET *nx_udp_receive_entry_packet;
+
+    /* Define the source IP address and source port of the datagram.  */
+    ULONG nx_udp_receive_entry_source_ip;
+    UINT  nx_udp_receive_entry_source_port;
+
+    /* Define the index of the interface the datagram was received on.  */
+    UINT  nx_udp_receive_entry_interface_index;
+} NX_UDP_RECEIVE_ENTRY;
+
+
+#ifdef NX_ENABLE_TCP_SACK
+/* Define the TCP selective acknowledgment block.  A block covers the sequence numbers from
+   the begin sequence up to, but not including, the end sequence.  */
+
+typedef struct NX_TCP_SACK_BLOCK_STRUCT
+{
+    ULONG nx_tcp_sack_block_begin;
+    ULONG nx_tcp_sack_block_end;
+} NX_TCP_SACK_BLOCK;
+#endif /* NX_ENABLE_TCP_SACK */
+
+
+#ifdef NX_ENABLE_TCP_REASSEMBLY_INDEX
+/* Define the TCP reassembly index entry.  An entry describes a run of contiguous out-of-order
+   packets on the receive queue, from the begin sequence up to, but not including, the end
+   sequence, along with the first and last packets of the run.  */
+
+typedef struct NX_TCP_REASSEMBLY_RANGE_STRUCT
+{
+    ULONG      nx_tcp_reassembly_range_begin;
+    ULONG      nx_tcp_reassembly_range_end;
+    NX_PACKET *nx_tcp_reassembly_range_first;
+    NX_PACKET *nx_tcp_reassembly_range_last;
+} NX_TCP_REASSEMBLY_RANGE;
+#endif /* NX_ENABLE_TCP_REASSEMBLY_INDEX */
+
+
 /* Define the basic TCP socket structure.  This structure is used to manage all information
    necessary to manage TCP transmission and reception.  */
 
@@ -1117,6 +1497,13 @@ typedef struct NX_TCP_SOCKET_STRUCT
     /* Counter for duplicated ACK  */
     UINT nx_tcp_socket_duplicated_ack_received;
 
+    /* Define the TCP congestion control algorithm of this socket and its private state.
+       The algorithm is called with an event when new data is acknowledged, on loss, on
+       retransmission timeout and when sending resumes after all data is acknowledged.  It
+       owns the slow start threshold and, outside of loss recovery, the congestion window.  */
+    VOID (*nx_tcp_socket_congestion_control)(struct NX_TCP_SOCKET_STRUCT *socket_ptr, UINT event, ULONG acked_bytes);
+    ULONG nx_tcp_socket_congestion_control_data[NX_TCP_CONGESTION_CONTROL_DATA_SIZE];
+
     /* Define the window size fields of the TCP socket structure.  */
     ULONG nx_tcp_socket_rx_window_default;
     ULONG nx_tcp_socket_rx_window_current;
@@ -1149,6 +1536,17 @@ typedef struct NX_TCP_SOCKET_STRUCT
     NX_PACKET *nx_tcp_socket_receive_queue_head,
               *nx_tcp_socket_receive_queue_tail;
 
+#ifdef NX_ENABLE_TCP_REASSEMBLY_INDEX
+    /* Define the TCP reassembly index.  The index holds, in sequence order, the runs of
+       out-of-order packets on the receive queue, so an incoming segment finds its place
+       without searching the queue.  The previous pointer is the last in-order packet
+       ahead of the first run, if it is still queued.  */
+    NX_TCP_REASSEMBLY_RANGE
+               nx_tcp_socket_reassembly_index[NX_TCP_REASSEMBLY_INDEX_SIZE];
+    UINT       nx_tcp_socket_reassembly_count;
+    NX_PACKET *nx_tcp_socket_reassembly_previous;
+#endif /* NX_ENABLE_TCP_REASSEMBLY_INDEX */
+
     /* Define the TCP packet sent queue. This queue is used to keep track of the
        transmit packets already send.  Before they can be released we need to receive
        an ACK back from the other end of the connection.  If no ACK is received, the
@@ -1167,6 +1565,31 @@ typedef struct NX_TCP_SOCKET_STRUCT
     ULONG nx_tcp_socket_timeout_max_retries;
     ULONG nx_tcp_socket_timeout_shift;
 
+#ifdef NX_ENABLE_TCP_RTT_ESTIMATION
+    /* Define the TCP round-trip time estimator (RFC 6298).  The smoothed round-trip time
+       is kept scaled by 8 and the round-trip time variation scaled by 4, both in timer
+       ticks.  When the sample is active, the segment ending at the sample sequence was
+       sent at the sample time and has not been retransmitted.  The timeout rate is
+       recomputed from the estimator and restored from the default for each new
+       connection.  */
+    ULONG nx_tcp_socket_rtt_srtt;
+    ULONG nx_tcp_socket_rtt_rttvar;
+    ULONG nx_tcp_socket_rtt_sequence;
+    ULONG nx_tcp_socket_rtt_time;
+    UINT  nx_tcp_socket_rtt_active;
+    ULONG nx_tcp_socket_timeout_rate_default;
+#endif /* NX_ENABLE_TCP_RTT_ESTIMATION */
+
+#ifdef NX_ENABLE_TCP_SEND_COALESCING
+    /* Define the data held back to be sent with later data in fewer, larger segments, and
+       the send coalescing options of the socket.  The coalesced counts are the application
+       packets, and their bytes, merged into data held back instead of sent on their own.  */
+    NX_PACKET *nx_tcp_socket_coalesce_packet;
+    UINT       nx_tcp_socket_coalesce_options;
+    ULONG      nx_tcp_socket_coalesced_packets;
+    ULONG      nx_tcp_socket_coalesced_bytes;
+#endif /* NX_ENABLE_TCP_SEND_COALESCING */
+
 #ifdef NX_ENABLE_TCP_WINDOW_SCALING
     /* Local receive window size, when user creates the TCP socket. */
     ULONG nx_tcp_socket_rx_window_maximum;
@@ -1178,10 +1601,35 @@ typedef struct NX_TCP_SOCKET_STRUCT
     ULONG nx_tcp_snd_win_scale_value;
 #endif /* NX_ENABLE_TCP_WINDOW_SCALING */
 
+#ifdef NX_ENABLE_TCP_SACK
+    /* Define the TCP selective acknowledgment (RFC 2018) parameters.  SACK is used only if
+       the peer offered it in its SYN.  The recent sequence is the start of the last
+       out-of-order segment received, reported first in the SACK option.  The scoreboard
+       holds, in sequence order, the data the peer has acknowledged selectively, and the
+       retransmit sequence is the end of the data already retransmitted in the current
+       recovery.  */
+    UINT  nx_tcp_socket_sack_permitted;
+    ULONG nx_tcp_socket_sack_recent;
+    ULONG nx_tcp_socket_sack_retransmit_sequence;
+    UINT  nx_tcp_socket_sack_count;
+    NX_TCP_SACK_BLOCK
+          nx_tcp_socket_sack_scoreboard[NX_TCP_SACK_SCOREBOARD_SIZE];
+#endif /* NX_ENABLE_TCP_SACK */
+
     /* Define the TCP keepalive timer parameters.  If enabled with NX_ENABLE_TCP_KEEPALIVE,
        these parameters are used to implement the keepalive timer.  */
     ULONG nx_tcp_socket_keepalive_timeout;
     ULONG nx_tcp_socket_keepalive_retries;
+    ULONG nx_tcp_socket_keepalive_ticks;
+
+    /* Define the TCP timer wheel list.  These pointers are used to manage the list of
+       TCP sockets whose next timer expires on the same wheel slot.  The timer tick is
+       the fast timer tick the socket timers were last aged to.  */
+    struct NX_TCP_SOCKET_STRUCT
+        *nx_tcp_socket_timer_next,
+        *nx_tcp_socket_timer_previous;
+    ULONG nx_tcp_socket_timer_expiration;
+    ULONG nx_tcp_socket_timer_tick;
 
     /* Define the TCP socket bound list.  These pointers are used to manage the list
        of TCP sockets on a particular hashed port index.  */
@@ -1189,6 +1637,13 @@ typedef struct NX_TCP_SOCKET_STRUCT
         *nx_tcp_socket_bound_next,
         *nx_tcp_socket_bound_previous;
 
+    /* Define the TCP socket connection list.  These pointers are used to manage the list
+       of connected TCP sockets on a particular hashed connection index.  */
+    struct NX_TCP_SOCKET_STRUCT
+        *nx_tcp_socket_connection_next,
+        *nx_tcp_socket_connection_previous;
+    ULONG nx_tcp_socket_connection_index;
+
     /* Define the TCP socket bind suspension thread pointer.  This pointer points
        to the thread that that is suspended attempting to bind to a port that is
        already bound to another socket.  */
@@ -1226,6 +1681,15 @@ typedef struct NX_TCP_SOCKET_STRUCT
         *nx_tcp_socket_created_next,
         *nx_tcp_socket_created_previous;
 
+#ifdef NX_ENABLE_TCP_LISTEN_POOL
+    /* Define the listen request whose pool the socket was added to, until the socket is
+       accepted, and the link to the next idle or established socket of that pool.  */
+    struct NX_TCP_LISTEN_STRUCT
+        *nx_tcp_socket_listen_pool;
+    struct NX_TCP_SOCKET_STRUCT
+        *nx_tcp_socket_listen_pool_next;
+#endif /* NX_ENABLE_TCP_LISTEN_POOL */
+
     /* Define the callback function for urgent data reception.  This is for future use.  */
     VOID (*nx_tcp_urgent_data_callback)(struct NX_TCP_SOCKET_STRUCT *socket_ptr);
 
@@ -1296,10 +1760,27 @@ typedef struct NX_TCP_LISTEN_STRUCT
     NX_PACKET *nx_tcp_listen_queue_head,
               *nx_tcp_listen_queue_tail;
 
+#ifdef NX_ENABLE_TCP_LISTEN_POOL
+    /* Define the pool of idle server sockets.  When the listen socket takes a connection
+       request, the next idle socket becomes the listen socket.  Pooled sockets whose
+       connections are established wait on the accept queue until they are accepted.  */
+    NX_TCP_SOCKET
+        *nx_tcp_listen_pool_head;
+    ULONG nx_tcp_listen_pool_count;
+    NX_TCP_SOCKET
+        *nx_tcp_listen_accept_head,
+        *nx_tcp_listen_accept_tail;
+    ULONG nx_tcp_listen_accept_count;
+#endif /* NX_ENABLE_TCP_LISTEN_POOL */
+
     /* Define the link between other TCP listen structures created by the application.  */
     struct NX_TCP_LISTEN_STRUCT
         *nx_tcp_listen_next,
         *nx_tcp_listen_previous;
+
+    /* Define the link to the next active listen request on the same hashed port index.  */
+    struct NX_TCP_LISTEN_STRUCT
+        *nx_tcp_listen_hash_next;
 } NX_TCP_LISTEN;
 
 struct NX_IP_DRIVER_STRUCT;
@@ -1381,6 +1862,11 @@ typedef struct NX_INTERFACE_STRUCT
        pointer results in NetX calling it when an IP address is found in an incoming
        ARP packet that matches that of nx_interface_ip_probe_address.  */
     VOID        (*nx_interface_ip_conflict_notify_handler)(struct NX_IP_STRUCT *, UINT, ULONG, ULONG, ULONG);
+
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+    /* Define the offload capabilities reported by the link driver.  */
+    ULONG nx_interface_capability_flag;
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
 } NX_INTERFACE;
 
 #ifdef NX_ENABLE_IP_STATIC_ROUTING
@@ -1398,9 +1884,108 @@ typedef struct NX_IP_ROUTING_ENTRY_STRUCT
 
     struct NX_INTERFACE_STRUCT
         *nx_ip_routing_entry_ip_interface;
+
+#ifdef NX_ENABLE_IP_ROUTE_TRIE
+    /* Metric of the route, lower values are preferred.  */
+    ULONG nx_ip_routing_entry_metric;
+
+    /* Next route to the same network, in metric order, or next available entry.  */
+    struct NX_IP_ROUTING_ENTRY_STRUCT
+        *nx_ip_routing_entry_next;
+#endif /* NX_ENABLE_IP_ROUTE_TRIE */
 } NX_IP_ROUTING_ENTRY;
 #endif /*  NX_ENABLE_IP_STATIC_ROUTING */
 
+#ifdef NX_ENABLE_IP_ROUTE_TRIE
+/* Define the static routing trie node structure.  A node holds a network prefix and the
+   routes to it, if any.  Nodes without routes only branch.  The child selected by the bit
+   that follows the prefix holds the longer prefixes under it.  */
+typedef struct NX_IP_ROUTE_NODE_STRUCT
+{
+    /* Network prefix and its length in bits, in host byte order.  */
+    ULONG nx_ip_route_node_prefix;
+    ULONG nx_ip_route_node_length;
+
+    /* Routes to this prefix, lowest metric first.  */
+    NX_IP_ROUTING_ENTRY *nx_ip_route_node_routes;
+
+    /* Children for the next bit clear and set.  The first also links available nodes.  */
+    struct NX_IP_ROUTE_NODE_STRUCT
+        *nx_ip_route_node_child[2];
+} NX_IP_ROUTE_NODE;
+
+/* Define the static route cache entry structure.  An entry is valid as long as its
+   generation matches the generation of the routing table.  */
+typedef struct NX_IP_ROUTE_CACHE_ENTRY_STRUCT
+{
+    ULONG                nx_ip_route_cache_destination;
+    ULONG                nx_ip_route_cache_generation;
+    NX_IP_ROUTING_ENTRY *nx_ip_route_cache_route;
+} NX_IP_ROUTE_CACHE_ENTRY;
+#endif /* NX_ENABLE_IP_ROUTE_TRIE */
+
+
+#ifdef NX_ENABLE_IP_RECEIVE_RING
+/* Define the IP receive ring structure.  A ring passes received packets from one driver
+   context to the IP helper thread without disabling interrupts.  Only the driver advances
+   the producer index and only the IP helper thread advances the consumer index.  Both
+   indexes run freely and are masked with the ring size to address a slot.  */
+
+typedef struct NX_IP_RECEIVE_RING_STRUCT
+{
+
+    /* Define the slots of the ring.  */
+    NX_PACKET *nx_ip_receive_ring_packets[NX_IP_RECEIVE_RING_SIZE];
+
+    /* Define the producer and consumer indexes.  */
+    volatile ULONG nx_ip_receive_ring_producer;
+    volatile ULONG nx_ip_receive_ring_consumer;
+
+    /* Define the number of packets dropped because the ring was full.  */
+    ULONG nx_ip_receive_ring_overflows;
+} NX_IP_RECEIVE_RING;
+#endif /* NX_ENABLE_IP_RECEIVE_RING */
+
+
+#ifdef NX_ENABLE_IP_FRAGMENT_HASH
+/* Define the IP fragment re-assembly structure.  A structure describes one datagram being
+   re-assembled.  Its fragments are kept in offset order on the nx_packet_fragment_next list
+   and do not overlap, so the datagram is complete once the payload bytes received equal the
+   payload length given by the last fragment.  */
+
+typedef struct NX_IP_FRAGMENT_ASSEMBLY_STRUCT
+{
+
+    /* Define the datagram key: source and destination addresses, and the IP header ID in
+       the upper 16 bits along with the protocol in the lower 8 bits.  */
+    ULONG nx_ip_fragment_assembly_source_ip;
+    ULONG nx_ip_fragment_assembly_destination_ip;
+    ULONG nx_ip_fragment_assembly_id;
+
+    /* Define the first and last fragments, in offset order.  */
+    NX_PACKET *nx_ip_fragment_assembly_first;
+    NX_PACKET *nx_ip_fragment_assembly_last;
+
+    /* Define the payload bytes received, and the payload length of the datagram, which is
+       zero until the last fragment arrives.  */
+    ULONG nx_ip_fragment_assembly_received;
+    ULONG nx_ip_fragment_assembly_length;
+
+    /* Define the number of fragments held and the source budget they are charged to.  */
+    ULONG nx_ip_fragment_assembly_packets;
+    UINT  nx_ip_fragment_assembly_source_index;
+
+    /* Define the periodic event count when the first fragment arrived.  */
+    ULONG nx_ip_fragment_assembly_start;
+
+    /* Define the links of the hash bucket list and of the list in arrival order.  */
+    struct NX_IP_FRAGMENT_ASSEMBLY_STRUCT
+        *nx_ip_fragment_assembly_hash_next,
+        *nx_ip_fragment_assembly_older,
+        *nx_ip_fragment_assembly_newer;
+} NX_IP_FRAGMENT_ASSEMBLY;
+#endif /* NX_ENABLE_IP_FRAGMENT_HASH */
+
 
 /* Define the Internet Protocol (IP) structure.  Any number of IP instances
    may be used by the application.  */
@@ -1464,6 +2049,14 @@ typedef struct NX_IP_STRUCT
     ULONG nx_ip_arp_aged_entries;
     ULONG nx_ip_arp_invalid_messages;
     ULONG nx_ip_arp_static_entries;
+#ifdef NX_ENABLE_ARP_CACHE_HASH
+    ULONG nx_ip_arp_cache_hits;
+    ULONG nx_ip_arp_cache_misses;
+    ULONG nx_ip_arp_cache_evictions;
+#endif /* NX_ENABLE_ARP_CACHE_HASH */
+#ifdef NX_ENABLE_ARP_PENDING_QUEUE
+    ULONG nx_ip_arp_resolution_drops;
+#endif /* NX_ENABLE_ARP_PENDING_QUEUE */
     ULONG nx_ip_udp_packets_sent;
     ULONG nx_ip_udp_bytes_sent;
     ULONG nx_ip_udp_packets_received;
@@ -1487,6 +2080,16 @@ typedef struct NX_IP_STRUCT
     ULONG nx_ip_tcp_retransmit_packets;
     ULONG nx_ip_tcp_resets_received;
     ULONG nx_ip_tcp_resets_sent;
+#ifdef NX_ENABLE_TCP_GRO
+    ULONG nx_ip_tcp_gro_segments_merged;
+#endif /* NX_ENABLE_TCP_GRO */
+#ifdef NX_ENABLE_TCP_GSO
+    ULONG nx_ip_tcp_gso_segments_sent;
+#endif /* NX_ENABLE_TCP_GSO */
+#ifdef NX_ENABLE_TCP_SEND_COALESCING
+    ULONG nx_ip_tcp_coalesced_packets;
+    ULONG nx_ip_tcp_coalesced_bytes;
+#endif /* NX_ENABLE_TCP_SEND_COALESCING */
     ULONG nx_ip_icmp_total_messages_received;
     ULONG nx_ip_icmp_checksum_errors;
     ULONG nx_ip_icmp_invalid_packets;
@@ -1532,6 +2135,11 @@ typedef struct NX_IP_STRUCT
     NX_PACKET *nx_ip_driver_deferred_packet_head,
               *nx_ip_driver_deferred_packet_tail;
 
+#if defined(NX_ENABLE_IP_RECEIVE_RING) && defined(NX_DRIVER_DEFERRED_PROCESSING)
+    /* Define the ring used instead of the Link Driver hardware deferred packet queue.  */
+    NX_IP_RECEIVE_RING nx_ip_driver_deferred_ring;
+#endif /* NX_ENABLE_IP_RECEIVE_RING && NX_DRIVER_DEFERRED_PROCESSING */
+
     /* Define the Link Driver hardware deferred packet processing routine.  If the driver
        deferred processing is enabled, this routine is called from the IP helper thread.  */
     VOID (*nx_ip_driver_deferred_packet_handler)(struct NX_IP_STRUCT *, NX_PACKET *);
@@ -1541,6 +2149,11 @@ typedef struct NX_IP_STRUCT
     NX_PACKET *nx_ip_deferred_received_packet_head,
               *nx_ip_deferred_received_packet_tail;
 
+#ifdef NX_ENABLE_IP_RECEIVE_RING
+    /* Define the ring used instead of the deferred packet processing queue.  */
+    NX_IP_RECEIVE_RING nx_ip_deferred_receive_ring;
+#endif /* NX_ENABLE_IP_RECEIVE_RING */
+
     /* Define the raw IP function pointer that also indicates whether or
        not raw IP packet sending and receiving is enabled.  */
     VOID (*nx_ip_raw_ip_processing)(struct NX_IP_STRUCT *, NX_PACKET *);
@@ -1594,6 +2207,24 @@ typedef struct NX_IP_STRUCT
     NX_PACKET *nx_ip_fragment_assembly_head,
               *nx_ip_fragment_assembly_tail;
 
+#ifdef NX_ENABLE_IP_FRAGMENT_HASH
+
+    /* Define the datagrams being re-assembled, the available ones, the hash table used to
+       find the datagram of a fragment, and the list of datagrams in arrival order.  */
+    NX_IP_FRAGMENT_ASSEMBLY  nx_ip_fragment_assemblies[NX_IP_FRAGMENT_MAX_ASSEMBLIES];
+    NX_IP_FRAGMENT_ASSEMBLY *nx_ip_fragment_assembly_available;
+    NX_IP_FRAGMENT_ASSEMBLY *nx_ip_fragment_assembly_table[NX_IP_FRAGMENT_HASH_SIZE];
+    NX_IP_FRAGMENT_ASSEMBLY *nx_ip_fragment_assembly_oldest,
+                            *nx_ip_fragment_assembly_newest;
+
+    /* Define the number of fragments held, overall and per hashed source address.  */
+    ULONG nx_ip_fragment_assembly_packets;
+    ULONG nx_ip_fragment_source_packets[NX_IP_FRAGMENT_HASH_SIZE];
+
+    /* Define the count of periodic events used to time out re-assembly.  */
+    ULONG nx_ip_fragment_periodic_count;
+#endif /* NX_ENABLE_IP_FRAGMENT_HASH */
+
     /* Define the IP address change notification callback routine pointer.  */
     VOID  (*nx_ip_address_change_notify)(struct NX_IP_STRUCT *, VOID *);
     VOID *nx_ip_address_change_notify_additional_info;
@@ -1658,6 +2289,14 @@ typedef struct NX_IP_STRUCT
     struct NX_UDP_SOCKET_STRUCT
         *nx_ip_udp_port_table[NX_UDP_PORT_TABLE_SIZE];
 
+#ifdef NX_ENABLE_UDP_PORT_CACHE
+
+    /* Define the exact match cache of the UDP sockets last found for a port, which lets
+       the receive processing skip the search of the port list.  */
+    struct NX_UDP_SOCKET_STRUCT
+        *nx_ip_udp_port_cache[NX_UDP_PORT_CACHE_SIZE];
+#endif /* NX_ENABLE_UDP_PORT_CACHE */
+
     /* Define the head pointer of the created UDP socket list.  */
     struct NX_UDP_SOCKET_STRUCT
         *nx_ip_udp_created_sockets_ptr;
@@ -1674,6 +2313,14 @@ typedef struct NX_IP_STRUCT
     struct NX_TCP_SOCKET_STRUCT
         *nx_ip_tcp_port_table[NX_TCP_PORT_TABLE_SIZE];
 
+    /* Define the TCP connection hash table associated with this IP instance.  It points
+       to the default table below unless the application has supplied a larger one.  */
+    struct NX_TCP_SOCKET_STRUCT
+        **nx_ip_tcp_connection_table;
+    ULONG nx_ip_tcp_connection_table_mask;
+    struct NX_TCP_SOCKET_STRUCT
+        *nx_ip_tcp_connection_table_default[NX_TCP_CONNECTION_TABLE_SIZE];
+
     /* Define the head pointer of the created TCP socket list.  */
     struct NX_TCP_SOCKET_STRUCT
         *nx_ip_tcp_created_sockets_ptr;
@@ -1703,6 +2350,14 @@ typedef struct NX_IP_STRUCT
     /* Define the count of incoming TCP packets on the queue.  */
     ULONG nx_ip_tcp_received_packet_count;
 
+#ifdef NX_ENABLE_TCP_GRO
+
+    /* Define the flag that is set while the IP helper thread processes a burst of received
+       packets.  The TCP segments of the burst are placed on the TCP queue, where the in-order
+       segments of a connection are coalesced before they are processed.  */
+    UINT nx_ip_tcp_gro_batch;
+#endif /* NX_ENABLE_TCP_GRO */
+
     /* Define the TCP listen request structure that contains the maximum number of
        listen requests allowed for this IP instance.  */
     struct NX_TCP_LISTEN_STRUCT
@@ -1717,14 +2372,41 @@ typedef struct NX_IP_STRUCT
     struct NX_TCP_LISTEN_STRUCT
         *nx_ip_tcp_active_listen_requests;
 
+    /* Define the hash table of the active listen requests, indexed by port.  */
+    struct NX_TCP_LISTEN_STRUCT
+        *nx_ip_tcp_listen_table[NX_TCP_LISTEN_TABLE_SIZE];
+
     /* Define the fast TCP periodic timer used for high resolution events for
        this IP instance.  */
     TX_TIMER nx_ip_tcp_fast_periodic_timer;
 
+    /* Define the TCP timer wheel.  Sockets with an active delayed ACK, transmit or
+       keepalive timer are placed on the slot of the fast timer tick they need to be
+       processed on, so the fast periodic processing only visits sockets that are due.  */
+    struct NX_TCP_SOCKET_STRUCT
+        *nx_ip_tcp_timer_wheel[NX_TCP_TIMER_WHEEL_SIZE];
+    ULONG nx_ip_tcp_timer_tick;
+
     /* Define the destination routing information associated with this IP
        instance.  */
+#ifdef NX_ENABLE_ARP_CACHE_HASH
+    /* The ARP hash table starts out as the default table below and is replaced by
+       a larger one carved from the ARP cache memory when it holds more entries.  */
+    struct NX_ARP_STRUCT
+       **nx_ip_arp_table;
+    ULONG nx_ip_arp_table_mask;
+    struct NX_ARP_STRUCT
+        *nx_ip_arp_table_default[NX_ROUTE_TABLE_SIZE];
+
+    /* Define the ARP timer wheel.  Dynamic entries with a retry or expiration timer
+       running are placed on the slot of the second they are due.  */
+    struct NX_ARP_STRUCT
+        *nx_ip_arp_timer_wheel[NX_ARP_TIMER_WHEEL_SIZE];
+    ULONG nx_ip_arp_timer_tick;
+#else
     struct NX_ARP_STRUCT
         *nx_ip_arp_table[NX_ROUTE_TABLE_SIZE];
+#endif /* NX_ENABLE_ARP_CACHE_HASH */
 
     /* Define the head pointer of the static ARP list.  */
     struct NX_ARP_STRUCT
@@ -1759,6 +2441,19 @@ typedef struct NX_IP_STRUCT
        enabled.  */
     void (*nx_ip_arp_packet_send)(struct NX_IP_STRUCT *, ULONG destination_ip, NX_INTERFACE *nx_interface);
 
+#ifdef NX_ENABLE_ARP_PENDING_QUEUE
+    /* Define the budgets of packets queued while waiting for ARP resolution, per entry
+       and in total, and the number of packets queued.  */
+    ULONG nx_ip_arp_entry_queue_maximum;
+    ULONG nx_ip_arp_pending_maximum;
+    ULONG nx_ip_arp_pending_packets;
+
+    /* Define the ARP retransmit timer and processing routine.  The timer only runs
+       while new entries have fast ARP retransmits left.  */
+    TX_TIMER nx_ip_arp_retransmit_timer;
+    void (*nx_ip_arp_retransmit_process)(struct NX_IP_STRUCT *);
+#endif /* NX_ENABLE_ARP_PENDING_QUEUE */
+
     /* Define the ARP gratuitous response handler. This routine is setup in the
        nx_arp_gratuitous_send function.  */
     void (*nx_ip_arp_gratuitous_response_handler)(struct NX_IP_STRUCT *, NX_PACKET *);
@@ -1812,6 +2507,19 @@ typedef struct NX_IP_STRUCT
 
     ULONG               nx_ip_routing_table_entry_count;
 
+#ifdef NX_ENABLE_IP_ROUTE_TRIE
+
+    /* Define the prefix trie over the routing table, its nodes, the available nodes and
+       routing table entries, and the cache of recent lookups.  The generation changes
+       whenever a route changes.  */
+    NX_IP_ROUTE_NODE         *nx_ip_route_trie_root;
+    NX_IP_ROUTE_NODE          nx_ip_route_nodes[2 * NX_IP_ROUTING_TABLE_SIZE];
+    NX_IP_ROUTE_NODE         *nx_ip_route_node_available;
+    NX_IP_ROUTING_ENTRY      *nx_ip_routing_entry_available;
+    NX_IP_ROUTE_CACHE_ENTRY   nx_ip_route_cache[NX_IP_ROUTE_CACHE_SIZE];
+    ULONG                     nx_ip_route_cache_generation;
+#endif /* NX_ENABLE_IP_ROUTE_TRIE */
+
 #endif /*  NX_ENABLE_IP_STATIC_ROUTING */
 
     /* Define the link status change notify routine. */
@@ -1870,6 +2578,7 @@ typedef struct NX_IP_DRIVER_STRUCT
 
 /* Services without error checking.  */
 
+#define nx_arp_cache_info_get                           _nx_arp_cache_info_get
 #define nx_arp_dynamic_entries_invalidate               _nx_arp_dynamic_entries_invalidate
 #define nx_arp_dynamic_entry_set                        _nx_arp_dynamic_entry_set
 #define nx_arp_enable                                   _nx_arp_enable
@@ -1877,6 +2586,8 @@ typedef struct NX_IP_DRIVER_STRUCT
 #define nx_arp_hardware_address_find                    _nx_arp_hardware_address_find
 #define nx_arp_info_get                                 _nx_arp_info_get
 #define nx_arp_ip_address_find                          _nx_arp_ip_address_find
+#define nx_arp_queue_configure                          _nx_arp_queue_configure
+#define nx_arp_queue_info_get                           _nx_arp_queue_info_get
 #define nx_arp_static_entries_delete                    _nx_arp_static_entries_delete
 #define nx_arp_static_entry_create                      _nx_arp_static_entry_create
 #define nx_arp_static_entry_delete                      _nx_arp_static_entry_delete
@@ -1908,30 +2619,38 @@ typedef struct NX_IP_DRIVER_STRUCT
 #define nx_ip_info_get                                  _nx_ip_info_get
 #define nx_ip_interface_attach                          _nx_ip_interface_attach
 #define nx_ip_interface_address_get                     _nx_ip_interface_address_get
+#define nx_ip_interface_capability_get                  _nx_ip_interface_capability_get
+#define nx_ip_interface_capability_set                  _nx_ip_interface_capability_set
 #define nx_ip_interface_address_set                     _nx_ip_interface_address_set
 #define nx_ip_interface_info_get                        _nx_ip_interface_info_get
 #define nx_ip_interface_status_check                    _nx_ip_interface_status_check
 #define nx_ip_raw_packet_disable                        _nx_ip_raw_packet_disable
 #define nx_ip_raw_packet_enable                         _nx_ip_raw_packet_enable
 #define nx_ip_raw_packet_receive                        _nx_ip_raw_packet_receive
+#define nx_ip_receive_ring_info_get                     _nx_ip_receive_ring_info_get
 #define nx_ip_raw_packet_send                           _nx_ip_raw_packet_send
 #define nx_ip_raw_packet_interface_send                 _nx_ip_raw_packet_interface_send
 #define nx_ip_static_route_add                          _nx_ip_static_route_add
+#define nx_ip_static_route_metric_add                   _nx_ip_static_route_metric_add
 #define nx_ip_static_route_delete                       _nx_ip_static_route_delete
 #define nx_ip_status_check                              _nx_ip_status_check
 #define nx_ip_link_status_change_notify_set             _nx_ip_link_status_change_notify_set
 
 #define nx_packet_allocate                              _nx_packet_allocate
+#define nx_packet_clone                                 _nx_packet_clone
 #define nx_packet_copy                                  _nx_packet_copy
 #define nx_packet_data_append                           _nx_packet_data_append
 #define nx_packet_data_extract_offset                   _nx_packet_data_extract_offset
 #define nx_packet_data_retrieve                         _nx_packet_data_retrieve
 #define nx_packet_length_get                            _nx_packet_length_get
+#define nx_packet_pool_cache_flush                      _nx_packet_pool_cache_flush
+#define nx_packet_pool_cache_info_get                   _nx_packet_pool_cache_info_get
 #define nx_packet_pool_create                           _nx_packet_pool_create
 #define nx_packet_pool_delete                           _nx_packet_pool_delete
 #define nx_packet_pool_info_get                         _nx_packet_pool_info_get
 #define nx_packet_release                               _nx_packet_release
 #define nx_packet_transmit_release                      _nx_packet_transmit_release
+#define nx_packet_vector_reference                      _nx_packet_vector_reference
 
 #define nx_rarp_disable                                 _nx_rarp_disable
 #define nx_rarp_enable                                  _nx_rarp_enable
@@ -1943,16 +2662,24 @@ typedef struct NX_IP_DRIVER_STRUCT
 #define nx_tcp_client_socket_connect                    _nx_tcp_client_socket_connect
 #define nx_tcp_client_socket_port_get                   _nx_tcp_client_socket_port_get
 #define nx_tcp_client_socket_unbind                     _nx_tcp_client_socket_unbind
+#define nx_tcp_congestion_control_cubic                 _nx_tcp_congestion_control_cubic
+#define nx_tcp_congestion_control_newreno               _nx_tcp_congestion_control_newreno
+#define nx_tcp_connection_table_resize                  _nx_tcp_connection_table_resize
 #define nx_tcp_enable                                   _nx_tcp_enable
 #define nx_tcp_free_port_find                           _nx_tcp_free_port_find
 #define nx_tcp_info_get                                 _nx_tcp_info_get
 #define nx_tcp_server_socket_accept                     _nx_tcp_server_socket_accept
 #define nx_tcp_server_socket_listen                     _nx_tcp_server_socket_listen
+#define nx_tcp_server_socket_pool_accept                _nx_tcp_server_socket_pool_accept
+#define nx_tcp_server_socket_pool_add                   _nx_tcp_server_socket_pool_add
 #define nx_tcp_server_socket_relisten                   _nx_tcp_server_socket_relisten
 #define nx_tcp_server_socket_unaccept                   _nx_tcp_server_socket_unaccept
 #define nx_tcp_server_socket_unlisten                   _nx_tcp_server_socket_unlisten
 #define nx_tcp_socket_bytes_available                   _nx_tcp_socket_bytes_available
+#define nx_tcp_socket_congestion_control_set            _nx_tcp_socket_congestion_control_set
+#define nx_tcp_socket_cork                              _nx_tcp_socket_cork
 #define nx_tcp_socket_create                            _nx_tcp_socket_create
+#define nx_tcp_socket_data_receive                      _nx_tcp_socket_data_receive
 #define nx_tcp_socket_delete                            _nx_tcp_socket_delete
 #define nx_tcp_socket_disconnect                        _nx_tcp_socket_disconnect
 #ifndef NX_DISABLE_EXTENDED_NOTIFY_SUPPORT
@@ -1964,12 +2691,16 @@ typedef struct NX_IP_DRIVER_STRUCT
 #define nx_tcp_socket_mss_get                           _nx_tcp_socket_mss_get
 #define nx_tcp_socket_mss_peer_get                      _nx_tcp_socket_mss_peer_get
 #define nx_tcp_socket_mss_set                           _nx_tcp_socket_mss_set
+#define nx_tcp_socket_nodelay_set                       _nx_tcp_socket_nodelay_set
 #define nx_tcp_socket_peer_info_get                     _nx_tcp_socket_peer_info_get
 #define nx_tcp_socket_receive                           _nx_tcp_socket_receive
 #define nx_tcp_socket_receive_notify                    _nx_tcp_socket_receive_notify
+#define nx_tcp_socket_rtt_info_get                      _nx_tcp_socket_rtt_info_get
 #define nx_tcp_socket_send                              _nx_tcp_socket_send
+#define nx_tcp_socket_send_vector                       _nx_tcp_socket_send_vector
 #define nx_tcp_socket_state_wait                        _nx_tcp_socket_state_wait
 #define nx_tcp_socket_transmit_configure                _nx_tcp_socket_transmit_configure
+#define nx_tcp_socket_uncork                            _nx_tcp_socket_uncork
 #define nx_tcp_socket_window_update_notify_set          _nx_tcp_socket_window_update_notify_set
 
 #define nx_udp_enable                                   _nx_udp_enable
@@ -1986,8 +2717,10 @@ typedef struct NX_IP_DRIVER_STRUCT
 #define nx_udp_socket_interface_send                    _nx_udp_socket_interface_send
 #define nx_udp_socket_port_get                          _nx_udp_socket_port_get
 #define nx_udp_socket_receive                           _nx_udp_socket_receive
+#define nx_udp_socket_receive_batch                     _nx_udp_socket_receive_batch
 #define nx_udp_socket_receive_notify                    _nx_udp_socket_receive_notify
 #define nx_udp_socket_send                              _nx_udp_socket_send
+#define nx_udp_socket_send_vector                       _nx_udp_socket_send_vector
 #define nx_udp_socket_unbind                            _nx_udp_socket_unbind
 #define nx_udp_source_extract                           _nx_udp_source_extract
 
@@ -1995,6 +2728,7 @@ typedef struct NX_IP_DRIVER_STRUCT
 
 /* Services with error checking.  */
 
+#define nx_arp_cache_info_get                           _nxe_arp_cache_info_get
 #define nx_arp_dynamic_entries_invalidate               _nxe_arp_dynamic_entries_invalidate
 #define nx_arp_dynamic_entry_set                        _nxe_arp_dynamic_entry_set
 #define nx_arp_enable                                   _nxe_arp_enable
@@ -2002,6 +2736,8 @@ typedef struct NX_IP_DRIVER_STRUCT
 #define nx_arp_hardware_address_find                    _nxe_arp_hardware_address_find
 #define nx_arp_info_get                                 _nxe_arp_info_get
 #define nx_arp_ip_address_find                          _nxe_arp_ip_address_find
+#define nx_arp_queue_configure                          _nxe_arp_queue_configure
+#define nx_arp_queue_info_get                           _nxe_arp_queue_info_get
 #define nx_arp_static_entries_delete                    _nxe_arp_static_entries_delete
 #define nx_arp_static_entry_create                      _nxe_arp_static_entry_create
 #define nx_arp_static_entry_delete                      _nxe_arp_static_entry_delete
@@ -2023,6 +2759,8 @@ typedef struct NX_IP_DRIVER_STRUCT
 #define nx_ip_address_set                               _nxe_ip_address_set
 #define nx_ip_interface_address_get                     _nxe_ip_interface_address_get
 #define nx_ip_interface_address_set                     _nxe_ip_interface_address_set
+#define nx_ip_interface_capability_get                  _nxe_ip_interface_capability_get
+#define nx_ip_interface_capability_set                  _nxe_ip_interface_capability_set
 #define nx_ip_interface_info_get                        _nxe_ip_interface_info_get
 #define nx_ip_interface_status_check                    _nxe_ip_interface_status_check
 #define nx_ip_create(i, n, a, m, d, l, p, s, y)         _nxe_ip_create(i, n, a, m, d, l, p, s, y, sizeof(NX_IP))
@@ -2039,25 +2777,31 @@ typedef struct NX_IP_DRIVER_STRUCT
 #define nx_ip_raw_packet_disable                        _nxe_ip_raw_packet_disable
 #define nx_ip_raw_packet_enable                         _nxe_ip_raw_packet_enable
 #define nx_ip_raw_packet_receive                        _nxe_ip_raw_packet_receive
+#define nx_ip_receive_ring_info_get                     _nxe_ip_receive_ring_info_get
 #define nx_ip_raw_packet_send(i, p, d, t)               _nxe_ip_raw_packet_send(i, &p, d, t)
 #define nx_ip_raw_packet_interface_send(i, p, d, f, t)  _nxe_ip_raw_packet_interface_send(i, &p, d, f, t)
 #define nx_ip_static_route_add                          _nxe_ip_static_route_add
+#define nx_ip_static_route_metric_add                   _nxe_ip_static_route_metric_add
 #define nx_ip_static_route_delete                       _nxe_ip_static_route_delete
 
 #define nx_ip_status_check                              _nxe_ip_status_check
 #define nx_ip_link_status_change_notify_set             _nxe_ip_link_status_change_notify_set
 
 #define nx_packet_allocate                              _nxe_packet_allocate
+#define nx_packet_clone                                 _nxe_packet_clone
 #define nx_packet_copy                                  _nxe_packet_copy
 #define nx_packet_data_append                           _nxe_packet_data_append
 #define nx_packet_data_extract_offset                   _nxe_packet_data_extract_offset
 #define nx_packet_data_retrieve                         _nxe_packet_data_retrieve
 #define nx_packet_length_get                            _nxe_packet_length_get
+#define nx_packet_pool_cache_flush                      _nxe_packet_pool_cache_flush
+#define nx_packet_pool_cache_info_get                   _nxe_packet_pool_cache_info_get
 #define nx_packet_pool_create(p, n, l, m, s)            _nxe_packet_pool_create(p, n, l, m, s, sizeof(NX_PACKET_POOL))
 #define nx_packet_pool_delete                           _nxe_packet_pool_delete
 #define nx_packet_pool_info_get                         _nxe_packet_pool_info_get
 #define nx_packet_release(p)                            _nxe_packet_release(&p)
 #define nx_packet_transmit_release(p)                   _nxe_packet_transmit_release(&p)
+#define nx_packet_vector_reference                      _nxe_packet_vector_reference
 
 #define nx_rarp_disable                                 _nxe_rarp_disable
 #define nx_rarp_enable                                  _nxe_rarp_enable
@@ -2069,16 +2813,24 @@ typedef struct NX_IP_DRIVER_STRUCT
 #define nx_tcp_client_socket_connect                    _nxe_tcp_client_socket_connect
 #define nx_tcp_client_socket_port_get                   _nxe_tcp_client_socket_port_get
 #define nx_tcp_client_socket_unbind                     _nxe_tcp_client_socket_unbind
+#define nx_tcp_congestion_control_cubic                 _nx_tcp_congestion_control_cubic
+#define nx_tcp_congestion_control_newreno               _nx_tcp_congestion_control_newreno
+#define nx_tcp_connection_table_resize                  _nxe_tcp_connection_table_resize
 #define nx_tcp_enable                                   _nxe_tcp_enable
 #define nx_tcp_free_port_find                           _nxe_tcp_free_port_find
 #define nx_tcp_info_get                                 _nxe_tcp_info_get
 #define nx_tcp_server_socket_accept                     _nxe_tcp_server_socket_accept
 #define nx_tcp_server_socket_listen                     _nxe_tcp_server_socket_listen
+#define nx_tcp_server_socket_pool_accept                _nxe_tcp_server_socket_pool_accept
+#define nx_tcp_server_socket_pool_add                   _nxe_tcp_server_socket_pool_add
 #define nx_tcp_server_socket_relisten                   _nxe_tcp_server_socket_relisten
 #define nx_tcp_server_socket_unaccept                   _nxe_tcp_server_socket_unaccept
 #define nx_tcp_server_socket_unlisten                   _nxe_tcp_server_socket_unlisten
 #define nx_tcp_socket_bytes_available                   _nxe_tcp_socket_bytes_available
+#define nx_tcp_socket_congestion_control_set            _nxe_tcp_socket_congestion_control_set
+#define nx_tcp_socket_cork                              _nxe_tcp_socket_cork
 #define nx_tcp_socket_create(i, s, n, t, f, l, w, u, d) _nxe_tcp_socket_create(i, s, n, t, f, l, w, u, d, sizeof(NX_TCP_SOCKET))
+#define nx_tcp_socket_data_receive                      _nxe_tcp_socket_data_receive
 #define nx_tcp_socket_delete                            _nxe_tcp_socket_delete
 #define nx_tcp_socket_disconnect                        _nxe_tcp_socket_disconnect
 #ifndef NX_DISABLE_EXTENDED_NOTIFY_SUPPORT
@@ -2090,12 +2842,16 @@ typedef struct NX_IP_DRIVER_STRUCT
 #define nx_tcp_socket_mss_get                           _nxe_tcp_socket_mss_get
 #define nx_tcp_socket_mss_peer_get                      _nxe_tcp_socket_mss_peer_get
 #define nx_tcp_socket_mss_set                           _nxe_tcp_socket_mss_set
+#define nx_tcp_socket_nodelay_set                       _nxe_tcp_socket_nodelay_set
 #define nx_tcp_socket_peer_info_get                     _nxe_tcp_socket_peer_info_get
 #define nx_tcp_socket_receive                           _nxe_tcp_socket_receive
 #define nx_tcp_socket_receive_notify                    _nxe_tcp_socket_receive_notify
+#define nx_tcp_socket_rtt_info_get                      _nxe_tcp_socket_rtt_info_get
 #define nx_tcp_socket_send(s, p, t)                     _nxe_tcp_socket_send(s, &p, t)
+#define nx_tcp_socket_send_vector                       _nxe_tcp_socket_send_vector
 #define nx_tcp_socket_state_wait                        _nxe_tcp_socket_state_wait
 #define nx_tcp_socket_transmit_configure                _nxe_tcp_socket_transmit_configure
+#define nx_tcp_socket_uncork                            _nxe_tcp_socket_uncork
 #define nx_tcp_socket_window_update_notify_set          _nxe_tcp_socket_window_update_notify_set
 
 #define nx_udp_enable                                   _nxe_udp_enable
@@ -2112,8 +2868,10 @@ typedef struct NX_IP_DRIVER_STRUCT
 #define nx_udp_socket_interface_send(s, p, i, t, a)     _nxe_udp_socket_interface_send(s, &p, i, t, a)
 #define nx_udp_socket_port_get                          _nxe_udp_socket_port_get
 #define nx_udp_socket_receive                           _nxe_udp_socket_receive
+#define nx_udp_socket_receive_batch                     _nxe_udp_socket_receive_batch
 #define nx_udp_socket_receive_notify                    _nxe_udp_socket_receive_notify
 #define nx_udp_socket_send(s, p, i, t)                  _nxe_udp_socket_send(s, &p, i, t)
+#define nx_udp_socket_send_vector                       _nxe_udp_socket_send_vector
 #define nx_udp_socket_unbind                            _nxe_udp_socket_unbind
 #define nx_udp_source_extract                           _nxe_udp_source_extract
 
@@ -2123,6 +2881,8 @@ typedef struct NX_IP_DRIVER_STRUCT
 /* Define the function prototypes of the NetX API.  */
 
 
+UINT nx_arp_cache_info_get(NX_IP *ip_ptr, ULONG *arp_cache_hits, ULONG *arp_cache_misses,
+                           ULONG *arp_cache_evictions, ULONG *arp_table_size);
 UINT nx_arp_dynamic_entries_invalidate(NX_IP *ip_ptr);
 UINT nx_arp_dynamic_entry_set(NX_IP *ip_ptr, ULONG ip_address,
                               ULONG physical_msw, ULONG physical_lsw);
@@ -2136,6 +2896,8 @@ UINT nx_arp_info_get(NX_IP *ip_ptr, ULONG *arp_requests_sent, ULONG *arp_request
                      ULONG *arp_aged_entries, ULONG *arp_invalid_messages);
 UINT nx_arp_ip_address_find(NX_IP *ip_ptr, ULONG *ip_address,
                             ULONG physical_msw, ULONG physical_lsw);
+UINT nx_arp_queue_configure(NX_IP *ip_ptr, ULONG entry_queue_maximum, ULONG total_queue_maximum);
+UINT nx_arp_queue_info_get(NX_IP *ip_ptr, ULONG *packets_queued, ULONG *resolution_drops);
 UINT nx_arp_static_entries_delete(NX_IP *ip_ptr);
 UINT nx_arp_static_entry_create(NX_IP *ip_ptr, ULONG ip_address,
                                 ULONG physical_msw, ULONG physical_lsw);
@@ -2163,6 +2925,8 @@ UINT nx_ip_address_get(NX_IP *ip_ptr, ULONG *ip_address, ULONG *network_mask);
 UINT nx_ip_address_set(NX_IP *ip_ptr, ULONG ip_address, ULONG network_mask);
 UINT nx_ip_interface_address_get(NX_IP *ip_ptr, ULONG interface_index, ULONG *ip_address, ULONG *network_mask);
 UINT nx_ip_interface_address_set(NX_IP *ip_ptr, ULONG interface_index, ULONG ip_address, ULONG network_mask);
+UINT nx_ip_interface_capability_get(NX_IP *ip_ptr, UINT interface_index, ULONG *interface_capability_flag);
+UINT nx_ip_interface_capability_set(NX_IP *ip_ptr, UINT interface_index, ULONG interface_capability_flag);
 UINT nx_ip_interface_info_get(NX_IP *ip_ptr, UINT interface_index, CHAR **interface_name, ULONG *ip_address,
                               ULONG *network_mask, ULONG *mtu_size, ULONG *phsyical_address_msw, ULONG *physical_address_lsw);
 #ifndef NX_DISABLE_ERROR_CHECKING
@@ -2208,7 +2972,9 @@ UINT _nx_ip_raw_packet_send(NX_IP *ip_ptr, NX_PACKET *packet_ptr,
 UINT _nx_ip_raw_packet_interface_send(NX_IP *ip_ptr, NX_PACKET *packet_ptr,
                                       ULONG destination_ip, UINT interface_index, ULONG type_of_service);
 #endif
+UINT nx_ip_receive_ring_info_get(NX_IP *ip_ptr, ULONG *packets_queued, ULONG *overflows);
 UINT nx_ip_static_route_add(NX_IP *ip_ptr, ULONG network_address, ULONG net_mask, ULONG next_hop);
+UINT nx_ip_static_route_metric_add(NX_IP *ip_ptr, ULONG network_address, ULONG net_mask, ULONG next_hop, ULONG metric);
 UINT nx_ip_static_route_delete(NX_IP *ip_ptr, ULONG network_address, ULONG net_mask);
 UINT nx_ip_status_check(NX_IP *ip_ptr, ULONG needed_status, ULONG *actual_status,
                         ULONG wait_option);
@@ -2216,6 +2982,8 @@ UINT nx_ip_link_status_change_notify_set(NX_IP *ip_ptr,  VOID (*link_status_chan
 
 UINT nx_packet_allocate(NX_PACKET_POOL *pool_ptr,  NX_PACKET **packet_ptr,
                         ULONG packet_type, ULONG wait_option);
+UINT nx_packet_clone(NX_PACKET *packet_ptr, NX_PACKET **new_packet_ptr,
+                     NX_PACKET_POOL *pool_ptr, ULONG wait_option);
 UINT nx_packet_copy(NX_PACKET *packet_ptr, NX_PACKET **new_packet_ptr,
                     NX_PACKET_POOL *pool_ptr, ULONG wait_option);
 UINT nx_packet_data_append(NX_PACKET *packet_ptr, VOID *data_start, ULONG data_size,
@@ -2224,6 +2992,9 @@ UINT nx_packet_data_extract_offset(NX_PACKET *packet_ptr, ULONG offset, VOID *bu
                                    ULONG buffer_length, ULONG *bytes_copied);
 UINT nx_packet_data_retrieve(NX_PACKET *packet_ptr, VOID *buffer_start, ULONG *bytes_copied);
 UINT nx_packet_length_get(NX_PACKET *packet_ptr, ULONG *length);
+UINT nx_packet_pool_cache_flush(NX_PACKET_POOL *pool_ptr);
+UINT nx_packet_pool_cache_info_get(NX_PACKET_POOL *pool_ptr, UINT cache_index, TX_THREAD **thread_ptr,
+                                   ULONG *cached_packets, ULONG *cache_hits, ULONG *cache_misses);
 #ifndef NX_DISABLE_ERROR_CHECKING
 UINT _nxe_packet_pool_create(NX_PACKET_POOL *pool_ptr, CHAR *name, ULONG payload_size,
                              VOID *memory_ptr, ULONG memory_size, UINT pool_control_block_size);
@@ -2242,6 +3013,9 @@ UINT _nxe_packet_transmit_release(NX_PACKET **packet_ptr_ptr);
 UINT _nx_packet_release(NX_PACKET *packet_ptr);
 UINT _nx_packet_transmit_release(NX_PACKET *packet_ptr);
 #endif
+UINT nx_packet_vector_reference(NX_PACKET_POOL *pool_ptr, NX_PACKET **packet_ptr, ULONG packet_type,
+                                NX_PACKET_VECTOR *vector_ptr, UINT vector_count,
+                                VOID (*release_notify)(VOID *context), VOID *context, ULONG wait_option);
 
 
 UINT nx_rarp_disable(NX_IP *ip_ptr);
@@ -2255,6 +3029,9 @@ UINT nx_tcp_client_socket_bind(NX_TCP_SOCKET *socket_ptr, UINT port, ULONG wait_
 UINT nx_tcp_client_socket_connect(NX_TCP_SOCKET *socket_ptr, ULONG server_ip, UINT server_port, ULONG wait_option);
 UINT nx_tcp_client_socket_port_get(NX_TCP_SOCKET *socket_ptr, UINT *port_ptr);
 UINT nx_tcp_client_socket_unbind(NX_TCP_SOCKET *socket_ptr);
+VOID nx_tcp_congestion_control_cubic(NX_TCP_SOCKET *socket_ptr, UINT event, ULONG acked_bytes);
+VOID nx_tcp_congestion_control_newreno(NX_TCP_SOCKET *socket_ptr, UINT event, ULONG acked_bytes);
+UINT nx_tcp_connection_table_resize(NX_IP *ip_ptr, VOID *table_memory, ULONG table_size);
 UINT nx_tcp_enable(NX_IP *ip_ptr);
 UINT nx_tcp_free_port_find(NX_IP *ip_ptr, UINT port, UINT *free_port_ptr);
 UINT nx_tcp_info_get(NX_IP *ip_ptr, ULONG *tcp_packets_sent, ULONG *tcp_bytes_sent,
@@ -2266,10 +3043,15 @@ UINT nx_tcp_info_get(NX_IP *ip_ptr, ULONG *tcp_packets_sent, ULONG *tcp_bytes_se
 UINT nx_tcp_server_socket_accept(NX_TCP_SOCKET *socket_ptr, ULONG wait_option);
 UINT nx_tcp_server_socket_listen(NX_IP *ip_ptr, UINT port, NX_TCP_SOCKET *socket_ptr, UINT listen_queue_size,
                                  VOID (*tcp_listen_callback)(NX_TCP_SOCKET *socket_ptr, UINT port));
+UINT nx_tcp_server_socket_pool_accept(NX_IP *ip_ptr, UINT port, NX_TCP_SOCKET **socket_ptr);
+UINT nx_tcp_server_socket_pool_add(NX_IP *ip_ptr, UINT port, NX_TCP_SOCKET *socket_ptr);
 UINT nx_tcp_server_socket_relisten(NX_IP *ip_ptr, UINT port, NX_TCP_SOCKET *socket_ptr);
 UINT nx_tcp_server_socket_unaccept(NX_TCP_SOCKET *socket_ptr);
 UINT nx_tcp_server_socket_unlisten(NX_IP *ip_ptr, UINT port);
 UINT nx_tcp_socket_bytes_available(NX_TCP_SOCKET *socket_ptr, ULONG *bytes_available);
+UINT nx_tcp_socket_congestion_control_set(NX_TCP_SOCKET *socket_ptr,
+                                          VOID (*congestion_control)(NX_TCP_SOCKET *socket_ptr, UINT event, ULONG acked_bytes));
+UINT nx_tcp_socket_cork(NX_TCP_SOCKET *socket_ptr);
 UINT nx_tcp_socket_peer_info_get(NX_TCP_SOCKET *socket_ptr, ULONG *peer_ip_address, ULONG *peer_port);
 #ifndef NX_DISABLE_ERROR_CHECKING
 UINT _nxe_tcp_socket_create(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr, CHAR *name,
@@ -2283,6 +3065,8 @@ UINT _nx_tcp_socket_create(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr, CHAR *name,
                            VOID (*tcp_urgent_data_callback)(NX_TCP_SOCKET *socket_ptr),
                            VOID (*tcp_disconnect_callback)(NX_TCP_SOCKET *socket_ptr));
 #endif
+UINT nx_tcp_socket_data_receive(NX_TCP_SOCKET *socket_ptr, VOID *buffer_start, ULONG buffer_length,
+                                ULONG *bytes_copied, ULONG wait_option);
 UINT nx_tcp_socket_delete(NX_TCP_SOCKET *socket_ptr);
 UINT nx_tcp_socket_disconnect(NX_TCP_SOCKET *socket_ptr, ULONG wait_option);
 #ifndef NX_DISABLE_EXTENDED_NOTIFY_SUPPORT
@@ -2299,16 +3083,21 @@ UINT nx_tcp_socket_info_get(NX_TCP_SOCKET *socket_ptr, ULONG *tcp_packets_sent,
 UINT nx_tcp_socket_mss_get(NX_TCP_SOCKET *socket_ptr, ULONG *mss);
 UINT nx_tcp_socket_mss_peer_get(NX_TCP_SOCKET *socket_ptr, ULONG *peer_mss);
 UINT nx_tcp_socket_mss_set(NX_TCP_SOCKET *socket_ptr, ULONG mss);
+UINT nx_tcp_socket_nodelay_set(NX_TCP_SOCKET *socket_ptr, UINT nodelay);
 UINT nx_tcp_socket_receive(NX_TCP_SOCKET *socket_ptr, NX_PACKET **packet_ptr, ULONG wait_option);
 UINT nx_tcp_socket_receive_notify(NX_TCP_SOCKET *socket_ptr, VOID (*tcp_receive_notify)(NX_TCP_SOCKET *socket_ptr));
+UINT nx_tcp_socket_rtt_info_get(NX_TCP_SOCKET *socket_ptr, ULONG *srtt, ULONG *rttvar, ULONG *rto);
 #ifndef NX_DISABLE_ERROR_CHECKING
 UINT _nxe_tcp_socket_send(NX_TCP_SOCKET *socket_ptr, NX_PACKET **packet_ptr_ptr, ULONG wait_option);
 #else
 UINT _nx_tcp_socket_send(NX_TCP_SOCKET *socket_ptr, NX_PACKET *packet_ptr, ULONG wait_option);
 #endif
+UINT nx_tcp_socket_send_vector(NX_TCP_SOCKET *socket_ptr, NX_PACKET_VECTOR *vector_ptr, UINT vector_count,
+                               VOID (*release_notify)(VOID *context), VOID *context, ULONG wait_option);
 UINT nx_tcp_socket_state_wait(NX_TCP_SOCKET *socket_ptr, UINT desired_state, ULONG wait_option);
 UINT nx_tcp_socket_transmit_configure(NX_TCP_SOCKET *socket_ptr, ULONG max_queue_depth, ULONG timeout,
                                       ULONG max_retries, ULONG timeout_shift);
+UINT nx_tcp_socket_uncork(NX_TCP_SOCKET *socket_ptr, ULONG wait_option);
 UINT nx_tcp_socket_window_update_notify_set(NX_TCP_SOCKET *socket_ptr,
                                             VOID (*tcp_window_update_notify)(NX_TCP_SOCKET *socket_ptr));
 
@@ -2342,6 +3131,8 @@ UINT nx_udp_socket_info_get(NX_UDP_SOCKET *socket_ptr, ULONG *udp_packets_sent,
 UINT nx_udp_socket_port_get(NX_UDP_SOCKET *socket_ptr, UINT *port_ptr);
 UINT nx_udp_socket_receive(NX_UDP_SOCKET *socket_ptr, NX_PACKET **packet_ptr,
                            ULONG wait_option);
+UINT nx_udp_socket_receive_batch(NX_UDP_SOCKET *socket_ptr, NX_UDP_RECEIVE_ENTRY *entry_ptr, UINT entry_count,
+                                 UINT *received_count, ULONG wait_option);
 UINT nx_udp_socket_receive_notify(NX_UDP_SOCKET *socket_ptr,
                                   VOID (*udp_receive_notify)(NX_UDP_SOCKET *socket_ptr));
 #ifndef NX_DISABLE_ERROR_CHECKING
@@ -2351,6 +3142,9 @@ UINT _nxe_udp_socket_send(NX_UDP_SOCKET *socket_ptr, NX_PACKET **packet_ptr_ptr,
 UINT _nx_udp_socket_send(NX_UDP_SOCKET *socket_ptr, NX_PACKET *packet_ptr,
                          ULONG ip_address, UINT port);
 #endif
+UINT nx_udp_socket_send_vector(NX_UDP_SOCKET *socket_ptr, NX_PACKET_VECTOR *vector_ptr, UINT vector_count,
+                               ULONG ip_address, UINT port,
+                               VOID (*release_notify)(VOID *context), VOID *context, ULONG wait_option);
 UINT nx_udp_socket_unbind(NX_UDP_SOCKET *socket_ptr);
 UINT nx_udp_source_extract(NX_PACKET *packet_ptr, ULONG *ip_address, UINT *port);
 
@@ -2396,6 +3190,21 @@ VOID _nx_arp_packet_deferred_receive(NX_IP *ip_ptr, NX_PACKET *packet_ptr);
 VOID _nx_rarp_packet_deferred_receive(NX_IP *ip_ptr, NX_PACKET *packet_ptr);
 
 
+/* Define the deferred NetX receive processing routine for a chain of IP packets linked
+   through nx_packet_queue_next.  A driver that receives several frames per interrupt can
+   hand all of them to the IP thread at the cost of a single packet.  */
+
+VOID _nx_ip_packet_deferred_chain_receive(NX_IP *ip_ptr, NX_PACKET *head_ptr, NX_PACKET *tail_ptr);
+
+
+/* Define the deferred NetX receive processing routine for the receive ring.  With
+   NX_ENABLE_IP_RECEIVE_RING, the packet is placed in a single-producer ring without disabling
+   interrupts, so it must only be called from the one receive context of the driver.  Any
+   other sender, such as loopback or PPP, must use _nx_ip_packet_deferred_receive.  */
+
+VOID _nx_ip_packet_ring_receive(NX_IP *ip_ptr, NX_PACKET *packet_ptr);
+
+
 /* Define the direct IP packet receive processing.  This is the lowest overhead way
    to notify NetX of a received IP packet, however, it results in the most amount of
    processing in the driver's receive ISR.  If the driver deferred packet processing
@@ -89,6 +89,49 @@
 #endif /* NX_ARP_DEFEND_INTERVAL */
 
 
+/* Define the states of dynamic ARP entries when NX_ENABLE_ARP_CACHE_HASH is defined.  An
+   incomplete entry is waiting for an ARP response.  A reachable entry was resolved within
+   the last NX_ARP_EXPIRATION_RATE seconds.  A stale entry is still used, and is probed
+   again the next time a packet is sent to it.  */
+
+#define NX_ARP_STATE_INCOMPLETE 0
+#define NX_ARP_STATE_REACHABLE  1
+#define NX_ARP_STATE_STALE      2
+#define NX_ARP_STATE_PROBE      3
+
+
+/* Define the macro that computes the ARP hash table index of an IP address, and the macro
+   that sets the state and the update timer of a dynamic ARP entry.  */
+
+#ifdef NX_ENABLE_ARP_CACHE_HASH
+#define NX_ARP_TABLE_INDEX(ip_ptr, ip_address) \
+    ((UINT)(((ip_address) + ((ip_address) >> 8)) & (ip_ptr) -> nx_ip_arp_table_mask))
+#define NX_ARP_ENTRY_STATE_SET(ip_ptr, arp_ptr, state, seconds) \
+    _nx_arp_entry_state_set(ip_ptr, arp_ptr, state, seconds)
+#else
+#define NX_ARP_TABLE_INDEX(ip_ptr, ip_address) \
+    ((UINT)(((ip_address) + ((ip_address) >> 8)) & NX_ROUTE_TABLE_MASK))
+#define NX_ARP_ENTRY_STATE_SET(ip_ptr, arp_ptr, state, seconds) \
+    ((arp_ptr) -> nx_arp_entry_next_update =  (seconds))
+#endif /* NX_ENABLE_ARP_CACHE_HASH */
+
+
+/* Define the macro that returns the packets queued on an ARP entry to the pending packet
+   budget once its queue is emptied, and the macro that starts the fast ARP retransmits of
+   a new dynamic entry.  */
+
+#ifdef NX_ENABLE_ARP_PENDING_QUEUE
+#define NX_ARP_QUEUE_CLEAR(ip_ptr, arp_ptr)                                         \
+    (ip_ptr) -> nx_ip_arp_pending_packets -=  (arp_ptr) -> nx_arp_packets_queued; \
+    (arp_ptr) -> nx_arp_packets_queued =  0;
+#define NX_ARP_RETRANSMIT_START(ip_ptr, arp_ptr) \
+    _nx_arp_retransmit_start(ip_ptr, arp_ptr);
+#else
+#define NX_ARP_QUEUE_CLEAR(ip_ptr, arp_ptr)
+#define NX_ARP_RETRANSMIT_START(ip_ptr, arp_ptr)
+#endif /* NX_ENABLE_ARP_PENDING_QUEUE */
+
+
 /* Define ARP function prototypes.  */
 
 VOID _nx_arp_initialize(VOID);
@@ -118,11 +161,28 @@ VOID _nx_arp_packet_deferred_receive(NX_IP *ip_ptr, NX_PACKET *packet_ptr);
 VOID _nx_arp_periodic_update(NX_IP *ip_ptr);
 UINT _nx_arp_probe_send(NX_IP *ip_ptr, UINT interface_index, ULONG probe_address);
 UINT _nx_arp_announce_send(NX_IP *ip_ptr, UINT interface_index);
+UINT _nx_arp_cache_info_get(NX_IP *ip_ptr, ULONG *arp_cache_hits, ULONG *arp_cache_misses,
+                            ULONG *arp_cache_evictions, ULONG *arp_table_size);
+#ifdef NX_ENABLE_ARP_CACHE_HASH
+VOID _nx_arp_entry_state_set(NX_IP *ip_ptr, NX_ARP *arp_ptr, UINT state, UINT seconds);
+VOID _nx_arp_entry_refresh(NX_IP *ip_ptr, NX_ARP *arp_ptr);
+VOID _nx_arp_timer_wheel_remove(NX_IP *ip_ptr, NX_ARP *arp_ptr);
+#endif /* NX_ENABLE_ARP_CACHE_HASH */
+UINT _nx_arp_queue_configure(NX_IP *ip_ptr, ULONG entry_queue_maximum, ULONG total_queue_maximum);
+UINT _nx_arp_queue_info_get(NX_IP *ip_ptr, ULONG *packets_queued, ULONG *resolution_drops);
+#ifdef NX_ENABLE_ARP_PENDING_QUEUE
+VOID _nx_arp_packet_queue(NX_IP *ip_ptr, NX_ARP *arp_ptr, NX_PACKET *packet_ptr);
+VOID _nx_arp_retransmit_start(NX_IP *ip_ptr, NX_ARP *arp_ptr);
+VOID _nx_arp_retransmit_process(NX_IP *ip_ptr);
+VOID _nx_arp_retransmit_timer_entry(ULONG ip_address);
+#endif /* NX_ENABLE_ARP_PENDING_QUEUE */
 
 
 /* Define error checking shells for ARP services.  These are only referenced by the
    application.  */
 
+UINT _nxe_arp_cache_info_get(NX_IP *ip_ptr, ULONG *arp_cache_hits, ULONG *arp_cache_misses,
+                             ULONG *arp_cache_evictions, ULONG *arp_table_size);
 UINT _nxe_arp_dynamic_entries_invalidate(NX_IP *ip_ptr);
 UINT _nxe_arp_dynamic_entry_set(NX_IP *ip_ptr, ULONG ip_address,
                                 ULONG physical_msw, ULONG physical_lsw);
@@ -136,6 +196,8 @@ UINT _nxe_arp_info_get(NX_IP *ip_ptr, ULONG *arp_requests_sent, ULONG *arp_reque
                        ULONG *arp_aged_entries, ULONG *arp_invalid_messages);
 UINT _nxe_arp_ip_address_find(NX_IP *ip_ptr, ULONG *ip_address,
                               ULONG physical_msw, ULONG physical_lsw);
+UINT _nxe_arp_queue_configure(NX_IP *ip_ptr, ULONG entry_queue_maximum, ULONG total_queue_maximum);
+UINT _nxe_arp_queue_info_get(NX_IP *ip_ptr, ULONG *packets_queued, ULONG *resolution_drops);
 VOID _nxe_arp_queue_process(NX_IP *ip_ptr);
 UINT _nxe_arp_static_entries_delete(NX_IP *ip_ptr);
 UINT _nxe_arp_static_entry_create(NX_IP *ip_ptr, ULONG ip_address,
@@ -81,6 +81,54 @@
 #define NX_IP_ALIGN_FRAGS            8                      /* Fragment alignment       */
 
 
+/* Define the check for an outgoing packet that must be fragmented.  A TCP super-segment is
+   larger than the MTU but is split into segments by the link driver instead.  */
+
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+#define NX_IP_FRAGMENTATION_NEEDED(p)                                                         \
+    (((p) -> nx_packet_length > (p) -> nx_packet_ip_interface -> nx_interface_ip_mtu_size) && \
+     ((p) -> nx_packet_tcp_segment_size == 0))
+#else
+#define NX_IP_FRAGMENTATION_NEEDED(p) \
+    ((p) -> nx_packet_length > (p) -> nx_packet_ip_interface -> nx_interface_ip_mtu_size)
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
+
+/* Define the check for a TCP super-segment that NetX splits into segments in software, because
+   the interface cannot do both the segmentation and the TCP checksums.  */
+
+#ifdef NX_ENABLE_TCP_GSO
+#define NX_IP_GSO_NEEDED(p)                                                                                    \
+    (((p) -> nx_packet_tcp_segment_size) &&                                                                   \
+     (((p) -> nx_packet_ip_interface -> nx_interface_capability_flag &                                        \
+       (NX_INTERFACE_CAPABILITY_TCP_SEGMENTATION | NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM)) !=                \
+      (NX_INTERFACE_CAPABILITY_TCP_SEGMENTATION | NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM)))
+#else
+#define NX_IP_GSO_NEEDED(p) NX_FALSE
+#endif /* NX_ENABLE_TCP_GSO */
+
+
+/* Define the fold of an address, or of a fragment key, into an index of the fragment
+   re-assembly hash table.  */
+
+#ifdef NX_ENABLE_IP_FRAGMENT_HASH
+#define NX_IP_FRAGMENT_HASH_INDEX(x) \
+    ((UINT)(((x) ^ ((x) >> 16) ^ ((x) >> 8)) & (NX_IP_FRAGMENT_HASH_SIZE - 1)))
+#endif /* NX_ENABLE_IP_FRAGMENT_HASH */
+
+
+/* Define the helpers of the static routing trie: the network mask of a prefix length, the
+   bit of an address that follows a prefix of the given length, and the fold of a
+   destination address into an index of the route cache.  */
+
+#ifdef NX_ENABLE_IP_ROUTE_TRIE
+#define NX_IP_ROUTE_PREFIX_MASK(l)   ((l) ? (((ULONG)0xFFFFFFFF) << (32 - (l))) : 0)
+#define NX_IP_ROUTE_BIT(a, l)        ((UINT)(((a) >> (31 - (l))) & 1))
+#define NX_IP_ROUTE_CACHE_INDEX(x) \
+    ((UINT)(((x) ^ ((x) >> 16) ^ ((x) >> 8)) & (NX_IP_ROUTE_CACHE_SIZE - 1)))
+#endif /* NX_ENABLE_IP_ROUTE_TRIE */
+
+
 /* Define IP event flags.  These events are processed by the IP thread. */
 
 #define NX_IP_ALL_EVENTS             ((ULONG)0xFFFFFFFF)    /* All event flags              */
@@ -99,6 +147,7 @@
                                                             /*   event                      */
 #define NX_IP_TCP_CLEANUP_DEFERRED   ((ULONG)0x00001000)    /* Deferred TCP cleanup event   */
 #define NX_IP_LINK_STATUS_EVENT      ((ULONG)0x00002000)    /* Link status change event     */
+#define NX_IP_ARP_RETRANSMIT_EVENT   ((ULONG)0x00004000)    /* ARP retransmit timer event   */
 
 
 #ifndef NX_IP_DEBUG_LOG_SIZE
@@ -174,6 +223,8 @@ UINT _nx_ip_address_get(NX_IP *ip_ptr, ULONG *ip_address, ULONG *network_mask);
 UINT _nx_ip_address_set(NX_IP *ip_ptr, ULONG ip_address, ULONG network_mask);
 UINT _nx_ip_interface_address_get(NX_IP *ip_ptr, ULONG interface_index, ULONG *ip_address, ULONG *network_mask);
 UINT _nx_ip_interface_address_set(NX_IP *ip_ptr, ULONG interface_index, ULONG ip_address, ULONG network_mask);
+UINT _nx_ip_interface_capability_get(NX_IP *ip_ptr, UINT interface_index, ULONG *interface_capability_flag);
+UINT _nx_ip_interface_capability_set(NX_IP *ip_ptr, UINT interface_index, ULONG interface_capability_flag);
 UINT _nx_ip_interface_info_get(NX_IP *ip_ptr, UINT interface_index, CHAR **interface_name, ULONG *ip_address,
                                ULONG *network_mask, ULONG *mtu_size, ULONG *phsyical_address_msw,
                                ULONG *physical_address_lsw);
@@ -219,6 +270,8 @@ VOID  _nx_ip_periodic_timer_entry(ULONG ip_address);
 VOID  _nx_ip_packet_send(NX_IP *ip_ptr, NX_PACKET *packet_ptr, ULONG destination_ip, ULONG type_of_service, ULONG time_to_live, ULONG protocol, ULONG fragment);
 VOID  _nx_ip_packet_receive(NX_IP *ip_ptr, NX_PACKET *packet_ptr);
 VOID  _nx_ip_packet_deferred_receive(NX_IP *ip_ptr, NX_PACKET *packet_ptr);
+VOID  _nx_ip_packet_deferred_chain_receive(NX_IP *ip_ptr, NX_PACKET *head_ptr, NX_PACKET *tail_ptr);
+VOID  _nx_ip_packet_ring_receive(NX_IP *ip_ptr, NX_PACKET *packet_ptr);
 UINT  _nx_ip_status_check(NX_IP *ip_ptr, ULONG needed_status, ULONG *actual_status,
                           ULONG wait_option);
 UINT  _nx_ip_link_status_change_notify_set(NX_IP *ip_ptr,  VOID (*link_status_change_notify)(NX_IP *ip_ptr, UINT interface_index, UINT link_up));
@@ -227,10 +280,38 @@ VOID  _nx_ip_raw_packet_cleanup(TX_THREAD *thread_ptr NX_CLEANUP_PARAMETER);
 VOID  _nx_ip_raw_packet_processing(NX_IP *ip_ptr, NX_PACKET *packet_ptr);
 VOID  _nx_ip_fragment_packet(struct NX_IP_DRIVER_STRUCT *driver_req_ptr);
 VOID  _nx_ip_fragment_assembly(NX_IP *ip_ptr);
+#ifdef NX_ENABLE_IP_FRAGMENT_HASH
+VOID  _nx_ip_fragment_hash_assembly(NX_IP *ip_ptr);
+NX_PACKET *_nx_ip_fragment_hash_insert(NX_IP *ip_ptr, NX_PACKET *packet_ptr);
+VOID  _nx_ip_fragment_hash_remove(NX_IP *ip_ptr, NX_IP_FRAGMENT_ASSEMBLY *assembly_ptr, UINT release);
+VOID  _nx_ip_fragment_hash_timeout_check(NX_IP *ip_ptr);
+#endif /* NX_ENABLE_IP_FRAGMENT_HASH */
+ULONG _nx_ip_checksum_compute(NX_PACKET *packet_ptr, ULONG protocol, ULONG data_length,
+                              ULONG source_ip, ULONG destination_ip);
+ULONG _nx_ip_checksum_adjust(ULONG checksum, ULONG old_value, ULONG new_value);
+ULONG _nx_ip_checksum_adjust_long(ULONG checksum, ULONG old_value, ULONG new_value);
+VOID  _nx_ip_driver_packet_send(NX_IP *ip_ptr, NX_PACKET *packet_ptr, ULONG destination_ip);
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+VOID  _nx_ip_packet_checksum_compute(NX_PACKET *packet_ptr);
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+#ifdef NX_ENABLE_TCP_GSO
+VOID  _nx_ip_gso_segment_send(struct NX_IP_DRIVER_STRUCT *driver_req_ptr);
+#endif /* NX_ENABLE_TCP_GSO */
+UINT  _nx_ip_receive_ring_info_get(NX_IP *ip_ptr, ULONG *packets_queued, ULONG *overflows);
+#ifdef NX_ENABLE_IP_RECEIVE_RING
+UINT  _nx_ip_receive_ring_put(NX_IP_RECEIVE_RING *ring_ptr, NX_PACKET *head_ptr);
+NX_PACKET *_nx_ip_receive_ring_get(NX_IP_RECEIVE_RING *ring_ptr);
+#endif /* NX_ENABLE_IP_RECEIVE_RING */
 
 UINT  _nx_ip_static_route_add(NX_IP *ip_ptr, ULONG network_address, ULONG net_mask, ULONG next_hop);
 UINT  _nx_ip_static_route_delete(NX_IP *ip_ptr, ULONG network_address, ULONG net_mask);
 ULONG _nx_ip_static_route_find(NX_IP *ip_ptr, ULONG destination_address);
+UINT  _nx_ip_static_route_metric_add(NX_IP *ip_ptr, ULONG network_address, ULONG net_mask, ULONG next_hop, ULONG metric);
+#ifdef NX_ENABLE_IP_ROUTE_TRIE
+NX_IP_ROUTE_NODE *_nx_ip_route_trie_node_find(NX_IP *ip_ptr, ULONG prefix, ULONG prefix_length, UINT create);
+UINT  _nx_ip_route_trie_delete(NX_IP *ip_ptr, ULONG prefix, ULONG prefix_length);
+NX_IP_ROUTING_ENTRY *_nx_ip_route_trie_lookup(NX_IP *ip_ptr, ULONG destination_address);
+#endif /* NX_ENABLE_IP_ROUTE_TRIE */
 
 /* Define error checking shells for API services.  These are only referenced by the
    application.  */
@@ -240,6 +321,8 @@ UINT _nxe_ip_address_get(NX_IP *ip_ptr, ULONG *ip_address, ULONG *network_mask);
 UINT _nxe_ip_address_set(NX_IP *ip_ptr, ULONG ip_address, ULONG network_mask);
 UINT _nxe_ip_interface_address_get(NX_IP *ip_ptr, ULONG interface_index, ULONG *ip_address, ULONG *network_mask);
 UINT _nxe_ip_interface_address_set(NX_IP *ip_ptr, ULONG interface_index, ULONG ip_address, ULONG network_mask);
+UINT _nxe_ip_interface_capability_get(NX_IP *ip_ptr, UINT interface_index, ULONG *interface_capability_flag);
+UINT _nxe_ip_interface_capability_set(NX_IP *ip_ptr, UINT interface_index, ULONG interface_capability_flag);
 UINT _nxe_ip_interface_info_get(NX_IP *ip_ptr, UINT interface_index, CHAR **interface_name, ULONG *ip_address,
                                 ULONG *network_mask, ULONG *mtu_size, ULONG *phsyical_address_msw,
                                 ULONG *physical_address_lsw);
@@ -270,12 +353,14 @@ UINT _nxe_ip_raw_packet_send(NX_IP *ip_ptr, NX_PACKET **packet_ptr_ptr,
                              ULONG destination_ip, ULONG type_of_service);
 UINT _nxe_ip_raw_packet_interface_send(NX_IP *ip_ptr, NX_PACKET **packet_ptr_ptr,
                                        ULONG destination_ip, UINT interface_index, ULONG type_of_service);
+UINT _nxe_ip_receive_ring_info_get(NX_IP *ip_ptr, ULONG *packets_queued, ULONG *overflows);
 UINT _nxe_ip_status_check(NX_IP *ip_ptr, ULONG needed_status, ULONG *actual_status,
                           ULONG wait_option);
 UINT _nxe_ip_link_status_change_notify_set(NX_IP *ip_ptr,  VOID (*link_status_change_notify)(NX_IP *ip_ptr, UINT interface_index, UINT link_up));
 
 UINT _nxe_ip_static_route_add(NX_IP *ip_ptr, ULONG network_address, ULONG net_mask, ULONG next_hop);
 UINT _nxe_ip_static_route_delete(NX_IP *ip_ptr, ULONG network_address, ULONG net_mask);
+UINT _nxe_ip_static_route_metric_add(NX_IP *ip_ptr, ULONG network_address, ULONG net_mask, ULONG next_hop, ULONG metric);
 UINT _nxe_ip_static_routing_disable(NX_IP *ip_ptr);
 UINT _nxe_ip_static_routing_enable(NX_IP *ip_ptr);
 
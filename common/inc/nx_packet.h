@@ -78,10 +78,20 @@
 
 
 
+/* Define the number of packets moved between a per-thread cache and the available list
+   of the pool at a time.  */
+
+#ifdef NX_ENABLE_PACKET_POOL_CACHE
+#define NX_PACKET_POOL_CACHE_BATCH  ((NX_PACKET_POOL_CACHE_SIZE + 1) / 2)
+#endif /* NX_ENABLE_PACKET_POOL_CACHE */
+
+
 /* Define packet pool management function prototypes.  */
 
 UINT _nx_packet_allocate(NX_PACKET_POOL *pool_ptr,  NX_PACKET **packet_ptr,
                          ULONG packet_type, ULONG wait_option);
+UINT _nx_packet_clone(NX_PACKET *packet_ptr, NX_PACKET **new_packet_ptr,
+                      NX_PACKET_POOL *pool_ptr, ULONG wait_option);
 UINT _nx_packet_copy(NX_PACKET *packet_ptr, NX_PACKET **new_packet_ptr,
                      NX_PACKET_POOL *pool_ptr, ULONG wait_option);
 UINT _nx_packet_data_append(NX_PACKET *packet_ptr, VOID *data_start, ULONG data_size,
@@ -90,6 +100,9 @@ UINT _nx_packet_data_extract_offset(NX_PACKET *packet_ptr, ULONG offset, VOID *b
                                     ULONG buffer_length, ULONG *bytes_copied);
 UINT _nx_packet_data_retrieve(NX_PACKET *packet_ptr, VOID *buffer_start, ULONG *bytes_copied);
 UINT _nx_packet_length_get(NX_PACKET *packet_ptr, ULONG *length);
+UINT _nx_packet_pool_cache_flush(NX_PACKET_POOL *pool_ptr);
+UINT _nx_packet_pool_cache_info_get(NX_PACKET_POOL *pool_ptr, UINT cache_index, TX_THREAD **thread_ptr,
+                                    ULONG *cached_packets, ULONG *cache_hits, ULONG *cache_misses);
 UINT _nx_packet_pool_create(NX_PACKET_POOL *pool_ptr, CHAR *name, ULONG payload_size,
                             VOID *memory_ptr, ULONG memory_size);
 UINT _nx_packet_pool_delete(NX_PACKET_POOL *pool_ptr);
@@ -98,7 +111,19 @@ UINT _nx_packet_pool_info_get(NX_PACKET_POOL *pool_ptr, ULONG *total_packets, UL
                               ULONG *invalid_packet_releases);
 UINT _nx_packet_release(NX_PACKET *packet_ptr);
 UINT _nx_packet_transmit_release(NX_PACKET *packet_ptr);
+UINT _nx_packet_vector_reference(NX_PACKET_POOL *pool_ptr, NX_PACKET **packet_ptr, ULONG packet_type,
+                                 NX_PACKET_VECTOR *vector_ptr, UINT vector_count,
+                                 VOID (*release_notify)(VOID *context), VOID *context, ULONG wait_option);
 VOID _nx_packet_pool_cleanup(TX_THREAD *thread_ptr NX_CLEANUP_PARAMETER);
+#ifdef NX_ENABLE_PACKET_POOL_CACHE
+NX_PACKET_POOL_CACHE *_nx_packet_pool_cache_get(NX_PACKET_POOL *pool_ptr);
+VOID _nx_packet_pool_cache_drain(NX_PACKET_POOL *pool_ptr, NX_PACKET_POOL_CACHE *cache_ptr, ULONG count);
+#endif /* NX_ENABLE_PACKET_POOL_CACHE */
+#ifdef NX_ENABLE_PACKET_CLONE
+UINT _nx_packet_clone_release(NX_PACKET *packet_ptr);
+UINT _nx_packet_data_reference(NX_PACKET *packet_ptr, NX_PACKET *source_ptr, UCHAR *data_start, ULONG data_size,
+                               NX_PACKET_POOL *pool_ptr, ULONG wait_option);
+#endif /* NX_ENABLE_PACKET_CLONE */
 VOID _nx_packet_pool_initialize(VOID);
 
 
@@ -107,6 +132,8 @@ VOID _nx_packet_pool_initialize(VOID);
 
 UINT _nxe_packet_allocate(NX_PACKET_POOL *pool_ptr,  NX_PACKET **packet_ptr,
                           ULONG packet_type, ULONG wait_option);
+UINT _nxe_packet_clone(NX_PACKET *packet_ptr, NX_PACKET **new_packet_ptr,
+                       NX_PACKET_POOL *pool_ptr, ULONG wait_option);
 UINT _nxe_packet_copy(NX_PACKET *packet_ptr, NX_PACKET **new_packet_ptr,
                       NX_PACKET_POOL *pool_ptr, ULONG wait_option);
 UINT _nxe_packet_data_append(NX_PACKET *packet_ptr, VOID *data_start, ULONG data_size,
@@ -115,6 +142,9 @@ UINT _nxe_packet_data_extract_offset(NX_PACKET *packet_ptr, ULONG offset, VOID *
                                      ULONG buffer_length, ULONG *bytes_copied);
 UINT _nxe_packet_data_retrieve(NX_PACKET *packet_ptr, VOID *buffer_start, ULONG *bytes_copied);
 UINT _nxe_packet_length_get(NX_PACKET *packet_ptr, ULONG *length);
+UINT _nxe_packet_pool_cache_flush(NX_PACKET_POOL *pool_ptr);
+UINT _nxe_packet_pool_cache_info_get(NX_PACKET_POOL *pool_ptr, UINT cache_index, TX_THREAD **thread_ptr,
+                                     ULONG *cached_packets, ULONG *cache_hits, ULONG *cache_misses);
 UINT _nxe_packet_pool_create(NX_PACKET_POOL *pool_ptr, CHAR *name, ULONG payload_size,
                              VOID *memory_ptr, ULONG memory_size, UINT pool_control_block_size);
 UINT _nxe_packet_pool_delete(NX_PACKET_POOL *pool_ptr);
@@ -123,6 +153,9 @@ UINT _nxe_packet_pool_info_get(NX_PACKET_POOL *pool_ptr, ULONG *total_packets, U
                                ULONG *invalid_packet_releases);
 UINT _nxe_packet_release(NX_PACKET **packet_ptr_ptr);
 UINT _nxe_packet_transmit_release(NX_PACKET **packet_ptr_ptr);
+UINT _nxe_packet_vector_reference(NX_PACKET_POOL *pool_ptr, NX_PACKET **packet_ptr, ULONG packet_type,
+                                  NX_PACKET_VECTOR *vector_ptr, UINT vector_count,
+                                  VOID (*release_notify)(VOID *context), VOID *context, ULONG wait_option);
 
 
 /* Packet pool management component data declarations follow.  */
@@ -64,7 +64,12 @@
 /* Define the TCP header typical size.  */
 
 #define NX_TCP_HEADER_SIZE       ((ULONG)0x50000000) /* Typical 5 word TCP header    */
+#ifdef NX_ENABLE_TCP_SACK
+#define NX_TCP_SYN_HEADER        ((ULONG)0x80000000) /* SYN header with MSS, window  */
+                                                     /*   scaling and SACK options   */
+#else
 #define NX_TCP_SYN_HEADER        ((ULONG)0x70000000) /* SYN header with MSS option   */
+#endif /* NX_ENABLE_TCP_SACK */
 #define NX_TCP_HEADER_MASK       ((ULONG)0xF0000000) /* TCP header size mask         */
 #define NX_TCP_HEADER_SHIFT      28                  /* Shift down to pickup length  */
 
@@ -90,6 +95,30 @@
 #define NX_TCP_NOP_KIND          0x01                /* NOP option kind              */
 #define NX_TCP_MSS_KIND          0x02                /* MSS option kind              */
 #define NX_TCP_RWIN_KIND         0x03
+#define NX_TCP_SACK_PERMITTED_OPTION ((ULONG)0x01010402) /* NOP, NOP, SACK permitted, 16 bits */
+#define NX_TCP_SACK_PERMITTED_KIND   0x04            /* SACK permitted option kind   */
+#define NX_TCP_SACK_OPTION       ((ULONG)0x01010500) /* NOP, NOP, SACK, length       */
+#define NX_TCP_SACK_KIND         0x05                /* SACK option kind             */
+#define NX_TCP_SACK_BLOCKS_MAXIMUM   4               /* SACK blocks that fit in the  */
+                                                     /*   TCP option space           */
+
+
+/* Define the layout of the congestion control data words used by CUBIC.  Times are
+   in ThreadX ticks, windows in bytes and K in 1/64 seconds.  */
+
+#define NX_TCP_CUBIC_W_MAX               0           /* Window before the last loss  */
+#define NX_TCP_CUBIC_EPOCH_START         1           /* Start of the growth epoch    */
+#define NX_TCP_CUBIC_K                   2           /* Time to reach W_MAX again    */
+#define NX_TCP_CUBIC_ORIGIN              3           /* Plateau of the cubic curve   */
+#define NX_TCP_CUBIC_W_EST               4           /* Reno-friendly window         */
+#define NX_TCP_CUBIC_LAST_TIME           5           /* Time of the last ACK         */
+#define NX_TCP_CUBIC_DATA_WORDS          6           /* Data words CUBIC uses        */
+
+
+/* Define the send coalescing options of a TCP socket.  */
+
+#define NX_TCP_COALESCE_NODELAY          0x01        /* Send small writes at once    */
+#define NX_TCP_COALESCE_CORK             0x02        /* Hold writes until uncorked   */
 
 
 /* Define constants for the optional TCP keepalive Timer.  To enable this
@@ -124,6 +153,29 @@
                                                     /*   of 1 causes each successive */
                                                     /*   be multiplied by two, etc.  */
 
+/* Define the bounds, in timer ticks, of the retransmit timeout computed from the
+   round-trip time when NX_ENABLE_TCP_RTT_ESTIMATION is defined.  The default minimum
+   is one second as recommended by RFC 6298.  */
+#ifndef NX_TCP_RTO_MINIMUM
+#define NX_TCP_RTO_MINIMUM       NX_IP_PERIODIC_RATE
+#endif
+
+#ifndef NX_TCP_RTO_MAXIMUM
+#define NX_TCP_RTO_MAXIMUM       (60 * NX_IP_PERIODIC_RATE)
+#endif
+
+#ifndef NX_TCP_SEGMENTATION_MAX_SIZE
+#define NX_TCP_SEGMENTATION_MAX_SIZE 65495          /* Maximum payload handed to an  */
+#endif                                              /*   interface doing TCP         */
+                                                    /*   segmentation offload, the   */
+                                                    /*   largest IP datagram less    */
+                                                    /*   the IP and TCP headers      */
+
+#ifndef NX_TCP_GRO_MAXIMUM_SEGMENTS
+#define NX_TCP_GRO_MAXIMUM_SEGMENTS 8               /* Maximum number of segments    */
+#endif                                              /*   coalesced into one packet   */
+                                                    /*   by TCP receive coalescing   */
+
 
 
 /* Define the rate for the TCP fast periodic timer.  This timer is used to process
@@ -155,6 +207,32 @@
 #endif
 
 
+/* Define the hash functions for the TCP connection and listen tables.  The connection
+   hash mixes the local port, peer IP address and peer port with a multiplicative
+   (Fibonacci) hash so that many connections to the same local port spread evenly.  */
+
+#define NX_TCP_CONNECTION_HASH(port, peer_ip, peer_port)                                                     \
+    ((((ULONG)(peer_ip) ^ ((((ULONG)(peer_port)) << NX_SHIFT_BY_16) | (ULONG)(port))) * ((ULONG)0x9E3779B1)) \
+     >> NX_SHIFT_BY_16)
+#define NX_TCP_LISTEN_HASH(port)    ((UINT)(((port) + ((port) >> 8)) & NX_TCP_LISTEN_TABLE_MASK))
+
+
+/* Define the conditions under which the delayed ACK and keepalive timers of a socket are
+   running.  The transmit timer is running whenever the socket timeout is non-zero.  */
+
+#define NX_TCP_DELAYED_ACK_ACTIVE(socket_ptr)                                                               \
+    (((socket_ptr) -> nx_tcp_socket_state >= NX_TCP_ESTABLISHED) &&                                         \
+     (((socket_ptr) -> nx_tcp_socket_rx_sequence != (socket_ptr) -> nx_tcp_socket_rx_sequence_acked) ||     \
+      ((socket_ptr) -> nx_tcp_socket_rx_window_last_sent < (socket_ptr) -> nx_tcp_socket_rx_window_current)))
+
+#ifdef NX_ENABLE_TCP_KEEPALIVE
+#define NX_TCP_KEEPALIVE_ACTIVE(socket_ptr)                                                                 \
+    (((socket_ptr) -> nx_tcp_socket_keepalive_enabled) &&                                                   \
+     ((socket_ptr) -> nx_tcp_socket_state == NX_TCP_ESTABLISHED) &&                                         \
+     ((socket_ptr) -> nx_tcp_socket_keepalive_timeout))
+#endif /* NX_ENABLE_TCP_KEEPALIVE */
+
+
 /* Define Basic TCP packet header data type.  This will be used to
    build new TCP packets and to examine incoming packets into NetX.  */
 
@@ -266,6 +344,13 @@ typedef  struct NX_TCP_SYN_STRUCT
     /* Define the second option word of the TCP SYN header.  This word contains
        window scaling if enabled. Otherwise it signals the end of the option list.  */
     ULONG nx_tcp_option_word_2;
+
+#ifdef NX_ENABLE_TCP_SACK
+    /* Define the third option word of the TCP SYN header.  This word contains the
+       SACK permitted option if SACK is offered.  Otherwise it signals the end of the
+       option list.  */
+    ULONG nx_tcp_option_word_3;
+#endif /* NX_ENABLE_TCP_SACK */
 } NX_TCP_SYN;
 
 
@@ -275,6 +360,7 @@ UINT _nx_tcp_client_socket_bind(NX_TCP_SOCKET *socket_ptr, UINT port, ULONG wait
 UINT _nx_tcp_client_socket_connect(NX_TCP_SOCKET *socket_ptr, ULONG server_ip, UINT server_port, ULONG wait_option);
 UINT _nx_tcp_client_socket_port_get(NX_TCP_SOCKET *socket_ptr, UINT *port_ptr);
 UINT _nx_tcp_client_socket_unbind(NX_TCP_SOCKET *socket_ptr);
+UINT _nx_tcp_connection_table_resize(NX_IP *ip_ptr, VOID *table_memory, ULONG table_size);
 UINT _nx_tcp_enable(NX_IP *ip_ptr);
 UINT _nx_tcp_free_port_find(NX_IP *ip_ptr, UINT port, UINT *free_port_ptr);
 UINT _nx_tcp_info_get(NX_IP *ip_ptr, ULONG *tcp_packets_sent, ULONG *tcp_bytes_sent,
@@ -286,6 +372,8 @@ UINT _nx_tcp_info_get(NX_IP *ip_ptr, ULONG *tcp_packets_sent, ULONG *tcp_bytes_s
 UINT _nx_tcp_server_socket_accept(NX_TCP_SOCKET *socket_ptr, ULONG wait_option);
 UINT _nx_tcp_server_socket_listen(NX_IP *ip_ptr, UINT port, NX_TCP_SOCKET *socket_ptr, UINT listen_queue_size,
                                   VOID (*tcp_listen_callback)(NX_TCP_SOCKET *socket_ptr, UINT port));
+UINT _nx_tcp_server_socket_pool_accept(NX_IP *ip_ptr, UINT port, NX_TCP_SOCKET **socket_ptr);
+UINT _nx_tcp_server_socket_pool_add(NX_IP *ip_ptr, UINT port, NX_TCP_SOCKET *socket_ptr);
 UINT _nx_tcp_server_socket_relisten(NX_IP *ip_ptr, UINT port, NX_TCP_SOCKET *socket_ptr);
 UINT _nx_tcp_server_socket_unaccept(NX_TCP_SOCKET *socket_ptr);
 UINT _nx_tcp_server_socket_unlisten(NX_IP *ip_ptr, UINT port);
@@ -293,6 +381,11 @@ UINT _nx_tcp_socket_create(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr, CHAR *name,
                            ULONG type_of_service, ULONG fragment, UINT time_to_live, ULONG window_size,
                            VOID (*tcp_urgent_data_callback)(NX_TCP_SOCKET *socket_ptr),
                            VOID (*tcp_disconnect_callback)(NX_TCP_SOCKET *socket_ptr));
+UINT _nx_tcp_socket_congestion_control_set(NX_TCP_SOCKET *socket_ptr,
+                                           VOID (*congestion_control)(NX_TCP_SOCKET *socket_ptr, UINT event, ULONG acked_bytes));
+UINT _nx_tcp_socket_cork(NX_TCP_SOCKET *socket_ptr);
+UINT _nx_tcp_socket_data_receive(NX_TCP_SOCKET *socket_ptr, VOID *buffer_start, ULONG buffer_length,
+                                 ULONG *bytes_copied, ULONG wait_option);
 UINT _nx_tcp_socket_delete(NX_TCP_SOCKET *socket_ptr);
 UINT _nx_tcp_socket_disconnect(NX_TCP_SOCKET *socket_ptr, ULONG wait_option);
 UINT _nx_tcp_socket_info_get(NX_TCP_SOCKET *socket_ptr, ULONG *tcp_packets_sent, ULONG *tcp_bytes_sent,
@@ -307,16 +400,21 @@ UINT _nx_tcp_socket_peer_info_get(NX_TCP_SOCKET *socket_ptr, ULONG *peer_ip_addr
 UINT _nx_tcp_socket_mss_get(NX_TCP_SOCKET *socket_ptr, ULONG *mss);
 UINT _nx_tcp_socket_mss_peer_get(NX_TCP_SOCKET *socket_ptr, ULONG *peer_mss);
 UINT _nx_tcp_socket_mss_set(NX_TCP_SOCKET *socket_ptr, ULONG mss);
+UINT _nx_tcp_socket_nodelay_set(NX_TCP_SOCKET *socket_ptr, UINT nodelay);
 UINT _nx_tcp_socket_receive(NX_TCP_SOCKET *socket_ptr, NX_PACKET **packet_ptr, ULONG wait_option);
 UINT _nx_tcp_socket_receive_notify(NX_TCP_SOCKET *socket_ptr,
                                    VOID (*tcp_receive_notify)(NX_TCP_SOCKET *socket_ptr));
+UINT _nx_tcp_socket_rtt_info_get(NX_TCP_SOCKET *socket_ptr, ULONG *srtt, ULONG *rttvar, ULONG *rto);
 UINT _nx_tcp_socket_window_update_notify_set(NX_TCP_SOCKET *socket_ptr,
                                              VOID (*tcp_windows_update_notify)(NX_TCP_SOCKET *socket_ptr));
 UINT _nx_tcp_socket_send(NX_TCP_SOCKET *socket_ptr, NX_PACKET *packet_ptr, ULONG wait_option);
+UINT _nx_tcp_socket_send_vector(NX_TCP_SOCKET *socket_ptr, NX_PACKET_VECTOR *vector_ptr, UINT vector_count,
+                                VOID (*release_notify)(VOID *context), VOID *context, ULONG wait_option);
 UINT _nx_tcp_socket_state_wait(NX_TCP_SOCKET *socket_ptr, UINT desired_state, ULONG wait_option);
 
 UINT _nx_tcp_socket_transmit_configure(NX_TCP_SOCKET *socket_ptr, ULONG max_queue_depth, ULONG timeout,
                                        ULONG max_retries, ULONG timeout_shift);
+UINT _nx_tcp_socket_uncork(NX_TCP_SOCKET *socket_ptr, ULONG wait_option);
 UINT _nx_tcp_socket_establish_notify(NX_TCP_SOCKET *socket_ptr, VOID (*tcp_establish_notify)(NX_TCP_SOCKET *socket_ptr));
 UINT _nx_tcp_socket_disconnect_complete_notify(NX_TCP_SOCKET *socket_ptr, VOID (*tcp_disconnect_complete_notify)(NX_TCP_SOCKET *socket_ptr));
 UINT _nx_tcp_socket_timed_wait_callback(NX_TCP_SOCKET *socket_ptr, VOID (*tcp_timed_wait_callback)(NX_TCP_SOCKET *socket_ptr));
@@ -327,6 +425,9 @@ UINT _nx_tcp_socket_peer_info_get(NX_TCP_SOCKET *, ULONG *, ULONG *);
 
 /* Define TCP component internal function prototypes.  */
 
+VOID  _nx_tcp_congestion_control_cubic(NX_TCP_SOCKET *socket_ptr, UINT event, ULONG acked_bytes);
+VOID  _nx_tcp_congestion_control_newreno(NX_TCP_SOCKET *socket_ptr, UINT event, ULONG acked_bytes);
+
 ULONG _nx_tcp_checksum(NX_PACKET *packet_ptr, ULONG source_address, ULONG destination_address);
 VOID  _nx_tcp_cleanup_deferred(TX_THREAD *thread_ptr NX_CLEANUP_PARAMETER);
 VOID  _nx_tcp_client_bind_cleanup(TX_THREAD *thread_ptr NX_CLEANUP_PARAMETER);
@@ -334,11 +435,45 @@ VOID  _nx_tcp_deferred_cleanup_check(NX_IP *ip_ptr);
 VOID  _nx_tcp_fast_periodic_processing(NX_IP *ip_ptr);
 VOID  _nx_tcp_fast_periodic_timer_entry(ULONG ip_address);
 VOID  _nx_tcp_socket_retransmit(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr, UINT need_fast_retransmit);
+VOID  _nx_tcp_socket_retransmit_packet(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr, NX_PACKET *packet_ptr);
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+ULONG _nx_tcp_socket_retransmit_slice(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr, NX_PACKET *packet_ptr, ULONG offset);
+ULONG _nx_tcp_socket_transmit_trim(NX_TCP_SOCKET *socket_ptr, NX_PACKET *packet_ptr, ULONG acknowledgment_number);
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+#ifdef NX_ENABLE_TCP_RTT_ESTIMATION
+VOID  _nx_tcp_socket_rtt_update(NX_TCP_SOCKET *socket_ptr, ULONG rtt);
+#endif /* NX_ENABLE_TCP_RTT_ESTIMATION */
 VOID  _nx_tcp_connect_cleanup(TX_THREAD *thread_ptr NX_CLEANUP_PARAMETER);
+NX_TCP_SOCKET *_nx_tcp_connection_table_find(NX_IP *ip_ptr, UINT port, ULONG peer_ip, UINT peer_port);
+VOID  _nx_tcp_connection_table_insert(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr);
+VOID  _nx_tcp_connection_table_remove(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr);
 VOID  _nx_tcp_disconnect_cleanup(TX_THREAD *thread_ptr NX_CLEANUP_PARAMETER);
 VOID  _nx_tcp_initialize(VOID);
 UINT  _nx_tcp_mss_option_get(UCHAR *option_ptr, ULONG option_area_size, ULONG *mss);
 UINT  _nx_tcp_window_scaling_option_get(UCHAR *option_ptr, ULONG option_area_size, ULONG *window_scale);
+#ifdef NX_ENABLE_TCP_SACK
+UINT  _nx_tcp_sack_permitted_option_get(UCHAR *option_ptr, ULONG option_area_size, UINT *sack_permitted);
+UINT  _nx_tcp_sack_option_get(UCHAR *option_ptr, ULONG option_area_size, NX_TCP_SACK_BLOCK *block_ptr, UINT *block_count);
+UINT  _nx_tcp_sack_option_build(NX_TCP_SOCKET *socket_ptr, ULONG *option_ptr);
+VOID  _nx_tcp_socket_sack_scoreboard_update(NX_TCP_SOCKET *socket_ptr, NX_TCP_HEADER *tcp_header_ptr);
+UINT  _nx_tcp_socket_sack_retransmit(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr);
+#endif /* NX_ENABLE_TCP_SACK */
+#ifdef NX_ENABLE_TCP_REASSEMBLY_INDEX
+UINT  _nx_tcp_socket_reassembly_insert(NX_TCP_SOCKET *socket_ptr, NX_PACKET *packet_ptr, ULONG begin_sequence, ULONG end_sequence, ULONG *ready_packets);
+VOID  _nx_tcp_socket_reassembly_rebuild(NX_TCP_SOCKET *socket_ptr);
+#endif /* NX_ENABLE_TCP_REASSEMBLY_INDEX */
+#ifdef NX_ENABLE_TCP_GRO
+NX_PACKET *_nx_tcp_gro_merge(NX_IP *ip_ptr, NX_PACKET *packet_ptr, NX_PACKET *queue_head);
+#endif /* NX_ENABLE_TCP_GRO */
+#ifdef NX_ENABLE_TCP_SEND_COALESCING
+NX_PACKET *_nx_tcp_socket_coalesce(NX_TCP_SOCKET *socket_ptr, NX_PACKET *packet_ptr);
+UINT       _nx_tcp_socket_coalesce_flush(NX_TCP_SOCKET *socket_ptr, ULONG wait_option);
+#endif /* NX_ENABLE_TCP_SEND_COALESCING */
+#ifdef NX_ENABLE_TCP_LISTEN_POOL
+VOID  _nx_tcp_listen_pool_arm(NX_IP *ip_ptr, struct NX_TCP_LISTEN_STRUCT *listen_ptr);
+VOID  _nx_tcp_listen_pool_recycle(NX_TCP_SOCKET *socket_ptr);
+VOID  _nx_tcp_listen_pool_remove(NX_TCP_SOCKET *socket_ptr);
+#endif /* NX_ENABLE_TCP_LISTEN_POOL */
 VOID  _nx_tcp_no_connection_reset(NX_IP *ip_ptr, NX_PACKET *packet_ptr, NX_TCP_HEADER *tcp_header_ptr);
 VOID  _nx_tcp_packet_process(NX_IP *ip_ptr, NX_PACKET *packet_ptr);
 VOID  _nx_tcp_packet_receive(NX_IP *ip_ptr, NX_PACKET *packet_ptr);
@@ -350,6 +485,9 @@ VOID  _nx_tcp_periodic_processing(NX_IP *ip_ptr);
 VOID  _nx_tcp_queue_process(NX_IP *ip_ptr);
 VOID  _nx_tcp_receive_cleanup(TX_THREAD *thread_ptr NX_CLEANUP_PARAMETER);
 VOID  _nx_tcp_socket_connection_reset(NX_TCP_SOCKET *socket_ptr);
+#ifdef NX_ENABLE_TCP_KEEPALIVE
+VOID  _nx_tcp_socket_keepalive_set(NX_TCP_SOCKET *socket_ptr, UINT keepalive_enabled);
+#endif /* NX_ENABLE_TCP_KEEPALIVE */
 VOID  _nx_tcp_socket_packet_process(NX_TCP_SOCKET *socket_ptr, NX_PACKET *packet_ptr);
 VOID  _nx_tcp_socket_receive_queue_flush(NX_TCP_SOCKET *socket_ptr);
 VOID  _nx_tcp_socket_state_ack_check(NX_TCP_SOCKET *socket_ptr, NX_TCP_HEADER *tcp_header_ptr);
@@ -364,8 +502,11 @@ VOID  _nx_tcp_socket_state_syn_received(NX_TCP_SOCKET *socket_ptr, NX_TCP_HEADER
 VOID  _nx_tcp_socket_state_transmit_check(NX_TCP_SOCKET *socket_ptr);
 VOID  _nx_tcp_socket_thread_resume(TX_THREAD **suspension_list_head, UINT status);
 VOID  _nx_tcp_socket_thread_suspend(TX_THREAD **suspension_list_head, VOID (*suspend_cleanup)(TX_THREAD *NX_CLEANUP_PARAMETER), NX_TCP_SOCKET *socket_ptr, TX_MUTEX *mutex_ptr, ULONG wait_option);
+VOID  _nx_tcp_socket_timer_update(NX_TCP_SOCKET *socket_ptr);
 VOID  _nx_tcp_socket_transmit_queue_flush(NX_TCP_SOCKET *socket_ptr);
 VOID  _nx_tcp_transmit_cleanup(TX_THREAD *thread_ptr NX_CLEANUP_PARAMETER);
+VOID  _nx_tcp_timer_wheel_insert(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr, ULONG ticks);
+VOID  _nx_tcp_timer_wheel_remove(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr);
 
 
 /* Define error checking shells for TCP API services.  These are only referenced by the
@@ -375,6 +516,7 @@ UINT _nxe_tcp_client_socket_bind(NX_TCP_SOCKET *socket_ptr, UINT port, ULONG wai
 UINT _nxe_tcp_client_socket_connect(NX_TCP_SOCKET *socket_ptr, ULONG server_ip, UINT server_port, ULONG wait_option);
 UINT _nxe_tcp_client_socket_port_get(NX_TCP_SOCKET *socket_ptr, UINT *port_ptr);
 UINT _nxe_tcp_client_socket_unbind(NX_TCP_SOCKET *socket_ptr);
+UINT _nxe_tcp_connection_table_resize(NX_IP *ip_ptr, VOID *table_memory, ULONG table_size);
 UINT _nxe_tcp_enable(NX_IP *ip_ptr);
 UINT _nxe_tcp_free_port_find(NX_IP *ip_ptr, UINT port, UINT *free_port_ptr);
 UINT _nxe_tcp_info_get(NX_IP *ip_ptr, ULONG *tcp_packets_sent, ULONG *tcp_bytes_sent,
@@ -386,6 +528,8 @@ UINT _nxe_tcp_info_get(NX_IP *ip_ptr, ULONG *tcp_packets_sent, ULONG *tcp_bytes_
 UINT _nxe_tcp_server_socket_accept(NX_TCP_SOCKET *socket_ptr, ULONG wait_option);
 UINT _nxe_tcp_server_socket_listen(NX_IP *ip_ptr, UINT port, NX_TCP_SOCKET *socket_ptr, UINT listen_queue_size,
                                    VOID (*tcp_listen_callback)(NX_TCP_SOCKET *socket_ptr, UINT port));
+UINT _nxe_tcp_server_socket_pool_accept(NX_IP *ip_ptr, UINT port, NX_TCP_SOCKET **socket_ptr);
+UINT _nxe_tcp_server_socket_pool_add(NX_IP *ip_ptr, UINT port, NX_TCP_SOCKET *socket_ptr);
 UINT _nxe_tcp_server_socket_relisten(NX_IP *ip_ptr, UINT port, NX_TCP_SOCKET *socket_ptr);
 UINT _nxe_tcp_server_socket_unaccept(NX_TCP_SOCKET *socket_ptr);
 UINT _nxe_tcp_server_socket_unlisten(NX_IP *ip_ptr, UINT port);
@@ -394,6 +538,11 @@ UINT _nxe_tcp_socket_create(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr, CHAR *name
                             VOID (*tcp_urgent_data_callback)(NX_TCP_SOCKET *socket_ptr),
                             VOID (*tcp_disconnect_callback)(NX_TCP_SOCKET *socket_ptr),
                             UINT tcp_socket_size);
+UINT _nxe_tcp_socket_congestion_control_set(NX_TCP_SOCKET *socket_ptr,
+                                            VOID (*congestion_control)(NX_TCP_SOCKET *socket_ptr, UINT event, ULONG acked_bytes));
+UINT _nxe_tcp_socket_cork(NX_TCP_SOCKET *socket_ptr);
+UINT _nxe_tcp_socket_data_receive(NX_TCP_SOCKET *socket_ptr, VOID *buffer_start, ULONG buffer_length,
+                                  ULONG *bytes_copied, ULONG wait_option);
 UINT _nxe_tcp_socket_delete(NX_TCP_SOCKET *socket_ptr);
 UINT _nxe_tcp_socket_disconnect(NX_TCP_SOCKET *socket_ptr, ULONG wait_option);
 UINT _nxe_tcp_socket_info_get(NX_TCP_SOCKET *socket_ptr, ULONG *tcp_packets_sent, ULONG *tcp_bytes_sent,
@@ -405,15 +554,20 @@ UINT _nxe_tcp_socket_info_get(NX_TCP_SOCKET *socket_ptr, ULONG *tcp_packets_sent
 UINT _nxe_tcp_socket_mss_get(NX_TCP_SOCKET *socket_ptr, ULONG *mss);
 UINT _nxe_tcp_socket_mss_peer_get(NX_TCP_SOCKET *socket_ptr, ULONG *peer_mss);
 UINT _nxe_tcp_socket_mss_set(NX_TCP_SOCKET *socket_ptr, ULONG mss);
+UINT _nxe_tcp_socket_nodelay_set(NX_TCP_SOCKET *socket_ptr, UINT nodelay);
 UINT _nxe_tcp_socket_receive(NX_TCP_SOCKET *socket_ptr, NX_PACKET **packet_ptr, ULONG wait_option);
 UINT _nxe_tcp_socket_receive_notify(NX_TCP_SOCKET *socket_ptr,
                                     VOID (*tcp_receive_notify)(NX_TCP_SOCKET *socket_ptr));
+UINT _nxe_tcp_socket_rtt_info_get(NX_TCP_SOCKET *socket_ptr, ULONG *srtt, ULONG *rttvar, ULONG *rto);
 UINT _nxe_tcp_socket_window_update_notify_set(NX_TCP_SOCKET *socket_ptr,
                                               VOID (*tcp_windows_update_notify)(NX_TCP_SOCKET *socket_ptr));
 UINT _nxe_tcp_socket_send(NX_TCP_SOCKET *socket_ptr, NX_PACKET **packet_ptr_ptr, ULONG wait_option);
+UINT _nxe_tcp_socket_send_vector(NX_TCP_SOCKET *socket_ptr, NX_PACKET_VECTOR *vector_ptr, UINT vector_count,
+                                 VOID (*release_notify)(VOID *context), VOID *context, ULONG wait_option);
 UINT _nxe_tcp_socket_state_wait(NX_TCP_SOCKET *socket_ptr, UINT desired_state, ULONG wait_option);
 UINT _nxe_tcp_socket_transmit_configure(NX_TCP_SOCKET *socket_ptr, ULONG max_queue_depth, ULONG timeout,
                                         ULONG max_retries, ULONG timeout_shift);
+UINT _nxe_tcp_socket_uncork(NX_TCP_SOCKET *socket_ptr, ULONG wait_option);
 
 UINT _nxe_tcp_socket_bytes_available(NX_TCP_SOCKET *, ULONG *);
 UINT _nxe_tcp_socket_peer_info_get(NX_TCP_SOCKET *, ULONG *, ULONG *);
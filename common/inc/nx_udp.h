@@ -111,10 +111,15 @@ UINT _nx_udp_socket_bytes_available(NX_UDP_SOCKET *socket_ptr, ULONG *bytes_avai
 UINT _nx_udp_socket_port_get(NX_UDP_SOCKET *socket_ptr, UINT *port_ptr);
 UINT _nx_udp_socket_receive(NX_UDP_SOCKET *socket_ptr, NX_PACKET **packet_ptr,
                             ULONG wait_option);
+UINT _nx_udp_socket_receive_batch(NX_UDP_SOCKET *socket_ptr, NX_UDP_RECEIVE_ENTRY *entry_ptr, UINT entry_count,
+                                  UINT *received_count, ULONG wait_option);
 UINT _nx_udp_socket_receive_notify(NX_UDP_SOCKET *socket_ptr,
                                    VOID (*udp_receive_notify)(NX_UDP_SOCKET *socket_ptr));
 UINT _nx_udp_socket_send(NX_UDP_SOCKET *socket_ptr, NX_PACKET *packet_ptr,
                          ULONG ip_address, UINT port);
+UINT _nx_udp_socket_send_vector(NX_UDP_SOCKET *socket_ptr, NX_PACKET_VECTOR *vector_ptr, UINT vector_count,
+                                ULONG ip_address, UINT port,
+                                VOID (*release_notify)(VOID *context), VOID *context, ULONG wait_option);
 UINT _nx_udp_socket_unbind(NX_UDP_SOCKET *socket_ptr);
 UINT _nx_udp_source_extract(NX_PACKET *packet_ptr, ULONG *ip_address, UINT *port);
 UINT _nx_udp_packet_info_extract(NX_PACKET *packet_ptr, ULONG *ip_address,
@@ -123,6 +128,9 @@ VOID _nx_udp_initialize(VOID);
 VOID _nx_udp_bind_cleanup(TX_THREAD *thread_ptr NX_CLEANUP_PARAMETER);
 VOID _nx_udp_packet_receive(NX_IP *ip_ptr, NX_PACKET *packet_ptr);
 VOID _nx_udp_receive_cleanup(TX_THREAD *thread_ptr NX_CLEANUP_PARAMETER);
+#ifndef NX_DISABLE_UDP_RX_CHECKSUM
+UINT _nx_udp_socket_checksum_verify(NX_UDP_SOCKET *socket_ptr, NX_PACKET *packet_ptr);
+#endif /* NX_DISABLE_UDP_RX_CHECKSUM */
 
 
 /* Define error checking shells for API services.  These are only referenced by the
@@ -148,10 +156,15 @@ UINT _nxe_udp_socket_bytes_available(NX_UDP_SOCKET *socket_ptr, ULONG *bytes_ava
 UINT _nxe_udp_socket_port_get(NX_UDP_SOCKET *socket_ptr, UINT *port_ptr);
 UINT _nxe_udp_socket_receive(NX_UDP_SOCKET *socket_ptr, NX_PACKET **packet_ptr,
                              ULONG wait_option);
+UINT _nxe_udp_socket_receive_batch(NX_UDP_SOCKET *socket_ptr, NX_UDP_RECEIVE_ENTRY *entry_ptr, UINT entry_count,
+                                   UINT *received_count, ULONG wait_option);
 UINT _nxe_udp_socket_receive_notify(NX_UDP_SOCKET *socket_ptr,
                                     VOID (*udp_receive_notify)(NX_UDP_SOCKET *socket_ptr));
 UINT _nxe_udp_socket_send(NX_UDP_SOCKET *socket_ptr, NX_PACKET **packet_ptr_ptr,
                           ULONG ip_address, UINT port);
+UINT _nxe_udp_socket_send_vector(NX_UDP_SOCKET *socket_ptr, NX_PACKET_VECTOR *vector_ptr, UINT vector_count,
+                                 ULONG ip_address, UINT port,
+                                 VOID (*release_notify)(VOID *context), VOID *context, ULONG wait_option);
 UINT _nxe_udp_socket_unbind(NX_UDP_SOCKET *socket_ptr);
 UINT _nxe_udp_source_extract(NX_PACKET *packet_ptr, ULONG *ip_address, UINT *port);
 UINT _nxe_udp_packet_info_extract(NX_PACKET *packet_ptr, ULONG *ip_address,
@@ -80,6 +80,28 @@
 #define NX_ENABLE_IP_STATIC_ROUTING
 */
 
+/* Defined, static routes are kept in a prefix trie and the route to the longest network prefix
+   containing the destination is found without scanning the routing table. Routes may carry a
+   metric with nx_ip_static_route_metric_add, the lowest metric wins, and net masks must be
+   contiguous. Recent lookups are cached. This defines NX_ENABLE_IP_STATIC_ROUTING. By default
+   the routing trie is not compiled in. */
+/*
+#define NX_ENABLE_IP_ROUTE_TRIE
+*/
+
+/* This define specifies the number of static routes of each IP instance. The default value
+   is 8.  */
+/*
+#define NX_IP_ROUTING_TABLE_SIZE 8
+*/
+
+/* This define specifies the number of destinations kept in the route cache of each IP
+   instance when NX_ENABLE_IP_ROUTE_TRIE is defined. It must be a power of two. The default
+   value is 16.  */
+/*
+#define NX_IP_ROUTE_CACHE_SIZE 16
+*/
+
 /* This define specifies the size of the physical packet header. The default value is 16 (based on
    a typical 16-byte Ethernet header).  */
 
@@ -191,6 +213,52 @@
 */
 
 
+/* Defined, the ARP cache is hashed on a table sized to the number of ARP entries that fit in the
+   cache memory given to nx_arp_enable, the least recently used entry is reused when the cache is
+   full, and entries are aged on a timer wheel so only due entries are visited each second.
+   Resolved entries that expire become stale and are probed when next used.  By default this
+   feature is not enabled.  */
+/*
+#define NX_ENABLE_ARP_CACHE_HASH
+*/
+
+/* This define specifies the number of one second slots of the ARP timer wheel when
+   NX_ENABLE_ARP_CACHE_HASH is defined. It must be a power of two. The default value is 64.  */
+/*
+#define NX_ARP_TIMER_WHEEL_SIZE     64
+*/
+
+
+/* Defined, packets waiting for ARP resolution are limited per entry to NX_ARP_MAX_QUEUE_DEPTH and
+   in total to NX_ARP_PENDING_PACKETS_MAXIMUM, both changeable with nx_arp_queue_configure, and a
+   packet over either limit is dropped instead of the oldest one queued.  New entries also send up
+   to NX_ARP_RETRANSMIT_MAXIMUM ARP requests before the periodic ARP update takes over, the first
+   NX_ARP_RETRANSMIT_INTERVAL ticks after the initial request and each later one after twice the
+   previous interval.  By default this feature is not enabled.  */
+/*
+#define NX_ENABLE_ARP_PENDING_QUEUE
+*/
+
+/* This define specifies the total number of packets queued while waiting for ARP resolution when
+   NX_ENABLE_ARP_PENDING_QUEUE is defined.  The default value of 0 allows half of the packets of
+   the default packet pool.  */
+/*
+#define NX_ARP_PENDING_PACKETS_MAXIMUM 0
+*/
+
+/* This define specifies the ticks before the first fast ARP retransmit of a new entry when
+   NX_ENABLE_ARP_PENDING_QUEUE is defined.  The default value is a quarter of a second.  */
+/*
+#define NX_ARP_RETRANSMIT_INTERVAL  (NX_IP_PERIODIC_RATE / 4)
+*/
+
+/* This define specifies the number of fast ARP retransmits of a new entry when
+   NX_ENABLE_ARP_PENDING_QUEUE is defined.  The default value is 3.  */
+/*
+#define NX_ARP_RETRANSMIT_MAXIMUM   3
+*/
+
+
 /* Defined, this option disables entering ARP request information in the ARP cache.  */
 
 /*
@@ -213,6 +281,33 @@
 */
 
 
+/* This define specifies the number of buckets in the default hash table used to find the socket
+   of an established TCP connection from its local port, peer IP address and peer port. It must
+   be a power of two. The table can be replaced at run time with nx_tcp_connection_table_resize.
+   The default value is 64.  */
+
+/*
+#define NX_TCP_CONNECTION_TABLE_SIZE 64
+*/
+
+
+/* This define specifies the number of buckets in the hash table of TCP server listen requests.
+   It must be a power of two. The default value is 16.  */
+
+/*
+#define NX_TCP_LISTEN_TABLE_SIZE    16
+*/
+
+
+/* This define specifies the number of slots in the TCP timer wheel. Each slot is one period of the
+   fast TCP timer; sockets whose next timer expires further away are revisited once per revolution
+   of the wheel. It must be a power of two. The default value is 256.  */
+
+/*
+#define NX_TCP_TIMER_WHEEL_SIZE     256
+*/
+
+
 /* Defined, this option enables the optional TCP keepalive timer.  */
 
 /*
@@ -226,6 +321,39 @@
 */
 
 
+/* Defined, this option enables TCP selective acknowledgment (RFC 2018). The SACK-permitted option is
+   negotiated on the SYN, out-of-order data is reported to the peer in ACKs, and the peer's SACK blocks
+   steer retransmission during fast recovery. Default disabled.  */
+/*
+#define NX_ENABLE_TCP_SACK
+*/
+
+
+/* This define specifies the number of ranges of selectively acknowledged data each socket remembers
+   when NX_ENABLE_TCP_SACK is defined. The default value is 8.  */
+/*
+#define NX_TCP_SACK_SCOREBOARD_SIZE 8
+*/
+
+
+/* Defined, this option enables the TCP reassembly index. Out-of-order segments are placed on the
+   receive queue with a binary search of the runs of out-of-order data instead of a walk of the
+   queue, which keeps reassembly fast with large receive windows on lossy paths. The index of each
+   socket has one entry per out-of-order packet the receive queue may hold, so
+   NX_TCP_MAX_OUT_OF_ORDER_PACKETS must be defined as well. Default disabled.  */
+/*
+#define NX_ENABLE_TCP_REASSEMBLY_INDEX
+*/
+
+
+/* This define specifies the number of ULONG words of per-socket state available to the TCP
+   congestion control algorithm selected with nx_tcp_socket_congestion_control_set. The NewReno
+   algorithm used by default needs none and the CUBIC algorithm needs 6. The default value is 8.  */
+/*
+#define NX_TCP_CONGESTION_CONTROL_DATA_SIZE 8
+*/
+
+
 
 /* Defined, this option enables the optional TCP immediate ACK response processing.  */
 
@@ -272,6 +400,28 @@
 */
 
 
+/* Defined, this option enables per-socket round-trip time estimation (RFC 6298). Each socket times
+   one unretransmitted segment per round trip (Karn's algorithm) and derives its retransmit timeout
+   from the smoothed round-trip time and its variation, replacing the fixed timeout set by
+   nx_tcp_socket_transmit_configure, which is still used until the first sample of each connection.
+   RFC 6298 backoff corresponds to a NX_TCP_RETRY_SHIFT of 1. Default disabled.  */
+
+/*
+#define NX_ENABLE_TCP_RTT_ESTIMATION
+*/
+
+
+/* This define specifies the lower and upper bounds, in timer ticks, of the retransmit timeout
+   computed from the round-trip time when NX_ENABLE_TCP_RTT_ESTIMATION is defined. The default
+   minimum is one second, as recommended by RFC 6298; low-latency networks may lower it. The default
+   maximum is 60 seconds.  */
+
+/*
+#define NX_TCP_RTO_MINIMUM          NX_IP_PERIODIC_RATE
+#define NX_TCP_RTO_MAXIMUM          (60 * NX_IP_PERIODIC_RATE)
+*/
+
+
 /* This define specifies how many keepalive retries are allowed before the connection is deemed broken.
    The default value is 10.  */
 
@@ -307,6 +457,29 @@
 #define NX_DISABLE_FRAGMENTATION
 */
 
+/* Defined, IP fragments are re-assembled with a hash table keyed on source and destination
+   address, protocol and IP header ID instead of searching one list of all datagrams. Fragments
+   are placed in offset order, overlapping fragments are dropped and completion is checked in
+   constant time. The number of fragments held overall and per source address is bounded, and
+   the oldest datagrams are discarded first when the budget or the re-assembly structures run
+   out. Default disabled.  */
+/*
+#define NX_ENABLE_IP_FRAGMENT_HASH
+*/
+
+/* These defines size fragment re-assembly when NX_ENABLE_IP_FRAGMENT_HASH is defined:
+   the number of hash table buckets, a power of two (default 16), the number of datagrams
+   re-assembled at the same time (default 8), the number of fragments held overall (default 64)
+   and from sources that hash to the same bucket (default 32), and the number of IP periodic
+   events after which an incomplete datagram is discarded (default 2).  */
+/*
+#define NX_IP_FRAGMENT_HASH_SIZE            16
+#define NX_IP_FRAGMENT_MAX_ASSEMBLIES       8
+#define NX_IP_FRAGMENT_MAX_PACKETS          64
+#define NX_IP_FRAGMENT_MAX_SOURCE_PACKETS   32
+#define NX_IP_FRAGMENT_TIMEOUT              2
+*/
+
 
 /* Defined, this option disables checksum logic on received IP packets. This is useful if the link-layer
    has reliable checksum or CRC logic.  */
@@ -323,6 +496,36 @@
 */
 
 
+/* Defined, this option enables the SSE2, AVX2 or NEON loops of the shared IP checksum engine.  The
+   instruction set is selected at build time from the compiler target (__AVX2__, __SSE2__ or
+   __ARM_NEON).  Without a matching target the portable 64-bit accumulator loop is used.  The
+   accumulators are unsigned long long unless NX_IP_CHECKSUM_ULONG64 names another 64-bit unsigned
+   type.  samples/demo_netx_checksum.c checks the engine and times it.  */
+
+/*
+#define NX_ENABLE_IP_CHECKSUM_SIMD
+*/
+
+
+/* Defined, this option enables interface capability negotiation.  After a link driver is initialized,
+   NetX issues the NX_LINK_GET_CAPABILITY command and skips the checksums (and TCP segmentation) the
+   driver reports its hardware can perform.  The capabilities can also be changed at run time with
+   nx_ip_interface_capability_set.  */
+
+/*
+#define NX_ENABLE_INTERFACE_CAPABILITY
+*/
+
+
+/* This define specifies the largest TCP payload, in bytes, handed to an interface that performs TCP
+   segmentation offload.  It only applies if NX_ENABLE_INTERFACE_CAPABILITY is defined.  The default
+   value is 65495, the largest IP datagram less the IP and TCP headers.  */
+
+/*
+#define NX_TCP_SEGMENTATION_MAX_SIZE 65495
+*/
+
+
 /* Defined, this option disables checksum logic on received TCP packets.  */
 
 /*
@@ -452,6 +655,132 @@
 #define NX_PACKET_HEADER_PAD_SIZE 1
 */
 
+/* Defined, each packet pool keeps small per-thread caches of free packets in front of its
+   available list. A thread allocates from and releases to its own cache without disabling
+   interrupts, and packets move between the cache and the pool in batches. Interrupt handlers
+   always use the pool. Packets in the cache of one thread are not available to other threads,
+   so a thread should call nx_packet_pool_cache_flush before it is deleted. Default disabled.  */
+/*
+#define NX_ENABLE_PACKET_POOL_CACHE
+*/
+
+/* This define specifies the number of per-thread caches of each packet pool when
+   NX_ENABLE_PACKET_POOL_CACHE is defined. Threads beyond this number use the pool directly.
+   The default value is 4.  */
+/*
+#define NX_PACKET_POOL_CACHE_COUNT 4
+*/
+
+/* This define specifies the number of packets each per-thread cache holds when
+   NX_ENABLE_PACKET_POOL_CACHE is defined. Half of this number of packets is moved between
+   the cache and the pool at a time. The default value is 16.  */
+/*
+#define NX_PACKET_POOL_CACHE_SIZE 16
+*/
+
+/* Defined, nx_packet_clone is available and is used instead of nx_packet_copy for loopback and
+   for the RAM driver and BSD raw packet fan-out. A clone copies only the first packet of a chain,
+   which holds the protocol headers; the data buffers of the other packets are shared and
+   reference counted. Shared data must not be modified. This adds two fields to each packet
+   header. Default disabled.  */
+/*
+#define NX_ENABLE_PACKET_CLONE
+*/
+
+/* Defined, packets handed to the IP thread by _nx_ip_packet_ring_receive and
+   _nx_ip_driver_deferred_receive are queued on a lock-free single-producer, single-consumer
+   ring instead of a list protected by disabling interrupts. The IP thread is only signaled when
+   the ring goes from empty to non-empty. Each of these functions must only be called from one
+   driver receive context per IP instance. _nx_ip_packet_deferred_receive and
+   _nx_ip_packet_deferred_chain_receive, which loopback, PPP and the RAM driver call from any
+   thread, keep using the list. Packets that do not fit are released and counted, see
+   nx_ip_receive_ring_info_get. Default disabled.  */
+/*
+#define NX_ENABLE_IP_RECEIVE_RING
+*/
+
+/* This define specifies the number of packets each receive ring of an IP instance holds when
+   NX_ENABLE_IP_RECEIVE_RING is defined. It must be a power of two. The default value is 64.  */
+/*
+#define NX_IP_RECEIVE_RING_SIZE 64
+*/
+
+/* This define specifies the memory barrier used by the receive ring when
+   NX_ENABLE_IP_RECEIVE_RING is defined. The default is __sync_synchronize() for GNU compilers
+   and nothing otherwise, which is only correct on single-core targets.  */
+/*
+#define NX_IP_RECEIVE_RING_BARRIER __sync_synchronize();
+*/
+
+/* Defined, nx_tcp_socket_send_vector, nx_udp_socket_send_vector and nx_packet_vector_reference
+   are available to send application buffers without copying them into packets. The buffers are
+   referenced from packet headers, and TCP segments such data by reference as well. The
+   application is notified when the buffers are no longer referenced, that is when TCP data is
+   acknowledged or a UDP datagram is transmitted. This defines NX_ENABLE_PACKET_CLONE and adds
+   two fields to each packet header. The link driver must support chained packets. Default
+   disabled.  */
+/*
+#define NX_ENABLE_ZERO_COPY_SEND
+*/
+
+/* Defined, each IP instance keeps an exact match cache of the UDP socket last found for a port,
+   so received datagrams for a cached port are delivered without taking the IP protection mutex
+   or searching the port list. Sockets are removed from the cache when they unbind. Default
+   disabled.  */
+/*
+#define NX_ENABLE_UDP_PORT_CACHE
+*/
+
+/* This define specifies the number of entries of the UDP port cache of each IP instance when
+   NX_ENABLE_UDP_PORT_CACHE is defined.  The value must be a power of two. The default value is
+   256.  */
+/*
+#define NX_UDP_PORT_CACHE_SIZE 256
+*/
+
+/* Defined, the IP helper thread queues the TCP segments of a burst of received packets and
+   coalesces the in-order data segments of a connection into one chained packet before TCP
+   processes them, so TCP state and ACKs are handled once per coalesced packet. Segments are
+   coalesced only when they carry no flags other than ACK and PSH and no TCP options. This defines
+   NX_ENABLE_INTERFACE_CAPABILITY to mark the checksums verified while coalescing. The link driver
+   must support chained packets. Default disabled.  */
+/*
+#define NX_ENABLE_TCP_GRO
+*/
+
+/* This define specifies the maximum number of TCP segments coalesced into one packet when
+   NX_ENABLE_TCP_GRO is defined. The default value is 8.  */
+/*
+#define NX_TCP_GRO_MAXIMUM_SEGMENTS 8
+*/
+
+/* Defined, TCP builds super-segments of up to NX_TCP_SEGMENTATION_MAX_SIZE bytes on every interface,
+   as it does for interfaces with TCP segmentation offload. On interfaces without that offload, the IP
+   layer splits each super-segment into MSS sized segments in software right before the packet is
+   handed to the link driver, after the route and the physical address of the next hop are resolved
+   once for the whole super-segment. The checksums of each segment are computed then, or by the
+   interface if it can. This defines NX_ENABLE_INTERFACE_CAPABILITY. Default disabled.  */
+/*
+#define NX_ENABLE_TCP_GSO
+*/
+
+/* Defined, TCP sockets coalesce small sends. Data smaller than MSS is held back and merged with
+   later data while earlier data is not acknowledged (Nagle's algorithm, which nx_tcp_socket_nodelay_set
+   turns off per socket), or while the socket is corked with nx_tcp_socket_cork until
+   nx_tcp_socket_uncork. The merged packets and bytes are counted per socket and per IP instance.
+   Default disabled.  */
+/*
+#define NX_ENABLE_TCP_SEND_COALESCING
+*/
+
+/* Defined, a TCP listen request can be given a pool of idle server sockets with
+   nx_tcp_server_socket_pool_add. Whenever the listen request has no listen socket, the next idle
+   socket takes its place and answers the connection request without waiting for a relisten.
+   Established connections are taken with nx_tcp_server_socket_pool_accept. Default disabled.  */
+/*
+#define NX_ENABLE_TCP_LISTEN_POOL
+*/
+
 /* If defined, the incoming SYN packet (connection request) is checked for a minimum acceptable
    MSS for the host to accept the connection. The default minimum should be based on the host
    application packet pool payload, socket transmit queue depth and relevant application specific parameters.
@@ -470,7 +799,8 @@
 */
 
 /* To limit the number of out of order packets stored to the TCP receive queue and prevent
-   possible packet pool depletion, define this to a non zero value:
+   possible packet pool depletion, define this to a non zero value. This value also sizes the
+   reassembly index when NX_ENABLE_TCP_REASSEMBLY_INDEX is defined:
 
 #define NX_TCP_MAX_OUT_OF_ORDER_PACKETS 8
 */
@@ -0,0 +1,136 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Address Resolution Protocol (ARP)                                   */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_arp.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_arp_cache_info_get                              PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function retrieves the ARP cache hit, miss and eviction counts */
+/*    of the specified IP instance, and the number of buckets of its ARP  */
+/*    hash table. A hit is a packet sent with a resolved entry, a miss is */
+/*    a packet that had to wait for or start address resolution, and an   */
+/*    eviction is an active entry reused for another address.             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                Pointer to IP instance        */
+/*    arp_cache_hits                        Destination for cache hits    */
+/*    arp_cache_misses                      Destination for cache misses  */
+/*    arp_cache_evictions                   Destination for entries       */
+/*                                            evicted                     */
+/*    arp_table_size                        Destination for number of     */
+/*                                            hash table buckets          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    tx_mutex_get                          Obtain protection mutex       */
+/*    tx_mutex_put                          Release protection mutex      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_arp_cache_info_get(NX_IP *ip_ptr, ULONG *arp_cache_hits, ULONG *arp_cache_misses,
+                             ULONG *arp_cache_evictions, ULONG *arp_table_size)
+{
+#ifdef NX_ENABLE_ARP_CACHE_HASH
+
+    /* Obtain protection on this IP instance.  */
+    tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
+
+    /* Determine if ARP cache hits is wanted.  */
+    if (arp_cache_hits)
+    {
+
+        /* Return the number of ARP cache hits of this IP instance.  */
+        *arp_cache_hits =  ip_ptr -> nx_ip_arp_cache_hits;
+    }
+
+    /* Determine if ARP cache misses is wanted.  */
+    if (arp_cache_misses)
+    {
+
+        /* Return the number of ARP cache misses of this IP instance.  */
+        *arp_cache_misses =  ip_ptr -> nx_ip_arp_cache_misses;
+    }
+
+    /* Determine if ARP cache evictions is wanted.  */
+    if (arp_cache_evictions)
+    {
+
+        /* Return the number of ARP entries evicted by this IP instance.  */
+        *arp_cache_evictions =  ip_ptr -> nx_ip_arp_cache_evictions;
+    }
+
+    /* Determine if ARP table size is wanted.  */
+    if (arp_table_size)
+    {
+
+        /* Return the number of buckets of the ARP hash table.  */
+        *arp_table_size =  ip_ptr -> nx_ip_arp_table_mask + 1;
+    }
+
+    /* Release the protection.  */
+    tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+    /* Return status to the caller.  */
+    return(NX_SUCCESS);
+#else
+    NX_PARAMETER_NOT_USED(ip_ptr);
+    NX_PARAMETER_NOT_USED(arp_cache_hits);
+    NX_PARAMETER_NOT_USED(arp_cache_misses);
+    NX_PARAMETER_NOT_USED(arp_cache_evictions);
+    NX_PARAMETER_NOT_USED(arp_table_size);
+
+    /* Return an error.  */
+    return(NX_NOT_ENABLED);
+#endif /* NX_ENABLE_ARP_CACHE_HASH */
+}
+
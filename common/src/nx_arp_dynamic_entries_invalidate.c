@@ -71,6 +71,11 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            returned queued packets to  */
+/*                                            the ARP pending packet      */
+/*                                            budget, resulting in        */
+/*                                            version 6.x                 */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_arp_dynamic_entries_invalidate(NX_IP *ip_ptr)
@@ -153,6 +158,9 @@ NX_PACKET *next_packet_ptr;
             /* Clear the queued packets head pointer.  */
             arp_entry -> nx_arp_packets_waiting =  NX_NULL;
 
+            /* Return the queued packets to the pending packet budget.  */
+            NX_ARP_QUEUE_CLEAR(ip_ptr, arp_entry)
+
             /* Restore interrupts.  */
             TX_RESTORE
 
@@ -61,7 +61,10 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _nx_arp_entry_allocate                Allocate an ARP entry         */
+/*    _nx_arp_entry_state_set               Set ARP entry state           */
 /*    _nx_arp_packet_send                   Send ARP request              */
+/*    _nx_arp_retransmit_start              Start fast ARP retransmits    */
+/*    _nx_ip_gso_segment_send               Split TCP super-segment       */
 /*    _nx_packet_transmit_release           Release ARP queued packet     */
 /*    tx_mutex_get                          Obtain protection mutex       */
 /*    tx_mutex_put                          Release protection mutex      */
@@ -81,6 +84,14 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), sent     */
+/*                                            TCP super-segments without  */
+/*                                            fragmentation, added ARP    */
+/*                                            cache hash, added ARP       */
+/*                                            pending packet budgets and  */
+/*                                            fast retransmits, split TCP */
+/*                                            super-segments in software, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_arp_dynamic_entry_set(NX_IP *ip_ptr, ULONG ip_address,
@@ -116,7 +127,7 @@ ULONG         next_hop_address = 0;
     tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
 
     /* Calculate the hash index for the specified IP address.  */
-    index =  (UINT)((ip_address + (ip_address >> 8)) & NX_ROUTE_TABLE_MASK);
+    index =  NX_ARP_TABLE_INDEX(ip_ptr, ip_address);
 
     /* Pickup the head pointer of the ARP entries for this IP instance.  */
     arp_list_head =  ip_ptr -> nx_ip_arp_table[index];
@@ -183,22 +194,24 @@ ULONG         next_hop_address = 0;
     arp_ptr -> nx_arp_physical_address_msw =  physical_msw;
     arp_ptr -> nx_arp_physical_address_lsw =  physical_lsw;
     arp_ptr -> nx_arp_retries =               0;
-    arp_ptr -> nx_arp_entry_next_update =     NX_ARP_EXPIRATION_RATE;
     arp_ptr -> nx_arp_ip_interface =          nx_interface;
 
     /* Determine if a physical address was supplied.  */
     if ((physical_msw | physical_lsw) == 0)
     {
 
-        /* Since there isn't physical mapping, change the update rate
+        /* Since there isn't physical mapping, use the update rate
            for possible ARP retries.  */
-        arp_ptr -> nx_arp_entry_next_update =     NX_ARP_UPDATE_RATE;
+        NX_ARP_ENTRY_STATE_SET(ip_ptr, arp_ptr, NX_ARP_STATE_INCOMPLETE, NX_ARP_UPDATE_RATE);
 
 
         /* The physical address was not specified so send an
            ARP request for the selected IP address.  */
         _nx_arp_packet_send(ip_ptr, ip_address, nx_interface);
 
+        /* Start the fast ARP retransmits of the entry.  */
+        NX_ARP_RETRANSMIT_START(ip_ptr, arp_ptr)
+
         /* Release the protection on the ARP list.  */
         tx_mutex_put(&(ip_ptr -> nx_ip_protection));
 
@@ -208,7 +221,8 @@ ULONG         next_hop_address = 0;
     else
     {
 
-        /* A physical address was supplied.  */
+        /* A physical address was supplied, start the expiration timer.  */
+        NX_ARP_ENTRY_STATE_SET(ip_ptr, arp_ptr, NX_ARP_STATE_REACHABLE, NX_ARP_EXPIRATION_RATE);
 
         /* Initialize the queued list head to NULL.  */
         queued_list_head =  NX_NULL;
@@ -226,6 +240,9 @@ ULONG         next_hop_address = 0;
             /* Pickup the packet pointer and clear the ARP queue pointer.  */
             queued_list_head =  arp_ptr -> nx_arp_packets_waiting;
             arp_ptr -> nx_arp_packets_waiting =  NX_NULL;
+
+            /* Return the queued packets to the pending packet budget.  */
+            NX_ARP_QUEUE_CLEAR(ip_ptr, arp_ptr)
         }
 
         /* Restore previous interrupt posture.  */
@@ -254,8 +271,19 @@ ULONG         next_hop_address = 0;
             driver_request.nx_ip_driver_packet               =  packet_ptr;
             driver_request.nx_ip_driver_interface            =  packet_ptr -> nx_packet_ip_interface;
 
+#ifdef NX_ENABLE_TCP_GSO
+            /* Determine if the TCP super-segment must be split into segments in software.  */
+            if (NX_IP_GSO_NEEDED(packet_ptr))
+            {
+
+                /* Split the super-segment and send the segments.  */
+                _nx_ip_gso_segment_send(&driver_request);
+                continue;
+            }
+#endif /* NX_ENABLE_TCP_GSO */
+
             /* Determine if fragmentation is needed.  */
-            if (packet_ptr -> nx_packet_length > packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_mtu_size)
+            if (NX_IP_FRAGMENTATION_NEEDED(packet_ptr))
             {
 
                 /* Fragmentation is needed, call the fragment routine if available. */
@@ -56,7 +56,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    None                                                                */
+/*    tx_timer_create                       Create ARP retransmit timer   */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -69,6 +69,12 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            ARP hash table sizing,      */
+/*                                            added ARP pending packet    */
+/*                                            budgets and retransmit      */
+/*                                            timer, resulting in version */
+/*                                            6.x                         */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_arp_enable(NX_IP *ip_ptr, VOID *arp_cache_memory, ULONG arp_cache_size)
@@ -77,6 +83,9 @@ UINT  _nx_arp_enable(NX_IP *ip_ptr, VOID *arp_cache_memory, ULONG arp_cache_size
 ULONG   i;
 ULONG   arp_entries;
 NX_ARP *entry_ptr;
+#ifdef NX_ENABLE_ARP_CACHE_HASH
+ULONG   table_size;
+#endif /* NX_ENABLE_ARP_CACHE_HASH */
 
 
     /* If trace is enabled, insert this event into the trace buffer.  */
@@ -91,6 +100,31 @@ NX_ARP *entry_ptr;
     /* Determine how many ARP entries will fit in this cache area.  */
     arp_entries =  arp_cache_size / sizeof(NX_ARP);
 
+#ifdef NX_ENABLE_ARP_CACHE_HASH
+
+    /* Size the ARP hash table to the power of two that gives each entry a bucket.  */
+    table_size =  NX_ROUTE_TABLE_SIZE;
+    while (table_size < arp_entries)
+    {
+        table_size =  table_size << 1;
+    }
+
+    /* Determine if the default table in the IP instance is too small.  */
+    if (table_size > NX_ROUTE_TABLE_SIZE)
+    {
+
+        /* Yes, place the hash table at the start of the cache area and the ARP entries
+           after it.  */
+        ip_ptr -> nx_ip_arp_table =  (NX_ARP **)arp_cache_memory;
+        arp_cache_memory =  (VOID *)(ip_ptr -> nx_ip_arp_table + table_size);
+        entry_ptr =  (NX_ARP *)arp_cache_memory;
+        arp_entries =  (arp_cache_size - (table_size * sizeof(NX_ARP *))) / sizeof(NX_ARP);
+    }
+
+    /* Store the hash table mask.  */
+    ip_ptr -> nx_ip_arp_table_mask =  table_size - 1;
+#endif /* NX_ENABLE_ARP_CACHE_HASH */
+
     /* Setup the list head pointers in the IP instance.  At first all ARP
        entries are associated with the dynamic ARP list.  The static ARP list
        is NULL until static ARP entry calls are made.  */
@@ -143,6 +177,26 @@ NX_ARP *entry_ptr;
     /* Setup the ARP send packet routine.  */
     ip_ptr -> nx_ip_arp_packet_send =  _nx_arp_packet_send;
 
+#ifdef NX_ENABLE_ARP_PENDING_QUEUE
+
+    /* Setup the pending packet budgets.  By default at most half of the default packet
+       pool waits for ARP resolution.  */
+    ip_ptr -> nx_ip_arp_entry_queue_maximum =  NX_ARP_MAX_QUEUE_DEPTH;
+    ip_ptr -> nx_ip_arp_pending_maximum =      NX_ARP_PENDING_PACKETS_MAXIMUM;
+    if (ip_ptr -> nx_ip_arp_pending_maximum == 0)
+    {
+        ip_ptr -> nx_ip_arp_pending_maximum =  (ip_ptr -> nx_ip_default_packet_pool -> nx_packet_pool_total + 1) / 2;
+    }
+
+    /* Setup the ARP retransmit routine.  */
+    ip_ptr -> nx_ip_arp_retransmit_process =  _nx_arp_retransmit_process;
+
+    /* Create the ARP retransmit timer.  It is started by the first new entry.  */
+    tx_timer_create(&(ip_ptr -> nx_ip_arp_retransmit_timer), ip_ptr -> nx_ip_name,
+                    _nx_arp_retransmit_timer_entry, (ULONG)ip_ptr,
+                    NX_ARP_RETRANSMIT_INTERVAL, NX_ARP_RETRANSMIT_INTERVAL, TX_NO_ACTIVATE);
+#endif /* NX_ENABLE_ARP_PENDING_QUEUE */
+
     /* Setup the ARP allocate service request pointer.  */
     ip_ptr -> nx_ip_arp_allocate =  _nx_arp_entry_allocate;
 
@@ -72,6 +72,12 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            ARP eviction count, counted */
+/*                                            queued packets of evicted   */
+/*                                            entries as ARP resolution   */
+/*                                            drops, resulting in version */
+/*                                            6.x                         */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_arp_entry_allocate(NX_IP *ip_ptr, NX_ARP **arp_list_ptr)
@@ -130,12 +136,27 @@ NX_PACKET *next_packet_ptr;
             /* Decrease the number of active ARP entries.  */
             ip_ptr -> nx_ip_arp_dynamic_active_count--;
 
+#if defined(NX_ENABLE_ARP_CACHE_HASH) && !defined(NX_DISABLE_ARP_INFO)
+
+            /* Increment the count of active entries evicted from the ARP cache.  */
+            ip_ptr -> nx_ip_arp_cache_evictions++;
+#endif
+
             /* Pickup the queued packets head pointer.  */
             next_packet_ptr =  arp_entry -> nx_arp_packets_waiting;
 
             /* Clear the queued packets head pointer.  */
             arp_entry -> nx_arp_packets_waiting =  NX_NULL;
 
+#if defined(NX_ENABLE_ARP_PENDING_QUEUE) && !defined(NX_DISABLE_ARP_INFO)
+
+            /* Count the queued packets as dropped waiting for ARP resolution.  */
+            ip_ptr -> nx_ip_arp_resolution_drops +=  arp_entry -> nx_arp_packets_queued;
+#endif
+
+            /* Return the queued packets to the pending packet budget.  */
+            NX_ARP_QUEUE_CLEAR(ip_ptr, arp_entry)
+
             /* Restore interrupts.  */
             TX_RESTORE
 
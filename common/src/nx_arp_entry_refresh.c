@@ -0,0 +1,134 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Address Resolution Protocol (ARP)                                   */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_arp.h"
+
+
+#ifdef NX_ENABLE_ARP_CACHE_HASH
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_arp_entry_refresh                               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is called when a packet is sent with the physical     */
+/*    address of an ARP entry. It counts the cache hit and moves a        */
+/*    dynamic entry to the front of the dynamic ARP list, so the least    */
+/*    recently used entry is the one reused when the cache is full. If    */
+/*    the entry is stale, an ARP request is sent to probe it while the    */
+/*    entry stays in use.                                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                IP instance pointer           */
+/*    arp_ptr                               Pointer to ARP entry          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_arp_entry_state_set               Set ARP entry state           */
+/*    _nx_arp_packet_send                   Send ARP request              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_ip_driver_packet_send             Send IP packet to driver      */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_arp_entry_refresh(NX_IP *ip_ptr, NX_ARP *arp_ptr)
+{
+
+TX_INTERRUPT_SAVE_AREA
+
+
+#ifndef NX_DISABLE_ARP_INFO
+    /* Increment the ARP cache hit count.  */
+    ip_ptr -> nx_ip_arp_cache_hits++;
+#endif
+
+    /* Static entries are not on the dynamic list and never age.  */
+    if (arp_ptr -> nx_arp_route_static)
+    {
+        return;
+    }
+
+    /* Disable interrupts.  */
+    TX_DISABLE
+
+    /* Move this ARP entry to the front of the dynamic list.  */
+    if (arp_ptr != ip_ptr -> nx_ip_arp_dynamic_list)
+    {
+
+        /* Link up the neighbors first.  */
+        (arp_ptr -> nx_arp_pool_next) -> nx_arp_pool_previous =
+            arp_ptr -> nx_arp_pool_previous;
+        (arp_ptr -> nx_arp_pool_previous) -> nx_arp_pool_next =
+            arp_ptr -> nx_arp_pool_next;
+
+        /* Now link this ARP entry to the head of the list.  */
+        arp_ptr -> nx_arp_pool_next =  ip_ptr -> nx_ip_arp_dynamic_list;
+        arp_ptr -> nx_arp_pool_previous =    (arp_ptr -> nx_arp_pool_next) -> nx_arp_pool_previous;
+        (arp_ptr -> nx_arp_pool_previous) -> nx_arp_pool_next =  arp_ptr;
+        (arp_ptr -> nx_arp_pool_next) -> nx_arp_pool_previous =  arp_ptr;
+
+        /* Now set the list head to this ARP entry.  */
+        ip_ptr -> nx_ip_arp_dynamic_list =  arp_ptr;
+    }
+
+    /* Restore interrupts.  */
+    TX_RESTORE
+
+    /* Determine if the entry is stale.  */
+    if (arp_ptr -> nx_arp_state == NX_ARP_STATE_STALE)
+    {
+
+        /* Yes, probe the entry with the same retries as a new entry.  */
+        arp_ptr -> nx_arp_retries =  0;
+        _nx_arp_entry_state_set(ip_ptr, arp_ptr, NX_ARP_STATE_PROBE, NX_ARP_UPDATE_RATE);
+
+        /* Send the ARP request out.  */
+        _nx_arp_packet_send(ip_ptr, arp_ptr -> nx_arp_ip_address, arp_ptr -> nx_arp_ip_interface);
+    }
+}
+#endif /* NX_ENABLE_ARP_CACHE_HASH */
+
@@ -0,0 +1,152 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Address Resolution Protocol (ARP)                                   */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_arp.h"
+
+
+#ifdef NX_ENABLE_ARP_CACHE_HASH
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_arp_entry_state_set                             PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function sets the state of a dynamic ARP entry and places it   */
+/*    on the ARP timer wheel slot that is the specified number of seconds */
+/*    ahead of the current second. If the entry is already on the wheel,  */
+/*    it is moved. A timer of zero seconds leaves the entry off the       */
+/*    wheel. Timers longer than one revolution of the wheel are placed on */
+/*    the last slot of the revolution, and the seconds left are kept in   */
+/*    the update counter of the entry.                                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                IP instance pointer           */
+/*    arp_ptr                               Pointer to ARP entry          */
+/*    state                                 New state of the entry        */
+/*    seconds                               Seconds until the entry is    */
+/*                                            due                         */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_arp_timer_wheel_remove            Remove from timer wheel       */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_arp_dynamic_entry_set             Set dynamic ARP entry         */
+/*    _nx_arp_entry_refresh                 Refresh ARP entry on use      */
+/*    _nx_arp_packet_receive                Process received ARP packet   */
+/*    _nx_arp_periodic_update               Process ARP periodic update   */
+/*    _nx_ip_driver_packet_send             Send IP packet to driver      */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_arp_entry_state_set(NX_IP *ip_ptr, NX_ARP *arp_ptr, UINT state, UINT seconds)
+{
+
+ULONG index;
+
+
+    /* Determine if the entry is already on the timer wheel.  */
+    if (arp_ptr -> nx_arp_timer_next)
+    {
+
+        /* Yes, remove it first.  */
+        _nx_arp_timer_wheel_remove(ip_ptr, arp_ptr);
+    }
+
+    /* Setup the new state of the entry.  */
+    arp_ptr -> nx_arp_state =  state;
+
+    /* Determine if the entry has a timer.  */
+    if (seconds == 0)
+    {
+
+        /* No, the entry stays off the timer wheel.  */
+        arp_ptr -> nx_arp_entry_next_update =  0;
+        return;
+    }
+
+    /* Limit the timer to one revolution of the wheel and keep the seconds that are left.  */
+    if (seconds > NX_ARP_TIMER_WHEEL_MASK)
+    {
+        arp_ptr -> nx_arp_entry_next_update =  seconds - NX_ARP_TIMER_WHEEL_MASK;
+        seconds =  NX_ARP_TIMER_WHEEL_MASK;
+    }
+    else
+    {
+        arp_ptr -> nx_arp_entry_next_update =  0;
+    }
+
+    /* Remember the second the entry is to be processed on.  */
+    arp_ptr -> nx_arp_timer_expiration =  ip_ptr -> nx_ip_arp_timer_tick + seconds;
+
+    /* Calculate the slot of the timer wheel.  */
+    index =  arp_ptr -> nx_arp_timer_expiration & NX_ARP_TIMER_WHEEL_MASK;
+
+    /* Determine if the list is NULL.  */
+    if (ip_ptr -> nx_ip_arp_timer_wheel[index])
+    {
+
+        /* There are already entries on this list... just add this one
+           to the end.  */
+        arp_ptr -> nx_arp_timer_next =
+            ip_ptr -> nx_ip_arp_timer_wheel[index];
+        arp_ptr -> nx_arp_timer_previous =
+            (ip_ptr -> nx_ip_arp_timer_wheel[index]) -> nx_arp_timer_previous;
+        ((ip_ptr -> nx_ip_arp_timer_wheel[index]) -> nx_arp_timer_previous) -> nx_arp_timer_next =
+            arp_ptr;
+        (ip_ptr -> nx_ip_arp_timer_wheel[index]) -> nx_arp_timer_previous =   arp_ptr;
+    }
+    else
+    {
+
+        /* Nothing is on this slot.  Add this ARP entry to an empty list.  */
+        arp_ptr -> nx_arp_timer_next =      arp_ptr;
+        arp_ptr -> nx_arp_timer_previous =  arp_ptr;
+        ip_ptr -> nx_ip_arp_timer_wheel[index] =  arp_ptr;
+    }
+}
+#endif /* NX_ENABLE_ARP_CACHE_HASH */
+
@@ -0,0 +1,152 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Address Resolution Protocol (ARP)                                   */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_arp.h"
+#include "nx_packet.h"
+
+
+#ifdef NX_ENABLE_ARP_PENDING_QUEUE
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_arp_packet_queue                                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function queues a packet on an ARP entry that is waiting for   */
+/*    address resolution. The packet is released instead if the entry     */
+/*    already holds its maximum number of packets, or if the packets      */
+/*    queued on all entries of the IP instance reach their maximum.       */
+/*    Keeping the packets that were queued first preserves the start of a */
+/*    burst, such as a TCP connection request.                            */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                IP instance pointer           */
+/*    arp_ptr                               Pointer to ARP entry          */
+/*    packet_ptr                            Pointer to packet to queue    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_packet_transmit_release           Release transmit packet       */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_ip_driver_packet_send             Send IP packet to driver      */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_arp_packet_queue(NX_IP *ip_ptr, NX_ARP *arp_ptr, NX_PACKET *packet_ptr)
+{
+
+TX_INTERRUPT_SAVE_AREA
+NX_PACKET *last_packet;
+
+
+    /* Ensure the queue next pointer is NULL for the packet before it
+       is placed on the ARP waiting queue.  */
+    packet_ptr -> nx_packet_queue_next =  NX_NULL;
+
+    /* Disable interrupts.  */
+    TX_DISABLE
+
+    /* Determine if the packet is within the pending packet budgets.  */
+    if ((arp_ptr -> nx_arp_packets_queued >= ip_ptr -> nx_ip_arp_entry_queue_maximum) ||
+        (ip_ptr -> nx_ip_arp_pending_packets >= ip_ptr -> nx_ip_arp_pending_maximum))
+    {
+
+        /* No, restore interrupts.  */
+        TX_RESTORE
+
+#ifndef NX_DISABLE_IP_INFO
+
+        /* Increment the IP transmit resource error count.  */
+        ip_ptr -> nx_ip_transmit_resource_errors++;
+
+        /* Increment the IP send packets dropped count.  */
+        ip_ptr -> nx_ip_send_packets_dropped++;
+#endif /* !NX_DISABLE_IP_INFO */
+
+#ifndef NX_DISABLE_ARP_INFO
+
+        /* Increment the count of packets dropped while waiting for ARP resolution.  */
+        ip_ptr -> nx_ip_arp_resolution_drops++;
+#endif /* !NX_DISABLE_ARP_INFO */
+
+        /* Release the packet.  */
+        _nx_packet_transmit_release(packet_ptr);
+        return;
+    }
+
+    /* Determine if the queue is empty.  */
+    if (arp_ptr -> nx_arp_packets_waiting == NX_NULL)
+    {
+
+        /* Yes, simply place the packet at the head of the list.  */
+        arp_ptr -> nx_arp_packets_waiting =  packet_ptr;
+    }
+    else
+    {
+
+        /* Find the last packet in the queue.  */
+        last_packet =  arp_ptr -> nx_arp_packets_waiting;
+        while (last_packet -> nx_packet_queue_next)
+        {
+
+            /* Move to the next packet in the queue.  */
+            last_packet =  last_packet -> nx_packet_queue_next;
+        }
+
+        /* Place the packet at the end of the list.  */
+        last_packet -> nx_packet_queue_next =  packet_ptr;
+    }
+
+    /* Account for the packet in both budgets.  */
+    arp_ptr -> nx_arp_packets_queued++;
+    ip_ptr -> nx_ip_arp_pending_packets++;
+
+    /* Restore interrupts.  */
+    TX_RESTORE
+}
+#endif /* NX_ENABLE_ARP_PENDING_QUEUE */
+
@@ -60,6 +60,8 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _nx_arp_entry_state_set               Set ARP entry state           */
+/*    _nx_ip_gso_segment_send               Split TCP super-segment       */
 /*    _nx_packet_release                    Release the ARP request       */
 /*    _nx_packet_transmit_release           Release ARP queued packet     */
 /*    (nx_ip_arp_allocate)                  ARP entry allocate call       */
@@ -78,6 +80,14 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), sent     */
+/*                                            TCP super-segments without  */
+/*                                            fragmentation, added ARP    */
+/*                                            cache hash, returned queued */
+/*                                            packets to the ARP pending  */
+/*                                            packet budget, split TCP    */
+/*                                            super-segments in software, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_arp_packet_receive(NX_IP *ip_ptr, NX_PACKET *packet_ptr)
@@ -434,7 +444,7 @@ NX_INTERFACE *interface_ptr;
     {
 
         /* Calculate the hash index for the sender IP address.  */
-        index =  (UINT)((sender_ip + (sender_ip >> 8)) & NX_ROUTE_TABLE_MASK);
+        index =  NX_ARP_TABLE_INDEX(ip_ptr, sender_ip);
 
         /* Pickup the first ARP entry.  */
         arp_ptr =  ip_ptr -> nx_ip_arp_table[index];
@@ -486,7 +496,7 @@ NX_INTERFACE *interface_ptr;
 
             /* Set the update rate to the expiration rate since we now have an ARP
                response.  */
-            arp_ptr -> nx_arp_entry_next_update =  NX_ARP_EXPIRATION_RATE;
+            NX_ARP_ENTRY_STATE_SET(ip_ptr, arp_ptr, NX_ARP_STATE_REACHABLE, NX_ARP_EXPIRATION_RATE);
 
             /* Reset the retry counter for this ARP entry.  */
             arp_ptr -> nx_arp_retries =  0;
@@ -507,6 +517,9 @@ NX_INTERFACE *interface_ptr;
                 /* Pickup the packet pointer and clear the ARP queue pointer.  */
                 queued_list_head =  arp_ptr -> nx_arp_packets_waiting;
                 arp_ptr -> nx_arp_packets_waiting =  NX_NULL;
+
+                /* Return the queued packets to the pending packet budget.  */
+                NX_ARP_QUEUE_CLEAR(ip_ptr, arp_ptr)
             }
 
             /* Restore previous interrupt posture.  */
@@ -542,7 +555,7 @@ NX_INTERFACE *interface_ptr;
     {
 
         /* Calculate the hash index for the sender IP address.  */
-        index =  (UINT)((sender_ip + (sender_ip >> 8)) & NX_ROUTE_TABLE_MASK);
+        index =  NX_ARP_TABLE_INDEX(ip_ptr, sender_ip);
 
         /* Allocate a new ARP entry in advance of the need to send to the IP
            address.  */
@@ -556,9 +569,11 @@ NX_INTERFACE *interface_ptr;
             arp_ptr -> nx_arp_ip_address =            sender_ip;
             arp_ptr -> nx_arp_physical_address_msw =  sender_physical_msw;
             arp_ptr -> nx_arp_physical_address_lsw =  sender_physical_lsw;
-            arp_ptr -> nx_arp_entry_next_update =     NX_ARP_EXPIRATION_RATE;
             arp_ptr -> nx_arp_retries =               0;
             arp_ptr -> nx_arp_ip_interface =          interface_ptr;
+
+            /* Start the expiration timer of the new entry.  */
+            NX_ARP_ENTRY_STATE_SET(ip_ptr, arp_ptr, NX_ARP_STATE_REACHABLE, NX_ARP_EXPIRATION_RATE);
         }
     }
 #endif /* NX_DISABLE_ARP_AUTO_ENTRY */
@@ -584,8 +599,19 @@ NX_INTERFACE *interface_ptr;
         driver_request.nx_ip_driver_packet               =  packet_ptr;
         driver_request.nx_ip_driver_interface            =  packet_ptr -> nx_packet_ip_interface;
 
+#ifdef NX_ENABLE_TCP_GSO
+        /* Determine if the TCP super-segment must be split into segments in software.  */
+        if (NX_IP_GSO_NEEDED(packet_ptr))
+        {
+
+            /* Split the super-segment and send the segments.  */
+            _nx_ip_gso_segment_send(&driver_request);
+            continue;
+        }
+#endif /* NX_ENABLE_TCP_GSO */
+
         /* Determine if fragmentation is needed.  */
-        if (packet_ptr -> nx_packet_length > packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_mtu_size)
+        if (NX_IP_FRAGMENTATION_NEEDED(packet_ptr))
         {
 
             /* Fragmentation is needed, call the fragment routine if available. */
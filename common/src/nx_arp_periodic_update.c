@@ -47,6 +47,10 @@
 /*    through the dynamic ARP list to see if another ARP request needs to */
 /*    sent.                                                               */
 /*                                                                        */
+/*    If NX_ENABLE_ARP_CACHE_HASH is defined, only the entries on the     */
+/*    ARP timer wheel slot of this second are processed.  Expired         */
+/*    reachable entries become stale instead of being probed.             */
+/*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
 /*    ip_address                            IP address in a ULONG         */
@@ -57,7 +61,9 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _nx_arp_entry_state_set               Set ARP entry state           */
 /*    _nx_arp_packet_send                   Send periodic ARP request out */
+/*    _nx_arp_timer_wheel_remove            Remove from timer wheel       */
 /*    _nx_packet_transmit_release           Release queued packet         */
 /*                                                                        */
 /*  CALLED BY                                                             */
@@ -71,6 +77,12 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            ARP timer wheel, counted    */
+/*                                            queued packets of aged      */
+/*                                            entries as ARP resolution   */
+/*                                            drops, resulting in version */
+/*                                            6.x                         */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_arp_periodic_update(NX_IP *ip_ptr)
@@ -82,7 +94,210 @@ ULONG      i;
 NX_ARP    *arp_entry;
 NX_PACKET *packet_ptr;
 NX_PACKET *next_packet_ptr;
+#ifdef NX_ENABLE_ARP_CACHE_HASH
+ULONG      index;
+#endif /* NX_ENABLE_ARP_CACHE_HASH */
+
+
+#ifdef NX_ENABLE_ARP_CACHE_HASH
+
+    /* Advance the ARP timer wheel by one second.  */
+    ip_ptr -> nx_ip_arp_timer_tick++;
+
+    /* Calculate the slot of the timer wheel for this second.  */
+    index =  ip_ptr -> nx_ip_arp_timer_tick & NX_ARP_TIMER_WHEEL_MASK;
+
+    /* Loop through the ARP entries due on this second.  Each entry is removed before it is
+       processed and placed on a later slot if its timer is started again, so the loop ends
+       once the slot is empty.  */
+    while (ip_ptr -> nx_ip_arp_timer_wheel[index])
+    {
+
+        /* Pickup the first entry on this slot and remove it from the wheel.  */
+        arp_entry =  ip_ptr -> nx_ip_arp_timer_wheel[index];
+        _nx_arp_timer_wheel_remove(ip_ptr, arp_entry);
+
+        /* Skip entries that were released or made static after their timer was started.  */
+        if ((arp_entry -> nx_arp_active_list_head == NX_NULL) || (arp_entry -> nx_arp_route_static))
+        {
+            continue;
+        }
+
+        /* Determine if the timer expires after this revolution of the wheel.  */
+        if (arp_entry -> nx_arp_entry_next_update)
+        {
+
+            /* Yes, place the entry on the wheel again for the seconds that are left.  */
+            _nx_arp_entry_state_set(ip_ptr, arp_entry, arp_entry -> nx_arp_state, arp_entry -> nx_arp_entry_next_update);
+            continue;
+        }
+
+        /* Determine if a reachable entry has expired.  */
+        if (arp_entry -> nx_arp_state == NX_ARP_STATE_REACHABLE)
+        {
+
+            /* Yes, the entry becomes stale.  It stays in use and is probed when the next
+               packet is sent to it, so idle entries cause no ARP traffic.  */
+            _nx_arp_entry_state_set(ip_ptr, arp_entry, NX_ARP_STATE_STALE, 0);
+            continue;
+        }
+
+        /* The entry is incomplete or being probed, and no ARP response arrived in time.  */
+        if (arp_entry -> nx_arp_retries == NX_ARP_MAXIMUM_RETRIES)
+        {
+
+            /* The number of retries has been exceeded. The entry is removed
+               from the active list and any queued packet is released.  */
+
+            /* Disable interrupts.  */
+            TX_DISABLE
+
+            /* Determine if this is the only ARP entry on the list.  */
+            if (arp_entry == arp_entry -> nx_arp_active_next)
+            {
+
+                /* Remove the entry from the list.  */
+                *(arp_entry -> nx_arp_active_list_head) =  NX_NULL;
+            }
+            else
+            {
+
+                /* Remove the entry from a list of more than one entry.  */
+
+                /* Update the list head pointer.  */
+                if (*(arp_entry -> nx_arp_active_list_head) == arp_entry)
+                {
+                    *(arp_entry -> nx_arp_active_list_head) =  arp_entry -> nx_arp_active_next;
+                }
+
+                /* Update the links of the adjacent ARP entries.  */
+                (arp_entry -> nx_arp_active_next) -> nx_arp_active_previous =
+                    arp_entry -> nx_arp_active_previous;
+                (arp_entry -> nx_arp_active_previous) -> nx_arp_active_next =
+                    arp_entry -> nx_arp_active_next;
+            }
+
+            /* Decrease the number of active ARP entries.  */
+            ip_ptr -> nx_ip_arp_dynamic_active_count--;
+
+            /* Clear the active head pointer.  */
+            arp_entry -> nx_arp_active_list_head =  NX_NULL;
+
+            /* Remove from its current position in the dynamic list.  */
+
+            /* Determine if this is the only ARP entry on the dynamic list.  */
+            if (arp_entry == arp_entry -> nx_arp_pool_next)
+            {
+
+                /* Remove the sole entry from the dynamic list head.  */
+                ip_ptr -> nx_ip_arp_dynamic_list =  NX_NULL;
+            }
+            else
+            {
 
+                /* Remove the entry from a list of more than one entry.  */
+
+                /* Update the links of the adjacent ARP dynamic pool entries.  */
+                (arp_entry -> nx_arp_pool_next) -> nx_arp_pool_previous =
+                    arp_entry -> nx_arp_pool_previous;
+                (arp_entry -> nx_arp_pool_previous) -> nx_arp_pool_next =
+                    arp_entry -> nx_arp_pool_next;
+
+                /* Update the list head pointer.  */
+                if (ip_ptr -> nx_ip_arp_dynamic_list == arp_entry)
+                {
+                    ip_ptr -> nx_ip_arp_dynamic_list =  arp_entry -> nx_arp_pool_next;
+                }
+            }
+
+            /* Place the ARP entry at the end of the dynamic ARP pool, which is where new
+               ARP requests are allocated from.  */
+
+            /* Determine if the dynamic ARP pool is empty.  */
+            if (ip_ptr -> nx_ip_arp_dynamic_list)
+            {
+
+                /* Dynamic list is not empty, add ARP entry to the end of the list.  */
+                arp_entry -> nx_arp_pool_next =
+                    ip_ptr -> nx_ip_arp_dynamic_list;
+                arp_entry -> nx_arp_pool_previous =
+                    (ip_ptr -> nx_ip_arp_dynamic_list) -> nx_arp_pool_previous;
+                ((ip_ptr -> nx_ip_arp_dynamic_list) -> nx_arp_pool_previous) -> nx_arp_pool_next =
+                    arp_entry;
+                (ip_ptr -> nx_ip_arp_dynamic_list) -> nx_arp_pool_previous =   arp_entry;
+            }
+            else
+            {
+
+                /* Dynamic list was empty, just place it at the head of the dynamic list.  */
+                ip_ptr -> nx_ip_arp_dynamic_list =  arp_entry;
+                arp_entry -> nx_arp_pool_next =     arp_entry;
+                arp_entry -> nx_arp_pool_previous = arp_entry;
+            }
+
+            /* Pickup the queued packets head pointer.  */
+            next_packet_ptr =  arp_entry -> nx_arp_packets_waiting;
+
+            /* Clear the queued packets head pointer.  */
+            arp_entry -> nx_arp_packets_waiting =  NX_NULL;
+
+#if defined(NX_ENABLE_ARP_PENDING_QUEUE) && !defined(NX_DISABLE_ARP_INFO)
+
+            /* Count the queued packets as dropped waiting for ARP resolution.  */
+            ip_ptr -> nx_ip_arp_resolution_drops +=  arp_entry -> nx_arp_packets_queued;
+#endif
+
+            /* Return the queued packets to the pending packet budget.  */
+            NX_ARP_QUEUE_CLEAR(ip_ptr, arp_entry)
+
+            /* Restore interrupts.  */
+            TX_RESTORE
+
+#ifndef NX_DISABLE_ARP_INFO
+
+            /* Increment the ARP aged entries count.  */
+            ip_ptr -> nx_ip_arp_aged_entries++;
+#endif
+
+            /* Loop to remove all queued packets.  */
+            while (next_packet_ptr)
+            {
+
+                /* Pickup the packet pointer at the head of the queue.  */
+                packet_ptr =  next_packet_ptr;
+
+                /* Move to the next packet in the queue.  */
+                next_packet_ptr =  next_packet_ptr -> nx_packet_queue_next;
+
+                /* Clear the next packet queue pointer.  */
+                packet_ptr -> nx_packet_queue_next =  NX_NULL;
+
+#ifndef NX_DISABLE_IP_INFO
+
+                /* Increment the IP send packets dropped count.  */
+                ip_ptr -> nx_ip_send_packets_dropped++;
+#endif
+
+                /* Release the packet that was queued for the expired ARP entry.  */
+                _nx_packet_transmit_release(packet_ptr);
+            }
+        }
+        else
+        {
+
+            /* We haven't yet had a response to this ARP request so send it again!  */
+
+            /* Increment the ARP retry counter.  */
+            arp_entry -> nx_arp_retries++;
+
+            /* Setup the ARP update rate to the maximum value again.  */
+            _nx_arp_entry_state_set(ip_ptr, arp_entry, arp_entry -> nx_arp_state, NX_ARP_UPDATE_RATE);
+
+            /* Send the ARP request out.  */
+            _nx_arp_packet_send(ip_ptr, arp_entry -> nx_arp_ip_address, arp_entry -> nx_arp_ip_interface);
+        }
+    }
+#else
 
     /* Pickup pointer to ARP dynamic list.  */
     arp_entry =  ip_ptr -> nx_ip_arp_dynamic_list;
@@ -209,6 +424,15 @@ NX_PACKET *next_packet_ptr;
                     /* Clear the queued packets head pointer.  */
                     arp_entry -> nx_arp_packets_waiting =  NX_NULL;
 
+#if defined(NX_ENABLE_ARP_PENDING_QUEUE) && !defined(NX_DISABLE_ARP_INFO)
+
+                    /* Count the queued packets as dropped waiting for ARP resolution.  */
+                    ip_ptr -> nx_ip_arp_resolution_drops +=  arp_entry -> nx_arp_packets_queued;
+#endif
+
+                    /* Return the queued packets to the pending packet budget.  */
+                    NX_ARP_QUEUE_CLEAR(ip_ptr, arp_entry)
+
                     /* Restore interrupts.  */
                     TX_RESTORE
 
@@ -255,6 +479,7 @@ NX_PACKET *next_packet_ptr;
         /* Move to the next ARP entry.  */
         arp_entry =  arp_entry -> nx_arp_pool_next;
     }
+#endif /* NX_ENABLE_ARP_CACHE_HASH */
 
     /* Reduce the defend timeout of interfaces.  */
     for (i = 0; i < NX_MAX_PHYSICAL_INTERFACES; i++)
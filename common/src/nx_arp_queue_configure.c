@@ -0,0 +1,101 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Address Resolution Protocol (ARP)                                   */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_arp.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_arp_queue_configure                             PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function sets the maximum number of packets that can be queued */
+/*    on one ARP entry while waiting for address resolution, and the      */
+/*    maximum number of such packets on all entries of the IP instance.   */
+/*    Packets already queued are kept.                                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                Pointer to IP instance        */
+/*    entry_queue_maximum                   Maximum packets queued on one */
+/*                                            entry                       */
+/*    total_queue_maximum                   Maximum packets queued on all */
+/*                                            entries                     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    tx_mutex_get                          Obtain protection mutex       */
+/*    tx_mutex_put                          Release protection mutex      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_arp_queue_configure(NX_IP *ip_ptr, ULONG entry_queue_maximum, ULONG total_queue_maximum)
+{
+#ifdef NX_ENABLE_ARP_PENDING_QUEUE
+
+    /* Obtain protection on this IP instance.  */
+    tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
+
+    /* Setup the new pending packet budgets.  */
+    ip_ptr -> nx_ip_arp_entry_queue_maximum =  entry_queue_maximum;
+    ip_ptr -> nx_ip_arp_pending_maximum =      total_queue_maximum;
+
+    /* Release the protection.  */
+    tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+    /* Return status to the caller.  */
+    return(NX_SUCCESS);
+#else
+    NX_PARAMETER_NOT_USED(ip_ptr);
+    NX_PARAMETER_NOT_USED(entry_queue_maximum);
+    NX_PARAMETER_NOT_USED(total_queue_maximum);
+
+    /* Return an error.  */
+    return(NX_NOT_ENABLED);
+#endif /* NX_ENABLE_ARP_PENDING_QUEUE */
+}
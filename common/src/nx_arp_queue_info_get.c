@@ -0,0 +1,114 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Address Resolution Protocol (ARP)                                   */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_arp.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_arp_queue_info_get                              PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function retrieves the number of packets of the specified IP   */
+/*    instance that are currently queued while waiting for ARP            */
+/*    resolution, and the number of packets dropped because they could    */
+/*    not be queued or because resolution failed.                         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                Pointer to IP instance        */
+/*    packets_queued                        Destination for packets       */
+/*                                            queued                      */
+/*    resolution_drops                      Destination for packets       */
+/*                                            dropped waiting for         */
+/*                                            resolution                  */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    tx_mutex_get                          Obtain protection mutex       */
+/*    tx_mutex_put                          Release protection mutex      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_arp_queue_info_get(NX_IP *ip_ptr, ULONG *packets_queued, ULONG *resolution_drops)
+{
+#ifdef NX_ENABLE_ARP_PENDING_QUEUE
+
+    /* Obtain protection on this IP instance.  */
+    tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
+
+    /* Determine if packets queued is wanted.  */
+    if (packets_queued)
+    {
+
+        /* Return the number of packets waiting for ARP resolution.  */
+        *packets_queued =  ip_ptr -> nx_ip_arp_pending_packets;
+    }
+
+    /* Determine if resolution drops is wanted.  */
+    if (resolution_drops)
+    {
+
+        /* Return the number of packets dropped waiting for ARP resolution.  */
+        *resolution_drops =  ip_ptr -> nx_ip_arp_resolution_drops;
+    }
+
+    /* Release the protection.  */
+    tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+    /* Return status to the caller.  */
+    return(NX_SUCCESS);
+#else
+    NX_PARAMETER_NOT_USED(ip_ptr);
+    NX_PARAMETER_NOT_USED(packets_queued);
+    NX_PARAMETER_NOT_USED(resolution_drops);
+
+    /* Return an error.  */
+    return(NX_NOT_ENABLED);
+#endif /* NX_ENABLE_ARP_PENDING_QUEUE */
+}
@@ -0,0 +1,157 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Address Resolution Protocol (ARP)                                   */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_arp.h"
+
+
+#ifdef NX_ENABLE_ARP_PENDING_QUEUE
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_arp_retransmit_process                          PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is called by the IP helper thread when the ARP        */
+/*    retransmit timer expires. It sends another ARP request for each     */
+/*    unresolved dynamic entry whose next fast retransmit is due, and     */
+/*    doubles the interval to the following one. Once no entry has fast   */
+/*    retransmits left, the timer is stopped and further retries are left */
+/*    to the periodic ARP update.                                         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                IP instance pointer           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    tx_time_get                           Get current time              */
+/*    tx_timer_deactivate                   Deactivate timer              */
+/*    _nx_arp_packet_send                   Send ARP request              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_ip_thread_entry                   IP helper thread              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_arp_retransmit_process(NX_IP *ip_ptr)
+{
+
+ULONG   current_time;
+ULONG   active_count;
+UINT    pending;
+NX_ARP *arp_entry;
+
+
+    /* Pickup the current time.  */
+    current_time =  tx_time_get();
+
+    /* No entry has fast retransmits left so far.  */
+    pending =  NX_FALSE;
+
+    /* Setup the starting entry and the number of active entries to visit.  */
+    arp_entry =     ip_ptr -> nx_ip_arp_dynamic_list;
+    active_count =  ip_ptr -> nx_ip_arp_dynamic_active_count;
+
+    /* Loop through the active dynamic ARP entries.  */
+    while (active_count)
+    {
+
+        /* Determine if this ARP entry is active.  */
+        if (arp_entry -> nx_arp_active_list_head)
+        {
+
+            /* Yes, one less active entry to visit.  */
+            active_count--;
+
+            /* Determine if the entry is unresolved and has fast retransmits left.  */
+            if ((arp_entry -> nx_arp_retransmit_remaining) &&
+                ((arp_entry -> nx_arp_physical_address_msw | arp_entry -> nx_arp_physical_address_lsw) == 0))
+            {
+
+                /* Determine if the next retransmit is due.  */
+                if ((LONG)(current_time - arp_entry -> nx_arp_retransmit_time) >= 0)
+                {
+
+                    /* Yes, one less retransmit is left.  */
+                    arp_entry -> nx_arp_retransmit_remaining--;
+
+                    /* Double the interval to the next retransmit.  */
+                    arp_entry -> nx_arp_retransmit_time =  current_time +
+                        ((ULONG)NX_ARP_RETRANSMIT_INTERVAL << (NX_ARP_RETRANSMIT_MAXIMUM - arp_entry -> nx_arp_retransmit_remaining));
+
+                    /* Send the ARP request out.  */
+                    _nx_arp_packet_send(ip_ptr, arp_entry -> nx_arp_ip_address, arp_entry -> nx_arp_ip_interface);
+                }
+
+                /* Determine if the entry still has fast retransmits left.  */
+                if (arp_entry -> nx_arp_retransmit_remaining)
+                {
+
+                    /* Yes, keep the timer running.  */
+                    pending =  NX_TRUE;
+                }
+            }
+        }
+
+        /* Move to the next dynamic entry.  */
+        arp_entry =  arp_entry -> nx_arp_pool_next;
+
+        /* Determine if we are back at the start of the dynamic list.  */
+        if (arp_entry == ip_ptr -> nx_ip_arp_dynamic_list)
+        {
+            break;
+        }
+    }
+
+    /* Determine if the ARP retransmit timer is still needed.  */
+    if (pending == NX_FALSE)
+    {
+
+        /* No, stop it until the next new entry.  */
+        tx_timer_deactivate(&(ip_ptr -> nx_ip_arp_retransmit_timer));
+    }
+}
+#endif /* NX_ENABLE_ARP_PENDING_QUEUE */
+
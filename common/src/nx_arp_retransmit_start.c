@@ -0,0 +1,87 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Address Resolution Protocol (ARP)                                   */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_arp.h"
+
+
+#ifdef NX_ENABLE_ARP_PENDING_QUEUE
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_arp_retransmit_start                            PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function sets up the fast ARP retransmits of a dynamic ARP     */
+/*    entry that has just sent its first ARP request, and starts the ARP  */
+/*    retransmit timer of the IP instance if it is not already running.   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                IP instance pointer           */
+/*    arp_ptr                               Pointer to ARP entry          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    tx_time_get                           Get current time              */
+/*    tx_timer_activate                     Activate timer                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_arp_dynamic_entry_set             Set dynamic ARP entry         */
+/*    _nx_ip_driver_packet_send             Send IP packet to driver      */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_arp_retransmit_start(NX_IP *ip_ptr, NX_ARP *arp_ptr)
+{
+
+    /* Setup the number of fast ARP retransmits and the time of the first one.  */
+    arp_ptr -> nx_arp_retransmit_remaining =  NX_ARP_RETRANSMIT_MAXIMUM;
+    arp_ptr -> nx_arp_retransmit_time =       tx_time_get() + NX_ARP_RETRANSMIT_INTERVAL;
+
+    /* Start the ARP retransmit timer.  Nothing happens if it is already running.  */
+    tx_timer_activate(&(ip_ptr -> nx_ip_arp_retransmit_timer));
+}
+#endif /* NX_ENABLE_ARP_PENDING_QUEUE */
+
@@ -76,6 +76,11 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            ARP cache hash, returned    */
+/*                                            queued packets to the ARP   */
+/*                                            pending packet budget,      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_arp_static_entry_create(NX_IP *ip_ptr, ULONG ip_address,
@@ -164,6 +169,9 @@ ULONG         next_hop_address;
 
             /* Clear the queued packets head pointer.  */
             arp_entry -> nx_arp_packets_waiting =  NX_NULL;
+
+            /* Return the queued packets to the pending packet budget.  */
+            NX_ARP_QUEUE_CLEAR(ip_ptr, arp_entry)
         }
 
         /* Remove this entry from the ARP dynamic list.  */
@@ -220,7 +228,7 @@ ULONG         next_hop_address;
         }
 
         /* Calculate the hash index for the IP address.  */
-        index =  (UINT)((ip_address + (ip_address >> 8)) & NX_ROUTE_TABLE_MASK);
+        index =  NX_ARP_TABLE_INDEX(ip_ptr, ip_address);
 
         /* Indicate the entry does not need updating.  */
         arp_entry -> nx_arp_entry_next_update =  0;
@@ -0,0 +1,122 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Address Resolution Protocol (ARP)                                   */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_arp.h"
+
+
+#ifdef NX_ENABLE_ARP_CACHE_HASH
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_arp_timer_wheel_remove                          PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function removes an ARP entry from the ARP timer wheel, if it  */
+/*    is on the wheel.                                                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                IP instance pointer           */
+/*    arp_ptr                               Pointer to ARP entry          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_arp_entry_state_set               Set ARP entry state           */
+/*    _nx_arp_periodic_update               Process ARP periodic update   */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_arp_timer_wheel_remove(NX_IP *ip_ptr, NX_ARP *arp_ptr)
+{
+
+ULONG index;
+
+
+    /* Determine if the entry is on the timer wheel.  */
+    if (arp_ptr -> nx_arp_timer_next == NX_NULL)
+    {
+
+        /* No, nothing to do.  */
+        return;
+    }
+
+    /* Calculate the slot of the timer wheel the entry is on.  */
+    index =  arp_ptr -> nx_arp_timer_expiration & NX_ARP_TIMER_WHEEL_MASK;
+
+    /* Determine if this is the only entry on the list.  */
+    if (arp_ptr == arp_ptr -> nx_arp_timer_next)
+    {
+
+        /* Yes, this is the only entry on the list.  Clear the list head pointer.  */
+        ip_ptr -> nx_ip_arp_timer_wheel[index] =  NX_NULL;
+    }
+    else
+    {
+
+        /* Otherwise, there are multiple entries on this list.  Remove just
+           this entry from the list.  */
+        (arp_ptr -> nx_arp_timer_previous) -> nx_arp_timer_next =
+            arp_ptr -> nx_arp_timer_next;
+        (arp_ptr -> nx_arp_timer_next) -> nx_arp_timer_previous =
+            arp_ptr -> nx_arp_timer_previous;
+
+        /* Determine if the head of the list needs to be updated.  */
+        if (ip_ptr -> nx_ip_arp_timer_wheel[index] == arp_ptr)
+        {
+
+            /* Yes, update the head pointer.  */
+            ip_ptr -> nx_ip_arp_timer_wheel[index] =  arp_ptr -> nx_arp_timer_next;
+        }
+    }
+
+    /* Clear the timer wheel list pointers.  */
+    arp_ptr -> nx_arp_timer_next =      NX_NULL;
+    arp_ptr -> nx_arp_timer_previous =  NX_NULL;
+}
+#endif /* NX_ENABLE_ARP_CACHE_HASH */
+
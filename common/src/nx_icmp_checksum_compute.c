@@ -26,6 +26,7 @@
 /* Include necessary system files.  */
 
 #include "nx_api.h"
+#include "nx_ip.h"
 #include "nx_icmp.h"
 
 #if (!defined(NX_DISABLE_ICMP_TX_CHECKSUM) || !defined(NX_DISABLE_ICMP_RX_CHECKSUM))
@@ -54,7 +55,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    None                                                                */
+/*    _nx_ip_checksum_compute               Compute IP checksum           */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -67,118 +68,16 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), used     */
+/*                                            shared checksum engine,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 ULONG  _nx_icmp_checksum_compute(NX_PACKET *packet_ptr)
 {
 
-ULONG      checksum =  0;
-ULONG      long_temp;
-USHORT     short_temp;
-ULONG      length;
-UCHAR     *word_ptr;
-NX_PACKET *current_packet;
-
-
-    /* Setup the length of the packet checksum.  */
-    length =  packet_ptr -> nx_packet_length;
-
-    /* Determine if we need to add a padding byte.  */
-    if (((length / sizeof(USHORT)) * sizeof(USHORT)) != length)
-    {
-
-        /* We have single byte alignment and we need two byte alignment.  */
-        length++;
-
-        /* Determine if there is a last packet pointer.  */
-        if (packet_ptr -> nx_packet_last)
-        {
-
-            /* Multi-packet message, add a zero byte at the end.  */
-            *((packet_ptr -> nx_packet_last) -> nx_packet_append_ptr) =  0;
-        }
-        else
-        {
-
-            /* Write a zero byte at the end of the first and only packet.  */
-            *(packet_ptr -> nx_packet_append_ptr) =  0;
-        }
-    }
-
-    /* Setup the pointer to the start of the packet.  */
-    word_ptr =  (UCHAR *)packet_ptr -> nx_packet_prepend_ptr;
-
-    /* Initialize the current packet to the input packet pointer.  */
-    current_packet =  packet_ptr;
-
-    /* Loop to calculate the packet's checksum.  */
-    while (length)
-    {
-
-        /* Determine if there is at least one ULONG left.  */
-        if ((UINT)(current_packet -> nx_packet_append_ptr - word_ptr) >= sizeof(ULONG))
-        {
-
-            /* Pickup a whole ULONG.  */
-            long_temp =  *((ULONG *)word_ptr);
-
-            /* Endian swapping logic.  If NX_LITTLE_ENDIAN is specified, these macros will
-               swap the endian of the ICMP word.  */
-            NX_CHANGE_ULONG_ENDIAN(long_temp);
-
-            /* Add upper 16-bits into checksum.  */
-            checksum =  checksum + (long_temp >> NX_SHIFT_BY_16);
-
-            /* Add lower 16-bits into checksum.  */
-            checksum =  checksum + (long_temp & NX_LOWER_16_MASK);
-
-            /* Move the word pointer and decrease the length.  */
-            word_ptr =  word_ptr + sizeof(ULONG);
-            length = length - sizeof(ULONG);
-        }
-        else
-        {
-
-            /* Pickup the 16-bit word.  */
-            short_temp =  *((USHORT *)word_ptr);
-
-            /* Endian swapping logic.  If NX_LITTLE_ENDIAN is specified, these macros will
-               swap the endian of the ICMP word.  */
-            NX_CHANGE_USHORT_ENDIAN(short_temp);
-
-            /* Add next 16-bit word into checksum.  */
-            checksum =  checksum + short_temp;
-
-            /* Move the word pointer and decrease the length.  */
-            word_ptr =  word_ptr + sizeof(USHORT);
-            length = length - sizeof(USHORT);
-        }
-
-        /* Determine if we are at the end of the current packet.  */
-        if ((word_ptr >= (UCHAR *)current_packet -> nx_packet_append_ptr) &&
-            (current_packet -> nx_packet_next))
-        {
-
-            /* We have crossed the packet boundary.  Move to the next packet
-               structure.  */
-            current_packet =  current_packet -> nx_packet_next;
-
-            /* Setup the new word pointer.  */
-            word_ptr =  (UCHAR *)current_packet -> nx_packet_prepend_ptr;
-        }
-    }
-
-    /* Add in the carry bits into the checksum.  */
-    checksum = (checksum >> NX_SHIFT_BY_16) + (checksum & NX_LOWER_16_MASK);
-
-    /* Do it again in case previous operation generates an overflow.  */
-    checksum = (checksum >> NX_SHIFT_BY_16) + (checksum & NX_LOWER_16_MASK);
-
-    /* Mask off the upper 16-bits.  */
-    checksum =  checksum & NX_LOWER_16_MASK;
-
-    /* Return the computed checksum.  */
-    return(checksum);
+    /* ICMP has no pseudo header, simply sum the whole message.  */
+    return(_nx_ip_checksum_compute(packet_ptr, NX_IP_ICMP, packet_ptr -> nx_packet_length, 0, 0));
 }
 #endif
 
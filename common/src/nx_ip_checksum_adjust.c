@@ -0,0 +1,94 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_checksum_adjust                              PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function incrementally updates a 16-bit ones complement        */
+/*    checksum after a single 16-bit field covered by it has changed from */
+/*    old_value to new_value, as described in RFC 1624 (HC' = ~(~HC + ~m  */
+/*    + m')).  This avoids recomputing the checksum over the whole packet */
+/*    when a header field such as TTL, a port or a window is rewritten.   */
+/*    All values are in the same byte order as the checksum field.        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    checksum                              Current checksum field        */
+/*    old_value                             Original 16-bit field value   */
+/*    new_value                             New 16-bit field value        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    checksum                              Updated checksum field        */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_ip_forward_packet_process         Forward IP packet             */
+/*    _nx_tcp_socket_retransmit             Retransmit TCP packets        */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _nx_ip_checksum_adjust(ULONG checksum, ULONG old_value, ULONG new_value)
+{
+
+ULONG sum;
+
+
+    /* Sum the complement of the old checksum and old value with the new value.  */
+    sum =  ((~checksum) & NX_LOWER_16_MASK) + ((~old_value) & NX_LOWER_16_MASK) + (new_value & NX_LOWER_16_MASK);
+
+    /* Add in the carry bits.  */
+    sum =  (sum >> NX_SHIFT_BY_16) + (sum & NX_LOWER_16_MASK);
+
+    /* Do it again in case previous operation generates an overflow.  */
+    sum =  (sum >> NX_SHIFT_BY_16) + (sum & NX_LOWER_16_MASK);
+
+    /* Return the complement of the sum as the new checksum field.  */
+    return((~sum) & NX_LOWER_16_MASK);
+}
@@ -0,0 +1,98 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_checksum_adjust_long                         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function incrementally updates a 16-bit ones complement        */
+/*    checksum after a 32-bit field covered by it (such as an IP address  */
+/*    or a TCP sequence or acknowledgment number) has changed from        */
+/*    old_value to new_value, as described in RFC 1624.  Both 16-bit      */
+/*    halves of the field are folded into the update at once.  All values */
+/*    are in the same byte order as the checksum field.                   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    checksum                              Current checksum field        */
+/*    old_value                             Original 32-bit field value   */
+/*    new_value                             New 32-bit field value        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    checksum                              Updated checksum field        */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_socket_retransmit             Retransmit TCP packets        */
+/*    _nx_tcp_socket_send                   Send TCP data                 */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _nx_ip_checksum_adjust_long(ULONG checksum, ULONG old_value, ULONG new_value)
+{
+
+ULONG sum;
+
+
+    /* Sum the complement of the old checksum and both halves of the old value.  */
+    sum =  ((~checksum) & NX_LOWER_16_MASK) +
+           ((~old_value) >> NX_SHIFT_BY_16) + ((~old_value) & NX_LOWER_16_MASK);
+
+    /* Add both halves of the new value.  */
+    sum +=  (new_value >> NX_SHIFT_BY_16) + (new_value & NX_LOWER_16_MASK);
+
+    /* Add in the carry bits.  */
+    sum =  (sum >> NX_SHIFT_BY_16) + (sum & NX_LOWER_16_MASK);
+
+    /* Do it again in case previous operation generates an overflow.  */
+    sum =  (sum >> NX_SHIFT_BY_16) + (sum & NX_LOWER_16_MASK);
+
+    /* Return the complement of the sum as the new checksum field.  */
+    return((~sum) & NX_LOWER_16_MASK);
+}
@@ -0,0 +1,446 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+
+
+/* Define the type of the 64-bit checksum accumulators.  ULONG64 is not defined by every
+   ThreadX port, so a port without unsigned long long can supply its own 64-bit unsigned
+   type through NX_IP_CHECKSUM_ULONG64.  */
+#ifndef NX_IP_CHECKSUM_ULONG64
+#define NX_IP_CHECKSUM_ULONG64  unsigned long long
+#endif /* NX_IP_CHECKSUM_ULONG64 */
+
+typedef NX_IP_CHECKSUM_ULONG64 NX_IP_CHECKSUM_SUM;
+
+#ifdef NX_ENABLE_IP_CHECKSUM_SIMD
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define NX_IP_CHECKSUM_AVX2
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define NX_IP_CHECKSUM_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define NX_IP_CHECKSUM_NEON
+#endif
+#endif /* NX_ENABLE_IP_CHECKSUM_SIMD */
+
+
+/* Define how a lone byte is positioned inside a native 16-bit word.  A byte that
+   starts a 16-bit word in network order is the high byte on the wire, which is the
+   low byte of a little endian load.  */
+#ifdef NX_LITTLE_ENDIAN
+#define NX_IP_CHECKSUM_FIRST_BYTE(b)     ((ULONG)(b))
+#define NX_IP_CHECKSUM_SECOND_BYTE(b)    (((ULONG)(b)) << 8)
+#else
+#define NX_IP_CHECKSUM_FIRST_BYTE(b)     (((ULONG)(b)) << 8)
+#define NX_IP_CHECKSUM_SECOND_BYTE(b)    ((ULONG)(b))
+#endif /* NX_LITTLE_ENDIAN */
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_checksum_fold                                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function folds a 64-bit one's complement accumulator down to   */
+/*    16 bits.                                                            */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    sum                                   64-bit accumulator            */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    sum                                   Folded 16-bit sum             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_ip_checksum_buffer_sum            Sum a contiguous buffer       */
+/*    _nx_ip_checksum_compute               Compute packet checksum       */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+static ULONG _nx_ip_checksum_fold(NX_IP_CHECKSUM_SUM sum)
+{
+
+    /* Fold the upper 32 bits into the lower 32 bits, twice to absorb the carry.  */
+    sum =  (sum >> 32) + (sum & 0xFFFFFFFF);
+    sum =  (sum >> 32) + (sum & 0xFFFFFFFF);
+
+    /* Now fold down to 16 bits, again twice to absorb the carry.  */
+    sum =  (sum >> NX_SHIFT_BY_16) + (sum & NX_LOWER_16_MASK);
+    sum =  (sum >> NX_SHIFT_BY_16) + (sum & NX_LOWER_16_MASK);
+
+    return((ULONG)sum);
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_checksum_buffer_sum                          PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function computes the one's complement sum of a contiguous     */
+/*    buffer.  Words are added in native byte order; the caller swaps     */
+/*    the folded result once at the very end.  The buffer is only read,   */
+/*    a trailing odd byte is padded with zero in a register.              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    data_ptr                              Pointer to data               */
+/*    length                                Number of bytes               */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    sum                                   Folded 16-bit native sum      */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_ip_checksum_fold                  Fold 64-bit accumulator       */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_ip_checksum_compute               Compute packet checksum       */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+static ULONG _nx_ip_checksum_buffer_sum(UCHAR *data_ptr, ULONG length)
+{
+
+NX_IP_CHECKSUM_SUM sum =  0;
+NX_IP_CHECKSUM_SUM sum_1 =  0;
+UINT               odd_address =  NX_FALSE;
+ULONG              folded;
+#if defined(NX_IP_CHECKSUM_AVX2)
+__m256i            zero_256;
+__m256i            data_256;
+__m256i            acc_256;
+NX_IP_CHECKSUM_SUM lanes[4];
+#endif /* NX_IP_CHECKSUM_AVX2 */
+#if defined(NX_IP_CHECKSUM_SSE2) || defined(NX_IP_CHECKSUM_AVX2)
+__m128i            zero_128;
+__m128i            data_128;
+__m128i            acc_128;
+NX_IP_CHECKSUM_SUM lanes_128[2];
+#endif /* NX_IP_CHECKSUM_SSE2 || NX_IP_CHECKSUM_AVX2 */
+#if defined(NX_IP_CHECKSUM_NEON)
+uint64x2_t         acc_neon;
+#endif /* NX_IP_CHECKSUM_NEON */
+
+
+    if (length == 0)
+    {
+        return(0);
+    }
+
+    /* A buffer that starts on an odd address is summed as if a zero byte was placed
+       in front of it, which shifts every byte into the opposite half of its word.
+       The folded result is swapped back before returning.  */
+    if (((ALIGN_TYPE)data_ptr) & 1)
+    {
+
+        sum =  NX_IP_CHECKSUM_SECOND_BYTE(*data_ptr);
+        data_ptr++;
+        length--;
+        odd_address =  NX_TRUE;
+    }
+
+    /* Align the pointer to a 32-bit boundary.  */
+    if ((((ALIGN_TYPE)data_ptr) & 2) && (length >= sizeof(USHORT)))
+    {
+
+        sum +=  *((USHORT *)data_ptr);
+        data_ptr +=  sizeof(USHORT);
+        length -=  sizeof(USHORT);
+    }
+
+#if defined(NX_IP_CHECKSUM_AVX2)
+
+    /* Sum 32 bytes per iteration, widening each 32-bit word into a 64-bit lane.  */
+    if (length >= 32)
+    {
+
+        zero_256 =  _mm256_setzero_si256();
+        acc_256 =  _mm256_setzero_si256();
+        do
+        {
+
+            data_256 =  _mm256_loadu_si256((__m256i *)data_ptr);
+            acc_256 =  _mm256_add_epi64(acc_256, _mm256_unpacklo_epi32(data_256, zero_256));
+            acc_256 =  _mm256_add_epi64(acc_256, _mm256_unpackhi_epi32(data_256, zero_256));
+            data_ptr +=  32;
+            length -=  32;
+        } while (length >= 32);
+
+        _mm256_storeu_si256((__m256i *)lanes, acc_256);
+        sum +=  (NX_IP_CHECKSUM_SUM)_nx_ip_checksum_fold(lanes[0]) + _nx_ip_checksum_fold(lanes[1]);
+        sum_1 +=  (NX_IP_CHECKSUM_SUM)_nx_ip_checksum_fold(lanes[2]) + _nx_ip_checksum_fold(lanes[3]);
+    }
+#endif /* NX_IP_CHECKSUM_AVX2 */
+
+#if defined(NX_IP_CHECKSUM_SSE2) || defined(NX_IP_CHECKSUM_AVX2)
+
+    /* Sum 16 bytes per iteration, widening each 32-bit word into a 64-bit lane.  */
+    if (length >= 16)
+    {
+
+        zero_128 =  _mm_setzero_si128();
+        acc_128 =  _mm_setzero_si128();
+        do
+        {
+
+            data_128 =  _mm_loadu_si128((__m128i *)data_ptr);
+            acc_128 =  _mm_add_epi64(acc_128, _mm_unpacklo_epi32(data_128, zero_128));
+            acc_128 =  _mm_add_epi64(acc_128, _mm_unpackhi_epi32(data_128, zero_128));
+            data_ptr +=  16;
+            length -=  16;
+        } while (length >= 16);
+
+        _mm_storeu_si128((__m128i *)lanes_128, acc_128);
+        sum +=  _nx_ip_checksum_fold(lanes_128[0]);
+        sum_1 +=  _nx_ip_checksum_fold(lanes_128[1]);
+    }
+#endif /* NX_IP_CHECKSUM_SSE2 || NX_IP_CHECKSUM_AVX2 */
+
+#if defined(NX_IP_CHECKSUM_NEON)
+
+    /* Sum 16 bytes per iteration with pairwise widening accumulation.  */
+    if (length >= 16)
+    {
+
+        acc_neon =  vdupq_n_u64(0);
+        do
+        {
+
+            acc_neon =  vpadalq_u32(acc_neon, vld1q_u32((const uint32_t *)data_ptr));
+            data_ptr +=  16;
+            length -=  16;
+        } while (length >= 16);
+
+        sum +=  _nx_ip_checksum_fold(vgetq_lane_u64(acc_neon, 0));
+        sum_1 +=  _nx_ip_checksum_fold(vgetq_lane_u64(acc_neon, 1));
+    }
+#endif /* NX_IP_CHECKSUM_NEON */
+
+    /* Portable path: two independent 64-bit accumulators, 16 bytes per iteration.  */
+    while (length >= 16)
+    {
+
+        sum +=    *((ULONG *)data_ptr);
+        sum_1 +=  *((ULONG *)(data_ptr + 4));
+        sum +=    *((ULONG *)(data_ptr + 8));
+        sum_1 +=  *((ULONG *)(data_ptr + 12));
+        data_ptr +=  16;
+        length -=  16;
+    }
+
+    /* Pickup the remaining whole words.  */
+    while (length >= sizeof(ULONG))
+    {
+
+        sum +=  *((ULONG *)data_ptr);
+        data_ptr +=  sizeof(ULONG);
+        length -=  sizeof(ULONG);
+    }
+
+    if (length >= sizeof(USHORT))
+    {
+
+        sum +=  *((USHORT *)data_ptr);
+        data_ptr +=  sizeof(USHORT);
+        length -=  sizeof(USHORT);
+    }
+
+    /* A trailing odd byte is the first half of a zero padded word.  */
+    if (length)
+    {
+        sum +=  NX_IP_CHECKSUM_FIRST_BYTE(*data_ptr);
+    }
+
+    folded =  _nx_ip_checksum_fold(sum + sum_1);
+
+    /* Undo the byte shift introduced by an odd start address.  */
+    if (odd_address)
+    {
+        folded =  ((folded >> 8) | (folded << 8)) & NX_LOWER_16_MASK;
+    }
+
+    return(folded);
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_checksum_compute                             PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function computes the one's complement sum used by the IP,     */
+/*    ICMP, TCP and UDP checksums.  The data is summed in native byte     */
+/*    order with 64-bit accumulators and swapped once at the end.  For    */
+/*    TCP and UDP the pseudo header built from the supplied addresses,    */
+/*    the protocol and data_length is added as well.  The packet is never */
+/*    written to.                                                         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    packet_ptr                            Pointer to packet             */
+/*    protocol                              NX_IP_TCP, NX_IP_UDP or any   */
+/*                                            other value for no pseudo   */
+/*                                            header                      */
+/*    data_length                           Number of bytes to sum,       */
+/*                                            starting at prepend_ptr     */
+/*    source_ip                             Source IP address             */
+/*    destination_ip                        Destination IP address        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    checksum                              16-bit sum in host byte order,*/
+/*                                            not complemented            */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_ip_checksum_buffer_sum            Sum a contiguous buffer       */
+/*    _nx_ip_checksum_fold                  Fold 64-bit accumulator       */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_icmp_checksum_compute             Compute ICMP checksum         */
+/*    _nx_tcp_checksum                      Compute TCP checksum          */
+/*    _nx_udp_socket_receive                UDP receive checksum          */
+/*    _nx_udp_socket_send                   UDP send checksum             */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _nx_ip_checksum_compute(NX_PACKET *packet_ptr, ULONG protocol, ULONG data_length,
+                               ULONG source_ip, ULONG destination_ip)
+{
+
+NX_IP_CHECKSUM_SUM sum =  0;
+ULONG              packet_sum;
+ULONG              packet_length;
+ULONG              remaining_length =  data_length;
+UINT               odd_offset =  NX_FALSE;
+NX_PACKET         *current_packet;
+
+
+    /* Loop through the packet chain.  */
+    for (current_packet =  packet_ptr;
+         (current_packet) && (remaining_length);
+         current_packet =  current_packet -> nx_packet_next)
+    {
+
+        /* Calculate the current packet length.  */
+        packet_length =  (ULONG)(current_packet -> nx_packet_append_ptr - current_packet -> nx_packet_prepend_ptr);
+        if (packet_length > remaining_length)
+        {
+            packet_length =  remaining_length;
+        }
+
+        packet_sum =  _nx_ip_checksum_buffer_sum(current_packet -> nx_packet_prepend_ptr, packet_length);
+
+        /* A buffer that starts at an odd offset of the datagram has its bytes in
+           the opposite halves of each word.  */
+        if (odd_offset)
+        {
+            packet_sum =  ((packet_sum >> 8) | (packet_sum << 8)) & NX_LOWER_16_MASK;
+        }
+
+        sum +=  packet_sum;
+
+        if (packet_length & 1)
+        {
+            odd_offset =  !odd_offset;
+        }
+
+        remaining_length -=  packet_length;
+    }
+
+    /* Fold, then convert the native sum to host byte order.  */
+    packet_sum =  _nx_ip_checksum_fold(sum);
+#ifdef NX_LITTLE_ENDIAN
+    packet_sum =  ((packet_sum >> 8) | (packet_sum << 8)) & NX_LOWER_16_MASK;
+#endif /* NX_LITTLE_ENDIAN */
+
+    /* Add the pseudo header for TCP and UDP.  */
+    if ((protocol == NX_IP_TCP) || (protocol == NX_IP_UDP))
+    {
+
+        sum =  packet_sum;
+        sum +=  (source_ip >> NX_SHIFT_BY_16);
+        sum +=  (source_ip & NX_LOWER_16_MASK);
+        sum +=  (destination_ip >> NX_SHIFT_BY_16);
+        sum +=  (destination_ip & NX_LOWER_16_MASK);
+        sum +=  (protocol >> NX_SHIFT_BY_16);
+        sum +=  (data_length & NX_LOWER_16_MASK);
+        packet_sum =  _nx_ip_checksum_fold(sum);
+    }
+
+    return(packet_sum);
+}
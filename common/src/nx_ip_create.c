@@ -83,6 +83,9 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            ARP hash table, resulting   */
+/*                                            in version 6.x              */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_ip_create(NX_IP *ip_ptr, CHAR *name, ULONG ip_address, ULONG network_mask,
@@ -130,6 +133,13 @@ NX_IP *tail_ptr;
     /* Initialize the ARP defend timeout.  */
     ip_ptr -> nx_ip_interface[0].nx_interface_arp_defend_timeout = 0;
 
+#ifdef NX_ENABLE_ARP_CACHE_HASH
+
+    /* Use the default ARP hash table until ARP is enabled.  */
+    ip_ptr -> nx_ip_arp_table =       ip_ptr -> nx_ip_arp_table_default;
+    ip_ptr -> nx_ip_arp_table_mask =  NX_ROUTE_TABLE_MASK;
+#endif /* NX_ENABLE_ARP_CACHE_HASH */
+
 
 #ifndef NX_DISABLE_LOOPBACK_INTERFACE
 
@@ -61,6 +61,7 @@
 /*    _nx_ip_raw_packet_cleanup             Cleanup raw packet suspension */
 /*    _nx_icmp_cleanup                      Cleanup for ICMP packets      */
 /*    _nx_ip_fragment_disable               Disable fragment processing   */
+/*    _nx_ip_receive_ring_get               Take packets from ring        */
 /*    tx_mutex_delete                       Delete IP protection mutex    */
 /*    tx_mutex_get                          Get protection mutex          */
 /*    tx_mutex_put                          Put protection mutex          */
@@ -83,6 +84,11 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            released packets of the     */
+/*                                            receive rings, deleted ARP  */
+/*                                            retransmit timer, resulting */
+/*                                            in version 6.x              */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_ip_delete(NX_IP *ip_ptr)
@@ -98,6 +104,12 @@ NX_PACKET   *igmp_queue_head;
 NX_PACKET   *tcp_queue_head;
 NX_PACKET   *arp_queue_head;
 NX_PACKET   *rarp_queue_head;
+#ifdef NX_ENABLE_IP_RECEIVE_RING
+NX_PACKET   *ring_head;
+#ifdef NX_DRIVER_DEFERRED_PROCESSING
+NX_PACKET   *driver_ring_head;
+#endif /* NX_DRIVER_DEFERRED_PROCESSING */
+#endif /* NX_ENABLE_IP_RECEIVE_RING */
 UINT         i;
 
     /* If trace is enabled, insert this event into the trace buffer.  */
@@ -195,6 +207,15 @@ UINT         i;
     ip_ptr ->  nx_ip_deferred_received_packet_head =  NX_NULL;
     ip_ptr ->  nx_ip_deferred_received_packet_tail =  NX_NULL;
 
+#ifdef NX_ENABLE_IP_RECEIVE_RING
+    /* Release all packets left in the receive rings.  The IP helper thread, which is the only
+       consumer of the rings, cannot run while the IP mutex is held.  */
+    ring_head =  _nx_ip_receive_ring_get(&(ip_ptr -> nx_ip_deferred_receive_ring));
+#ifdef NX_DRIVER_DEFERRED_PROCESSING
+    driver_ring_head =  _nx_ip_receive_ring_get(&(ip_ptr -> nx_ip_driver_deferred_ring));
+#endif /* NX_DRIVER_DEFERRED_PROCESSING */
+#endif /* NX_ENABLE_IP_RECEIVE_RING */
+
     /* Release all queued ICMP packets.  */
     icmp_queue_head =   ip_ptr ->  nx_ip_icmp_queue_head;
     ip_ptr ->  nx_ip_icmp_queue_head =  NX_NULL;
@@ -237,6 +258,17 @@ UINT         i;
         tx_timer_delete(&(ip_ptr -> nx_ip_tcp_fast_periodic_timer));
     }
 
+#ifdef NX_ENABLE_ARP_PENDING_QUEUE
+    /* Determine if ARP is enabled.  */
+    if (ip_ptr -> nx_ip_arp_allocate)
+    {
+
+        /* Yes, ARP is enabled. Deactivate and delete the ARP retransmit timer.  */
+        tx_timer_deactivate(&(ip_ptr -> nx_ip_arp_retransmit_timer));
+        tx_timer_delete(&(ip_ptr -> nx_ip_arp_retransmit_timer));
+    }
+#endif /* NX_ENABLE_ARP_PENDING_QUEUE */
+
     /* Terminate the internal IP thread.  */
     tx_thread_terminate(&(ip_ptr -> nx_ip_thread));
 
@@ -262,6 +294,20 @@ UINT         i;
         _nx_ip_delete_queue_clear(deferred_head);
     }
 
+#ifdef NX_ENABLE_IP_RECEIVE_RING
+    /* Release any packets of the receive rings.  */
+    if (ring_head)
+    {
+        _nx_ip_delete_queue_clear(ring_head);
+    }
+#ifdef NX_DRIVER_DEFERRED_PROCESSING
+    if (driver_ring_head)
+    {
+        _nx_ip_delete_queue_clear(driver_ring_head);
+    }
+#endif /* NX_DRIVER_DEFERRED_PROCESSING */
+#endif /* NX_ENABLE_IP_RECEIVE_RING */
+
     /* Release any queued ICMP packets.  */
     if (icmp_queue_head)
     {
@@ -45,7 +45,9 @@
 /*    This function places the supplied packet on the driver's deferred   */
 /*    receive queue.  It will be processed later during subsequent        */
 /*    execution of the IP helper thread by calling the driver's deferred  */
-/*    handling routine.                                                   */
+/*    handling routine.  With NX_ENABLE_IP_RECEIVE_RING, the queue is a   */
+/*    single-producer ring, so this function must only be called from one */
+/*    driver receive context per IP instance.                             */
 /*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
@@ -58,7 +60,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    None                                                                */
+/*    _nx_ip_receive_ring_put               Place packet in ring          */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -71,12 +73,26 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            receive ring, resulting in  */
+/*                                            version 6.x                 */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_ip_driver_deferred_receive(NX_IP *ip_ptr, NX_PACKET *packet_ptr)
 {
 
 #ifdef NX_DRIVER_DEFERRED_PROCESSING
+#ifdef NX_ENABLE_IP_RECEIVE_RING
+
+    /* Place the packet in the driver deferred ring without disabling interrupts.  */
+    packet_ptr -> nx_packet_queue_next =  NX_NULL;
+    if (_nx_ip_receive_ring_put(&(ip_ptr -> nx_ip_driver_deferred_ring), packet_ptr))
+    {
+
+        /* The ring was empty, wakeup IP helper thread to process the packet.  */
+        tx_event_flags_set(&(ip_ptr -> nx_ip_events), NX_IP_DRIVER_PACKET_EVENT, TX_OR);
+    }
+#else
 TX_INTERRUPT_SAVE_AREA
 
     /* Disable interrupts.  */
@@ -108,6 +124,7 @@ TX_INTERRUPT_SAVE_AREA
         /* Restore interrupts.  */
         TX_RESTORE
     }
+#endif /* NX_ENABLE_IP_RECEIVE_RING */
 
 #else
 
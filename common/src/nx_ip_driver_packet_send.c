@@ -0,0 +1,917 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+#include "nx_packet.h"
+#include "nx_igmp.h"
+#include "nx_arp.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_driver_packet_send                           PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function sends an IP packet, whose IP header is already built  */
+/*    and in network byte order, to the appropriate link driver.  It      */
+/*    handles loopback, broadcast, multicast, ARP resolution,             */
+/*    fragmentation and the software segmentation of TCP super-segments.  */
+/*    The packet's interface and next hop address must already be set.    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                Pointer to IP control block   */
+/*    packet_ptr                            Pointer to packet to send     */
+/*    destination_ip                        Destination IP address        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_arp_entry_refresh                 Refresh ARP entry on use      */
+/*    _nx_arp_entry_state_set               Set ARP entry state           */
+/*    _nx_arp_packet_queue                  Queue packet for ARP          */
+/*    _nx_arp_retransmit_start              Start fast ARP retransmits    */
+/*    _nx_ip_gso_segment_send               Split TCP super-segment       */
+/*    _nx_ip_loopback_send                  Send packet via the LB driver */
+/*    _nx_ip_packet_checksum_compute        Compute pending checksums     */
+/*    _nx_packet_transmit_release           Release transmit packet       */
+/*    (nx_ip_fragment_processing)           Fragment processing           */
+/*    (ip_link_driver)                      User supplied link driver     */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_ip_forward_packet_process         Forward IP packet             */
+/*    _nx_ip_packet_send                    Send IP packet                */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_ip_driver_packet_send(NX_IP *ip_ptr, NX_PACKET *packet_ptr, ULONG destination_ip)
+{
+
+TX_INTERRUPT_SAVE_AREA
+NX_IP_DRIVER  driver_request;
+UINT          index;
+NX_ARP       *arp_ptr;
+#ifndef NX_ENABLE_ARP_PENDING_QUEUE
+NX_PACKET    *last_packet;
+NX_PACKET    *remove_packet;
+UINT          queued_count;
+#endif /* NX_ENABLE_ARP_PENDING_QUEUE */
+
+
+#ifdef NX_ENABLE_IP_PACKET_FILTER
+    /* Check if the IP packet filter is set.  */
+    if (ip_ptr -> nx_ip_packet_filter)
+    {
+
+        /* Yes, call the IP packet filter routine.  */
+        if ((ip_ptr -> nx_ip_packet_filter((VOID *)(packet_ptr -> nx_packet_prepend_ptr), NX_IP_PACKET_OUT)) != NX_SUCCESS)
+        {
+
+            /* Drop the packet. */
+            _nx_packet_transmit_release(packet_ptr);
+            return;
+        }
+    }
+#endif /* NX_ENABLE_IP_PACKET_FILTER */
+
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+#ifndef NX_ENABLE_TCP_GSO
+    /* Determine if this is a TCP super-segment the interface can no longer split.  */
+    if ((packet_ptr -> nx_packet_tcp_segment_size) &&
+        !(packet_ptr -> nx_packet_ip_interface -> nx_interface_capability_flag & NX_INTERFACE_CAPABILITY_TCP_SEGMENTATION))
+    {
+
+        /* Send it as a regular packet, fragmented if necessary.  */
+        packet_ptr -> nx_packet_tcp_segment_size =  0;
+    }
+#endif /* NX_ENABLE_TCP_GSO */
+
+    /* Determine if the checksums left for the hardware must be computed here instead.  This is
+       the case when the interface cannot compute them, or when the packet is looped back,
+       broadcast, multicast or fragmented and therefore never reaches the hardware intact.  The
+       checksums of a super-segment split in software are computed for each segment instead.  */
+    if ((packet_ptr -> nx_packet_interface_capability_flag) &&
+        (((packet_ptr -> nx_packet_interface_capability_flag & ~(packet_ptr -> nx_packet_ip_interface -> nx_interface_capability_flag)) &&
+          !NX_IP_GSO_NEEDED(packet_ptr)) ||
+         (destination_ip == packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_address) ||
+         ((destination_ip >= NX_IP_LOOPBACK_FIRST) && (destination_ip <= NX_IP_LOOPBACK_LAST)) ||
+         (destination_ip == NX_IP_LIMITED_BROADCAST) ||
+         ((destination_ip & NX_IP_CLASS_D_MASK) == NX_IP_CLASS_D_TYPE) ||
+         ((destination_ip & ~(packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_network_mask)) ==
+          ~(packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_network_mask)) ||
+         (NX_IP_FRAGMENTATION_NEEDED(packet_ptr))))
+    {
+
+        /* Compute the pending checksums in software.  */
+        _nx_ip_packet_checksum_compute(packet_ptr);
+    }
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
+    /* Take care of the loopback case. */
+    if ((destination_ip == packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_address) ||
+        ((destination_ip >= NX_IP_LOOPBACK_FIRST) && (destination_ip <= NX_IP_LOOPBACK_LAST)))
+    {
+        /* Send the packet via the loopback driver, and release the original
+           packet after loopback send. */
+        _nx_ip_loopback_send(ip_ptr, packet_ptr, NX_TRUE);
+
+        return;
+    }
+
+    /* Determine if physical mapping is needed by the link driver.  */
+    if (packet_ptr -> nx_packet_ip_interface -> nx_interface_address_mapping_needed)
+    {
+
+        /* Yes, Check for broadcast address. */
+
+        /* Determine if an IP limited or directed broadcast is requested.  */
+        if ((destination_ip == NX_IP_LIMITED_BROADCAST) ||
+            (((destination_ip & packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_network_mask) == packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_network) &&
+             ((destination_ip & ~(packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_network_mask)) == ~(packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_network_mask))))
+        {
+
+            /* Build the driver request.  */
+            driver_request.nx_ip_driver_ptr                  =  ip_ptr;
+            driver_request.nx_ip_driver_command              =  NX_LINK_PACKET_BROADCAST;
+            driver_request.nx_ip_driver_packet               =  packet_ptr;
+            driver_request.nx_ip_driver_physical_address_msw =  0xFFFFUL;
+            driver_request.nx_ip_driver_physical_address_lsw =  0xFFFFFFFFUL;
+            driver_request.nx_ip_driver_interface            =  packet_ptr -> nx_packet_ip_interface;
+#ifdef NX_ENABLE_TCP_GSO
+            /* Determine if the TCP super-segment must be split into segments in software.  */
+            if (NX_IP_GSO_NEEDED(packet_ptr))
+            {
+
+                /* Split the super-segment and send the segments.  */
+                _nx_ip_gso_segment_send(&driver_request);
+                return;
+            }
+#endif /* NX_ENABLE_TCP_GSO */
+
+#ifndef NX_DISABLE_FRAGMENTATION
+            /* Determine if fragmentation is needed.  */
+            if (NX_IP_FRAGMENTATION_NEEDED(packet_ptr))
+            {
+
+                /* Fragmentation is needed, call the fragment routine if available. */
+                if (ip_ptr -> nx_ip_fragment_processing)
+                {
+
+                    /* Call the IP fragment processing routine.  */
+                    (ip_ptr -> nx_ip_fragment_processing)(&driver_request);
+                }
+                else
+                {
+
+#ifndef NX_DISABLE_IP_INFO
+
+                    /* Increment the IP send packets dropped count.  */
+                    ip_ptr -> nx_ip_send_packets_dropped++;
+#endif /* !NX_DISABLE_IP_INFO */
+
+                    /* Just release the packet.  */
+                    _nx_packet_transmit_release(packet_ptr);
+                }
+
+                /* In either case, this packet send is complete, just return.  */
+                return;
+            }
+#endif /* !NX_DISABLE_FRAGMENTATION */
+
+#ifndef NX_DISABLE_IP_INFO
+
+            /* Increment the IP packet sent count.  */
+            ip_ptr -> nx_ip_total_packets_sent++;
+
+            /* Increment the IP bytes sent count.  */
+            ip_ptr -> nx_ip_total_bytes_sent +=  packet_ptr -> nx_packet_length - sizeof(NX_IP_HEADER);
+#endif /* !NX_DISABLE_IP_INFO */
+
+            /* If trace is enabled, insert this event into the trace buffer.  */
+            NX_TRACE_IN_LINE_INSERT(NX_TRACE_INTERNAL_IO_DRIVER_PACKET_SEND, ip_ptr, packet_ptr, packet_ptr -> nx_packet_length, 0, NX_TRACE_INTERNAL_EVENTS, 0, 0)
+
+            /* Broadcast packet.  */
+            (packet_ptr -> nx_packet_ip_interface -> nx_interface_link_driver_entry) (&driver_request);
+
+            return;
+        }
+
+        /* Determine if we have a class D multicast address.  */
+        else if ((destination_ip & NX_IP_CLASS_D_MASK) == NX_IP_CLASS_D_TYPE)
+        {
+
+            /* Yes, we have a class D multicast address.  Derive the physical mapping from
+               the class D address.  */
+            driver_request.nx_ip_driver_physical_address_msw =  NX_IP_MULTICAST_UPPER;
+            driver_request.nx_ip_driver_physical_address_lsw =  NX_IP_MULTICAST_LOWER | (destination_ip & NX_IP_MULTICAST_MASK);
+            driver_request.nx_ip_driver_interface            =  packet_ptr -> nx_packet_ip_interface;
+
+            /* Determine if the group was joined by this IP instance, and requested a packet via its loopback interface.  */
+            index =  0;
+            while (index < NX_MAX_MULTICAST_GROUPS)
+            {
+
+                /* Determine if the destination address matches the requested address.  */
+                if (ip_ptr -> nx_ip_igmp_join_list[index] == destination_ip)
+                {
+
+                    /* Yes, break the loop!  */
+                    break;
+                }
+
+                /* Increment the join list index.  */
+                index++;
+            }
+            if (index < NX_MAX_MULTICAST_GROUPS)
+            {
+
+                /* Determine if the group has loopback enabled.  */
+                if (ip_ptr -> nx_ip_igmp_group_loopback_enable[index])
+                {
+
+                    /*
+                       Yes, loopback is enabled! Send the packet via
+                       the loopback interface, and do not release the
+                       original packet so it can be transmitted via a physical
+                       interface later on.
+                     */
+                    _nx_ip_loopback_send(ip_ptr, packet_ptr, NX_FALSE);
+                }
+            }
+
+            /* Build the driver request.  */
+            driver_request.nx_ip_driver_ptr        =  ip_ptr;
+            driver_request.nx_ip_driver_command    =  NX_LINK_PACKET_SEND;
+            driver_request.nx_ip_driver_packet     =  packet_ptr;
+            driver_request.nx_ip_driver_interface  =  packet_ptr -> nx_packet_ip_interface;
+
+#ifdef NX_ENABLE_TCP_GSO
+            /* Determine if the TCP super-segment must be split into segments in software.  */
+            if (NX_IP_GSO_NEEDED(packet_ptr))
+            {
+
+                /* Split the super-segment and send the segments.  */
+                _nx_ip_gso_segment_send(&driver_request);
+                return;
+            }
+#endif /* NX_ENABLE_TCP_GSO */
+
+#ifndef NX_DISABLE_FRAGMENTATION
+            /* Determine if fragmentation is needed.  */
+            if (NX_IP_FRAGMENTATION_NEEDED(packet_ptr))
+            {
+
+                /* Fragmentation is needed, call the fragment routine if available. */
+                if (ip_ptr -> nx_ip_fragment_processing)
+                {
+
+                    /* Call the IP fragment processing routine.  */
+                    (ip_ptr -> nx_ip_fragment_processing)(&driver_request);
+                }
+                else
+                {
+
+#ifndef NX_DISABLE_IP_INFO
+
+                    /* Increment the IP send packets dropped count.  */
+                    ip_ptr -> nx_ip_send_packets_dropped++;
+#endif /* !NX_DISABLE_IP_INFO */
+                    /* Just release the packet.  */
+                    _nx_packet_transmit_release(packet_ptr);
+                }
+
+                /* In either case, this packet send is complete, just return.  */
+                return;
+            }
+#endif /* !NX_DISABLE_FRAGMENTATION */
+
+#ifndef NX_DISABLE_IP_INFO
+
+            /* Increment the IP packet sent count.  */
+            ip_ptr -> nx_ip_total_packets_sent++;
+
+            /* Increment the IP bytes sent count.  */
+            ip_ptr -> nx_ip_total_bytes_sent +=  packet_ptr -> nx_packet_length - sizeof(NX_IP_HEADER);
+#endif /* !NX_DISABLE_IP_INFO */
+
+            /* If trace is enabled, insert this event into the trace buffer.  */
+            NX_TRACE_IN_LINE_INSERT(NX_TRACE_INTERNAL_IO_DRIVER_PACKET_SEND, ip_ptr, packet_ptr, packet_ptr -> nx_packet_length, 0, NX_TRACE_INTERNAL_EVENTS, 0, 0)
+
+            /* Send the IP packet out on the network via the attached driver.  */
+            (packet_ptr -> nx_packet_ip_interface -> nx_interface_link_driver_entry) (&driver_request);
+
+            /* Done processing Multicast packet.  Return to caller.  */
+            return;
+        }
+
+        /* If we get here, the packet destination is a unicast address.  */
+        destination_ip = packet_ptr -> nx_packet_next_hop_address;
+
+        /* Look into the ARP Routing Table to derive the physical address.  */
+
+        /* Calculate the hash index for the destination IP address.  */
+        index =  NX_ARP_TABLE_INDEX(ip_ptr, destination_ip);
+
+        /* Disable interrupts temporarily.  */
+        TX_DISABLE
+
+        /* Determine if there is an entry for this IP address.  */
+        arp_ptr =  ip_ptr -> nx_ip_arp_table[index];
+
+        /* Determine if this arp entry matches the destination IP address.  */
+        if ((arp_ptr) && (arp_ptr -> nx_arp_ip_address == destination_ip))
+        {
+
+            /* Yes, we have an existing ARP mapping entry.  */
+
+            /* Determine if there is a physical address.  */
+            if (arp_ptr -> nx_arp_physical_address_msw | arp_ptr -> nx_arp_physical_address_lsw)
+            {
+
+                /* Yes, we have a physical mapping.  Copy the physical address into the driver
+                   request structure.  */
+                driver_request.nx_ip_driver_physical_address_msw =  arp_ptr -> nx_arp_physical_address_msw;
+                driver_request.nx_ip_driver_physical_address_lsw =  arp_ptr -> nx_arp_physical_address_lsw;
+                driver_request.nx_ip_driver_interface            =  packet_ptr -> nx_packet_ip_interface;
+
+                /* Restore interrupts.  */
+                TX_RESTORE
+
+#ifdef NX_ENABLE_ARP_CACHE_HASH
+
+                /* Mark the ARP entry as recently used.  */
+                _nx_arp_entry_refresh(ip_ptr, arp_ptr);
+#endif /* NX_ENABLE_ARP_CACHE_HASH */
+
+                /* Build the driver request.  */
+                driver_request.nx_ip_driver_ptr =      ip_ptr;
+                driver_request.nx_ip_driver_command =  NX_LINK_PACKET_SEND;
+                driver_request.nx_ip_driver_packet =   packet_ptr;
+
+#ifdef NX_ENABLE_TCP_GSO
+                /* Determine if the TCP super-segment must be split into segments in software.  */
+                if (NX_IP_GSO_NEEDED(packet_ptr))
+                {
+
+                    /* Split the super-segment and send the segments.  */
+                    _nx_ip_gso_segment_send(&driver_request);
+                    return;
+                }
+#endif /* NX_ENABLE_TCP_GSO */
+
+#ifndef NX_DISABLE_FRAGMENTATION
+                /* Determine if fragmentation is needed.  */
+                if (NX_IP_FRAGMENTATION_NEEDED(packet_ptr))
+                {
+
+                    /* Fragmentation is needed, call the fragment routine if available. */
+                    if (ip_ptr -> nx_ip_fragment_processing)
+                    {
+
+                        /* Call the IP fragment processing routine.  */
+                        (ip_ptr -> nx_ip_fragment_processing)(&driver_request);
+                    }
+                    else
+                    {
+
+#ifndef NX_DISABLE_IP_INFO
+
+                        /* Increment the IP send packets dropped count.  */
+                        ip_ptr -> nx_ip_send_packets_dropped++;
+#endif /* !NX_DISABLE_IP_INFO */
+
+                        /* Just release the packet.  */
+                        _nx_packet_transmit_release(packet_ptr);
+                    }
+
+                    /* In either case, this packet send is complete, just return.  */
+                    return;
+                }
+#endif /* !NX_DISABLE_FRAGMENTATION */
+
+#ifndef NX_DISABLE_IP_INFO
+
+                /* Increment the IP packet sent count.  */
+                ip_ptr -> nx_ip_total_packets_sent++;
+
+                /* Increment the IP bytes sent count.  */
+                ip_ptr -> nx_ip_total_bytes_sent +=  packet_ptr -> nx_packet_length - sizeof(NX_IP_HEADER);
+#endif /* !NX_DISABLE_IP_INFO */
+
+                /* If trace is enabled, insert this event into the trace buffer.  */
+                NX_TRACE_IN_LINE_INSERT(NX_TRACE_INTERNAL_IO_DRIVER_PACKET_SEND, ip_ptr, packet_ptr, packet_ptr -> nx_packet_length, 0, NX_TRACE_INTERNAL_EVENTS, 0, 0)
+
+                /* Send the IP packet out on the network via the attached driver.  */
+                (packet_ptr -> nx_packet_ip_interface -> nx_interface_link_driver_entry) (&driver_request);
+
+                /* Return to caller.  */
+                return;
+            }
+            else
+            {
+
+#if defined(NX_ENABLE_ARP_CACHE_HASH) && !defined(NX_DISABLE_ARP_INFO)
+
+                /* Increment the ARP cache miss count.  */
+                ip_ptr -> nx_ip_arp_cache_misses++;
+#endif
+
+#ifdef NX_ENABLE_ARP_PENDING_QUEUE
+
+                /* Restore interrupts.  */
+                TX_RESTORE
+
+                /* No physical mapping available.  Queue the packet within the pending packet budgets.  */
+                _nx_arp_packet_queue(ip_ptr, arp_ptr, packet_ptr);
+#else
+                /* No physical mapping available. Set the current packet's queue next pointer to NULL.  */
+                packet_ptr -> nx_packet_queue_next =  NX_NULL;
+
+                /* Determine if the queue is empty.  */
+                if (arp_ptr -> nx_arp_packets_waiting == NX_NULL)
+                {
+
+                    /* Yes, we have an empty ARP packet queue.  Simply place the
+                       packet at the head of the list.  */
+                    arp_ptr -> nx_arp_packets_waiting =  packet_ptr;
+
+                    /* Restore interrupts.  */
+                    TX_RESTORE
+                }
+                else
+                {
+
+                    /* Determine how many packets are on the ARP entry's packet
+                       queue and remember the last packet in the queue.  We know
+                       there is at least one on the queue and another that is
+                       going to be queued.  */
+                    last_packet =  arp_ptr -> nx_arp_packets_waiting;
+                    queued_count = 1;
+                    while (last_packet -> nx_packet_queue_next)
+                    {
+
+                        /* Increment the queued count.  */
+                        queued_count++;
+
+                        /* Yes, move to the next packet in the queue.  */
+                        last_packet =  last_packet -> nx_packet_queue_next;
+                    }
+
+                    /* Place the packet at the end of the list.  */
+                    last_packet -> nx_packet_queue_next =  packet_ptr;
+
+                    /* Default the remove packet pointer to NULL.  */
+                    remove_packet =  NX_NULL;
+
+                    /* Determine if the packets queued has exceeded the queue
+                       depth.  */
+                    if (queued_count >= NX_ARP_MAX_QUEUE_DEPTH)
+                    {
+
+                        /* Save the packet pointer at the head of the list.  */
+                        remove_packet =  arp_ptr -> nx_arp_packets_waiting;
+
+                        /* Remove the packet from the ARP queue.  */
+                        arp_ptr -> nx_arp_packets_waiting =  remove_packet -> nx_packet_queue_next;
+
+                        /* Clear the remove packet queue next pointer.  */
+                        remove_packet -> nx_packet_queue_next =  NX_NULL;
+
+#ifndef NX_DISABLE_IP_INFO
+
+                        /* Increment the IP transmit resource error count.  */
+                        ip_ptr -> nx_ip_transmit_resource_errors++;
+
+                        /* Increment the IP send packets dropped count.  */
+                        ip_ptr -> nx_ip_send_packets_dropped++;
+#endif /* !NX_DISABLE_IP_INFO */
+                    }
+
+                    /* Restore interrupts.  */
+                    TX_RESTORE
+
+                    /* Determine if there is a packet to remove.  */
+                    if (remove_packet)
+                    {
+
+                        /* Yes, the packet queue depth for this ARP entry was exceeded
+                           so release the packet that was removed from the queue.  */
+                        _nx_packet_transmit_release(remove_packet);
+                    }
+                }
+#endif /* NX_ENABLE_ARP_PENDING_QUEUE */
+
+                /* Return to caller.  */
+                return;
+            }
+        }
+        else
+        {
+
+            /* At this point, we need to search the ARP list for a match for the
+               destination IP.  */
+
+            /* First, restore interrupts.  */
+            TX_RESTORE
+
+            /* Pickup the first ARP entry.  */
+            arp_ptr =  ip_ptr -> nx_ip_arp_table[index];
+
+            /* Loop to look for an ARP match.  */
+            while (arp_ptr)
+            {
+
+                /* Check for an IP match.  */
+                if (arp_ptr -> nx_arp_ip_address == destination_ip)
+                {
+
+                    /* Yes, we found a match.  Get out of the loop!  */
+                    break;
+                }
+
+                /* Move to the next active ARP entry.  */
+                arp_ptr =  arp_ptr -> nx_arp_active_next;
+
+                /* Determine if we are at the end of the ARP list.  */
+                if (arp_ptr == ip_ptr -> nx_ip_arp_table[index])
+                {
+                    /* Clear the ARP pointer.  */
+                    arp_ptr =  NX_NULL;
+                    break;
+                }
+            }
+
+            /* Determine if we actually found a matching ARP entry.  */
+            if (arp_ptr)
+            {
+
+                /* Yes, we found an ARP entry.  Now check and see if
+                   it has an actual physical address.  */
+                if (arp_ptr -> nx_arp_physical_address_msw | arp_ptr -> nx_arp_physical_address_lsw)
+                {
+
+                    /* Yes, we have a physical mapping.  Copy the physical address into the driver
+                       request structure.  */
+                    driver_request.nx_ip_driver_physical_address_msw =  arp_ptr -> nx_arp_physical_address_msw;
+                    driver_request.nx_ip_driver_physical_address_lsw =  arp_ptr -> nx_arp_physical_address_lsw;
+
+                    /* Disable interrupts.  */
+                    TX_DISABLE
+
+                    /* Move this ARP entry to the head of the list.  */
+                    ip_ptr -> nx_ip_arp_table[index] =  arp_ptr;
+
+                    /* Restore interrupts.  */
+                    TX_RESTORE
+
+#ifdef NX_ENABLE_ARP_CACHE_HASH
+
+                    /* Mark the ARP entry as recently used.  */
+                    _nx_arp_entry_refresh(ip_ptr, arp_ptr);
+#endif /* NX_ENABLE_ARP_CACHE_HASH */
+
+                    /* Build the driver request message.  */
+                    driver_request.nx_ip_driver_ptr        =  ip_ptr;
+                    driver_request.nx_ip_driver_command    =  NX_LINK_PACKET_SEND;
+                    driver_request.nx_ip_driver_packet     =  packet_ptr;
+                    driver_request.nx_ip_driver_interface  =  packet_ptr -> nx_packet_ip_interface;
+
+#ifdef NX_ENABLE_TCP_GSO
+                    /* Determine if the TCP super-segment must be split into segments in software.  */
+                    if (NX_IP_GSO_NEEDED(packet_ptr))
+                    {
+
+                        /* Split the super-segment and send the segments.  */
+                        _nx_ip_gso_segment_send(&driver_request);
+                        return;
+                    }
+#endif /* NX_ENABLE_TCP_GSO */
+
+#ifndef NX_DISABLE_FRAGMENTATION
+                    /* Determine if fragmentation is needed.  */
+                    if (NX_IP_FRAGMENTATION_NEEDED(packet_ptr))
+                    {
+
+                        /* Fragmentation is needed, call the fragment routine if available. */
+                        if (ip_ptr -> nx_ip_fragment_processing)
+                        {
+
+                            /* Call the IP fragment processing routine.  */
+                            (ip_ptr -> nx_ip_fragment_processing)(&driver_request);
+                        }
+                        else
+                        {
+
+#ifndef NX_DISABLE_IP_INFO
+
+                            /* Increment the IP send packets dropped count.  */
+                            ip_ptr -> nx_ip_send_packets_dropped++;
+#endif /* !NX_DISABLE_IP_INFO */
+
+                            /* Just release the packet.  */
+                            _nx_packet_transmit_release(packet_ptr);
+                        }
+
+                        /* In either case, this packet send is complete, just return.  */
+                        return;
+                    }
+#endif /* !NX_DISABLE_FRAGMENTATION */
+
+#ifndef NX_DISABLE_IP_INFO
+
+                    /* Increment the IP packet sent count.  */
+                    ip_ptr -> nx_ip_total_packets_sent++;
+
+                    /* Increment the IP bytes sent count.  */
+                    ip_ptr -> nx_ip_total_bytes_sent +=  packet_ptr -> nx_packet_length - sizeof(NX_IP_HEADER);
+#endif /* !NX_DISABLE_IP_INFO */
+
+                    /* If trace is enabled, insert this event into the trace buffer.  */
+                    NX_TRACE_IN_LINE_INSERT(NX_TRACE_INTERNAL_IO_DRIVER_PACKET_SEND, ip_ptr, packet_ptr, packet_ptr -> nx_packet_length, 0, NX_TRACE_INTERNAL_EVENTS, 0, 0)
+
+                    /* Send the IP packet out on the network via the attached driver.  */
+                    (packet_ptr -> nx_packet_ip_interface -> nx_interface_link_driver_entry) (&driver_request);
+
+                    /* Return to caller.  */
+                    return;
+                }
+                else
+                {
+
+                    /* We don't have physical mapping.  */
+#if defined(NX_ENABLE_ARP_CACHE_HASH) && !defined(NX_DISABLE_ARP_INFO)
+
+                    /* Increment the ARP cache miss count.  */
+                    ip_ptr -> nx_ip_arp_cache_misses++;
+#endif
+
+#ifdef NX_ENABLE_ARP_PENDING_QUEUE
+
+                    /* Queue the packet within the pending packet budgets.  */
+                    _nx_arp_packet_queue(ip_ptr, arp_ptr, packet_ptr);
+#else
+                    /* Disable interrupts.  */
+                    TX_DISABLE
+
+                    /* Ensure the current packet's queue next pointer to NULL.  */
+                    packet_ptr -> nx_packet_queue_next =  NX_NULL;
+
+                    /* Determine if the queue is empty.  */
+                    if (arp_ptr -> nx_arp_packets_waiting == NX_NULL)
+                    {
+
+                        /* Yes, we have an empty ARP packet queue.  Simply place the
+                           packet at the head of the list.  */
+                        arp_ptr -> nx_arp_packets_waiting =  packet_ptr;
+
+                        /* Restore interrupts.  */
+                        TX_RESTORE
+                    }
+                    else
+                    {
+
+
+                        /* Determine how many packets are on the ARP entry's packet
+                           queue and remember the last packet in the queue.  We know
+                           there is at least one on the queue and another that is
+                           going to be queued.  */
+                        last_packet =  arp_ptr -> nx_arp_packets_waiting;
+                        queued_count = 1;
+                        while (last_packet -> nx_packet_queue_next)
+                        {
+
+                            /* Increment the queued count.  */
+                            queued_count++;
+
+                            /* Yes, move to the next packet in the queue.  */
+                            last_packet =  last_packet -> nx_packet_queue_next;
+                        }
+
+                        /* Place the packet at the end of the list.  */
+                        last_packet -> nx_packet_queue_next =  packet_ptr;
+
+                        /* Default the remove packet pointer to NULL.  */
+                        remove_packet =  NX_NULL;
+
+                        /* Determine if the packets queued has exceeded the queue
+                           depth.  */
+                        if (queued_count >= NX_ARP_MAX_QUEUE_DEPTH)
+                        {
+
+                            /* Save the packet pointer at the head of the list.  */
+                            remove_packet =  arp_ptr -> nx_arp_packets_waiting;
+
+                            /* Remove the packet from the ARP queue.  */
+                            arp_ptr -> nx_arp_packets_waiting =  remove_packet -> nx_packet_queue_next;
+
+                            /* Clear the remove packet queue next pointer.  */
+                            remove_packet -> nx_packet_queue_next =  NX_NULL;
+
+#ifndef NX_DISABLE_IP_INFO
+
+                            /* Increment the IP transmit resource error count.  */
+                            ip_ptr -> nx_ip_transmit_resource_errors++;
+
+                            /* Increment the IP send packets dropped count.  */
+                            ip_ptr -> nx_ip_send_packets_dropped++;
+#endif /* !NX_DISABLE_IP_INFO */
+                        }
+
+                        /* Restore interrupts.  */
+                        TX_RESTORE
+
+                        /* Determine if there is a packet to remove.  */
+                        if (remove_packet)
+                        {
+
+                            /* Yes, the packet queue depth for this ARP entry was exceeded
+                               so release the packet that was removed from the queue.  */
+                            _nx_packet_transmit_release(remove_packet);
+                        }
+                    }
+#endif /* NX_ENABLE_ARP_PENDING_QUEUE */
+
+                    /* Return to caller.  */
+                    return;
+                }
+            }
+            else
+            {
+
+                /* No ARP entry was found.  We need to allocate a new ARP entry, populate it, and
+                   initiate an ARP request to get the specific physical mapping.  */
+#if defined(NX_ENABLE_ARP_CACHE_HASH) && !defined(NX_DISABLE_ARP_INFO)
+
+                /* Increment the ARP cache miss count.  */
+                ip_ptr -> nx_ip_arp_cache_misses++;
+#endif
+
+                /* Allocate a new ARP entry.  */
+                if ((!ip_ptr -> nx_ip_arp_allocate) ||
+                    ((ip_ptr -> nx_ip_arp_allocate)(ip_ptr, &(ip_ptr -> nx_ip_arp_table[index]))))
+                {
+
+                    /* Error, release the protection and the packet.  */
+
+#ifndef NX_DISABLE_IP_INFO
+
+                    /* Increment the IP transmit resource error count.  */
+                    ip_ptr -> nx_ip_transmit_resource_errors++;
+
+                    /* Increment the IP send packets dropped count.  */
+                    ip_ptr -> nx_ip_send_packets_dropped++;
+#endif /* !NX_DISABLE_IP_INFO */
+
+                    /* Release the packet.  */
+                    _nx_packet_transmit_release(packet_ptr);
+
+                    /* Just return!  */
+                    return;
+                }
+
+                /* Otherwise, setup a pointer to the new ARP entry.  */
+                arp_ptr =  (ip_ptr -> nx_ip_arp_table[index]) -> nx_arp_active_previous;
+
+                /* Setup the IP address and clear the physical mapping.  */
+                arp_ptr -> nx_arp_ip_address           =  destination_ip;
+                arp_ptr -> nx_arp_physical_address_msw =  0;
+                arp_ptr -> nx_arp_physical_address_lsw =  0;
+                arp_ptr -> nx_arp_retries              =  0;
+                arp_ptr -> nx_arp_ip_interface         =  packet_ptr -> nx_packet_ip_interface;
+
+                /* Start the ARP retry timer of the new entry.  */
+                NX_ARP_ENTRY_STATE_SET(ip_ptr, arp_ptr, NX_ARP_STATE_INCOMPLETE, NX_ARP_UPDATE_RATE);
+
+#ifdef NX_ENABLE_ARP_PENDING_QUEUE
+
+                /* Queue the packet within the pending packet budgets.  */
+                _nx_arp_packet_queue(ip_ptr, arp_ptr, packet_ptr);
+#else
+
+                /* Ensure the queue next pointer is NULL for the packet before it
+                   is placed on the ARP waiting queue.  */
+                packet_ptr -> nx_packet_queue_next =  NX_NULL;
+
+                /* Queue the packet for output.  */
+                arp_ptr -> nx_arp_packets_waiting =  packet_ptr;
+#endif /* NX_ENABLE_ARP_PENDING_QUEUE */
+
+                /* Call ARP send to send an ARP request.  */
+                (ip_ptr -> nx_ip_arp_packet_send)(ip_ptr, destination_ip, arp_ptr -> nx_arp_ip_interface);
+
+                /* Start the fast ARP retransmits of the new entry.  */
+                NX_ARP_RETRANSMIT_START(ip_ptr, arp_ptr)
+                return;
+            }
+        }
+    }
+    else
+    {
+
+        /* This IP interface does not require any IP-to-physical mapping.  */
+
+        /* Build the driver request.  */
+        driver_request.nx_ip_driver_ptr        =      ip_ptr;
+        driver_request.nx_ip_driver_command    =  NX_LINK_PACKET_SEND;
+        driver_request.nx_ip_driver_packet     =  packet_ptr;
+        driver_request.nx_ip_driver_interface  =  packet_ptr -> nx_packet_ip_interface;
+
+#ifdef NX_ENABLE_TCP_GSO
+        /* Determine if the TCP super-segment must be split into segments in software.  */
+        if (NX_IP_GSO_NEEDED(packet_ptr))
+        {
+
+            /* Split the super-segment and send the segments.  */
+            _nx_ip_gso_segment_send(&driver_request);
+            return;
+        }
+#endif /* NX_ENABLE_TCP_GSO */
+
+#ifndef NX_DISABLE_FRAGMENTATION
+        /* Determine if fragmentation is needed.  */
+        if (NX_IP_FRAGMENTATION_NEEDED(packet_ptr))
+        {
+
+            /* Fragmentation is needed, call the fragment routine if available. */
+            if (ip_ptr -> nx_ip_fragment_processing)
+            {
+
+                /* Call the IP fragment processing routine.  */
+                (ip_ptr -> nx_ip_fragment_processing)(&driver_request);
+            }
+            else
+            {
+
+#ifndef NX_DISABLE_IP_INFO
+
+                /* Increment the IP send packets dropped count.  */
+                ip_ptr -> nx_ip_send_packets_dropped++;
+#endif /* !NX_DISABLE_IP_INFO */
+
+                /* Just release the packet.  */
+                _nx_packet_transmit_release(packet_ptr);
+            }
+
+            /* In either case, this packet send is complete, just return.  */
+            return;
+        }
+#endif /* !NX_DISABLE_FRAGMENTATION */
+
+#ifndef NX_DISABLE_IP_INFO
+
+        /* Increment the IP packet sent count.  */
+        ip_ptr -> nx_ip_total_packets_sent++;
+
+        /* Increment the IP bytes sent count.  */
+        ip_ptr -> nx_ip_total_bytes_sent +=  packet_ptr -> nx_packet_length - sizeof(NX_IP_HEADER);
+#endif /* !NX_DISABLE_IP_INFO */
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        NX_TRACE_IN_LINE_INSERT(NX_TRACE_INTERNAL_IO_DRIVER_PACKET_SEND, ip_ptr, packet_ptr, packet_ptr -> nx_packet_length, 0, NX_TRACE_INTERNAL_EVENTS, 0, 0)
+
+        /* No mapping driver.  Just send the packet out!  */
+        (packet_ptr -> nx_packet_ip_interface -> nx_interface_link_driver_entry) (&driver_request);
+    }
+}
+
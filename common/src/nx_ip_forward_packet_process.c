@@ -27,6 +27,7 @@
 
 #include "nx_api.h"
 #include "nx_ip.h"
+#include "nx_packet.h"
 
 
 /**************************************************************************/
@@ -42,8 +43,10 @@
 /*  DESCRIPTION                                                           */
 /*                                                                        */
 /*    This function attempts to forward the IP packet to the destination  */
-/*    IP by using the NetX send packet routine.  Note that the IP header  */
-/*    is still intact prior to the packet.                                */
+/*    IP.  The original IP header, which is still intact prior to the     */
+/*    packet, is reused: the time to live is decremented, the header      */
+/*    checksum is adjusted incrementally and the packet is handed         */
+/*    straight to the link layer.                                         */
 /*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
@@ -56,7 +59,10 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    _nx_ip_packet_send                    Send IP packet                */
+/*    _nx_ip_checksum_adjust                Adjust checksum incrementally */
+/*    _nx_ip_driver_packet_send             Send packet to link driver    */
+/*    _nx_ip_route_find                     Find outgoing interface       */
+/*    _nx_packet_release                    Release packet                */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -69,16 +75,27 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            decremented TTL and         */
+/*                                            adjusted header checksum    */
+/*                                            incrementally instead of    */
+/*                                            rebuilding the header,      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_ip_forward_packet_process(NX_IP *ip_ptr, NX_PACKET *packet_ptr)
 {
 
 NX_IP_HEADER *ip_header_ptr;
+ULONG         destination_ip;
+ULONG         old_word;
+ULONG         checksum;
+ULONG         temp;
 
 
-    /* The NetX IP forwarding consists of simply sending the same packet out through
-       the internal send routine.  Applications may choose to modify this code or
+    /* The NetX IP forwarding consists of sending the same packet, with its original
+       IP header, out through the link layer.  Only the time to live and the header
+       checksum are updated.  Applications may choose to modify this code or
        replace the nx_ip_forward_packet_process pointer in the IP structure to point
        at an application-specific routine for forwarding.  */
 
@@ -86,14 +103,98 @@ NX_IP_HEADER *ip_header_ptr;
        backwards to access it.  */
     ip_header_ptr =  (NX_IP_HEADER *)(packet_ptr -> nx_packet_prepend_ptr - sizeof(NX_IP_HEADER));
 
-    /* Call the IP send routine to forward the packet.  */
-    _nx_ip_packet_send(ip_ptr, packet_ptr, ip_header_ptr -> nx_ip_header_destination_ip,
-                       (ip_header_ptr -> nx_ip_header_word_0 & NX_IP_TOS_MASK),
-                       (ip_header_ptr -> nx_ip_header_word_2 & NX_IP_TIME_TO_LIVE_MASK) >> NX_IP_TIME_TO_LIVE_SHIFT,
-                       (ip_header_ptr -> nx_ip_header_word_2 & NX_IP_PROTOCOL_MASK),
-                       (ip_header_ptr -> nx_ip_header_word_1 & NX_DONT_FRAGMENT));
+    /* Pickup the destination IP address.  */
+    destination_ip =  ip_header_ptr -> nx_ip_header_destination_ip;
 
-    /* Return to caller.  */
-    return;
-}
+    /* Determine if the packet may travel any further.  */
+    if ((ip_header_ptr -> nx_ip_header_word_2 & NX_IP_TIME_TO_LIVE_MASK) <= (1UL << NX_IP_TIME_TO_LIVE_SHIFT))
+    {
+
+#ifndef NX_DISABLE_IP_INFO
+
+        /* Increment the IP receive packets dropped count.  */
+        ip_ptr -> nx_ip_receive_packets_dropped++;
+#endif
+
+        /* Release the packet.  */
+        _nx_packet_release(packet_ptr);
+        return;
+    }
+
+    /* Find the outgoing interface and next hop for the destination.  */
+    if (_nx_ip_route_find(ip_ptr, destination_ip, &packet_ptr -> nx_packet_ip_interface,
+                          &packet_ptr -> nx_packet_next_hop_address) != NX_SUCCESS)
+    {
+
+#ifndef NX_DISABLE_IP_INFO
+
+        /* Increment the IP send packets dropped count.  */
+        ip_ptr -> nx_ip_send_packets_dropped++;
+#endif
+
+        /* Release the packet.  */
+        _nx_packet_release(packet_ptr);
+        return;
+    }
+
+    /* Decrement the time to live, remembering the 16-bit word it shares with the protocol.  */
+    old_word =  ip_header_ptr -> nx_ip_header_word_2 >> NX_SHIFT_BY_16;
+    ip_header_ptr -> nx_ip_header_word_2 -=  (1UL << NX_IP_TIME_TO_LIVE_SHIFT);
+
+    /* Determine if the receive path removed IP options from the header.  In that case
+       the total length and the original checksum no longer describe this header.  */
+    if ((ip_header_ptr -> nx_ip_header_word_0 & NX_LOWER_16_MASK) != (packet_ptr -> nx_packet_length + sizeof(NX_IP_HEADER)))
+    {
 
+        /* Update the total length.  */
+        ip_header_ptr -> nx_ip_header_word_0 =  (ip_header_ptr -> nx_ip_header_word_0 & ~NX_LOWER_16_MASK) |
+            (packet_ptr -> nx_packet_length + sizeof(NX_IP_HEADER));
+
+        /* Clear the checksum field and compute the header checksum from scratch.  */
+        ip_header_ptr -> nx_ip_header_word_2 =  ip_header_ptr -> nx_ip_header_word_2 & ~NX_LOWER_16_MASK;
+        temp =       ip_header_ptr -> nx_ip_header_word_0;
+        checksum =   (temp >> NX_SHIFT_BY_16) + (temp & NX_LOWER_16_MASK);
+        temp =       ip_header_ptr -> nx_ip_header_word_1;
+        checksum +=  (temp >> NX_SHIFT_BY_16) + (temp & NX_LOWER_16_MASK);
+        temp =       ip_header_ptr -> nx_ip_header_word_2;
+        checksum +=  (temp >> NX_SHIFT_BY_16);
+        temp =       ip_header_ptr -> nx_ip_header_source_ip;
+        checksum +=  (temp >> NX_SHIFT_BY_16) + (temp & NX_LOWER_16_MASK);
+        temp =       ip_header_ptr -> nx_ip_header_destination_ip;
+        checksum +=  (temp >> NX_SHIFT_BY_16) + (temp & NX_LOWER_16_MASK);
+
+        /* Add in the carry bits into the checksum.  */
+        checksum = (checksum >> NX_SHIFT_BY_16) + (checksum & NX_LOWER_16_MASK);
+
+        /* Do it again in case previous operation generates an overflow.  */
+        checksum = (checksum >> NX_SHIFT_BY_16) + (checksum & NX_LOWER_16_MASK);
+
+        /* Complement the checksum.  */
+        checksum =  NX_LOWER_16_MASK & ~checksum;
+    }
+    else
+    {
+
+        /* Incrementally update the header checksum for the changed word.  */
+        checksum =  _nx_ip_checksum_adjust(ip_header_ptr -> nx_ip_header_word_2 & NX_LOWER_16_MASK,
+                                           old_word, ip_header_ptr -> nx_ip_header_word_2 >> NX_SHIFT_BY_16);
+    }
+
+    /* Store the checksum in the IP header.  */
+    ip_header_ptr -> nx_ip_header_word_2 =  (ip_header_ptr -> nx_ip_header_word_2 & ~NX_LOWER_16_MASK) | checksum;
+
+    /* Endian swapping logic.  If NX_LITTLE_ENDIAN is specified, these macros will
+       swap the endian of the IP header.  */
+    NX_CHANGE_ULONG_ENDIAN(ip_header_ptr -> nx_ip_header_word_0);
+    NX_CHANGE_ULONG_ENDIAN(ip_header_ptr -> nx_ip_header_word_1);
+    NX_CHANGE_ULONG_ENDIAN(ip_header_ptr -> nx_ip_header_word_2);
+    NX_CHANGE_ULONG_ENDIAN(ip_header_ptr -> nx_ip_header_source_ip);
+    NX_CHANGE_ULONG_ENDIAN(ip_header_ptr -> nx_ip_header_destination_ip);
+
+    /* Include the IP header in the packet again.  */
+    packet_ptr -> nx_packet_prepend_ptr =  (UCHAR *)ip_header_ptr;
+    packet_ptr -> nx_packet_length +=  sizeof(NX_IP_HEADER);
+
+    /* Hand the packet directly to the link layer.  */
+    _nx_ip_driver_packet_send(ip_ptr, packet_ptr, destination_ip);
+}
@@ -55,6 +55,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _nx_ip_fragment_hash_remove           Remove datagram               */
 /*    _nx_packet_release                    Release packet                */
 /*    tx_mutex_get                          Get protection mutex          */
 /*    tx_mutex_put                          Put protection mutex          */
@@ -70,6 +71,9 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            fragment hash table,        */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_ip_fragment_disable(NX_IP *ip_ptr)
@@ -114,6 +118,15 @@ NX_PACKET *release_packet;
     /* Restore interrupts.  */
     TX_RESTORE
 
+#ifdef NX_ENABLE_IP_FRAGMENT_HASH
+
+    /* Remove all datagrams from the re-assembly hash table and release their fragments.  */
+    while (ip_ptr -> nx_ip_fragment_assembly_oldest)
+    {
+        _nx_ip_fragment_hash_remove(ip_ptr, ip_ptr -> nx_ip_fragment_assembly_oldest, NX_TRUE);
+    }
+#endif /* NX_ENABLE_IP_FRAGMENT_HASH */
+
     /* Release mutex protection.  */
     tx_mutex_put(&(ip_ptr -> nx_ip_protection));
 
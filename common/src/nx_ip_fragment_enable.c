@@ -68,6 +68,9 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            fragment hash table,        */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_ip_fragment_enable(NX_IP *ip_ptr)
@@ -75,21 +78,51 @@ UINT  _nx_ip_fragment_enable(NX_IP *ip_ptr)
 
 TX_INTERRUPT_SAVE_AREA
 
+#ifdef NX_ENABLE_IP_FRAGMENT_HASH
+UINT i;
+#endif /* NX_ENABLE_IP_FRAGMENT_HASH */
+
 
     /* If trace is enabled, insert this event into the trace buffer.  */
     NX_TRACE_IN_LINE_INSERT(NX_TRACE_IP_FRAGMENT_ENABLE, ip_ptr, 0, 0, 0, NX_TRACE_IP_EVENTS, 0, 0)
 
+#ifdef NX_ENABLE_IP_FRAGMENT_HASH
+
+    /* Determine if IP fragment re-assembly is not enabled yet.  */
+    if (ip_ptr -> nx_ip_fragment_assembly == NX_NULL)
+    {
+
+        /* Place all re-assembly structures on the available list.  */
+        ip_ptr -> nx_ip_fragment_assembly_available =  NX_NULL;
+        for (i = 0; i < NX_IP_FRAGMENT_MAX_ASSEMBLIES; i++)
+        {
+            ip_ptr -> nx_ip_fragment_assemblies[i].nx_ip_fragment_assembly_hash_next =  ip_ptr -> nx_ip_fragment_assembly_available;
+            ip_ptr -> nx_ip_fragment_assembly_available =  &(ip_ptr -> nx_ip_fragment_assemblies[i]);
+        }
+    }
+#endif /* NX_ENABLE_IP_FRAGMENT_HASH */
+
     /* Disable interrupts temporarily.  */
     TX_DISABLE
 
     /* Setup the IP fragment processing routine pointer.  */
     ip_ptr -> nx_ip_fragment_processing =  _nx_ip_fragment_packet;
 
+#ifdef NX_ENABLE_IP_FRAGMENT_HASH
+
+    /* Setup the hashed IP fragment assembly routine pointer.  */
+    ip_ptr -> nx_ip_fragment_assembly =  _nx_ip_fragment_hash_assembly;
+
+    /* Setup the hashed IP fragment timeout routine pointer.  */
+    ip_ptr -> nx_ip_fragment_timeout_check =  _nx_ip_fragment_hash_timeout_check;
+#else
+
     /* Setup the IP fragment assembly routine pointer.  */
     ip_ptr -> nx_ip_fragment_assembly =  _nx_ip_fragment_assembly;
 
     /* Setup the IP fragment timeout routine pointer.  */
     ip_ptr -> nx_ip_fragment_timeout_check =  _nx_ip_fragment_timeout_check;
+#endif /* NX_ENABLE_IP_FRAGMENT_HASH */
 
     /* Restore interrupts.  */
     TX_RESTORE
@@ -0,0 +1,253 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+#include "nx_packet.h"
+
+
+#ifdef NX_ENABLE_IP_FRAGMENT_HASH
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_fragment_hash_assembly                       PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function processes the IP fragments received when the fragment */
+/*    re-assembly hash table is used. Each fragment is placed with its    */
+/*    datagram, and a datagram that is complete is re-assembled and       */
+/*    dispatched to the appropriate protocol or the raw IP handler.       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                Pointer to IP instance        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_ip_fragment_hash_insert           Insert IP fragment            */
+/*    _nx_packet_release                    Release packet                */
+/*    (nx_ip_raw_ip_processing)             Raw IP packet processing      */
+/*    (nx_ip_tcp_packet_receive)            Receive a TCP packet          */
+/*    (nx_ip_udp_packet_receive)            Receive a UDP packet          */
+/*    (nx_ip_icmp_packet_receive)           Receive a ICMP packet         */
+/*    (nx_ip_igmp_packet_receive)           Receive a IGMP packet         */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_ip_thread_entry                   IP helper thread              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_ip_fragment_hash_assembly(NX_IP *ip_ptr)
+{
+TX_INTERRUPT_SAVE_AREA
+
+NX_PACKET    *new_fragment_head;
+NX_PACKET    *current_fragment;
+NX_PACKET    *fragment_head;
+NX_PACKET    *search_ptr;
+NX_IP_HEADER *current_header;
+ULONG         protocol;
+
+
+    /* Disable interrupts.  */
+    TX_DISABLE
+
+    /* Remove the packets from the incoming IP fragment queue.  */
+    new_fragment_head =  ip_ptr -> nx_ip_received_fragment_head;
+    ip_ptr -> nx_ip_received_fragment_head =  NX_NULL;
+    ip_ptr -> nx_ip_received_fragment_tail =  NX_NULL;
+
+    /* Restore interrupts.  */
+    TX_RESTORE
+
+    /* Process each IP packet in the received IP fragment queue.  */
+    while (new_fragment_head)
+    {
+
+        /* Setup the current fragment pointer.  */
+        current_fragment =  new_fragment_head;
+
+        /* Move the head pointer.  */
+        new_fragment_head =  new_fragment_head -> nx_packet_queue_next;
+
+        /* Place the fragment with its datagram.  */
+        fragment_head =  _nx_ip_fragment_hash_insert(ip_ptr, current_fragment);
+
+        /* Determine if the datagram is complete.  */
+        if (fragment_head == NX_NULL)
+        {
+
+            /* No, move to the next fragment.  */
+            continue;
+        }
+
+        /* The fragments of the datagram are linked in offset order.  We now need to loop
+           through them and reassemble the packet.  */
+        search_ptr =       fragment_head -> nx_packet_fragment_next;
+
+        /* Loop through the fragments and assemble the IP fragment.  */
+        while (search_ptr)
+        {
+
+            /* Accumulate the new length into the head packet.  */
+            fragment_head -> nx_packet_length =  fragment_head -> nx_packet_length +
+                search_ptr -> nx_packet_length - sizeof(NX_IP_HEADER);
+
+            /* Position past the IP header in the subsequent packets.  */
+            search_ptr -> nx_packet_prepend_ptr =  search_ptr -> nx_packet_prepend_ptr +
+                sizeof(NX_IP_HEADER);
+
+            /* Link the addition fragment to the head fragment.  */
+            if (fragment_head -> nx_packet_last)
+            {
+                (fragment_head -> nx_packet_last) -> nx_packet_next =  search_ptr;
+            }
+            else
+            {
+                fragment_head -> nx_packet_next =  search_ptr;
+            }
+            if (search_ptr -> nx_packet_last)
+            {
+                fragment_head -> nx_packet_last =  search_ptr -> nx_packet_last;
+            }
+            else
+            {
+                fragment_head -> nx_packet_last =  search_ptr;
+            }
+
+            /* Move to the next fragment in the chain.  */
+            search_ptr =  search_ptr -> nx_packet_fragment_next;
+        }
+
+        /* We are now ready to dispatch this packet just like the normal IP receive packet
+           processing.  */
+
+        /* Build a pointer to the IP header.  */
+        current_header =  (NX_IP_HEADER *)fragment_head -> nx_packet_prepend_ptr;
+
+        /* Determine what protocol the current IP datagram is.  */
+        protocol =  current_header -> nx_ip_header_word_2 & NX_IP_PROTOCOL_MASK;
+
+        /* Remove the IP header from the packet.  */
+        fragment_head -> nx_packet_prepend_ptr =  fragment_head -> nx_packet_prepend_ptr + sizeof(NX_IP_HEADER);
+
+        /* Adjust the length.  */
+        fragment_head -> nx_packet_length =  fragment_head -> nx_packet_length - sizeof(NX_IP_HEADER);
+
+#ifndef NX_DISABLE_IP_INFO
+
+        /* Increment the number of packets reassembled.  */
+        ip_ptr -> nx_ip_packets_reassembled++;
+
+        /* Increment the number of packets delivered.  */
+        ip_ptr -> nx_ip_total_packets_delivered++;
+
+        /* Increment the IP packet bytes received (not including the header).  */
+        ip_ptr -> nx_ip_total_bytes_received +=  fragment_head -> nx_packet_length;
+#endif
+
+        /* Determine if RAW IP is supported.  */
+        if (ip_ptr -> nx_ip_raw_ip_processing)
+        {
+
+            /* Call the raw IP packet processing routine.  */
+            (ip_ptr -> nx_ip_raw_ip_processing)(ip_ptr, fragment_head);
+        }
+
+        /* Dispatch the protocol...  Have we found a UDP packet?  */
+        else if ((protocol == NX_IP_UDP) && (ip_ptr -> nx_ip_udp_packet_receive))
+        {
+
+            /* Yes, a UDP packet is present, dispatch to the appropriate UDP handler
+               if present.  */
+            (ip_ptr -> nx_ip_udp_packet_receive)(ip_ptr, fragment_head);
+        }
+        /* Is a TCP packet present?  */
+        else if ((protocol == NX_IP_TCP) && (ip_ptr -> nx_ip_tcp_packet_receive))
+        {
+
+            /* Yes, a TCP packet is present, dispatch to the appropriate TCP handler
+               if present.  */
+            (ip_ptr -> nx_ip_tcp_packet_receive)(ip_ptr, fragment_head);
+        }
+        /* Is a ICMP packet present?  */
+        else if ((protocol == NX_IP_ICMP) && (ip_ptr -> nx_ip_icmp_packet_receive))
+        {
+
+            /* Yes, a ICMP packet is present, dispatch to the appropriate ICMP handler
+               if present.  */
+            (ip_ptr -> nx_ip_icmp_packet_receive)(ip_ptr, fragment_head);
+        }
+        else if ((protocol == NX_IP_IGMP) && (ip_ptr -> nx_ip_igmp_packet_receive))
+        {
+
+            /* Yes, a IGMP packet is present, dispatch to the appropriate ICMP handler
+               if present.  */
+            (ip_ptr -> nx_ip_igmp_packet_receive)(ip_ptr, fragment_head);
+        }
+        else
+        {
+
+#ifndef NX_DISABLE_IP_INFO
+
+            /* Decrement the number of packets delivered.  */
+            ip_ptr -> nx_ip_total_packets_delivered--;
+
+            /* Decrement the IP packet bytes received (not including the header).  */
+            ip_ptr -> nx_ip_total_bytes_received -=  fragment_head -> nx_packet_length;
+
+            /* Increment the IP unknown protocol count.  */
+            ip_ptr -> nx_ip_unknown_protocols_received++;
+
+            /* Increment the IP receive packets dropped count.  */
+            ip_ptr -> nx_ip_receive_packets_dropped++;
+#endif
+
+            /* Toss the IP packet since we don't know what to do with it!  */
+            _nx_packet_release(fragment_head);
+        }
+    }
+}
+#endif /* NX_ENABLE_IP_FRAGMENT_HASH */
+
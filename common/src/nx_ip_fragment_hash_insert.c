@@ -0,0 +1,429 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+#include "nx_packet.h"
+
+
+#ifdef NX_ENABLE_IP_FRAGMENT_HASH
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_fragment_hash_insert                         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function places an IP fragment with the datagram it belongs    */
+/*    to. The datagram is found through a hash of the source and          */
+/*    destination addresses, protocol and IP header ID, and the fragment  */
+/*    is linked in offset order, checking the last fragment first so in-  */
+/*    order fragments are placed in constant time. Fragments that overlap */
+/*    data already received, or that are not consistent with the datagram */
+/*    length, are dropped.                                                */
+/*                                                                        */
+/*    Fragments are charged to an overall and a per-source budget. A      */
+/*    fragment over the source budget is dropped. Over the overall        */
+/*    budget, or when no re-assembly structure is available, the oldest   */
+/*    datagrams are discarded first. When the fragment completes its      */
+/*    datagram, the datagram is removed from the table and its first      */
+/*    fragment is returned, with the other fragments linked in offset     */
+/*    order.                                                              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                Pointer to IP instance        */
+/*    packet_ptr                            Pointer to IP fragment        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    fragment_head                         First fragment of a complete  */
+/*                                            datagram, or NX_NULL        */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_ip_fragment_hash_remove           Remove datagram               */
+/*    _nx_packet_release                    Release dropped fragment      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_ip_fragment_hash_assembly         Process IP fragments          */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+NX_PACKET  *_nx_ip_fragment_hash_insert(NX_IP *ip_ptr, NX_PACKET *packet_ptr)
+{
+
+NX_IP_FRAGMENT_ASSEMBLY *assembly_ptr;
+NX_IP_HEADER            *ip_header_ptr;
+NX_IP_HEADER            *search_header;
+NX_PACKET               *previous_ptr;
+NX_PACKET               *next_ptr;
+NX_PACKET               *fragment_head;
+ULONG                    source_ip;
+ULONG                    destination_ip;
+ULONG                    id;
+ULONG                    key;
+ULONG                    offset;
+ULONG                    end;
+ULONG                    search_offset;
+UINT                     index;
+UINT                     source_index;
+
+
+    /* Setup a pointer to the IP header of the fragment.  */
+    ip_header_ptr =  (NX_IP_HEADER *)packet_ptr -> nx_packet_prepend_ptr;
+
+    /* Pickup the datagram key of the fragment: addresses, IP header ID and protocol.  */
+    source_ip =       ip_header_ptr -> nx_ip_header_source_ip;
+    destination_ip =  ip_header_ptr -> nx_ip_header_destination_ip;
+    id =              (ip_header_ptr -> nx_ip_header_word_1 & ~NX_LOWER_16_MASK) |
+                      ((ip_header_ptr -> nx_ip_header_word_2 & NX_IP_PROTOCOL_MASK) >> NX_SHIFT_BY_16);
+
+    /* Compute the payload range of the fragment in bytes.  */
+    offset =  (ip_header_ptr -> nx_ip_header_word_1 & NX_IP_OFFSET_MASK) * NX_IP_ALIGN_FRAGS;
+    end =     offset + (ip_header_ptr -> nx_ip_header_word_0 & NX_LOWER_16_MASK) - sizeof(NX_IP_HEADER);
+
+    /* Determine if the fragment is valid.  It must carry data, stay within the maximum
+       datagram size and, unless it is the last fragment, carry a multiple of the
+       fragment alignment.  */
+    if ((end <= offset) ||
+        (end > (NX_LOWER_16_MASK - sizeof(NX_IP_HEADER))) ||
+        ((ip_header_ptr -> nx_ip_header_word_1 & NX_IP_MORE_FRAGMENT) &&
+         ((end - offset) & (NX_IP_ALIGN_FRAGS - 1))))
+    {
+
+#ifndef NX_DISABLE_IP_INFO
+
+        /* Increment the IP receive packets dropped count.  */
+        ip_ptr -> nx_ip_receive_packets_dropped++;
+#endif
+
+        /* Release the fragment.  */
+        _nx_packet_release(packet_ptr);
+
+        /* Return, nothing is complete.  */
+        return(NX_NULL);
+    }
+
+    /* Compute the hash table index of the datagram.  */
+    key =    source_ip ^ destination_ip ^ id;
+    index =  NX_IP_FRAGMENT_HASH_INDEX(key);
+
+    /* Search the hash bucket for the datagram of this fragment.  */
+    assembly_ptr =  ip_ptr -> nx_ip_fragment_assembly_table[index];
+    while (assembly_ptr)
+    {
+
+        /* Determine if the key matches. RFC 791 Section 3.2 recommends that packet
+           fragments be compared for source IP, destination IP, protocol and IP header ID.  */
+        if ((assembly_ptr -> nx_ip_fragment_assembly_id == id) &&
+            (assembly_ptr -> nx_ip_fragment_assembly_source_ip == source_ip) &&
+            (assembly_ptr -> nx_ip_fragment_assembly_destination_ip == destination_ip))
+        {
+
+            /* Yes, the datagram is found.  */
+            break;
+        }
+
+        /* Move to the next datagram in the bucket.  */
+        assembly_ptr =  assembly_ptr -> nx_ip_fragment_assembly_hash_next;
+    }
+
+    /* Pickup the source budget the fragment is charged to.  */
+    if (assembly_ptr)
+    {
+        source_index =  assembly_ptr -> nx_ip_fragment_assembly_source_index;
+    }
+    else
+    {
+        source_index =  NX_IP_FRAGMENT_HASH_INDEX(source_ip);
+    }
+
+    /* Discard the oldest other datagrams while the overall budget is used up.  */
+    while ((ip_ptr -> nx_ip_fragment_assembly_packets >= NX_IP_FRAGMENT_MAX_PACKETS) &&
+           (ip_ptr -> nx_ip_fragment_assembly_oldest != assembly_ptr))
+    {
+
+#ifndef NX_DISABLE_IP_INFO
+
+        /* Increment the re-assembly failures count.  */
+        ip_ptr -> nx_ip_reassembly_failures++;
+
+        /* Increment the IP receive packets dropped count.  */
+        ip_ptr -> nx_ip_receive_packets_dropped +=
+            (ip_ptr -> nx_ip_fragment_assembly_oldest) -> nx_ip_fragment_assembly_packets;
+#endif
+
+        /* Remove the oldest datagram and release its fragments.  */
+        _nx_ip_fragment_hash_remove(ip_ptr, ip_ptr -> nx_ip_fragment_assembly_oldest, NX_TRUE);
+    }
+
+    /* Determine if the fragment fits in the overall and the source budgets.  */
+    if ((ip_ptr -> nx_ip_fragment_assembly_packets >= NX_IP_FRAGMENT_MAX_PACKETS) ||
+        (ip_ptr -> nx_ip_fragment_source_packets[source_index] >= NX_IP_FRAGMENT_MAX_SOURCE_PACKETS))
+    {
+
+#ifndef NX_DISABLE_IP_INFO
+
+        /* Increment the IP receive packets dropped count.  */
+        ip_ptr -> nx_ip_receive_packets_dropped++;
+#endif
+
+        /* Release the fragment.  */
+        _nx_packet_release(packet_ptr);
+
+        /* Return, nothing is complete.  */
+        return(NX_NULL);
+    }
+
+    /* Determine if this is the first fragment of a new datagram.  */
+    if (assembly_ptr == NX_NULL)
+    {
+
+        /* Determine if a re-assembly structure is available.  */
+        if (ip_ptr -> nx_ip_fragment_assembly_available == NX_NULL)
+        {
+
+#ifndef NX_DISABLE_IP_INFO
+
+            /* Increment the re-assembly failures count.  */
+            ip_ptr -> nx_ip_reassembly_failures++;
+
+            /* Increment the IP receive packets dropped count.  */
+            ip_ptr -> nx_ip_receive_packets_dropped +=
+                (ip_ptr -> nx_ip_fragment_assembly_oldest) -> nx_ip_fragment_assembly_packets;
+#endif
+
+            /* No, discard the oldest datagram to make room.  */
+            _nx_ip_fragment_hash_remove(ip_ptr, ip_ptr -> nx_ip_fragment_assembly_oldest, NX_TRUE);
+        }
+
+        /* Pickup an available re-assembly structure.  */
+        assembly_ptr =  ip_ptr -> nx_ip_fragment_assembly_available;
+        ip_ptr -> nx_ip_fragment_assembly_available =  assembly_ptr -> nx_ip_fragment_assembly_hash_next;
+
+        /* Setup the datagram.  */
+        assembly_ptr -> nx_ip_fragment_assembly_source_ip =       source_ip;
+        assembly_ptr -> nx_ip_fragment_assembly_destination_ip =  destination_ip;
+        assembly_ptr -> nx_ip_fragment_assembly_id =              id;
+        assembly_ptr -> nx_ip_fragment_assembly_first =           NX_NULL;
+        assembly_ptr -> nx_ip_fragment_assembly_last =            NX_NULL;
+        assembly_ptr -> nx_ip_fragment_assembly_received =        0;
+        assembly_ptr -> nx_ip_fragment_assembly_length =          0;
+        assembly_ptr -> nx_ip_fragment_assembly_packets =         0;
+        assembly_ptr -> nx_ip_fragment_assembly_source_index =    source_index;
+        assembly_ptr -> nx_ip_fragment_assembly_start =           ip_ptr -> nx_ip_fragment_periodic_count;
+
+        /* Place the datagram at the front of its hash bucket.  */
+        assembly_ptr -> nx_ip_fragment_assembly_hash_next =  ip_ptr -> nx_ip_fragment_assembly_table[index];
+        ip_ptr -> nx_ip_fragment_assembly_table[index] =     assembly_ptr;
+
+        /* Place the datagram at the end of the list in arrival order.  */
+        assembly_ptr -> nx_ip_fragment_assembly_older =  ip_ptr -> nx_ip_fragment_assembly_newest;
+        assembly_ptr -> nx_ip_fragment_assembly_newer =  NX_NULL;
+        if (ip_ptr -> nx_ip_fragment_assembly_newest)
+        {
+            (ip_ptr -> nx_ip_fragment_assembly_newest) -> nx_ip_fragment_assembly_newer =  assembly_ptr;
+        }
+        else
+        {
+            ip_ptr -> nx_ip_fragment_assembly_oldest =  assembly_ptr;
+        }
+        ip_ptr -> nx_ip_fragment_assembly_newest =  assembly_ptr;
+    }
+
+    /* Find the neighbors of the fragment, starting with the last fragment so fragments
+       that arrive in order are placed right away.  */
+    previous_ptr =  assembly_ptr -> nx_ip_fragment_assembly_last;
+    next_ptr =      NX_NULL;
+    if (previous_ptr)
+    {
+
+        /* Pickup the offset of the last fragment.  */
+        search_header =  (NX_IP_HEADER *)previous_ptr -> nx_packet_prepend_ptr;
+        search_offset =  (search_header -> nx_ip_header_word_1 & NX_IP_OFFSET_MASK) * NX_IP_ALIGN_FRAGS;
+
+        /* Determine if the fragment goes before the last fragment.  */
+        if (offset < search_offset)
+        {
+
+            /* Yes, walk the fragments from the first one.  */
+            previous_ptr =  NX_NULL;
+            next_ptr =      assembly_ptr -> nx_ip_fragment_assembly_first;
+            do
+            {
+
+                /* Pickup the offset of this fragment.  */
+                search_header =  (NX_IP_HEADER *)next_ptr -> nx_packet_prepend_ptr;
+                search_offset =  (search_header -> nx_ip_header_word_1 & NX_IP_OFFSET_MASK) * NX_IP_ALIGN_FRAGS;
+
+                /* Determine if the fragment goes before this fragment.  */
+                if (offset < search_offset)
+                {
+                    break;
+                }
+
+                /* Move to the next fragment.  */
+                previous_ptr =  next_ptr;
+                next_ptr =      next_ptr -> nx_packet_fragment_next;
+            } while (next_ptr);
+        }
+    }
+
+    /* Determine if the fragment overlaps the previous fragment.  */
+    if (previous_ptr)
+    {
+
+        /* Compute the end of the previous fragment.  */
+        search_header =  (NX_IP_HEADER *)previous_ptr -> nx_packet_prepend_ptr;
+        search_offset =  (search_header -> nx_ip_header_word_1 & NX_IP_OFFSET_MASK) * NX_IP_ALIGN_FRAGS +
+                         (search_header -> nx_ip_header_word_0 & NX_LOWER_16_MASK) - sizeof(NX_IP_HEADER);
+
+        /* Check for overlap.  */
+        if (search_offset > offset)
+        {
+
+            /* The fragment overlaps, remember this by clearing the end.  */
+            end =  0;
+        }
+    }
+
+    /* Determine if the fragment overlaps the next fragment.  */
+    if (next_ptr)
+    {
+
+        /* Pickup the offset of the next fragment.  */
+        search_header =  (NX_IP_HEADER *)next_ptr -> nx_packet_prepend_ptr;
+        search_offset =  (search_header -> nx_ip_header_word_1 & NX_IP_OFFSET_MASK) * NX_IP_ALIGN_FRAGS;
+
+        /* Check for overlap.  */
+        if (end > search_offset)
+        {
+
+            /* The fragment overlaps, remember this by clearing the end.  */
+            end =  0;
+        }
+    }
+
+    /* Determine if the fragment is consistent with the datagram length.  The last fragment
+       must not arrive twice and must end after all other fragments, and no fragment may end
+       after the last one.  */
+    if (assembly_ptr -> nx_ip_fragment_assembly_length)
+    {
+
+        /* Check the fragment against the known length.  */
+        if ((end > assembly_ptr -> nx_ip_fragment_assembly_length) ||
+            (!(ip_header_ptr -> nx_ip_header_word_1 & NX_IP_MORE_FRAGMENT)))
+        {
+            end =  0;
+        }
+    }
+    else if ((!(ip_header_ptr -> nx_ip_header_word_1 & NX_IP_MORE_FRAGMENT)) && (next_ptr))
+    {
+
+        /* Fragments were received beyond the end of the datagram.  */
+        end =  0;
+    }
+
+    /* Determine if the fragment must be dropped.  */
+    if (end == 0)
+    {
+
+#ifndef NX_DISABLE_IP_INFO
+
+        /* Increment the IP receive packets dropped count.  */
+        ip_ptr -> nx_ip_receive_packets_dropped++;
+#endif
+
+        /* Release the fragment.  */
+        _nx_packet_release(packet_ptr);
+
+        /* Return, nothing is complete.  */
+        return(NX_NULL);
+    }
+
+    /* Link the fragment between its neighbors.  */
+    packet_ptr -> nx_packet_fragment_next =  next_ptr;
+    if (previous_ptr)
+    {
+        previous_ptr -> nx_packet_fragment_next =  packet_ptr;
+    }
+    else
+    {
+        assembly_ptr -> nx_ip_fragment_assembly_first =  packet_ptr;
+    }
+    if (next_ptr == NX_NULL)
+    {
+        assembly_ptr -> nx_ip_fragment_assembly_last =  packet_ptr;
+    }
+
+    /* Account for the fragment.  */
+    assembly_ptr -> nx_ip_fragment_assembly_received +=  end - offset;
+    assembly_ptr -> nx_ip_fragment_assembly_packets++;
+    ip_ptr -> nx_ip_fragment_assembly_packets++;
+    ip_ptr -> nx_ip_fragment_source_packets[source_index]++;
+
+    /* Determine if this is the last fragment of the datagram.  */
+    if (!(ip_header_ptr -> nx_ip_header_word_1 & NX_IP_MORE_FRAGMENT))
+    {
+
+        /* Yes, the datagram length is now known.  */
+        assembly_ptr -> nx_ip_fragment_assembly_length =  end;
+    }
+
+    /* Determine if all data of the datagram is present.  Fragments do not overlap, so no hole
+       is left when the data received adds up to the datagram length.  */
+    if (assembly_ptr -> nx_ip_fragment_assembly_received != assembly_ptr -> nx_ip_fragment_assembly_length)
+    {
+
+        /* No, the datagram is not complete yet.  */
+        return(NX_NULL);
+    }
+
+    /* Pickup the first fragment of the complete datagram.  */
+    fragment_head =  assembly_ptr -> nx_ip_fragment_assembly_first;
+
+    /* Remove the datagram, the caller takes ownership of its fragments.  */
+    _nx_ip_fragment_hash_remove(ip_ptr, assembly_ptr, NX_FALSE);
+
+    /* Return the first fragment.  */
+    return(fragment_head);
+}
+#endif /* NX_ENABLE_IP_FRAGMENT_HASH */
+
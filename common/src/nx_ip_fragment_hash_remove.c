@@ -0,0 +1,158 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+#include "nx_packet.h"
+
+
+#ifdef NX_ENABLE_IP_FRAGMENT_HASH
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_fragment_hash_remove                         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function removes a datagram from the fragment re-assembly hash */
+/*    table and the list of datagrams in arrival order, takes its         */
+/*    fragments off the fragment budgets and makes the re-assembly        */
+/*    structure available again. If requested, the fragments are          */
+/*    released, otherwise the caller takes ownership of them.             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                Pointer to IP instance        */
+/*    assembly_ptr                          Pointer to datagram           */
+/*    release                               NX_TRUE to release fragments  */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_packet_release                    Release fragment              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_ip_fragment_hash_insert           Insert IP fragment            */
+/*    _nx_ip_fragment_hash_timeout_check    Check for fragment timeout    */
+/*    _nx_ip_fragment_disable               Disable IP fragmenting        */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_ip_fragment_hash_remove(NX_IP *ip_ptr, NX_IP_FRAGMENT_ASSEMBLY *assembly_ptr, UINT release)
+{
+
+NX_IP_FRAGMENT_ASSEMBLY **link_ptr;
+NX_PACKET                *fragment;
+NX_PACKET                *next_fragment;
+ULONG                     key;
+UINT                      index;
+
+
+    /* Compute the hash table index of the datagram.  */
+    key =    assembly_ptr -> nx_ip_fragment_assembly_source_ip ^
+             assembly_ptr -> nx_ip_fragment_assembly_destination_ip ^
+             assembly_ptr -> nx_ip_fragment_assembly_id;
+    index =  NX_IP_FRAGMENT_HASH_INDEX(key);
+
+    /* Find the link to the datagram in its hash bucket.  */
+    link_ptr =  &(ip_ptr -> nx_ip_fragment_assembly_table[index]);
+    while (*link_ptr != assembly_ptr)
+    {
+
+        /* Move to the link of the next datagram in the bucket.  */
+        link_ptr =  &((*link_ptr) -> nx_ip_fragment_assembly_hash_next);
+    }
+
+    /* Remove the datagram from its hash bucket.  */
+    *link_ptr =  assembly_ptr -> nx_ip_fragment_assembly_hash_next;
+
+    /* Remove the datagram from the list in arrival order.  */
+    if (assembly_ptr -> nx_ip_fragment_assembly_older)
+    {
+        (assembly_ptr -> nx_ip_fragment_assembly_older) -> nx_ip_fragment_assembly_newer =
+            assembly_ptr -> nx_ip_fragment_assembly_newer;
+    }
+    else
+    {
+        ip_ptr -> nx_ip_fragment_assembly_oldest =  assembly_ptr -> nx_ip_fragment_assembly_newer;
+    }
+    if (assembly_ptr -> nx_ip_fragment_assembly_newer)
+    {
+        (assembly_ptr -> nx_ip_fragment_assembly_newer) -> nx_ip_fragment_assembly_older =
+            assembly_ptr -> nx_ip_fragment_assembly_older;
+    }
+    else
+    {
+        ip_ptr -> nx_ip_fragment_assembly_newest =  assembly_ptr -> nx_ip_fragment_assembly_older;
+    }
+
+    /* Take the fragments off the overall and the source budgets.  */
+    ip_ptr -> nx_ip_fragment_assembly_packets -=  assembly_ptr -> nx_ip_fragment_assembly_packets;
+    ip_ptr -> nx_ip_fragment_source_packets[assembly_ptr -> nx_ip_fragment_assembly_source_index] -=
+        assembly_ptr -> nx_ip_fragment_assembly_packets;
+
+    /* Determine if the fragments should be released.  */
+    if (release)
+    {
+
+        /* Walk the chain of fragments of this datagram.  */
+        fragment =  assembly_ptr -> nx_ip_fragment_assembly_first;
+        while (fragment)
+        {
+
+            /* Pickup the next fragment.  */
+            next_fragment =  fragment -> nx_packet_fragment_next;
+
+            /* Release this fragment.  */
+            _nx_packet_release(fragment);
+
+            /* Move to the next fragment.  */
+            fragment =  next_fragment;
+        }
+    }
+
+    /* Place the re-assembly structure on the available list.  */
+    assembly_ptr -> nx_ip_fragment_assembly_hash_next =  ip_ptr -> nx_ip_fragment_assembly_available;
+    ip_ptr -> nx_ip_fragment_assembly_available =        assembly_ptr;
+}
+#endif /* NX_ENABLE_IP_FRAGMENT_HASH */
+
@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+
+
+#ifdef NX_ENABLE_IP_FRAGMENT_HASH
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_fragment_hash_timeout_check                  PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is called by the IP periodic processing when the      */
+/*    fragment re-assembly hash table is used. It releases the fragments  */
+/*    of every datagram that is not complete NX_IP_FRAGMENT_TIMEOUT       */
+/*    periodic events after its first fragment arrived. Datagrams are     */
+/*    kept in arrival order, so only the expired ones are visited.        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                Pointer to IP instance        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_ip_fragment_hash_remove           Remove datagram               */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_ip_thread_entry                   IP helper thread              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_ip_fragment_hash_timeout_check(NX_IP *ip_ptr)
+{
+
+NX_IP_FRAGMENT_ASSEMBLY *assembly_ptr;
+
+
+    /* Count this periodic event.  */
+    ip_ptr -> nx_ip_fragment_periodic_count++;
+
+    /* Loop to remove the datagrams that have timed out, oldest first.  */
+    assembly_ptr =  ip_ptr -> nx_ip_fragment_assembly_oldest;
+    while ((assembly_ptr) &&
+           ((ip_ptr -> nx_ip_fragment_periodic_count - assembly_ptr -> nx_ip_fragment_assembly_start) >= NX_IP_FRAGMENT_TIMEOUT))
+    {
+
+#ifndef NX_DISABLE_IP_INFO
+
+        /* Increment the re-assembly failures count.  */
+        ip_ptr -> nx_ip_reassembly_failures++;
+
+        /* Increment the IP receive packets dropped count.  */
+        ip_ptr -> nx_ip_receive_packets_dropped +=  assembly_ptr -> nx_ip_fragment_assembly_packets;
+#endif
+
+        /* Remove the datagram and release its fragments.  */
+        _nx_ip_fragment_hash_remove(ip_ptr, assembly_ptr, NX_TRUE);
+
+        /* Move to the next oldest datagram.  */
+        assembly_ptr =  ip_ptr -> nx_ip_fragment_assembly_oldest;
+    }
+}
+#endif /* NX_ENABLE_IP_FRAGMENT_HASH */
+
@@ -0,0 +1,349 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+#include "nx_tcp.h"
+#include "nx_packet.h"
+
+#ifdef NX_ENABLE_TCP_GSO
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_gso_segment_send                             PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function splits a TCP super-segment into segments of the size  */
+/*    recorded in the packet and sends them out through the associated    */
+/*    link driver, for interfaces that cannot segment TCP data            */
+/*    themselves. The IP and TCP headers of the super-segment are copied  */
+/*    into each segment, with the total length, IP identification,        */
+/*    sequence number and flags fixed up. The checksums of each segment   */
+/*    are computed here unless the interface computes them. This function */
+/*    uses the already built driver request, so the route and the         */
+/*    physical address of the next hop are resolved only once for the     */
+/*    whole super-segment.                                                */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    driver_req_ptr                        Pointer to driver request     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_packet_allocate                   Allocate packet for segment   */
+/*    _nx_packet_data_append                Copy headers and payload      */
+/*    _nx_packet_data_reference             Reference shared payload      */
+/*    _nx_packet_release                    Release partial segment       */
+/*    _nx_packet_transmit_release           Transmit packet release       */
+/*    _nx_ip_packet_checksum_compute        Compute segment checksums     */
+/*    (ip_link_driver)                      User supplied link driver     */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_arp_dynamic_entry_set             Set dynamic ARP entry         */
+/*    _nx_arp_packet_receive                Received ARP packet           */
+/*                                            processing                  */
+/*    _nx_ip_driver_packet_send             Send packet to link driver    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_ip_gso_segment_send(NX_IP_DRIVER *driver_req_ptr)
+{
+
+UINT          status;
+UCHAR        *data_ptr;
+ULONG        *header_ptr;
+ULONG         ip_header_length;
+ULONG         header_length;
+ULONG         remaining_bytes;
+ULONG         segment_bytes;
+ULONG         segment_remaining;
+ULONG         segment_size;
+ULONG         segment_count;
+ULONG         checksum_flag;
+ULONG         copy_size;
+ULONG         temp;
+NX_IP_DRIVER  driver_request;
+NX_PACKET    *packet_ptr;
+NX_PACKET    *source_packet;
+NX_PACKET    *segment_packet;
+NX_IP        *ip_ptr;
+
+
+    /* Setup the local driver request that will be used for each segment.  There will be a unique
+       packet pointer for each request, but otherwise all the other fields will remain constant.  */
+    driver_request =  *driver_req_ptr;
+
+    /* Setup the IP pointer.  */
+    ip_ptr =  driver_req_ptr -> nx_ip_driver_ptr;
+
+    /* Pickup the super-segment and the size of the segments to create.  */
+    packet_ptr =    driver_req_ptr -> nx_ip_driver_packet;
+    segment_size =  packet_ptr -> nx_packet_tcp_segment_size;
+
+    /* Compute the length of the IP header and of the IP and TCP headers together.  */
+    header_ptr =  (ULONG *)packet_ptr -> nx_packet_prepend_ptr;
+    temp =  *header_ptr;
+    NX_CHANGE_ULONG_ENDIAN(temp);
+    ip_header_length =  ((temp & NX_IP_LENGTH_MASK) >> 24) * sizeof(ULONG);
+    temp =  *(header_ptr + (ip_header_length / sizeof(ULONG)) + 3);
+    NX_CHANGE_ULONG_ENDIAN(temp);
+    header_length =  ip_header_length + ((temp >> 28) * sizeof(ULONG));
+
+    /* Both checksums cover fields that differ between the segments, so they are computed for
+       each segment, by the interface or in software.  */
+    checksum_flag =  0;
+#ifndef NX_DISABLE_IP_TX_CHECKSUM
+    checksum_flag |=  NX_INTERFACE_CAPABILITY_IPV4_TX_CHECKSUM;
+#endif /* NX_DISABLE_IP_TX_CHECKSUM */
+#ifndef NX_DISABLE_TCP_TX_CHECKSUM
+    checksum_flag |=  NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM;
+#endif /* NX_DISABLE_TCP_TX_CHECKSUM */
+
+    /* Setup the source of the payload, right after the headers.  */
+    source_packet =    packet_ptr;
+    data_ptr =         packet_ptr -> nx_packet_prepend_ptr + header_length;
+    remaining_bytes =  packet_ptr -> nx_packet_length - header_length;
+    segment_count =    0;
+
+    /* Loop to build each segment and send it out through the associated driver.  */
+    while (remaining_bytes)
+    {
+
+        /* Calculate the size of the payload of this segment.  */
+        if (remaining_bytes > segment_size)
+        {
+            segment_bytes =  segment_size;
+        }
+        else
+        {
+            segment_bytes =  remaining_bytes;
+        }
+
+        /* Allocate a packet from the default packet pool, leaving room for the physical header.  */
+        status =  _nx_packet_allocate(ip_ptr -> nx_ip_default_packet_pool, &segment_packet, NX_PHYSICAL_HEADER, TX_NO_WAIT);
+
+        /* Determine if there is a packet available.  */
+        if (status)
+        {
+
+#ifndef NX_DISABLE_IP_INFO
+
+            /* Increment the IP send packets dropped count.  */
+            ip_ptr -> nx_ip_send_packets_dropped++;
+
+            /* Increment the IP transmit resource error count.  */
+            ip_ptr -> nx_ip_transmit_resource_errors++;
+#endif /* NX_DISABLE_IP_INFO */
+
+            /* Error, not enough packets to perform the segmentation...  release the
+               super-segment, TCP retransmits the data that was not sent.  */
+            _nx_packet_transmit_release(packet_ptr);
+            return;
+        }
+
+        /* Copy the IP and TCP headers.  */
+        status =  _nx_packet_data_append(segment_packet, packet_ptr -> nx_packet_prepend_ptr, header_length,
+                                         ip_ptr -> nx_ip_default_packet_pool, NX_NO_WAIT);
+
+        /* Loop to copy the payload of the segment, walking the super-segment packet chain.  */
+        segment_remaining =  segment_bytes;
+        while ((status == NX_SUCCESS) && (segment_remaining))
+        {
+
+            /* Determine if the current packet of the chain is exhausted.  */
+            if (data_ptr == source_packet -> nx_packet_append_ptr)
+            {
+
+                /* Move to the next packet in the chain.  */
+                source_packet =  source_packet -> nx_packet_next;
+
+                /* Determine if the chain is shorter than the super-segment.  */
+                if (source_packet == NX_NULL)
+                {
+
+#ifndef NX_DISABLE_IP_INFO
+
+                    /* Increment the invalid transmit packet count.  */
+                    ip_ptr -> nx_ip_invalid_transmit_packets++;
+#endif /* NX_DISABLE_IP_INFO */
+
+                    /* Stop building the segments.  */
+                    status =  NX_INVALID_PACKET;
+                    break;
+                }
+
+                /* Setup new source pointer.  */
+                data_ptr =  source_packet -> nx_packet_prepend_ptr;
+                continue;
+            }
+
+            /* Copy as much of this packet as fits in the segment.  */
+            copy_size =  (ULONG)(source_packet -> nx_packet_append_ptr - data_ptr);
+            if (copy_size > segment_remaining)
+            {
+                copy_size =  segment_remaining;
+            }
+
+#ifdef NX_ENABLE_PACKET_CLONE
+            /* Determine if the payload is in a shared buffer, such as an application buffer
+               of a zero copy send.  */
+            if (source_packet -> nx_packet_clone_source)
+            {
+
+                /* Yes, reference the payload from the segment instead of copying it.  */
+                status =  _nx_packet_data_reference(segment_packet, source_packet, data_ptr, copy_size,
+                                                    ip_ptr -> nx_ip_default_packet_pool, NX_NO_WAIT);
+            }
+            else
+#endif /* NX_ENABLE_PACKET_CLONE */
+            {
+
+                /* Append the payload.  */
+                status =  _nx_packet_data_append(segment_packet, data_ptr, copy_size,
+                                                 ip_ptr -> nx_ip_default_packet_pool, NX_NO_WAIT);
+            }
+
+            /* Advance past the payload.  */
+            data_ptr +=           copy_size;
+            segment_remaining -=  copy_size;
+        }
+
+        /* Determine if the segment could not be built.  */
+        if (status)
+        {
+
+#ifndef NX_DISABLE_IP_INFO
+
+            /* Increment the IP send packets dropped count.  */
+            ip_ptr -> nx_ip_send_packets_dropped++;
+
+            /* Increment the IP transmit resource error count.  */
+            ip_ptr -> nx_ip_transmit_resource_errors++;
+#endif /* NX_DISABLE_IP_INFO */
+
+            /* Release the partial segment and the super-segment.  */
+            _nx_packet_release(segment_packet);
+            _nx_packet_transmit_release(packet_ptr);
+            return;
+        }
+
+        /* Reduce the remaining payload.  */
+        remaining_bytes -=  segment_bytes;
+
+        /* Fix up the IP total length.  */
+        header_ptr =  (ULONG *)segment_packet -> nx_packet_prepend_ptr;
+        temp =  *header_ptr;
+        NX_CHANGE_ULONG_ENDIAN(temp);
+        temp =  (temp & ~NX_IP_PACKET_SIZE_MASK) | (header_length + segment_bytes);
+        NX_CHANGE_ULONG_ENDIAN(temp);
+        *header_ptr =  temp;
+
+        /* Fix up the IP identification, the IP layer reserved one for each segment.  */
+        temp =  *(header_ptr + 1);
+        NX_CHANGE_ULONG_ENDIAN(temp);
+        temp =  temp + (segment_count << NX_SHIFT_BY_16);
+        NX_CHANGE_ULONG_ENDIAN(temp);
+        *(header_ptr + 1) =  temp;
+
+        /* Fix up the TCP sequence number.  */
+        header_ptr =  header_ptr + (ip_header_length / sizeof(ULONG));
+        temp =  *(header_ptr + 1);
+        NX_CHANGE_ULONG_ENDIAN(temp);
+        temp =  temp + (segment_count * segment_size);
+        NX_CHANGE_ULONG_ENDIAN(temp);
+        *(header_ptr + 1) =  temp;
+
+        /* Only the last segment keeps the FIN and PSH flags.  */
+        if (remaining_bytes)
+        {
+            temp =  *(header_ptr + 3);
+            NX_CHANGE_ULONG_ENDIAN(temp);
+            temp =  temp & ~(NX_TCP_FIN_BIT | NX_TCP_PSH_BIT);
+            NX_CHANGE_ULONG_ENDIAN(temp);
+            *(header_ptr + 3) =  temp;
+        }
+
+        /* Set the proper interface.  */
+        segment_packet -> nx_packet_ip_interface =  packet_ptr -> nx_packet_ip_interface;
+
+        /* Compute the checksums the interface does not compute in software.  */
+        segment_packet -> nx_packet_interface_capability_flag =
+            checksum_flag & ~(segment_packet -> nx_packet_ip_interface -> nx_interface_capability_flag);
+        _nx_ip_packet_checksum_compute(segment_packet);
+
+        /* Leave the other checksums to the interface.  */
+        segment_packet -> nx_packet_interface_capability_flag =
+            checksum_flag & segment_packet -> nx_packet_ip_interface -> nx_interface_capability_flag;
+
+#ifndef NX_DISABLE_IP_INFO
+
+        /* Increment the IP packet sent count.  */
+        ip_ptr -> nx_ip_total_packets_sent++;
+
+        /* Increment the IP bytes sent count.  */
+        ip_ptr -> nx_ip_total_bytes_sent +=  segment_packet -> nx_packet_length - ip_header_length;
+#endif /* NX_DISABLE_IP_INFO */
+
+#ifndef NX_DISABLE_TCP_INFO
+
+        /* Increment the count of segments built in software.  */
+        ip_ptr -> nx_ip_tcp_gso_segments_sent++;
+#endif /* NX_DISABLE_TCP_INFO */
+
+        /* Send the segment to the associated driver for output.  */
+        driver_request.nx_ip_driver_packet =  segment_packet;
+
+        /* If trace is enabled, insert this event into the trace buffer.  */
+        NX_TRACE_IN_LINE_INSERT(NX_TRACE_INTERNAL_IO_DRIVER_PACKET_SEND, ip_ptr, segment_packet, segment_packet -> nx_packet_length, 0, NX_TRACE_INTERNAL_EVENTS, 0, 0);
+
+        (segment_packet -> nx_packet_ip_interface -> nx_interface_link_driver_entry)(&driver_request);
+
+        /* Move to the next segment.  */
+        segment_count++;
+    }
+
+    /* The super-segment has been sent out in segments... release it!  */
+    _nx_packet_transmit_release(packet_ptr);
+}
+#endif /* NX_ENABLE_TCP_GSO */
@@ -78,6 +78,11 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            queried the interface       */
+/*                                            capabilities from the link  */
+/*                                            driver, resulting in        */
+/*                                            version 6.x                 */
 /*                                                                        */
 /**************************************************************************/
 UINT _nx_ip_interface_attach(NX_IP *ip_ptr, CHAR *interface_name, ULONG ip_address, ULONG network_mask, VOID (*ip_link_driver)(struct NX_IP_DRIVER_STRUCT *))
@@ -86,6 +91,9 @@ UINT _nx_ip_interface_attach(NX_IP *ip_ptr, CHAR *interface_name, ULONG ip_addre
 int           i;
 NX_INTERFACE *nx_interface = NX_NULL;
 NX_IP_DRIVER  driver_request;
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+ULONG         capability_flag;
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
 
 
     /* This function must be called within the system initialization
@@ -156,7 +164,27 @@ NX_IP_DRIVER  driver_request;
         */
         (ip_ptr -> nx_ip_interface[i].nx_interface_link_driver_entry) (&driver_request);
 
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
 
+        /* Ask the link driver which checksum and segmentation work its hardware can take over.
+           Drivers that do not know the command leave the interface without offload.  */
+        capability_flag =                         0;
+        driver_request.nx_ip_driver_ptr =         ip_ptr;
+        driver_request.nx_ip_driver_command =     NX_LINK_GET_CAPABILITY;
+        driver_request.nx_ip_driver_return_ptr =  &capability_flag;
+        driver_request.nx_ip_driver_status =      NX_UNHANDLED_COMMAND;
+        (ip_ptr -> nx_ip_interface[i].nx_interface_link_driver_entry) (&driver_request);
+
+        /* Record the capabilities if the driver handled the command.  */
+        if (driver_request.nx_ip_driver_status == NX_SUCCESS)
+        {
+            ip_ptr -> nx_ip_interface[i].nx_interface_capability_flag =  capability_flag;
+        }
+        else
+        {
+            ip_ptr -> nx_ip_interface[i].nx_interface_capability_flag =  0;
+        }
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
 
         /* Call the link driver again to enable the interface.  */
         driver_request.nx_ip_driver_ptr =      ip_ptr;
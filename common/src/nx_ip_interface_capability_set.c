@@ -0,0 +1,104 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_interface_capability_set                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function sets the offload capabilities of the specified        */
+/*    interface.  It overrides the capabilities reported by the link      */
+/*    driver, for example to turn off an offload the hardware handles     */
+/*    poorly.                                                             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                IP control block pointer      */
+/*    interface_index                       IP interface index            */
+/*    interface_capability_flag             Capability flags              */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_ip_interface_capability_set(NX_IP *ip_ptr, UINT interface_index, ULONG interface_capability_flag)
+{
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+
+
+    /* Check for valid interface ID */
+    if (interface_index >= NX_MAX_PHYSICAL_INTERFACES)
+    {
+        return(NX_INVALID_INTERFACE);
+    }
+
+    /* Check for interface being valid. */
+    if (!ip_ptr -> nx_ip_interface[interface_index].nx_interface_valid)
+    {
+        return(NX_INVALID_INTERFACE);
+    }
+
+    /* Set the capability flags.  */
+    ip_ptr -> nx_ip_interface[interface_index].nx_interface_capability_flag =  interface_capability_flag;
+
+    /* Return completion status.  */
+    return(NX_SUCCESS);
+#else /* !NX_ENABLE_INTERFACE_CAPABILITY */
+    NX_PARAMETER_NOT_USED(ip_ptr);
+    NX_PARAMETER_NOT_USED(interface_index);
+    NX_PARAMETER_NOT_USED(interface_capability_flag);
+
+    /* Interface capability is not enabled.  */
+    return(NX_NOT_SUPPORTED);
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+}
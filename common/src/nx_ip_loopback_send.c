@@ -59,6 +59,7 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _nx_ip_packet_deferred_receive        Receive loopback packet       */
+/*    _nx_packet_clone                      Clone packet for loopback     */
 /*    _nx_packet_copy                       Copy packet for loopback      */
 /*    _nx_packet_transmit_release           Release transmit packet       */
 /*                                                                        */
@@ -73,6 +74,9 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), cloned   */
+/*                                            packets when enabled,       */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID _nx_ip_loopback_send(NX_IP *ip_ptr, NX_PACKET *packet_ptr, UINT packet_release)
@@ -80,9 +84,15 @@ VOID _nx_ip_loopback_send(NX_IP *ip_ptr, NX_PACKET *packet_ptr, UINT packet_rele
 
 NX_PACKET *packet_copy;
 
+#ifdef NX_ENABLE_PACKET_CLONE
+    /* Clone the packet so it can be enqueued properly by the receive
+       processing.  Only the first packet of the chain is copied.  */
+    if (_nx_packet_clone(packet_ptr, &packet_copy, ip_ptr -> nx_ip_default_packet_pool, NX_NO_WAIT) == NX_SUCCESS)
+#else
     /* Copy the packet so it can be enqueued properly by the receive
        processing.  */
     if (_nx_packet_copy(packet_ptr, &packet_copy, ip_ptr -> nx_ip_default_packet_pool, NX_NO_WAIT) == NX_SUCCESS)
+#endif /* NX_ENABLE_PACKET_CLONE */
     {
 
 #ifndef NX_DISABLE_IP_INFO
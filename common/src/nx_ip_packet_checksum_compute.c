@@ -0,0 +1,216 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+#include "nx_tcp.h"
+#include "nx_udp.h"
+
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_packet_checksum_compute                      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function computes, in software, the checksums NetX left for    */
+/*    the link driver to compute on an outgoing IP packet.  It is used    */
+/*    when the packet cannot reach hardware that will compute them, for   */
+/*    example when it is looped back, broadcast or fragmented.  It is     */
+/*    also used by drivers that simulate checksum offload.  The packet    */
+/*    prepend pointer must point to the IP header, which is in network    */
+/*    byte order.                                                         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    packet_ptr                            Pointer to packet             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_ip_checksum_compute               Compute TCP or UDP checksum   */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_ip_driver_packet_send             Send packet to link driver    */
+/*    _nx_ram_network_driver                RAM network driver            */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_ip_packet_checksum_compute(NX_PACKET *packet_ptr)
+{
+
+ULONG         *word_ptr;
+ULONG          ip_header_length;
+ULONG          protocol;
+ULONG          source_ip;
+ULONG          destination_ip;
+ULONG          checksum;
+ULONG          temp;
+ULONG          i;
+NX_TCP_HEADER *tcp_header_ptr;
+NX_UDP_HEADER *udp_header_ptr;
+
+
+    /* Determine if there is any checksum left to compute.  */
+    if (packet_ptr -> nx_packet_interface_capability_flag == 0)
+    {
+        return;
+    }
+
+    /* Pickup the IP header fields needed to compute the checksums.  */
+    word_ptr =  (ULONG *)packet_ptr -> nx_packet_prepend_ptr;
+    temp =  *word_ptr;
+    NX_CHANGE_ULONG_ENDIAN(temp);
+    ip_header_length =  (temp & NX_IP_LENGTH_MASK) >> 24;
+    temp =  *(word_ptr + 2);
+    NX_CHANGE_ULONG_ENDIAN(temp);
+    protocol =  temp & NX_IP_PROTOCOL_MASK;
+    source_ip =  *(word_ptr + 3);
+    NX_CHANGE_ULONG_ENDIAN(source_ip);
+    destination_ip =  *(word_ptr + 4);
+    NX_CHANGE_ULONG_ENDIAN(destination_ip);
+
+    /* Determine if the TCP or UDP checksum is pending.  */
+    if (((protocol == NX_IP_TCP) && (packet_ptr -> nx_packet_interface_capability_flag & NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM)) ||
+        ((protocol == NX_IP_UDP) && (packet_ptr -> nx_packet_interface_capability_flag & NX_INTERFACE_CAPABILITY_UDP_TX_CHECKSUM)))
+    {
+
+        /* Position the packet at the transport header.  */
+        packet_ptr -> nx_packet_prepend_ptr =  packet_ptr -> nx_packet_prepend_ptr + (ip_header_length * sizeof(ULONG));
+        packet_ptr -> nx_packet_length =  packet_ptr -> nx_packet_length - (ip_header_length * sizeof(ULONG));
+
+        /* Clear the checksum field, it may still hold a value from a previous transmission.  */
+        tcp_header_ptr =  (NX_TCP_HEADER *)packet_ptr -> nx_packet_prepend_ptr;
+        udp_header_ptr =  (NX_UDP_HEADER *)packet_ptr -> nx_packet_prepend_ptr;
+        if (protocol == NX_IP_TCP)
+        {
+            temp =  tcp_header_ptr -> nx_tcp_header_word_4;
+            NX_CHANGE_ULONG_ENDIAN(temp);
+            temp =  temp & NX_LOWER_16_MASK;
+            NX_CHANGE_ULONG_ENDIAN(temp);
+            tcp_header_ptr -> nx_tcp_header_word_4 =  temp;
+        }
+        else
+        {
+            temp =  udp_header_ptr -> nx_udp_header_word_1;
+            NX_CHANGE_ULONG_ENDIAN(temp);
+            temp =  temp & ~NX_LOWER_16_MASK;
+            NX_CHANGE_ULONG_ENDIAN(temp);
+            udp_header_ptr -> nx_udp_header_word_1 =  temp;
+        }
+
+        /* Compute the checksum over the transport header and data.  */
+        checksum =  _nx_ip_checksum_compute(packet_ptr, protocol, packet_ptr -> nx_packet_length,
+                                            source_ip, destination_ip);
+        checksum =  ~checksum & NX_LOWER_16_MASK;
+
+        if (protocol == NX_IP_TCP)
+        {
+
+            /* Place the checksum in the upper half of the fifth TCP header word.  */
+            temp =  tcp_header_ptr -> nx_tcp_header_word_4;
+            NX_CHANGE_ULONG_ENDIAN(temp);
+            temp =  (temp & NX_LOWER_16_MASK) | (checksum << NX_SHIFT_BY_16);
+            NX_CHANGE_ULONG_ENDIAN(temp);
+            tcp_header_ptr -> nx_tcp_header_word_4 =  temp;
+        }
+        else
+        {
+
+            /* A computed UDP checksum of zero is sent as all ones.  */
+            if (checksum == 0)
+            {
+                checksum =  NX_LOWER_16_MASK;
+            }
+
+            /* Place the checksum in the lower half of the second UDP header word.  */
+            temp =  udp_header_ptr -> nx_udp_header_word_1;
+            NX_CHANGE_ULONG_ENDIAN(temp);
+            temp =  (temp & ~NX_LOWER_16_MASK) | checksum;
+            NX_CHANGE_ULONG_ENDIAN(temp);
+            udp_header_ptr -> nx_udp_header_word_1 =  temp;
+        }
+
+        /* Restore the packet to the IP header.  */
+        packet_ptr -> nx_packet_prepend_ptr =  packet_ptr -> nx_packet_prepend_ptr - (ip_header_length * sizeof(ULONG));
+        packet_ptr -> nx_packet_length =  packet_ptr -> nx_packet_length + (ip_header_length * sizeof(ULONG));
+    }
+
+    /* Determine if the IP header checksum is pending.  */
+    if (packet_ptr -> nx_packet_interface_capability_flag & NX_INTERFACE_CAPABILITY_IPV4_TX_CHECKSUM)
+    {
+
+        /* Clear the checksum field.  */
+        temp =  *(word_ptr + 2);
+        NX_CHANGE_ULONG_ENDIAN(temp);
+        temp =  temp & ~NX_LOWER_16_MASK;
+        NX_CHANGE_ULONG_ENDIAN(temp);
+        *(word_ptr + 2) =  temp;
+
+        /* Sum all the words of the IP header.  */
+        checksum =  0;
+        for (i = 0; i < ip_header_length; i++)
+        {
+            temp =  *(word_ptr + i);
+            NX_CHANGE_ULONG_ENDIAN(temp);
+            checksum +=  (temp >> NX_SHIFT_BY_16) + (temp & NX_LOWER_16_MASK);
+        }
+
+        /* Add in the carry bits into the checksum.  */
+        checksum = (checksum >> NX_SHIFT_BY_16) + (checksum & NX_LOWER_16_MASK);
+
+        /* Do it again in case previous operation generates an overflow.  */
+        checksum = (checksum >> NX_SHIFT_BY_16) + (checksum & NX_LOWER_16_MASK);
+
+        /* Now store the checksum in the IP header.  */
+        temp =  *(word_ptr + 2);
+        NX_CHANGE_ULONG_ENDIAN(temp);
+        temp =  temp | (NX_LOWER_16_MASK & (~checksum));
+        NX_CHANGE_ULONG_ENDIAN(temp);
+        *(word_ptr + 2) =  temp;
+    }
+
+    /* All checksums are now in place.  */
+    packet_ptr -> nx_packet_interface_capability_flag =  0;
+}
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
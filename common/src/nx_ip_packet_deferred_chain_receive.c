@@ -0,0 +1,116 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_packet_deferred_chain_receive                PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function receives a chain of packets from the link driver      */
+/*    (usually the link driver's input ISR) and places the whole chain in */
+/*    the deferred receive packet queue with interrupts disabled once.    */
+/*    The packets are linked in receive order through                     */
+/*    nx_packet_queue_next, the last packet of the chain is given by the  */
+/*    caller.  This lets a driver that takes many frames per interrupt    */
+/*    hand them to the IP helper thread at the cost of a single packet.   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                Pointer to IP control block   */
+/*    head_ptr                              First packet of the chain     */
+/*    tail_ptr                              Last packet of the chain      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    tx_event_flags_set                    Set events for IP thread      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application I/O Driver                                              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_ip_packet_deferred_chain_receive(NX_IP *ip_ptr, NX_PACKET *head_ptr, NX_PACKET *tail_ptr)
+{
+
+TX_INTERRUPT_SAVE_AREA
+
+
+    /* Terminate the chain.  */
+    tail_ptr -> nx_packet_queue_next =  NX_NULL;
+
+    /* Disable interrupts.  */
+    TX_DISABLE
+
+    /* Check to see if the deferred processing queue is empty.  */
+    if (ip_ptr -> nx_ip_deferred_received_packet_head)
+    {
+
+        /* Not empty, just place the chain at the end of the queue.  */
+        (ip_ptr -> nx_ip_deferred_received_packet_tail) -> nx_packet_queue_next =  head_ptr;
+        ip_ptr -> nx_ip_deferred_received_packet_tail =  tail_ptr;
+
+        /* Restore interrupts.  */
+        TX_RESTORE
+    }
+    else
+    {
+
+        /* Empty deferred receive processing queue.  Just setup the head pointers and
+           set the event flags to ensure the IP helper thread looks at the deferred processing
+           queue.  */
+        ip_ptr -> nx_ip_deferred_received_packet_head =  head_ptr;
+        ip_ptr -> nx_ip_deferred_received_packet_tail =  tail_ptr;
+
+        /* Restore interrupts.  */
+        TX_RESTORE
+
+        /* Wakeup IP helper thread to process the IP deferred receive.  */
+        tx_event_flags_set(&(ip_ptr -> nx_ip_events), NX_IP_RECEIVE_EVENT, TX_OR);
+    }
+}
+
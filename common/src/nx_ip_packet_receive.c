@@ -82,6 +82,10 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            supported IP header         */
+/*                                            checksum offload, resulting */
+/*                                            in version 6.x              */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_ip_packet_receive(NX_IP *ip_ptr, NX_PACKET *packet_ptr)
@@ -102,6 +106,7 @@ UINT           dest_port;
 ULONG          ip_option_words;
 ULONG          checksum;
 ULONG          temp;
+UINT           compute_checksum =  NX_TRUE;
 #endif /* NX_DISABLE_IP_RX_CHECKSUM */
 
 
@@ -289,26 +294,42 @@ ULONG          temp;
 
 #ifndef NX_DISABLE_IP_RX_CHECKSUM
 
-    /* Perform a checksum on the packet header.  */
-    temp =       ip_header_ptr -> nx_ip_header_word_0;
-    checksum =   (temp >> NX_SHIFT_BY_16) + (temp & NX_LOWER_16_MASK);
-    temp =       ip_header_ptr -> nx_ip_header_word_1;
-    checksum +=  (temp >> NX_SHIFT_BY_16) + (temp & NX_LOWER_16_MASK);
-    temp =       ip_header_ptr -> nx_ip_header_word_2;
-    checksum +=  (temp >> NX_SHIFT_BY_16) + (temp & NX_LOWER_16_MASK);
-    temp =       ip_header_ptr -> nx_ip_header_source_ip;
-    checksum +=  (temp >> NX_SHIFT_BY_16) + (temp & NX_LOWER_16_MASK);
-    temp =       ip_header_ptr -> nx_ip_header_destination_ip;
-    checksum +=  (temp >> NX_SHIFT_BY_16) + (temp & NX_LOWER_16_MASK);
-
-    /* Add in the carry bits into the checksum.  */
-    checksum = (checksum >> NX_SHIFT_BY_16) + (checksum & NX_LOWER_16_MASK);
-
-    /* Do it again in case previous operation generates an overflow.  */
-    checksum = (checksum >> NX_SHIFT_BY_16) + (checksum & NX_LOWER_16_MASK);
-
-    /* Take the one's complement.  */
-    checksum =   NX_LOWER_16_MASK & ~checksum;
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+    /* Determine if the interface already verified the checksum of a header without options.  */
+    if ((packet_ptr -> nx_packet_ip_interface -> nx_interface_capability_flag & NX_INTERFACE_CAPABILITY_IPV4_RX_CHECKSUM) &&
+        (ip_header_length == NX_IP_NORMAL_LENGTH))
+    {
+
+        /* Yes, treat the header checksum as valid.  */
+        compute_checksum =  NX_FALSE;
+        checksum =  0;
+    }
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
+    if (compute_checksum)
+    {
+
+        /* Perform a checksum on the packet header.  */
+        temp =       ip_header_ptr -> nx_ip_header_word_0;
+        checksum =   (temp >> NX_SHIFT_BY_16) + (temp & NX_LOWER_16_MASK);
+        temp =       ip_header_ptr -> nx_ip_header_word_1;
+        checksum +=  (temp >> NX_SHIFT_BY_16) + (temp & NX_LOWER_16_MASK);
+        temp =       ip_header_ptr -> nx_ip_header_word_2;
+        checksum +=  (temp >> NX_SHIFT_BY_16) + (temp & NX_LOWER_16_MASK);
+        temp =       ip_header_ptr -> nx_ip_header_source_ip;
+        checksum +=  (temp >> NX_SHIFT_BY_16) + (temp & NX_LOWER_16_MASK);
+        temp =       ip_header_ptr -> nx_ip_header_destination_ip;
+        checksum +=  (temp >> NX_SHIFT_BY_16) + (temp & NX_LOWER_16_MASK);
+
+        /* Add in the carry bits into the checksum.  */
+        checksum = (checksum >> NX_SHIFT_BY_16) + (checksum & NX_LOWER_16_MASK);
+
+        /* Do it again in case previous operation generates an overflow.  */
+        checksum = (checksum >> NX_SHIFT_BY_16) + (checksum & NX_LOWER_16_MASK);
+
+        /* Take the one's complement.  */
+        checksum =   NX_LOWER_16_MASK & ~checksum;
+    }
 
     /* Determine if the checksum is valid.  */
     if (checksum)
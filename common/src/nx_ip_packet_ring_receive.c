@@ -0,0 +1,98 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_packet_ring_receive                          PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function receives a packet from the receive ISR or thread of   */
+/*    the link driver and places it in the deferred receive ring of the   */
+/*    IP instance, without disabling interrupts. The ring has a single    */
+/*    producer, so this function must only be called from one driver     */
+/*    context per IP instance. Loopback, PPP and other senders use        */
+/*    _nx_ip_packet_deferred_receive, which queues on the list protected  */
+/*    by disabling interrupts. Without NX_ENABLE_IP_RECEIVE_RING, the     */
+/*    packet is passed to _nx_ip_packet_deferred_receive.                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                Pointer to IP control block   */
+/*    packet_ptr                            Pointer to packet received    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_ip_packet_deferred_receive        Queue packet on locked list   */
+/*    _nx_ip_receive_ring_put               Place packet in ring          */
+/*    tx_event_flags_set                    Set events for IP thread      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application I/O Driver                                              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_ip_packet_ring_receive(NX_IP *ip_ptr, NX_PACKET *packet_ptr)
+{
+
+#ifdef NX_ENABLE_IP_RECEIVE_RING
+
+    /* Place the packet in the deferred receive ring without disabling interrupts.  */
+    packet_ptr -> nx_packet_queue_next =  NX_NULL;
+    if (_nx_ip_receive_ring_put(&(ip_ptr -> nx_ip_deferred_receive_ring), packet_ptr))
+    {
+
+        /* The ring was empty, wakeup IP helper thread to process the IP deferred receive.  */
+        tx_event_flags_set(&(ip_ptr -> nx_ip_events), NX_IP_RECEIVE_EVENT, TX_OR);
+    }
+#else
+
+    /* No receive ring, queue the packet on the deferred receive list.  */
+    _nx_ip_packet_deferred_receive(ip_ptr, packet_ptr);
+#endif /* NX_ENABLE_IP_RECEIVE_RING */
+}
+
@@ -0,0 +1,140 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+
+
+#ifdef NX_ENABLE_IP_RECEIVE_RING
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_receive_ring_get                             PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function removes all packets from a receive ring without       */
+/*    disabling interrupts and returns them as a list linked by their     */
+/*    queue pointers. It must only be called from the consumer of the     */
+/*    ring, which is the IP helper thread. The consumer must call this    */
+/*    function until it returns NULL before it waits for the next wakeup. */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ring_ptr                              Pointer to receive ring       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    packet_ptr                            First packet removed, or NULL */
+/*                                            if the ring is empty        */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_ip_thread_entry                   IP helper thread              */
+/*    _nx_ip_delete                         Delete IP instance            */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+NX_PACKET  *_nx_ip_receive_ring_get(NX_IP_RECEIVE_RING *ring_ptr)
+{
+
+ULONG      producer;
+ULONG      consumer;
+NX_PACKET *head_ptr;
+NX_PACKET *tail_ptr;
+NX_PACKET *packet_ptr;
+
+
+    /* Pickup the indexes.  Only this context changes the consumer index.  */
+    consumer =  ring_ptr -> nx_ip_receive_ring_consumer;
+    producer =  ring_ptr -> nx_ip_receive_ring_producer;
+
+    /* Determine if the ring is empty.  */
+    if (consumer == producer)
+    {
+
+        /* Yes, there is nothing to process.  */
+        return(NX_NULL);
+    }
+
+    /* Make sure the slots are read after the producer index.  */
+    NX_IP_RECEIVE_RING_BARRIER
+
+    /* Loop to link all published packets into a list.  */
+    head_ptr =  NX_NULL;
+    tail_ptr =  NX_NULL;
+    while (consumer != producer)
+    {
+
+        /* Pickup the packet of this slot.  */
+        packet_ptr =  ring_ptr -> nx_ip_receive_ring_packets[consumer & (NX_IP_RECEIVE_RING_SIZE - 1)];
+        consumer++;
+
+        /* Link the packet at the end of the list.  */
+        if (tail_ptr)
+        {
+            tail_ptr -> nx_packet_queue_next =  packet_ptr;
+        }
+        else
+        {
+            head_ptr =  packet_ptr;
+        }
+        tail_ptr =  packet_ptr;
+    }
+
+    /* Terminate the list.  */
+    tail_ptr -> nx_packet_queue_next =  NX_NULL;
+
+    /* Make sure the slots are read before they are given back to the producer.  */
+    NX_IP_RECEIVE_RING_BARRIER
+
+    /* Give the slots back to the producer.  */
+    ring_ptr -> nx_ip_receive_ring_consumer =  consumer;
+
+    /* Make sure the slots are given back before the producer index is checked again.  */
+    NX_IP_RECEIVE_RING_BARRIER
+
+    /* Return the list of packets.  */
+    return(head_ptr);
+}
+#endif /* NX_ENABLE_IP_RECEIVE_RING */
+
@@ -0,0 +1,114 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_receive_ring_info_get                        PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function retrieves the number of packets waiting in the        */
+/*    receive rings of the specified IP instance and the number of        */
+/*    packets the rings dropped because they were full.                   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                Pointer to IP instance        */
+/*    packets_queued                        Destination for packets       */
+/*                                            queued                      */
+/*    overflows                             Destination for packets       */
+/*                                            dropped                     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_ip_receive_ring_info_get(NX_IP *ip_ptr, ULONG *packets_queued, ULONG *overflows)
+{
+#ifdef NX_ENABLE_IP_RECEIVE_RING
+NX_IP_RECEIVE_RING *ring_ptr;
+
+
+    /* Setup a pointer to the deferred receive ring.  */
+    ring_ptr =  &(ip_ptr -> nx_ip_deferred_receive_ring);
+
+    /* Determine if packets queued is wanted.  */
+    if (packets_queued)
+    {
+        *packets_queued =  ring_ptr -> nx_ip_receive_ring_producer - ring_ptr -> nx_ip_receive_ring_consumer;
+#ifdef NX_DRIVER_DEFERRED_PROCESSING
+        *packets_queued +=  ip_ptr -> nx_ip_driver_deferred_ring.nx_ip_receive_ring_producer -
+                            ip_ptr -> nx_ip_driver_deferred_ring.nx_ip_receive_ring_consumer;
+#endif /* NX_DRIVER_DEFERRED_PROCESSING */
+    }
+
+    /* Determine if overflows is wanted.  */
+    if (overflows)
+    {
+        *overflows =  ring_ptr -> nx_ip_receive_ring_overflows;
+#ifdef NX_DRIVER_DEFERRED_PROCESSING
+        *overflows +=  ip_ptr -> nx_ip_driver_deferred_ring.nx_ip_receive_ring_overflows;
+#endif /* NX_DRIVER_DEFERRED_PROCESSING */
+    }
+
+    /* Return completion status.  */
+    return(NX_SUCCESS);
+#else
+    NX_PARAMETER_NOT_USED(ip_ptr);
+    NX_PARAMETER_NOT_USED(packets_queued);
+    NX_PARAMETER_NOT_USED(overflows);
+
+    /* Return an error.  */
+    return(NX_NOT_ENABLED);
+#endif /* NX_ENABLE_IP_RECEIVE_RING */
+}
+
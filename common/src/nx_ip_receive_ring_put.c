@@ -0,0 +1,155 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+#include "nx_packet.h"
+
+
+#ifdef NX_ENABLE_IP_RECEIVE_RING
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_receive_ring_put                             PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function places a list of received packets, linked by their    */
+/*    queue pointers, in a receive ring without disabling interrupts. It  */
+/*    must only be called from the single producer of the ring. Packets   */
+/*    that do not fit are released and counted as overflows.              */
+/*                                                                        */
+/*    The caller must wake up the consumer when this function returns     */
+/*    NX_TRUE, which is the case when the ring was empty before the       */
+/*    packets were published. The consumer index is checked again after   */
+/*    publishing, so a consumer that emptied the ring concurrently is not */
+/*    missed.                                                             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ring_ptr                              Pointer to receive ring       */
+/*    head_ptr                              Pointer to first packet       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                NX_TRUE if the consumer must  */
+/*                                            be woken up                 */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_packet_release                    Release dropped packet        */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_ip_packet_ring_receive            Defer IP packet receive       */
+/*    _nx_ip_driver_deferred_receive        Defer driver packet receive   */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_ip_receive_ring_put(NX_IP_RECEIVE_RING *ring_ptr, NX_PACKET *head_ptr)
+{
+
+ULONG      first;
+ULONG      producer;
+ULONG      consumer;
+NX_PACKET *next_packet_ptr;
+
+
+    /* Pickup the indexes.  Only this context changes the producer index.  */
+    producer =  ring_ptr -> nx_ip_receive_ring_producer;
+    consumer =  ring_ptr -> nx_ip_receive_ring_consumer;
+    first =     producer;
+
+    /* Loop through the list of packets.  */
+    while (head_ptr)
+    {
+
+        /* Pickup the next packet.  */
+        next_packet_ptr =  head_ptr -> nx_packet_queue_next;
+
+        /* Determine if the ring looks full.  */
+        if ((producer - consumer) >= NX_IP_RECEIVE_RING_SIZE)
+        {
+
+            /* Pickup the consumer index again, the consumer may have made room.  */
+            consumer =  ring_ptr -> nx_ip_receive_ring_consumer;
+
+            /* Determine if the ring is full.  */
+            if ((producer - consumer) >= NX_IP_RECEIVE_RING_SIZE)
+            {
+
+                /* Yes, drop the packet.  */
+                ring_ptr -> nx_ip_receive_ring_overflows++;
+                _nx_packet_release(head_ptr);
+
+                /* Move to the next packet.  */
+                head_ptr =  next_packet_ptr;
+                continue;
+            }
+        }
+
+        /* Place the packet in the next free slot.  */
+        ring_ptr -> nx_ip_receive_ring_packets[producer & (NX_IP_RECEIVE_RING_SIZE - 1)] =  head_ptr;
+        producer++;
+
+        /* Move to the next packet.  */
+        head_ptr =  next_packet_ptr;
+    }
+
+    /* Determine if any packet was placed in the ring.  */
+    if (producer == first)
+    {
+
+        /* No, there is nothing for the consumer.  */
+        return(NX_FALSE);
+    }
+
+    /* Make sure the slots are written before they are published.  */
+    NX_IP_RECEIVE_RING_BARRIER
+
+    /* Publish the packets to the consumer.  */
+    ring_ptr -> nx_ip_receive_ring_producer =  producer;
+
+    /* Make sure the packets are published before the consumer index is checked.  */
+    NX_IP_RECEIVE_RING_BARRIER
+
+    /* The consumer must be woken up if it had taken all packets before these.  */
+    return((ring_ptr -> nx_ip_receive_ring_consumer == first) ? NX_TRUE : NX_FALSE);
+}
+#endif /* NX_ENABLE_IP_RECEIVE_RING */
+
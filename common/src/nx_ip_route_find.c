@@ -68,6 +68,7 @@
 /*                                                                        */
 /*    [nx_ip_find_route_process]            Search the static routing     */
 /*                                            table.                      */
+/*    _nx_ip_route_trie_lookup              Find route in routing trie    */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -88,13 +89,19 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            routing trie, resulting in  */
+/*                                            version 6.x                 */
 /*                                                                        */
 /**************************************************************************/
 ULONG  _nx_ip_route_find(NX_IP *ip_ptr, ULONG destination_address, NX_INTERFACE **nx_ip_interface, ULONG *next_hop_address)
 {
 
-NX_INTERFACE *nx_interface;
-ULONG         i;
+NX_INTERFACE        *nx_interface;
+ULONG                i;
+#ifdef NX_ENABLE_IP_ROUTE_TRIE
+NX_IP_ROUTING_ENTRY *entry_ptr;
+#endif /* NX_ENABLE_IP_ROUTE_TRIE */
 
     /* Determine whether or not destination_address is multicast or directed broadcast. */
     if (((destination_address & NX_IP_CLASS_D_MASK) == NX_IP_CLASS_D_TYPE) ||
@@ -113,7 +120,19 @@ ULONG         i;
 
 
 
-#ifdef NX_ENABLE_IP_STATIC_ROUTING
+#ifdef NX_ENABLE_IP_ROUTE_TRIE
+
+    /* Find the route to the longest network prefix that contains the destination.  */
+    entry_ptr =  _nx_ip_route_trie_lookup(ip_ptr, destination_address);
+    if (entry_ptr)
+    {
+        *nx_ip_interface = entry_ptr -> nx_ip_routing_entry_ip_interface;
+        *next_hop_address = entry_ptr -> nx_ip_routing_entry_next_hop_address;
+
+        return(NX_SUCCESS);
+    }
+
+#elif defined(NX_ENABLE_IP_STATIC_ROUTING)
 
 
     /* Search through the routing table, check whether the entry exists or not. */
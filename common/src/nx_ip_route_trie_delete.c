@@ -0,0 +1,192 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+
+
+#ifdef NX_ENABLE_IP_ROUTE_TRIE
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_route_trie_delete                            PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function removes all routes to a network prefix from the       */
+/*    static routing trie and makes their routing table entries available */
+/*    again. The node of the prefix is removed unless it still branches,  */
+/*    and a branch node left with a single child is removed as well. The  */
+/*    caller must hold the IP mutex.                                      */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                Pointer to IP instance        */
+/*    prefix                                Network prefix                */
+/*    prefix_length                         Prefix length in bits         */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                NX_TRUE if routes were        */
+/*                                            removed                     */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_ip_static_route_delete            Delete static route           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_ip_route_trie_delete(NX_IP *ip_ptr, ULONG prefix, ULONG prefix_length)
+{
+
+NX_IP_ROUTE_NODE   **link_ptr;
+NX_IP_ROUTE_NODE   **parent_link_ptr;
+NX_IP_ROUTE_NODE    *node_ptr;
+NX_IP_ROUTE_NODE    *parent_ptr;
+NX_IP_ROUTING_ENTRY *entry_ptr;
+NX_IP_ROUTING_ENTRY *next_entry_ptr;
+
+
+    /* Walk down the trie from the root to the node of the prefix.  */
+    parent_link_ptr =  NX_NULL;
+    link_ptr =         &(ip_ptr -> nx_ip_route_trie_root);
+    while ((node_ptr = *link_ptr) != NX_NULL)
+    {
+
+        /* Determine if the node prefix is part of the prefix.  */
+        if ((node_ptr -> nx_ip_route_node_length > prefix_length) ||
+            ((prefix ^ node_ptr -> nx_ip_route_node_prefix) & NX_IP_ROUTE_PREFIX_MASK(node_ptr -> nx_ip_route_node_length)))
+        {
+
+            /* No, the prefix is not in the trie.  */
+            return(NX_FALSE);
+        }
+
+        /* Determine if this is the node of the prefix.  */
+        if (node_ptr -> nx_ip_route_node_length == prefix_length)
+        {
+            break;
+        }
+
+        /* Move to the child selected by the bit after the node prefix.  */
+        parent_link_ptr =  link_ptr;
+        link_ptr =         &(node_ptr -> nx_ip_route_node_child[NX_IP_ROUTE_BIT(prefix, node_ptr -> nx_ip_route_node_length)]);
+    }
+
+    /* Determine if routes to the prefix exist.  */
+    if ((node_ptr == NX_NULL) || (node_ptr -> nx_ip_route_node_routes == NX_NULL))
+    {
+        return(NX_FALSE);
+    }
+
+    /* Make the routing table entries of the prefix available.  */
+    entry_ptr =  node_ptr -> nx_ip_route_node_routes;
+    while (entry_ptr)
+    {
+
+        /* Pickup the next route.  */
+        next_entry_ptr =  entry_ptr -> nx_ip_routing_entry_next;
+
+        /* Clear the entry and place it on the available list.  */
+        entry_ptr -> nx_ip_routing_entry_destination_ip =    0;
+        entry_ptr -> nx_ip_routing_entry_net_mask =          0;
+        entry_ptr -> nx_ip_routing_entry_next_hop_address =  0;
+        entry_ptr -> nx_ip_routing_entry_ip_interface =      NX_NULL;
+        entry_ptr -> nx_ip_routing_entry_next =              ip_ptr -> nx_ip_routing_entry_available;
+        ip_ptr -> nx_ip_routing_entry_available =            entry_ptr;
+        ip_ptr -> nx_ip_routing_table_entry_count--;
+
+        /* Move to the next route.  */
+        entry_ptr =  next_entry_ptr;
+    }
+    node_ptr -> nx_ip_route_node_routes =  NX_NULL;
+
+    /* Determine if the node still branches.  */
+    if ((node_ptr -> nx_ip_route_node_child[0]) && (node_ptr -> nx_ip_route_node_child[1]))
+    {
+        return(NX_TRUE);
+    }
+
+    /* Replace the node with its only child, if any.  */
+    if (node_ptr -> nx_ip_route_node_child[0])
+    {
+        *link_ptr =  node_ptr -> nx_ip_route_node_child[0];
+    }
+    else
+    {
+        *link_ptr =  node_ptr -> nx_ip_route_node_child[1];
+    }
+
+    /* Place the node on the available list.  */
+    node_ptr -> nx_ip_route_node_child[0] =  ip_ptr -> nx_ip_route_node_available;
+    ip_ptr -> nx_ip_route_node_available =   node_ptr;
+
+    /* Determine if the parent is a branch node that is left with a single child.  */
+    if ((parent_link_ptr) && (*link_ptr == NX_NULL))
+    {
+
+        /* Pickup the parent.  */
+        parent_ptr =  *parent_link_ptr;
+        if (parent_ptr -> nx_ip_route_node_routes == NX_NULL)
+        {
+
+            /* Replace the parent with its other child.  */
+            if (parent_ptr -> nx_ip_route_node_child[0])
+            {
+                *parent_link_ptr =  parent_ptr -> nx_ip_route_node_child[0];
+            }
+            else
+            {
+                *parent_link_ptr =  parent_ptr -> nx_ip_route_node_child[1];
+            }
+
+            /* Place the parent on the available list.  */
+            parent_ptr -> nx_ip_route_node_child[0] =  ip_ptr -> nx_ip_route_node_available;
+            ip_ptr -> nx_ip_route_node_available =     parent_ptr;
+        }
+    }
+
+    /* Return success.  */
+    return(NX_TRUE);
+}
+#endif /* NX_ENABLE_IP_ROUTE_TRIE */
+
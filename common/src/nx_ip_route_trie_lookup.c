@@ -0,0 +1,160 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+
+
+#ifdef NX_ENABLE_IP_ROUTE_TRIE
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_route_trie_lookup                            PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function finds the static route to a destination address: the  */
+/*    route with the lowest metric to the longest network prefix that     */
+/*    contains the address. Recent destinations are kept in a small       */
+/*    cache, whose entries are valid until a route changes.               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                Pointer to IP instance        */
+/*    destination_address                   Destination IP address        */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    entry_ptr                             Route to the destination, or  */
+/*                                            NX_NULL if none             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_ip_route_find                     Find suitable outgoing        */
+/*                                            interface                   */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+NX_IP_ROUTING_ENTRY  *_nx_ip_route_trie_lookup(NX_IP *ip_ptr, ULONG destination_address)
+{
+TX_INTERRUPT_SAVE_AREA
+
+NX_IP_ROUTE_CACHE_ENTRY *cache_ptr;
+NX_IP_ROUTE_NODE        *node_ptr;
+NX_IP_ROUTING_ENTRY     *entry_ptr;
+ULONG                    generation;
+
+
+    /* Pickup the cache entry of the destination.  */
+    cache_ptr =  &(ip_ptr -> nx_ip_route_cache[NX_IP_ROUTE_CACHE_INDEX(destination_address)]);
+
+    /* Disable interrupts, the cache entry is shared by all callers.  */
+    TX_DISABLE
+
+    /* Pickup the routing table generation.  */
+    generation =  ip_ptr -> nx_ip_route_cache_generation;
+
+    /* Determine if the destination is cached.  */
+    if ((cache_ptr -> nx_ip_route_cache_destination == destination_address) &&
+        (cache_ptr -> nx_ip_route_cache_generation == generation))
+    {
+
+        /* Yes, pickup its route.  */
+        entry_ptr =  cache_ptr -> nx_ip_route_cache_route;
+
+        /* Restore interrupts.  */
+        TX_RESTORE
+
+        /* Return the route.  */
+        return(entry_ptr);
+    }
+
+    /* Restore interrupts.  */
+    TX_RESTORE
+
+    /* Walk down the trie, remembering the routes of the longest prefix found.  */
+    entry_ptr =  NX_NULL;
+    node_ptr =   ip_ptr -> nx_ip_route_trie_root;
+    while (node_ptr)
+    {
+
+        /* Determine if the node prefix contains the destination.  */
+        if ((destination_address ^ node_ptr -> nx_ip_route_node_prefix) & NX_IP_ROUTE_PREFIX_MASK(node_ptr -> nx_ip_route_node_length))
+        {
+
+            /* No, no longer prefix contains it either.  */
+            break;
+        }
+
+        /* Remember the routes of this prefix, if any.  */
+        if (node_ptr -> nx_ip_route_node_routes)
+        {
+            entry_ptr =  node_ptr -> nx_ip_route_node_routes;
+        }
+
+        /* Determine if this is a host route.  */
+        if (node_ptr -> nx_ip_route_node_length == 32)
+        {
+            break;
+        }
+
+        /* Move to the child selected by the bit after the node prefix.  */
+        node_ptr =  node_ptr -> nx_ip_route_node_child[NX_IP_ROUTE_BIT(destination_address, node_ptr -> nx_ip_route_node_length)];
+    }
+
+    /* Disable interrupts.  */
+    TX_DISABLE
+
+    /* Cache the route.  It is only used if no route changed since the generation was
+       picked up.  */
+    cache_ptr -> nx_ip_route_cache_destination =  destination_address;
+    cache_ptr -> nx_ip_route_cache_generation =   generation;
+    cache_ptr -> nx_ip_route_cache_route =        entry_ptr;
+
+    /* Restore interrupts.  */
+    TX_RESTORE
+
+    /* Return the route.  */
+    return(entry_ptr);
+}
+#endif /* NX_ENABLE_IP_ROUTE_TRIE */
+
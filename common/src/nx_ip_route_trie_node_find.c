@@ -0,0 +1,202 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+
+
+#ifdef NX_ENABLE_IP_ROUTE_TRIE
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_route_trie_node_find                         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function finds the node of a network prefix in the static      */
+/*    routing trie and, if requested, creates it when it does not exist.  */
+/*    A new prefix either becomes a leaf, is placed above a node whose    */
+/*    prefix it covers, or is placed next to such a node under a new      */
+/*    branch node at the first bit in which they differ. The caller must  */
+/*    hold the IP mutex.                                                  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                Pointer to IP instance        */
+/*    prefix                                Network prefix                */
+/*    prefix_length                         Prefix length in bits         */
+/*    create                                NX_TRUE to create the node    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    node_ptr                              Node of the prefix, or        */
+/*                                            NX_NULL                     */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_ip_static_route_metric_add        Add static route with metric  */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+NX_IP_ROUTE_NODE  *_nx_ip_route_trie_node_find(NX_IP *ip_ptr, ULONG prefix, ULONG prefix_length, UINT create)
+{
+
+NX_IP_ROUTE_NODE **link_ptr;
+NX_IP_ROUTE_NODE  *node_ptr;
+NX_IP_ROUTE_NODE  *new_node_ptr;
+NX_IP_ROUTE_NODE  *branch_ptr;
+ULONG              difference;
+ULONG              common_length;
+
+
+    /* Walk down the trie from the root.  */
+    link_ptr =  &(ip_ptr -> nx_ip_route_trie_root);
+    while ((node_ptr = *link_ptr) != NX_NULL)
+    {
+
+        /* Compute the length of the prefix shared by the node and the new prefix.  */
+        common_length =  0;
+        difference =     node_ptr -> nx_ip_route_node_prefix ^ prefix;
+        while ((common_length < 32) && !(difference & 0x80000000))
+        {
+            difference =  difference << 1;
+            common_length++;
+        }
+        if (common_length > node_ptr -> nx_ip_route_node_length)
+        {
+            common_length =  node_ptr -> nx_ip_route_node_length;
+        }
+        if (common_length > prefix_length)
+        {
+            common_length =  prefix_length;
+        }
+
+        /* Determine if the node prefix is part of the new prefix.  */
+        if (common_length < node_ptr -> nx_ip_route_node_length)
+        {
+
+            /* No, the new prefix goes above this node.  */
+            break;
+        }
+
+        /* Determine if the node holds the new prefix itself.  */
+        if (node_ptr -> nx_ip_route_node_length == prefix_length)
+        {
+
+            /* Yes, return the node.  */
+            return(node_ptr);
+        }
+
+        /* Move to the child selected by the bit after the node prefix.  */
+        link_ptr =  &(node_ptr -> nx_ip_route_node_child[NX_IP_ROUTE_BIT(prefix, node_ptr -> nx_ip_route_node_length)]);
+    }
+
+    /* Determine if the node should be created.  */
+    if (!create)
+    {
+
+        /* No, the prefix is not in the trie.  */
+        return(NX_NULL);
+    }
+
+    /* Pickup an available node for the new prefix.  */
+    new_node_ptr =  ip_ptr -> nx_ip_route_node_available;
+    if (new_node_ptr == NX_NULL)
+    {
+        return(NX_NULL);
+    }
+    ip_ptr -> nx_ip_route_node_available =  new_node_ptr -> nx_ip_route_node_child[0];
+
+    /* Setup the new node.  */
+    new_node_ptr -> nx_ip_route_node_prefix =    prefix;
+    new_node_ptr -> nx_ip_route_node_length =    prefix_length;
+    new_node_ptr -> nx_ip_route_node_routes =    NX_NULL;
+    new_node_ptr -> nx_ip_route_node_child[0] =  NX_NULL;
+    new_node_ptr -> nx_ip_route_node_child[1] =  NX_NULL;
+
+    /* Determine if the new prefix is a leaf.  */
+    if (node_ptr == NX_NULL)
+    {
+
+        /* Yes, link it in place.  */
+        *link_ptr =  new_node_ptr;
+    }
+
+    /* Determine if the new prefix covers the node.  */
+    else if (common_length == prefix_length)
+    {
+
+        /* Yes, place the node under the new prefix.  */
+        new_node_ptr -> nx_ip_route_node_child[NX_IP_ROUTE_BIT(node_ptr -> nx_ip_route_node_prefix, prefix_length)] =  node_ptr;
+        *link_ptr =  new_node_ptr;
+    }
+    else
+    {
+
+        /* The prefixes differ after the common part, pickup an available node to branch.  */
+        branch_ptr =  ip_ptr -> nx_ip_route_node_available;
+        if (branch_ptr == NX_NULL)
+        {
+
+            /* Give the new node back.  */
+            new_node_ptr -> nx_ip_route_node_child[0] =  ip_ptr -> nx_ip_route_node_available;
+            ip_ptr -> nx_ip_route_node_available =        new_node_ptr;
+            return(NX_NULL);
+        }
+        ip_ptr -> nx_ip_route_node_available =  branch_ptr -> nx_ip_route_node_child[0];
+
+        /* Setup the branch node on the common part of the prefixes.  */
+        branch_ptr -> nx_ip_route_node_prefix =  prefix & NX_IP_ROUTE_PREFIX_MASK(common_length);
+        branch_ptr -> nx_ip_route_node_length =  common_length;
+        branch_ptr -> nx_ip_route_node_routes =  NX_NULL;
+
+        /* Place the new node and the node under the branch, by their first different bit.  */
+        branch_ptr -> nx_ip_route_node_child[NX_IP_ROUTE_BIT(prefix, common_length)] =      new_node_ptr;
+        branch_ptr -> nx_ip_route_node_child[!NX_IP_ROUTE_BIT(prefix, common_length)] =     node_ptr;
+        *link_ptr =  branch_ptr;
+    }
+
+    /* Return the new node.  */
+    return(new_node_ptr);
+}
+#endif /* NX_ENABLE_IP_ROUTE_TRIE */
+
@@ -64,6 +64,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _nx_ip_static_route_metric_add        Add static route with metric  */
 /*    tx_mutex_get                                                        */
 /*    tx_mutex_put                                                        */
 /*                                                                        */
@@ -82,13 +83,22 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            routing trie, resulting in  */
+/*                                            version 6.x                 */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_ip_static_route_add(NX_IP *ip_ptr, ULONG network_address,
                               ULONG net_mask, ULONG next_hop)
 {
 
-#ifdef NX_ENABLE_IP_STATIC_ROUTING
+#ifdef NX_ENABLE_IP_ROUTE_TRIE
+
+    /* Add the route with the lowest metric.  This replaces the next hop of a route added
+       to the same network before.  */
+    return(_nx_ip_static_route_metric_add(ip_ptr, network_address, net_mask, next_hop, 0));
+
+#elif defined(NX_ENABLE_IP_STATIC_ROUTING)
 
 ULONG         i;
 NX_INTERFACE *nx_ip_interface = NX_NULL;
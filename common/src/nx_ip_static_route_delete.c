@@ -62,6 +62,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _nx_ip_route_trie_delete              Delete routing trie prefix    */
 /*    tx_mutex_get                                                        */
 /*    tx_mutex_put                                                        */
 /*                                                                        */
@@ -80,6 +81,9 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            routing trie, resulting in  */
+/*                                            version 6.x                 */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_ip_static_route_delete(NX_IP *ip_ptr, ULONG network_address, ULONG net_mask)
@@ -88,13 +92,33 @@ UINT  _nx_ip_static_route_delete(NX_IP *ip_ptr, ULONG network_address, ULONG net
 
 #ifdef NX_ENABLE_IP_STATIC_ROUTING
 
+#ifdef NX_ENABLE_IP_ROUTE_TRIE
+ULONG prefix_length;
+#else
 ULONG i;
 UINT  found_match    = NX_FALSE;
+#endif /* NX_ENABLE_IP_ROUTE_TRIE */
 UINT  status         = NX_NOT_SUCCESSFUL;
 
 
     network_address = network_address & net_mask;
 
+#ifdef NX_ENABLE_IP_ROUTE_TRIE
+
+    /* Compute the prefix length of the net mask.  */
+    prefix_length =  0;
+    while ((prefix_length < 32) && (net_mask & (((ULONG)0x80000000) >> prefix_length)))
+    {
+        prefix_length++;
+    }
+
+    /* Make sure the net mask is contiguous, the trie only holds prefixes.  */
+    if (net_mask != NX_IP_ROUTE_PREFIX_MASK(prefix_length))
+    {
+        return(NX_NOT_SUCCESSFUL);
+    }
+#endif /* NX_ENABLE_IP_ROUTE_TRIE */
+
     /* Obtain the IP mutex so we can manipulate the internal routing table. */
     /* This routine does not need to be protected by mask off interrupt
        because it cannot be invoked from ISR. */
@@ -111,6 +135,20 @@ UINT  status         = NX_NOT_SUCCESSFUL;
         return NX_SUCCESS;
     }
 
+#ifdef NX_ENABLE_IP_ROUTE_TRIE
+
+    /* Remove all routes to the network from the routing trie.  */
+    if (_nx_ip_route_trie_delete(ip_ptr, network_address, prefix_length))
+    {
+
+        /* Invalidate the cached routes.  */
+        ip_ptr -> nx_ip_route_cache_generation++;
+
+        /* Indicate successful deletion. */
+        status = NX_SUCCESS;
+    }
+#else
+
     /* Search through the routing table, check whether the same entry exists. */
     for (i = 0; i < ip_ptr -> nx_ip_routing_table_entry_count; i++)
     {
@@ -151,6 +189,7 @@ UINT  status         = NX_NOT_SUCCESSFUL;
         /* Indicate successful deletion. */
         status = NX_SUCCESS;
     }
+#endif /* NX_ENABLE_IP_ROUTE_TRIE */
 
     tx_mutex_put(&(ip_ptr -> nx_ip_protection));
 
@@ -0,0 +1,244 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Internet Protocol (IP)                                              */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ip_static_route_metric_add                      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function adds a static route with a metric to the routing      */
+/*    table. Several routes to the same network may exist with different  */
+/*    metrics, and the route with the lowest metric is used. A route with */
+/*    the same network, net mask and metric as an existing one replaces   */
+/*    its next hop.                                                       */
+/*                                                                        */
+/*    Routes are kept in a prefix trie, so the net mask must be           */
+/*    contiguous. If the routing trie is not enabled, an error status is  */
+/*    returned.                                                           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                Pointer to IP instance        */
+/*    network_address                       Network address, in host byte */
+/*                                            order.                      */
+/*    net_mask                              Network Mask, in host byte    */
+/*                                            order.                      */
+/*    next_hop                              Next Hop address, in host     */
+/*                                            byte order.                 */
+/*    metric                                Metric of the route           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*    NX_IP_ADDRESS_ERROR                   Invalid address input         */
+/*    NX_OVERFLOW                           Static routing table full     */
+/*    NX_NOT_SUPPORTED                      Routing trie not enabled      */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_ip_route_trie_node_find           Find routing trie node        */
+/*    tx_mutex_get                          Get protection mutex          */
+/*    tx_mutex_put                          Put protection mutex          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*    _nx_ip_static_route_add               Add static route              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_ip_static_route_metric_add(NX_IP *ip_ptr, ULONG network_address,
+                                     ULONG net_mask, ULONG next_hop, ULONG metric)
+{
+
+#ifdef NX_ENABLE_IP_ROUTE_TRIE
+
+ULONG                 i;
+ULONG                 prefix_length;
+NX_INTERFACE         *nx_ip_interface = NX_NULL;
+NX_IP_ROUTE_NODE     *node_ptr;
+NX_IP_ROUTING_ENTRY **link_ptr;
+NX_IP_ROUTING_ENTRY  *entry_ptr;
+
+
+    /* Make sure the net mask is contiguous, the trie only holds prefixes.  */
+    if ((~net_mask) & ((~net_mask) + 1))
+    {
+        return(NX_IP_ADDRESS_ERROR);
+    }
+
+    /* Compute the prefix length of the net mask.  */
+    prefix_length =  0;
+    while ((prefix_length < 32) && (net_mask & (((ULONG)0x80000000) >> prefix_length)))
+    {
+        prefix_length++;
+    }
+
+    /* Obtain the IP mutex so we can manipulate the internal routing table. */
+    tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
+
+    /* Make sure next hop is on one of the interfaces. */
+    for (i = 0; i < NX_MAX_IP_INTERFACES; i++)
+    {
+
+        if (ip_ptr -> nx_ip_interface[i].nx_interface_valid &&
+            ((next_hop & (ip_ptr -> nx_ip_interface[i].nx_interface_ip_network_mask)) == ip_ptr -> nx_ip_interface[i].nx_interface_ip_network))
+        {
+
+            nx_ip_interface = &(ip_ptr -> nx_ip_interface[i]);
+
+            /* Break out of the for loop */
+            break;
+        }
+    }
+
+    /* If no matching interface, return the error status. */
+    if (nx_ip_interface == NX_NULL)
+    {
+
+        /* Unlock the mutex, and return the error status. */
+        tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+        return(NX_IP_ADDRESS_ERROR);
+    }
+
+    /* Obtain the network address, based on the specified netmask. */
+    network_address = network_address & net_mask;
+
+    /* If trace is enabled, insert this event into the trace buffer.  */
+    NX_TRACE_IN_LINE_INSERT(NX_TRACE_IP_STATIC_ROUTE_ADD, ip_ptr, network_address, net_mask, next_hop, NX_TRACE_IP_EVENTS, 0, 0);
+
+    /* Determine if the routing table is empty.  */
+    if (ip_ptr -> nx_ip_routing_table_entry_count == 0)
+    {
+
+        /* Yes, place all routing table entries and trie nodes on the available lists.  */
+        ip_ptr -> nx_ip_route_trie_root =          NX_NULL;
+        ip_ptr -> nx_ip_routing_entry_available =  NX_NULL;
+        ip_ptr -> nx_ip_route_node_available =     NX_NULL;
+        for (i = 0; i < NX_IP_ROUTING_TABLE_SIZE; i++)
+        {
+            ip_ptr -> nx_ip_routing_table[i].nx_ip_routing_entry_next =  ip_ptr -> nx_ip_routing_entry_available;
+            ip_ptr -> nx_ip_routing_entry_available =                    &(ip_ptr -> nx_ip_routing_table[i]);
+        }
+        for (i = 0; i < (2 * NX_IP_ROUTING_TABLE_SIZE); i++)
+        {
+            ip_ptr -> nx_ip_route_nodes[i].nx_ip_route_node_child[0] =  ip_ptr -> nx_ip_route_node_available;
+            ip_ptr -> nx_ip_route_node_available =                      &(ip_ptr -> nx_ip_route_nodes[i]);
+        }
+    }
+
+    /* Find the trie node of the network.  It is only created if a new route can be added,
+       a network in the trie always has routes unless it branches.  Each network needs at
+       most two nodes, so nodes do not run out before routing table entries.  */
+    node_ptr =  _nx_ip_route_trie_node_find(ip_ptr, network_address, prefix_length,
+                                            (ip_ptr -> nx_ip_routing_entry_available != NX_NULL));
+
+    /* Find the place of the metric in the routes to the network.  */
+    link_ptr =  NX_NULL;
+    if (node_ptr)
+    {
+        link_ptr =  &(node_ptr -> nx_ip_route_node_routes);
+        while ((*link_ptr) && ((*link_ptr) -> nx_ip_routing_entry_metric < metric))
+        {
+            link_ptr =  &((*link_ptr) -> nx_ip_routing_entry_next);
+        }
+    }
+
+    /* Determine if a route with the same metric exists.  */
+    if ((link_ptr) && (*link_ptr) && ((*link_ptr) -> nx_ip_routing_entry_metric == metric))
+    {
+
+        /* Yes, only the next hop and the interface need to be updated.  */
+        entry_ptr =  *link_ptr;
+    }
+    else
+    {
+
+        /* Determine if the route can be added.  */
+        if ((link_ptr == NX_NULL) || (ip_ptr -> nx_ip_routing_entry_available == NX_NULL))
+        {
+
+            /* No, the table is full.  */
+            tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+            return(NX_OVERFLOW);
+        }
+
+        /* Pickup an available routing table entry.  */
+        entry_ptr =  ip_ptr -> nx_ip_routing_entry_available;
+        ip_ptr -> nx_ip_routing_entry_available =  entry_ptr -> nx_ip_routing_entry_next;
+
+        /* Setup the route and link it in metric order.  */
+        entry_ptr -> nx_ip_routing_entry_destination_ip =  network_address;
+        entry_ptr -> nx_ip_routing_entry_net_mask =        net_mask;
+        entry_ptr -> nx_ip_routing_entry_metric =          metric;
+        entry_ptr -> nx_ip_routing_entry_next =            *link_ptr;
+        *link_ptr =  entry_ptr;
+
+        ip_ptr -> nx_ip_routing_table_entry_count++;
+    }
+
+    /* Setup the next hop and the interface.  */
+    entry_ptr -> nx_ip_routing_entry_next_hop_address =  next_hop;
+    entry_ptr -> nx_ip_routing_entry_ip_interface =      nx_ip_interface;
+
+    /* Invalidate the cached routes.  */
+    ip_ptr -> nx_ip_route_cache_generation++;
+
+    /* Unlock the mutex. */
+    tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+    /* Return success to the caller.  */
+    return(NX_SUCCESS);
+
+#else /*  !NX_ENABLE_IP_ROUTE_TRIE */
+    NX_PARAMETER_NOT_USED(ip_ptr);
+    NX_PARAMETER_NOT_USED(network_address);
+    NX_PARAMETER_NOT_USED(net_mask);
+    NX_PARAMETER_NOT_USED(next_hop);
+    NX_PARAMETER_NOT_USED(metric);
+
+    return(NX_NOT_SUPPORTED);
+#endif /* NX_ENABLE_IP_ROUTE_TRIE */
+}
@@ -64,6 +64,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _nx_ip_receive_ring_get               Take packets from ring        */
 /*    tx_event_flags_get                    Suspend on event flags that   */
 /*                                            are used to signal this     */
 /*                                            thread what to do           */
@@ -74,6 +75,7 @@
 /*    _nx_ip_packet_receive                 IP receive packet processing  */
 /*    (nx_arp_queue_process)                ARP receive queue processing  */
 /*    (nx_ip_arp_periodic_update)           ARP periodic update processing*/
+/*    (nx_ip_arp_retransmit_process)        ARP retransmit processing     */
 /*    (nx_ip_rarp_periodic_update)          RARP periodic processing      */
 /*    (nx_ip_fragment_assembly)             IP fragment processing        */
 /*    (nx_ip_fragment_timeout_check)        Fragment timeout checking     */
@@ -96,6 +98,16 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            queried the interface       */
+/*                                            capabilities from the link  */
+/*                                            driver, processed the       */
+/*                                            deferred receive queue in   */
+/*                                            batches, added receive      */
+/*                                            rings, added ARP retransmit */
+/*                                            event, supported TCP        */
+/*                                            receive coalescing,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_ip_thread_entry(ULONG ip_ptr_value)
@@ -107,8 +119,12 @@ NX_IP_DRIVER driver_request;
 NX_IP       *ip_ptr;
 ULONG        ip_events;
 NX_PACKET   *packet_ptr;
+NX_PACKET   *next_packet_ptr;
 UINT         i;
 ULONG        foo;
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+ULONG        capability_flag;
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
 
 
     /* Setup IP pointer from the input value.  */
@@ -154,6 +170,28 @@ ULONG        foo;
              */
             (ip_ptr -> nx_ip_interface[i].nx_interface_link_driver_entry) (&driver_request);
 
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+
+            /* Ask the link driver which checksum and segmentation work its hardware can take over.
+               Drivers that do not know the command leave the interface without offload.  */
+            capability_flag =                         0;
+            driver_request.nx_ip_driver_ptr =         ip_ptr;
+            driver_request.nx_ip_driver_command =     NX_LINK_GET_CAPABILITY;
+            driver_request.nx_ip_driver_return_ptr =  &capability_flag;
+            driver_request.nx_ip_driver_status =      NX_UNHANDLED_COMMAND;
+            (ip_ptr -> nx_ip_interface[i].nx_interface_link_driver_entry) (&driver_request);
+
+            /* Record the capabilities if the driver handled the command.  */
+            if (driver_request.nx_ip_driver_status == NX_SUCCESS)
+            {
+                ip_ptr -> nx_ip_interface[i].nx_interface_capability_flag =  capability_flag;
+            }
+            else
+            {
+                ip_ptr -> nx_ip_interface[i].nx_interface_capability_flag =  0;
+            }
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
             /* Call the link driver again to enable the interface.  */
             driver_request.nx_ip_driver_ptr =      ip_ptr;
             driver_request.nx_ip_driver_command =  NX_LINK_ENABLE;
@@ -183,6 +221,34 @@ ULONG        foo;
         if (ip_events & NX_IP_DRIVER_PACKET_EVENT)
         {
 
+#ifdef NX_ENABLE_TCP_GRO
+
+            /* Queue the TCP segments of the burst so that they can be coalesced.  */
+            ip_ptr -> nx_ip_tcp_gro_batch =  NX_TRUE;
+#endif /* NX_ENABLE_TCP_GRO */
+
+#ifdef NX_ENABLE_IP_RECEIVE_RING
+            /* Loop to take all packets out of the driver deferred ring.  */
+            while ((next_packet_ptr = _nx_ip_receive_ring_get(&(ip_ptr -> nx_ip_driver_deferred_ring))) != NX_NULL)
+            {
+
+                /* Loop through the packets taken from the ring.  */
+                while (next_packet_ptr)
+                {
+
+                    /* Pickup the packet and the next packet before the packet is processed.  */
+                    packet_ptr =       next_packet_ptr;
+                    next_packet_ptr =  packet_ptr -> nx_packet_queue_next;
+
+                    /* make sure that there is a deferred processing function */
+                    if (ip_ptr ->  nx_ip_driver_deferred_packet_handler)
+                    {
+                        /* Call the actual Deferred packet processing function.  */
+                        (ip_ptr ->  nx_ip_driver_deferred_packet_handler)(ip_ptr, packet_ptr);
+                    }
+                }
+            }
+#else
             /* Loop to process all deferred packet requests.  */
             while (ip_ptr -> nx_ip_driver_deferred_packet_head)
             {
@@ -215,6 +281,17 @@ ULONG        foo;
                     (ip_ptr ->  nx_ip_driver_deferred_packet_handler)(ip_ptr, packet_ptr);
                 }
             }
+#endif /* NX_ENABLE_IP_RECEIVE_RING */
+
+#ifdef NX_ENABLE_TCP_GRO
+
+            /* Process the TCP segments queued during the burst.  */
+            ip_ptr -> nx_ip_tcp_gro_batch =  NX_FALSE;
+            if (ip_ptr -> nx_ip_tcp_queue_head)
+            {
+                ip_events |=  NX_IP_TCP_EVENT;
+            }
+#endif /* NX_ENABLE_TCP_GRO */
 
             /* Determine if there is anything else to do in the loop.  */
             ip_events =  ip_events & ~(NX_IP_DRIVER_PACKET_EVENT);
@@ -229,11 +306,38 @@ ULONG        foo;
         if (ip_events & NX_IP_RECEIVE_EVENT)
         {
 
+#ifdef NX_ENABLE_TCP_GRO
+
+            /* Queue the TCP segments of the burst so that they can be coalesced.  */
+            ip_ptr -> nx_ip_tcp_gro_batch =  NX_TRUE;
+#endif /* NX_ENABLE_TCP_GRO */
+
+#ifdef NX_ENABLE_IP_RECEIVE_RING
+            /* Loop to take all packets the driver placed in the deferred receive ring.  */
+            while ((packet_ptr = _nx_ip_receive_ring_get(&(ip_ptr -> nx_ip_deferred_receive_ring))) != NX_NULL)
+            {
+
+                /* Loop through the packets taken from the ring.  */
+                while (packet_ptr)
+                {
+
+                    /* Pickup the next packet before the packet is processed.  */
+                    next_packet_ptr =  packet_ptr -> nx_packet_queue_next;
+
+                    /* Call the actual IP packet receive function.  */
+                    _nx_ip_packet_receive(ip_ptr, packet_ptr);
+
+                    /* Move to the next packet.  */
+                    packet_ptr =  next_packet_ptr;
+                }
+            }
+#endif /* NX_ENABLE_IP_RECEIVE_RING */
+
             /* Loop to process all deferred packet requests.  */
             while (ip_ptr -> nx_ip_deferred_received_packet_head)
             {
 
-                /* Remove the first packet and process it!  */
+                /* Remove the whole deferred queue and process it as a batch.  */
 
                 /* Disable interrupts.  */
                 TX_DISABLE
@@ -241,23 +345,37 @@ ULONG        foo;
                 /* Pickup the first packet.  */
                 packet_ptr =  ip_ptr -> nx_ip_deferred_received_packet_head;
 
-                /* Move the head pointer to the next packet.  */
-                ip_ptr -> nx_ip_deferred_received_packet_head =  packet_ptr -> nx_packet_queue_next;
+                /* The queue is now empty.  */
+                ip_ptr -> nx_ip_deferred_received_packet_head =  NX_NULL;
+                ip_ptr -> nx_ip_deferred_received_packet_tail =  NX_NULL;
 
-                /* Check for end of deferred processing queue.  */
-                if (ip_ptr -> nx_ip_deferred_received_packet_head == NX_NULL)
+                /* Restore interrupts.  */
+                TX_RESTORE
+
+                /* Loop through the packets of the batch.  */
+                while (packet_ptr)
                 {
 
-                    /* Yes, the queue is empty.  Set the tail pointer to NULL.  */
-                    ip_ptr -> nx_ip_deferred_received_packet_tail =  NX_NULL;
+                    /* Pickup the next packet before the packet is processed.  */
+                    next_packet_ptr =  packet_ptr -> nx_packet_queue_next;
+
+                    /* Call the actual IP packet receive function.  */
+                    _nx_ip_packet_receive(ip_ptr, packet_ptr);
+
+                    /* Move to the next packet.  */
+                    packet_ptr =  next_packet_ptr;
                 }
+            }
 
-                /* Restore interrupts.  */
-                TX_RESTORE
+#ifdef NX_ENABLE_TCP_GRO
 
-                /* Call the actual IP packet receive function.  */
-                _nx_ip_packet_receive(ip_ptr, packet_ptr);
+            /* Process the TCP segments queued during the burst.  */
+            ip_ptr -> nx_ip_tcp_gro_batch =  NX_FALSE;
+            if (ip_ptr -> nx_ip_tcp_queue_head)
+            {
+                ip_events |=  NX_IP_TCP_EVENT;
             }
+#endif /* NX_ENABLE_TCP_GRO */
 
             /* Determine if there is anything else to do in the loop.  */
             ip_events =  ip_events & ~(NX_IP_RECEIVE_EVENT);
@@ -298,6 +416,24 @@ ULONG        foo;
             }
         }
 
+#ifdef NX_ENABLE_ARP_PENDING_QUEUE
+        /* Check for an ARP retransmit event.  */
+        if ((ip_events & NX_IP_ARP_RETRANSMIT_EVENT) && (ip_ptr -> nx_ip_arp_retransmit_process))
+        {
+
+            /* Retransmit the ARP requests that are due.  */
+            (ip_ptr -> nx_ip_arp_retransmit_process)(ip_ptr);
+
+            /* Determine if there is anything else to do in the loop.  */
+            ip_events =  ip_events & ~(NX_IP_ARP_RETRANSMIT_EVENT);
+
+            if (!ip_events)
+            {
+                continue;
+            }
+        }
+#endif /* NX_ENABLE_ARP_PENDING_QUEUE */
+
         /* Check for a periodic events.  */
         if (ip_events & NX_IP_PERIODIC_EVENT)
         {
@@ -59,6 +59,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _nx_packet_pool_cache_get             Find packet cache             */
 /*    _tx_thread_system_suspend             Suspend thread                */
 /*                                                                        */
 /*  CALLED BY                                                             */
@@ -72,6 +73,11 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            cleared the interface       */
+/*                                            capability fields, added    */
+/*                                            per-thread packet cache,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_packet_allocate(NX_PACKET_POOL *pool_ptr,  NX_PACKET **packet_ptr,
@@ -82,6 +88,11 @@ TX_INTERRUPT_SAVE_AREA
 UINT       status;                      /* Return status           */
 TX_THREAD *thread_ptr;                  /* Working thread pointer  */
 NX_PACKET *work_ptr;                    /* Working packet pointer  */
+#ifdef NX_ENABLE_PACKET_POOL_CACHE
+NX_PACKET_POOL_CACHE *cache_ptr;        /* Thread packet cache     */
+NX_PACKET            *tail_ptr;         /* Last packet of a batch  */
+ULONG                 count;            /* Packets in a batch      */
+#endif /* NX_ENABLE_PACKET_POOL_CACHE */
 
 #ifdef TX_ENABLE_EVENT_TRACE
 TX_TRACE_BUFFER_ENTRY *trace_event;
@@ -102,6 +113,100 @@ ULONG                  trace_timestamp;
     /* If trace is enabled, insert this event into the trace buffer.  */
     NX_TRACE_IN_LINE_INSERT(NX_TRACE_PACKET_ALLOCATE, pool_ptr, 0, packet_type, pool_ptr -> nx_packet_pool_available, NX_TRACE_PACKET_EVENTS, &trace_event, &trace_timestamp)
 
+#ifdef NX_ENABLE_PACKET_POOL_CACHE
+
+    /* Pickup the packet cache of this thread.  */
+    cache_ptr =  _nx_packet_pool_cache_get(pool_ptr);
+    if (cache_ptr)
+    {
+
+        /* Determine if the cache is empty.  */
+        if (cache_ptr -> nx_packet_pool_cache_count == 0)
+        {
+
+#ifndef NX_DISABLE_PACKET_INFO
+            /* Increment the cache miss count.  */
+            cache_ptr -> nx_packet_pool_cache_misses++;
+#endif
+
+            /* Disable interrupts to refill the cache from the available list.  */
+            TX_DISABLE
+
+            /* Find the end of a batch at the front of the available list.  */
+            work_ptr =  pool_ptr -> nx_packet_pool_available_list;
+            tail_ptr =  NX_NULL;
+            count =     0;
+            while ((count < NX_PACKET_POOL_CACHE_BATCH) && (count < pool_ptr -> nx_packet_pool_available))
+            {
+                tail_ptr =  work_ptr;
+                work_ptr =  work_ptr -> nx_packet_next;
+                count++;
+            }
+
+            /* Determine if any packets are available.  */
+            if (count)
+            {
+
+                /* Yes, move the batch to the cache.  */
+                cache_ptr -> nx_packet_pool_cache_list =   pool_ptr -> nx_packet_pool_available_list;
+                cache_ptr -> nx_packet_pool_cache_count =  count;
+                tail_ptr -> nx_packet_next =  NX_NULL;
+                pool_ptr -> nx_packet_pool_available_list =  work_ptr;
+                pool_ptr -> nx_packet_pool_available -=  count;
+            }
+
+            /* Restore interrupts.  */
+            TX_RESTORE
+        }
+#ifndef NX_DISABLE_PACKET_INFO
+        else
+        {
+
+            /* Increment the cache hit count.  */
+            cache_ptr -> nx_packet_pool_cache_hits++;
+        }
+#endif
+
+        /* Determine if the cache has a packet.  */
+        if (cache_ptr -> nx_packet_pool_cache_count)
+        {
+
+            /* Yes, take the first packet of the cache.  Only this thread accesses
+               the list of its cache, so no protection is needed.  */
+            work_ptr =  cache_ptr -> nx_packet_pool_cache_list;
+            cache_ptr -> nx_packet_pool_cache_list =  work_ptr -> nx_packet_next;
+            cache_ptr -> nx_packet_pool_cache_count--;
+
+            /* Setup various fields for this packet.  */
+            work_ptr -> nx_packet_next             =  NX_NULL;
+            work_ptr -> nx_packet_queue_next       =  NX_NULL;
+            work_ptr -> nx_packet_last             =  NX_NULL;
+            work_ptr -> nx_packet_length           =  0;
+            work_ptr -> nx_packet_prepend_ptr      =  work_ptr -> nx_packet_data_start + packet_type;
+            work_ptr -> nx_packet_append_ptr       =  work_ptr -> nx_packet_prepend_ptr;
+            work_ptr -> nx_packet_ip_interface     =  NX_NULL;
+            work_ptr -> nx_packet_next_hop_address =  NX_NULL;
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+            work_ptr -> nx_packet_interface_capability_flag =  0;
+            work_ptr -> nx_packet_tcp_segment_size =           0;
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+            /* Set the TCP queue to the value that indicates it has been allocated.  */
+            work_ptr -> nx_packet_tcp_queue_next   =  (NX_PACKET *)NX_PACKET_ALLOCATED;
+
+            /* Place the new packet pointer in the return destination.  */
+            *packet_ptr =  work_ptr;
+
+            /* Update the trace event with the status.  */
+            NX_TRACE_EVENT_UPDATE(trace_event, trace_timestamp, NX_TRACE_PACKET_ALLOCATE, 0, *packet_ptr, 0, 0)
+
+            /* Return successful completion.  */
+            return(NX_SUCCESS);
+        }
+
+        /* The pool is empty, suspend on it below if requested.  */
+    }
+#endif /* NX_ENABLE_PACKET_POOL_CACHE */
+
     /* Disable interrupts to get a packet from the pool.  */
     TX_DISABLE
 
@@ -127,6 +232,10 @@ ULONG                  trace_timestamp;
         work_ptr -> nx_packet_append_ptr       =  work_ptr -> nx_packet_prepend_ptr;
         work_ptr -> nx_packet_ip_interface     =  NX_NULL;
         work_ptr -> nx_packet_next_hop_address =  NX_NULL;
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+        work_ptr -> nx_packet_interface_capability_flag =  0;
+        work_ptr -> nx_packet_tcp_segment_size =           0;
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
         /* Set the TCP queue to the value that indicates it has been allocated.  */
         work_ptr -> nx_packet_tcp_queue_next   =  (NX_PACKET *)NX_PACKET_ALLOCATED;
 
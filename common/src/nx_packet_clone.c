@@ -0,0 +1,198 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Packet Pool Management (Packet)                                     */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_packet.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_packet_clone                                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function clones the specified packet using packets allocated   */
+/*    from the specified packet pool. The data of the first packet of the */
+/*    chain, which holds the protocol headers, is copied into a private   */
+/*    packet so the clone and the original can each update their headers. */
+/*    Every other packet of the chain is represented in the clone by a    */
+/*    packet header that references the data buffer of the original       */
+/*    packet instead of copying it. A shared data buffer is reference     */
+/*    counted and returned to its pool only when the original and all     */
+/*    clones have been released.                                          */
+/*                                                                        */
+/*    The shared data must not be modified by the original packet or any  */
+/*    clone.                                                              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    packet_ptr                            Pointer to source packet      */
+/*    new_packet_ptr                        Pointer for return packet     */
+/*    pool_ptr                              Pointer to packet pool to use */
+/*                                            for new packet(s)           */
+/*    wait_option                           Suspension option             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_packet_allocate                   Allocate data packet          */
+/*    _nx_packet_data_append                Packet data append service    */
+/*    _nx_packet_data_reference             Reference packet data         */
+/*    _nx_packet_release                    Release data packet           */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*    _nx_ip_loopback_send                  Send loopback packet          */
+/*    _nx_ram_network_driver_output         RAM driver output             */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_packet_clone(NX_PACKET *packet_ptr, NX_PACKET **new_packet_ptr,
+                       NX_PACKET_POOL *pool_ptr, ULONG wait_option)
+{
+#ifdef NX_ENABLE_PACKET_CLONE
+NX_PACKET *work_ptr;                    /* New packet pointer         */
+NX_PACKET *source_ptr;                  /* Data buffer owner          */
+ULONG      size;                        /* Packet data size           */
+UINT       status;                      /* Return status              */
+
+
+    /* Default the return packet pointer to NULL.  */
+    *new_packet_ptr =  NX_NULL;
+
+    /* Determine if there is anything to clone.  */
+    if (!packet_ptr -> nx_packet_length)
+    {
+
+        /* Empty source packet, return an error.  */
+        return(NX_INVALID_PACKET);
+    }
+
+    /* Allocate a new packet for the private copy of the first packet of the chain.  */
+    status =  _nx_packet_allocate(pool_ptr, &work_ptr,
+                                  (ULONG)(packet_ptr -> nx_packet_prepend_ptr - packet_ptr -> nx_packet_data_start), wait_option);
+
+    /* Determine if the packet was not allocated.  */
+    if (status != NX_SUCCESS)
+    {
+
+        /* Return the error code from the packet allocate routine.  */
+        return(status);
+    }
+
+    /* Copy the packet interface information. */
+    work_ptr -> nx_packet_ip_interface = packet_ptr -> nx_packet_ip_interface;
+
+    /* Copy the packet next hop address */
+    work_ptr -> nx_packet_next_hop_address = packet_ptr -> nx_packet_next_hop_address;
+
+    /* Calculate the data size of the first packet.  */
+    size =  (ULONG)(packet_ptr -> nx_packet_append_ptr - packet_ptr -> nx_packet_prepend_ptr);
+
+    /* Copy the data of the first packet, which holds the protocol headers.  */
+    status =  _nx_packet_data_append(work_ptr, packet_ptr -> nx_packet_prepend_ptr, size, pool_ptr, wait_option);
+
+    /* Determine if there was an error in the data append.  */
+    if (status != NX_SUCCESS)
+    {
+
+        /* An error is present, release the new packet.  */
+        _nx_packet_release(work_ptr);
+
+        /* Return the error code from the packet data append service.  */
+        return(status);
+    }
+
+    /* Loop to reference the data of the remaining packets of the chain.  */
+    source_ptr =  packet_ptr;
+    while (source_ptr -> nx_packet_next)
+    {
+
+        /* Move to the next packet in the chain.  */
+        source_ptr =  source_ptr -> nx_packet_next;
+
+        /* Reference the data of the source packet from a packet header appended to the clone.  */
+        status =  _nx_packet_data_reference(work_ptr, source_ptr, source_ptr -> nx_packet_prepend_ptr,
+                                            (ULONG)(source_ptr -> nx_packet_append_ptr - source_ptr -> nx_packet_prepend_ptr),
+                                            pool_ptr, wait_option);
+
+        /* Determine if the packet was not referenced.  */
+        if (status != NX_SUCCESS)
+        {
+
+            /* An error is present, release the new packet chain.  */
+            _nx_packet_release(work_ptr);
+
+            /* Return the error code from the packet data reference routine.  */
+            return(status);
+        }
+    }
+
+    /* Determine if the packet clone was successful.  */
+    if (packet_ptr -> nx_packet_length != work_ptr -> nx_packet_length)
+    {
+
+        /* An error is present, release the new packet.  */
+        _nx_packet_release(work_ptr);
+
+        /* Return an error code.  */
+        return(NX_INVALID_PACKET);
+    }
+
+    /* Everything is okay, return the new packet pointer.  */
+    *new_packet_ptr =  work_ptr;
+
+    /* Return success status.  */
+    return(NX_SUCCESS);
+#else
+    NX_PARAMETER_NOT_USED(packet_ptr);
+    NX_PARAMETER_NOT_USED(pool_ptr);
+    NX_PARAMETER_NOT_USED(wait_option);
+
+    /* Default the return packet pointer to NULL.  */
+    *new_packet_ptr =  NX_NULL;
+
+    /* Return an error.  */
+    return(NX_NOT_ENABLED);
+#endif /* NX_ENABLE_PACKET_CLONE */
+}
+
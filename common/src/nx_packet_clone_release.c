@@ -0,0 +1,148 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Packet Pool Management (Packet)                                     */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_packet.h"
+
+
+#ifdef NX_ENABLE_PACKET_CLONE
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_packet_clone_release                            PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function drops the reference a packet holds on a shared data   */
+/*    buffer when the packet is released. If the packet is a clone, its   */
+/*    own data buffer is restored and the owner of the shared buffer is   */
+/*    released once its last reference is dropped. If the packet owns a   */
+/*    buffer that clones still reference, the packet is left allocated    */
+/*    until the last clone is released.                                   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    packet_ptr                            Pointer to packet being       */
+/*                                            released                    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                NX_TRUE if the packet can be  */
+/*                                            returned to its pool now    */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_packet_release                    Release shared buffer owner   */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_packet_release                    Release data packet           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_packet_clone_release(NX_PACKET *packet_ptr)
+{
+
+TX_INTERRUPT_SAVE_AREA
+
+NX_PACKET *source_ptr;
+ULONG      reference_count;
+
+
+    /* Pickup the packet that owns the referenced data buffer.  */
+    source_ptr =  packet_ptr -> nx_packet_clone_source;
+
+    /* Determine if this packet is a clone.  */
+    if (source_ptr)
+    {
+
+        /* Yes, restore the data buffer of the clone itself.  */
+        packet_ptr -> nx_packet_clone_source =  NX_NULL;
+        packet_ptr -> nx_packet_data_start =    ((UCHAR *)packet_ptr) + sizeof(NX_PACKET);
+        packet_ptr -> nx_packet_data_end =      packet_ptr -> nx_packet_data_start +
+                                                (packet_ptr -> nx_packet_pool_owner) -> nx_packet_pool_payload_size;
+
+        /* Disable interrupts to update the reference count of the owner.  */
+        TX_DISABLE
+
+        /* Drop the reference of the clone.  */
+        source_ptr -> nx_packet_reference_count--;
+        reference_count =  source_ptr -> nx_packet_reference_count;
+
+        /* Restore interrupts.  */
+        TX_RESTORE
+
+        /* Determine if this was the last reference.  The owner has then already been released
+           and left allocated for the clones.  */
+        if (reference_count == 0)
+        {
+
+            /* Release the owner of the data buffer.  */
+            _nx_packet_release(source_ptr);
+        }
+
+        /* The clone packet itself can be returned to its pool.  */
+        return(NX_TRUE);
+    }
+
+    /* This packet owns a data buffer shared with clones.  */
+
+    /* Disable interrupts to update the reference count.  */
+    TX_DISABLE
+
+    /* Drop the reference of the packet itself.  */
+    packet_ptr -> nx_packet_reference_count--;
+    reference_count =  packet_ptr -> nx_packet_reference_count;
+
+    /* Determine if clones still reference the data buffer.  */
+    if (reference_count)
+    {
+
+        /* Yes, detach the packet from its chain.  It is released by the last clone.  */
+        packet_ptr -> nx_packet_next =  NX_NULL;
+        packet_ptr -> nx_packet_last =  NX_NULL;
+    }
+
+    /* Restore interrupts.  */
+    TX_RESTORE
+
+    /* Return whether the packet can be returned to its pool.  */
+    return((reference_count == 0) ? NX_TRUE : NX_FALSE);
+}
+#endif /* NX_ENABLE_PACKET_CLONE */
+
@@ -0,0 +1,156 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Packet Pool Management (Packet)                                     */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_packet.h"
+
+
+#ifdef NX_ENABLE_PACKET_CLONE
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_packet_data_reference                           PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function appends a packet to the end of the packet chain that  */
+/*    references data of a packet instead of copying it. The data area of */
+/*    the new packet is exactly the referenced data, so nothing can be    */
+/*    prepended or appended into the shared buffer through it. The packet */
+/*    that owns the buffer is left allocated until its last reference is  */
+/*    released.                                                           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    packet_ptr                            Packet to append to           */
+/*    source_ptr                            Packet the data belongs to    */
+/*    data_start                            Pointer to referenced data    */
+/*    data_size                             Size of referenced data       */
+/*    pool_ptr                              Pool for the new packet       */
+/*    wait_option                           Suspension option             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_packet_allocate                   Allocate packet header        */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_packet_clone                      Clone packet                  */
+/*    _nx_packet_vector_reference           Reference application buffers */
+/*    _nx_tcp_socket_send                   Send TCP packet               */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_packet_data_reference(NX_PACKET *packet_ptr, NX_PACKET *source_ptr, UCHAR *data_start, ULONG data_size,
+                                NX_PACKET_POOL *pool_ptr, ULONG wait_option)
+{
+
+TX_INTERRUPT_SAVE_AREA
+
+NX_PACKET *reference_ptr;
+UINT       status;
+
+
+    /* Allocate a packet header for the reference.  */
+    status =  _nx_packet_allocate(pool_ptr, &reference_ptr, 0, wait_option);
+
+    /* Determine if the packet was not allocated.  */
+    if (status != NX_SUCCESS)
+    {
+
+        /* Return the error code from the packet allocate routine.  */
+        return(status);
+    }
+
+    /* The data area of the reference is exactly the referenced data.  */
+    reference_ptr -> nx_packet_data_start =   data_start;
+    reference_ptr -> nx_packet_data_end =     data_start + data_size;
+    reference_ptr -> nx_packet_prepend_ptr =  data_start;
+    reference_ptr -> nx_packet_append_ptr =   data_start + data_size;
+
+    /* Reference the packet that owns the data buffer.  A reference of a reference points to
+       the original owner.  */
+    if (source_ptr -> nx_packet_clone_source)
+    {
+        reference_ptr -> nx_packet_clone_source =  source_ptr -> nx_packet_clone_source;
+    }
+    else
+    {
+        reference_ptr -> nx_packet_clone_source =  source_ptr;
+    }
+
+    /* Disable interrupts to update the reference count.  */
+    TX_DISABLE
+
+    /* Count the new reference, and the reference of the owner itself the first time the buffer
+       is shared.  */
+    if ((reference_ptr -> nx_packet_clone_source) -> nx_packet_reference_count)
+    {
+        (reference_ptr -> nx_packet_clone_source) -> nx_packet_reference_count++;
+    }
+    else
+    {
+        (reference_ptr -> nx_packet_clone_source) -> nx_packet_reference_count =  2;
+    }
+
+    /* Restore interrupts.  */
+    TX_RESTORE
+
+    /* Link the reference at the end of the packet chain.  */
+    if (packet_ptr -> nx_packet_last)
+    {
+        (packet_ptr -> nx_packet_last) -> nx_packet_next =  reference_ptr;
+    }
+    else
+    {
+        packet_ptr -> nx_packet_next =  reference_ptr;
+    }
+    packet_ptr -> nx_packet_last =  reference_ptr;
+
+    /* Update the length of the packet.  */
+    packet_ptr -> nx_packet_length =  packet_ptr -> nx_packet_length + data_size;
+
+    /* Return success status.  */
+    return(NX_SUCCESS);
+}
+#endif /* NX_ENABLE_PACKET_CLONE */
+
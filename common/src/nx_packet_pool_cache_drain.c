@@ -0,0 +1,148 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Packet Pool Management (Packet)                                     */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_packet.h"
+
+
+#ifdef NX_ENABLE_PACKET_POOL_CACHE
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_packet_pool_cache_drain                         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function moves packets from the packet cache of the current    */
+/*    thread back to the available list of the pool.  The packets are     */
+/*    linked onto the available list with interrupts disabled once for    */
+/*    the whole batch.  If threads are suspended on the pool, the packets */
+/*    are released one at a time instead so the suspended threads receive */
+/*    them.                                                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                              Pool of the cache             */
+/*    cache_ptr                             Cache of the current thread   */
+/*    count                                 Number of packets to move     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_packet_release                    Release packet                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_packet_release                    Release packet                */
+/*    _nx_packet_pool_cache_flush           Flush packet cache            */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_packet_pool_cache_drain(NX_PACKET_POOL *pool_ptr, NX_PACKET_POOL_CACHE *cache_ptr, ULONG count)
+{
+
+TX_INTERRUPT_SAVE_AREA
+
+NX_PACKET *head_ptr;
+NX_PACKET *tail_ptr;
+NX_PACKET *work_ptr;
+ULONG      i;
+
+
+    /* Limit the count to the packets in the cache.  */
+    if (count > cache_ptr -> nx_packet_pool_cache_count)
+    {
+        count =  cache_ptr -> nx_packet_pool_cache_count;
+    }
+
+    /* Determine if there is anything to move.  */
+    if (count == 0)
+    {
+        return;
+    }
+
+    /* Detach the first count packets of the cache.  Only this thread accesses the
+       list of its cache, so no protection is needed.  */
+    head_ptr =  cache_ptr -> nx_packet_pool_cache_list;
+    tail_ptr =  head_ptr;
+    for (i = 1; i < count; i++)
+    {
+        tail_ptr =  tail_ptr -> nx_packet_next;
+    }
+    cache_ptr -> nx_packet_pool_cache_list =  tail_ptr -> nx_packet_next;
+    cache_ptr -> nx_packet_pool_cache_count -=  count;
+
+    /* Disable interrupts to place the packets back in the pool.  */
+    TX_DISABLE
+
+    /* Determine if any threads are suspended on the pool.  */
+    if (pool_ptr -> nx_packet_pool_suspension_list == TX_NULL)
+    {
+
+        /* No, link the whole batch in front of the available list.  */
+        tail_ptr -> nx_packet_next =  pool_ptr -> nx_packet_pool_available_list;
+        pool_ptr -> nx_packet_pool_available_list =  head_ptr;
+
+        /* Increment the count of available blocks.  */
+        pool_ptr -> nx_packet_pool_available +=  count;
+
+        /* Restore interrupts.  */
+        TX_RESTORE
+
+        return;
+    }
+
+    /* Restore interrupts.  */
+    TX_RESTORE
+
+    /* Threads are waiting for packets.  Mark the batch as allocated so it can be
+       released as a chain, which hands the packets to the suspended threads.  */
+    tail_ptr -> nx_packet_next =  NX_NULL;
+    for (work_ptr = head_ptr; work_ptr; work_ptr = work_ptr -> nx_packet_next)
+    {
+        work_ptr -> nx_packet_tcp_queue_next =  (NX_PACKET *)NX_PACKET_ALLOCATED;
+    }
+
+    /* Release the chain.  */
+    _nx_packet_release(head_ptr);
+}
+#endif /* NX_ENABLE_PACKET_POOL_CACHE */
+
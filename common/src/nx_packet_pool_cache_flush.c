@@ -0,0 +1,115 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Packet Pool Management (Packet)                                     */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_packet.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_packet_pool_cache_flush                         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns all packets in the packet cache of the        */
+/*    calling thread to the specified packet pool and gives up the cache, */
+/*    so another thread can use it.  A thread that allocates or releases  */
+/*    packets should call this function before it is deleted, otherwise   */
+/*    the packets in its cache are not available to other threads.  If    */
+/*    the thread uses the pool again, it obtains a new cache.             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                              Pool to flush the cache of    */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_packet_pool_cache_get             Find packet cache             */
+/*    _nx_packet_pool_cache_drain           Return cached packets         */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_packet_pool_cache_flush(NX_PACKET_POOL *pool_ptr)
+{
+#ifdef NX_ENABLE_PACKET_POOL_CACHE
+
+NX_PACKET_POOL_CACHE *cache_ptr;
+
+
+    /* Pickup the packet cache of this thread.  */
+    cache_ptr =  _nx_packet_pool_cache_get(pool_ptr);
+    if (cache_ptr == NX_NULL)
+    {
+
+        /* No cache is used by this caller, nothing to flush.  */
+        return(NX_SUCCESS);
+    }
+
+    /* Return the packets to the pool.  While threads are suspended on the pool, packets
+       are handed to them and the remainder may be placed back in the cache, so loop
+       until the cache is empty.  */
+    while (cache_ptr -> nx_packet_pool_cache_count)
+    {
+        _nx_packet_pool_cache_drain(pool_ptr, cache_ptr, cache_ptr -> nx_packet_pool_cache_count);
+    }
+
+    /* Clear the statistics for the next owner.  */
+    cache_ptr -> nx_packet_pool_cache_hits =    0;
+    cache_ptr -> nx_packet_pool_cache_misses =  0;
+
+    /* Give up the cache.  */
+    cache_ptr -> nx_packet_pool_cache_thread =  TX_NULL;
+
+    /* Return successful completion.  */
+    return(NX_SUCCESS);
+#else
+    NX_PARAMETER_NOT_USED(pool_ptr);
+
+    /* Return an error.  */
+    return(NX_NOT_ENABLED);
+#endif /* NX_ENABLE_PACKET_POOL_CACHE */
+}
+
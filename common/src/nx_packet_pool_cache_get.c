@@ -0,0 +1,166 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Packet Pool Management (Packet)                                     */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "tx_thread.h"
+#include "nx_packet.h"
+
+
+#ifdef NX_ENABLE_PACKET_POOL_CACHE
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_packet_pool_cache_get                           PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function finds the packet cache of the current thread in the   */
+/*    specified packet pool.  A thread without a cache is given an unused */
+/*    one.  No cache is used from interrupt context, by code that runs    */
+/*    before the ThreadX scheduler starts or when all caches of the pool  */
+/*    are owned by other threads; in these cases NX_NULL is returned and  */
+/*    the caller uses the available list of the pool.                     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                              Pool to find the cache in     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    cache_ptr                             Cache of the current thread,  */
+/*                                            or NX_NULL if none          */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_packet_allocate                   Allocate packet               */
+/*    _nx_packet_release                    Release packet                */
+/*    _nx_packet_pool_cache_flush           Flush packet cache            */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+NX_PACKET_POOL_CACHE  *_nx_packet_pool_cache_get(NX_PACKET_POOL *pool_ptr)
+{
+
+TX_INTERRUPT_SAVE_AREA
+
+TX_THREAD            *thread_ptr;
+NX_PACKET_POOL_CACHE *cache_ptr;
+NX_PACKET_POOL_CACHE *unused_ptr;
+UINT                  i;
+
+
+    /* Pickup thread pointer.  */
+    thread_ptr =  _tx_thread_current_ptr;
+
+    /* Determine if the caller is a thread.  */
+    if ((TX_THREAD_GET_SYSTEM_STATE()) || (thread_ptr == TX_NULL))
+    {
+
+        /* No, interrupts and initialization use the available list of the pool.  */
+        return(NX_NULL);
+    }
+
+    /* Search for the cache of this thread, remembering an unused cache.  */
+    unused_ptr =  NX_NULL;
+    cache_ptr =   pool_ptr -> nx_packet_pool_cache;
+    for (i = 0; i < NX_PACKET_POOL_CACHE_COUNT; i++)
+    {
+
+        /* Determine if this thread owns this cache.  */
+        if (cache_ptr -> nx_packet_pool_cache_thread == thread_ptr)
+        {
+
+            /* Yes, return the cache.  */
+            return(cache_ptr);
+        }
+
+        /* Determine if this cache is unused.  */
+        if ((unused_ptr == NX_NULL) && (cache_ptr -> nx_packet_pool_cache_thread == TX_NULL))
+        {
+            unused_ptr =  cache_ptr;
+        }
+
+        /* Move to the next cache.  */
+        cache_ptr++;
+    }
+
+    /* Determine if an unused cache was seen.  */
+    if (unused_ptr == NX_NULL)
+    {
+
+        /* No, all caches are owned by other threads.  */
+        return(NX_NULL);
+    }
+
+    /* Disable interrupts to claim an unused cache.  */
+    TX_DISABLE
+
+    /* Search again, since another thread may have claimed the cache meanwhile.  */
+    cache_ptr =  pool_ptr -> nx_packet_pool_cache;
+    for (i = 0; i < NX_PACKET_POOL_CACHE_COUNT; i++)
+    {
+
+        /* Determine if this cache is unused.  */
+        if (cache_ptr -> nx_packet_pool_cache_thread == TX_NULL)
+        {
+
+            /* Yes, this thread now owns the cache.  */
+            cache_ptr -> nx_packet_pool_cache_thread =  thread_ptr;
+
+            /* Restore interrupts.  */
+            TX_RESTORE
+
+            return(cache_ptr);
+        }
+
+        /* Move to the next cache.  */
+        cache_ptr++;
+    }
+
+    /* Restore interrupts.  */
+    TX_RESTORE
+
+    /* All caches are owned by other threads.  */
+    return(NX_NULL);
+}
+#endif /* NX_ENABLE_PACKET_POOL_CACHE */
+
@@ -0,0 +1,142 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Packet Pool Management (Packet)                                     */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_packet.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_packet_pool_cache_info_get                      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function retrieves information about one of the per-thread     */
+/*    packet caches of the specified packet pool: the thread that owns    */
+/*    it, the number of free packets it holds and how often an allocation */
+/*    was satisfied from the cache (hit) or had to refill the cache from  */
+/*    the pool (miss).  The free packet count reported by                 */
+/*    nx_packet_pool_info_get includes the packets held in the caches.    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                              Pool to get information from  */
+/*    cache_index                           Index of the cache            */
+/*    thread_ptr                            Destination for owner thread  */
+/*    cached_packets                        Destination for cached        */
+/*                                            packets                     */
+/*    cache_hits                            Destination for cache hits    */
+/*    cache_misses                          Destination for cache misses  */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_packet_pool_cache_info_get(NX_PACKET_POOL *pool_ptr, UINT cache_index, TX_THREAD **thread_ptr,
+                                      ULONG *cached_packets, ULONG *cache_hits, ULONG *cache_misses)
+{
+#ifdef NX_ENABLE_PACKET_POOL_CACHE
+TX_INTERRUPT_SAVE_AREA
+
+NX_PACKET_POOL_CACHE *cache_ptr;
+
+
+    /* Check for a valid cache index.  */
+    if (cache_index >= NX_PACKET_POOL_CACHE_COUNT)
+    {
+        return(NX_INVALID_PARAMETERS);
+    }
+
+    /* Setup a pointer to the cache.  */
+    cache_ptr =  &(pool_ptr -> nx_packet_pool_cache[cache_index]);
+
+    /* Disable interrupts to get packet cache information.  */
+    TX_DISABLE
+
+    /* Determine if the owner thread is wanted.  */
+    if (thread_ptr)
+    {
+        *thread_ptr =  cache_ptr -> nx_packet_pool_cache_thread;
+    }
+
+    /* Determine if cached packets is wanted.  */
+    if (cached_packets)
+    {
+        *cached_packets =  cache_ptr -> nx_packet_pool_cache_count;
+    }
+
+    /* Determine if cache hits is wanted.  */
+    if (cache_hits)
+    {
+        *cache_hits =  cache_ptr -> nx_packet_pool_cache_hits;
+    }
+
+    /* Determine if cache misses is wanted.  */
+    if (cache_misses)
+    {
+        *cache_misses =  cache_ptr -> nx_packet_pool_cache_misses;
+    }
+
+    /* Restore interrupts.  */
+    TX_RESTORE
+
+    /* Return completion status.  */
+    return(NX_SUCCESS);
+#else
+    NX_PARAMETER_NOT_USED(pool_ptr);
+    NX_PARAMETER_NOT_USED(cache_index);
+    NX_PARAMETER_NOT_USED(thread_ptr);
+    NX_PARAMETER_NOT_USED(cached_packets);
+    NX_PARAMETER_NOT_USED(cache_hits);
+    NX_PARAMETER_NOT_USED(cache_misses);
+
+    /* Return an error.  */
+    return(NX_NOT_ENABLED);
+#endif /* NX_ENABLE_PACKET_POOL_CACHE */
+}
+
@@ -71,6 +71,12 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            cleared per-thread packet   */
+/*                                            caches, initialized packet  */
+/*                                            clone fields, initialized   */
+/*                                            zero copy send fields,      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_packet_pool_create(NX_PACKET_POOL *pool_ptr, CHAR *name_ptr, ULONG payload_size,
@@ -106,6 +112,12 @@ CHAR           *end_of_pool;            /* End of pool area            */
     pool_ptr -> nx_packet_pool_size =             pool_size;
     pool_ptr -> nx_packet_pool_payload_size =     original_payload_size;
 
+#ifdef NX_ENABLE_PACKET_POOL_CACHE
+
+    /* Start with all per-thread caches unused and empty.  */
+    memset((void *)pool_ptr -> nx_packet_pool_cache, 0, sizeof(pool_ptr -> nx_packet_pool_cache));
+#endif /* NX_ENABLE_PACKET_POOL_CACHE */
+
     /* Calculate the end of the pool's memory area.  */
     end_of_pool =  ((CHAR *)pool_start) + pool_size;
 
@@ -131,6 +143,17 @@ CHAR           *end_of_pool;            /* End of pool area            */
         /* Mark the packet as free.  */
         ((NX_PACKET *)packet_ptr) -> nx_packet_tcp_queue_next =  (NX_PACKET *)NX_PACKET_FREE;
 
+#ifdef NX_ENABLE_PACKET_CLONE
+        /* The packet uses its own data buffer, which is not shared.  */
+        ((NX_PACKET *)packet_ptr) -> nx_packet_clone_source =     NX_NULL;
+        ((NX_PACKET *)packet_ptr) -> nx_packet_reference_count =  0;
+#endif /* NX_ENABLE_PACKET_CLONE */
+
+#ifdef NX_ENABLE_ZERO_COPY_SEND
+        /* The packet does not own application buffers.  */
+        ((NX_PACKET *)packet_ptr) -> nx_packet_release_notify =  NX_NULL;
+#endif /* NX_ENABLE_ZERO_COPY_SEND */
+
         /* Setup the packet data pointers.  */
         ((NX_PACKET *)packet_ptr) -> nx_packet_data_start =  (UCHAR *)(packet_ptr + sizeof(NX_PACKET));
         ((NX_PACKET *)packet_ptr) -> nx_packet_data_end =    (UCHAR *)(packet_ptr + sizeof(NX_PACKET) + original_payload_size);
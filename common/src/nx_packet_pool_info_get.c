@@ -74,6 +74,10 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            counted packets in per-     */
+/*                                            thread caches as free,      */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_packet_pool_info_get(NX_PACKET_POOL *pool_ptr, ULONG *total_packets, ULONG *free_packets,
@@ -82,6 +86,10 @@ UINT  _nx_packet_pool_info_get(NX_PACKET_POOL *pool_ptr, ULONG *total_packets, U
 {
 TX_INTERRUPT_SAVE_AREA
 
+#ifdef NX_ENABLE_PACKET_POOL_CACHE
+UINT i;
+#endif /* NX_ENABLE_PACKET_POOL_CACHE */
+
 
     /* Disable interrupts to get packet pool information.  */
     TX_DISABLE
@@ -100,6 +108,15 @@ TX_INTERRUPT_SAVE_AREA
 
         /* Return the number of free packets in this pool.  */
         *free_packets =  pool_ptr -> nx_packet_pool_available;
+
+#ifdef NX_ENABLE_PACKET_POOL_CACHE
+
+        /* Add the free packets held in the per-thread caches.  */
+        for (i = 0; i < NX_PACKET_POOL_CACHE_COUNT; i++)
+        {
+            *free_packets +=  pool_ptr -> nx_packet_pool_cache[i].nx_packet_pool_cache_count;
+        }
+#endif /* NX_ENABLE_PACKET_POOL_CACHE */
     }
 
     /* Determine if empty pool requests is wanted.  */
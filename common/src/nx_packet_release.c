@@ -55,6 +55,9 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _nx_packet_clone_release              Drop shared buffer reference  */
+/*    _nx_packet_pool_cache_drain           Return cached packets         */
+/*    _nx_packet_pool_cache_get             Find packet cache             */
 /*    _tx_thread_system_resume              Resume suspended thread       */
 /*                                                                        */
 /*  CALLED BY                                                             */
@@ -68,6 +71,14 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            cleared the interface       */
+/*                                            capability fields, added    */
+/*                                            per-thread packet cache,    */
+/*                                            released shared packet data */
+/*                                            buffers, notified release   */
+/*                                            of zero copy send buffers,  */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_packet_release(NX_PACKET *packet_ptr)
@@ -78,6 +89,12 @@ TX_INTERRUPT_SAVE_AREA
 NX_PACKET_POOL *pool_ptr;               /* Pool pointer            */
 TX_THREAD      *thread_ptr;             /* Working thread pointer  */
 NX_PACKET      *next_packet;            /* Working block pointer   */
+#ifdef NX_ENABLE_ZERO_COPY_SEND
+VOID          (*release_notify)(VOID *context);
+#endif /* NX_ENABLE_ZERO_COPY_SEND */
+#ifdef NX_ENABLE_PACKET_POOL_CACHE
+NX_PACKET_POOL_CACHE *cache_ptr;        /* Thread packet cache     */
+#endif /* NX_ENABLE_PACKET_POOL_CACHE */
 
 
     /* If trace is enabled, insert this event into the trace buffer.  */
@@ -113,6 +130,74 @@ NX_PACKET      *next_packet;            /* Working block pointer   */
         /* Pickup the next packet. */
         next_packet =  packet_ptr -> nx_packet_next;
 
+#ifdef NX_ENABLE_PACKET_CLONE
+
+        /* Determine if the packet is a clone or owns a data buffer shared with clones.  */
+        if (((packet_ptr -> nx_packet_clone_source) || (packet_ptr -> nx_packet_reference_count)) &&
+            (_nx_packet_clone_release(packet_ptr) == NX_FALSE))
+        {
+
+            /* The data buffer is still referenced by clones, the last clone releases the packet.  */
+            packet_ptr =  next_packet;
+            continue;
+        }
+#endif /* NX_ENABLE_PACKET_CLONE */
+
+#ifdef NX_ENABLE_ZERO_COPY_SEND
+
+        /* Determine if the packet owns application buffers of a zero copy send.  */
+        if (packet_ptr -> nx_packet_release_notify)
+        {
+
+            /* Yes, the buffers are no longer referenced.  Clear the notify function before
+               calling it, so it is called only once.  */
+            release_notify =  packet_ptr -> nx_packet_release_notify;
+            packet_ptr -> nx_packet_release_notify =  NX_NULL;
+
+            /* Notify the application that it owns the buffers again.  */
+            (release_notify)(packet_ptr -> nx_packet_release_context);
+        }
+#endif /* NX_ENABLE_ZERO_COPY_SEND */
+
+#ifdef NX_ENABLE_PACKET_POOL_CACHE
+
+        /* Pickup the pool pointer.  */
+        pool_ptr =  packet_ptr -> nx_packet_pool_owner;
+
+        /* Determine if the packet can be kept in the cache of this thread.  While threads
+           are suspended on the pool, packets are returned to the pool so they are resumed.  */
+        if (pool_ptr -> nx_packet_pool_suspension_list == TX_NULL)
+        {
+
+            /* Pickup the packet cache of this thread.  */
+            cache_ptr =  _nx_packet_pool_cache_get(pool_ptr);
+            if (cache_ptr)
+            {
+
+                /* Determine if the cache is full.  */
+                if (cache_ptr -> nx_packet_pool_cache_count >= NX_PACKET_POOL_CACHE_SIZE)
+                {
+
+                    /* Yes, return a batch of packets to the pool.  */
+                    _nx_packet_pool_cache_drain(pool_ptr, cache_ptr, NX_PACKET_POOL_CACHE_BATCH);
+                }
+
+                /* Mark the packet as free.  */
+                packet_ptr -> nx_packet_tcp_queue_next =  (NX_PACKET *)NX_PACKET_FREE;
+
+                /* Put the packet in the cache.  Only this thread accesses the list of its
+                   cache, so no protection is needed.  */
+                packet_ptr -> nx_packet_next =  cache_ptr -> nx_packet_pool_cache_list;
+                cache_ptr -> nx_packet_pool_cache_list =  packet_ptr;
+                cache_ptr -> nx_packet_pool_cache_count++;
+
+                /* Move to the next packet in the list.  */
+                packet_ptr =  next_packet;
+                continue;
+            }
+        }
+#endif /* NX_ENABLE_PACKET_POOL_CACHE */
+
         /* Disable interrupts to put this packet back in the packet pool.  */
         TX_DISABLE
 
@@ -171,6 +256,10 @@ NX_PACKET      *next_packet;            /* Working block pointer   */
             packet_ptr -> nx_packet_length =       0;
             packet_ptr -> nx_packet_prepend_ptr =  packet_ptr -> nx_packet_data_start + (thread_ptr -> tx_thread_suspend_info);
             packet_ptr -> nx_packet_append_ptr =   packet_ptr -> nx_packet_prepend_ptr;
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+            packet_ptr -> nx_packet_interface_capability_flag =  0;
+            packet_ptr -> nx_packet_tcp_segment_size =           0;
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
 
             /* Return this block pointer to the suspended thread waiting for
                a block.  */
@@ -0,0 +1,204 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Packet Pool Management (Packet)                                     */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_packet.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_packet_vector_reference                         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function builds a packet chain that references the specified   */
+/*    application buffers instead of copying them. The first packet of    */
+/*    the chain holds no data and leaves room for the protocol headers of */
+/*    the packet type. Each buffer is referenced by a packet header whose */
+/*    data area is exactly the buffer, so the buffers are never written   */
+/*    by NetX.                                                            */
+/*                                                                        */
+/*    The buffers must not be modified or reused until the release notify */
+/*    function is called. It is called once the last packet referencing   */
+/*    the buffers is released, which may be from the IP helper thread, a  */
+/*    driver or an interrupt, so it must not suspend. It is not called if */
+/*    this service returns an error.                                      */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    pool_ptr                              Pool to allocate packets from */
+/*    packet_ptr                            Pointer to place packet chain */
+/*    packet_type                           Type of packet to build       */
+/*    vector_ptr                            Pointer to buffer descriptors */
+/*    vector_count                          Number of buffer descriptors  */
+/*    release_notify                        Buffer release notify         */
+/*                                            function                    */
+/*    context                               Argument of notify function   */
+/*    wait_option                           Suspension option             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_packet_allocate                   Allocate data packet          */
+/*    _nx_packet_data_reference             Reference buffer data         */
+/*    _nx_packet_release                    Release data packet           */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*    _nx_tcp_socket_send_vector            Send TCP buffers              */
+/*    _nx_udp_socket_send_vector            Send UDP buffers              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_packet_vector_reference(NX_PACKET_POOL *pool_ptr, NX_PACKET **packet_ptr, ULONG packet_type,
+                                  NX_PACKET_VECTOR *vector_ptr, UINT vector_count,
+                                  VOID (*release_notify)(VOID *context), VOID *context, ULONG wait_option)
+{
+#ifdef NX_ENABLE_ZERO_COPY_SEND
+NX_PACKET *work_ptr;                    /* New packet pointer         */
+NX_PACKET *owner_ptr;                   /* Application buffer owner   */
+UINT       i;                           /* Buffer descriptor index    */
+UINT       status;                      /* Return status              */
+
+
+    /* Default the return packet pointer to NULL.  */
+    *packet_ptr =  NX_NULL;
+
+    /* Allocate the packet that holds the protocol headers.  */
+    status =  _nx_packet_allocate(pool_ptr, &work_ptr, packet_type, wait_option);
+
+    /* Determine if the packet was not allocated.  */
+    if (status != NX_SUCCESS)
+    {
+
+        /* Return the error code from the packet allocate routine.  */
+        return(status);
+    }
+
+    /* Allocate the packet that owns the application buffers.  It is not part of the chain and
+       is released when the last packet referencing the buffers is released.  */
+    status =  _nx_packet_allocate(pool_ptr, &owner_ptr, 0, wait_option);
+
+    /* Determine if the packet was not allocated.  */
+    if (status != NX_SUCCESS)
+    {
+
+        /* An error is present, release the header packet.  */
+        _nx_packet_release(work_ptr);
+
+        /* Return the error code from the packet allocate routine.  */
+        return(status);
+    }
+
+    /* The owner holds a reference of its own while the chain is built.  */
+    owner_ptr -> nx_packet_reference_count =  1;
+
+    /* Loop to reference the application buffers.  */
+    for (i = 0; i < vector_count; i++)
+    {
+
+        /* Skip empty buffers.  */
+        if (vector_ptr[i].nx_packet_vector_length == 0)
+        {
+            continue;
+        }
+
+        /* Reference the buffer from a packet header appended to the chain.  */
+        status =  _nx_packet_data_reference(work_ptr, owner_ptr, (UCHAR *)vector_ptr[i].nx_packet_vector_data,
+                                            vector_ptr[i].nx_packet_vector_length, pool_ptr, wait_option);
+
+        /* Determine if the buffer was not referenced.  */
+        if (status != NX_SUCCESS)
+        {
+            break;
+        }
+    }
+
+    /* Determine if there is any data to send.  */
+    if ((status == NX_SUCCESS) && (work_ptr -> nx_packet_length == 0))
+    {
+
+        /* No, all buffers are empty.  */
+        status =  NX_INVALID_PACKET;
+    }
+
+    /* Determine if the packet chain was built.  */
+    if (status == NX_SUCCESS)
+    {
+
+        /* Yes, setup the function called when the buffers are no longer referenced.  */
+        owner_ptr -> nx_packet_release_notify =   release_notify;
+        owner_ptr -> nx_packet_release_context =  context;
+
+        /* Return the packet chain.  */
+        *packet_ptr =  work_ptr;
+    }
+    else
+    {
+
+        /* An error is present, release the packet chain.  The application is not notified.  */
+        _nx_packet_release(work_ptr);
+    }
+
+    /* Drop the reference of the owner itself.  From now on the owner is released by the last
+       packet referencing the buffers.  */
+    _nx_packet_release(owner_ptr);
+
+    /* Return completion status.  */
+    return(status);
+#else
+    NX_PARAMETER_NOT_USED(pool_ptr);
+    NX_PARAMETER_NOT_USED(packet_type);
+    NX_PARAMETER_NOT_USED(vector_ptr);
+    NX_PARAMETER_NOT_USED(vector_count);
+    NX_PARAMETER_NOT_USED(release_notify);
+    NX_PARAMETER_NOT_USED(context);
+    NX_PARAMETER_NOT_USED(wait_option);
+
+    /* Default the return packet pointer to NULL.  */
+    *packet_ptr =  NX_NULL;
+
+    /* Return an error.  */
+    return(NX_NOT_ENABLED);
+#endif /* NX_ENABLE_ZERO_COPY_SEND */
+}
+
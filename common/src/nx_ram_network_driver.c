@@ -24,11 +24,41 @@
 /* Include necessary system files.  */
 
 #include "nx_api.h"
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+#include "nx_ip.h"
+#include "nx_tcp.h"
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
 
 
 #define NX_LINK_MTU      8096
 
 
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+/* Define the offloads the simulated hardware reports.  Checksums are filled in
+   and TCP super-segments are split just before the frame goes on the wire.  When
+   NetX segments TCP super-segments in software, the simulated hardware leaves that
+   to NetX so the software path is exercised end to end.  */
+#ifndef NX_RAM_DRIVER_CAPABILITY
+#ifdef NX_ENABLE_TCP_GSO
+#define NX_RAM_DRIVER_CAPABILITY (NX_INTERFACE_CAPABILITY_IPV4_TX_CHECKSUM | \
+                                  NX_INTERFACE_CAPABILITY_IPV4_RX_CHECKSUM | \
+                                  NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM |  \
+                                  NX_INTERFACE_CAPABILITY_TCP_RX_CHECKSUM |  \
+                                  NX_INTERFACE_CAPABILITY_UDP_TX_CHECKSUM |  \
+                                  NX_INTERFACE_CAPABILITY_UDP_RX_CHECKSUM)
+#else
+#define NX_RAM_DRIVER_CAPABILITY (NX_INTERFACE_CAPABILITY_IPV4_TX_CHECKSUM | \
+                                  NX_INTERFACE_CAPABILITY_IPV4_RX_CHECKSUM | \
+                                  NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM |  \
+                                  NX_INTERFACE_CAPABILITY_TCP_RX_CHECKSUM |  \
+                                  NX_INTERFACE_CAPABILITY_UDP_TX_CHECKSUM |  \
+                                  NX_INTERFACE_CAPABILITY_UDP_RX_CHECKSUM |  \
+                                  NX_INTERFACE_CAPABILITY_TCP_SEGMENTATION)
+#endif /* NX_ENABLE_TCP_GSO */
+#endif
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
+
 /* Define Ethernet address format.  This is prepended to the incoming IP
    and ARP/RARP messages.  The frame beginning is 14 bytes, but for speed
    purposes, we are going to assume there are 16 bytes free in front of the
@@ -63,6 +93,9 @@ ULONG   simulated_address_lsw =  0x33445566;
 VOID _nx_ram_network_driver(NX_IP_DRIVER *driver_req_ptr);
 void _nx_ram_network_driver_output(NX_IP *ip_ptr, NX_PACKET *packet_ptr, UINT device_instance_id);
 void _nx_ram_network_driver_receive(NX_IP *ip_ptr, NX_PACKET *packet_ptr, UINT device_instance_id);
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+void _nx_ram_network_driver_segment(NX_IP_DRIVER *driver_req_ptr);
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
 
 #define NX_MAX_RAM_INTERFACES 4
 
@@ -109,7 +142,9 @@ static _nx_ram_network_driver_instance_type nx_ram_driver[NX_MAX_RAM_INTERFACES]
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _nx_ip_packet_checksum_compute        Compute offloaded checksums   */
 /*    _nx_ram_network_driver_output         Send physical packet out      */
+/*    _nx_ram_network_driver_segment        Split TCP super-segment       */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -122,6 +157,10 @@ static _nx_ram_network_driver_instance_type nx_ram_driver[NX_MAX_RAM_INTERFACES]
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            simulated checksum and TCP  */
+/*                                            segmentation offload,       */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_ram_network_driver(NX_IP_DRIVER *driver_req_ptr)
@@ -294,6 +333,20 @@ NX_INTERFACE *interface_ptr;
         /* Place the ethernet frame at the front of the packet.  */
         packet_ptr =  driver_req_ptr -> nx_ip_driver_packet;
 
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+        /* Determine if this is a TCP super-segment.  */
+        if (packet_ptr -> nx_packet_tcp_segment_size)
+        {
+
+            /* Yes, split it into MSS sized segments as segmentation offload hardware does.  */
+            _nx_ram_network_driver_segment(driver_req_ptr);
+            break;
+        }
+
+        /* Fill in the checksums left to the simulated hardware.  */
+        _nx_ip_packet_checksum_compute(packet_ptr);
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
         /* Adjust the prepend pointer.  */
         packet_ptr -> nx_packet_prepend_ptr =  packet_ptr -> nx_packet_prepend_ptr - NX_ETHERNET_SIZE;
 
@@ -419,6 +472,16 @@ NX_INTERFACE *interface_ptr;
         break;
     }
 
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+    case NX_LINK_GET_CAPABILITY:
+    {
+
+        /* Return the offloads the simulated hardware performs.  */
+        *(driver_req_ptr -> nx_ip_driver_return_ptr) =  NX_RAM_DRIVER_CAPABILITY;
+        break;
+    }
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
     case NX_LINK_DEFERRED_PROCESSING:
     {
 
@@ -443,6 +506,213 @@ NX_INTERFACE *interface_ptr;
 }
 
 
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_ram_network_driver_segment                      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function splits a TCP super-segment into segments of the size  */
+/*    recorded in the packet, the way TCP segmentation offload hardware   */
+/*    does.  Each segment carries a copy of the IP and TCP headers with   */
+/*    the total length, IP identification, sequence number and flags      */
+/*    fixed up, and is then sent through the driver like any other        */
+/*    packet.                                                             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    driver_req_ptr                        Pointer to driver request     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    nx_packet_allocate                    Allocate a segment packet     */
+/*    nx_packet_data_append                 Copy headers and payload      */
+/*    nx_packet_release                     Release a partial segment     */
+/*    nx_packet_transmit_release            Release the super-segment     */
+/*    _nx_ram_network_driver                Send each segment             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_ram_network_driver                RAM network driver            */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+void  _nx_ram_network_driver_segment(NX_IP_DRIVER *driver_req_ptr)
+{
+
+NX_IP_DRIVER segment_request;
+NX_PACKET   *packet_ptr;
+NX_PACKET   *segment_ptr;
+NX_PACKET   *source_ptr;
+UCHAR       *data_ptr;
+ULONG       *header_ptr;
+ULONG        ip_header_length;
+ULONG        header_length;
+ULONG        remaining_bytes;
+ULONG        segment_bytes;
+ULONG        copy_size;
+ULONG        segment_size;
+ULONG        segment_count;
+ULONG        temp;
+
+
+    /* Pickup the super-segment and the size of the segments to create.  */
+    packet_ptr =  driver_req_ptr -> nx_ip_driver_packet;
+    segment_size =  packet_ptr -> nx_packet_tcp_segment_size;
+
+    /* Compute the length of the IP header and of the IP and TCP headers together.  */
+    header_ptr =  (ULONG *)packet_ptr -> nx_packet_prepend_ptr;
+    temp =  *header_ptr;
+    NX_CHANGE_ULONG_ENDIAN(temp);
+    ip_header_length =  ((temp & NX_IP_LENGTH_MASK) >> 24) * sizeof(ULONG);
+    temp =  *(header_ptr + (ip_header_length / sizeof(ULONG)) + 3);
+    NX_CHANGE_ULONG_ENDIAN(temp);
+    header_length =  ip_header_length + ((temp >> 28) * sizeof(ULONG));
+
+    /* Setup the source of the payload, right after the headers.  */
+    source_ptr =  packet_ptr;
+    data_ptr =  packet_ptr -> nx_packet_prepend_ptr + header_length;
+    remaining_bytes =  packet_ptr -> nx_packet_length - header_length;
+    segment_count =  0;
+
+    /* Loop to build and send each segment.  */
+    while (remaining_bytes)
+    {
+
+        /* Allocate a packet for the segment, leaving room for the physical header.  */
+        if (nx_packet_allocate(driver_req_ptr -> nx_ip_driver_ptr -> nx_ip_default_packet_pool, &segment_ptr,
+                               NX_PHYSICAL_HEADER, NX_NO_WAIT))
+        {
+            break;
+        }
+
+        /* Copy the IP and TCP headers.  */
+        if (nx_packet_data_append(segment_ptr, packet_ptr -> nx_packet_prepend_ptr, header_length,
+                                  driver_req_ptr -> nx_ip_driver_ptr -> nx_ip_default_packet_pool, NX_NO_WAIT))
+        {
+            nx_packet_release(segment_ptr);
+            break;
+        }
+
+        /* Determine how much payload goes into this segment.  */
+        if (remaining_bytes > segment_size)
+        {
+            segment_bytes =  segment_size;
+        }
+        else
+        {
+            segment_bytes =  remaining_bytes;
+        }
+
+        /* Copy the payload, walking the super-segment packet chain.  */
+        copy_size =  0;
+        while (segment_bytes > copy_size)
+        {
+
+            /* Move to the next packet in the chain if this one is exhausted.  */
+            if (data_ptr == source_ptr -> nx_packet_append_ptr)
+            {
+                source_ptr =  source_ptr -> nx_packet_next;
+                if (source_ptr == NX_NULL)
+                {
+                    break;
+                }
+                data_ptr =  source_ptr -> nx_packet_prepend_ptr;
+                continue;
+            }
+
+            /* Copy as much of this buffer as fits in the segment.  */
+            temp =  (ULONG)(source_ptr -> nx_packet_append_ptr - data_ptr);
+            if (temp > (segment_bytes - copy_size))
+            {
+                temp =  segment_bytes - copy_size;
+            }
+            if (nx_packet_data_append(segment_ptr, data_ptr, temp,
+                                      driver_req_ptr -> nx_ip_driver_ptr -> nx_ip_default_packet_pool, NX_NO_WAIT))
+            {
+                break;
+            }
+            data_ptr +=  temp;
+            copy_size +=  temp;
+        }
+
+        /* Determine if the payload could not be copied.  */
+        if (copy_size != segment_bytes)
+        {
+            nx_packet_release(segment_ptr);
+            break;
+        }
+
+        remaining_bytes -=  segment_bytes;
+
+        /* Fix up the IP total length.  */
+        header_ptr =  (ULONG *)segment_ptr -> nx_packet_prepend_ptr;
+        temp =  *header_ptr;
+        NX_CHANGE_ULONG_ENDIAN(temp);
+        temp =  (temp & ~NX_IP_PACKET_SIZE_MASK) | (header_length + segment_bytes);
+        NX_CHANGE_ULONG_ENDIAN(temp);
+        *header_ptr =  temp;
+
+        /* Fix up the IP identification, the IP layer reserved one for each segment.  */
+        temp =  *(header_ptr + 1);
+        NX_CHANGE_ULONG_ENDIAN(temp);
+        temp =  temp + (segment_count << NX_SHIFT_BY_16);
+        NX_CHANGE_ULONG_ENDIAN(temp);
+        *(header_ptr + 1) =  temp;
+
+        /* Fix up the TCP sequence number.  */
+        header_ptr =  header_ptr + (ip_header_length / sizeof(ULONG));
+        temp =  *(header_ptr + 1);
+        NX_CHANGE_ULONG_ENDIAN(temp);
+        temp =  temp + (segment_count * segment_size);
+        NX_CHANGE_ULONG_ENDIAN(temp);
+        *(header_ptr + 1) =  temp;
+
+        /* Only the last segment keeps the FIN and PSH flags.  */
+        if (remaining_bytes)
+        {
+            temp =  *(header_ptr + 3);
+            NX_CHANGE_ULONG_ENDIAN(temp);
+            temp =  temp & ~(NX_TCP_FIN_BIT | NX_TCP_PSH_BIT);
+            NX_CHANGE_ULONG_ENDIAN(temp);
+            *(header_ptr + 3) =  temp;
+        }
+
+        /* Both checksums must be computed for the segment.  */
+        segment_ptr -> nx_packet_ip_interface =  packet_ptr -> nx_packet_ip_interface;
+        segment_ptr -> nx_packet_interface_capability_flag =  NX_INTERFACE_CAPABILITY_IPV4_TX_CHECKSUM |
+                                                              NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM;
+
+        /* Send the segment through the driver.  */
+        segment_request =  *driver_req_ptr;
+        segment_request.nx_ip_driver_packet =  segment_ptr;
+        _nx_ram_network_driver(&segment_request);
+
+        segment_count++;
+    }
+
+    /* The super-segment itself is never put on the wire.  */
+    nx_packet_transmit_release(packet_ptr);
+}
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
+
 /**************************************************************************/
 /*                                                                        */
 /*  FUNCTION                                               RELEASE        */
@@ -473,6 +743,7 @@ NX_INTERFACE *interface_ptr;
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    nx_packet_clone                       Clone a packet                */
 /*    nx_packet_copy                        Copy a packet                 */
 /*    nx_packet_transmit_release            Release a packet              */
 /*    _nx_ram_network_driver_receive        RAM driver receive processing */
@@ -488,6 +759,9 @@ NX_INTERFACE *interface_ptr;
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), cloned   */
+/*                                            packets when enabled,       */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 void  _nx_ram_network_driver_output(NX_IP *ip_ptr, NX_PACKET *packet_ptr, UINT device_instance_id)
@@ -571,8 +845,13 @@ UINT   j;
             ((destination_address_msw == nx_ram_driver[i].nx_ram_driver_simulated_address_msw) &&
              (destination_address_lsw == nx_ram_driver[i].nx_ram_driver_simulated_address_lsw)))
         {
+#ifdef NX_ENABLE_PACKET_CLONE
+            /* Make a clone of packet for the forwarding.  */
+            if (nx_packet_clone(packet_ptr, &packet_copy, next_ip -> nx_ip_default_packet_pool, NX_NO_WAIT))
+#else
             /* Make a copy of packet for the forwarding.  */
             if (nx_packet_copy(packet_ptr, &packet_copy, next_ip -> nx_ip_default_packet_pool, NX_NO_WAIT))
+#endif /* NX_ENABLE_PACKET_CLONE */
             {
 
                 /* Remove the Ethernet header.  */
@@ -60,10 +60,12 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _nx_tcp_connection_table_insert       Insert into connection table  */
 /*    _nx_tcp_socket_thread_suspend         Suspend thread for connection */
 /*    _nx_tcp_packet_send_syn               Send SYN packet               */
 /*    _nx_ip_route_find                     Find a suitable outgoing      */
 /*                                            interface.                  */
+/*    _nx_tcp_socket_timer_update           Update socket timers          */
 /*    tx_mutex_get                          Obtain protection             */
 /*    tx_mutex_put                          Release protection            */
 /*                                                                        */
@@ -78,6 +80,13 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            TCP connection table, added */
+/*                                            TCP timer wheel, added      */
+/*                                            round-trip time reset,      */
+/*                                            added SACK reset, added     */
+/*                                            reassembly index reset,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_tcp_client_socket_connect(NX_TCP_SOCKET *socket_ptr, ULONG server_ip, UINT server_port, ULONG wait_option)
@@ -189,6 +198,9 @@ NX_INTERFACE *outgoing_interface;
 
     socket_ptr -> nx_tcp_socket_connect_interface = outgoing_interface;
 
+    /* Place the socket on the TCP connection table.  */
+    _nx_tcp_connection_table_insert(ip_ptr, socket_ptr);
+
     /* Setup the initial sequence number.  */
     if (socket_ptr -> nx_tcp_socket_tx_sequence == 0)
     {
@@ -209,7 +221,24 @@ NX_INTERFACE *outgoing_interface;
     /* Increment the sequence number.  */
     socket_ptr -> nx_tcp_socket_tx_sequence++;
 
+#ifdef NX_ENABLE_TCP_RTT_ESTIMATION
+
+    /* Start the new connection from the configured timeout with no round-trip time estimate.  */
+    socket_ptr -> nx_tcp_socket_timeout_rate =  socket_ptr -> nx_tcp_socket_timeout_rate_default;
+    socket_ptr -> nx_tcp_socket_rtt_srtt =      0;
+    socket_ptr -> nx_tcp_socket_rtt_rttvar =    0;
+    socket_ptr -> nx_tcp_socket_rtt_active =    NX_FALSE;
+#endif /* NX_ENABLE_TCP_RTT_ESTIMATION */
+
+#ifdef NX_ENABLE_TCP_SACK
+
+    /* SACK is used only if the peer accepts it in its SYN.  */
+    socket_ptr -> nx_tcp_socket_sack_permitted =  NX_FALSE;
+    socket_ptr -> nx_tcp_socket_sack_count =      0;
+#endif /* NX_ENABLE_TCP_SACK */
+
     /* Setup a timeout so the connection attempt can be sent again.  */
+    _nx_tcp_socket_timer_update(socket_ptr);
     socket_ptr -> nx_tcp_socket_timeout =          socket_ptr -> nx_tcp_socket_timeout_rate;
     socket_ptr -> nx_tcp_socket_timeout_retries =  0;
 
@@ -228,6 +257,9 @@ NX_INTERFACE *outgoing_interface;
     socket_ptr -> nx_tcp_socket_receive_queue_count =  0;
     socket_ptr -> nx_tcp_socket_receive_queue_head  =  NX_NULL;
     socket_ptr -> nx_tcp_socket_receive_queue_tail  =  NX_NULL;
+#ifdef NX_ENABLE_TCP_REASSEMBLY_INDEX
+    socket_ptr -> nx_tcp_socket_reassembly_count =    0;
+#endif /* NX_ENABLE_TCP_REASSEMBLY_INDEX */
 
     /* Send the SYN message.  */
     _nx_tcp_packet_send_syn(socket_ptr, (socket_ptr -> nx_tcp_socket_tx_sequence - 1));
@@ -56,6 +56,7 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _nx_tcp_client_bind_cleanup           Remove and cleanup bind req   */
+/*    _nx_tcp_connection_table_remove       Remove from connection table  */
 /*    _nx_tcp_disconnect_cleanup            Disconnect cleanup            */
 /*    _nx_tcp_socket_receive_queue_flush    Release all received packets  */
 /*    _nx_tcp_socket_thread_resume          Resume thread suspended on    */
@@ -74,6 +75,9 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            TCP connection table,       */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_tcp_client_socket_unbind(NX_TCP_SOCKET *socket_ptr)
@@ -125,6 +129,9 @@ NX_TCP_SOCKET *new_socket_ptr;
         return(NX_NOT_CLOSED);
     }
 
+    /* Remove the socket from the TCP connection table.  */
+    _nx_tcp_connection_table_remove(ip_ptr, socket_ptr);
+
     /* Check for a thread suspended for disconnect processing to complete.  */
     if (socket_ptr -> nx_tcp_socket_disconnect_suspended_thread)
     {
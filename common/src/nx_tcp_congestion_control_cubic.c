@@ -0,0 +1,405 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_tcp.h"
+
+#if NX_TCP_CONGESTION_CONTROL_DATA_SIZE < NX_TCP_CUBIC_DATA_WORDS
+#error "NX_TCP_CONGESTION_CONTROL_DATA_SIZE is too small for the CUBIC congestion control algorithm."
+#endif
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_congestion_control_cubic_root               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function computes the integer cube root of a 32-bit value with */
+/*    the bitwise method, which needs neither a divide nor a multiply by  */
+/*    more than a small constant per step.                                */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    value                                 Value to take the root of     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    root                                  Largest root cubed <= value   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_congestion_control_cubic      CUBIC congestion control      */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+static ULONG  _nx_tcp_congestion_control_cubic_root(ULONG value)
+{
+
+INT   shift;
+ULONG root;
+ULONG bit;
+
+
+    /* Produce one bit of the root for every three bits of the value, starting at the top.  */
+    root =  0;
+    for (shift = 30; shift >= 0; shift -= 3)
+    {
+
+        /* Make room for the next bit of the root.  */
+        root =  root << 1;
+
+        /* Compute the amount (root + 1)^3 - root^3 at this bit position.  */
+        bit =  ((3 * root * (root + 1)) + 1) << shift;
+
+        /* Determine if the next bit of the root is set.  */
+        if (value >= bit)
+        {
+            value -=  bit;
+            root++;
+        }
+    }
+
+    /* Return the root.  */
+    return(root);
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_congestion_control_cubic                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is the CUBIC TCP congestion control algorithm of RFC  */
+/*    8312.  Outside of slow start the congestion window follows a cubic  */
+/*    function of the time since the last loss, centered on the window at */
+/*    which the loss happened, so it regains the previous window quickly  */
+/*    and then probes for more bandwidth carefully.  The window never     */
+/*    grows slower than the Reno-friendly estimate.                       */
+/*                                                                        */
+/*    All of the arithmetic is done with 32-bit integers.  Time is        */
+/*    measured in 1/64 second units, C is 0.4 and the multiplicative      */
+/*    decrease factor is 0.7.  The algorithm state is kept in the         */
+/*    congestion control data words of the socket.                        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to TCP socket         */
+/*    event                                 Congestion control event      */
+/*    acked_bytes                           Bytes acknowledged by the ACK */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_tcp_congestion_control_cubic_root Compute integer cube root     */
+/*    tx_time_get                           Get current time              */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_socket_retransmit             Retransmit TCP packet         */
+/*    _nx_tcp_socket_send                   Send data packet              */
+/*    _nx_tcp_socket_state_ack_check        Process received ACK          */
+/*    _nx_tcp_socket_state_syn_received     Process SYN RECEIVED state    */
+/*    _nx_tcp_socket_state_syn_sent         Process SYN SENT state        */
+/*    _nx_tcp_socket_congestion_control_set Set congestion control        */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_tcp_congestion_control_cubic(NX_TCP_SOCKET *socket_ptr, UINT event, ULONG acked_bytes)
+{
+
+ULONG *data_ptr;
+ULONG  current_time;
+ULONG  elapsed_time;
+ULONG  delta;
+ULONG  offset;
+ULONG  target;
+ULONG  increment;
+ULONG  mss;
+ULONG  window;
+
+
+    /* Setup a pointer to the CUBIC state of this socket.  */
+    data_ptr =  socket_ptr -> nx_tcp_socket_congestion_control_data;
+
+    /* Pickup the current time and the MSS.  */
+    current_time =  tx_time_get();
+    mss =  socket_ptr -> nx_tcp_socket_connect_mss;
+
+    switch (event)
+    {
+
+    case NX_TCP_CONGESTION_CONTROL_INIT:
+    {
+
+        /* Start without any history of loss.  */
+        memset((void *)data_ptr, 0, NX_TCP_CUBIC_DATA_WORDS * sizeof(ULONG));
+
+        break;
+    }
+
+    case NX_TCP_CONGESTION_CONTROL_ACK:
+    {
+
+        /* Remember when the last ACK arrived, to recognize an idle period.  */
+        data_ptr[NX_TCP_CUBIC_LAST_TIME] =  current_time;
+
+        /* Nothing to do if no new data is acknowledged.  */
+        if (acked_bytes == 0)
+        {
+            break;
+        }
+
+        /* Determine if the socket is in slow start.  */
+        if (socket_ptr -> nx_tcp_socket_tx_window_congestion < socket_ptr -> nx_tcp_socket_tx_slow_start_threshold)
+        {
+
+            /* cwnd += min (N, SMSS).
+               where N is the number of ACKed bytes. */
+            /* Section 3.1, Page 6, RFC5681. */
+            if (acked_bytes < mss)
+            {
+                socket_ptr -> nx_tcp_socket_tx_window_congestion +=  acked_bytes;
+            }
+            else
+            {
+                socket_ptr -> nx_tcp_socket_tx_window_congestion +=  mss;
+            }
+
+            break;
+        }
+
+        window =  socket_ptr -> nx_tcp_socket_tx_window_congestion;
+
+        /* Determine if a new congestion avoidance epoch starts.  */
+        if (data_ptr[NX_TCP_CUBIC_EPOCH_START] == 0)
+        {
+
+            /* Yes, start the epoch now.  Zero means no epoch, so avoid it.  */
+            data_ptr[NX_TCP_CUBIC_EPOCH_START] =  current_time ? current_time : 1;
+
+            if (window < data_ptr[NX_TCP_CUBIC_W_MAX])
+            {
+
+                /* Compute K = cubic_root((W_max - cwnd) / C) in 1/64 seconds, which is
+                   cubic_root((W_max - cwnd) in segments * 64^3 / 0.4).  */
+                delta =  (data_ptr[NX_TCP_CUBIC_W_MAX] - window) / mss;
+                if (delta > 6553)
+                {
+                    delta =  6553;
+                }
+                data_ptr[NX_TCP_CUBIC_K] =       _nx_tcp_congestion_control_cubic_root(delta * 655360);
+                data_ptr[NX_TCP_CUBIC_ORIGIN] =  data_ptr[NX_TCP_CUBIC_W_MAX];
+            }
+            else
+            {
+
+                /* The window is already past the previous maximum, start at the inflection point.  */
+                data_ptr[NX_TCP_CUBIC_K] =       0;
+                data_ptr[NX_TCP_CUBIC_ORIGIN] =  window;
+            }
+
+            /* Start the Reno-friendly estimate at the current window.  */
+            data_ptr[NX_TCP_CUBIC_W_EST] =  window;
+        }
+
+        /* Compute the time t in the epoch one round trip from now, in 1/64 seconds.  */
+        elapsed_time =  current_time - data_ptr[NX_TCP_CUBIC_EPOCH_START];
+#ifdef NX_ENABLE_TCP_RTT_ESTIMATION
+        elapsed_time +=  socket_ptr -> nx_tcp_socket_rtt_srtt >> 3;
+#endif /* NX_ENABLE_TCP_RTT_ESTIMATION */
+        if (elapsed_time > (0x03FFFFFF / NX_IP_PERIODIC_RATE) * NX_IP_PERIODIC_RATE)
+        {
+            elapsed_time =  (0x03FFFFFF / NX_IP_PERIODIC_RATE) * NX_IP_PERIODIC_RATE;
+        }
+        elapsed_time =  (elapsed_time << 6) / NX_IP_PERIODIC_RATE;
+
+        /* Compute the distance |t - K| from the plateau, limited to 25 seconds.  */
+        if (elapsed_time < data_ptr[NX_TCP_CUBIC_K])
+        {
+            delta =  data_ptr[NX_TCP_CUBIC_K] - elapsed_time;
+        }
+        else
+        {
+            delta =  elapsed_time - data_ptr[NX_TCP_CUBIC_K];
+        }
+        if (delta > 1600)
+        {
+            delta =  1600;
+        }
+
+        /* Compute C * |t - K|^3 in 1/64 segments, then convert to bytes.  */
+        offset =  (delta * delta * delta) / 10240;
+        offset =  ((offset >> 6) * mss) + (((offset & 63) * mss) >> 6);
+
+        /* Compute the cubic window W_cubic(t + RTT).  */
+        if (elapsed_time < data_ptr[NX_TCP_CUBIC_K])
+        {
+
+            /* Concave region, below the plateau.  */
+            if (offset < data_ptr[NX_TCP_CUBIC_ORIGIN])
+            {
+                target =  data_ptr[NX_TCP_CUBIC_ORIGIN] - offset;
+            }
+            else
+            {
+                target =  0;
+            }
+        }
+        else
+        {
+
+            /* Convex region, probing above the plateau.  */
+            target =  data_ptr[NX_TCP_CUBIC_ORIGIN] + offset;
+        }
+
+        /* Never more than 1.5 times the window per round trip.  */
+        if (target > window + (window >> 1))
+        {
+            target =  window + (window >> 1);
+        }
+
+        /* Never account for more than one window of acknowledged data.  */
+        if (acked_bytes > window)
+        {
+            acked_bytes =  window;
+        }
+
+        /* Grow the Reno-friendly estimate by 3 * (1 - 0.7) / (1 + 0.7) segments per round trip.  */
+        increment =  ((mss * 9) / 17) / (window / acked_bytes);
+        data_ptr[NX_TCP_CUBIC_W_EST] +=  increment;
+
+        /* Never grow slower than Reno would.  */
+        if (target < data_ptr[NX_TCP_CUBIC_W_EST])
+        {
+            target =  data_ptr[NX_TCP_CUBIC_W_EST];
+        }
+
+        /* Determine if the window is below the target.  */
+        if (target > window)
+        {
+
+            /* Yes, grow the window so it reaches the target in one round trip.  */
+            increment =  (target - window) / (window / acked_bytes);
+
+            /* If the above formula yields 0, the result is rounded up to 1 byte.  */
+            if (increment == 0)
+            {
+                increment =  1;
+            }
+
+            socket_ptr -> nx_tcp_socket_tx_window_congestion =  window + increment;
+        }
+
+        break;
+    }
+
+    case NX_TCP_CONGESTION_CONTROL_LOSS:
+    case NX_TCP_CONGESTION_CONTROL_TIMEOUT:
+    {
+
+        /* Pickup the flight size.  */
+        window =  socket_ptr -> nx_tcp_socket_tx_outstanding_bytes;
+
+        /* Remember the window at the loss.  With fast convergence, release bandwidth
+           to new flows by lowering W_max when the loss came before the previous maximum.  */
+        if (window < data_ptr[NX_TCP_CUBIC_W_MAX])
+        {
+            data_ptr[NX_TCP_CUBIC_W_MAX] =  (window / 20) * 17;
+        }
+        else
+        {
+            data_ptr[NX_TCP_CUBIC_W_MAX] =  window;
+        }
+
+        /* Reduce the window by the multiplicative decrease factor 0.7.  */
+        window =  (window / 10) * 7;
+
+        /* Make sure we have at least 2 * MSS */
+        if (window < (mss << 1))
+        {
+            window =  mss << 1;
+        }
+
+        /* Set the slow_start_threshold */
+        socket_ptr -> nx_tcp_socket_tx_slow_start_threshold =  window;
+
+        /* A new epoch starts when congestion avoidance resumes.  */
+        data_ptr[NX_TCP_CUBIC_EPOCH_START] =  0;
+
+        break;
+    }
+
+    case NX_TCP_CONGESTION_CONTROL_IDLE:
+    {
+
+        /* Do not count the idle time as growth time of the current epoch.  */
+        if (data_ptr[NX_TCP_CUBIC_EPOCH_START] != 0)
+        {
+            data_ptr[NX_TCP_CUBIC_EPOCH_START] +=  current_time - data_ptr[NX_TCP_CUBIC_LAST_TIME];
+        }
+
+        data_ptr[NX_TCP_CUBIC_LAST_TIME] =  current_time;
+
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
@@ -0,0 +1,153 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_tcp.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_congestion_control_newreno                  PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function is the default TCP congestion control algorithm.  It  */
+/*    implements the slow start and congestion avoidance window growth of */
+/*    RFC 5681 and halves the flight size on loss.  The fast recovery     */
+/*    window inflation and deflation of RFC 6582 is done by the TCP core. */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to TCP socket         */
+/*    event                                 Congestion control event      */
+/*    acked_bytes                           Bytes acknowledged by the ACK */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_socket_retransmit             Retransmit TCP packet         */
+/*    _nx_tcp_socket_send                   Send data packet              */
+/*    _nx_tcp_socket_state_ack_check        Process received ACK          */
+/*    _nx_tcp_socket_state_syn_received     Process SYN RECEIVED state    */
+/*    _nx_tcp_socket_state_syn_sent         Process SYN SENT state        */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_tcp_congestion_control_newreno(NX_TCP_SOCKET *socket_ptr, UINT event, ULONG acked_bytes)
+{
+
+ULONG window;
+
+
+    switch (event)
+    {
+
+    case NX_TCP_CONGESTION_CONTROL_ACK:
+    {
+
+        /* Adjust the transmit window.  In slow start phase, the transmit window is incremented for every ACK.
+           In Congestion Avoidance phase, the window is incremented for every RTT.  */
+        if (socket_ptr -> nx_tcp_socket_tx_window_congestion >= socket_ptr -> nx_tcp_socket_tx_slow_start_threshold)
+        {
+
+            /* In Congestion avoidance phase, for every ACK it receives, increase the window size using the
+               following approximation:
+               cwnd = cwnd + MSS * MSS / cwnd;
+             */
+            window =  socket_ptr -> nx_tcp_socket_connect_mss2 / socket_ptr -> nx_tcp_socket_tx_window_congestion;
+
+            /* If the above formula yields 0, the result SHOULD be rounded up to 1 byte.  */
+            if (window == 0)
+            {
+                window =  1;
+            }
+
+            socket_ptr -> nx_tcp_socket_tx_window_congestion =  socket_ptr -> nx_tcp_socket_tx_window_congestion + window;
+        }
+        else
+        {
+
+            /* cwnd += min (N, SMSS).
+               where N is the number of ACKed bytes. */
+            /* Section 3.1, Page 6, RFC5681. */
+            if (acked_bytes < socket_ptr -> nx_tcp_socket_connect_mss)
+            {
+                socket_ptr -> nx_tcp_socket_tx_window_congestion +=  acked_bytes;
+            }
+            else
+            {
+                socket_ptr -> nx_tcp_socket_tx_window_congestion +=  socket_ptr -> nx_tcp_socket_connect_mss;
+            }
+        }
+
+        break;
+    }
+
+    case NX_TCP_CONGESTION_CONTROL_LOSS:
+    case NX_TCP_CONGESTION_CONTROL_TIMEOUT:
+    {
+
+        /* Compute the flight size / 2 value. */
+        window =  socket_ptr -> nx_tcp_socket_tx_outstanding_bytes >> 1;
+
+        /* Make sure we have at least 2 * MSS */
+        if (window < (socket_ptr -> nx_tcp_socket_connect_mss << 1))
+        {
+            window =  socket_ptr -> nx_tcp_socket_connect_mss << 1;
+        }
+
+        /* Set the slow_start_threshold */
+        socket_ptr -> nx_tcp_socket_tx_slow_start_threshold =  window;
+
+        break;
+    }
+
+    default:
+
+        /* NewReno keeps no state of its own.  */
+        break;
+    }
+}
+
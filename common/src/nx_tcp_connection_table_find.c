@@ -0,0 +1,120 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+#include "nx_tcp.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_connection_table_find                       PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function finds the socket of an established TCP connection     */
+/*    from the local port, peer IP address and peer port of an incoming   */
+/*    segment. The connection table is hashed on all three values, so the */
+/*    lookup does not depend on how many connections share the same local */
+/*    port.                                                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                IP instance pointer           */
+/*    port                                  Local TCP port                */
+/*    peer_ip                               Peer IP address               */
+/*    peer_port                             Peer TCP port                 */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    socket_ptr                            Connected socket, or NX_NULL  */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_packet_process                Process incoming TCP packet   */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+NX_TCP_SOCKET  *_nx_tcp_connection_table_find(NX_IP *ip_ptr, UINT port, ULONG peer_ip, UINT peer_port)
+{
+
+ULONG          index;
+NX_TCP_SOCKET *socket_ptr;
+
+
+    /* Calculate the hash index in the TCP connection table of the IP instance.  */
+    index =  NX_TCP_CONNECTION_HASH(port, peer_ip, peer_port) & ip_ptr -> nx_ip_tcp_connection_table_mask;
+
+    /* Search the connected sockets in this index.  */
+    socket_ptr =  ip_ptr -> nx_ip_tcp_connection_table[index];
+
+    /* Determine if there are any connected sockets on this index.  */
+    if (socket_ptr)
+    {
+
+        /* Yes, loop to examine the list of connected sockets on this index.  */
+        do
+        {
+
+            /* Determine if the connection has been found.  */
+            if ((socket_ptr -> nx_tcp_socket_port == port) &&
+                (socket_ptr -> nx_tcp_socket_connect_ip == peer_ip) &&
+                (socket_ptr -> nx_tcp_socket_connect_port == peer_port))
+            {
+
+                /* Yes, move the head pointer to this socket so the next segment of the
+                   same connection is found first.  */
+                ip_ptr -> nx_ip_tcp_connection_table[index] =  socket_ptr;
+
+                /* Return the socket.  */
+                return(socket_ptr);
+            }
+
+            /* Move to the next entry in the connection index.  */
+            socket_ptr =  socket_ptr -> nx_tcp_socket_connection_next;
+        } while (socket_ptr != ip_ptr -> nx_ip_tcp_connection_table[index]);
+    }
+
+    /* No connection found.  */
+    return(NX_NULL);
+}
+
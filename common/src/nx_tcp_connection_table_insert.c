@@ -0,0 +1,122 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+#include "nx_tcp.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_connection_table_insert                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function places a socket whose peer IP address and peer port   */
+/*    have been set on the TCP connection table, so incoming segments of  */
+/*    the connection can be found.  If the socket is still on the table   */
+/*    from a previous connection, it is removed first.                    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                IP instance pointer           */
+/*    socket_ptr                            Pointer to TCP socket         */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_tcp_connection_table_remove       Remove previous connection    */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_client_socket_connect         Client connect service        */
+/*    _nx_tcp_connection_table_resize       Resize connection table       */
+/*    _nx_tcp_packet_process                Process incoming TCP packet   */
+/*    _nx_tcp_server_socket_relisten        Server relisten service       */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_tcp_connection_table_insert(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr)
+{
+
+ULONG index;
+
+
+    /* Determine if the socket is still on the table from a previous connection.  */
+    if (socket_ptr -> nx_tcp_socket_connection_next)
+    {
+
+        /* Yes, remove it first.  */
+        _nx_tcp_connection_table_remove(ip_ptr, socket_ptr);
+    }
+
+    /* Calculate the hash index in the TCP connection table of the IP instance.  */
+    index =  NX_TCP_CONNECTION_HASH(socket_ptr -> nx_tcp_socket_port, socket_ptr -> nx_tcp_socket_connect_ip,
+                                    socket_ptr -> nx_tcp_socket_connect_port) & ip_ptr -> nx_ip_tcp_connection_table_mask;
+
+    /* Remember the index, the connection fields may be cleared before the socket is removed.  */
+    socket_ptr -> nx_tcp_socket_connection_index =  index;
+
+    /* Determine if the list is NULL.  */
+    if (ip_ptr -> nx_ip_tcp_connection_table[index])
+    {
+
+        /* There are already sockets on this list... just add this one
+           to the end.  */
+        socket_ptr -> nx_tcp_socket_connection_next =
+            ip_ptr -> nx_ip_tcp_connection_table[index];
+        socket_ptr -> nx_tcp_socket_connection_previous =
+            (ip_ptr -> nx_ip_tcp_connection_table[index]) -> nx_tcp_socket_connection_previous;
+        ((ip_ptr -> nx_ip_tcp_connection_table[index]) -> nx_tcp_socket_connection_previous) -> nx_tcp_socket_connection_next =
+            socket_ptr;
+        (ip_ptr -> nx_ip_tcp_connection_table[index]) -> nx_tcp_socket_connection_previous =   socket_ptr;
+    }
+    else
+    {
+
+        /* Nothing is on the connection list.  Add this TCP socket to an
+           empty list.  */
+        socket_ptr -> nx_tcp_socket_connection_next =      socket_ptr;
+        socket_ptr -> nx_tcp_socket_connection_previous =  socket_ptr;
+        ip_ptr -> nx_ip_tcp_connection_table[index] =      socket_ptr;
+    }
+}
+
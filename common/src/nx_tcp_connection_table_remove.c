@@ -0,0 +1,122 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+#include "nx_tcp.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_connection_table_remove                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function removes a socket from the TCP connection table.  It   */
+/*    does nothing if the socket is not on the table.                     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                IP instance pointer           */
+/*    socket_ptr                            Pointer to TCP socket         */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_client_socket_connect         Client connect service        */
+/*    _nx_tcp_client_socket_unbind          Client unbind service         */
+/*    _nx_tcp_connection_table_insert       Insert into connection table  */
+/*    _nx_tcp_server_socket_unaccept        Server unaccept service       */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_tcp_connection_table_remove(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr)
+{
+
+ULONG index;
+
+
+    /* Determine if the socket is on the connection table.  */
+    if (socket_ptr -> nx_tcp_socket_connection_next == NX_NULL)
+    {
+
+        /* No, nothing to do.  */
+        return;
+    }
+
+    /* Pickup the index the socket was placed on.  */
+    index =  socket_ptr -> nx_tcp_socket_connection_index;
+
+    /* Determine if this is the only socket on the list.  */
+    if (socket_ptr == socket_ptr -> nx_tcp_socket_connection_next)
+    {
+
+        /* Yes, this is the only socket on the list.  Clear the list head pointer.  */
+        ip_ptr -> nx_ip_tcp_connection_table[index] =  NX_NULL;
+    }
+    else
+    {
+
+        /* Otherwise, there are multiple sockets on this list.  Remove just
+           this socket from the list.  */
+        (socket_ptr -> nx_tcp_socket_connection_previous) -> nx_tcp_socket_connection_next =
+            socket_ptr -> nx_tcp_socket_connection_next;
+        (socket_ptr -> nx_tcp_socket_connection_next) -> nx_tcp_socket_connection_previous =
+            socket_ptr -> nx_tcp_socket_connection_previous;
+
+        /* Determine if the head of the list needs to be updated.  */
+        if (ip_ptr -> nx_ip_tcp_connection_table[index] == socket_ptr)
+        {
+
+            /* Yes, update the head pointer.  */
+            ip_ptr -> nx_ip_tcp_connection_table[index] =  socket_ptr -> nx_tcp_socket_connection_next;
+        }
+    }
+
+    /* Clear the connection list pointers.  */
+    socket_ptr -> nx_tcp_socket_connection_next =      NX_NULL;
+    socket_ptr -> nx_tcp_socket_connection_previous =  NX_NULL;
+}
+
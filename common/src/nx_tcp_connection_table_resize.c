@@ -0,0 +1,143 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+#include "nx_tcp.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_connection_table_resize                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function replaces the hash table used to find the socket of an */
+/*    established TCP connection with the supplied memory.  The number of */
+/*    hash buckets is the largest power of two that fits in the memory.   */
+/*    Sockets already on the previous table are moved to the new one, so  */
+/*    the table can be resized while connections are active.  The memory  */
+/*    of the previous table is no longer used by NetX afterwards.         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                IP instance pointer           */
+/*    table_memory                          Start of table memory         */
+/*    table_size                            Size in bytes of table memory */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    tx_mutex_get                          Obtain protection mutex       */
+/*    tx_mutex_put                          Release protection mutex      */
+/*    _nx_tcp_connection_table_insert       Insert into connection table  */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_tcp_connection_table_resize(NX_IP *ip_ptr, VOID *table_memory, ULONG table_size)
+{
+
+ULONG          buckets;
+ULONG          i;
+ULONG          sockets_count;
+NX_TCP_SOCKET *socket_ptr;
+
+
+    /* Compute the number of hash buckets that fit in the supplied memory.  */
+    buckets =  table_size / sizeof(NX_TCP_SOCKET *);
+
+    /* Check for memory that does not hold a single bucket, since the mask below must not wrap.  */
+    if (buckets == 0)
+    {
+        return(NX_SIZE_ERROR);
+    }
+
+    /* Round down to a power of two by clearing the lowest set bit until one is left.  */
+    while (buckets & (buckets - 1))
+    {
+        buckets =  buckets & (buckets - 1);
+    }
+
+    /* Obtain the IP protection.  */
+    tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
+
+    /* Clear the new table.  */
+    for (i = 0; i < buckets; i++)
+    {
+        ((NX_TCP_SOCKET **)table_memory)[i] =  NX_NULL;
+    }
+
+    /* Setup the new table in the IP instance.  */
+    ip_ptr -> nx_ip_tcp_connection_table =       (NX_TCP_SOCKET **)table_memory;
+    ip_ptr -> nx_ip_tcp_connection_table_mask =  buckets - 1;
+
+    /* Loop through the created sockets to move the connected ones to the new table.  The
+       created list is used since the new memory may overlap the previous table.  */
+    socket_ptr =     ip_ptr -> nx_ip_tcp_created_sockets_ptr;
+    sockets_count =  ip_ptr -> nx_ip_tcp_created_sockets_count;
+    while (sockets_count--)
+    {
+
+        /* Determine if this socket was on the previous table.  */
+        if (socket_ptr -> nx_tcp_socket_connection_next)
+        {
+
+            /* Yes, forget the previous links and place it on the new table.  */
+            socket_ptr -> nx_tcp_socket_connection_next =      NX_NULL;
+            socket_ptr -> nx_tcp_socket_connection_previous =  NX_NULL;
+            _nx_tcp_connection_table_insert(ip_ptr, socket_ptr);
+        }
+
+        /* Move to the next created socket.  */
+        socket_ptr =  socket_ptr -> nx_tcp_socket_created_next;
+    }
+
+    /* Release the IP protection.  */
+    tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+    /* Return success.  */
+    return(NX_SUCCESS);
+}
+
@@ -68,6 +68,9 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            TCP connection table,       */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_tcp_enable(NX_IP *ip_ptr)
@@ -105,6 +108,10 @@ struct NX_TCP_LISTEN_STRUCT *listen_ptr;
     /* Make sure the last listen request has a NULL pointer.  */
     listen_ptr -> nx_tcp_listen_next =  NX_NULL;
 
+    /* Setup the default TCP connection table.  */
+    ip_ptr -> nx_ip_tcp_connection_table =       ip_ptr -> nx_ip_tcp_connection_table_default;
+    ip_ptr -> nx_ip_tcp_connection_table_mask =  NX_TCP_CONNECTION_TABLE_SIZE - 1;
+
     /* Set the TCP packet queue processing function.  */
     ip_ptr -> nx_ip_tcp_queue_process =  _nx_tcp_queue_process;
 
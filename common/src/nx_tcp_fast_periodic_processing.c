@@ -44,9 +44,12 @@
 /*  DESCRIPTION                                                           */
 /*                                                                        */
 /*    This function processes the fast periodic TCP processing for        */
-/*    sending delayed ACK messages for previous receive operations and    */
-/*    for re-transmitting packets that have not been ACKed by the other   */
-/*    side of the connection.                                             */
+/*    sending delayed ACK messages for previous receive operations, for   */
+/*    re-transmitting packets that have not been ACKed by the other       */
+/*    side of the connection and for keepalive probes.  Only the sockets  */
+/*    on the current slot of the TCP timer wheel are visited; sockets     */
+/*    with a timer still running are placed on the slot of their next    */
+/*    expiration.                                                         */
 /*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
@@ -59,9 +62,12 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _nx_tcp_packet_send_ack               Send a delayed ACK            */
+/*    _nx_tcp_packet_send_fin               Send FIN again                */
 /*    _nx_tcp_packet_send_syn               Send initial SYN again        */
 /*    _nx_tcp_socket_connection_reset       Reset connection on timeout   */
 /*    _nx_tcp_socket_retransmit             Retransmit packet             */
+/*    _nx_tcp_timer_wheel_insert            Insert into timer wheel       */
+/*    _nx_tcp_timer_wheel_remove            Remove from timer wheel       */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -74,40 +80,57 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            processed sockets from the  */
+/*                                            TCP timer wheel, added SACK */
+/*                                            scoreboard reset, resulting */
+/*                                            in version 6.x              */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_tcp_fast_periodic_processing(NX_IP *ip_ptr)
 {
 
 NX_TCP_SOCKET *socket_ptr;
-ULONG          sockets;
+ULONG          index;
+ULONG          elapsed;
+ULONG          next;
+ULONG          ticks;
 ULONG          timer_rate;
+#ifdef NX_ENABLE_TCP_KEEPALIVE
+ULONG          seconds;
+#endif /* NX_ENABLE_TCP_KEEPALIVE */
 
 
     /* Pickup this timer's periodic rate.  */
     timer_rate =  _nx_tcp_fast_timer_rate;
 
-    /* Pickup the number of created TCP sockets.  */
-    sockets =  ip_ptr -> nx_ip_tcp_created_sockets_count;
+    /* Advance the TCP timer wheel by one tick.  */
+    ip_ptr -> nx_ip_tcp_timer_tick++;
 
-    /* Pickup the first socket.  */
-    socket_ptr =  ip_ptr -> nx_ip_tcp_created_sockets_ptr;
+    /* Calculate the slot of the timer wheel for this tick.  */
+    index =  ip_ptr -> nx_ip_tcp_timer_tick & NX_TCP_TIMER_WHEEL_MASK;
 
-    /* Loop through the created sockets.  */
-    while (sockets--)
+    /* Loop through the sockets due on this tick.  Each socket is removed before it is
+       processed and placed on a later slot if it still has a timer running, so the
+       loop ends once the slot is empty.  */
+    while (ip_ptr -> nx_ip_tcp_timer_wheel[index])
     {
 
+        /* Pickup the first socket on this slot and remove it from the wheel.  */
+        socket_ptr =  ip_ptr -> nx_ip_tcp_timer_wheel[index];
+        _nx_tcp_timer_wheel_remove(ip_ptr, socket_ptr);
 
+        /* Compute the time elapsed since the timers of this socket were last aged.  */
+        elapsed =  (ip_ptr -> nx_ip_tcp_timer_tick - socket_ptr -> nx_tcp_socket_timer_tick) * timer_rate;
+        socket_ptr -> nx_tcp_socket_timer_tick =  ip_ptr -> nx_ip_tcp_timer_tick;
 
         /* Determine if the socket is in an established or disconnect state and has delayed sending an ACK
            from a previous receive packet event.  */
-        if ((socket_ptr -> nx_tcp_socket_state >= NX_TCP_ESTABLISHED) &&
-            ((socket_ptr -> nx_tcp_socket_rx_sequence != socket_ptr -> nx_tcp_socket_rx_sequence_acked) ||
-             (socket_ptr -> nx_tcp_socket_rx_window_last_sent < socket_ptr -> nx_tcp_socket_rx_window_current)))
+        if (NX_TCP_DELAYED_ACK_ACTIVE(socket_ptr))
         {
 
             /* Determine if the ACK has expired.  */
-            if (socket_ptr -> nx_tcp_socket_delayed_ack_timeout <= timer_rate)
+            if (socket_ptr -> nx_tcp_socket_delayed_ack_timeout <= elapsed)
             {
 
                 /* Send the delayed ACK, which also resets the ACK timeout.  */
@@ -118,7 +141,7 @@ ULONG          timer_rate;
 
                 /* No, it hasn't expired yet.  Just decrement it for now.  */
                 socket_ptr -> nx_tcp_socket_delayed_ack_timeout =
-                    socket_ptr -> nx_tcp_socket_delayed_ack_timeout - timer_rate;
+                    socket_ptr -> nx_tcp_socket_delayed_ack_timeout - elapsed;
             }
         }
 
@@ -128,11 +151,11 @@ ULONG          timer_rate;
         {
 
             /* Yes, a timeout is active.  Determine if it has expired.  */
-            if (socket_ptr -> nx_tcp_socket_timeout > timer_rate)
+            if (socket_ptr -> nx_tcp_socket_timeout > elapsed)
             {
 
                 /* No, it hasn't expired yet.  Just decrement the timeout value.  */
-                socket_ptr -> nx_tcp_socket_timeout =  socket_ptr -> nx_tcp_socket_timeout - timer_rate;
+                socket_ptr -> nx_tcp_socket_timeout =  socket_ptr -> nx_tcp_socket_timeout - elapsed;
             }
             else if (socket_ptr -> nx_tcp_socket_timeout_retries >= socket_ptr -> nx_tcp_socket_timeout_max_retries)
             {
@@ -167,6 +190,12 @@ ULONG          timer_rate;
                 /* Update the transmit sequence that entered fast transmit. */
                 socket_ptr -> nx_tcp_socket_tx_sequence_recover = socket_ptr -> nx_tcp_socket_tx_sequence - 1;
 
+#ifdef NX_ENABLE_TCP_SACK
+                /* The peer may have discarded data it acknowledged selectively, so forget
+                   the SACK scoreboard after a timeout.  RFC 2018, Section 8.  */
+                socket_ptr -> nx_tcp_socket_sack_count =  0;
+#endif /* NX_ENABLE_TCP_SACK */
+
                 /* Retransmit the packet. */
                 _nx_tcp_socket_retransmit(ip_ptr, socket_ptr, NX_FALSE);
 
@@ -195,8 +224,95 @@ ULONG          timer_rate;
             }
         }
 
-        /* Move to the next TCP socket.  */
-        socket_ptr =  socket_ptr -> nx_tcp_socket_created_next;
+#ifdef NX_ENABLE_TCP_KEEPALIVE
+
+        /* Check for the socket having a TCP Keepalive timer active.  */
+        if (NX_TCP_KEEPALIVE_ACTIVE(socket_ptr))
+        {
+
+            /* Convert the elapsed time to whole seconds of the keepalive timer.  */
+            socket_ptr -> nx_tcp_socket_keepalive_ticks =  socket_ptr -> nx_tcp_socket_keepalive_ticks + elapsed;
+            seconds =  socket_ptr -> nx_tcp_socket_keepalive_ticks / NX_IP_PERIODIC_RATE;
+            socket_ptr -> nx_tcp_socket_keepalive_ticks =  socket_ptr -> nx_tcp_socket_keepalive_ticks - (seconds * NX_IP_PERIODIC_RATE);
+
+            /* Determine if the keepalive timeout has expired.  */
+            if (socket_ptr -> nx_tcp_socket_keepalive_timeout > seconds)
+            {
+
+                /* No, just decrement the socket's keepalive timeout timer.  */
+                socket_ptr -> nx_tcp_socket_keepalive_timeout =  socket_ptr -> nx_tcp_socket_keepalive_timeout - seconds;
+            }
+            else
+            {
+
+                /* Yes, the timeout has expired.  Increment the retries and
+                   determine if there are any retries left.  */
+                socket_ptr -> nx_tcp_socket_keepalive_retries++;
+                if (socket_ptr -> nx_tcp_socket_keepalive_retries < NX_TCP_KEEPALIVE_RETRIES)
+                {
+
+                    /* Yes, there are more retries left.  Set the next timeout expiration
+                       to the retry time instead of the initial time.  */
+                    socket_ptr -> nx_tcp_socket_keepalive_timeout =  NX_TCP_KEEPALIVE_RETRY;
+
+                    /* Send Keepalive ACK probe to see if the other side of the connection
+                       is still there.  We need to decrement the ACK number first for the
+                       probe message and then restore the value immediately after the ACK
+                       is sent.  */
+                    _nx_tcp_packet_send_ack(socket_ptr, (socket_ptr -> nx_tcp_socket_tx_sequence - 1));
+                }
+                else
+                {
+
+                    /* The Keepalive timer retries have failed, enter a CLOSED state
+                       via the reset processing.  */
+                    _nx_tcp_socket_connection_reset(socket_ptr);
+                }
+            }
+        }
+#endif /* NX_ENABLE_TCP_KEEPALIVE */
+
+        /* Compute the number of ticks until the earliest running timer of this socket expires.
+           Zero means no timer is running.  */
+        next =  0;
+
+        /* Check the delayed ACK timer.  */
+        if (NX_TCP_DELAYED_ACK_ACTIVE(socket_ptr))
+        {
+            next =  (socket_ptr -> nx_tcp_socket_delayed_ack_timeout + timer_rate - 1) / timer_rate;
+        }
+
+        /* Check the transmit timer.  */
+        if (socket_ptr -> nx_tcp_socket_timeout)
+        {
+            ticks =  (socket_ptr -> nx_tcp_socket_timeout + timer_rate - 1) / timer_rate;
+            if ((next == 0) || (ticks < next))
+            {
+                next =  ticks;
+            }
+        }
+
+#ifdef NX_ENABLE_TCP_KEEPALIVE
+
+        /* Check the keepalive timer.  */
+        if (NX_TCP_KEEPALIVE_ACTIVE(socket_ptr))
+        {
+            ticks =  ((socket_ptr -> nx_tcp_socket_keepalive_timeout * NX_IP_PERIODIC_RATE) -
+                      socket_ptr -> nx_tcp_socket_keepalive_ticks + timer_rate - 1) / timer_rate;
+            if ((next == 0) || (ticks < next))
+            {
+                next =  ticks;
+            }
+        }
+#endif /* NX_ENABLE_TCP_KEEPALIVE */
+
+        /* Determine if the socket has a running timer.  */
+        if (next)
+        {
+
+            /* Yes, place the socket on the slot of its next expiration.  */
+            _nx_tcp_timer_wheel_insert(ip_ptr, socket_ptr, next);
+        }
     }
 }
 
@@ -0,0 +1,315 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_tcp.h"
+#include "nx_packet.h"
+
+
+#ifdef NX_ENABLE_TCP_GRO
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_gro_segment_check                           PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function determines if a received TCP segment can be coalesced */
+/*    with other segments of its connection, that is if it carries data,  */
+/*    has a header without options that is held in the first packet of    */
+/*    the chain, and has no control bits other than ACK and PSH. The TCP  */
+/*    checksum of such a segment is verified here, and the segment is     */
+/*    marked so that TCP packet processing does not verify it again.      */
+/*    Segments with an invalid checksum are left to the regular           */
+/*    processing, which counts and drops them.                            */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    packet_ptr                            Pointer to received segment   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    data_length                           Length of the segment data,   */
+/*                                            zero if the segment can not */
+/*                                            be coalesced                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_tcp_checksum                      Verify TCP checksum           */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_gro_merge                     Coalesce TCP segments         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+static ULONG  _nx_tcp_gro_segment_check(NX_PACKET *packet_ptr)
+{
+
+NX_TCP_HEADER *tcp_header_ptr;
+ULONG          header_word_3;
+#ifndef NX_DISABLE_TCP_RX_CHECKSUM
+ULONG         *ip_header_ptr;
+#endif /* NX_DISABLE_TCP_RX_CHECKSUM */
+
+
+    /* Determine if the TCP header is held in the first packet of the chain.  */
+    if ((ULONG)(packet_ptr -> nx_packet_append_ptr - packet_ptr -> nx_packet_prepend_ptr) < sizeof(NX_TCP_HEADER))
+    {
+        return(0);
+    }
+
+    /* Pickup the word of the TCP header with the header length and control bits.  The header is
+       still in network byte order.  */
+    tcp_header_ptr =  (NX_TCP_HEADER *)packet_ptr -> nx_packet_prepend_ptr;
+    header_word_3 =   tcp_header_ptr -> nx_tcp_header_word_3;
+    NX_CHANGE_ULONG_ENDIAN(header_word_3);
+
+    /* Only data segments without options and without control bits other than ACK and PSH
+       are coalesced.  */
+    if (((header_word_3 & ~(NX_TCP_PSH_BIT | NX_LOWER_16_MASK)) != (NX_TCP_HEADER_SIZE | NX_TCP_ACK_BIT)) ||
+        (packet_ptr -> nx_packet_length <= sizeof(NX_TCP_HEADER)))
+    {
+        return(0);
+    }
+
+#ifndef NX_DISABLE_TCP_RX_CHECKSUM
+
+    /* Determine if the interface has already verified the TCP checksum.  */
+    if (!((packet_ptr -> nx_packet_ip_interface -> nx_interface_capability_flag |
+           packet_ptr -> nx_packet_interface_capability_flag) & NX_INTERFACE_CAPABILITY_TCP_RX_CHECKSUM))
+    {
+
+        /* Pickup the pointer to the source IP address in front of the TCP header.  */
+        ip_header_ptr =  (ULONG *)packet_ptr -> nx_packet_prepend_ptr;
+
+        /* Verify the checksum.  */
+        if (_nx_tcp_checksum(packet_ptr, *(ip_header_ptr - 2), packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_address))
+        {
+
+            /* Leave the segment to the regular processing.  */
+            return(0);
+        }
+
+        /* Mark the TCP checksum of the segment as verified.  */
+        packet_ptr -> nx_packet_interface_capability_flag |=  NX_INTERFACE_CAPABILITY_TCP_RX_CHECKSUM;
+    }
+#endif /* NX_DISABLE_TCP_RX_CHECKSUM */
+
+    /* Return the length of the segment data.  */
+    return(packet_ptr -> nx_packet_length - (ULONG)sizeof(NX_TCP_HEADER));
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_gro_merge                                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function coalesces the TCP segments at the head of the TCP     */
+/*    queue that directly follow a received segment of the same           */
+/*    connection into that segment. The data of each following segment is */
+/*    linked to the end of the packet chain of the segment, and its       */
+/*    acknowledgment number, window and PSH bit replace those of the      */
+/*    segment, so that the socket processes the data of all segments at   */
+/*    once and acknowledges it with one ACK. Coalescing stops at the      */
+/*    first segment that belongs to another connection, is out of order,  */
+/*    acknowledges less, or carries control bits or options, and after    */
+/*    NX_TCP_GRO_MAXIMUM_SEGMENTS segments.                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                Pointer to IP control block   */
+/*    packet_ptr                            Pointer to received segment   */
+/*    queue_head                            Pointer to the segments that  */
+/*                                            follow it in the TCP queue  */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    queue_head                            Pointer to the segments that  */
+/*                                            were not coalesced          */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_tcp_gro_segment_check             Check TCP segment             */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_queue_process                 Process TCP packet queue      */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+NX_PACKET  *_nx_tcp_gro_merge(NX_IP *ip_ptr, NX_PACKET *packet_ptr, NX_PACKET *queue_head)
+{
+
+ULONG          data_length;
+ULONG          segments;
+ULONG          next_sequence;
+ULONG          acknowledgment;
+ULONG          sequence;
+ULONG          next_acknowledgment;
+ULONG         *ip_header_ptr;
+ULONG         *next_ip_header_ptr;
+NX_TCP_HEADER *tcp_header_ptr;
+NX_TCP_HEADER *next_header_ptr;
+NX_PACKET     *next_packet_ptr;
+NX_PACKET     *last_packet_ptr;
+
+
+    /* Determine if the segment can be coalesced.  */
+    data_length =  _nx_tcp_gro_segment_check(packet_ptr);
+    if (data_length == 0)
+    {
+
+        /* No, leave the queue unchanged.  */
+        return(queue_head);
+    }
+
+    /* Setup pointers to the addresses and the TCP header of the segment.  */
+    ip_header_ptr =   (ULONG *)packet_ptr -> nx_packet_prepend_ptr;
+    tcp_header_ptr =  (NX_TCP_HEADER *)packet_ptr -> nx_packet_prepend_ptr;
+
+    /* Compute the sequence number that follows the data of the segment.  */
+    next_sequence =  tcp_header_ptr -> nx_tcp_sequence_number;
+    NX_CHANGE_ULONG_ENDIAN(next_sequence);
+    next_sequence +=  data_length;
+
+    /* Pickup the acknowledgment number of the segment.  */
+    acknowledgment =  tcp_header_ptr -> nx_tcp_acknowledgment_number;
+    NX_CHANGE_ULONG_ENDIAN(acknowledgment);
+
+    /* Find the last packet of the chain.  */
+    last_packet_ptr =  packet_ptr;
+    while (last_packet_ptr -> nx_packet_next)
+    {
+        last_packet_ptr =  last_packet_ptr -> nx_packet_next;
+    }
+
+    /* Loop to coalesce the segments that follow.  */
+    for (segments = 1; (queue_head) && (segments < NX_TCP_GRO_MAXIMUM_SEGMENTS); segments++)
+    {
+
+        /* Pickup the next segment in the queue.  */
+        next_packet_ptr =  queue_head;
+
+        /* Determine if the next segment can be coalesced.  */
+        data_length =  _nx_tcp_gro_segment_check(next_packet_ptr);
+        if (data_length == 0)
+        {
+            break;
+        }
+
+        /* Setup pointers to the addresses and the TCP header of the next segment.  */
+        next_ip_header_ptr =  (ULONG *)next_packet_ptr -> nx_packet_prepend_ptr;
+        next_header_ptr =     (NX_TCP_HEADER *)next_packet_ptr -> nx_packet_prepend_ptr;
+
+        /* Determine if the next segment belongs to the same connection.  */
+        if ((next_packet_ptr -> nx_packet_ip_interface != packet_ptr -> nx_packet_ip_interface) ||
+            (*(next_ip_header_ptr - 2) != *(ip_header_ptr - 2)) ||
+            (*(next_ip_header_ptr - 1) != *(ip_header_ptr - 1)) ||
+            (next_header_ptr -> nx_tcp_header_word_0 != tcp_header_ptr -> nx_tcp_header_word_0))
+        {
+            break;
+        }
+
+        /* Pickup the sequence and acknowledgment numbers of the next segment.  */
+        sequence =             next_header_ptr -> nx_tcp_sequence_number;
+        next_acknowledgment =  next_header_ptr -> nx_tcp_acknowledgment_number;
+        NX_CHANGE_ULONG_ENDIAN(sequence);
+        NX_CHANGE_ULONG_ENDIAN(next_acknowledgment);
+
+        /* Determine if the next segment directly follows the data and acknowledges no less.  */
+        if ((sequence != next_sequence) || ((INT)(next_acknowledgment - acknowledgment) < 0))
+        {
+            break;
+        }
+
+        /* Remove the next segment from the queue.  */
+        queue_head =  next_packet_ptr -> nx_packet_queue_next;
+        next_packet_ptr -> nx_packet_queue_next =  NX_NULL;
+
+        /* Take over the acknowledgment number, window and PSH bit of the next segment.  */
+        tcp_header_ptr -> nx_tcp_acknowledgment_number =  next_header_ptr -> nx_tcp_acknowledgment_number;
+        tcp_header_ptr -> nx_tcp_header_word_3 =          next_header_ptr -> nx_tcp_header_word_3;
+
+        /* Remove the TCP header of the next segment and link its data to the end of the chain.  */
+        next_packet_ptr -> nx_packet_prepend_ptr +=  sizeof(NX_TCP_HEADER);
+        last_packet_ptr -> nx_packet_next =          next_packet_ptr;
+        packet_ptr -> nx_packet_length +=            data_length;
+
+        /* Find the new last packet of the chain.  */
+        last_packet_ptr =  next_packet_ptr;
+        while (last_packet_ptr -> nx_packet_next)
+        {
+            last_packet_ptr =  last_packet_ptr -> nx_packet_next;
+        }
+
+        /* Advance the expected sequence number and the acknowledgment number.  */
+        next_sequence +=  data_length;
+        acknowledgment =  next_acknowledgment;
+
+#ifndef NX_DISABLE_TCP_INFO
+
+        /* Increment the count of coalesced segments.  */
+        ip_ptr -> nx_ip_tcp_gro_segments_merged++;
+#endif /* NX_DISABLE_TCP_INFO */
+    }
+
+    /* Update the last packet of the chain.  */
+    if (last_packet_ptr != packet_ptr)
+    {
+        packet_ptr -> nx_packet_last =  last_packet_ptr;
+    }
+
+    /* Return the segments that were not coalesced.  */
+    return(queue_head);
+}
+#endif /* NX_ENABLE_TCP_GRO */
+
@@ -0,0 +1,112 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_tcp.h"
+
+
+#ifdef NX_ENABLE_TCP_LISTEN_POOL
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_listen_pool_arm                             PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function makes the next idle socket of the pool of the         */
+/*    specified listen request its listen socket, if the listen request   */
+/*    has none.  The socket is accepted without waiting, so the SYN+ACK   */
+/*    is sent as soon as a connection request arrives.  Queued connection */
+/*    requests are each given an idle socket in the same way.  This       */
+/*    function must be called with the IP protection held.                */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                Pointer to IP instance        */
+/*    listen_ptr                            Pointer to listen request     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_tcp_server_socket_accept          Accept the connection         */
+/*    _nx_tcp_server_socket_relisten        Make socket the listen socket */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_listen_pool_recycle           Return socket to pool         */
+/*    _nx_tcp_listen_pool_remove            Remove socket from pool       */
+/*    _nx_tcp_packet_process                Process TCP packet            */
+/*    _nx_tcp_server_socket_pool_add        Add socket to listen pool     */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_tcp_listen_pool_arm(NX_IP *ip_ptr, struct NX_TCP_LISTEN_STRUCT *listen_ptr)
+{
+
+NX_TCP_SOCKET *socket_ptr;
+
+
+    /* Loop while the listen request has no listen socket and idle sockets are available.  */
+    while ((listen_ptr -> nx_tcp_listen_socket_ptr == NX_NULL) && (listen_ptr -> nx_tcp_listen_pool_head))
+    {
+
+        /* Remove the first idle socket from the pool.  */
+        socket_ptr =  listen_ptr -> nx_tcp_listen_pool_head;
+        listen_ptr -> nx_tcp_listen_pool_head =  socket_ptr -> nx_tcp_socket_listen_pool_next;
+        listen_ptr -> nx_tcp_listen_pool_count--;
+        socket_ptr -> nx_tcp_socket_listen_pool_next =  NX_NULL;
+
+        /* Make the socket the listen socket.  If connection requests are queued, the socket
+           takes the oldest one instead and the next idle socket is tried for the others.  */
+        if (_nx_tcp_server_socket_relisten(ip_ptr, listen_ptr -> nx_tcp_listen_port, socket_ptr) == NX_INVALID_RELISTEN)
+        {
+
+            /* The listen request no longer takes sockets, leave the socket to the application.  */
+            socket_ptr -> nx_tcp_socket_listen_pool =  NX_NULL;
+            continue;
+        }
+
+        /* Accept the connection without waiting.  */
+        _nx_tcp_server_socket_accept(socket_ptr, NX_NO_WAIT);
+    }
+}
+#endif /* NX_ENABLE_TCP_LISTEN_POOL */
+
@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_tcp.h"
+
+
+#ifdef NX_ENABLE_TCP_LISTEN_POOL
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_listen_pool_recycle                         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns a pooled socket whose connection request      */
+/*    failed before the connection was established to the idle pool of    */
+/*    its listen request.  If the listen request is gone, the socket is   */
+/*    left closed and unbound for the application.  This function must be */
+/*    called with the IP protection held.                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to socket             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_tcp_listen_pool_arm               Arm next pooled socket        */
+/*    _nx_tcp_server_socket_unaccept        Unaccept server socket        */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_socket_connection_reset       Reset connection              */
+/*    _nx_tcp_socket_state_syn_received     Process SYN RECEIVED state    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_tcp_listen_pool_recycle(NX_TCP_SOCKET *socket_ptr)
+{
+
+struct NX_TCP_LISTEN_STRUCT *listen_ptr;
+NX_IP                       *ip_ptr;
+UINT                         port;
+
+
+    /* Pickup the IP and the port of the socket before it is unbound.  */
+    ip_ptr =  socket_ptr -> nx_tcp_socket_ip_ptr;
+    port =    socket_ptr -> nx_tcp_socket_port;
+
+    /* Remove the socket from the port so it can listen again.  */
+    _nx_tcp_server_socket_unaccept(socket_ptr);
+
+    /* Search for the listen request on the same port.  */
+    listen_ptr =  ip_ptr -> nx_ip_tcp_listen_table[NX_TCP_LISTEN_HASH(port)];
+    while ((listen_ptr) && (listen_ptr -> nx_tcp_listen_port != port))
+    {
+
+        /* Move to the next listen request on the same hashed port index.  */
+        listen_ptr =  listen_ptr -> nx_tcp_listen_hash_next;
+    }
+
+    /* Determine if the socket still belongs to this listen request.  */
+    if ((listen_ptr == NX_NULL) || (listen_ptr != socket_ptr -> nx_tcp_socket_listen_pool))
+    {
+
+        /* No, the pool is gone.  Leave the socket to the application.  */
+        socket_ptr -> nx_tcp_socket_listen_pool =  NX_NULL;
+        return;
+    }
+
+    /* Place the socket back at the front of the idle pool.  */
+    socket_ptr -> nx_tcp_socket_listen_pool_next =  listen_ptr -> nx_tcp_listen_pool_head;
+    listen_ptr -> nx_tcp_listen_pool_head =  socket_ptr;
+    listen_ptr -> nx_tcp_listen_pool_count++;
+
+    /* Make sure the listen request has a listen socket.  */
+    _nx_tcp_listen_pool_arm(ip_ptr, listen_ptr);
+}
+#endif /* NX_ENABLE_TCP_LISTEN_POOL */
+
@@ -0,0 +1,158 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_tcp.h"
+
+
+#ifdef NX_ENABLE_TCP_LISTEN_POOL
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_listen_pool_remove                          PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function takes a pooled socket out of its listen pool.  The    */
+/*    socket is unlinked from the idle pool or from the accept queue, or, */
+/*    if it is the listen socket, the next idle socket takes its place.   */
+/*    A socket that is still connecting is left in the pool, so it can    */
+/*    be recycled when its connection request fails.  This function must  */
+/*    be called with the IP protection held.                              */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to socket             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_tcp_listen_pool_arm               Arm next pooled socket        */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_server_socket_unaccept        Unaccept server socket        */
+/*    _nx_tcp_socket_connection_reset       Reset connection              */
+/*    _nx_tcp_socket_delete                 Delete TCP socket             */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_tcp_listen_pool_remove(NX_TCP_SOCKET *socket_ptr)
+{
+
+struct NX_TCP_LISTEN_STRUCT *listen_ptr;
+NX_TCP_SOCKET              **link_ptr;
+NX_TCP_SOCKET               *previous_ptr;
+
+
+    /* Pickup the listen request of the pool.  */
+    listen_ptr =  socket_ptr -> nx_tcp_socket_listen_pool;
+    if (listen_ptr == NX_NULL)
+    {
+        return;
+    }
+
+    /* Search the idle pool for the socket.  */
+    link_ptr =  &(listen_ptr -> nx_tcp_listen_pool_head);
+    while ((*link_ptr) && (*link_ptr != socket_ptr))
+    {
+
+        /* Move to the next idle socket.  */
+        link_ptr =  &((*link_ptr) -> nx_tcp_socket_listen_pool_next);
+    }
+
+    /* Determine if the socket is idle.  */
+    if (*link_ptr)
+    {
+
+        /* Yes, remove it from the idle pool.  */
+        *link_ptr =  socket_ptr -> nx_tcp_socket_listen_pool_next;
+        listen_ptr -> nx_tcp_listen_pool_count--;
+    }
+    else
+    {
+
+        /* Search the accept queue for the socket.  */
+        previous_ptr =  NX_NULL;
+        link_ptr =  &(listen_ptr -> nx_tcp_listen_accept_head);
+        while ((*link_ptr) && (*link_ptr != socket_ptr))
+        {
+
+            /* Move to the next established socket.  */
+            previous_ptr =  *link_ptr;
+            link_ptr =  &((*link_ptr) -> nx_tcp_socket_listen_pool_next);
+        }
+
+        /* Determine if the socket is waiting to be accepted.  */
+        if (*link_ptr)
+        {
+
+            /* Yes, remove it from the accept queue.  */
+            *link_ptr =  socket_ptr -> nx_tcp_socket_listen_pool_next;
+            if (listen_ptr -> nx_tcp_listen_accept_tail == socket_ptr)
+            {
+                listen_ptr -> nx_tcp_listen_accept_tail =  previous_ptr;
+            }
+            listen_ptr -> nx_tcp_listen_accept_count--;
+        }
+        else if (listen_ptr -> nx_tcp_listen_socket_ptr == socket_ptr)
+        {
+
+            /* The socket is the listen socket, give its place to the next idle socket.  */
+            listen_ptr -> nx_tcp_listen_socket_ptr =  NX_NULL;
+            socket_ptr -> nx_tcp_socket_listen_pool =  NX_NULL;
+            _nx_tcp_listen_pool_arm(socket_ptr -> nx_tcp_socket_ip_ptr, listen_ptr);
+            return;
+        }
+        else
+        {
+
+            /* The socket is still connecting, leave it in the pool.  */
+            return;
+        }
+    }
+
+    /* The socket no longer belongs to the pool.  */
+    socket_ptr -> nx_tcp_socket_listen_pool =       NX_NULL;
+    socket_ptr -> nx_tcp_socket_listen_pool_next =  NX_NULL;
+}
+#endif /* NX_ENABLE_TCP_LISTEN_POOL */
+
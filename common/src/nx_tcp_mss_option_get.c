@@ -72,6 +72,9 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            SACK option parsing,        */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_tcp_mss_option_get(UCHAR *option_ptr, ULONG option_area_size, ULONG *mss)
@@ -249,3 +252,189 @@ ULONG option_length;
 }
 #endif /* NX_ENABLE_TCP_WINDOW_SCALING */
 
+
+#ifdef NX_ENABLE_TCP_SACK
+
+UINT  _nx_tcp_sack_permitted_option_get(UCHAR *option_ptr, ULONG option_area_size, UINT *sack_permitted)
+{
+
+ULONG option_length;
+
+
+    /* Clear the flag, in case the SYN message does not offer SACK.  */
+    *sack_permitted =  NX_FALSE;
+
+    /* Loop through the option area looking for the SACK permitted option.  */
+    while (option_area_size >= 2)
+    {
+
+        /* Is the current character the SACK permitted type?  */
+        if (*option_ptr == NX_TCP_SACK_PERMITTED_KIND)
+        {
+
+            /* Yes, we found it!  Check the option length, if option length is not
+               equal to 2, return NX_FALSE.  */
+            if (*(option_ptr + 1) != 2)
+            {
+                return(NX_FALSE);
+            }
+
+            /* The peer accepts selective acknowledgments.  */
+            *sack_permitted =  NX_TRUE;
+
+            break;
+        }
+
+        /* Otherwise, process relative to the option type.  */
+
+        /* Check for end of list.  */
+        if (*option_ptr == NX_TCP_EOL_KIND)
+        {
+
+            /* Yes, end of list, get out!  */
+            break;
+        }
+
+        /* Check for NOP.  */
+        if (*option_ptr == NX_TCP_NOP_KIND)
+        {
+            /* One character option!  Skip this option and move to the next entry. */
+            option_ptr++;
+
+            option_area_size--;
+        }
+        else
+        {
+
+            /* Derive the option length.  */
+            option_length = *(option_ptr + 1);
+
+            /* Return when option length is invalid. */
+            if (option_length == 0)
+            {
+                return(NX_FALSE);
+            }
+
+            /* Move the option pointer forward.  */
+            option_ptr =  option_ptr + option_length;
+
+            /* Determine if this is greater than the option area size.  */
+            if (option_length > option_area_size)
+            {
+                option_area_size =  0;
+            }
+            else
+            {
+                option_area_size =  option_area_size - option_length;
+            }
+        }
+    }
+
+    /* Return.  */
+    return(NX_TRUE);
+}
+
+
+UINT  _nx_tcp_sack_option_get(UCHAR *option_ptr, ULONG option_area_size, NX_TCP_SACK_BLOCK *block_ptr, UINT *block_count)
+{
+
+ULONG option_length;
+UINT  i;
+
+
+    /* Initialize the number of blocks found.  */
+    *block_count =  0;
+
+    /* Loop through the option area looking for the SACK option.  */
+    while (option_area_size >= 2)
+    {
+
+        /* Is the current character the SACK type?  */
+        if (*option_ptr == NX_TCP_SACK_KIND)
+        {
+
+            /* Yes, we found it!  */
+
+            /* Pickup the option length.  */
+            option_length =  *(option_ptr + 1);
+
+            /* Check the option length, it must hold whole blocks of two sequence numbers and fit
+               in the option area.  */
+            if ((option_length < 10) || (((option_length - 2) & 7) != 0) || (option_length > option_area_size))
+            {
+                return(NX_FALSE);
+            }
+
+            /* Move the pointer to the first block.  */
+            option_ptr =  option_ptr + 2;
+
+            /* Loop to pickup the blocks.  */
+            for (i = 0; (i < ((option_length - 2) >> 3)) && (i < NX_TCP_SACK_BLOCKS_MAXIMUM); i++)
+            {
+
+                /* Build the begin and end sequence numbers, which are in network byte order.  */
+                block_ptr -> nx_tcp_sack_block_begin =  ((ULONG)option_ptr[0] << 24) | ((ULONG)option_ptr[1] << 16) |
+                                                        ((ULONG)option_ptr[2] << 8) | (ULONG)option_ptr[3];
+                block_ptr -> nx_tcp_sack_block_end =    ((ULONG)option_ptr[4] << 24) | ((ULONG)option_ptr[5] << 16) |
+                                                        ((ULONG)option_ptr[6] << 8) | (ULONG)option_ptr[7];
+
+                /* Move to the next block.  */
+                option_ptr =  option_ptr + 8;
+                block_ptr++;
+            }
+
+            /* Return the number of blocks.  */
+            *block_count =  i;
+
+            break;
+        }
+
+        /* Otherwise, process relative to the option type.  */
+
+        /* Check for end of list.  */
+        if (*option_ptr == NX_TCP_EOL_KIND)
+        {
+
+            /* Yes, end of list, get out!  */
+            break;
+        }
+
+        /* Check for NOP.  */
+        if (*option_ptr == NX_TCP_NOP_KIND)
+        {
+            /* One character option!  Skip this option and move to the next entry. */
+            option_ptr++;
+
+            option_area_size--;
+        }
+        else
+        {
+
+            /* Derive the option length.  */
+            option_length = *(option_ptr + 1);
+
+            /* Return when option length is invalid. */
+            if (option_length == 0)
+            {
+                return(NX_FALSE);
+            }
+
+            /* Move the option pointer forward.  */
+            option_ptr =  option_ptr + option_length;
+
+            /* Determine if this is greater than the option area size.  */
+            if (option_length > option_area_size)
+            {
+                option_area_size =  0;
+            }
+            else
+            {
+                option_area_size =  option_area_size - option_length;
+            }
+        }
+    }
+
+    /* Return.  */
+    return(NX_TRUE);
+}
+#endif /* NX_ENABLE_TCP_SACK */
@@ -64,11 +64,16 @@
 /*                                                                        */
 /*    _nx_packet_release                    Packet release function       */
 /*    _nx_tcp_checksum                      Calculate TCP packet checksum */
+/*    _nx_tcp_connection_table_find         Find connected socket         */
+/*    _nx_tcp_connection_table_insert       Insert into connection table  */
+/*    _nx_tcp_listen_pool_arm               Arm next pooled socket        */
 /*    _nx_tcp_mss_option_get                Get peer MSS option           */
 /*    _nx_tcp_no_connection_reset           Reset on no connection        */
 /*    _nx_tcp_packet_send_syn               Send SYN message              */
+/*    _nx_tcp_sack_permitted_option_get     Get peer SACK permitted       */
 /*    _nx_tcp_socket_packet_process         Socket specific packet        */
 /*                                            processing routine          */
+/*    _nx_tcp_socket_timer_update           Update socket timers          */
 /*    (nx_tcp_listen_callback)              Application listen callback   */
 /*                                            function                    */
 /*                                                                        */
@@ -84,6 +89,18 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            supported TCP checksum      */
+/*                                            offload, looked up          */
+/*                                            connections and listen      */
+/*                                            requests by hash, added TCP */
+/*                                            timer wheel, added round-   */
+/*                                            trip time reset, added SACK */
+/*                                            negotiation, accepted       */
+/*                                            checksums verified by       */
+/*                                            receive coalescing, added   */
+/*                                            listen socket pool,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_tcp_packet_process(NX_IP *ip_ptr, NX_PACKET *packet_ptr)
@@ -111,6 +128,9 @@ UINT                         status;
 #ifdef NX_ENABLE_TCP_WINDOW_SCALING
 ULONG                        rwin_scale = 0xFF;
 #endif /* NX_ENABLE_TCP_WINDOW_SCALING */
+#ifdef NX_ENABLE_TCP_SACK
+UINT                         sack_permitted = NX_FALSE;
+#endif /* NX_ENABLE_TCP_SACK */
 
 
     /* Pickup the source IP address.  */
@@ -119,22 +139,30 @@ ULONG                        rwin_scale = 0xFF;
 
 #ifndef NX_DISABLE_TCP_RX_CHECKSUM
 
-    /* Calculate the checksum.  */
-    if (_nx_tcp_checksum(packet_ptr, source_ip, packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_address))
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+    /* Determine if the interface or TCP receive coalescing has already verified the TCP checksum.  */
+    if (!((packet_ptr -> nx_packet_ip_interface -> nx_interface_capability_flag |
+           packet_ptr -> nx_packet_interface_capability_flag) & NX_INTERFACE_CAPABILITY_TCP_RX_CHECKSUM))
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
     {
 
+        /* Calculate the checksum.  */
+        if (_nx_tcp_checksum(packet_ptr, source_ip, packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_address))
+        {
+
 #ifndef NX_DISABLE_TCP_INFO
 
-        /* Increment the TCP invalid packet error count.  */
-        ip_ptr -> nx_ip_tcp_invalid_packets++;
+            /* Increment the TCP invalid packet error count.  */
+            ip_ptr -> nx_ip_tcp_invalid_packets++;
 
-        /* Increment the TCP packet checksum error count.  */
-        ip_ptr -> nx_ip_tcp_checksum_errors++;
+            /* Increment the TCP packet checksum error count.  */
+            ip_ptr -> nx_ip_tcp_checksum_errors++;
 #endif
 
-        /* Checksum error, just release the packet.  */
-        _nx_packet_release(packet_ptr);
-        return;
+            /* Checksum error, just release the packet.  */
+            _nx_packet_release(packet_ptr);
+            return;
+        }
     }
 #endif
 
@@ -204,6 +232,21 @@ ULONG                        rwin_scale = 0xFF;
             is_valid_option_flag = NX_FALSE;
         }
 #endif /* NX_ENABLE_TCP_WINDOW_SCALING */
+
+#ifdef NX_ENABLE_TCP_SACK
+        /* Determine if the peer accepts selective acknowledgments.  Only a SYN may carry the
+           SACK permitted option.  */
+        if (tcp_header_ptr -> nx_tcp_header_word_3 & NX_TCP_SYN_BIT)
+        {
+            status = _nx_tcp_sack_permitted_option_get((packet_ptr -> nx_packet_prepend_ptr + sizeof(NX_TCP_HEADER)), option_words * sizeof(ULONG), &sack_permitted);
+
+            /* Check the status. if status is NX_FALSE, means Option Length is invalid.  */
+            if (status == NX_FALSE)
+            {
+                is_valid_option_flag = NX_FALSE;
+            }
+        }
+#endif /* NX_ENABLE_TCP_SACK */
     }
 
     /* Pickup the destination TCP port.  */
@@ -212,97 +255,70 @@ ULONG                        rwin_scale = 0xFF;
     /* Pickup the source TCP port.  */
     source_port =  (UINT)(tcp_header_ptr -> nx_tcp_header_word_0 >> NX_SHIFT_BY_16);
 
-    /* Calculate the hash index in the TCP port array of the associated IP instance.  */
-    index =  (UINT)((port + (port >> 8)) & NX_TCP_PORT_TABLE_MASK);
-
-    /* Search the bound sockets in this index for the particular port.  */
-    socket_ptr =  ip_ptr -> nx_ip_tcp_port_table[index];
+    /* Search the TCP connection table for an existing connection of this segment.  */
+    socket_ptr =  _nx_tcp_connection_table_find(ip_ptr, port, source_ip, source_port);
 
-    /* Determine if there are any sockets bound on this port index.  */
+    /* Determine if an existing connection was found.  */
     if (socket_ptr)
     {
 
-        /*  Yes, loop to examine the list of bound ports on this index.  */
-        do
+        /* If this packet contains SYN */
+        if (tcp_header_ptr -> nx_tcp_header_word_3 & NX_TCP_SYN_BIT)
         {
+            /* Record the MSS value if it is present and the   Otherwise use 536, as
+               outlined in RFC 1122 section 4.2.2.6. */
 
-            /* Determine if the port has been found.  */
-            if ((socket_ptr -> nx_tcp_socket_port == port) &&
-                (socket_ptr -> nx_tcp_socket_connect_ip == source_ip) &&
-                (socket_ptr -> nx_tcp_socket_connect_port == source_port))
-            {
-
-                /* Yes, we have a match!  */
-
-                /* Determine if we need to update the tcp port head pointer.  This should
-                   only be done if the found socket pointer is not the head pointer and
-                   the mutex for this IP instance is available.  */
-                if (socket_ptr != ip_ptr -> nx_ip_tcp_port_table[index])
-                {
-
-                    /* Move the port head pointer to this socket.  */
-                    ip_ptr -> nx_ip_tcp_port_table[index] =  socket_ptr;
-                }
-
-                /* If this packet contains SYN */
-                if (tcp_header_ptr -> nx_tcp_header_word_3 & NX_TCP_SYN_BIT)
-                {
-                    /* Record the MSS value if it is present and the   Otherwise use 536, as
-                       outlined in RFC 1122 section 4.2.2.6. */
-
-                    /* Yes, MSS was found store it!  */
-                    socket_ptr -> nx_tcp_socket_peer_mss =  mss;
+            /* Yes, MSS was found store it!  */
+            socket_ptr -> nx_tcp_socket_peer_mss =  mss;
 
-                    /* Compute the local MSS size based on the interface MTU size. */
-                    mss = packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_mtu_size - sizeof(NX_TCP_HEADER) - sizeof(NX_IP_HEADER);
+            /* Compute the local MSS size based on the interface MTU size. */
+            mss = packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_mtu_size - sizeof(NX_TCP_HEADER) - sizeof(NX_IP_HEADER);
 
-                    /* Calculate sender MSS. */
-                    if (mss > socket_ptr -> nx_tcp_socket_peer_mss)
-                    {
+            /* Calculate sender MSS. */
+            if (mss > socket_ptr -> nx_tcp_socket_peer_mss)
+            {
 
-                        /* Local MSS is larger than peer MSS. */
-                        mss = socket_ptr -> nx_tcp_socket_peer_mss;
-                    }
+                /* Local MSS is larger than peer MSS. */
+                mss = socket_ptr -> nx_tcp_socket_peer_mss;
+            }
 
-                    if ((mss > socket_ptr -> nx_tcp_socket_mss) && socket_ptr -> nx_tcp_socket_mss)
-                    {
-                        socket_ptr -> nx_tcp_socket_connect_mss  = socket_ptr -> nx_tcp_socket_mss;
-                    }
-                    else
-                    {
-                        socket_ptr -> nx_tcp_socket_connect_mss  = mss;
-                    }
+            if ((mss > socket_ptr -> nx_tcp_socket_mss) && socket_ptr -> nx_tcp_socket_mss)
+            {
+                socket_ptr -> nx_tcp_socket_connect_mss  = socket_ptr -> nx_tcp_socket_mss;
+            }
+            else
+            {
+                socket_ptr -> nx_tcp_socket_connect_mss  = mss;
+            }
 
-                    /* Compute the SMSS * SMSS value, so later TCP module doesn't need to redo the multiplication. */
-                    socket_ptr -> nx_tcp_socket_connect_mss2 =
-                        socket_ptr -> nx_tcp_socket_connect_mss * socket_ptr -> nx_tcp_socket_connect_mss;
+            /* Compute the SMSS * SMSS value, so later TCP module doesn't need to redo the multiplication. */
+            socket_ptr -> nx_tcp_socket_connect_mss2 =
+                socket_ptr -> nx_tcp_socket_connect_mss * socket_ptr -> nx_tcp_socket_connect_mss;
 
 
 
 #ifdef NX_ENABLE_TCP_WINDOW_SCALING
-                    /*
-                       Simply record the peer's window scale value. When we move to the
-                       ESTABLISHED state, we will set the peer window scale to 0 if the
-                       peer does not support this feature.
-                     */
-                    socket_ptr -> nx_tcp_snd_win_scale_value = rwin_scale;
+            /*
+               Simply record the peer's window scale value. When we move to the
+               ESTABLISHED state, we will set the peer window scale to 0 if the
+               peer does not support this feature.
+             */
+            socket_ptr -> nx_tcp_snd_win_scale_value = rwin_scale;
 #endif /* NX_ENABLE_TCP_WINDOW_SCALING */
-                }
 
+#ifdef NX_ENABLE_TCP_SACK
+            /* Record whether the peer accepted SACK.  */
+            socket_ptr -> nx_tcp_socket_sack_permitted =  sack_permitted;
+            socket_ptr -> nx_tcp_socket_sack_count =      0;
+#endif /* NX_ENABLE_TCP_SACK */
+        }
 
-                /* Process the packet within an existing TCP connection.  */
-                _nx_tcp_socket_packet_process(socket_ptr, packet_ptr);
 
-                /* Get out of the search loop and this function!  */
-                return;
-            }
-            else
-            {
+        /* Process the packet within an existing TCP connection.  */
+        _nx_tcp_socket_packet_process(socket_ptr, packet_ptr);
 
-                /* Move to the next entry in the bound index.  */
-                socket_ptr =  socket_ptr -> nx_tcp_socket_bound_next;
-            }
-        } while ((socket_ptr) && (socket_ptr != ip_ptr -> nx_ip_tcp_port_table[index]));
+        /* Get out of this function!  */
+        return;
     }
 
     /* At this point, we know there is not an existing TCP connection.  */
@@ -380,407 +396,432 @@ ULONG                        rwin_scale = 0xFF;
             return;
         }
 
-        /* Search all ports in listen mode for a match. */
-        listen_ptr =  ip_ptr -> nx_ip_tcp_active_listen_requests;
-        do
+        /* Search the listen requests on this port index for a match.  */
+        listen_ptr =  ip_ptr -> nx_ip_tcp_listen_table[NX_TCP_LISTEN_HASH(port)];
+        while ((listen_ptr) && (listen_ptr -> nx_tcp_listen_port != port))
         {
 
-            /* Determine if this port is in a listen mode.  */
-            if (listen_ptr -> nx_tcp_listen_port == port)
-            {
+            /* Move to the next listen request on this index.  */
+            listen_ptr =  listen_ptr -> nx_tcp_listen_hash_next;
+        }
+
+        /* Determine if this port is in a listen mode.  */
+        if (listen_ptr)
+        {
 
 #ifndef NX_DISABLE_TCP_INFO
 
-                /* Check for a RST (reset) bit set.  */
-                if (!(tcp_header_ptr -> nx_tcp_header_word_3 & NX_TCP_RST_BIT))
-                {
+            /* Check for a RST (reset) bit set.  */
+            if (!(tcp_header_ptr -> nx_tcp_header_word_3 & NX_TCP_RST_BIT))
+            {
 
-                    /* Increment the passive TCP connections count.  */
-                    ip_ptr -> nx_ip_tcp_passive_connections++;
+                /* Increment the passive TCP connections count.  */
+                ip_ptr -> nx_ip_tcp_passive_connections++;
 
-                    /* Increment the TCP connections count.  */
-                    ip_ptr -> nx_ip_tcp_connections++;
-                }
+                /* Increment the TCP connections count.  */
+                ip_ptr -> nx_ip_tcp_connections++;
+            }
 
 #endif
 
-                /* Okay, this port is in a listen mode.  We now need to see if
-                   there is an available socket for the new connection request
-                   present.  */
-                if ((listen_ptr -> nx_tcp_listen_socket_ptr) &&
-                    ((tcp_header_ptr -> nx_tcp_header_word_3 & NX_TCP_RST_BIT) == NX_NULL))
-                {
+            /* Okay, this port is in a listen mode.  We now need to see if
+               there is an available socket for the new connection request
+               present.  */
+            if ((listen_ptr -> nx_tcp_listen_socket_ptr) &&
+                ((tcp_header_ptr -> nx_tcp_header_word_3 & NX_TCP_RST_BIT) == NX_NULL))
+            {
 
-                    /* Yes there is indeed a socket present.  We now need to
-                       fill in the appropriate info and call the server callback
-                       routine.  */
+                /* Yes there is indeed a socket present.  We now need to
+                   fill in the appropriate info and call the server callback
+                   routine.  */
 
-                    /* Allocate the supplied server socket.  */
-                    socket_ptr =  listen_ptr -> nx_tcp_listen_socket_ptr;
+                /* Allocate the supplied server socket.  */
+                socket_ptr =  listen_ptr -> nx_tcp_listen_socket_ptr;
 
 
 #ifndef NX_DISABLE_EXTENDED_NOTIFY_SUPPORT
-                    /* If extended notify is enabled, call the syn_received notify function.
-                       This user-supplied function decides whether or not this SYN request
-                       should be accepted. */
-                    if (socket_ptr -> nx_tcp_socket_syn_received_notify)
+                /* If extended notify is enabled, call the syn_received notify function.
+                   This user-supplied function decides whether or not this SYN request
+                   should be accepted. */
+                if (socket_ptr -> nx_tcp_socket_syn_received_notify)
+                {
+                    if ((socket_ptr -> nx_tcp_socket_syn_received_notify)(socket_ptr, packet_ptr) != NX_TRUE)
                     {
-                        if ((socket_ptr -> nx_tcp_socket_syn_received_notify)(socket_ptr, packet_ptr) != NX_TRUE)
-                        {
-                            /* Release the packet.  */
-                            _nx_packet_release(packet_ptr);
+                        /* Release the packet.  */
+                        _nx_packet_release(packet_ptr);
 
-                            /* Finished processing, simply return!  */
-                            return;
-                        }
+                        /* Finished processing, simply return!  */
+                        return;
                     }
+                }
 #endif /* NX_DISABLE_EXTENDED_NOTIFY_SUPPORT */
 
-                    /* If trace is enabled, insert this event into the trace buffer.  */
-                    NX_TRACE_IN_LINE_INSERT(NX_TRACE_INTERNAL_TCP_SYN_RECEIVE, ip_ptr, socket_ptr, packet_ptr, tcp_header_ptr -> nx_tcp_sequence_number, NX_TRACE_INTERNAL_EVENTS, 0, 0)
-
-                    /* Clear the server socket pointer in the listen request.  If the
-                       application wishes to honor more server connections on this port,
-                       the application must call relisten with a new server socket
-                       pointer.  */
-                    listen_ptr -> nx_tcp_listen_socket_ptr =  NX_NULL;
-
-                    /* Fill the socket in with the appropriate information.  */
-                    socket_ptr -> nx_tcp_socket_connect_ip =    source_ip;
-                    socket_ptr -> nx_tcp_socket_connect_port =  source_port;
-                    socket_ptr -> nx_tcp_socket_rx_sequence =   tcp_header_ptr -> nx_tcp_sequence_number;
-                    socket_ptr -> nx_tcp_socket_connect_interface = packet_ptr -> nx_packet_ip_interface;
-
-                    if (_nx_ip_route_find(ip_ptr, source_ip, &socket_ptr -> nx_tcp_socket_connect_interface,
-                                          &socket_ptr -> nx_tcp_socket_next_hop_address) != NX_SUCCESS)
-                    {
-                        /* Cannot determine how to send packets to this TCP peer.  Since we are able to
-                           receive the syn, use the incoming interface, and send the packet out directly. */
+                /* If trace is enabled, insert this event into the trace buffer.  */
+                NX_TRACE_IN_LINE_INSERT(NX_TRACE_INTERNAL_TCP_SYN_RECEIVE, ip_ptr, socket_ptr, packet_ptr, tcp_header_ptr -> nx_tcp_sequence_number, NX_TRACE_INTERNAL_EVENTS, 0, 0)
 
-                        socket_ptr -> nx_tcp_socket_next_hop_address = source_ip;
-                    }
+                /* Clear the server socket pointer in the listen request.  If the
+                   application wishes to honor more server connections on this port,
+                   the application must call relisten with a new server socket
+                   pointer.  */
+                listen_ptr -> nx_tcp_listen_socket_ptr =  NX_NULL;
 
-                    /* Yes, MSS was found store it!  */
-                    socket_ptr -> nx_tcp_socket_peer_mss =  mss;
+                /* Fill the socket in with the appropriate information.  */
+                socket_ptr -> nx_tcp_socket_connect_ip =    source_ip;
+                socket_ptr -> nx_tcp_socket_connect_port =  source_port;
+                socket_ptr -> nx_tcp_socket_rx_sequence =   tcp_header_ptr -> nx_tcp_sequence_number;
+                socket_ptr -> nx_tcp_socket_connect_interface = packet_ptr -> nx_packet_ip_interface;
+
+                if (_nx_ip_route_find(ip_ptr, source_ip, &socket_ptr -> nx_tcp_socket_connect_interface,
+                                      &socket_ptr -> nx_tcp_socket_next_hop_address) != NX_SUCCESS)
+                {
+                    /* Cannot determine how to send packets to this TCP peer.  Since we are able to
+                       receive the syn, use the incoming interface, and send the packet out directly. */
+
+                    socket_ptr -> nx_tcp_socket_next_hop_address = source_ip;
+                }
+
+                /* Yes, MSS was found store it!  */
+                socket_ptr -> nx_tcp_socket_peer_mss =  mss;
 
 #ifdef NX_ENABLE_TCP_WINDOW_SCALING
-                    /*
-                       Simply record the peer's window scale value. When we move to the
-                       ESTABLISHED state, we will set the peer window scale to 0 if the
-                       peer does not support this feature.
-                     */
-                    socket_ptr -> nx_tcp_snd_win_scale_value = rwin_scale;
+                /*
+                   Simply record the peer's window scale value. When we move to the
+                   ESTABLISHED state, we will set the peer window scale to 0 if the
+                   peer does not support this feature.
+                 */
+                socket_ptr -> nx_tcp_snd_win_scale_value = rwin_scale;
 #endif /* NX_ENABLE_TCP_WINDOW_SCALING */
 
-                    /* Set the initial slow start threshold to be the advertised window size. */
-                    socket_ptr -> nx_tcp_socket_tx_slow_start_threshold = socket_ptr -> nx_tcp_socket_tx_window_advertised;
+#ifdef NX_ENABLE_TCP_SACK
+                /* Record whether the peer offered SACK.  */
+                socket_ptr -> nx_tcp_socket_sack_permitted =  sack_permitted;
+                socket_ptr -> nx_tcp_socket_sack_count =      0;
+#endif /* NX_ENABLE_TCP_SACK */
 
-                    /* Slow start:  setup initial window (IW) to be MSS,  RFC 2581, 3.1 */
-                    socket_ptr -> nx_tcp_socket_tx_window_congestion = mss;
+                /* Set the initial slow start threshold to be the advertised window size. */
+                socket_ptr -> nx_tcp_socket_tx_slow_start_threshold = socket_ptr -> nx_tcp_socket_tx_window_advertised;
 
-                    /* Initialize the transmit outstanding byte count to zero. */
-                    socket_ptr -> nx_tcp_socket_tx_outstanding_bytes = 0;
+                /* Slow start:  setup initial window (IW) to be MSS,  RFC 2581, 3.1 */
+                socket_ptr -> nx_tcp_socket_tx_window_congestion = mss;
 
-                    /* Calculate the hash index in the TCP port array of the associated IP instance.  */
-                    index =  (UINT)((port + (port >> 8)) & NX_TCP_PORT_TABLE_MASK);
+                /* Initialize the transmit outstanding byte count to zero. */
+                socket_ptr -> nx_tcp_socket_tx_outstanding_bytes = 0;
 
-                    /* Determine if the list is NULL.  */
-                    if (ip_ptr -> nx_ip_tcp_port_table[index])
-                    {
+                /* Calculate the hash index in the TCP port array of the associated IP instance.  */
+                index =  (UINT)((port + (port >> 8)) & NX_TCP_PORT_TABLE_MASK);
 
-                        /* There are already sockets on this list... just add this one
-                           to the end.  */
-                        socket_ptr -> nx_tcp_socket_bound_next =
-                            ip_ptr -> nx_ip_tcp_port_table[index];
-                        socket_ptr -> nx_tcp_socket_bound_previous =
-                            (ip_ptr -> nx_ip_tcp_port_table[index]) -> nx_tcp_socket_bound_previous;
-                        ((ip_ptr -> nx_ip_tcp_port_table[index]) -> nx_tcp_socket_bound_previous) -> nx_tcp_socket_bound_next =
-                            socket_ptr;
-                        (ip_ptr -> nx_ip_tcp_port_table[index]) -> nx_tcp_socket_bound_previous =   socket_ptr;
-                    }
-                    else
-                    {
+                /* Determine if the list is NULL.  */
+                if (ip_ptr -> nx_ip_tcp_port_table[index])
+                {
 
-                        /* Nothing is on the TCP port list.  Add this TCP socket to an
-                           empty list.  */
-                        socket_ptr -> nx_tcp_socket_bound_next =      socket_ptr;
-                        socket_ptr -> nx_tcp_socket_bound_previous =  socket_ptr;
-                        ip_ptr -> nx_ip_tcp_port_table[index] =       socket_ptr;
-                    }
+                    /* There are already sockets on this list... just add this one
+                       to the end.  */
+                    socket_ptr -> nx_tcp_socket_bound_next =
+                        ip_ptr -> nx_ip_tcp_port_table[index];
+                    socket_ptr -> nx_tcp_socket_bound_previous =
+                        (ip_ptr -> nx_ip_tcp_port_table[index]) -> nx_tcp_socket_bound_previous;
+                    ((ip_ptr -> nx_ip_tcp_port_table[index]) -> nx_tcp_socket_bound_previous) -> nx_tcp_socket_bound_next =
+                        socket_ptr;
+                    (ip_ptr -> nx_ip_tcp_port_table[index]) -> nx_tcp_socket_bound_previous =   socket_ptr;
+                }
+                else
+                {
 
-                    /* Pickup the listen callback function.  */
-                    listen_callback =  listen_ptr -> nx_tcp_listen_callback;
+                    /* Nothing is on the TCP port list.  Add this TCP socket to an
+                       empty list.  */
+                    socket_ptr -> nx_tcp_socket_bound_next =      socket_ptr;
+                    socket_ptr -> nx_tcp_socket_bound_previous =  socket_ptr;
+                    ip_ptr -> nx_ip_tcp_port_table[index] =       socket_ptr;
+                }
 
-                    /* Release the incoming packet.  */
-                    _nx_packet_release(packet_ptr);
+                /* Place the socket on the TCP connection table.  */
+                _nx_tcp_connection_table_insert(ip_ptr, socket_ptr);
 
-                    /* Determine if an accept call with suspension has already been made
-                       for this socket.  If so, the SYN message needs to be sent from
-                       here.  */
-                    if (socket_ptr -> nx_tcp_socket_state == NX_TCP_SYN_RECEIVED)
-                    {
+                /* Pickup the listen callback function.  */
+                listen_callback =  listen_ptr -> nx_tcp_listen_callback;
 
+                /* Release the incoming packet.  */
+                _nx_packet_release(packet_ptr);
 
-                        /* If trace is enabled, insert this event into the trace buffer.  */
-                        NX_TRACE_IN_LINE_INSERT(NX_TRACE_INTERNAL_TCP_STATE_CHANGE, ip_ptr, socket_ptr, socket_ptr -> nx_tcp_socket_state, socket_ptr -> nx_tcp_socket_state, NX_TRACE_INTERNAL_EVENTS, 0, 0)
+                /* Determine if an accept call with suspension has already been made
+                   for this socket.  If so, the SYN message needs to be sent from
+                   here.  */
+                if (socket_ptr -> nx_tcp_socket_state == NX_TCP_SYN_RECEIVED)
+                {
 
 
-                        /* The application is suspended on an accept call for this socket.
-                           Simply send the SYN now and keep the thread suspended until the
-                           other side completes the connection.  */
+                    /* If trace is enabled, insert this event into the trace buffer.  */
+                    NX_TRACE_IN_LINE_INSERT(NX_TRACE_INTERNAL_TCP_STATE_CHANGE, ip_ptr, socket_ptr, socket_ptr -> nx_tcp_socket_state, socket_ptr -> nx_tcp_socket_state, NX_TRACE_INTERNAL_EVENTS, 0, 0)
 
-                        /* Send the SYN message, but increment the ACK first.  */
-                        socket_ptr -> nx_tcp_socket_rx_sequence++;
 
-                        /* Increment the sequence number for the SYN message.  */
-                        socket_ptr -> nx_tcp_socket_tx_sequence++;
+                    /* The application is suspended on an accept call for this socket.
+                       Simply send the SYN now and keep the thread suspended until the
+                       other side completes the connection.  */
 
-                        /* Setup a timeout so the connection attempt can be sent again.  */
-                        socket_ptr -> nx_tcp_socket_timeout =          socket_ptr -> nx_tcp_socket_timeout_rate;
-                        socket_ptr -> nx_tcp_socket_timeout_retries =  0;
+                    /* Send the SYN message, but increment the ACK first.  */
+                    socket_ptr -> nx_tcp_socket_rx_sequence++;
 
-                        /* Send the SYN+ACK message.  */
-                        _nx_tcp_packet_send_syn(socket_ptr, (socket_ptr -> nx_tcp_socket_tx_sequence - 1));
-                    }
+                    /* Increment the sequence number for the SYN message.  */
+                    socket_ptr -> nx_tcp_socket_tx_sequence++;
 
-                    /* Determine if there is a listen callback function.  */
-                    if (listen_callback)
-                    {
-                        /* Call the user's listen callback function.  */
-                        (listen_callback)(socket_ptr, port);
-                    }
+#ifdef NX_ENABLE_TCP_RTT_ESTIMATION
 
-                    /* Finished processing, just return.  */
-                    return;
+                    /* Start the new connection from the configured timeout with no round-trip time estimate.  */
+                    socket_ptr -> nx_tcp_socket_timeout_rate =  socket_ptr -> nx_tcp_socket_timeout_rate_default;
+                    socket_ptr -> nx_tcp_socket_rtt_srtt =      0;
+                    socket_ptr -> nx_tcp_socket_rtt_rttvar =    0;
+                    socket_ptr -> nx_tcp_socket_rtt_active =    NX_FALSE;
+#endif /* NX_ENABLE_TCP_RTT_ESTIMATION */
+
+                    /* Setup a timeout so the connection attempt can be sent again.  */
+                    _nx_tcp_socket_timer_update(socket_ptr);
+                    socket_ptr -> nx_tcp_socket_timeout =          socket_ptr -> nx_tcp_socket_timeout_rate;
+                    socket_ptr -> nx_tcp_socket_timeout_retries =  0;
+
+                    /* Send the SYN+ACK message.  */
+                    _nx_tcp_packet_send_syn(socket_ptr, (socket_ptr -> nx_tcp_socket_tx_sequence - 1));
                 }
-                else
+
+                /* Determine if there is a listen callback function.  */
+                if (listen_callback)
                 {
+                    /* Call the user's listen callback function.  */
+                    (listen_callback)(socket_ptr, port);
+                }
 
-                    /* There is no server socket available for the new connection.  */
+#ifdef NX_ENABLE_TCP_LISTEN_POOL
 
-                    /* Note: The application needs to call relisten on a socket to process queued
-                       connection requests.  */
+                /* Give the listen request the next idle socket from its pool.  */
+                _nx_tcp_listen_pool_arm(ip_ptr, listen_ptr);
+#endif /* NX_ENABLE_TCP_LISTEN_POOL */
 
-                    /* Check for a RST (reset) bit set.  */
-                    if (!(tcp_header_ptr -> nx_tcp_header_word_3 & NX_TCP_RST_BIT))
-                    {
+                /* Finished processing, just return.  */
+                return;
+            }
+            else
+            {
 
-                        /* If trace is enabled, insert this event into the trace buffer.  */
-                        NX_TRACE_IN_LINE_INSERT(NX_TRACE_INTERNAL_TCP_SYN_RECEIVE, ip_ptr, NX_NULL, packet_ptr, tcp_header_ptr -> nx_tcp_sequence_number, NX_TRACE_INTERNAL_EVENTS, 0, 0)
-                    }
+                /* There is no server socket available for the new connection.  */
 
-                    queued_count =  listen_ptr -> nx_tcp_listen_queue_current;
-                    queued_ptr =    listen_ptr -> nx_tcp_listen_queue_head;
+                /* Note: The application needs to call relisten on a socket to process queued
+                   connection requests.  */
 
-                    /* Check for the same connection request already in the queue. If this is a RST packet
-                       it will check for a previous connection which should be removed from the queue.  */
+                /* Check for a RST (reset) bit set.  */
+                if (!(tcp_header_ptr -> nx_tcp_header_word_3 & NX_TCP_RST_BIT))
+                {
 
-                    /* Loop through the queued list.  */
-                    while (queued_count--)
-                    {
+                    /* If trace is enabled, insert this event into the trace buffer.  */
+                    NX_TRACE_IN_LINE_INSERT(NX_TRACE_INTERNAL_TCP_SYN_RECEIVE, ip_ptr, NX_NULL, packet_ptr, tcp_header_ptr -> nx_tcp_sequence_number, NX_TRACE_INTERNAL_EVENTS, 0, 0)
+                }
 
-                        /* Pickup the queued source port and source IP address to check for a match.  */
-                        queued_source_ip =    *(((ULONG *)queued_ptr -> nx_packet_prepend_ptr) - 2);
-                        queued_source_port =  (UINT)(*((ULONG *)queued_ptr -> nx_packet_prepend_ptr) >> NX_SHIFT_BY_16);
+                queued_count =  listen_ptr -> nx_tcp_listen_queue_current;
+                queued_ptr =    listen_ptr -> nx_tcp_listen_queue_head;
 
-                        /* Determine if this matches the current connection request.  */
-                        if ((queued_source_ip == source_ip) && (queued_source_port == source_port))
-                        {
+                /* Check for the same connection request already in the queue. If this is a RST packet
+                   it will check for a previous connection which should be removed from the queue.  */
 
-                            /* Check for a RST (reset) bit set.  */
-                            if (tcp_header_ptr -> nx_tcp_header_word_3 & NX_TCP_RST_BIT)
-                            {
+                /* Loop through the queued list.  */
+                while (queued_count--)
+                {
 
-                                tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
+                    /* Pickup the queued source port and source IP address to check for a match.  */
+                    queued_source_ip =    *(((ULONG *)queued_ptr -> nx_packet_prepend_ptr) - 2);
+                    queued_source_port =  (UINT)(*((ULONG *)queued_ptr -> nx_packet_prepend_ptr) >> NX_SHIFT_BY_16);
 
-                                /* This matches a previous connection request which needs to be removed from the listen queue. */
+                    /* Determine if this matches the current connection request.  */
+                    if ((queued_source_ip == source_ip) && (queued_source_port == source_port))
+                    {
 
-                                /* Are there are any connection requests on the queue? */
-                                if (listen_ptr -> nx_tcp_listen_queue_current == 0)
-                                {
+                        /* Check for a RST (reset) bit set.  */
+                        if (tcp_header_ptr -> nx_tcp_header_word_3 & NX_TCP_RST_BIT)
+                        {
 
-                                    /* No, put the TCP socket back in the listen structure. */
-                                    listen_ptr -> nx_tcp_listen_socket_ptr =  socket_ptr;
-                                }
-                                else
-                                {
+                            tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
 
-                                /* Yes, we need to find the connection request in the queue. */
-                                NX_PACKET *current_packet_ptr, *prev_packet_ptr;
-                                UINT       found_connection_request = NX_FALSE;
+                            /* This matches a previous connection request which needs to be removed from the listen queue. */
 
-                                    /* Start with the oldest one. */
-                                    current_packet_ptr = listen_ptr -> nx_tcp_listen_queue_head;
+                            /* Are there are any connection requests on the queue? */
+                            if (listen_ptr -> nx_tcp_listen_queue_current == 0)
+                            {
 
-                                    /* Remove the oldest connection request if it matches the current RST packet. */
-                                    if (queued_ptr  == listen_ptr -> nx_tcp_listen_queue_head)
-                                    {
+                                /* No, put the TCP socket back in the listen structure. */
+                                listen_ptr -> nx_tcp_listen_socket_ptr =  socket_ptr;
+                            }
+                            else
+                            {
 
-                                        /* Reset the front (oldest) of the queue to the next request. */
-                                        current_packet_ptr =  listen_ptr -> nx_tcp_listen_queue_head;
-                                        listen_ptr -> nx_tcp_listen_queue_head =  current_packet_ptr -> nx_packet_queue_next;
+                            /* Yes, we need to find the connection request in the queue. */
+                            NX_PACKET *current_packet_ptr, *prev_packet_ptr;
+                            UINT       found_connection_request = NX_FALSE;
 
-                                        /* Was there only one queue request e.g. head == tail?   */
-                                        if (current_packet_ptr == listen_ptr -> nx_tcp_listen_queue_tail)
-                                        {
+                                /* Start with the oldest one. */
+                                current_packet_ptr = listen_ptr -> nx_tcp_listen_queue_head;
 
-                                            /* Yes, and now there are none. Set the queue to empty. */
-                                            listen_ptr -> nx_tcp_listen_queue_tail =  NX_NULL;
-                                        }
+                                /* Remove the oldest connection request if it matches the current RST packet. */
+                                if (queued_ptr  == listen_ptr -> nx_tcp_listen_queue_head)
+                                {
 
-                                        found_connection_request = NX_TRUE;
-                                    }
-                                    else
+                                    /* Reset the front (oldest) of the queue to the next request. */
+                                    current_packet_ptr =  listen_ptr -> nx_tcp_listen_queue_head;
+                                    listen_ptr -> nx_tcp_listen_queue_head =  current_packet_ptr -> nx_packet_queue_next;
+
+                                    /* Was there only one queue request e.g. head == tail?   */
+                                    if (current_packet_ptr == listen_ptr -> nx_tcp_listen_queue_tail)
                                     {
 
-                                        /* Check the rest of the connection requests. */
+                                        /* Yes, and now there are none. Set the queue to empty. */
+                                        listen_ptr -> nx_tcp_listen_queue_tail =  NX_NULL;
+                                    }
 
-                                        prev_packet_ptr = current_packet_ptr;
-                                        current_packet_ptr = current_packet_ptr -> nx_packet_queue_next;
+                                    found_connection_request = NX_TRUE;
+                                }
+                                else
+                                {
 
-                                        /* Loop through the queue to the most recent request or until we find a match. */
-                                        while (current_packet_ptr)
-                                        {
+                                    /* Check the rest of the connection requests. */
 
-                                            /* Do we have a match? */
-                                            if (queued_ptr == current_packet_ptr)
-                                            {
+                                    prev_packet_ptr = current_packet_ptr;
+                                    current_packet_ptr = current_packet_ptr -> nx_packet_queue_next;
 
-                                                /* Yes, remove this one! */
+                                    /* Loop through the queue to the most recent request or until we find a match. */
+                                    while (current_packet_ptr)
+                                    {
 
-                                                /* Link around the request we are removing. */
-                                                prev_packet_ptr -> nx_packet_queue_next = current_packet_ptr -> nx_packet_queue_next;
+                                        /* Do we have a match? */
+                                        if (queued_ptr == current_packet_ptr)
+                                        {
 
-                                                /* Is the request being removed the tail (most recent connection?)   */
-                                                if (current_packet_ptr == listen_ptr -> nx_tcp_listen_queue_tail)
-                                                {
+                                            /* Yes, remove this one! */
 
-                                                    /* Yes, set the previous connection request as the tail. */
-                                                    listen_ptr -> nx_tcp_listen_queue_tail = prev_packet_ptr;
-                                                }
+                                            /* Link around the request we are removing. */
+                                            prev_packet_ptr -> nx_packet_queue_next = current_packet_ptr -> nx_packet_queue_next;
 
-                                                /* Make sure the most recent request null terminates the list. */
-                                                listen_ptr -> nx_tcp_listen_queue_tail -> nx_packet_queue_next =  NX_NULL;
+                                            /* Is the request being removed the tail (most recent connection?)   */
+                                            if (current_packet_ptr == listen_ptr -> nx_tcp_listen_queue_tail)
+                                            {
 
-                                                found_connection_request = NX_TRUE;
-                                                break;
+                                                /* Yes, set the previous connection request as the tail. */
+                                                listen_ptr -> nx_tcp_listen_queue_tail = prev_packet_ptr;
                                             }
 
-                                            /* Not the connection request to remove. Check the next one,
-                                               and save the current connection request as the 'previous' one. */
-                                            prev_packet_ptr = current_packet_ptr;
-                                            current_packet_ptr = current_packet_ptr -> nx_packet_queue_next;
+                                            /* Make sure the most recent request null terminates the list. */
+                                            listen_ptr -> nx_tcp_listen_queue_tail -> nx_packet_queue_next =  NX_NULL;
+
+                                            found_connection_request = NX_TRUE;
+                                            break;
                                         }
+
+                                        /* Not the connection request to remove. Check the next one,
+                                           and save the current connection request as the 'previous' one. */
+                                        prev_packet_ptr = current_packet_ptr;
+                                        current_packet_ptr = current_packet_ptr -> nx_packet_queue_next;
                                     }
+                                }
 
-                                    /* Verify we found the connection to remove. */
-                                    if (found_connection_request == NX_TRUE)
-                                    {
+                                /* Verify we found the connection to remove. */
+                                if (found_connection_request == NX_TRUE)
+                                {
 
-                                        /* Release the connection request packet.  */
-                                        _nx_packet_release(current_packet_ptr);
+                                    /* Release the connection request packet.  */
+                                    _nx_packet_release(current_packet_ptr);
 
-                                        /* Update the listen queue. */
-                                        listen_ptr -> nx_tcp_listen_queue_current--;
-                                    }
+                                    /* Update the listen queue. */
+                                    listen_ptr -> nx_tcp_listen_queue_current--;
                                 }
-
-                                /* Release the protection.  */
-                                tx_mutex_put(&(ip_ptr -> nx_ip_protection));
                             }
 
+                            /* Release the protection.  */
+                            tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+                        }
+
 #ifndef NX_DISABLE_TCP_INFO
 
-                            /* Increment the TCP dropped packet count.  */
-                            ip_ptr -> nx_ip_tcp_receive_packets_dropped++;
+                        /* Increment the TCP dropped packet count.  */
+                        ip_ptr -> nx_ip_tcp_receive_packets_dropped++;
 #endif
 
-                            /* Simply release the packet and return.  */
-                            _nx_packet_release(packet_ptr);
-
-                            /* Return!  */
-                            return;
-                        }
+                        /* Simply release the packet and return.  */
+                        _nx_packet_release(packet_ptr);
 
-                        /* Move to next item in the queue.  */
-                        queued_ptr =  queued_ptr -> nx_packet_queue_next;
+                        /* Return!  */
+                        return;
                     }
 
-                    /* No duplicate connection requests were found. */
+                    /* Move to next item in the queue.  */
+                    queued_ptr =  queued_ptr -> nx_packet_queue_next;
+                }
 
-                    /* Is this a RST packet? */
-                    if (tcp_header_ptr -> nx_tcp_header_word_3 & NX_TCP_RST_BIT)
-                    {
-                        /* Yes, so not a connection request. Do not place on the listen queue. */
+                /* No duplicate connection requests were found. */
 
-                        /* Release the packet.  */
-                        _nx_packet_release(packet_ptr);
+                /* Is this a RST packet? */
+                if (tcp_header_ptr -> nx_tcp_header_word_3 & NX_TCP_RST_BIT)
+                {
+                    /* Yes, so not a connection request. Do not place on the listen queue. */
 
-                        /* Return!  */
-                        return;
-                    }
+                    /* Release the packet.  */
+                    _nx_packet_release(packet_ptr);
 
-                    /* This is a valid connection request. Place this request on the listen queue.  */
+                    /* Return!  */
+                    return;
+                }
 
-                    /* Set the next pointer of the packet to NULL.  */
-                    packet_ptr -> nx_packet_queue_next =  NX_NULL;
+                /* This is a valid connection request. Place this request on the listen queue.  */
 
-                    /* Queue the new connection request.  */
-                    if (listen_ptr -> nx_tcp_listen_queue_head)
-                    {
+                /* Set the next pointer of the packet to NULL.  */
+                packet_ptr -> nx_packet_queue_next =  NX_NULL;
 
-                        /* There is a connection request already queued, just link packet to tail.  */
-                        (listen_ptr -> nx_tcp_listen_queue_tail) -> nx_packet_queue_next =  packet_ptr;
-                    }
-                    else
-                    {
+                /* Queue the new connection request.  */
+                if (listen_ptr -> nx_tcp_listen_queue_head)
+                {
 
-                        /* The queue is empty.  Setup head pointer to the new packet.  */
-                        listen_ptr -> nx_tcp_listen_queue_head =  packet_ptr;
-                    }
+                    /* There is a connection request already queued, just link packet to tail.  */
+                    (listen_ptr -> nx_tcp_listen_queue_tail) -> nx_packet_queue_next =  packet_ptr;
+                }
+                else
+                {
 
-                    /* Setup the tail pointer to the new packet and increment the queue count.  */
-                    listen_ptr -> nx_tcp_listen_queue_tail =  packet_ptr;
-                    listen_ptr -> nx_tcp_listen_queue_current++;
+                    /* The queue is empty.  Setup head pointer to the new packet.  */
+                    listen_ptr -> nx_tcp_listen_queue_head =  packet_ptr;
+                }
 
-                    /* Determine if the queue depth has been exceeded.  */
-                    if (listen_ptr -> nx_tcp_listen_queue_current > listen_ptr -> nx_tcp_listen_queue_maximum)
-                    {
+                /* Setup the tail pointer to the new packet and increment the queue count.  */
+                listen_ptr -> nx_tcp_listen_queue_tail =  packet_ptr;
+                listen_ptr -> nx_tcp_listen_queue_current++;
+
+                /* Determine if the queue depth has been exceeded.  */
+                if (listen_ptr -> nx_tcp_listen_queue_current > listen_ptr -> nx_tcp_listen_queue_maximum)
+                {
 
 #ifndef NX_DISABLE_TCP_INFO
 
-                        /* Increment the TCP connections dropped count.  */
-                        ip_ptr -> nx_ip_tcp_connections_dropped++;
-                        ip_ptr -> nx_ip_tcp_connections--;
+                    /* Increment the TCP connections dropped count.  */
+                    ip_ptr -> nx_ip_tcp_connections_dropped++;
+                    ip_ptr -> nx_ip_tcp_connections--;
 
-                        /* Increment the TCP dropped packet count.  */
-                        ip_ptr -> nx_ip_tcp_receive_packets_dropped++;
+                    /* Increment the TCP dropped packet count.  */
+                    ip_ptr -> nx_ip_tcp_receive_packets_dropped++;
 #endif
 
-                        /* Save the head packet pointer, since this will be released below.  */
-                        packet_ptr =  listen_ptr -> nx_tcp_listen_queue_head;
-
-                        /* Remove the oldest packet from the queue.  */
-                        listen_ptr -> nx_tcp_listen_queue_head =  (listen_ptr -> nx_tcp_listen_queue_head) -> nx_packet_queue_next;
+                    /* Save the head packet pointer, since this will be released below.  */
+                    packet_ptr =  listen_ptr -> nx_tcp_listen_queue_head;
 
-                        /* Decrement the number of packets in the queue.  */
-                        listen_ptr -> nx_tcp_listen_queue_current--;
+                    /* Remove the oldest packet from the queue.  */
+                    listen_ptr -> nx_tcp_listen_queue_head =  (listen_ptr -> nx_tcp_listen_queue_head) -> nx_packet_queue_next;
 
-                        /* We have exceeded the number of connections that can be
-                           queued for this port.  */
+                    /* Decrement the number of packets in the queue.  */
+                    listen_ptr -> nx_tcp_listen_queue_current--;
 
-                        /* Release the packet.  */
-                        _nx_packet_release(packet_ptr);
-                    }
+                    /* We have exceeded the number of connections that can be
+                       queued for this port.  */
 
-                    /* Finished processing, just return.  */
-                    return;
+                    /* Release the packet.  */
+                    _nx_packet_release(packet_ptr);
                 }
-            }
 
-            /* Move to the next listen request.  */
-            listen_ptr =  listen_ptr -> nx_tcp_listen_next;
-        } while (listen_ptr != ip_ptr -> nx_ip_tcp_active_listen_requests);
+                /* Finished processing, just return.  */
+                return;
+            }
+        }
     }
 
 #ifndef NX_DISABLE_TCP_INFO
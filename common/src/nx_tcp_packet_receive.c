@@ -76,6 +76,10 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), queued   */
+/*                                            TCP segments of a received  */
+/*                                            burst, resulting in version */
+/*                                            6.x                         */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_tcp_packet_receive(NX_IP *ip_ptr, NX_PACKET *packet_ptr)
@@ -144,6 +148,41 @@ TX_INTERRUPT_SAVE_AREA
         /* Wakeup IP thread for processing one or more messages in the TCP queue.  */
         tx_event_flags_set(&(ip_ptr -> nx_ip_events), NX_IP_TCP_EVENT, TX_OR);
     }
+#ifdef NX_ENABLE_TCP_GRO
+    else if ((ip_ptr -> nx_ip_tcp_gro_batch) && (_tx_thread_current_ptr == &(ip_ptr -> nx_ip_thread)))
+    {
+
+        /* The IP helper thread is processing a burst of received packets.  Place the packet at
+           the end of the TCP message queue, which the IP helper thread processes after the burst
+           so that the in-order segments of a connection are coalesced.  */
+
+        /* Disable interrupts.  */
+        TX_DISABLE
+
+        /* Add the packet to the TCP message queue.  */
+        if (ip_ptr -> nx_ip_tcp_queue_head)
+        {
+
+            /* Link the current packet at the end of the queue.  */
+            (ip_ptr -> nx_ip_tcp_queue_tail) -> nx_packet_queue_next =  packet_ptr;
+            ip_ptr -> nx_ip_tcp_received_packet_count++;
+        }
+        else
+        {
+
+            /* Empty queue, add to the head of the TCP message queue.  */
+            ip_ptr -> nx_ip_tcp_queue_head =             packet_ptr;
+            ip_ptr -> nx_ip_tcp_received_packet_count =  1;
+        }
+
+        /* Update the tail of the queue.  */
+        ip_ptr -> nx_ip_tcp_queue_tail =      packet_ptr;
+        packet_ptr -> nx_packet_queue_next =  NX_NULL;
+
+        /* Restore interrupts.  */
+        TX_RESTORE
+    }
+#endif /* NX_ENABLE_TCP_GRO */
     else
     {
 
@@ -59,6 +59,7 @@
 /*    _nx_packet_allocate                   Allocate a packet             */
 /*    _nx_tcp_checksum                      Calculate TCP checksum        */
 /*    _nx_ip_packet_send                    Send IP packet                */
+/*    _nx_tcp_sack_option_build             Build SACK option             */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -83,6 +84,10 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            supported TCP checksum      */
+/*                                            offload, added SACK option, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_tcp_packet_send_ack(NX_TCP_SOCKET *socket_ptr, ULONG tx_sequence)
@@ -92,14 +97,31 @@ NX_IP         *ip_ptr;
 NX_PACKET     *packet_ptr;
 NX_TCP_HEADER *tcp_header_ptr;
 ULONG          checksum;
+ULONG          option_length =  0;
+#ifdef NX_ENABLE_TCP_SACK
+ULONG          option_words[1 + (NX_TCP_SACK_BLOCKS_MAXIMUM << 1)];
+ULONG         *option_ptr;
+UINT           i;
+#endif /* NX_ENABLE_TCP_SACK */
 
 
     /* Setup the IP pointer.  */
     ip_ptr =  socket_ptr -> nx_tcp_socket_ip_ptr;
 
+#ifdef NX_ENABLE_TCP_SACK
+
+    /* Determine if out-of-order data may be reported to the peer.  */
+    if (socket_ptr -> nx_tcp_socket_sack_permitted == NX_TRUE)
+    {
+
+        /* Yes, build the SACK option for the out-of-order data, if any.  */
+        option_length =  _nx_tcp_sack_option_build(socket_ptr, option_words) * sizeof(ULONG);
+    }
+#endif /* NX_ENABLE_TCP_SACK */
+
     /* Allocate a packet for the ACK message.  */
     if (_nx_packet_allocate(ip_ptr -> nx_ip_default_packet_pool,
-                            &packet_ptr, NX_TCP_PACKET, NX_NO_WAIT) != NX_SUCCESS)
+                            &packet_ptr, NX_TCP_PACKET + option_length, NX_NO_WAIT) != NX_SUCCESS)
     {
 
         /* Just give up and return.  */
@@ -110,10 +132,10 @@ ULONG          checksum;
     packet_ptr -> nx_packet_ip_interface = socket_ptr -> nx_tcp_socket_connect_interface;
     packet_ptr -> nx_packet_next_hop_address = socket_ptr -> nx_tcp_socket_next_hop_address;
     /* Setup the packet payload pointers and length for a basic TCP packet.  */
-    packet_ptr -> nx_packet_prepend_ptr -= sizeof(NX_TCP_HEADER);
+    packet_ptr -> nx_packet_prepend_ptr -= sizeof(NX_TCP_HEADER) + option_length;
 
     /* Setup the packet length.  */
-    packet_ptr -> nx_packet_length =  sizeof(NX_TCP_HEADER);
+    packet_ptr -> nx_packet_length =  sizeof(NX_TCP_HEADER) + option_length;
 
     /* Pickup the pointer to the head of the TCP packet.  */
     tcp_header_ptr =  (NX_TCP_HEADER *)packet_ptr -> nx_packet_prepend_ptr;
@@ -123,10 +145,10 @@ ULONG          checksum;
     tcp_header_ptr -> nx_tcp_sequence_number =      tx_sequence;
     tcp_header_ptr -> nx_tcp_acknowledgment_number = socket_ptr -> nx_tcp_socket_rx_sequence;
 #ifdef NX_ENABLE_TCP_WINDOW_SCALING
-    tcp_header_ptr -> nx_tcp_header_word_3 =        NX_TCP_HEADER_SIZE | NX_TCP_ACK_BIT | (socket_ptr -> nx_tcp_socket_rx_window_current >> socket_ptr -> nx_tcp_rcv_win_scale_value);
+    tcp_header_ptr -> nx_tcp_header_word_3 =        (NX_TCP_HEADER_SIZE + ((option_length / sizeof(ULONG)) << NX_TCP_HEADER_SHIFT)) | NX_TCP_ACK_BIT | (socket_ptr -> nx_tcp_socket_rx_window_current >> socket_ptr -> nx_tcp_rcv_win_scale_value);
 
 #else /* !NX_ENABLE_TCP_WINDOW_SCALING */
-    tcp_header_ptr -> nx_tcp_header_word_3 =        NX_TCP_HEADER_SIZE | NX_TCP_ACK_BIT | (socket_ptr -> nx_tcp_socket_rx_window_current);
+    tcp_header_ptr -> nx_tcp_header_word_3 =        (NX_TCP_HEADER_SIZE + ((option_length / sizeof(ULONG)) << NX_TCP_HEADER_SHIFT)) | NX_TCP_ACK_BIT | (socket_ptr -> nx_tcp_socket_rx_window_current);
 #endif /* NX_ENABLE_TCP_WINDOW_SCALING */
     tcp_header_ptr -> nx_tcp_header_word_4 =        0;
 
@@ -145,9 +167,33 @@ ULONG          checksum;
     NX_CHANGE_ULONG_ENDIAN(tcp_header_ptr -> nx_tcp_header_word_3);
     NX_CHANGE_ULONG_ENDIAN(tcp_header_ptr -> nx_tcp_header_word_4);
 
+#ifdef NX_ENABLE_TCP_SACK
+
+    /* Place the SACK option, if any, after the TCP header.  */
+    option_ptr =  (ULONG *)(tcp_header_ptr + 1);
+    for (i = 0; i < (option_length / sizeof(ULONG)); i++)
+    {
+        option_ptr[i] =  option_words[i];
+        NX_CHANGE_ULONG_ENDIAN(option_ptr[i]);
+    }
+#endif /* NX_ENABLE_TCP_SACK */
+
     /* Calculate the TCP checksum.  */
 #ifndef NX_DISABLE_TCP_TX_CHECKSUM
-    checksum =  _nx_tcp_checksum(packet_ptr, packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_address, socket_ptr -> nx_tcp_socket_connect_ip);
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+    /* Determine if the interface computes the TCP checksum.  */
+    if (packet_ptr -> nx_packet_ip_interface -> nx_interface_capability_flag & NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM)
+    {
+
+        /* Yes, leave the checksum to the interface.  */
+        checksum =  0;
+        packet_ptr -> nx_packet_interface_capability_flag |=  NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM;
+    }
+    else
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+    {
+        checksum =  _nx_tcp_checksum(packet_ptr, packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_address, socket_ptr -> nx_tcp_socket_connect_ip);
+    }
 #else
     checksum = 0;
 #endif
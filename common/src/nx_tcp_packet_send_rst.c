@@ -74,6 +74,10 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            supported TCP checksum      */
+/*                                            offload, resulting in       */
+/*                                            version 6.x                 */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_tcp_packet_send_rst(NX_TCP_SOCKET *socket_ptr, NX_TCP_HEADER *header_ptr)
@@ -170,7 +174,20 @@ ULONG          checksum;
 
     /* Calculate the TCP checksum.  */
 #ifndef NX_DISABLE_TCP_TX_CHECKSUM
-    checksum = _nx_tcp_checksum(packet_ptr, packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_address, socket_ptr -> nx_tcp_socket_connect_ip);
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+    /* Determine if the interface computes the TCP checksum.  */
+    if (packet_ptr -> nx_packet_ip_interface -> nx_interface_capability_flag & NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM)
+    {
+
+        /* Yes, leave the checksum to the interface.  */
+        checksum =  0;
+        packet_ptr -> nx_packet_interface_capability_flag |=  NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM;
+    }
+    else
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+    {
+        checksum = _nx_tcp_checksum(packet_ptr, packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_address, socket_ptr -> nx_tcp_socket_connect_ip);
+    }
 #else
     checksum = 0;
 #endif
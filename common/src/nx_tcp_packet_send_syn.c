@@ -77,6 +77,11 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            supported TCP checksum      */
+/*                                            offload, added SACK         */
+/*                                            permitted option, resulting */
+/*                                            in version 6.x              */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_tcp_packet_send_syn(NX_TCP_SOCKET *socket_ptr, ULONG tx_sequence)
@@ -92,6 +97,9 @@ ULONG       mss;
 UINT        include_window_scaling = NX_FALSE;
 UINT        scale_factor;
 #endif /* NX_ENABLE_TCP_WINDOW_SCALING */
+#ifdef NX_ENABLE_TCP_SACK
+ULONG       option_word3 = NX_TCP_OPTION_END;
+#endif /* NX_ENABLE_TCP_SACK */
 
     /* Setup the IP pointer.  */
     ip_ptr =  socket_ptr -> nx_tcp_socket_ip_ptr;
@@ -185,6 +193,18 @@ UINT        scale_factor;
 
 #endif /* NX_ENABLE_TCP_WINDOW_SCALING */
 
+#ifdef NX_ENABLE_TCP_SACK
+
+    /* Offer SACK if we initiate the SYN, or accept it if the peer offered it.  */
+    if ((socket_ptr -> nx_tcp_socket_state == NX_TCP_SYN_SENT) ||
+        (socket_ptr -> nx_tcp_socket_sack_permitted == NX_TRUE))
+    {
+
+        /* Sets the SACK permitted option.  */
+        option_word3 =  NX_TCP_SACK_PERMITTED_OPTION;
+    }
+#endif /* NX_ENABLE_TCP_SACK */
+
     mss = socket_ptr -> nx_tcp_socket_connect_interface -> nx_interface_ip_mtu_size - sizeof(NX_IP_HEADER) - sizeof(NX_TCP_HEADER);
 
     mss &= 0x0000FFFFUL;
@@ -218,6 +238,9 @@ UINT        scale_factor;
     tcp_header_ptr -> nx_tcp_header_word_4 =        0;
     tcp_header_ptr -> nx_tcp_option_word_1 =        NX_TCP_MSS_OPTION | mss;
     tcp_header_ptr -> nx_tcp_option_word_2 =        option_word2;
+#ifdef NX_ENABLE_TCP_SACK
+    tcp_header_ptr -> nx_tcp_option_word_3 =        option_word3;
+#endif /* NX_ENABLE_TCP_SACK */
 
     /* If trace is enabled, insert this event into the trace buffer.  */
     NX_TRACE_IN_LINE_INSERT(NX_TRACE_INTERNAL_TCP_SYN_SEND, ip_ptr, socket_ptr, packet_ptr, tx_sequence, NX_TRACE_INTERNAL_EVENTS, 0, 0)
@@ -231,10 +254,26 @@ UINT        scale_factor;
     NX_CHANGE_ULONG_ENDIAN(tcp_header_ptr -> nx_tcp_header_word_4);
     NX_CHANGE_ULONG_ENDIAN(tcp_header_ptr -> nx_tcp_option_word_1);
     NX_CHANGE_ULONG_ENDIAN(tcp_header_ptr -> nx_tcp_option_word_2);
+#ifdef NX_ENABLE_TCP_SACK
+    NX_CHANGE_ULONG_ENDIAN(tcp_header_ptr -> nx_tcp_option_word_3);
+#endif /* NX_ENABLE_TCP_SACK */
 
     /* Calculate the TCP checksum.  */
 #ifndef NX_DISABLE_TCP_TX_CHECKSUM
-    checksum =  _nx_tcp_checksum(packet_ptr, packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_address, socket_ptr -> nx_tcp_socket_connect_ip);
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+    /* Determine if the interface computes the TCP checksum.  */
+    if (packet_ptr -> nx_packet_ip_interface -> nx_interface_capability_flag & NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM)
+    {
+
+        /* Yes, leave the checksum to the interface.  */
+        checksum =  0;
+        packet_ptr -> nx_packet_interface_capability_flag |=  NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM;
+    }
+    else
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+    {
+        checksum =  _nx_tcp_checksum(packet_ptr, packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_address, socket_ptr -> nx_tcp_socket_connect_ip);
+    }
 #else
     checksum = 0;
 #endif
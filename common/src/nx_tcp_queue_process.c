@@ -53,6 +53,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _nx_tcp_gro_merge                     Coalesce TCP segments         */
 /*    _nx_tcp_packet_process                Process TCP packet            */
 /*                                                                        */
 /*  CALLED BY                                                             */
@@ -66,6 +67,10 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            supported TCP receive       */
+/*                                            coalescing, resulting in    */
+/*                                            version 6.x                 */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_tcp_queue_process(NX_IP *ip_ptr)
@@ -100,6 +105,12 @@ NX_PACKET *packet_ptr;
         queue_head =  queue_head -> nx_packet_queue_next;
         packet_ptr -> nx_packet_queue_next =  NX_NULL;
 
+#ifdef NX_ENABLE_TCP_GRO
+
+        /* Coalesce the in-order segments of the same connection that follow the packet.  */
+        queue_head =  _nx_tcp_gro_merge(ip_ptr, packet_ptr, queue_head);
+#endif /* NX_ENABLE_TCP_GRO */
+
         /* Process the packet.  */
         _nx_tcp_packet_process(ip_ptr, packet_ptr);
     }
@@ -0,0 +1,213 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_packet.h"
+#include "nx_tcp.h"
+
+
+#ifdef NX_ENABLE_TCP_SACK
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_sack_option_build                           PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function builds the SACK option for an outgoing ACK from the   */
+/*    out-of-order data on the socket's receive queue. Contiguous out-of- */
+/*    order packets are reported as one block. The block holding the most */
+/*    recently received out-of-order segment comes first, followed by the */
+/*    lowest other blocks, as recommended by RFC 2018. The option words   */
+/*    are built in host byte order.                                       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to socket             */
+/*    option_ptr                            Pointer to option words       */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    option_words                          Number of option words built  */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_packet_send_ack               Send ACK message              */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_tcp_sack_option_build(NX_TCP_SOCKET *socket_ptr, ULONG *option_ptr)
+{
+
+NX_PACKET        *packet_ptr;
+NX_TCP_HEADER    *header_ptr;
+NX_TCP_SACK_BLOCK block[NX_TCP_SACK_BLOCKS_MAXIMUM];
+NX_TCP_SACK_BLOCK recent_block;
+ULONG             header_length;
+ULONG             begin_sequence =  0;
+ULONG             end_sequence =  0;
+ULONG             block_begin =  0;
+ULONG             block_end =  0;
+UINT              block_valid =  NX_FALSE;
+UINT              recent_valid =  NX_FALSE;
+UINT              count =  0;
+UINT              i;
+
+
+    /* Pickup the head of the receive queue.  */
+    packet_ptr =  socket_ptr -> nx_tcp_socket_receive_queue_head;
+
+    /* Loop through the receive queue, collecting the out-of-order data into blocks.  */
+    for (;;)
+    {
+
+        /* Skip the in-order packets waiting to be received.  */
+        while ((packet_ptr) && (packet_ptr != (NX_PACKET *)NX_PACKET_ENQUEUED) &&
+               (packet_ptr -> nx_packet_queue_next == (NX_PACKET *)NX_PACKET_READY))
+        {
+            packet_ptr =  packet_ptr -> nx_packet_tcp_queue_next;
+        }
+
+        /* Determine if we are at the end of the queue.  */
+        if (packet_ptr == (NX_PACKET *)NX_PACKET_ENQUEUED)
+        {
+            packet_ptr =  NX_NULL;
+        }
+
+        /* Determine if there is another out-of-order packet.  */
+        if (packet_ptr)
+        {
+
+            /* Setup a pointer to the TCP header of this packet.  */
+            header_ptr =  (NX_TCP_HEADER *)packet_ptr -> nx_packet_prepend_ptr;
+
+            /* Calculate the header size for this packet.  */
+            header_length =  (header_ptr -> nx_tcp_header_word_3 >> NX_TCP_HEADER_SHIFT) * sizeof(ULONG);
+
+            /* Compute the sequence numbers of the data in this packet.  */
+            begin_sequence =  header_ptr -> nx_tcp_sequence_number;
+            end_sequence =    begin_sequence + packet_ptr -> nx_packet_length - header_length;
+
+            /* Move to the next packet.  */
+            packet_ptr =  packet_ptr -> nx_packet_tcp_queue_next;
+
+            /* Determine if the data continues the current block.  */
+            if ((block_valid) && (begin_sequence == block_end))
+            {
+
+                /* Yes, extend the block.  */
+                block_end =  end_sequence;
+                continue;
+            }
+        }
+
+        /* The current block, if any, is complete.  */
+        if (block_valid)
+        {
+
+            /* Determine if it holds the most recently received segment.  */
+            if ((recent_valid == NX_FALSE) &&
+                ((INT)(socket_ptr -> nx_tcp_socket_sack_recent - block_begin) >= 0) &&
+                ((INT)(block_end - socket_ptr -> nx_tcp_socket_sack_recent) > 0))
+            {
+
+                /* Yes, it is reported first.  */
+                recent_block.nx_tcp_sack_block_begin =  block_begin;
+                recent_block.nx_tcp_sack_block_end =    block_end;
+                recent_valid =  NX_TRUE;
+            }
+            else if (count < NX_TCP_SACK_BLOCKS_MAXIMUM)
+            {
+
+                /* Record the block.  */
+                block[count].nx_tcp_sack_block_begin =  block_begin;
+                block[count].nx_tcp_sack_block_end =    block_end;
+                count++;
+            }
+        }
+
+        /* Determine if the whole queue has been examined.  */
+        if (packet_ptr == NX_NULL)
+        {
+            break;
+        }
+
+        /* Start a new block with this packet.  */
+        block_begin =  begin_sequence;
+        block_end =    end_sequence;
+        block_valid =  NX_TRUE;
+    }
+
+    /* Determine if the most recent block must displace one of the others.  */
+    if ((recent_valid) && (count == NX_TCP_SACK_BLOCKS_MAXIMUM))
+    {
+        count--;
+    }
+
+    /* Determine if there is any out-of-order data to report.  */
+    if ((recent_valid == NX_FALSE) && (count == 0))
+    {
+        return(0);
+    }
+
+    /* Build the option kind and length.  */
+    *option_ptr++ =  NX_TCP_SACK_OPTION | (2 + ((count + recent_valid) << 3));
+
+    /* Place the most recent block first.  */
+    if (recent_valid)
+    {
+        *option_ptr++ =  recent_block.nx_tcp_sack_block_begin;
+        *option_ptr++ =  recent_block.nx_tcp_sack_block_end;
+    }
+
+    /* Place the other blocks.  */
+    for (i = 0; i < count; i++)
+    {
+        *option_ptr++ =  block[i].nx_tcp_sack_block_begin;
+        *option_ptr++ =  block[i].nx_tcp_sack_block_end;
+    }
+
+    /* Return the number of option words.  */
+    return(1 + ((count + recent_valid) << 1));
+}
+#endif /* NX_ENABLE_TCP_SACK */
+
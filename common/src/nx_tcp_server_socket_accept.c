@@ -58,6 +58,7 @@
 /*                                                                        */
 /*    _nx_tcp_packet_send_syn               Send SYN message              */
 /*    _nx_tcp_socket_thread_suspend         Suspend thread for connection */
+/*    _nx_tcp_socket_timer_update           Update socket timers          */
 /*    tx_mutex_get                          Obtain a protection mutex     */
 /*    tx_mutex_put                          Release a protection mutex    */
 /*    rand                                  Random number for sequence    */
@@ -73,6 +74,12 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            TCP timer wheel, added      */
+/*                                            round-trip time reset,      */
+/*                                            added reassembly index      */
+/*                                            reset, resulting in version */
+/*                                            6.x                         */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_tcp_server_socket_accept(NX_TCP_SOCKET *socket_ptr, ULONG wait_option)
@@ -145,7 +152,17 @@ NX_IP *ip_ptr;
             /* Increment the sequence number.  */
             socket_ptr -> nx_tcp_socket_tx_sequence++;
 
+#ifdef NX_ENABLE_TCP_RTT_ESTIMATION
+
+            /* Start the new connection from the configured timeout with no round-trip time estimate.  */
+            socket_ptr -> nx_tcp_socket_timeout_rate =  socket_ptr -> nx_tcp_socket_timeout_rate_default;
+            socket_ptr -> nx_tcp_socket_rtt_srtt =      0;
+            socket_ptr -> nx_tcp_socket_rtt_rttvar =    0;
+            socket_ptr -> nx_tcp_socket_rtt_active =    NX_FALSE;
+#endif /* NX_ENABLE_TCP_RTT_ESTIMATION */
+
             /* Setup a timeout so the connection attempt can be sent again.  */
+            _nx_tcp_socket_timer_update(socket_ptr);
             socket_ptr -> nx_tcp_socket_timeout =          socket_ptr -> nx_tcp_socket_timeout_rate;
             socket_ptr -> nx_tcp_socket_timeout_retries =  0;
 
@@ -164,6 +181,9 @@ NX_IP *ip_ptr;
             socket_ptr -> nx_tcp_socket_receive_queue_count =  0;
             socket_ptr -> nx_tcp_socket_receive_queue_head  =  NX_NULL;
             socket_ptr -> nx_tcp_socket_receive_queue_tail  =  NX_NULL;
+#ifdef NX_ENABLE_TCP_REASSEMBLY_INDEX
+            socket_ptr -> nx_tcp_socket_reassembly_count =    0;
+#endif /* NX_ENABLE_TCP_REASSEMBLY_INDEX */
 
 
             /* Send the SYN+ACK message.  */
@@ -74,6 +74,10 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            listen request to listen    */
+/*                                            table, resulting in version */
+/*                                            6.x                         */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_tcp_server_socket_listen(NX_IP *ip_ptr, UINT port, NX_TCP_SOCKET *socket_ptr, UINT listen_queue_size,
@@ -117,32 +121,27 @@ struct NX_TCP_LISTEN_STRUCT *tail_ptr;
     /* Clean connected interface. */
     socket_ptr -> nx_tcp_socket_connect_interface = NX_NULL;
 
-    /* Search through the active listen requests to see if there is already
+    /* Search through the listen requests on this port index to see if there is already
        one active.  */
-    listen_ptr =  ip_ptr -> nx_ip_tcp_active_listen_requests;
-    if (listen_ptr)
+    listen_ptr =  ip_ptr -> nx_ip_tcp_listen_table[NX_TCP_LISTEN_HASH(port)];
+    while (listen_ptr)
     {
 
-        /* Search the active listen requests for this port.  */
-        do
+        /* Determine if there is another listen request for the same port.  */
+        if (listen_ptr -> nx_tcp_listen_port == port)
         {
 
-            /* Determine if there is another listen request for the same port.  */
-            if (listen_ptr -> nx_tcp_listen_port == port)
-            {
+            /* This is a duplicate request, return an error.  */
 
-                /* This is a duplicate request, return an error.  */
+            /* Release the protection.  */
+            tx_mutex_put(&(ip_ptr -> nx_ip_protection));
 
-                /* Release the protection.  */
-                tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+            /* Return the error code.  */
+            return(NX_DUPLICATE_LISTEN);
+        }
 
-                /* Return the error code.  */
-                return(NX_DUPLICATE_LISTEN);
-            }
-
-            /* Move to the next listen request.  */
-            listen_ptr =  listen_ptr -> nx_tcp_listen_next;
-        } while (listen_ptr != ip_ptr -> nx_ip_tcp_active_listen_requests);
+        /* Move to the next listen request on this index.  */
+        listen_ptr =  listen_ptr -> nx_tcp_listen_hash_next;
     }
 
     /* Okay, we have a new listen request.  */
@@ -209,6 +208,10 @@ struct NX_TCP_LISTEN_STRUCT *tail_ptr;
         listen_ptr -> nx_tcp_listen_next =            listen_ptr;
     }
 
+    /* Link the listen request on the listen table index of this port.  */
+    listen_ptr -> nx_tcp_listen_hash_next =  ip_ptr -> nx_ip_tcp_listen_table[NX_TCP_LISTEN_HASH(port)];
+    ip_ptr -> nx_ip_tcp_listen_table[NX_TCP_LISTEN_HASH(port)] =  listen_ptr;
+
     /* Successful listen request, release the protection.  */
     tx_mutex_put(&(ip_ptr -> nx_ip_protection));
 
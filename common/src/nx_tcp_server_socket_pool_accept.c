@@ -0,0 +1,162 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_tcp.h"
+
+
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_server_socket_pool_accept                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function removes the oldest established connection from the    */
+/*    accept queue of the listen request on the specified port.  The      */
+/*    returned socket no longer belongs to the socket pool; once the      */
+/*    application is done with it, it must be unaccepted before it is     */
+/*    added to the pool again.  Connections that are no longer            */
+/*    established are skipped.  This function does not wait, the          */
+/*    application is told of new connections by the establish notify      */
+/*    callback of the pooled sockets.                                     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                Pointer to IP instance        */
+/*    port                                  TCP port number               */
+/*    socket_ptr                            Destination for the pointer   */
+/*                                            to the connected socket     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    tx_mutex_get                          Obtain protection mutex       */
+/*    tx_mutex_put                          Release protection mutex      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_tcp_server_socket_pool_accept(NX_IP *ip_ptr, UINT port, NX_TCP_SOCKET **socket_ptr)
+{
+
+#ifdef NX_ENABLE_TCP_LISTEN_POOL
+struct NX_TCP_LISTEN_STRUCT *listen_ptr;
+NX_TCP_SOCKET               *accepted_ptr;
+
+
+    /* Obtain the IP protection.  */
+    tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
+
+    /* Search for the active listen request on this port.  */
+    listen_ptr =  ip_ptr -> nx_ip_tcp_listen_table[NX_TCP_LISTEN_HASH(port)];
+    while ((listen_ptr) && (listen_ptr -> nx_tcp_listen_port != port))
+    {
+
+        /* Move to the next listen request on the same hashed port index.  */
+        listen_ptr =  listen_ptr -> nx_tcp_listen_hash_next;
+    }
+
+    /* Determine if a listen request was found.  */
+    if (listen_ptr == NX_NULL)
+    {
+
+        /* Release the protection mutex.  */
+        tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+        /* Return the entry not found error code.  */
+        return(NX_ENTRY_NOT_FOUND);
+    }
+
+    /* Loop through the accept queue for the oldest connection that is still established.  */
+    do
+    {
+
+        /* Pickup the oldest connection.  */
+        accepted_ptr =  listen_ptr -> nx_tcp_listen_accept_head;
+        if (accepted_ptr == NX_NULL)
+        {
+
+            /* Release the protection mutex.  */
+            tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+            /* Return the not found error code, no connection is waiting.  */
+            return(NX_NOT_FOUND);
+        }
+
+        /* Remove the socket from the accept queue.  */
+        listen_ptr -> nx_tcp_listen_accept_head =  accepted_ptr -> nx_tcp_socket_listen_pool_next;
+        if (listen_ptr -> nx_tcp_listen_accept_head == NX_NULL)
+        {
+
+            /* The accept queue is empty now.  */
+            listen_ptr -> nx_tcp_listen_accept_tail =  NX_NULL;
+        }
+        listen_ptr -> nx_tcp_listen_accept_count--;
+
+        /* The socket now belongs to the application.  A socket that has left the
+           established states is skipped, the application has seen it disconnect.  */
+        accepted_ptr -> nx_tcp_socket_listen_pool_next =  NX_NULL;
+        accepted_ptr -> nx_tcp_socket_listen_pool =  NX_NULL;
+    } while ((accepted_ptr -> nx_tcp_socket_state != NX_TCP_ESTABLISHED) &&
+             (accepted_ptr -> nx_tcp_socket_state != NX_TCP_CLOSE_WAIT));
+
+    /* Release the protection mutex.  */
+    tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+    /* Return the connected socket.  */
+    *socket_ptr =  accepted_ptr;
+
+    /* Return success.  */
+    return(NX_SUCCESS);
+#else
+    NX_PARAMETER_NOT_USED(ip_ptr);
+    NX_PARAMETER_NOT_USED(port);
+    NX_PARAMETER_NOT_USED(socket_ptr);
+
+    return(NX_NOT_SUPPORTED);
+#endif /* NX_ENABLE_TCP_LISTEN_POOL */
+}
+
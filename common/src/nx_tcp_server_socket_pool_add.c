@@ -0,0 +1,157 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_tcp.h"
+
+
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_server_socket_pool_add                      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function adds a closed, unbound server socket to the idle      */
+/*    socket pool of an active listen request.  Whenever the listen       */
+/*    request has no listen socket, the next idle socket takes its place  */
+/*    so connection requests are answered without waiting for the         */
+/*    application to relisten.  Established connections are then taken    */
+/*    from the listen request with _nx_tcp_server_socket_pool_accept.     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                Pointer to IP instance        */
+/*    port                                  TCP port number               */
+/*    socket_ptr                            Server socket pointer         */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_tcp_listen_pool_arm               Arm next pooled socket        */
+/*    tx_mutex_get                          Obtain protection mutex       */
+/*    tx_mutex_put                          Release protection mutex      */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_tcp_server_socket_pool_add(NX_IP *ip_ptr, UINT port, NX_TCP_SOCKET *socket_ptr)
+{
+
+#ifdef NX_ENABLE_TCP_LISTEN_POOL
+struct NX_TCP_LISTEN_STRUCT *listen_ptr;
+
+
+    /* Obtain the IP protection.  */
+    tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
+
+    /* Determine if the server socket is in a proper state.  */
+    if (socket_ptr -> nx_tcp_socket_state != NX_TCP_CLOSED)
+    {
+
+        /* Release the protection mutex.  */
+        tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+        /* Return the not closed error code.  */
+        return(NX_NOT_CLOSED);
+    }
+
+    /* Determine if the server socket has already been bound to port, if a socket bind is
+       already pending from another thread or if the socket already belongs to a pool.  */
+    if ((socket_ptr -> nx_tcp_socket_bound_next) ||
+        (socket_ptr -> nx_tcp_socket_bind_in_progress) ||
+        (socket_ptr -> nx_tcp_socket_listen_pool))
+    {
+
+        /* Release the protection mutex.  */
+        tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+        /* Return an already bound error code.  */
+        return(NX_ALREADY_BOUND);
+    }
+
+    /* Search for the active listen request on this port.  */
+    listen_ptr =  ip_ptr -> nx_ip_tcp_listen_table[NX_TCP_LISTEN_HASH(port)];
+    while ((listen_ptr) && (listen_ptr -> nx_tcp_listen_port != port))
+    {
+
+        /* Move to the next listen request on the same hashed port index.  */
+        listen_ptr =  listen_ptr -> nx_tcp_listen_hash_next;
+    }
+
+    /* Determine if a listen request was found.  */
+    if (listen_ptr == NX_NULL)
+    {
+
+        /* Release the protection mutex.  */
+        tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+        /* Return the invalid relisten error code, the port is not being listened on.  */
+        return(NX_INVALID_RELISTEN);
+    }
+
+    /* Place the socket at the front of the idle pool.  */
+    socket_ptr -> nx_tcp_socket_listen_pool =  listen_ptr;
+    socket_ptr -> nx_tcp_socket_listen_pool_next =  listen_ptr -> nx_tcp_listen_pool_head;
+    listen_ptr -> nx_tcp_listen_pool_head =  socket_ptr;
+    listen_ptr -> nx_tcp_listen_pool_count++;
+
+    /* If the listen request has no listen socket, the new socket takes its place.  */
+    _nx_tcp_listen_pool_arm(ip_ptr, listen_ptr);
+
+    /* Release the protection mutex.  */
+    tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+    /* Return success.  */
+    return(NX_SUCCESS);
+#else
+    NX_PARAMETER_NOT_USED(ip_ptr);
+    NX_PARAMETER_NOT_USED(port);
+    NX_PARAMETER_NOT_USED(socket_ptr);
+
+    return(NX_NOT_SUPPORTED);
+#endif /* NX_ENABLE_TCP_LISTEN_POOL */
+}
+
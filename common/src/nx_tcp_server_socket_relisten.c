@@ -59,6 +59,8 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _nx_packet_release                    Release packet                */
+/*    _nx_tcp_connection_table_insert       Insert into connection table  */
+/*    _nx_tcp_sack_permitted_option_get     Get peer SACK permitted       */
 /*    tx_mutex_get                          Obtain protection mutex       */
 /*    tx_mutex_put                          Release protection mutex      */
 /*                                                                        */
@@ -73,6 +75,10 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            TCP connection table, added */
+/*                                            SACK negotiation, resulting */
+/*                                            in version 6.x              */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_tcp_server_socket_relisten(NX_IP *ip_ptr, UINT port, NX_TCP_SOCKET *socket_ptr)
@@ -90,6 +96,9 @@ ULONG                        option_words;
 #ifdef NX_ENABLE_TCP_WINDOW_SCALING
 ULONG                        rwin_scale;
 #endif /* NX_ENABLE_TCP_WINDOW_SCALING */
+#ifdef NX_ENABLE_TCP_SACK
+UINT                         sack_permitted = NX_FALSE;
+#endif /* NX_ENABLE_TCP_SACK */
 VOID                       (*listen_callback)(NX_TCP_SOCKET *socket_ptr, UINT port);
 
 
@@ -218,6 +227,10 @@ VOID                       (*listen_callback)(NX_TCP_SOCKET *socket_ptr, UINT po
 #ifdef NX_ENABLE_TCP_WINDOW_SCALING
                             _nx_tcp_window_scaling_option_get((packet_ptr -> nx_packet_prepend_ptr + sizeof(NX_TCP_HEADER)), option_words * sizeof(ULONG), &rwin_scale);
 #endif /* NX_ENABLE_TCP_WINDOW_SCALING */
+
+#ifdef NX_ENABLE_TCP_SACK
+                            _nx_tcp_sack_permitted_option_get((packet_ptr -> nx_packet_prepend_ptr + sizeof(NX_TCP_HEADER)), option_words * sizeof(ULONG), &sack_permitted);
+#endif /* NX_ENABLE_TCP_SACK */
                         }
                     }
 
@@ -237,6 +250,9 @@ VOID                       (*listen_callback)(NX_TCP_SOCKET *socket_ptr, UINT po
 
                     socket_ptr -> nx_tcp_socket_connect_interface = packet_ptr -> nx_packet_ip_interface;
 
+                    /* Place the socket on the TCP connection table.  */
+                    _nx_tcp_connection_table_insert(ip_ptr, socket_ptr);
+
                     /* Indicate this socket is a server socket.  */
                     socket_ptr -> nx_tcp_socket_client_type =  NX_FALSE;
 
@@ -261,6 +277,12 @@ VOID                       (*listen_callback)(NX_TCP_SOCKET *socket_ptr, UINT po
                     socket_ptr -> nx_tcp_snd_win_scale_value = rwin_scale;
 #endif /* NX_ENABLE_TCP_WINDOW_SCALING */
 
+#ifdef NX_ENABLE_TCP_SACK
+                    /* Record whether the peer offered SACK.  */
+                    socket_ptr -> nx_tcp_socket_sack_permitted =  sack_permitted;
+                    socket_ptr -> nx_tcp_socket_sack_count =      0;
+#endif /* NX_ENABLE_TCP_SACK */
+
                     /* If trace is enabled, insert this event into the trace buffer.  */
                     NX_TRACE_IN_LINE_INSERT(NX_TRACE_INTERNAL_TCP_STATE_CHANGE, ip_ptr, socket_ptr, socket_ptr -> nx_tcp_socket_state, NX_TCP_LISTEN_STATE, NX_TRACE_INTERNAL_EVENTS, 0, 0)
 
@@ -55,6 +55,8 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _nx_tcp_connection_table_remove       Remove from connection table  */
+/*    _nx_tcp_listen_pool_remove            Remove socket from pool       */
 /*    _nx_tcp_socket_receive_queue_flush    Release all receive packets   */
 /*    tx_mutex_get                          Obtain a protection mutex     */
 /*    tx_mutex_put                          Release a protection mutex    */
@@ -70,6 +72,11 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            TCP connection table,       */
+/*                                            removed socket from listen  */
+/*                                            pool, resulting in version  */
+/*                                            6.x                         */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_tcp_server_socket_unaccept(NX_TCP_SOCKET *socket_ptr)
@@ -120,6 +127,15 @@ UINT                         port;
         return(NX_NOT_LISTEN_STATE);
     }
 
+#ifdef NX_ENABLE_TCP_LISTEN_POOL
+
+    /* Take the socket off the accept queue if it was never accepted from its listen pool.  */
+    _nx_tcp_listen_pool_remove(socket_ptr);
+#endif /* NX_ENABLE_TCP_LISTEN_POOL */
+
+    /* Remove the socket from the TCP connection table.  */
+    _nx_tcp_connection_table_remove(ip_ptr, socket_ptr);
+
     /* Check for a thread suspended for disconnect processing to complete.  */
     if (socket_ptr -> nx_tcp_socket_disconnect_suspended_thread)
     {
@@ -71,16 +71,26 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            removed listen request from */
+/*                                            listen table, released      */
+/*                                            listen socket pool,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_tcp_server_socket_unlisten(NX_IP *ip_ptr, UINT port)
 {
 
-NX_TCP_SOCKET               *socket_ptr;
-NX_PACKET                   *packet_ptr;
-NX_PACKET                   *next_packet_ptr;
-ULONG                        queue_count;
-struct NX_TCP_LISTEN_STRUCT *listen_ptr;
+NX_TCP_SOCKET                *socket_ptr;
+NX_PACKET                    *packet_ptr;
+NX_PACKET                    *next_packet_ptr;
+ULONG                         queue_count;
+struct NX_TCP_LISTEN_STRUCT  *listen_ptr;
+struct NX_TCP_LISTEN_STRUCT **hash_ptr;
+#ifdef NX_ENABLE_TCP_LISTEN_POOL
+NX_TCP_SOCKET                *pool_socket_ptr;
+ULONG                         sockets_count;
+#endif /* NX_ENABLE_TCP_LISTEN_POOL */
 
 
     /* If trace is enabled, insert this event into the trace buffer.  */
@@ -130,6 +140,48 @@ struct NX_TCP_LISTEN_STRUCT *listen_ptr;
                     }
                 }
 
+                /* Unlink the listen structure from the listen table index of this port.  */
+                hash_ptr =  &(ip_ptr -> nx_ip_tcp_listen_table[NX_TCP_LISTEN_HASH(port)]);
+                while (*hash_ptr != listen_ptr)
+                {
+
+                    /* Move to the next listen request on this index.  */
+                    hash_ptr =  &((*hash_ptr) -> nx_tcp_listen_hash_next);
+                }
+                *hash_ptr =  listen_ptr -> nx_tcp_listen_hash_next;
+                listen_ptr -> nx_tcp_listen_hash_next =  NX_NULL;
+
+#ifdef NX_ENABLE_TCP_LISTEN_POOL
+
+                /* Release the sockets of the listen pool.  Idle sockets stay closed, sockets
+                   that are connecting or waiting to be accepted keep their connections and
+                   are left to the application.  */
+                pool_socket_ptr =  ip_ptr -> nx_ip_tcp_created_sockets_ptr;
+                sockets_count =    ip_ptr -> nx_ip_tcp_created_sockets_count;
+                while (sockets_count--)
+                {
+
+                    /* Determine if this socket belongs to the pool of this listen request.  */
+                    if (pool_socket_ptr -> nx_tcp_socket_listen_pool == listen_ptr)
+                    {
+
+                        /* Yes, remove it from the pool.  */
+                        pool_socket_ptr -> nx_tcp_socket_listen_pool =       NX_NULL;
+                        pool_socket_ptr -> nx_tcp_socket_listen_pool_next =  NX_NULL;
+                    }
+
+                    /* Move to the next created socket.  */
+                    pool_socket_ptr =  pool_socket_ptr -> nx_tcp_socket_created_next;
+                }
+
+                /* Clear the idle pool and the accept queue.  */
+                listen_ptr -> nx_tcp_listen_pool_head =    NX_NULL;
+                listen_ptr -> nx_tcp_listen_pool_count =   0;
+                listen_ptr -> nx_tcp_listen_accept_head =  NX_NULL;
+                listen_ptr -> nx_tcp_listen_accept_tail =  NX_NULL;
+                listen_ptr -> nx_tcp_listen_accept_count = 0;
+#endif /* NX_ENABLE_TCP_LISTEN_POOL */
+
                 /* Add the listen request back to the available list.  */
                 listen_ptr -> nx_tcp_listen_next =  ip_ptr -> nx_ip_tcp_available_listen_requests;
                 ip_ptr -> nx_ip_tcp_available_listen_requests =  listen_ptr;
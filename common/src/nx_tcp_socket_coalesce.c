@@ -0,0 +1,198 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+#include "nx_packet.h"
+#include "nx_tcp.h"
+
+
+#ifdef NX_ENABLE_TCP_SEND_COALESCING
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_socket_coalesce                             PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function merges an application packet into the data held back  */
+/*    by the specified socket, and holds the result back while it is      */
+/*    smaller than MSS and either the socket is corked or, unless Nagle's */
+/*    algorithm is disabled for the socket, data is in flight. A small    */
+/*    packet is copied into the free space at the end of the held data,   */
+/*    any other packet is chained to it.                                  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to socket             */
+/*    packet_ptr                            Pointer to packet to send     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    packet_ptr                            Packet to send now, NULL if   */
+/*                                            all data is held back       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_packet_release                    Release merged packet         */
+/*    tx_mutex_get                          Obtain protection             */
+/*    tx_mutex_put                          Release protection            */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_socket_send                   Send data on TCP socket       */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+NX_PACKET  *_nx_tcp_socket_coalesce(NX_TCP_SOCKET *socket_ptr, NX_PACKET *packet_ptr)
+{
+
+NX_IP     *ip_ptr;
+NX_PACKET *held_packet;
+NX_PACKET *last_packet;
+ULONG      length;
+
+
+    /* Setup IP pointer.  */
+    ip_ptr =  socket_ptr -> nx_tcp_socket_ip_ptr;
+
+    /* Obtain the IP mutex so we can access the socket.  */
+    tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
+
+    /* Pickup the data held back by the socket.  */
+    held_packet =  socket_ptr -> nx_tcp_socket_coalesce_packet;
+
+    /* Only coalesce valid packets on a connected socket, anything else is left to the send
+       processing, which reports the error.  */
+    if ((packet_ptr -> nx_packet_tcp_queue_next != (NX_PACKET *)NX_PACKET_ALLOCATED) ||
+        ((socket_ptr -> nx_tcp_socket_state != NX_TCP_ESTABLISHED) &&
+         (socket_ptr -> nx_tcp_socket_state != NX_TCP_CLOSE_WAIT)))
+    {
+
+        /* Release protection.  */
+        tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+        /* Return the packet.  */
+        return(packet_ptr);
+    }
+
+    /* Determine if there is held data to merge the packet into.  */
+    if (held_packet)
+    {
+
+        /* Pickup the length of the packet.  */
+        length =  packet_ptr -> nx_packet_length;
+
+        /* Pickup the last buffer of the held data.  */
+        last_packet =  held_packet -> nx_packet_last;
+        if (last_packet == NX_NULL)
+        {
+            last_packet =  held_packet;
+        }
+
+        /* Determine if the packet is a single buffer that fits in the free space at the end
+           of the held data.  */
+        if ((packet_ptr -> nx_packet_next == NX_NULL) &&
+#ifdef NX_ENABLE_PACKET_CLONE
+            (last_packet -> nx_packet_clone_source == NX_NULL) &&
+#endif /* NX_ENABLE_PACKET_CLONE */
+            (length <= (ULONG)(last_packet -> nx_packet_data_end - last_packet -> nx_packet_append_ptr)))
+        {
+
+            /* Yes, copy the data of the packet to the end of the held data.  */
+            memcpy(last_packet -> nx_packet_append_ptr, packet_ptr -> nx_packet_prepend_ptr, length); /* Use case of memcpy is verified. */
+            last_packet -> nx_packet_append_ptr =  last_packet -> nx_packet_append_ptr + length;
+
+            /* Release the packet.  */
+            _nx_packet_release(packet_ptr);
+        }
+        else
+        {
+
+            /* Chain the packet to the held data.  */
+            last_packet -> nx_packet_next =  packet_ptr;
+            if (packet_ptr -> nx_packet_last)
+            {
+                held_packet -> nx_packet_last =  packet_ptr -> nx_packet_last;
+            }
+            else
+            {
+                held_packet -> nx_packet_last =  packet_ptr;
+            }
+            packet_ptr -> nx_packet_last =  NX_NULL;
+        }
+
+        /* Update the length of the held data.  */
+        held_packet -> nx_packet_length =  held_packet -> nx_packet_length + length;
+
+        /* Increment the coalesced packet and byte counts of the socket.  */
+        socket_ptr -> nx_tcp_socket_coalesced_packets++;
+        socket_ptr -> nx_tcp_socket_coalesced_bytes +=  length;
+
+#ifndef NX_DISABLE_TCP_INFO
+        /* Increment the coalesced packet and byte counts of the IP instance.  */
+        ip_ptr -> nx_ip_tcp_coalesced_packets++;
+        ip_ptr -> nx_ip_tcp_coalesced_bytes +=  length;
+#endif /* NX_DISABLE_TCP_INFO */
+
+        /* Continue with the held data.  */
+        packet_ptr =  held_packet;
+        socket_ptr -> nx_tcp_socket_coalesce_packet =  NX_NULL;
+    }
+
+    /* Determine if the data is smaller than MSS and the socket is corked, or has data in flight
+       while Nagle's algorithm is used (RFC 896, RFC 1122 section 4.2.3.4).  */
+    if ((packet_ptr -> nx_packet_length < socket_ptr -> nx_tcp_socket_connect_mss) &&
+        ((socket_ptr -> nx_tcp_socket_coalesce_options & NX_TCP_COALESCE_CORK) ||
+         (!(socket_ptr -> nx_tcp_socket_coalesce_options & NX_TCP_COALESCE_NODELAY) &&
+          (socket_ptr -> nx_tcp_socket_transmit_sent_head))))
+    {
+
+        /* Yes, hold the data back until more data is sent, all data in flight is
+           acknowledged or the socket is uncorked.  */
+        socket_ptr -> nx_tcp_socket_coalesce_packet =  packet_ptr;
+        packet_ptr =  NX_NULL;
+    }
+
+    /* Release protection.  */
+    tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+    /* Return the packet to send now.  */
+    return(packet_ptr);
+}
+#endif /* NX_ENABLE_TCP_SEND_COALESCING */
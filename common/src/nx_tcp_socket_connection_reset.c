@@ -55,6 +55,8 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _nx_tcp_listen_pool_recycle           Return socket to pool         */
+/*    _nx_tcp_listen_pool_remove            Remove socket from pool       */
 /*    _nx_tcp_socket_transmit_queue_flush   Release transmitted packets   */
 /*    _nx_tcp_socket_receive_queue_flush    Release received packets      */
 /*    _nx_tcp_connect_cleanup               Resume thread suspended       */
@@ -80,6 +82,9 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            listen socket pool,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_tcp_socket_connection_reset(NX_TCP_SOCKET *socket_ptr)
@@ -178,5 +183,27 @@ UINT saved_state;
         (socket_ptr -> nx_tcp_disconnect_complete_notify)(socket_ptr);
     }
 #endif
+
+#ifdef NX_ENABLE_TCP_LISTEN_POOL
+
+    /* Determine if the socket belongs to a listen pool.  */
+    if (socket_ptr -> nx_tcp_socket_listen_pool)
+    {
+
+        /* Determine if the connection request was lost before it was established.  */
+        if (saved_state == NX_TCP_SYN_RECEIVED)
+        {
+
+            /* Yes, return the socket to its pool to wait for the next connection request.  */
+            _nx_tcp_listen_pool_recycle(socket_ptr);
+        }
+        else
+        {
+
+            /* No, take the socket off the accept queue.  It is left to the application.  */
+            _nx_tcp_listen_pool_remove(socket_ptr);
+        }
+    }
+#endif /* NX_ENABLE_TCP_LISTEN_POOL */
 }
 
@@ -81,6 +81,11 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            default timeout for round-  */
+/*                                            trip time estimation, added */
+/*                                            default congestion control, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_tcp_socket_create(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr, CHAR *name,
@@ -132,6 +137,9 @@ NX_TCP_SOCKET *tail_ptr;
     socket_ptr -> nx_tcp_socket_timeout_rate =         _nx_tcp_transmit_timer_rate;
     socket_ptr -> nx_tcp_socket_timeout_max_retries =  NX_TCP_MAXIMUM_RETRIES;
     socket_ptr -> nx_tcp_socket_timeout_shift =        NX_TCP_RETRY_SHIFT;
+#ifdef NX_ENABLE_TCP_RTT_ESTIMATION
+    socket_ptr -> nx_tcp_socket_timeout_rate_default = _nx_tcp_transmit_timer_rate;
+#endif /* NX_ENABLE_TCP_RTT_ESTIMATION */
 
     /* Setup the default maximum transmit queue depth.  */
     socket_ptr -> nx_tcp_socket_transmit_queue_maximum_default =  NX_TCP_MAXIMUM_TX_QUEUE;
@@ -167,6 +175,9 @@ NX_TCP_SOCKET *tail_ptr;
     /* Clear the receive notify function pointer.  */
     socket_ptr -> nx_tcp_receive_callback =  NX_NULL;
 
+    /* Use NewReno congestion control until the application selects another algorithm.  */
+    socket_ptr -> nx_tcp_socket_congestion_control =  _nx_tcp_congestion_control_newreno;
+
 #ifdef NX_ENABLE_TCP_KEEPALIVE
     /* If the Keep alive feature is enabled in NetX, enable it
        on all TCP sockets. */
@@ -0,0 +1,342 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+#include "nx_packet.h"
+#include "nx_tcp.h"
+#include "tx_thread.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_socket_data_receive                         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function copies up to the specified number of received bytes   */
+/*    from the head of the receive queue of the specified socket into the */
+/*    buffer, across packet boundaries. Packets that are fully copied are */
+/*    removed and released; a partially copied packet stays at the head   */
+/*    of the queue with the copied data removed, so the next receive      */
+/*    starts with the remaining data. The receive window is updated once  */
+/*    for all copied bytes.                                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to socket             */
+/*    buffer_start                          Pointer to destination buffer */
+/*    buffer_length                         Size of destination buffer    */
+/*    bytes_copied                          Number of bytes copied        */
+/*    wait_option                           Suspension option             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_packet_release                    Release copied packet         */
+/*    _nx_tcp_packet_send_ack               Send ACK message              */
+/*    _nx_tcp_socket_thread_suspend         Suspend calling thread        */
+/*    _nx_tcp_socket_timer_update           Update socket timers          */
+/*    tx_mutex_get                          Get protection mutex          */
+/*    tx_mutex_put                          Put protection mutex          */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_tcp_socket_data_receive(NX_TCP_SOCKET *socket_ptr, VOID *buffer_start, ULONG buffer_length,
+                                  ULONG *bytes_copied, ULONG wait_option)
+{
+
+NX_IP         *ip_ptr;
+NX_TCP_HEADER *header_ptr;
+NX_PACKET     *head_packet_ptr;
+NX_PACKET     *work_ptr;
+NX_PACKET     *next_ptr;
+UCHAR         *buffer_ptr;
+ULONG          header_length;
+ULONG          remaining_bytes;
+ULONG          copy_size;
+ULONG          consumed_bytes;
+ULONG          total_bytes;
+UINT           status;
+
+
+    /* Setup the pointer to the associated IP instance.  */
+    ip_ptr =  socket_ptr -> nx_tcp_socket_ip_ptr;
+
+    /* Set the number of copied bytes to zero initially.  */
+    *bytes_copied =  0;
+
+    /* Get protection while we look at this socket.  */
+    tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
+
+    /* Loop until received data is available.  */
+    while (1)
+    {
+
+        /* Determine if the socket is currently bound.  */
+        if (!socket_ptr ->  nx_tcp_socket_bound_next)
+        {
+
+            /* Release protection.  */
+            tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+            /* Socket is not bound, return an error message.  */
+            return(NX_NOT_BOUND);
+        }
+
+        /* Pickup the first packet of the receive queue.  */
+        head_packet_ptr =  socket_ptr -> nx_tcp_socket_receive_queue_head;
+
+        /* Determine if the first packet is available and has been ACKed.  */
+        if ((head_packet_ptr) && (head_packet_ptr -> nx_packet_queue_next == ((NX_PACKET *)NX_PACKET_READY)))
+        {
+
+            /* Yes, copy the data.  */
+            break;
+        }
+
+        /* Determine if the socket can still receive data.  */
+        if ((head_packet_ptr == NX_NULL) &&
+            ((socket_ptr -> nx_tcp_socket_state <= NX_TCP_SYN_SENT)   ||
+             (socket_ptr -> nx_tcp_socket_state == NX_TCP_CLOSE_WAIT) ||
+             (socket_ptr -> nx_tcp_socket_state >= NX_TCP_CLOSING)))
+        {
+
+            /* No, release the IP protection.  */
+            tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+            /* Return an error code.  */
+            return(NX_NOT_CONNECTED);
+        }
+
+        /* Determine if the thread may wait for data.  */
+        if ((wait_option == NX_NO_WAIT) || (_tx_thread_current_ptr == &(ip_ptr -> nx_ip_thread)))
+        {
+
+            /* No, release protection.  */
+            tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+            /* Return an empty receive queue error message.  */
+            return(NX_NO_PACKET);
+        }
+
+        /* Suspend the thread on this socket's receive queue.  Without a return packet pointer,
+           the thread is resumed when data is ready and the data stays on the receive queue.  */
+        _tx_thread_current_ptr -> tx_thread_additional_suspend_info =  NX_NULL;
+
+        /* Increment the suspended thread count.  */
+        socket_ptr -> nx_tcp_socket_receive_suspended_count++;
+
+        /* Suspend the thread on the receive queue.  */
+        _nx_tcp_socket_thread_suspend(&(socket_ptr -> nx_tcp_socket_receive_suspension_list), _nx_tcp_receive_cleanup, socket_ptr, &(ip_ptr -> nx_ip_protection), wait_option);
+
+        /* Determine if the thread was resumed for received data.  */
+        status =  _tx_thread_current_ptr -> tx_thread_suspend_status;
+        if (status != NX_SUCCESS)
+        {
+
+            /* No, return the error code.  */
+            return(status);
+        }
+
+        /* Get protection again, the data may already be received by another thread.  */
+        tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
+    }
+
+    /* Setup the destination and the number of bytes to copy.  */
+    buffer_ptr =       (UCHAR *)buffer_start;
+    remaining_bytes =  buffer_length;
+    total_bytes =      0;
+
+    /* Loop to copy the data of the ready packets at the head of the queue.  */
+    while ((remaining_bytes) && (head_packet_ptr) &&
+           (head_packet_ptr -> nx_packet_queue_next == ((NX_PACKET *)NX_PACKET_READY)))
+    {
+
+        /* Setup a pointer to the TCP header of the packet and calculate its size.  */
+        header_ptr =     (NX_TCP_HEADER *)head_packet_ptr -> nx_packet_prepend_ptr;
+        header_length =  (header_ptr -> nx_tcp_header_word_3 >> NX_TCP_HEADER_SHIFT) * sizeof(ULONG);
+
+        /* Determine if the whole packet data fits in the buffer.  */
+        if ((head_packet_ptr -> nx_packet_length - header_length) <= remaining_bytes)
+        {
+
+            /* Yes, copy the data of each buffer of the packet.  */
+            consumed_bytes =  head_packet_ptr -> nx_packet_length - header_length;
+            work_ptr =  head_packet_ptr;
+            copy_size =  (ULONG)(work_ptr -> nx_packet_append_ptr - work_ptr -> nx_packet_prepend_ptr) - header_length;
+            memcpy(buffer_ptr, work_ptr -> nx_packet_prepend_ptr + header_length, copy_size); /* Use case of memcpy is verified. */
+            buffer_ptr =  buffer_ptr + copy_size;
+            for (work_ptr = work_ptr -> nx_packet_next; work_ptr; work_ptr = work_ptr -> nx_packet_next)
+            {
+                copy_size =  (ULONG)(work_ptr -> nx_packet_append_ptr - work_ptr -> nx_packet_prepend_ptr);
+                memcpy(buffer_ptr, work_ptr -> nx_packet_prepend_ptr, copy_size); /* Use case of memcpy is verified. */
+                buffer_ptr =  buffer_ptr + copy_size;
+            }
+
+            /* Remove the packet from the queue.  */
+            next_ptr =  head_packet_ptr -> nx_packet_tcp_queue_next;
+            if (head_packet_ptr == socket_ptr -> nx_tcp_socket_receive_queue_tail)
+            {
+
+                /* Only item in the queue.  Set the head and tail pointers to NULL.  */
+                socket_ptr -> nx_tcp_socket_receive_queue_head =  NX_NULL;
+                socket_ptr -> nx_tcp_socket_receive_queue_tail =  NX_NULL;
+                next_ptr =  NX_NULL;
+            }
+            else
+            {
+
+                /* Simply update the head pointer to the packet after the current.  */
+                socket_ptr -> nx_tcp_socket_receive_queue_head =  next_ptr;
+            }
+
+            /* Decrease the number of received packets.  */
+            socket_ptr -> nx_tcp_socket_receive_queue_count--;
+
+            /* Mark the packet as no longer enqueued and release it.  */
+            head_packet_ptr -> nx_packet_tcp_queue_next =  (NX_PACKET *)NX_PACKET_ALLOCATED;
+            head_packet_ptr -> nx_packet_queue_next =  NX_NULL;
+            _nx_packet_release(head_packet_ptr);
+
+            /* Move to the next packet.  */
+            head_packet_ptr =  next_ptr;
+        }
+        else
+        {
+
+            /* No, copy as much data as fits and leave the rest at the head of the queue.  */
+            consumed_bytes =  remaining_bytes;
+
+            /* Copy from the data of the first buffer, behind the TCP header.  */
+            work_ptr =   head_packet_ptr;
+            copy_size =  (ULONG)(work_ptr -> nx_packet_append_ptr - work_ptr -> nx_packet_prepend_ptr) - header_length;
+            if (copy_size > remaining_bytes)
+            {
+                copy_size =  remaining_bytes;
+            }
+            memcpy(buffer_ptr, work_ptr -> nx_packet_prepend_ptr + header_length, copy_size); /* Use case of memcpy is verified. */
+            buffer_ptr =  buffer_ptr + copy_size;
+            remaining_bytes =  remaining_bytes - copy_size;
+
+            /* Move the TCP header up to the remaining data of the first buffer.  */
+            memmove(work_ptr -> nx_packet_prepend_ptr + copy_size, work_ptr -> nx_packet_prepend_ptr, header_length); /* Use case of memmove is verified. */
+            work_ptr -> nx_packet_prepend_ptr =  work_ptr -> nx_packet_prepend_ptr + copy_size;
+            header_ptr =  (NX_TCP_HEADER *)work_ptr -> nx_packet_prepend_ptr;
+
+            /* Copy from the chained buffers, releasing the buffers that are fully copied.  */
+            while (remaining_bytes)
+            {
+                next_ptr =   (head_packet_ptr -> nx_packet_next) -> nx_packet_next;
+                work_ptr =   head_packet_ptr -> nx_packet_next;
+                copy_size =  (ULONG)(work_ptr -> nx_packet_append_ptr - work_ptr -> nx_packet_prepend_ptr);
+                if (copy_size > remaining_bytes)
+                {
+
+                    /* Copy the start of the buffer and keep the rest.  */
+                    memcpy(buffer_ptr, work_ptr -> nx_packet_prepend_ptr, remaining_bytes); /* Use case of memcpy is verified. */
+                    buffer_ptr =  buffer_ptr + remaining_bytes;
+                    work_ptr -> nx_packet_prepend_ptr =  work_ptr -> nx_packet_prepend_ptr + remaining_bytes;
+                    remaining_bytes =  0;
+                }
+                else
+                {
+
+                    /* Copy the whole buffer, then unlink and release it.  */
+                    memcpy(buffer_ptr, work_ptr -> nx_packet_prepend_ptr, copy_size); /* Use case of memcpy is verified. */
+                    buffer_ptr =  buffer_ptr + copy_size;
+                    remaining_bytes =  remaining_bytes - copy_size;
+                    head_packet_ptr -> nx_packet_next =  next_ptr;
+                    work_ptr -> nx_packet_next =  NX_NULL;
+                    _nx_packet_release(work_ptr);
+                }
+            }
+
+            /* The remaining data now starts behind the copied data.  */
+            header_ptr -> nx_tcp_sequence_number =  header_ptr -> nx_tcp_sequence_number + consumed_bytes;
+            head_packet_ptr -> nx_packet_length =  head_packet_ptr -> nx_packet_length - consumed_bytes;
+        }
+
+        /* Account for the copied data.  */
+        remaining_bytes =  buffer_length - total_bytes - consumed_bytes;
+        total_bytes =  total_bytes + consumed_bytes;
+    }
+
+    /* Return the number of copied bytes.  */
+    *bytes_copied =  total_bytes;
+
+    /* Bring the socket timers up to date, since a larger receive window may need
+       to be advertised by the delayed ACK timer.  */
+    _nx_tcp_socket_timer_update(socket_ptr);
+
+    /* Increase the receive window size once for all copied data.  */
+    socket_ptr -> nx_tcp_socket_rx_window_current += total_bytes;
+
+    /* Determine if the new size is greater than the default window size.  */
+    if (socket_ptr -> nx_tcp_socket_rx_window_current > socket_ptr -> nx_tcp_socket_rx_window_default)
+    {
+
+        /* Yes, new receive window size is greater than the socket's default,
+           adjust to the default window size.  */
+        socket_ptr -> nx_tcp_socket_rx_window_current = socket_ptr -> nx_tcp_socket_rx_window_default;
+    }
+
+    /* Determine if an ACK should be forced out for window update, SWS avoidance algorithm.
+       RFC1122, Section4.2.3.3, Page97-98. */
+    if (((socket_ptr -> nx_tcp_socket_rx_window_current - socket_ptr -> nx_tcp_socket_rx_window_last_sent) >= (socket_ptr -> nx_tcp_socket_rx_window_default / 2)) &&
+        ((socket_ptr -> nx_tcp_socket_state == NX_TCP_ESTABLISHED) || (socket_ptr -> nx_tcp_socket_state == NX_TCP_FIN_WAIT_1) || (socket_ptr -> nx_tcp_socket_state == NX_TCP_FIN_WAIT_2)))
+    {
+
+        /* Send a Window Update.  */
+        _nx_tcp_packet_send_ack(socket_ptr, socket_ptr -> nx_tcp_socket_tx_sequence);
+    }
+
+    /* Release protection.  */
+    tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+    /* Return a successful status.  */
+    return(NX_SUCCESS);
+}
+
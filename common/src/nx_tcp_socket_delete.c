@@ -54,6 +54,8 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _nx_tcp_listen_pool_remove            Remove socket from pool       */
+/*    _nx_tcp_timer_wheel_remove            Remove from timer wheel       */
 /*    tx_mutex_get                          Obtain protection mutex       */
 /*    tx_mutex_put                          Release protection mutex      */
 /*                                                                        */
@@ -68,6 +70,10 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            TCP timer wheel, removed    */
+/*                                            socket from listen pool,    */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_tcp_socket_delete(NX_TCP_SOCKET *socket_ptr)
@@ -109,6 +115,15 @@ NX_IP *ip_ptr;
         return(NX_STILL_BOUND);
     }
 
+#ifdef NX_ENABLE_TCP_LISTEN_POOL
+
+    /* Take the socket out of its listen pool.  */
+    _nx_tcp_listen_pool_remove(socket_ptr);
+#endif /* NX_ENABLE_TCP_LISTEN_POOL */
+
+    /* Remove the socket from the TCP timer wheel.  */
+    _nx_tcp_timer_wheel_remove(ip_ptr, socket_ptr);
+
     /* Disable interrupts.  */
     TX_DISABLE
 
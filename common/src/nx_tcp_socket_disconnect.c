@@ -62,6 +62,8 @@
 /*    _nx_tcp_packet_send_fin               Send FIN message              */
 /*    _nx_tcp_packet_send_rst               Send RST on no timeout        */
 /*    _nx_tcp_receive_cleanup               Clear receive suspension      */
+/*    _nx_tcp_socket_coalesce_flush         Send held data                */
+/*    _nx_tcp_socket_timer_update           Update socket timers          */
 /*    _nx_tcp_transmit_cleanup              Clear transmit suspension     */
 /*    _nx_tcp_socket_thread_suspend         Suspend calling thread        */
 /*    _nx_tcp_socket_transmit_queue_flush   Release all transmit packets  */
@@ -79,6 +81,11 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            TCP timer wheel, sent data  */
+/*                                            held back by send           */
+/*                                            coalescing, resulting in    */
+/*                                            version 6.x                 */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_tcp_socket_disconnect(NX_TCP_SOCKET *socket_ptr, ULONG wait_option)
@@ -100,6 +107,17 @@ NX_IP        *ip_ptr;
     /* Default status to success.  */
     status =  NX_SUCCESS;
 
+#ifdef NX_ENABLE_TCP_SEND_COALESCING
+
+    /* Determine if data is held back by send coalescing.  */
+    if (socket_ptr -> nx_tcp_socket_coalesce_packet)
+    {
+
+        /* Send the held data ahead of the FIN.  */
+        _nx_tcp_socket_coalesce_flush(socket_ptr, wait_option);
+    }
+#endif /* NX_ENABLE_TCP_SEND_COALESCING */
+
     /* Obtain the IP mutex so we can access socket and IP information.  */
     tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
 
@@ -122,6 +140,9 @@ NX_IP        *ip_ptr;
         return(NX_NOT_CONNECTED);
     }
 
+    /* Bring the socket timers up to date before the disconnect timeout is started.  */
+    _nx_tcp_socket_timer_update(socket_ptr);
+
 #ifdef NX_ENABLE_TCP_KEEPALIVE
     /* Clear the TCP Keepalive timer to disable it for this socket (only needed when
        the socket is connected.  */
@@ -0,0 +1,114 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+#include "nx_tcp.h"
+
+
+#ifdef NX_ENABLE_TCP_KEEPALIVE
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_socket_keepalive_set                        PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function enables or disables the keepalive timer of the        */
+/*    socket.  The socket timers are brought up to date on the TCP timer  */
+/*    wheel first, so a keepalive timer started here is picked up by the  */
+/*    fast periodic processing.                                           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to TCP socket         */
+/*    keepalive_enabled                     NX_TRUE to enable keepalive   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_tcp_socket_timer_update           Update socket timers          */
+/*    tx_mutex_get                          Obtain a protection mutex     */
+/*    tx_mutex_put                          Release a protection mutex    */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    setsockopt                            BSD set socket option         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_tcp_socket_keepalive_set(NX_TCP_SOCKET *socket_ptr, UINT keepalive_enabled)
+{
+
+NX_IP *ip_ptr;
+
+
+    /* Setup the IP pointer.  */
+    ip_ptr =  socket_ptr -> nx_tcp_socket_ip_ptr;
+
+    /* Obtain the IP mutex so we can access socket and IP information.  */
+    tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
+
+    /* Bring the socket timers up to date before the keepalive timer is changed.  */
+    _nx_tcp_socket_timer_update(socket_ptr);
+
+    /* Update the keepalive setting of the socket.  */
+    socket_ptr -> nx_tcp_socket_keepalive_enabled =  keepalive_enabled;
+    socket_ptr -> nx_tcp_socket_keepalive_retries =  0;
+
+    if (keepalive_enabled == NX_TRUE)
+    {
+
+        /* Set the keepalive timeout for this socket with the configurable keepalive timeout.  */
+        socket_ptr -> nx_tcp_socket_keepalive_timeout =  NX_TCP_KEEPALIVE_INITIAL;
+    }
+    else
+    {
+
+        /* Clear the socket keepalive timeout.  */
+        socket_ptr -> nx_tcp_socket_keepalive_timeout =  0;
+    }
+
+    /* Release the IP protection.  */
+    tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+}
+#endif /* NX_ENABLE_TCP_KEEPALIVE */
+
@@ -0,0 +1,124 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_tcp.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_socket_nodelay_set                          PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function disables (nodelay set to NX_TRUE) or enables Nagle's  */
+/*    algorithm on the specified TCP socket. Nagle's algorithm holds back */
+/*    data smaller than MSS while earlier data is not acknowledged, and   */
+/*    is used by default. Disabling it sends the data held back by it.    */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to TCP socket         */
+/*    nodelay                               NX_TRUE to send small data    */
+/*                                            without delay               */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_tcp_socket_coalesce_flush         Send held data                */
+/*    tx_mutex_get                          Obtain protection             */
+/*    tx_mutex_put                          Release protection            */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_tcp_socket_nodelay_set(NX_TCP_SOCKET *socket_ptr, UINT nodelay)
+{
+
+#ifdef NX_ENABLE_TCP_SEND_COALESCING
+NX_IP *ip_ptr;
+UINT   send_held;
+
+
+    /* Setup IP pointer.  */
+    ip_ptr =  socket_ptr -> nx_tcp_socket_ip_ptr;
+
+    /* Obtain the IP mutex so we can access the socket.  */
+    tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
+
+    /* Update the Nagle option of the socket.  */
+    if (nodelay)
+    {
+        socket_ptr -> nx_tcp_socket_coalesce_options |=  NX_TCP_COALESCE_NODELAY;
+    }
+    else
+    {
+        socket_ptr -> nx_tcp_socket_coalesce_options &=  ~((UINT)NX_TCP_COALESCE_NODELAY);
+    }
+
+    /* Determine if data held back by Nagle's algorithm is now to be sent.  */
+    send_held =  (nodelay) && (socket_ptr -> nx_tcp_socket_coalesce_packet) &&
+                 !(socket_ptr -> nx_tcp_socket_coalesce_options & NX_TCP_COALESCE_CORK);
+
+    /* Release protection.  */
+    tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+    /* Determine if the held data is to be sent.  */
+    if (send_held)
+    {
+
+        /* Yes, send it.  If the window does not allow it, it is sent once the window opens.  */
+        _nx_tcp_socket_coalesce_flush(socket_ptr, NX_NO_WAIT);
+    }
+
+    /* Return successful completion.  */
+    return(NX_SUCCESS);
+#else /* NX_ENABLE_TCP_SEND_COALESCING */
+    NX_PARAMETER_NOT_USED(socket_ptr);
+    NX_PARAMETER_NOT_USED(nodelay);
+
+    return(NX_NOT_SUPPORTED);
+#endif /* NX_ENABLE_TCP_SEND_COALESCING */
+}
+
@@ -69,6 +69,7 @@
 /*    _nx_tcp_socket_state_syn_received     Process SYN RECEIVED state    */
 /*    _nx_tcp_socket_state_syn_sent         Process SYN SENT state        */
 /*    _nx_tcp_socket_state_transmit_check   Check for transmit ability    */
+/*    _nx_tcp_socket_timer_update           Update socket timers          */
 /*    (nx_tcp_urgent_data_callback)         Application urgent callback   */
 /*                                            function                    */
 /*                                                                        */
@@ -83,6 +84,9 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            TCP timer wheel, resulting  */
+/*                                            in version 6.x              */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_tcp_socket_packet_process(NX_TCP_SOCKET *socket_ptr, NX_PACKET *packet_ptr)
@@ -99,6 +103,10 @@ ULONG         rx_window;
 UINT          outside_of_window;
 ULONG         mss = 0;
 
+    /* Bring the socket timers up to date, since processing the packet may start or
+       restart them.  */
+    _nx_tcp_socket_timer_update(socket_ptr);
+
     /* Copy the TCP header, since the actual packet can be delivered to
        a waiting socket/thread during this routine and before we are done
        using the header.  */
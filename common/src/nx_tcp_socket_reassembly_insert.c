@@ -0,0 +1,291 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_packet.h"
+#include "nx_tcp.h"
+
+
+#ifdef NX_ENABLE_TCP_REASSEMBLY_INDEX
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_socket_reassembly_insert                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function places an out-of-order data packet on the socket's    */
+/*    receive queue using the reassembly index. The run preceding the     */
+/*    packet is found with a binary search of the index, and the packet   */
+/*    is linked between that run and the next one. Runs that become       */
+/*    adjacent are merged. If the packet fills the hole at the expected   */
+/*    sequence number, the packets of the first run are marked ready for  */
+/*    receiving and the receive sequence is advanced.                     */
+/*                                                                        */
+/*    The index is sized for the out-of-order packets the receive queue   */
+/*    may hold, so every new run fits. If the packet overlaps queued      */
+/*    data, nothing is changed and the caller must search the receive     */
+/*    queue instead.                                                      */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to owning socket      */
+/*    packet_ptr                            Pointer to packet to queue    */
+/*    begin_sequence                        First sequence of packet data */
+/*    end_sequence                          Sequence following the data   */
+/*    ready_packets                         Number of packets made ready  */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    NX_TRUE                               Packet is queued              */
+/*    NX_FALSE                              Packet is not queued          */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_socket_state_data_check       Process received data         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_tcp_socket_reassembly_insert(NX_TCP_SOCKET *socket_ptr, NX_PACKET *packet_ptr, ULONG begin_sequence,
+                                       ULONG end_sequence, ULONG *ready_packets)
+{
+
+NX_TCP_REASSEMBLY_RANGE *range;
+NX_PACKET               *previous_ptr;
+NX_PACKET               *next_ptr;
+UINT                     count;
+UINT                     low;
+UINT                     high;
+UINT                     middle;
+UINT                     merge_previous;
+UINT                     merge_next;
+UINT                     i;
+
+
+    /* Setup a pointer to the index.  */
+    range =  socket_ptr -> nx_tcp_socket_reassembly_index;
+    count =  socket_ptr -> nx_tcp_socket_reassembly_count;
+
+    /* Find the first run that ends after the beginning of the packet.  */
+    low =   0;
+    high =  count;
+    while (low < high)
+    {
+        middle =  (low + high) >> 1;
+        if ((INT)(range[middle].nx_tcp_reassembly_range_end - begin_sequence) > 0)
+        {
+            high =  middle;
+        }
+        else
+        {
+            low =  middle + 1;
+        }
+    }
+
+    /* Determine if the packet overlaps this run.  */
+    if ((low < count) && ((INT)(range[low].nx_tcp_reassembly_range_begin - end_sequence) < 0))
+    {
+
+        /* Yes, leave the overlap to the receive queue search.  */
+        return(NX_FALSE);
+    }
+
+    /* Determine if the packet touches the runs around it.  */
+    merge_previous =  (low > 0) && (range[low - 1].nx_tcp_reassembly_range_end == begin_sequence);
+    merge_next =      (low < count) && (range[low].nx_tcp_reassembly_range_begin == end_sequence);
+
+    /* Find the packets the new packet goes between.  */
+    if (low > 0)
+    {
+
+        /* Behind the last packet of the previous run.  */
+        previous_ptr =  range[low - 1].nx_tcp_reassembly_range_last;
+    }
+    else if (count == 0)
+    {
+
+        /* Behind the in-order packets, all of the queue.  */
+        previous_ptr =  socket_ptr -> nx_tcp_socket_receive_queue_tail;
+    }
+    else if (socket_ptr -> nx_tcp_socket_receive_queue_head == range[0].nx_tcp_reassembly_range_first)
+    {
+
+        /* At the head of the queue, the in-order packets have been received.  */
+        previous_ptr =  NX_NULL;
+    }
+    else
+    {
+
+        /* Behind the last in-order packet.  */
+        previous_ptr =  socket_ptr -> nx_tcp_socket_reassembly_previous;
+    }
+
+    if (low < count)
+    {
+        next_ptr =  range[low].nx_tcp_reassembly_range_first;
+    }
+    else
+    {
+        next_ptr =  (NX_PACKET *)NX_PACKET_ENQUEUED;
+    }
+
+    /* Link the packet into the receive queue.  */
+    if (previous_ptr)
+    {
+        previous_ptr -> nx_packet_tcp_queue_next =  packet_ptr;
+    }
+    else
+    {
+        socket_ptr -> nx_tcp_socket_receive_queue_head =  packet_ptr;
+    }
+    packet_ptr -> nx_packet_tcp_queue_next =  next_ptr;
+
+    /* Determine if the packet is the new tail.  */
+    if (next_ptr == (NX_PACKET *)NX_PACKET_ENQUEUED)
+    {
+        socket_ptr -> nx_tcp_socket_receive_queue_tail =  packet_ptr;
+    }
+
+    /* Increment the receive TCP packet count.  */
+    socket_ptr -> nx_tcp_socket_receive_queue_count++;
+
+    /* Update the index.  */
+    if ((merge_previous) && (merge_next))
+    {
+
+        /* The packet joins two runs.  */
+        range[low - 1].nx_tcp_reassembly_range_end =   range[low].nx_tcp_reassembly_range_end;
+        range[low - 1].nx_tcp_reassembly_range_last =  range[low].nx_tcp_reassembly_range_last;
+
+        /* Remove the second run.  */
+        for (i = low + 1; i < count; i++)
+        {
+            range[i - 1] =  range[i];
+        }
+        count--;
+
+        /* The packet is now part of the run before it.  */
+        low--;
+    }
+    else if (merge_previous)
+    {
+
+        /* The packet extends the previous run.  */
+        range[low - 1].nx_tcp_reassembly_range_end =   end_sequence;
+        range[low - 1].nx_tcp_reassembly_range_last =  packet_ptr;
+        low--;
+    }
+    else if (merge_next)
+    {
+
+        /* The packet extends the next run.  */
+        range[low].nx_tcp_reassembly_range_begin =  begin_sequence;
+        range[low].nx_tcp_reassembly_range_first =  packet_ptr;
+    }
+    else
+    {
+
+        /* The packet is a new run.  Make room for it.  */
+        for (i = count; i > low; i--)
+        {
+            range[i] =  range[i - 1];
+        }
+        count++;
+
+        /* Setup the new run.  */
+        range[low].nx_tcp_reassembly_range_begin =  begin_sequence;
+        range[low].nx_tcp_reassembly_range_end =    end_sequence;
+        range[low].nx_tcp_reassembly_range_first =  packet_ptr;
+        range[low].nx_tcp_reassembly_range_last =   packet_ptr;
+
+        /* Determine if the new run is the first.  */
+        if (low == 0)
+        {
+
+            /* Yes, remember the in-order packet ahead of it.  */
+            socket_ptr -> nx_tcp_socket_reassembly_previous =  previous_ptr;
+        }
+    }
+
+    /* No packet is ready yet.  */
+    *ready_packets =  0;
+
+    /* Determine if the first run now starts at the expected sequence number.  */
+    if ((low == 0) && (range[0].nx_tcp_reassembly_range_begin == socket_ptr -> nx_tcp_socket_rx_sequence))
+    {
+
+        /* Yes, mark the packets of the run as ready for retrieval.  */
+        next_ptr =  range[0].nx_tcp_reassembly_range_first;
+        for (;;)
+        {
+            next_ptr -> nx_packet_queue_next =  (NX_PACKET *)NX_PACKET_READY;
+            (*ready_packets)++;
+
+            if (next_ptr == range[0].nx_tcp_reassembly_range_last)
+            {
+                break;
+            }
+
+            next_ptr =  next_ptr -> nx_packet_tcp_queue_next;
+        }
+
+        /* Advance the receive sequence past the run.  */
+        socket_ptr -> nx_tcp_socket_rx_sequence =  range[0].nx_tcp_reassembly_range_end;
+
+        /* Its last packet is now the in-order packet ahead of the next run.  */
+        socket_ptr -> nx_tcp_socket_reassembly_previous =  range[0].nx_tcp_reassembly_range_last;
+
+        /* Remove the run.  */
+        for (i = 1; i < count; i++)
+        {
+            range[i - 1] =  range[i];
+        }
+        count--;
+    }
+
+    /* Save the number of runs.  */
+    socket_ptr -> nx_tcp_socket_reassembly_count =  count;
+
+    return(NX_TRUE);
+}
+#endif /* NX_ENABLE_TCP_REASSEMBLY_INDEX */
+
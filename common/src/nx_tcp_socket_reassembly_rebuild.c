@@ -0,0 +1,148 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_packet.h"
+#include "nx_tcp.h"
+
+
+#ifdef NX_ENABLE_TCP_REASSEMBLY_INDEX
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_socket_reassembly_rebuild                   PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function rebuilds the reassembly index of the socket from its  */
+/*    receive queue. It is called after the receive queue is changed      */
+/*    without the index, for example when an out-of-order segment         */
+/*    overlaps queued data.                                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to owning socket      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_socket_state_data_check       Process received data         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_tcp_socket_reassembly_rebuild(NX_TCP_SOCKET *socket_ptr)
+{
+
+NX_TCP_REASSEMBLY_RANGE *range;
+NX_PACKET               *packet_ptr;
+NX_TCP_HEADER           *header_ptr;
+ULONG                    header_length;
+ULONG                    begin_sequence;
+ULONG                    end_sequence;
+UINT                     count =  0;
+
+
+    /* Setup a pointer to the index.  */
+    range =  socket_ptr -> nx_tcp_socket_reassembly_index;
+
+    /* No in-order packet is known yet.  */
+    socket_ptr -> nx_tcp_socket_reassembly_previous =  NX_NULL;
+
+    /* Pickup the head of the receive queue.  */
+    packet_ptr =  socket_ptr -> nx_tcp_socket_receive_queue_head;
+
+    /* Loop through the receive queue.  */
+    while ((packet_ptr) && (packet_ptr != (NX_PACKET *)NX_PACKET_ENQUEUED))
+    {
+
+        /* Determine if the packet is in order.  */
+        if (packet_ptr -> nx_packet_queue_next == (NX_PACKET *)NX_PACKET_READY)
+        {
+
+            /* Yes, remember it as the last in-order packet.  */
+            socket_ptr -> nx_tcp_socket_reassembly_previous =  packet_ptr;
+        }
+        else
+        {
+
+            /* Setup a pointer to the TCP header of this packet.  */
+            header_ptr =  (NX_TCP_HEADER *)packet_ptr -> nx_packet_prepend_ptr;
+
+            /* Calculate the header size for this packet.  */
+            header_length =  (header_ptr -> nx_tcp_header_word_3 >> NX_TCP_HEADER_SHIFT) * sizeof(ULONG);
+
+            /* Compute the sequence numbers of the data in this packet.  */
+            begin_sequence =  header_ptr -> nx_tcp_sequence_number;
+            end_sequence =    begin_sequence + packet_ptr -> nx_packet_length - header_length;
+
+            /* Determine if the packet continues the last run.  */
+            if ((count) && (range[count - 1].nx_tcp_reassembly_range_end == begin_sequence))
+            {
+
+                /* Yes, extend the run.  */
+                range[count - 1].nx_tcp_reassembly_range_end =   end_sequence;
+                range[count - 1].nx_tcp_reassembly_range_last =  packet_ptr;
+            }
+            else
+            {
+
+                /* Start a new run.  */
+                range[count].nx_tcp_reassembly_range_begin =  begin_sequence;
+                range[count].nx_tcp_reassembly_range_end =    end_sequence;
+                range[count].nx_tcp_reassembly_range_first =  packet_ptr;
+                range[count].nx_tcp_reassembly_range_last =   packet_ptr;
+                count++;
+            }
+        }
+
+        /* Move to the next packet.  */
+        packet_ptr =  packet_ptr -> nx_packet_tcp_queue_next;
+    }
+
+    /* Save the number of runs.  */
+    socket_ptr -> nx_tcp_socket_reassembly_count =  count;
+}
+#endif /* NX_ENABLE_TCP_REASSEMBLY_INDEX */
+
@@ -61,6 +61,7 @@
 /*                                                                        */
 /*    _nx_tcp_packet_send_ack               Send ACK message              */
 /*    _nx_tcp_socket_thread_suspend         Suspend calling thread        */
+/*    _nx_tcp_socket_timer_update           Update socket timers          */
 /*    tx_mutex_get                          Get protection mutex          */
 /*    tx_mutex_put                          Put protection mutex          */
 /*                                                                        */
@@ -75,6 +76,9 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            TCP timer wheel, resulting  */
+/*                                            in version 6.x              */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_tcp_socket_receive(NX_TCP_SOCKET *socket_ptr, NX_PACKET **packet_ptr, ULONG wait_option)
@@ -200,6 +204,10 @@ ULONG                  trace_timestamp;
         /* Place the packet pointer in the return pointer.  */
         *packet_ptr =  head_packet_ptr;
 
+        /* Bring the socket timers up to date, since a larger receive window may need
+           to be advertised by the delayed ACK timer.  */
+        _nx_tcp_socket_timer_update(socket_ptr);
+
         /* Increase the receive window size.  */
         socket_ptr -> nx_tcp_socket_rx_window_current += (*packet_ptr) -> nx_packet_length;
 
@@ -74,6 +74,9 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            reassembly index reset,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_tcp_socket_receive_queue_flush(NX_TCP_SOCKET *socket_ptr)
@@ -109,5 +112,11 @@ NX_PACKET *next_packet_ptr;
         /* Decrease the queued packet count.  */
         socket_ptr -> nx_tcp_socket_receive_queue_count--;
     }
+
+#ifdef NX_ENABLE_TCP_REASSEMBLY_INDEX
+
+    /* Clear the reassembly index.  */
+    socket_ptr -> nx_tcp_socket_reassembly_count =  0;
+#endif /* NX_ENABLE_TCP_REASSEMBLY_INDEX */
 }
 
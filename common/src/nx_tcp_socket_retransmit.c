@@ -43,7 +43,10 @@
 /*                                                                        */
 /*  DESCRIPTION                                                           */
 /*                                                                        */
-/*    This function retransmit a TCP packet.                              */
+/*    This function retransmit a TCP packet.  In fast recovery with SACK, */
+/*    the first segment not acknowledged selectively is retransmitted.    */
+/*    Of a super-segment built for segmentation offload, only the first   */
+/*    MSS is retransmitted.                                               */
 /*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
@@ -57,7 +60,10 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    _nx_ip_packet_send                    Resend the transmit packet    */
+/*    (nx_tcp_socket_congestion_control)    Set slow start threshold      */
+/*    _nx_tcp_socket_retransmit_packet      Resend the transmit packet    */
+/*    _nx_tcp_socket_retransmit_slice       Resend one MSS of a packet    */
+/*    _nx_tcp_socket_sack_retransmit        Retransmit SACK hole          */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -71,14 +77,25 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            refreshed ACK number and    */
+/*                                            window of retransmitted     */
+/*                                            segments, supported TCP     */
+/*                                            checksum and segmentation   */
+/*                                            offload, added Karn's       */
+/*                                            algorithm, added SACK       */
+/*                                            recovery, moved slow start  */
+/*                                            threshold to the congestion */
+/*                                            control algorithm,          */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_tcp_socket_retransmit(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr, UINT need_fast_retransmit)
 {
-NX_PACKET *packet_ptr;
-NX_PACKET *next_ptr;
-ULONG      window;
-ULONG      available;
+NX_PACKET     *packet_ptr;
+NX_PACKET     *next_ptr;
+ULONG          window;
+ULONG          available;
 
     /* If the reciever winodw is zero, we enter the zero window probe phase
        RFC 793 Sec 3.7, p42: keep send new data.
@@ -110,21 +127,29 @@ ULONG      available;
     /* Increment the retry counter.  */
     socket_ptr -> nx_tcp_socket_timeout_retries++;
 
+#ifdef NX_ENABLE_TCP_RTT_ESTIMATION
+
+    /* Discard any round-trip time sample in progress, since the acknowledgment can no
+       longer be matched to one transmission of the segment (Karn's algorithm).  */
+    socket_ptr -> nx_tcp_socket_rtt_active =  NX_FALSE;
+#endif /* NX_ENABLE_TCP_RTT_ESTIMATION */
+
     if ((need_fast_retransmit == NX_TRUE) || (socket_ptr -> nx_tcp_socket_fast_recovery == NX_FALSE))
     {
 
-        /* Timed out on an outgoing packet.  Enter slow start mode. */
-        /* Compute the flight size / 2 value. */
-        window = socket_ptr -> nx_tcp_socket_tx_outstanding_bytes >> 1;
-
-        /* Make sure we have at least 2 * MSS */
-        if (window < (socket_ptr -> nx_tcp_socket_connect_mss << 1))
+        /* Timed out on an outgoing packet, or a loss was signaled by duplicate ACKs.
+           Let the congestion control algorithm set the slow start threshold.  */
+        if (need_fast_retransmit == NX_TRUE)
         {
-            window = socket_ptr -> nx_tcp_socket_connect_mss << 1;
+            (socket_ptr -> nx_tcp_socket_congestion_control)(socket_ptr, NX_TCP_CONGESTION_CONTROL_LOSS, 0);
+        }
+        else
+        {
+            (socket_ptr -> nx_tcp_socket_congestion_control)(socket_ptr, NX_TCP_CONGESTION_CONTROL_TIMEOUT, 0);
         }
 
-        /* Set the slow_start_threshold */
-        socket_ptr -> nx_tcp_socket_tx_slow_start_threshold = window;
+        /* Pickup the new slow start threshold.  */
+        window =  socket_ptr -> nx_tcp_socket_tx_slow_start_threshold;
 
         /* Set the current window to be MSS size. */
         socket_ptr -> nx_tcp_socket_tx_window_congestion = socket_ptr -> nx_tcp_socket_connect_mss;
@@ -141,6 +166,12 @@ ULONG      available;
 
             /* Update the transmit sequence that enters fast transmit. */
             socket_ptr -> nx_tcp_socket_tx_sequence_recover = socket_ptr -> nx_tcp_socket_tx_sequence - 1;
+
+#ifdef NX_ENABLE_TCP_SACK
+
+            /* Nothing has been retransmitted in this recovery yet.  */
+            socket_ptr -> nx_tcp_socket_sack_retransmit_sequence =  socket_ptr -> nx_tcp_socket_previous_highest_ack;
+#endif /* NX_ENABLE_TCP_SACK */
         }
     }
 
@@ -149,6 +180,20 @@ ULONG      available;
         (socket_ptr -> nx_tcp_socket_timeout_retries *
          socket_ptr -> nx_tcp_socket_timeout_shift);
 
+#ifdef NX_ENABLE_TCP_SACK
+
+    /* Determine if the peer has acknowledged data selectively during fast recovery.  */
+    if ((socket_ptr -> nx_tcp_socket_fast_recovery == NX_TRUE) &&
+        (socket_ptr -> nx_tcp_socket_sack_count))
+    {
+
+        /* Yes, retransmit the first segment the peer is missing instead of the head.  */
+        _nx_tcp_socket_sack_retransmit(ip_ptr, socket_ptr);
+
+        return;
+    }
+#endif /* NX_ENABLE_TCP_SACK */
+
     /* Get available size of packet that can be sent. */
     available = socket_ptr -> nx_tcp_socket_tx_window_congestion;
 
@@ -160,6 +205,23 @@ ULONG      available;
     while (packet_ptr && (packet_ptr -> nx_packet_queue_next == (NX_PACKET *)NX_DRIVER_TX_DONE))
     {
 
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+
+        /* Determine if the packet is a super-segment built for segmentation offload.  */
+        if ((packet_ptr -> nx_packet_length - sizeof(NX_TCP_HEADER)) > socket_ptr -> nx_tcp_socket_connect_mss)
+        {
+
+            /* Yes, only its first MSS is retransmitted, and only at the head of the queue, so
+               a retransmission never exceeds one segment.  The rest is sent again once the
+               peer acknowledges the slice.  */
+            if (packet_ptr == socket_ptr -> nx_tcp_socket_transmit_sent_head)
+            {
+                _nx_tcp_socket_retransmit_slice(ip_ptr, socket_ptr, packet_ptr, 0);
+            }
+            break;
+        }
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
         if (packet_ptr -> nx_packet_length > (available + sizeof(NX_TCP_HEADER)))
         {
             /* This packet can not be sent. */
@@ -167,33 +229,21 @@ ULONG      available;
         }
 
         /* Decrease the available size. */
-        available -= (packet_ptr -> nx_packet_length - sizeof(NX_TCP_HEADER));
+        if (available > (packet_ptr -> nx_packet_length - sizeof(NX_TCP_HEADER)))
+        {
+            available -= (packet_ptr -> nx_packet_length - sizeof(NX_TCP_HEADER));
+        }
+        else
+        {
+            available =  0;
+        }
 
         /* Pickup next packet. */
         next_ptr = packet_ptr -> nx_packet_tcp_queue_next;
 
-#ifndef NX_DISABLE_TCP_INFO
-        /* Increment the TCP retransmit count.  */
-        ip_ptr -> nx_ip_tcp_retransmit_packets++;
-
-        /* Increment the TCP retransmit count for the socket.  */
-        socket_ptr -> nx_tcp_socket_retransmit_packets++;
-#endif
-
-        /* If trace is enabled, insert this event into the trace buffer.  */
-        NX_TRACE_IN_LINE_INSERT(NX_TRACE_INTERNAL_TCP_RETRY, ip_ptr, socket_ptr, packet_ptr, socket_ptr -> nx_tcp_socket_timeout_retries, NX_TRACE_INTERNAL_EVENTS, 0, 0);
-
-        /* Clear the queue next pointer.  */
-        packet_ptr -> nx_packet_queue_next =  NX_NULL;
-
-        /* Yes, the driver has finished with the packet at the head of the
-           transmit sent list... so it can be sent again!  */
-
         /* Yes, the driver has finished with the packet at the head of the
            transmit sent list... so it can be sent again!  */
-        _nx_ip_packet_send(ip_ptr, packet_ptr,  socket_ptr -> nx_tcp_socket_connect_ip,
-                           socket_ptr -> nx_tcp_socket_type_of_service, socket_ptr -> nx_tcp_socket_time_to_live, NX_IP_TCP,
-                           socket_ptr -> nx_tcp_socket_fragment_enable);
+        _nx_tcp_socket_retransmit_packet(ip_ptr, socket_ptr, packet_ptr);
 
         /* Move to next packet. */
         /* During fast recovery, only one packet is retransmitted at once. */
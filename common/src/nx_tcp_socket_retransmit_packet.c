@@ -0,0 +1,160 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_packet.h"
+#include "nx_ip.h"
+#include "nx_tcp.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_socket_retransmit_packet                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function retransmits one packet of the socket's transmit sent  */
+/*    list, which the driver must have finished with. The ACK number and  */
+/*    window of the segment are refreshed, with the checksum adjusted     */
+/*    incrementally.                                                      */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                IP instance pointer           */
+/*    socket_ptr                            Pointer to owning socket      */
+/*    packet_ptr                            Pointer to packet to resend   */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_ip_checksum_adjust                Adjust checksum incrementally */
+/*    _nx_ip_checksum_adjust_long           Adjust checksum incrementally */
+/*    _nx_ip_packet_send                    Resend the transmit packet    */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_socket_retransmit             Retransmit packet             */
+/*    _nx_tcp_socket_retransmit_slice       Retransmit one MSS of packet  */
+/*    _nx_tcp_socket_sack_retransmit        Retransmit SACK hole          */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_tcp_socket_retransmit_packet(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr, NX_PACKET *packet_ptr)
+{
+NX_TCP_HEADER *header_ptr;
+ULONG          acknowledgment_number;
+ULONG          rx_window;
+ULONG          word_3;
+ULONG          word_4;
+
+#ifndef NX_DISABLE_TCP_INFO
+    /* Increment the TCP retransmit count.  */
+    ip_ptr -> nx_ip_tcp_retransmit_packets++;
+
+    /* Increment the TCP retransmit count for the socket.  */
+    socket_ptr -> nx_tcp_socket_retransmit_packets++;
+#endif
+
+    /* If trace is enabled, insert this event into the trace buffer.  */
+    NX_TRACE_IN_LINE_INSERT(NX_TRACE_INTERNAL_TCP_RETRY, ip_ptr, socket_ptr, packet_ptr, socket_ptr -> nx_tcp_socket_timeout_retries, NX_TRACE_INTERNAL_EVENTS, 0, 0);
+
+    /* Clear the queue next pointer.  */
+    packet_ptr -> nx_packet_queue_next =  NX_NULL;
+
+    /* Pickup the pointer to the head of the TCP packet.  */
+    header_ptr =  (NX_TCP_HEADER *)packet_ptr -> nx_packet_prepend_ptr;
+
+    /* Pickup the ACK number and window that were sent with the original segment.  */
+    acknowledgment_number =  header_ptr -> nx_tcp_acknowledgment_number;
+    word_3 =  header_ptr -> nx_tcp_header_word_3;
+    NX_CHANGE_ULONG_ENDIAN(acknowledgment_number);
+    NX_CHANGE_ULONG_ENDIAN(word_3);
+
+    /* Compute the window to advertise now.  */
+#ifdef NX_ENABLE_TCP_WINDOW_SCALING
+    rx_window =  socket_ptr -> nx_tcp_socket_rx_window_current >> socket_ptr -> nx_tcp_rcv_win_scale_value;
+#else /* !NX_ENABLE_TCP_WINDOW_SCALING */
+    rx_window =  socket_ptr -> nx_tcp_socket_rx_window_current;
+#endif /* NX_ENABLE_TCP_WINDOW_SCALING */
+
+    /* Determine if the segment carries stale acknowledgment information.  */
+    if ((word_3 & NX_TCP_ACK_BIT) &&
+        ((acknowledgment_number != socket_ptr -> nx_tcp_socket_rx_sequence) ||
+         ((word_3 & NX_LOWER_16_MASK) != rx_window)))
+    {
+
+        /* Yes, refresh the ACK number and window in the header.  */
+        header_ptr -> nx_tcp_acknowledgment_number =  socket_ptr -> nx_tcp_socket_rx_sequence;
+        NX_CHANGE_ULONG_ENDIAN(header_ptr -> nx_tcp_acknowledgment_number);
+        header_ptr -> nx_tcp_header_word_3 =  (word_3 & ~NX_LOWER_16_MASK) | rx_window;
+        NX_CHANGE_ULONG_ENDIAN(header_ptr -> nx_tcp_header_word_3);
+
+#ifndef NX_DISABLE_TCP_TX_CHECKSUM
+
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+        /* Determine if the checksum is left to the interface.  */
+        if (!(packet_ptr -> nx_packet_interface_capability_flag & NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM))
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+        {
+
+            /* Adjust the checksum for the changed fields instead of recalculating it.  */
+            word_4 =  header_ptr -> nx_tcp_header_word_4;
+            NX_CHANGE_ULONG_ENDIAN(word_4);
+            word_4 =  (word_4 & NX_LOWER_16_MASK) |
+                (_nx_ip_checksum_adjust(_nx_ip_checksum_adjust_long(word_4 >> NX_SHIFT_BY_16, acknowledgment_number,
+                                                                    socket_ptr -> nx_tcp_socket_rx_sequence),
+                                        word_3 & NX_LOWER_16_MASK, rx_window) << NX_SHIFT_BY_16);
+            NX_CHANGE_ULONG_ENDIAN(word_4);
+            header_ptr -> nx_tcp_header_word_4 =  word_4;
+        }
+#endif /* NX_DISABLE_TCP_TX_CHECKSUM */
+
+        /* Remember the last ACKed sequence and the last reported window size.  */
+        socket_ptr -> nx_tcp_socket_rx_sequence_acked =    socket_ptr -> nx_tcp_socket_rx_sequence;
+        socket_ptr -> nx_tcp_socket_rx_window_last_sent =  socket_ptr -> nx_tcp_socket_rx_window_current;
+    }
+
+    /* Send the packet again.  */
+    _nx_ip_packet_send(ip_ptr, packet_ptr,  socket_ptr -> nx_tcp_socket_connect_ip,
+                       socket_ptr -> nx_tcp_socket_type_of_service, socket_ptr -> nx_tcp_socket_time_to_live, NX_IP_TCP,
+                       socket_ptr -> nx_tcp_socket_fragment_enable);
+}
+
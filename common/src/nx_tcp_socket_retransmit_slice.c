@@ -0,0 +1,270 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_packet.h"
+#include "nx_ip.h"
+#include "nx_tcp.h"
+
+
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_socket_retransmit_slice                     PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function retransmits at most one MSS of a packet of the        */
+/*    socket's transmit sent list, starting at the specified offset into  */
+/*    its data, so a super-segment built for segmentation offload is      */
+/*    never resent whole. The slice is a new packet with a copy of the    */
+/*    TCP header that references the data of the sent packet, or copies  */
+/*    it when packet clones are disabled. A packet that fits in one MSS   */
+/*    is retransmitted as it is.                                          */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                IP instance pointer           */
+/*    socket_ptr                            Pointer to owning socket      */
+/*    packet_ptr                            Pointer to packet to resend   */
+/*    offset                                Offset of the slice into the  */
+/*                                            data of the packet          */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    slice_length                          Number of bytes resent, zero  */
+/*                                            if no packet is available   */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_ip_packet_send                    Send the slice                */
+/*    _nx_packet_allocate                   Allocate the slice            */
+/*    _nx_packet_data_append                Copy header and data          */
+/*    _nx_packet_data_reference             Reference data                */
+/*    _nx_packet_release                    Release the slice             */
+/*    _nx_tcp_socket_retransmit_packet      Resend the whole packet       */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_socket_retransmit             Retransmit packet             */
+/*    _nx_tcp_socket_sack_retransmit        Retransmit SACK hole          */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _nx_tcp_socket_retransmit_slice(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr, NX_PACKET *packet_ptr, ULONG offset)
+{
+
+NX_PACKET     *slice_ptr;
+NX_PACKET     *source_ptr;
+NX_TCP_HEADER *header_ptr;
+UCHAR         *data_ptr;
+ULONG          header_length;
+ULONG          data_length;
+ULONG          slice_length;
+ULONG          remaining_bytes;
+ULONG          copy_size;
+ULONG          rx_window;
+ULONG          temp;
+UINT           status;
+
+
+    /* Setup a pointer to the TCP header of the packet.  */
+    /*lint -e{927} -e{826} suppress cast of pointer to pointer, since it is necessary  */
+    header_ptr =  (NX_TCP_HEADER *)packet_ptr -> nx_packet_prepend_ptr;
+
+    /* Determine the size of the TCP header and of the data.  */
+    temp =  header_ptr -> nx_tcp_header_word_3;
+    NX_CHANGE_ULONG_ENDIAN(temp);
+    header_length =  (temp >> NX_TCP_HEADER_SHIFT) * sizeof(ULONG);
+    data_length =    packet_ptr -> nx_packet_length - header_length;
+
+    /* Compute the size of the slice, at most one MSS.  */
+    slice_length =  data_length - offset;
+    if (slice_length > socket_ptr -> nx_tcp_socket_connect_mss)
+    {
+        slice_length =  socket_ptr -> nx_tcp_socket_connect_mss;
+    }
+
+    /* Determine if the slice is the whole packet.  */
+    if (slice_length == data_length)
+    {
+
+        /* Yes, simply send the packet again.  */
+        _nx_tcp_socket_retransmit_packet(ip_ptr, socket_ptr, packet_ptr);
+
+        return(slice_length);
+    }
+
+    /* Allocate a packet for the slice, leaving room for the IP and physical headers.  */
+    if (_nx_packet_allocate(ip_ptr -> nx_ip_default_packet_pool, &slice_ptr, NX_IP_PACKET, NX_NO_WAIT))
+    {
+
+        /* No packet is available, the data is retransmitted on a later timeout.  */
+        return(0);
+    }
+
+    /* Copy the TCP header.  */
+    status =  _nx_packet_data_append(slice_ptr, header_ptr, header_length,
+                                     ip_ptr -> nx_ip_default_packet_pool, NX_NO_WAIT);
+
+    /* Find the first byte of the slice in the packet chain.  */
+    source_ptr =       packet_ptr;
+    data_ptr =         packet_ptr -> nx_packet_prepend_ptr + header_length;
+    remaining_bytes =  offset;
+    while (remaining_bytes >= (ULONG)(source_ptr -> nx_packet_append_ptr - data_ptr))
+    {
+        remaining_bytes =  remaining_bytes - (ULONG)(source_ptr -> nx_packet_append_ptr - data_ptr);
+        source_ptr =       source_ptr -> nx_packet_next;
+        data_ptr =         source_ptr -> nx_packet_prepend_ptr;
+    }
+    data_ptr =  data_ptr + remaining_bytes;
+
+    /* Loop to add the data of the slice, walking the packet chain.  */
+    remaining_bytes =  slice_length;
+    while ((status == NX_SUCCESS) && (remaining_bytes))
+    {
+
+        /* Determine if the current packet of the chain is exhausted.  */
+        if (data_ptr == source_ptr -> nx_packet_append_ptr)
+        {
+
+            /* Move to the next packet in the chain.  */
+            source_ptr =  source_ptr -> nx_packet_next;
+            data_ptr =    source_ptr -> nx_packet_prepend_ptr;
+            continue;
+        }
+
+        /* Add as much of the current packet as the slice needs.  */
+        copy_size =  (ULONG)(source_ptr -> nx_packet_append_ptr - data_ptr);
+        if (copy_size > remaining_bytes)
+        {
+            copy_size =  remaining_bytes;
+        }
+
+#ifdef NX_ENABLE_PACKET_CLONE
+        status =  _nx_packet_data_reference(slice_ptr, source_ptr, data_ptr, copy_size,
+                                            ip_ptr -> nx_ip_default_packet_pool, NX_NO_WAIT);
+#else
+        status =  _nx_packet_data_append(slice_ptr, data_ptr, copy_size,
+                                         ip_ptr -> nx_ip_default_packet_pool, NX_NO_WAIT);
+#endif /* NX_ENABLE_PACKET_CLONE */
+
+        data_ptr =         data_ptr + copy_size;
+        remaining_bytes =  remaining_bytes - copy_size;
+    }
+
+    /* Determine if the slice could not be built.  */
+    if (status != NX_SUCCESS)
+    {
+
+        /* Release the slice, the data is retransmitted on a later timeout.  */
+        _nx_packet_release(slice_ptr);
+
+        return(0);
+    }
+
+    /* Setup a pointer to the TCP header of the slice.  */
+    /*lint -e{927} -e{826} suppress cast of pointer to pointer, since it is necessary  */
+    header_ptr =  (NX_TCP_HEADER *)slice_ptr -> nx_packet_prepend_ptr;
+
+    /* Advance the sequence number to the start of the slice.  */
+    temp =  header_ptr -> nx_tcp_sequence_number;
+    NX_CHANGE_ULONG_ENDIAN(temp);
+    temp =  temp + offset;
+    NX_CHANGE_ULONG_ENDIAN(temp);
+    header_ptr -> nx_tcp_sequence_number =  temp;
+
+    /* Compute the window to advertise now.  */
+#ifdef NX_ENABLE_TCP_WINDOW_SCALING
+    rx_window =  socket_ptr -> nx_tcp_socket_rx_window_current >> socket_ptr -> nx_tcp_rcv_win_scale_value;
+#else /* !NX_ENABLE_TCP_WINDOW_SCALING */
+    rx_window =  socket_ptr -> nx_tcp_socket_rx_window_current;
+#endif /* NX_ENABLE_TCP_WINDOW_SCALING */
+
+    /* Only a slice that ends the packet keeps the FIN and PSH flags.  Refresh the window.  */
+    temp =  header_ptr -> nx_tcp_header_word_3;
+    NX_CHANGE_ULONG_ENDIAN(temp);
+    if ((offset + slice_length) < data_length)
+    {
+        temp =  temp & ~(NX_TCP_FIN_BIT | NX_TCP_PSH_BIT);
+    }
+    temp =  (temp & ~NX_LOWER_16_MASK) | rx_window;
+    NX_CHANGE_ULONG_ENDIAN(temp);
+    header_ptr -> nx_tcp_header_word_3 =  temp;
+
+    /* Refresh the ACK number.  */
+    header_ptr -> nx_tcp_acknowledgment_number =  socket_ptr -> nx_tcp_socket_rx_sequence;
+    NX_CHANGE_ULONG_ENDIAN(header_ptr -> nx_tcp_acknowledgment_number);
+
+    /* Clear the checksum, it is computed by the interface or by the IP layer when the slice is
+       sent.  */
+    temp =  header_ptr -> nx_tcp_header_word_4;
+    NX_CHANGE_ULONG_ENDIAN(temp);
+    temp =  temp & NX_LOWER_16_MASK;
+    NX_CHANGE_ULONG_ENDIAN(temp);
+    header_ptr -> nx_tcp_header_word_4 =  temp;
+#ifndef NX_DISABLE_TCP_TX_CHECKSUM
+    slice_ptr -> nx_packet_interface_capability_flag |=  NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM;
+#endif /* NX_DISABLE_TCP_TX_CHECKSUM */
+
+    /* Remember the last ACKed sequence and the last reported window size.  */
+    socket_ptr -> nx_tcp_socket_rx_sequence_acked =    socket_ptr -> nx_tcp_socket_rx_sequence;
+    socket_ptr -> nx_tcp_socket_rx_window_last_sent =  socket_ptr -> nx_tcp_socket_rx_window_current;
+
+#ifndef NX_DISABLE_TCP_INFO
+    /* Increment the TCP retransmit count.  */
+    ip_ptr -> nx_ip_tcp_retransmit_packets++;
+
+    /* Increment the TCP retransmit count for the socket.  */
+    socket_ptr -> nx_tcp_socket_retransmit_packets++;
+#endif
+
+    /* If trace is enabled, insert this event into the trace buffer.  */
+    NX_TRACE_IN_LINE_INSERT(NX_TRACE_INTERNAL_TCP_RETRY, ip_ptr, socket_ptr, slice_ptr, socket_ptr -> nx_tcp_socket_timeout_retries, NX_TRACE_INTERNAL_EVENTS, 0, 0);
+
+    /* Send the slice.  */
+    _nx_ip_packet_send(ip_ptr, slice_ptr,  socket_ptr -> nx_tcp_socket_connect_ip,
+                       socket_ptr -> nx_tcp_socket_type_of_service, socket_ptr -> nx_tcp_socket_time_to_live, NX_IP_TCP,
+                       socket_ptr -> nx_tcp_socket_fragment_enable);
+
+    /* Return the number of bytes resent.  */
+    return(slice_length);
+}
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
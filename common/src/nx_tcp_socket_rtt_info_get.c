@@ -0,0 +1,129 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_tcp.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_socket_rtt_info_get                         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function retrieves the round-trip time estimate and the        */
+/*    current retransmit timeout of the specified TCP socket, all in      */
+/*    timer ticks. If round-trip time estimation is not enabled, the      */
+/*    estimate is returned as zero and the timeout is the configured one. */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to the TCP socket     */
+/*    srtt                                  Destination for smoothed      */
+/*                                            round-trip time             */
+/*    rttvar                                Destination for round-trip    */
+/*                                            time variation              */
+/*    rto                                   Destination for retransmit    */
+/*                                            timeout                     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    tx_mutex_get                          Obtain protection             */
+/*    tx_mutex_put                          Release protection            */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nxe_tcp_socket_rtt_info_get          Error checking shell          */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_tcp_socket_rtt_info_get(NX_TCP_SOCKET *socket_ptr, ULONG *srtt, ULONG *rttvar, ULONG *rto)
+{
+
+NX_IP *ip_ptr;
+
+
+    /* Setup IP pointer.  */
+    ip_ptr =  socket_ptr -> nx_tcp_socket_ip_ptr;
+
+    /* Obtain the IP mutex so we can examine the socket.  */
+    tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
+
+    /* Determine if the smoothed round-trip time is requested.  */
+    if (srtt)
+    {
+
+#ifdef NX_ENABLE_TCP_RTT_ESTIMATION
+        /* Return the smoothed round-trip time, removing the scale.  */
+        *srtt =  socket_ptr -> nx_tcp_socket_rtt_srtt >> 3;
+#else
+        *srtt =  0;
+#endif /* NX_ENABLE_TCP_RTT_ESTIMATION */
+    }
+
+    /* Determine if the round-trip time variation is requested.  */
+    if (rttvar)
+    {
+
+#ifdef NX_ENABLE_TCP_RTT_ESTIMATION
+        /* Return the round-trip time variation, removing the scale.  */
+        *rttvar =  socket_ptr -> nx_tcp_socket_rtt_rttvar >> 2;
+#else
+        *rttvar =  0;
+#endif /* NX_ENABLE_TCP_RTT_ESTIMATION */
+    }
+
+    /* Determine if the retransmit timeout is requested.  */
+    if (rto)
+    {
+
+        /* Return the retransmit timeout used for the next transmission.  */
+        *rto =  socket_ptr -> nx_tcp_socket_timeout_rate;
+    }
+
+    /* Release protection.  */
+    tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+    /* Return successful completion status.  */
+    return(NX_SUCCESS);
+}
+
@@ -0,0 +1,152 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_tcp.h"
+
+
+#ifdef NX_ENABLE_TCP_RTT_ESTIMATION
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_socket_rtt_update                           PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function folds a new round-trip time sample into the socket's  */
+/*    smoothed round-trip time and round-trip time variation, and         */
+/*    recomputes the retransmit timeout from them as specified by RFC     */
+/*    6298. The timeout is bounded by NX_TCP_RTO_MINIMUM and              */
+/*    NX_TCP_RTO_MAXIMUM.                                                 */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to socket             */
+/*    rtt                                   Round-trip time sample in     */
+/*                                            timer ticks                 */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_socket_state_ack_check        Process received ACK          */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_tcp_socket_rtt_update(NX_TCP_SOCKET *socket_ptr, ULONG rtt)
+{
+
+ULONG srtt;
+ULONG rttvar;
+ULONG delta;
+ULONG rto;
+
+
+    /* A sample shorter than the timer resolution counts as one tick.  */
+    if (rtt == 0)
+    {
+        rtt =  1;
+    }
+
+    /* Pickup the current estimate.  SRTT is scaled by 8 and RTTVAR by 4.  */
+    srtt =    socket_ptr -> nx_tcp_socket_rtt_srtt;
+    rttvar =  socket_ptr -> nx_tcp_socket_rtt_rttvar;
+
+    /* Determine if this is the first sample of the connection.  */
+    if (srtt == 0)
+    {
+
+        /* Yes, SRTT = R and RTTVAR = R/2.  RFC 6298, Section 2.2.  */
+        srtt =    rtt << 3;
+        rttvar =  rtt << 1;
+    }
+    else
+    {
+
+        /* Compute |SRTT - R| against the previous smoothed value.  */
+        if (rtt > (srtt >> 3))
+        {
+            delta =  rtt - (srtt >> 3);
+        }
+        else
+        {
+            delta =  (srtt >> 3) - rtt;
+        }
+
+        /* RTTVAR = 3/4 RTTVAR + 1/4 |SRTT - R| and SRTT = 7/8 SRTT + 1/8 R.
+           RFC 6298, Section 2.3.  */
+        rttvar =  rttvar - (rttvar >> 2) + delta;
+        srtt =    srtt - (srtt >> 3) + rtt;
+    }
+
+    /* Save the new estimate.  */
+    socket_ptr -> nx_tcp_socket_rtt_srtt =    srtt;
+    socket_ptr -> nx_tcp_socket_rtt_rttvar =  rttvar;
+
+    /* RTO = SRTT + max(G, 4 * RTTVAR), where G is the TCP timer granularity.  */
+    rto =  srtt >> 3;
+    if (rttvar > _nx_tcp_fast_timer_rate)
+    {
+        rto =  rto + rttvar;
+    }
+    else
+    {
+        rto =  rto + _nx_tcp_fast_timer_rate;
+    }
+
+    /* Keep the retransmit timeout within the configured bounds.  */
+    if (rto < NX_TCP_RTO_MINIMUM)
+    {
+        rto =  NX_TCP_RTO_MINIMUM;
+    }
+    else if (rto > NX_TCP_RTO_MAXIMUM)
+    {
+        rto =  NX_TCP_RTO_MAXIMUM;
+    }
+
+    /* Use it for subsequent transmit timeouts.  */
+    socket_ptr -> nx_tcp_socket_timeout_rate =  rto;
+}
+#endif /* NX_ENABLE_TCP_RTT_ESTIMATION */
+
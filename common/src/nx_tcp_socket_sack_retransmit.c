@@ -0,0 +1,239 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_packet.h"
+#include "nx_tcp.h"
+
+
+#ifdef NX_ENABLE_TCP_SACK
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_socket_sack_retransmit                      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function retransmits, during fast recovery, the first segment  */
+/*    of the transmit sent list that has not been acknowledged            */
+/*    selectively, that lies below the highest data acknowledged          */
+/*    selectively and that has not yet been retransmitted in this         */
+/*    recovery. Of a super-segment built for segmentation offload, only   */
+/*    the first MSS of that data is retransmitted.                        */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                IP instance pointer           */
+/*    socket_ptr                            Pointer to owning socket      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    NX_TRUE                               A segment is retransmitted    */
+/*    NX_FALSE                              No segment to retransmit      */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_tcp_socket_retransmit_packet      Resend the transmit packet    */
+/*    _nx_tcp_socket_retransmit_slice       Resend one MSS of a packet    */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_socket_retransmit             Retransmit packet             */
+/*    _nx_tcp_socket_state_ack_check        Process received ACK          */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_tcp_socket_sack_retransmit(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr)
+{
+
+NX_PACKET         *packet_ptr;
+NX_TCP_HEADER     *header_ptr;
+NX_TCP_SACK_BLOCK *scoreboard;
+ULONG              header_length;
+ULONG              begin_sequence;
+ULONG              end_sequence;
+ULONG              sacked_sequence;
+UINT               count;
+UINT               i;
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+ULONG              slice_sequence;
+ULONG              slice_length;
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
+
+    /* Setup a pointer to the scoreboard.  */
+    scoreboard =  socket_ptr -> nx_tcp_socket_sack_scoreboard;
+    count =       socket_ptr -> nx_tcp_socket_sack_count;
+
+    /* Determine if the peer has acknowledged any data selectively.  */
+    if (count == 0)
+    {
+        return(NX_FALSE);
+    }
+
+    /* Only data below the highest data acknowledged selectively is considered lost.  */
+    sacked_sequence =  scoreboard[count - 1].nx_tcp_sack_block_end;
+
+    /* Pickup the head of the transmit queue.  */
+    packet_ptr =  socket_ptr -> nx_tcp_socket_transmit_sent_head;
+
+    /* Loop through the transmit sent list.  */
+    while ((packet_ptr) && (packet_ptr != (NX_PACKET *)NX_PACKET_ENQUEUED))
+    {
+
+        /* Setup a pointer to the TCP header of this packet.  */
+        header_ptr =  (NX_TCP_HEADER *)packet_ptr -> nx_packet_prepend_ptr;
+
+        /* Pickup the starting sequence number and header size.  */
+        begin_sequence =  header_ptr -> nx_tcp_sequence_number;
+        header_length =   header_ptr -> nx_tcp_header_word_3;
+        NX_CHANGE_ULONG_ENDIAN(begin_sequence);
+        NX_CHANGE_ULONG_ENDIAN(header_length);
+        header_length =  (header_length >> NX_TCP_HEADER_SHIFT) * sizeof(ULONG);
+
+        /* Compute the ending sequence number.  */
+        end_sequence =  begin_sequence + packet_ptr -> nx_packet_length - header_length;
+
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+
+        /* Determine if the segment is a super-segment built for segmentation offload.  */
+        if ((end_sequence - begin_sequence) > socket_ptr -> nx_tcp_socket_connect_mss)
+        {
+
+            /* Yes, find its first byte that is missing at the peer and has not been
+               retransmitted in this recovery.  */
+            slice_sequence =  begin_sequence;
+            if ((INT)(socket_ptr -> nx_tcp_socket_sack_retransmit_sequence - slice_sequence) > 0)
+            {
+                slice_sequence =  socket_ptr -> nx_tcp_socket_sack_retransmit_sequence;
+            }
+
+            /* Skip the ranges of the scoreboard, which are in sequence order.  */
+            for (i = 0; i < count; i++)
+            {
+                if (((INT)(slice_sequence - scoreboard[i].nx_tcp_sack_block_begin) >= 0) &&
+                    ((INT)(scoreboard[i].nx_tcp_sack_block_end - slice_sequence) > 0))
+                {
+                    slice_sequence =  scoreboard[i].nx_tcp_sack_block_end;
+                }
+            }
+
+            /* Determine if that byte is in the segment, below the highest data acknowledged
+               selectively, and the driver is done with the segment.  */
+            /*lint -e{923} suppress cast of ULONG to pointer.  */
+            if (((INT)(end_sequence - slice_sequence) > 0) &&
+                ((INT)(sacked_sequence - slice_sequence) > 0) &&
+                (packet_ptr -> nx_packet_queue_next == (NX_PACKET *)NX_DRIVER_TX_DONE))
+            {
+
+                /* Yes, retransmit one MSS from there, instead of the whole super-segment.  */
+                slice_length =  _nx_tcp_socket_retransmit_slice(ip_ptr, socket_ptr, packet_ptr, slice_sequence - begin_sequence);
+
+                /* Determine if no packet was available for the slice.  */
+                if (slice_length == 0)
+                {
+                    return(NX_FALSE);
+                }
+
+                /* Remember the data retransmitted in this recovery.  */
+                socket_ptr -> nx_tcp_socket_sack_retransmit_sequence =  slice_sequence + slice_length;
+
+                return(NX_TRUE);
+            }
+
+            /* Determine if the segment was sent after the highest data acknowledged selectively.  */
+            if ((INT)(end_sequence - sacked_sequence) > 0)
+            {
+
+                /* Yes, there is no evidence the rest was lost.  */
+                break;
+            }
+
+            /* Move to the next packet.  */
+            packet_ptr =  packet_ptr -> nx_packet_tcp_queue_next;
+
+            continue;
+        }
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
+        /* Determine if the segment was sent after the highest data acknowledged selectively.  */
+        if ((INT)(end_sequence - sacked_sequence) > 0)
+        {
+
+            /* Yes, there is no evidence it was lost.  */
+            break;
+        }
+
+        /* Determine if the segment has not been retransmitted in this recovery.  */
+        if ((INT)(end_sequence - socket_ptr -> nx_tcp_socket_sack_retransmit_sequence) > 0)
+        {
+
+            /* Determine if a range of the scoreboard covers the segment.  */
+            for (i = 0; i < count; i++)
+            {
+                if (((INT)(begin_sequence - scoreboard[i].nx_tcp_sack_block_begin) >= 0) &&
+                    ((INT)(scoreboard[i].nx_tcp_sack_block_end - end_sequence) >= 0))
+                {
+                    break;
+                }
+            }
+
+            /* Determine if the segment is missing at the peer and the driver is done with it.  */
+            /*lint -e{923} suppress cast of ULONG to pointer.  */
+            if ((i == count) && (packet_ptr -> nx_packet_queue_next == (NX_PACKET *)NX_DRIVER_TX_DONE))
+            {
+
+                /* Yes, remember the data retransmitted in this recovery.  */
+                socket_ptr -> nx_tcp_socket_sack_retransmit_sequence =  end_sequence;
+
+                /* Retransmit the segment.  */
+                _nx_tcp_socket_retransmit_packet(ip_ptr, socket_ptr, packet_ptr);
+
+                return(NX_TRUE);
+            }
+        }
+
+        /* Move to the next packet.  */
+        packet_ptr =  packet_ptr -> nx_packet_tcp_queue_next;
+    }
+
+    /* Nothing to retransmit.  */
+    return(NX_FALSE);
+}
+#endif /* NX_ENABLE_TCP_SACK */
+
@@ -0,0 +1,228 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_tcp.h"
+
+
+#ifdef NX_ENABLE_TCP_SACK
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_socket_sack_scoreboard_update               PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function updates the SACK scoreboard of the socket from an     */
+/*    incoming ACK. Ranges covered by the cumulative acknowledgment are   */
+/*    removed, and the blocks of the SACK option, if any, are merged into */
+/*    the scoreboard, which is kept in sequence order without overlapping */
+/*    ranges. If the scoreboard is full, the highest range is discarded.  */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to socket             */
+/*    tcp_header_ptr                        Pointer to incoming TCP       */
+/*                                            header                      */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_tcp_sack_option_get               Get SACK option blocks        */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_socket_state_ack_check        Process received ACK          */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_tcp_socket_sack_scoreboard_update(NX_TCP_SOCKET *socket_ptr, NX_TCP_HEADER *tcp_header_ptr)
+{
+
+NX_TCP_SACK_BLOCK  block[NX_TCP_SACK_BLOCKS_MAXIMUM];
+NX_TCP_SACK_BLOCK *scoreboard;
+ULONG              acknowledgment_number;
+ULONG              header_length;
+UINT               block_count;
+UINT               count;
+UINT               i;
+UINT               j;
+UINT               k;
+
+
+    /* Setup a pointer to the scoreboard.  */
+    scoreboard =  socket_ptr -> nx_tcp_socket_sack_scoreboard;
+    count =       socket_ptr -> nx_tcp_socket_sack_count;
+
+    /* Pickup the cumulative acknowledgment.  */
+    acknowledgment_number =  tcp_header_ptr -> nx_tcp_acknowledgment_number;
+
+    /* Find the ranges the cumulative acknowledgment covers entirely.  */
+    for (i = 0; i < count; i++)
+    {
+        if ((INT)(scoreboard[i].nx_tcp_sack_block_end - acknowledgment_number) > 0)
+        {
+            break;
+        }
+    }
+
+    /* Remove them.  */
+    if (i)
+    {
+        for (j = i; j < count; j++)
+        {
+            scoreboard[j - i] =  scoreboard[j];
+        }
+        count =  count - i;
+    }
+
+    /* Trim the first range to the cumulative acknowledgment.  */
+    if ((count) && ((INT)(scoreboard[0].nx_tcp_sack_block_begin - acknowledgment_number) < 0))
+    {
+        scoreboard[0].nx_tcp_sack_block_begin =  acknowledgment_number;
+    }
+
+    /* Determine the size of the TCP header.  */
+    header_length =  (tcp_header_ptr -> nx_tcp_header_word_3 >> NX_TCP_HEADER_SHIFT) * sizeof(ULONG);
+
+    /* Pickup the SACK blocks from the option area, if any.  */
+    if ((header_length <= sizeof(NX_TCP_HEADER)) ||
+        (_nx_tcp_sack_option_get((UCHAR *)(tcp_header_ptr + 1), header_length - sizeof(NX_TCP_HEADER),
+                                 block, &block_count) == NX_FALSE))
+    {
+        block_count =  0;
+    }
+
+    /* Loop to merge the blocks into the scoreboard.  */
+    for (i = 0; i < block_count; i++)
+    {
+
+        /* Ignore blocks that are empty, already covered by the cumulative acknowledgment or
+           beyond the data sent.  */
+        if (((INT)(block[i].nx_tcp_sack_block_end - block[i].nx_tcp_sack_block_begin) <= 0) ||
+            ((INT)(block[i].nx_tcp_sack_block_end - acknowledgment_number) <= 0) ||
+            ((INT)(block[i].nx_tcp_sack_block_end - socket_ptr -> nx_tcp_socket_tx_sequence) > 0))
+        {
+            continue;
+        }
+
+        /* Trim the block to the cumulative acknowledgment.  */
+        if ((INT)(block[i].nx_tcp_sack_block_begin - acknowledgment_number) < 0)
+        {
+            block[i].nx_tcp_sack_block_begin =  acknowledgment_number;
+        }
+
+        /* Skip the ranges that end before the block.  */
+        for (j = 0; j < count; j++)
+        {
+            if ((INT)(scoreboard[j].nx_tcp_sack_block_end - block[i].nx_tcp_sack_block_begin) >= 0)
+            {
+                break;
+            }
+        }
+
+        /* Extend the block over the ranges it overlaps or touches.  */
+        for (k = j; k < count; k++)
+        {
+            if ((INT)(scoreboard[k].nx_tcp_sack_block_begin - block[i].nx_tcp_sack_block_end) > 0)
+            {
+                break;
+            }
+
+            if ((INT)(scoreboard[k].nx_tcp_sack_block_begin - block[i].nx_tcp_sack_block_begin) < 0)
+            {
+                block[i].nx_tcp_sack_block_begin =  scoreboard[k].nx_tcp_sack_block_begin;
+            }
+
+            if ((INT)(scoreboard[k].nx_tcp_sack_block_end - block[i].nx_tcp_sack_block_end) > 0)
+            {
+                block[i].nx_tcp_sack_block_end =  scoreboard[k].nx_tcp_sack_block_end;
+            }
+        }
+
+        /* Determine if the block overlaps any range.  */
+        if (k > j)
+        {
+
+            /* Yes, the block replaces the ranges it overlaps.  */
+            scoreboard[j] =  block[i];
+
+            /* Close the gap left by the other ranges.  */
+            for (j++; k < count; j++, k++)
+            {
+                scoreboard[j] =  scoreboard[k];
+            }
+            count =  j;
+        }
+        else
+        {
+
+            /* No, the block is a new range.  Determine if the scoreboard is full.  */
+            if (count == NX_TCP_SACK_SCOREBOARD_SIZE)
+            {
+
+                /* Yes, discard the block if it is the highest range.  */
+                if (j == count)
+                {
+                    continue;
+                }
+
+                /* Otherwise discard the highest range.  */
+                count--;
+            }
+
+            /* Make room for the new range.  */
+            for (k = count; k > j; k--)
+            {
+                scoreboard[k] =  scoreboard[k - 1];
+            }
+
+            /* Insert it.  */
+            scoreboard[j] =  block[i];
+            count++;
+        }
+    }
+
+    /* Save the number of ranges.  */
+    socket_ptr -> nx_tcp_socket_sack_count =  count;
+}
+#endif /* NX_ENABLE_TCP_SACK */
+
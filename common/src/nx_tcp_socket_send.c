@@ -58,6 +58,8 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    (nx_tcp_socket_congestion_control)    Signal idle restart           */
+/*    _nx_ip_checksum_adjust_long           Adjust checksum incrementally */
 /*    _nx_ip_packet_send                    Packet send function          */
 /*    _nx_tcp_checksum                      Calculate TCP checksum        */
 /*    _nx_tcp_socket_thread_suspend         Suspend calling thread        */
@@ -75,6 +77,16 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            adjusted the checksum       */
+/*                                            incrementally when the      */
+/*                                            sequence number changes,    */
+/*                                            supported TCP checksum      */
+/*                                            offload, added congestion   */
+/*                                            control idle event, left    */
+/*                                            the checksums of TCP super- */
+/*                                            segments to segmentation,   */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 static UINT  _nx_tcp_socket_send_internal(NX_TCP_SOCKET *socket_ptr, NX_PACKET *packet_ptr, ULONG wait_option)
@@ -176,39 +188,62 @@ ULONG          tx_window_current;
     NX_CHANGE_ULONG_ENDIAN(header_ptr -> nx_tcp_header_word_3);
     NX_CHANGE_ULONG_ENDIAN(header_ptr -> nx_tcp_header_word_4);
 
-    do
-    {
+    /* Pickup the current transmit sequence number.  */
+    header_ptr -> nx_tcp_sequence_number =  socket_ptr -> nx_tcp_socket_tx_sequence;
+    sequence_number =  header_ptr -> nx_tcp_sequence_number;
+    NX_CHANGE_ULONG_ENDIAN(header_ptr -> nx_tcp_sequence_number);
 
-        /* Pickup the current transmit sequence number.  */
-        header_ptr -> nx_tcp_sequence_number =  socket_ptr -> nx_tcp_socket_tx_sequence;
-        sequence_number =  header_ptr -> nx_tcp_sequence_number;
-        NX_CHANGE_ULONG_ENDIAN(header_ptr -> nx_tcp_sequence_number);
-
-        /* Calculate the TCP checksum without protection.  */
+    /* Calculate the TCP checksum without protection.  */
 #ifndef NX_DISABLE_TCP_TX_CHECKSUM
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+    /* Determine if the interface computes the TCP checksum.  */
+#ifdef NX_ENABLE_TCP_GSO
+    if ((packet_ptr -> nx_packet_ip_interface -> nx_interface_capability_flag & NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM) ||
+        (packet_ptr -> nx_packet_tcp_segment_size))
+#else
+    if (packet_ptr -> nx_packet_ip_interface -> nx_interface_capability_flag & NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM)
+#endif /* NX_ENABLE_TCP_GSO */
+    {
+
+        /* Yes, leave the checksum to the interface.  A super-segment gets the checksum of each
+           of its segments when it is split.  */
+        checksum =  0;
+        packet_ptr -> nx_packet_interface_capability_flag |=  NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM;
+    }
+    else
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+    {
         checksum =  _nx_tcp_checksum(packet_ptr, packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_address, socket_ptr -> nx_tcp_socket_connect_ip);
+    }
 #else
-        checksum = 0;
+    checksum = 0;
 #endif
-        /* Place protection while we check the sequence number for the new TCP packet.  */
-        tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
 
-        /* Determine if the sequence number is the same.  */
-        if (sequence_number != socket_ptr -> nx_tcp_socket_tx_sequence)
-        {
+    /* Place protection while we check the sequence number for the new TCP packet.  */
+    tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
 
-            /* Another transmit on this socket took place and changed the sequence.  We need to
-               recalculate the checksum with a new sequence number.  Release protection and
-               just resume the loop.  */
-            tx_mutex_put(&(ip_ptr -> nx_ip_protection));
-        }
-        else
-        {
+    /* Bring the socket timers up to date before the transmit timeout is started.  */
+    _nx_tcp_socket_timer_update(socket_ptr);
+
+    /* Determine if the sequence number is the same.  */
+    if (sequence_number != socket_ptr -> nx_tcp_socket_tx_sequence)
+    {
 
-            /* We have a good checksum, proceed with sending the packet.  */
-            break;
+        /* Another transmit on this socket took place and changed the sequence.  Place the
+           new sequence number in the header and adjust the checksum for it instead of
+           recalculating it over the whole packet.  */
+        header_ptr -> nx_tcp_sequence_number =  socket_ptr -> nx_tcp_socket_tx_sequence;
+        NX_CHANGE_ULONG_ENDIAN(header_ptr -> nx_tcp_sequence_number);
+#ifndef NX_DISABLE_TCP_TX_CHECKSUM
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+        /* Determine if the checksum is left to the interface.  */
+        if (!(packet_ptr -> nx_packet_interface_capability_flag & NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM))
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+        {
+            checksum =  _nx_ip_checksum_adjust_long(checksum, sequence_number, socket_ptr -> nx_tcp_socket_tx_sequence);
         }
-    } while (NX_FOREVER);
+#endif
+    }
 
     /* Check for the socket being in an established state.  It's possible the connection could have gone
        away during the TCP checksum calculation above.  */
@@ -275,6 +310,18 @@ ULONG          tx_window_current;
         socket_ptr -> nx_tcp_socket_tx_sequence =  socket_ptr -> nx_tcp_socket_tx_sequence +
             (packet_ptr -> nx_packet_length - sizeof(NX_TCP_HEADER));
 
+#ifdef NX_ENABLE_TCP_RTT_ESTIMATION
+
+        /* Determine if a round-trip time sample is already being taken.  */
+        if (socket_ptr -> nx_tcp_socket_rtt_active == NX_FALSE)
+        {
+
+            /* No, time this segment until it is acknowledged.  */
+            socket_ptr -> nx_tcp_socket_rtt_active =    NX_TRUE;
+            socket_ptr -> nx_tcp_socket_rtt_sequence =  socket_ptr -> nx_tcp_socket_tx_sequence;
+            socket_ptr -> nx_tcp_socket_rtt_time =      tx_time_get();
+        }
+#endif /* NX_ENABLE_TCP_RTT_ESTIMATION */
 
         /* Yes, the packet can be sent.  Place the packet on the sent list.  */
         if (socket_ptr -> nx_tcp_socket_transmit_sent_head)
@@ -287,7 +334,10 @@ ULONG          tx_window_current;
         else
         {
 
-            /* Empty list, just setup the head and tail to the current packet.  */
+            /* Empty list, tell the congestion control algorithm the connection was idle.  */
+            (socket_ptr -> nx_tcp_socket_congestion_control)(socket_ptr, NX_TCP_CONGESTION_CONTROL_IDLE, 0);
+
+            /* Setup the head and tail to the current packet.  */
             socket_ptr -> nx_tcp_socket_transmit_sent_head =  packet_ptr;
             socket_ptr -> nx_tcp_socket_transmit_sent_tail =  packet_ptr;
 
@@ -403,7 +453,116 @@ ULONG          tx_window_current;
 /*                                                                        */
 /*  FUNCTION                                               RELEASE        */
 /*                                                                        */
-/*    _nx_tcp_socket_send                                 PORTABLE C      */
+/*    _nx_tcp_socket_send_segment_size                    PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function returns the payload size of the next segment sent on */
+/*    the specified socket.  This is MSS, unless TCP payload larger than  */
+/*    MSS is segmented by the interface or by the IP layer.  Then it is   */
+/*    the window still free, min(cwnd, swnd) less the outstanding bytes,  */
+/*    rounded down to a multiple of MSS with one MSS as the floor, so a   */
+/*    super-segment goes out as soon as it fits instead of after the      */
+/*    whole flight is acknowledged.                                       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to socket             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    segment_size                          Payload size of next segment  */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_socket_send_segments          Send data in segments         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+static ULONG  _nx_tcp_socket_send_segment_size(NX_TCP_SOCKET *socket_ptr)
+{
+
+ULONG segment_size;
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+ULONG tx_window_current;
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
+
+    /* MSS size is IP MTU - IP header - optional header - TCP header. */
+    segment_size =  socket_ptr -> nx_tcp_socket_connect_mss;
+
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+#ifdef NX_ENABLE_TCP_GSO
+    /* TCP payload larger than MSS is segmented by the interface, or by the IP layer in software
+       right before the packet is handed to the link driver.  */
+    if ((segment_size) && (socket_ptr -> nx_tcp_socket_connect_interface))
+#else
+    /* Determine if the interface segments (and checksums) TCP payload larger than MSS.  */
+    if ((segment_size) && (socket_ptr -> nx_tcp_socket_connect_interface) &&
+        ((socket_ptr -> nx_tcp_socket_connect_interface -> nx_interface_capability_flag &
+          (NX_INTERFACE_CAPABILITY_TCP_SEGMENTATION | NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM)) ==
+         (NX_INTERFACE_CAPABILITY_TCP_SEGMENTATION | NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM)))
+#endif /* NX_ENABLE_TCP_GSO */
+    {
+
+        /* Yes, pick up min(cwnd, swnd).  */
+        if (socket_ptr -> nx_tcp_socket_tx_window_advertised > socket_ptr -> nx_tcp_socket_tx_window_congestion)
+        {
+            tx_window_current =  socket_ptr -> nx_tcp_socket_tx_window_congestion;
+        }
+        else
+        {
+            tx_window_current =  socket_ptr -> nx_tcp_socket_tx_window_advertised;
+        }
+
+        /* Subtract the data in flight, the send logic only sends what fits in the rest of the
+           window.  */
+        if (tx_window_current > socket_ptr -> nx_tcp_socket_tx_outstanding_bytes)
+        {
+            tx_window_current -=  socket_ptr -> nx_tcp_socket_tx_outstanding_bytes;
+        }
+        else
+        {
+            tx_window_current =  0;
+        }
+
+        /* Limit the super-segment to what fits in one IP datagram.  */
+        if (tx_window_current > NX_TCP_SEGMENTATION_MAX_SIZE)
+        {
+            tx_window_current =  NX_TCP_SEGMENTATION_MAX_SIZE;
+        }
+
+        /* Round down to a multiple of MSS, but never below one MSS.  */
+        if (tx_window_current > segment_size)
+        {
+            segment_size =  tx_window_current - (tx_window_current % segment_size);
+        }
+    }
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
+    /* Return the segment size.  */
+    return(segment_size);
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_socket_send_segments                        PORTABLE C      */
 /*                                                           6.1          */
 /*  AUTHOR                                                                */
 /*                                                                        */
@@ -413,7 +572,9 @@ ULONG          tx_window_current;
 /*                                                                        */
 /*    This function sends a TCP packet through the specified socket.      */
 /*      If payload size exceeds MSS, this service fragments the payload   */
-/*      to fit into MSS.                                                  */
+/*      to fit into MSS.  If the interface performs TCP segmentation      */
+/*      offload, the payload is fragmented into super-segments instead,   */
+/*      which the interface splits into MSS sized segments.               */
 /*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
@@ -431,14 +592,17 @@ ULONG          tx_window_current;
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _nx_tcp_socket_send_internal          Transmit TCP payload          */
+/*    _nx_tcp_socket_send_segment_size      Size next (super-)segment     */
 /*    _nx_packet_allocate                   Packet allocation for         */
 /*                                            fragmentation               */
 /*    _nx_packet_release                    Packet release                */
 /*    _nx_packet_data_append                Move data into fragments      */
+/*    _nx_packet_data_reference             Reference shared data         */
+/*    _nx_tcp_socket_timer_update           Update socket timers          */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
-/*    Application                                                         */
+/*    _nx_tcp_socket_send                   Send data on TCP socket       */
 /*                                                                        */
 /*                                                                        */
 /*  RELEASE HISTORY                                                       */
@@ -448,9 +612,24 @@ ULONG          tx_window_current;
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), sent     */
+/*                                            super-segments to           */
+/*                                            interfaces with TCP         */
+/*                                            segmentation offload, added */
+/*                                            TCP timer wheel, added      */
+/*                                            round-trip time sampling,   */
+/*                                            referenced shared buffers   */
+/*                                            instead of copying them,    */
+/*                                            built super-segments for    */
+/*                                            software segmentation,      */
+/*                                            moved out of the send       */
+/*                                            service for send            */
+/*                                            coalescing, sized super-    */
+/*                                            segments to the free window,*/
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
-UINT  _nx_tcp_socket_send(NX_TCP_SOCKET *socket_ptr, NX_PACKET *packet_ptr, ULONG wait_option)
+static UINT  _nx_tcp_socket_send_segments(NX_TCP_SOCKET *socket_ptr, NX_PACKET *packet_ptr, ULONG wait_option)
 {
 
 ULONG      remaining_bytes;
@@ -463,16 +642,26 @@ ULONG      fragment_packet_space_remaining = 0;
 ULONG      copy_size;
 UCHAR     *current_ptr;
 ULONG      fragment_length;
+ULONG      segment_size;
 
     /* Initialize outcome to successful completion. */
     ret = NX_SUCCESS;
 
-    /* MSS size is IP MTU - IP header - optional header - TCP header. */
+    /* Pickup the size of the next segment or super-segment.  */
+    segment_size =  _nx_tcp_socket_send_segment_size(socket_ptr);
 
-    /* Send the packet directly if it is within MSS size. */
-    if (packet_ptr -> nx_packet_length <= socket_ptr -> nx_tcp_socket_connect_mss)
+    /* Send the packet directly if it is within the segment size. */
+    if (packet_ptr -> nx_packet_length <= segment_size)
     {
 
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+        /* Determine if the interface has to split this packet into MSS sized segments.  */
+        if (packet_ptr -> nx_packet_length > socket_ptr -> nx_tcp_socket_connect_mss)
+        {
+            packet_ptr -> nx_packet_tcp_segment_size =  socket_ptr -> nx_tcp_socket_connect_mss;
+        }
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
         return(_nx_tcp_socket_send_internal(socket_ptr, packet_ptr, wait_option));
     }
 
@@ -504,8 +693,12 @@ ULONG      fragment_length;
                 return(ret);
             }
 
-            /* The fragment remaining bytes cannot exceed the socket MSS. */
-            fragment_packet_space_remaining = socket_ptr -> nx_tcp_socket_connect_mss;
+            /* Size the fragment to the window that is free now, the previous fragment is in
+               flight.  */
+            segment_size =  _nx_tcp_socket_send_segment_size(socket_ptr);
+
+            /* The fragment remaining bytes cannot exceed the segment size. */
+            fragment_packet_space_remaining = segment_size;
 
             /* Initialize the fragment packet length. */
             fragment_packet -> nx_packet_length = 0;
@@ -547,9 +740,24 @@ ULONG      fragment_length;
             copy_size = fragment_packet_space_remaining;
         }
 
-        /* Append data. */
-        ret = _nx_packet_data_append(fragment_packet, current_ptr, copy_size,
-                                     ip_ptr -> nx_ip_default_packet_pool, wait_option);
+#ifdef NX_ENABLE_PACKET_CLONE
+        /* Determine if the source data is in a shared buffer, such as an application buffer
+           of a zero copy send.  */
+        if (current_packet -> nx_packet_clone_source)
+        {
+
+            /* Yes, reference the data from the fragment instead of copying it. */
+            ret = _nx_packet_data_reference(fragment_packet, current_packet, current_ptr, copy_size,
+                                            ip_ptr -> nx_ip_default_packet_pool, wait_option);
+        }
+        else
+#endif /* NX_ENABLE_PACKET_CLONE */
+        {
+
+            /* Append data. */
+            ret = _nx_packet_data_append(fragment_packet, current_ptr, copy_size,
+                                         ip_ptr -> nx_ip_default_packet_pool, wait_option);
+        }
 
         /* Check for errors with data append. */
         if (ret != NX_SUCCESS)
@@ -578,6 +786,15 @@ ULONG      fragment_length;
         {
             /* A fragment is ready to be transmitted. */
             fragment_length = fragment_packet -> nx_packet_length;
+
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+            /* Determine if the interface has to split this fragment into MSS sized segments.  */
+            if (fragment_length > socket_ptr -> nx_tcp_socket_connect_mss)
+            {
+                fragment_packet -> nx_packet_tcp_segment_size =  socket_ptr -> nx_tcp_socket_connect_mss;
+            }
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
             ret = _nx_tcp_socket_send_internal(socket_ptr, fragment_packet, wait_option);
 
             if (ret != NX_SUCCESS)
@@ -616,6 +833,15 @@ ULONG      fragment_length;
     /* Transmit the last fragment if not transmitted yet. */
     if (fragment_packet)
     {
+
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+        /* Determine if the interface has to split this fragment into MSS sized segments.  */
+        if (fragment_packet -> nx_packet_length > socket_ptr -> nx_tcp_socket_connect_mss)
+        {
+            fragment_packet -> nx_packet_tcp_segment_size =  socket_ptr -> nx_tcp_socket_connect_mss;
+        }
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
         ret =  _nx_tcp_socket_send_internal(socket_ptr, fragment_packet, wait_option);
 
         if (ret != NX_SUCCESS)
@@ -633,3 +859,282 @@ ULONG      fragment_length;
     return(ret);
 }
 
+
+#ifdef NX_ENABLE_TCP_SEND_COALESCING
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_socket_coalesce_send                        PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function sends data returned by send coalescing. If data held  */
+/*    back, which the application no longer owns, cannot be sent, it is   */
+/*    held back again while the socket is connected.                      */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to socket             */
+/*    send_packet                           Pointer to packet to send     */
+/*    packet_ptr                            Application packet, NULL when */
+/*                                            only held data is sent      */
+/*    wait_option                           Suspension option             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_packet_release                    Release packet                */
+/*    _nx_tcp_socket_send_segments          Send packet in segments       */
+/*    tx_mutex_get                          Obtain protection             */
+/*    tx_mutex_put                          Release protection            */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_socket_coalesce_flush         Send held data                */
+/*    _nx_tcp_socket_send                   Send data on TCP socket       */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+static UINT  _nx_tcp_socket_coalesce_send(NX_TCP_SOCKET *socket_ptr, NX_PACKET *send_packet,
+                                          NX_PACKET *packet_ptr, ULONG wait_option)
+{
+
+NX_IP     *ip_ptr;
+NX_PACKET *held_packet;
+UINT       status;
+
+
+    /* Send the packet.  */
+    status =  _nx_tcp_socket_send_segments(socket_ptr, send_packet, wait_option);
+
+    /* Determine if data held back, which the application no longer owns, could not be sent.  */
+    if ((status != NX_SUCCESS) && (send_packet != packet_ptr))
+    {
+
+        /* Setup IP pointer.  */
+        ip_ptr =  socket_ptr -> nx_tcp_socket_ip_ptr;
+
+        /* Obtain the IP mutex so we can access the socket.  */
+        tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
+
+        /* Determine if the socket is still connected.  */
+        if ((socket_ptr -> nx_tcp_socket_state == NX_TCP_ESTABLISHED) ||
+            (socket_ptr -> nx_tcp_socket_state == NX_TCP_CLOSE_WAIT))
+        {
+
+            /* Yes, hold the data back again, ahead of any data held back in the meantime.  */
+            held_packet =  socket_ptr -> nx_tcp_socket_coalesce_packet;
+            if (held_packet)
+            {
+
+                /* Chain the data held back in the meantime to the data that was not sent.  */
+                if (send_packet -> nx_packet_last)
+                {
+                    (send_packet -> nx_packet_last) -> nx_packet_next =  held_packet;
+                }
+                else
+                {
+                    send_packet -> nx_packet_next =  held_packet;
+                }
+                if (held_packet -> nx_packet_last)
+                {
+                    send_packet -> nx_packet_last =  held_packet -> nx_packet_last;
+                }
+                else
+                {
+                    send_packet -> nx_packet_last =  held_packet;
+                }
+                held_packet -> nx_packet_last =  NX_NULL;
+                send_packet -> nx_packet_length =  send_packet -> nx_packet_length + held_packet -> nx_packet_length;
+            }
+            socket_ptr -> nx_tcp_socket_coalesce_packet =  send_packet;
+        }
+        else
+        {
+
+            /* No, the data is dropped as the data in the transmit queue is.  */
+            _nx_packet_release(send_packet);
+        }
+
+        /* Release protection.  */
+        tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+        /* Determine if an application packet was merged into the data.  */
+        if (packet_ptr)
+        {
+
+            /* Yes, the application packet is accepted.  */
+            status =  NX_SUCCESS;
+        }
+    }
+
+    /* Return completion status.  */
+    return(status);
+}
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_socket_coalesce_flush                       PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function sends the data held back by send coalescing on the    */
+/*    specified socket, if any.                                           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to socket             */
+/*    wait_option                           Suspension option             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_tcp_socket_coalesce_send          Send coalesced data           */
+/*    tx_mutex_get                          Obtain protection             */
+/*    tx_mutex_put                          Release protection            */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_socket_disconnect             Disconnect TCP socket         */
+/*    _nx_tcp_socket_nodelay_set            Set Nagle's algorithm option  */
+/*    _nx_tcp_socket_state_transmit_check   Check for transmit suspension */
+/*    _nx_tcp_socket_uncork                 Uncork TCP socket             */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_tcp_socket_coalesce_flush(NX_TCP_SOCKET *socket_ptr, ULONG wait_option)
+{
+
+NX_IP     *ip_ptr;
+NX_PACKET *held_packet;
+
+
+    /* Setup IP pointer.  */
+    ip_ptr =  socket_ptr -> nx_tcp_socket_ip_ptr;
+
+    /* Obtain the IP mutex so we can access the socket.  */
+    tx_mutex_get(&(ip_ptr -> nx_ip_protection), TX_WAIT_FOREVER);
+
+    /* Pickup the data held back by the socket, it is no longer held back.  */
+    held_packet =  socket_ptr -> nx_tcp_socket_coalesce_packet;
+    socket_ptr -> nx_tcp_socket_coalesce_packet =  NX_NULL;
+
+    /* Release protection.  */
+    tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+
+    /* Determine if there is any data to send.  */
+    if (held_packet == NX_NULL)
+    {
+        return(NX_SUCCESS);
+    }
+
+    /* Send the held data.  */
+    return(_nx_tcp_socket_coalesce_send(socket_ptr, held_packet, NX_NULL, wait_option));
+}
+#endif /* NX_ENABLE_TCP_SEND_COALESCING */
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_socket_send                                 PORTABLE C      */
+/*                                                           6.1          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function sends a TCP packet through the specified socket. If   */
+/*    send coalescing is enabled, packets smaller than MSS are held back  */
+/*    and merged into fewer, larger segments while the socket is corked   */
+/*    or data is in flight.                                               */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to socket             */
+/*    packet_ptr                            Pointer to packet to send     */
+/*    wait_option                           Suspension option             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_tcp_socket_coalesce               Coalesce small packets        */
+/*    _nx_tcp_socket_coalesce_send          Send coalesced data           */
+/*    _nx_tcp_socket_send_segments          Send packet in segments       */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application                                                         */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
+/*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
+/*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            send coalescing, resulting  */
+/*                                            in version 6.x              */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_tcp_socket_send(NX_TCP_SOCKET *socket_ptr, NX_PACKET *packet_ptr, ULONG wait_option)
+{
+
+#ifdef NX_ENABLE_TCP_SEND_COALESCING
+NX_PACKET *send_packet;
+
+
+    /* Merge the packet into the data held back by the socket, or hold it back as well.  */
+    send_packet =  _nx_tcp_socket_coalesce(socket_ptr, packet_ptr);
+
+    /* Determine if there is anything to send now.  */
+    if (send_packet == NX_NULL)
+    {
+
+        /* No, the data is sent once more data is sent, the data in flight is acknowledged
+           or the socket is uncorked.  */
+        return(NX_SUCCESS);
+    }
+
+    /* Send the packet.  */
+    return(_nx_tcp_socket_coalesce_send(socket_ptr, send_packet, packet_ptr, wait_option));
+#else
+
+    /* Send the packet.  */
+    return(_nx_tcp_socket_send_segments(socket_ptr, packet_ptr, wait_option));
+#endif /* NX_ENABLE_TCP_SEND_COALESCING */
+}
@@ -58,9 +58,14 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    (nx_tcp_socket_congestion_control)    Grow congestion window        */
 /*    _nx_tcp_packet_send_ack               Send ACK message              */
 /*    _nx_packet_release                    Packet release function       */
 /*    _nx_tcp_socket_retransmit             Retransmit packet             */
+/*    _nx_tcp_socket_rtt_update             Update round-trip time        */
+/*    _nx_tcp_socket_sack_retransmit        Retransmit missing segment    */
+/*    _nx_tcp_socket_sack_scoreboard_update Update SACK scoreboard        */
+/*    _nx_tcp_socket_transmit_trim          Trim partially ACKed packet   */
 /*                                                                        */
 /*  CALLED BY                                                             */
 /*                                                                        */
@@ -77,6 +82,14 @@
 /*                                            fixed the bug of race       */
 /*                                            condition,                  */
 /*                                            resulting in version 6.1.9  */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            round-trip time sampling,   */
+/*                                            added SACK scoreboard       */
+/*                                            update, moved window growth */
+/*                                            to the congestion control   */
+/*                                            algorithm, trimmed packets  */
+/*                                            partially acknowledged,     */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_tcp_socket_state_ack_check(NX_TCP_SOCKET *socket_ptr, NX_TCP_HEADER *tcp_header_ptr)
@@ -95,6 +108,7 @@ ULONG          ending_packet_sequence;
 ULONG          starting_tx_sequence =  0;
 ULONG          ending_tx_sequence =  0;
 ULONG          acked_bytes;
+ULONG          trimmed_bytes =  0;
 UINT           wrapped_flag =  NX_FALSE;
 
 
@@ -141,6 +155,17 @@ UINT           wrapped_flag =  NX_FALSE;
         }
 #endif
 
+#ifdef NX_ENABLE_TCP_SACK
+
+        /* Determine if the peer may acknowledge data selectively.  */
+        if (socket_ptr -> nx_tcp_socket_sack_permitted == NX_TRUE)
+        {
+
+            /* Yes, update the scoreboard from this ACK.  */
+            _nx_tcp_socket_sack_scoreboard_update(socket_ptr, tcp_header_ptr);
+        }
+#endif /* NX_ENABLE_TCP_SACK */
+
 
         /* First, determine if incoming ACK matches our transmit sequence.  */
         if (tcp_header_ptr -> nx_tcp_acknowledgment_number == socket_ptr -> nx_tcp_socket_tx_sequence)
@@ -220,8 +245,18 @@ UINT           wrapped_flag =  NX_FALSE;
                              (socket_ptr -> nx_tcp_socket_fast_recovery == NX_TRUE))
                     {
 
-                        /* CWND += MSS  */
-                        socket_ptr -> nx_tcp_socket_tx_window_congestion += socket_ptr -> nx_tcp_socket_connect_mss;
+#ifdef NX_ENABLE_TCP_SACK
+                        /* Retransmit the next segment the peer is missing, if any.  The duplicate
+                           ACK then accounts for the retransmission instead of inflating the
+                           congestion window.  */
+                        if ((socket_ptr -> nx_tcp_socket_sack_count == 0) ||
+                            (_nx_tcp_socket_sack_retransmit(socket_ptr -> nx_tcp_socket_ip_ptr, socket_ptr) == NX_FALSE))
+#endif /* NX_ENABLE_TCP_SACK */
+                        {
+
+                            /* CWND += MSS  */
+                            socket_ptr -> nx_tcp_socket_tx_window_congestion += socket_ptr -> nx_tcp_socket_connect_mss;
+                        }
                     }
                 }
 
@@ -399,10 +434,18 @@ UINT           wrapped_flag =  NX_FALSE;
                     search_ptr =  NX_NULL;
                 }
             }
+
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+
+            /* Remove the data the ACK covers from the first packet it does not cover entirely.
+               A super-segment the peer received in part is then retransmitted from the first
+               byte the peer is missing, and the partial ACK opens the window.  */
+            trimmed_bytes =  _nx_tcp_socket_transmit_trim(socket_ptr, search_ptr, tcp_header_ptr -> nx_tcp_acknowledgment_number);
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
         }
 
-        /* Determine if anything needs to be released.  */
-        if (!packet_release_count)
+        /* Determine if anything needs to be released or trimmed.  */
+        if ((!packet_release_count) && (!trimmed_bytes))
         {
 
             /* No, check and see if the ACK is valid.  */
@@ -448,6 +491,20 @@ UINT           wrapped_flag =  NX_FALSE;
         else
         {
 
+#ifdef NX_ENABLE_TCP_RTT_ESTIMATION
+
+            /* Determine if this ACK covers the segment being timed.  */
+            if ((socket_ptr -> nx_tcp_socket_rtt_active == NX_TRUE) &&
+                ((INT)(tcp_header_ptr -> nx_tcp_acknowledgment_number -
+                       socket_ptr -> nx_tcp_socket_rtt_sequence) >= 0))
+            {
+
+                /* Yes, the sample is complete.  Update the retransmit timeout from it.  */
+                socket_ptr -> nx_tcp_socket_rtt_active =  NX_FALSE;
+                _nx_tcp_socket_rtt_update(socket_ptr, tx_time_get() - socket_ptr -> nx_tcp_socket_rtt_time);
+            }
+#endif /* NX_ENABLE_TCP_RTT_ESTIMATION */
+
             /* Congestion window adjustment during slow start and congestion avoidance is executed
                on every incoming ACK that acknowledges new data. RFC5681, Section3.1, Page4-8.  */
             /* Check whether the socket is in fast recovery procedure. */
@@ -502,6 +559,12 @@ UINT           wrapped_flag =  NX_FALSE;
                 starting_tx_sequence =  search_header_ptr -> nx_tcp_sequence_number;
                 NX_CHANGE_ULONG_ENDIAN(starting_tx_sequence);
 
+                /* If only the head was trimmed, the acknowledged data preceded it.  */
+                if (!packet_release_count)
+                {
+                    starting_tx_sequence =  starting_tx_sequence - trimmed_bytes;
+                }
+
                 /* Set previous cumulative acknowlesgement. */
                 socket_ptr -> nx_tcp_socket_previous_highest_ack = starting_tx_sequence;
 
@@ -522,44 +585,8 @@ UINT           wrapped_flag =  NX_FALSE;
             else
             {
 
-                /* Adjust the transmit window.  In slow start phase, the transmit window is incremented for every ACK.
-                   In Congestion Avoidance phase, the window is incremented for every RTT.  */
-                if (socket_ptr -> nx_tcp_socket_tx_window_congestion >= socket_ptr -> nx_tcp_socket_tx_slow_start_threshold)
-                {
-
-                    /* In Congestion avoidance phase, for every ACK it receives, increase the window size using the
-                       following approximation:
-                       cwnd = cwnd + MSS * MSS / cwnd;
-                     */
-                    temp = socket_ptr -> nx_tcp_socket_connect_mss2 / socket_ptr -> nx_tcp_socket_tx_window_congestion;
-
-                    /* If the above formula yields 0, the result SHOULD be rounded up to 1 byte.  */
-                    if (temp == 0)
-                    {
-                        temp = 1;
-                    }
-
-                    socket_ptr -> nx_tcp_socket_tx_window_congestion = socket_ptr -> nx_tcp_socket_tx_window_congestion + temp;
-                }
-                else
-                {
-
-                    /* cwnd += min (N, SMSS).
-                       where N is the number of ACKed bytes. */
-                    /* Section 3.1, Page 6, RFC5681. */
-                    if (acked_bytes < socket_ptr -> nx_tcp_socket_connect_mss)
-                    {
-
-                        /* In Slow start phase. Increase the cwnd by full MSS for every ack.*/
-                        socket_ptr -> nx_tcp_socket_tx_window_congestion += (tcp_header_ptr -> nx_tcp_acknowledgment_number - starting_tx_sequence);
-                    }
-                    else
-                    {
-
-                        /* In Slow start phase. Increase the cwnd by full MSS for every ack.*/
-                        socket_ptr -> nx_tcp_socket_tx_window_congestion += socket_ptr -> nx_tcp_socket_connect_mss;
-                    }
-                }
+                /* Let the congestion control algorithm grow the transmit window.  */
+                (socket_ptr -> nx_tcp_socket_congestion_control)(socket_ptr, NX_TCP_CONGESTION_CONTROL_ACK, acked_bytes);
             }
         }
 
@@ -570,7 +597,15 @@ UINT           wrapped_flag =  NX_FALSE;
 
         /* Okay so now the packet after the previous pointer needs to be the front of the
            queue.  */
-        if (previous_ptr != socket_ptr -> nx_tcp_socket_transmit_sent_tail)
+        if (!packet_release_count)
+        {
+
+            /* Only the front of the head was acknowledged, it stays at the front of the queue.
+               Setup a new transmit timeout.  */
+            socket_ptr -> nx_tcp_socket_timeout =          socket_ptr -> nx_tcp_socket_timeout_rate;
+            socket_ptr -> nx_tcp_socket_timeout_retries =  0;
+        }
+        else if (previous_ptr != socket_ptr -> nx_tcp_socket_transmit_sent_tail)
         {
 
             /* Just update the head pointer.  */
@@ -288,6 +288,8 @@ ULONG      work_length;
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _nx_packet_release                    Release packet on overlap     */
+/*    _nx_tcp_socket_reassembly_insert      Queue out-of-order packet     */
+/*    _nx_tcp_socket_reassembly_rebuild     Rebuild reassembly index      */
 /*    _nx_tcp_socket_thread_resume          Resume suspended thread       */
 /*    _nx_tcp_packet_send_ack               Send immediate ACK            */
 /*    (nx_tcp_receive_callback)             Packet receive notify function*/
@@ -305,6 +307,12 @@ ULONG      work_length;
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s),          */
+/*                                            reported out-of-order data  */
+/*                                            with SACK, added reassembly */
+/*                                            index, resumed threads that */
+/*                                            copy data in place,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_tcp_socket_state_data_check(NX_TCP_SOCKET *socket_ptr, NX_PACKET *packet_ptr)
@@ -519,9 +527,6 @@ NX_IP *ip_ptr;
     else if (socket_ptr -> nx_tcp_socket_receive_queue_head == NX_NULL)
     {
 
-        /* Packet data begins to the right of the expected sequence (out of sequence data). Force an ACK. */
-        _nx_tcp_packet_send_ack(socket_ptr, socket_ptr -> nx_tcp_socket_tx_sequence);
-
         /* There are no packets chained on the receive queue.  Simply add the
            new packet to the receive queue. */
         socket_ptr -> nx_tcp_socket_receive_queue_head = packet_ptr;
@@ -543,7 +548,43 @@ NX_IP *ip_ptr;
 #ifdef NX_ENABLE_TCP_WINDOW_SCALING
         socket_ptr -> nx_tcp_socket_tx_window_advertised <<= socket_ptr -> nx_tcp_snd_win_scale_value;
 #endif /* NX_ENABLE_TCP_WINDOW_SCALING */
+
+#ifdef NX_ENABLE_TCP_REASSEMBLY_INDEX
+
+        /* Index the packet as the first run of out-of-order data.  */
+        _nx_tcp_socket_reassembly_rebuild(socket_ptr);
+#endif /* NX_ENABLE_TCP_REASSEMBLY_INDEX */
+
+#ifdef NX_ENABLE_TCP_SACK
+
+        /* Remember the most recent out-of-order segment, it is reported first.  */
+        socket_ptr -> nx_tcp_socket_sack_recent =  packet_begin_sequence;
+#endif /* NX_ENABLE_TCP_SACK */
+
+        /* Packet data begins to the right of the expected sequence (out of sequence data). Force an ACK.
+           The packet is queued first so that a SACK option reports it.  */
+        _nx_tcp_packet_send_ack(socket_ptr, socket_ptr -> nx_tcp_socket_tx_sequence);
     }
+#ifdef NX_ENABLE_TCP_REASSEMBLY_INDEX
+    else if (_nx_tcp_socket_reassembly_insert(socket_ptr, packet_ptr, packet_begin_sequence,
+                                              packet_end_sequence, &acked_packets) == NX_TRUE)
+    {
+
+        /* The reassembly index placed the packet in a hole of the receive queue.  */
+
+        /* Packet data begins to the right of the expected sequence (out of sequence data). Force an ACK.  */
+        if (((INT)packet_begin_sequence - (INT)original_rx_sequence) > 0)
+        {
+
+#ifdef NX_ENABLE_TCP_SACK
+            /* Remember the most recent out-of-order segment, it is reported first.  */
+            socket_ptr -> nx_tcp_socket_sack_recent =  packet_begin_sequence;
+
+#endif /* NX_ENABLE_TCP_SACK */
+            _nx_tcp_packet_send_ack(socket_ptr, socket_ptr -> nx_tcp_socket_tx_sequence);
+        }
+    }
+#endif /* NX_ENABLE_TCP_REASSEMBLY_INDEX */
     else
     {       /* Out of order insertion with packets on the queue. */
 
@@ -554,12 +595,6 @@ NX_IP *ip_ptr;
         /* Go through the received packet chain, and locate the first packet that the
            packet_begin_sequence is to the right of the end of it. */
 
-        /* Packet data begins to the right of the expected sequence (out of sequence data). Force an ACK. */
-        if (((INT)packet_begin_sequence - (INT)socket_ptr -> nx_tcp_socket_rx_sequence) > 0)
-        {
-            _nx_tcp_packet_send_ack(socket_ptr, socket_ptr -> nx_tcp_socket_tx_sequence);
-        }
-
         /* At this point, it is guaranteed that the receive queue contains packets. */
         search_ptr = socket_ptr -> nx_tcp_socket_receive_queue_head;
 
@@ -782,6 +817,19 @@ NX_IP *ip_ptr;
         /* Increment the receive TCP packet count.  */
         socket_ptr -> nx_tcp_socket_receive_queue_count++;
 
+        /* Packet data begins to the right of the expected sequence (out of sequence data). Force an ACK.
+           The packet is queued first so that a SACK option reports it.  */
+        if (((INT)packet_begin_sequence - (INT)socket_ptr -> nx_tcp_socket_rx_sequence) > 0)
+        {
+
+#ifdef NX_ENABLE_TCP_SACK
+            /* Remember the most recent out-of-order segment, it is reported first.  */
+            socket_ptr -> nx_tcp_socket_sack_recent =  packet_begin_sequence;
+
+#endif /* NX_ENABLE_TCP_SACK */
+            _nx_tcp_packet_send_ack(socket_ptr, socket_ptr -> nx_tcp_socket_tx_sequence);
+        }
+
         /* End of the out-of-order search.  At this point, the packet has been inserted. */
 
         /* Now we need to figure out how much, if any, we can ACK.  */
@@ -845,6 +893,12 @@ NX_IP *ip_ptr;
 
         /* If there are no packet crosses the rx_sequence, the TCP stream in the receive queue contains
            missing pieces. */
+
+#ifdef NX_ENABLE_TCP_REASSEMBLY_INDEX
+
+        /* Bring the reassembly index up to date with the receive queue.  */
+        _nx_tcp_socket_reassembly_rebuild(socket_ptr);
+#endif /* NX_ENABLE_TCP_REASSEMBLY_INDEX */
     }   /* End of out-of-order insertion. */
 
 
@@ -913,6 +967,12 @@ NX_IP *ip_ptr;
 
         /* Decrease receive queue count. */
         socket_ptr -> nx_tcp_socket_receive_queue_count--;
+
+#ifdef NX_ENABLE_TCP_REASSEMBLY_INDEX
+
+        /* Bring the reassembly index up to date with the receive queue.  */
+        _nx_tcp_socket_reassembly_rebuild(socket_ptr);
+#endif /* NX_ENABLE_TCP_REASSEMBLY_INDEX */
     }
 #endif /* NX_TCP_MAX_OUT_OF_ORDER_PACKETS */
 
@@ -923,6 +983,18 @@ NX_IP *ip_ptr;
     while (acked_packets && socket_ptr -> nx_tcp_socket_receive_suspension_list)
     {
 
+        /* Determine if the first suspended thread copies the data from the receive queue
+           with nx_tcp_socket_data_receive, which suspends without a return packet pointer.  */
+        if ((socket_ptr -> nx_tcp_socket_receive_suspension_list) -> tx_thread_additional_suspend_info == NX_NULL)
+        {
+
+            /* Yes, leave the data on the receive queue and resume the thread to copy it.  */
+            socket_ptr -> nx_tcp_socket_receive_suspended_count--;
+            acked_packets--;
+            _nx_tcp_socket_thread_resume(&(socket_ptr -> nx_tcp_socket_receive_suspension_list), NX_SUCCESS);
+            continue;
+        }
+
         /* Setup a pointer to the first queued packet.  */
         packet_ptr =  socket_ptr -> nx_tcp_socket_receive_queue_head;
         /* Remove it from the queue.  */
@@ -59,6 +59,8 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    (nx_tcp_socket_congestion_control)    Initialize congestion control */
+/*    _nx_tcp_listen_pool_recycle           Return socket to pool         */
 /*    _nx_tcp_socket_thread_resume          Resume suspended thread       */
 /*    _nx_tcp_packet_send_rst               Send RST packet               */
 /*                                                                        */
@@ -73,12 +75,20 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            congestion control          */
+/*                                            initialization, added       */
+/*                                            listen socket pool,         */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_tcp_socket_state_syn_received(NX_TCP_SOCKET *socket_ptr, NX_TCP_HEADER *tcp_header_ptr)
 {
 UINT window_wrap_flag = NX_FALSE;
 UINT outside_of_window;
+#ifdef NX_ENABLE_TCP_LISTEN_POOL
+struct NX_TCP_LISTEN_STRUCT *listen_ptr;
+#endif /* NX_ENABLE_TCP_LISTEN_POOL */
 
 
     /* Determine if the incoming message is an ACK message.  If it is and
@@ -144,9 +154,34 @@ UINT outside_of_window;
             }
         }
 
+        /* Let the congestion control algorithm start from the initial window.  */
+        (socket_ptr -> nx_tcp_socket_congestion_control)(socket_ptr, NX_TCP_CONGESTION_CONTROL_INIT, 0);
+
         /* Move into the ESTABLISHED state.  */
         socket_ptr -> nx_tcp_socket_state =  NX_TCP_ESTABLISHED;
 
+#ifdef NX_ENABLE_TCP_LISTEN_POOL
+
+        /* Determine if the socket was taken from a listen pool.  */
+        if (socket_ptr -> nx_tcp_socket_listen_pool)
+        {
+
+            /* Yes, place the socket at the end of the accept queue of its listen request.  */
+            listen_ptr =  socket_ptr -> nx_tcp_socket_listen_pool;
+            socket_ptr -> nx_tcp_socket_listen_pool_next =  NX_NULL;
+            if (listen_ptr -> nx_tcp_listen_accept_tail)
+            {
+                (listen_ptr -> nx_tcp_listen_accept_tail) -> nx_tcp_socket_listen_pool_next =  socket_ptr;
+            }
+            else
+            {
+                listen_ptr -> nx_tcp_listen_accept_head =  socket_ptr;
+            }
+            listen_ptr -> nx_tcp_listen_accept_tail =  socket_ptr;
+            listen_ptr -> nx_tcp_listen_accept_count++;
+        }
+#endif /* NX_ENABLE_TCP_LISTEN_POOL */
+
 #ifndef NX_DISABLE_EXTENDED_NOTIFY_SUPPORT
 
         /* If registered with the TCP socket, call the application's connection completion callback function.  */
@@ -240,6 +275,15 @@ UINT outside_of_window;
 
             /* This socket should not have an active timeout. */
             socket_ptr -> nx_tcp_socket_timeout = 0;
+
+#ifdef NX_ENABLE_TCP_LISTEN_POOL
+
+            /* A pooled socket goes back to its pool to wait for the next connection request.  */
+            if (socket_ptr -> nx_tcp_socket_listen_pool)
+            {
+                _nx_tcp_listen_pool_recycle(socket_ptr);
+            }
+#endif /* NX_ENABLE_TCP_LISTEN_POOL */
         }
         else
         {
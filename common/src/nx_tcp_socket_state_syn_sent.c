@@ -58,6 +58,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    (nx_tcp_socket_congestion_control)    Initialize congestion control */
 /*    _nx_tcp_packet_send_ack               Send ACK packet               */
 /*    _nx_tcp_packet_send_syn               Send SYN packet               */
 /*    _nx_tcp_packet_send_rst               Send RST packet               */
@@ -74,6 +75,10 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            congestion control          */
+/*                                            initialization, resulting   */
+/*                                            in version 6.x              */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_tcp_socket_state_syn_sent(NX_TCP_SOCKET *socket_ptr, NX_TCP_HEADER *tcp_header_ptr)
@@ -149,6 +154,9 @@ VOID  _nx_tcp_socket_state_syn_sent(NX_TCP_SOCKET *socket_ptr, NX_TCP_HEADER *tc
             }
         }
 
+        /* Let the congestion control algorithm start from the initial window.  */
+        (socket_ptr -> nx_tcp_socket_congestion_control)(socket_ptr, NX_TCP_CONGESTION_CONTROL_INIT, 0);
+
         /* Send the ACK.  */
         _nx_tcp_packet_send_ack(socket_ptr, socket_ptr -> nx_tcp_socket_tx_sequence);
 
@@ -223,6 +231,9 @@ VOID  _nx_tcp_socket_state_syn_sent(NX_TCP_SOCKET *socket_ptr, NX_TCP_HEADER *tc
             socket_ptr -> nx_tcp_socket_tx_window_congestion -= socket_ptr -> nx_tcp_socket_connect_mss;
         }
 
+        /* Let the congestion control algorithm start from the initial window.  */
+        (socket_ptr -> nx_tcp_socket_congestion_control)(socket_ptr, NX_TCP_CONGESTION_CONTROL_INIT, 0);
+
         /* Set the Initial transmit outstanding byte count. */
         socket_ptr -> nx_tcp_socket_tx_outstanding_bytes = 0;
 
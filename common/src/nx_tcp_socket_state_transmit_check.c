@@ -46,6 +46,8 @@
 /*    This function determines if the new receive window value is large   */
 /*    enough to satisfy a thread suspended trying to send data on the TCP */
 /*    connection.  This is typically called from the ESTABLISHED state.   */
+/*    It also sends the data held back by send coalescing once it is no   */
+/*    longer held back.                                                   */
 /*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
@@ -58,6 +60,7 @@
 /*  CALLS                                                                 */
 /*                                                                        */
 /*    _nx_ip_packet_send                    Send IP packet                */
+/*    _nx_tcp_socket_coalesce_flush         Send held data                */
 /*    _nx_tcp_socket_thread_resume          Resume suspended thread       */
 /*                                                                        */
 /*  CALLED BY                                                             */
@@ -71,6 +74,10 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), sent     */
+/*                                            data held back by send      */
+/*                                            coalescing, resulting in    */
+/*                                            version 6.x                 */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_tcp_socket_state_transmit_check(NX_TCP_SOCKET *socket_ptr)
@@ -206,5 +213,23 @@ ULONG      tx_window_current;
             _nx_tcp_socket_thread_resume(&(socket_ptr -> nx_tcp_socket_transmit_suspension_list), NX_SUCCESS);
         }
     }
+
+#ifdef NX_ENABLE_TCP_SEND_COALESCING
+
+    /* Determine if data is held back while no thread is suspended attempting to transmit,
+       and the data is no longer held back because it reached MSS, or the socket is not
+       corked and either all data in flight is acknowledged or Nagle's algorithm is not used.  */
+    if ((socket_ptr -> nx_tcp_socket_coalesce_packet) &&
+        (socket_ptr -> nx_tcp_socket_transmit_suspension_list == NX_NULL) &&
+        (((socket_ptr -> nx_tcp_socket_coalesce_packet) -> nx_packet_length >= socket_ptr -> nx_tcp_socket_connect_mss) ||
+         (!(socket_ptr -> nx_tcp_socket_coalesce_options & NX_TCP_COALESCE_CORK) &&
+          ((socket_ptr -> nx_tcp_socket_coalesce_options & NX_TCP_COALESCE_NODELAY) ||
+           (socket_ptr -> nx_tcp_socket_transmit_sent_head == NX_NULL)))))
+    {
+
+        /* Send the held data.  If the window does not allow it, the data remains held back.  */
+        _nx_tcp_socket_coalesce_flush(socket_ptr, NX_NO_WAIT);
+    }
+#endif /* NX_ENABLE_TCP_SEND_COALESCING */
 }
 
@@ -0,0 +1,165 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+#include "nx_tcp.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_socket_timer_update                         PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function must be called before a timer of the socket is        */
+/*    started or restarted outside of the fast periodic processing.  It   */
+/*    ages the running delayed ACK, transmit and keepalive timers of the  */
+/*    socket to the current fast timer tick and schedules the socket for  */
+/*    the next tick, where its next timer expiration is computed again.   */
+/*    Running timers are never expired here, since the socket is always   */
+/*    processed on the wheel before its earliest timer expires.           */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to TCP socket         */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_tcp_timer_wheel_insert            Insert into timer wheel       */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_client_socket_connect         Client connect service        */
+/*    _nx_tcp_packet_process                Process incoming TCP packet   */
+/*    _nx_tcp_server_socket_accept          Server accept service         */
+/*    _nx_tcp_socket_disconnect             Disconnect service            */
+/*    _nx_tcp_socket_keepalive_set          Set socket keepalive          */
+/*    _nx_tcp_socket_packet_process         Process socket packet         */
+/*    _nx_tcp_socket_receive                Socket receive service        */
+/*    _nx_tcp_socket_send                   Socket send service           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_tcp_socket_timer_update(NX_TCP_SOCKET *socket_ptr)
+{
+
+NX_IP *ip_ptr;
+ULONG  elapsed;
+#ifdef NX_ENABLE_TCP_KEEPALIVE
+ULONG  seconds;
+#endif /* NX_ENABLE_TCP_KEEPALIVE */
+
+
+    /* Setup the IP pointer.  */
+    ip_ptr =  socket_ptr -> nx_tcp_socket_ip_ptr;
+
+    /* Determine if the socket has running timers on the timer wheel.  */
+    if (socket_ptr -> nx_tcp_socket_timer_next)
+    {
+
+        /* Yes, compute the time elapsed since the timers were last aged.  */
+        elapsed =  (ip_ptr -> nx_ip_tcp_timer_tick - socket_ptr -> nx_tcp_socket_timer_tick) * _nx_tcp_fast_timer_rate;
+
+        /* Determine if the delayed ACK timer is running.  */
+        if (NX_TCP_DELAYED_ACK_ACTIVE(socket_ptr))
+        {
+
+            /* Age the delayed ACK timer, leaving at least one tick.  */
+            if (socket_ptr -> nx_tcp_socket_delayed_ack_timeout > elapsed)
+            {
+                socket_ptr -> nx_tcp_socket_delayed_ack_timeout =
+                    socket_ptr -> nx_tcp_socket_delayed_ack_timeout - elapsed;
+            }
+            else
+            {
+                socket_ptr -> nx_tcp_socket_delayed_ack_timeout =  1;
+            }
+        }
+
+        /* Determine if the transmit timer is running.  */
+        if (socket_ptr -> nx_tcp_socket_timeout)
+        {
+
+            /* Age the transmit timer, leaving at least one tick.  */
+            if (socket_ptr -> nx_tcp_socket_timeout > elapsed)
+            {
+                socket_ptr -> nx_tcp_socket_timeout =  socket_ptr -> nx_tcp_socket_timeout - elapsed;
+            }
+            else
+            {
+                socket_ptr -> nx_tcp_socket_timeout =  1;
+            }
+        }
+
+#ifdef NX_ENABLE_TCP_KEEPALIVE
+
+        /* Determine if the keepalive timer is running.  */
+        if (NX_TCP_KEEPALIVE_ACTIVE(socket_ptr))
+        {
+
+            /* Age the keepalive timer by the whole seconds elapsed, leaving at least one second.  */
+            socket_ptr -> nx_tcp_socket_keepalive_ticks =  socket_ptr -> nx_tcp_socket_keepalive_ticks + elapsed;
+            seconds =  socket_ptr -> nx_tcp_socket_keepalive_ticks / NX_IP_PERIODIC_RATE;
+            if (seconds >= socket_ptr -> nx_tcp_socket_keepalive_timeout)
+            {
+                seconds =  socket_ptr -> nx_tcp_socket_keepalive_timeout - 1;
+            }
+            socket_ptr -> nx_tcp_socket_keepalive_timeout =  socket_ptr -> nx_tcp_socket_keepalive_timeout - seconds;
+            socket_ptr -> nx_tcp_socket_keepalive_ticks =  socket_ptr -> nx_tcp_socket_keepalive_ticks - (seconds * NX_IP_PERIODIC_RATE);
+        }
+#endif /* NX_ENABLE_TCP_KEEPALIVE */
+    }
+    else
+    {
+
+        /* No timers were running, so there is no partial keepalive second.  */
+        socket_ptr -> nx_tcp_socket_keepalive_ticks =  0;
+    }
+
+    /* The socket timers are now current.  */
+    socket_ptr -> nx_tcp_socket_timer_tick =  ip_ptr -> nx_ip_tcp_timer_tick;
+
+    /* Process the socket on the next tick to pick up any timer started by the caller.  */
+    _nx_tcp_timer_wheel_insert(ip_ptr, socket_ptr, 1);
+}
+
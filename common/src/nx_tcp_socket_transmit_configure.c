@@ -78,6 +78,10 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            default timeout for round-  */
+/*                                            trip time estimation,       */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_tcp_socket_transmit_configure(NX_TCP_SOCKET *socket_ptr, ULONG max_queue_depth,
@@ -102,6 +106,9 @@ NX_IP *ip_ptr;
     socket_ptr -> nx_tcp_socket_timeout_shift =                   timeout_shift;
     socket_ptr -> nx_tcp_socket_transmit_queue_maximum_default =  max_queue_depth;
     socket_ptr -> nx_tcp_socket_transmit_queue_maximum =          max_queue_depth;
+#ifdef NX_ENABLE_TCP_RTT_ESTIMATION
+    socket_ptr -> nx_tcp_socket_timeout_rate_default =            timeout;
+#endif /* NX_ENABLE_TCP_RTT_ESTIMATION */
 
     /* Release the IP protection.  */
     tx_mutex_put(&(ip_ptr -> nx_ip_protection));
@@ -44,7 +44,7 @@
 /*  DESCRIPTION                                                           */
 /*                                                                        */
 /*    This function releases all packets in the specified socket's        */
-/*    transmit queue.                                                     */
+/*    transmit queue, and the data held back by send coalescing.          */
 /*                                                                        */
 /*  INPUT                                                                 */
 /*                                                                        */
@@ -71,6 +71,10 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), released */
+/*                                            data held back by send      */
+/*                                            coalescing, resulting in    */
+/*                                            version 6.x                 */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_tcp_socket_transmit_queue_flush(NX_TCP_SOCKET *socket_ptr)
@@ -127,5 +131,17 @@ NX_PACKET *next_packet_ptr;
         /* Decrease the queued packet count.  */
         socket_ptr -> nx_tcp_socket_transmit_sent_count--;
     }
+
+#ifdef NX_ENABLE_TCP_SEND_COALESCING
+
+    /* Determine if data is held back by send coalescing.  */
+    if (socket_ptr -> nx_tcp_socket_coalesce_packet)
+    {
+
+        /* Release the held data, it is never sent.  */
+        _nx_packet_release(socket_ptr -> nx_tcp_socket_coalesce_packet);
+        socket_ptr -> nx_tcp_socket_coalesce_packet =  NX_NULL;
+    }
+#endif /* NX_ENABLE_TCP_SEND_COALESCING */
 }
 
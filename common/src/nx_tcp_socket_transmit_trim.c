@@ -0,0 +1,188 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_packet.h"
+#include "nx_tcp.h"
+
+
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_socket_transmit_trim                        PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function removes the data an ACK covers from the front of a    */
+/*    packet of the socket's transmit sent list, when the ACK ends inside */
+/*    the packet, as it does for a super-segment the peer received only   */
+/*    in part. The TCP header is moved up to the remaining data and its   */
+/*    sequence number advanced, so a retransmission starts at the first   */
+/*    byte the peer is missing. The checksum is left to the interface or  */
+/*    to the IP layer, since the payload changed.                         */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to owning socket      */
+/*    packet_ptr                            Pointer to packet to trim     */
+/*    acknowledgment_number                 ACK number received           */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    trim_length                           Number of bytes removed       */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_packet_release                    Release emptied buffer        */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_socket_state_ack_check        Process ACK number            */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+ULONG  _nx_tcp_socket_transmit_trim(NX_TCP_SOCKET *socket_ptr, NX_PACKET *packet_ptr, ULONG acknowledgment_number)
+{
+
+NX_TCP_HEADER *header_ptr;
+NX_PACKET     *work_ptr;
+ULONG          header_length;
+ULONG          sequence_number;
+ULONG          trim_length;
+ULONG          remaining_bytes;
+ULONG          work_length;
+ULONG          temp;
+
+
+    /* Determine if there is a packet the driver has finished with.  */
+    /*lint -e{923} suppress cast of ULONG to pointer.  */
+    if ((packet_ptr == NX_NULL) || (packet_ptr -> nx_packet_queue_next != ((NX_PACKET *)NX_DRIVER_TX_DONE)))
+    {
+        return(0);
+    }
+
+    /* Setup a pointer to the TCP header of the packet.  */
+    /*lint -e{927} -e{826} suppress cast of pointer to pointer, since it is necessary  */
+    header_ptr =  (NX_TCP_HEADER *)packet_ptr -> nx_packet_prepend_ptr;
+
+    /* Pickup the starting sequence number and header size.  */
+    sequence_number =  header_ptr -> nx_tcp_sequence_number;
+    temp =             header_ptr -> nx_tcp_header_word_3;
+    NX_CHANGE_ULONG_ENDIAN(sequence_number);
+    NX_CHANGE_ULONG_ENDIAN(temp);
+    header_length =  (temp >> NX_TCP_HEADER_SHIFT) * sizeof(ULONG);
+
+    /* Determine if the ACK ends inside the data of the packet.  */
+    trim_length =  acknowledgment_number - sequence_number;
+    if (((INT)trim_length <= 0) || (trim_length >= (packet_ptr -> nx_packet_length - header_length)))
+    {
+
+        /* No, there is nothing to trim.  */
+        return(0);
+    }
+
+    /* Move the TCP header up over the acknowledged data of the first buffer.  Only bytes the
+       peer already has are overwritten.  */
+    work_length =  (ULONG)(packet_ptr -> nx_packet_append_ptr - packet_ptr -> nx_packet_prepend_ptr) - header_length;
+    if (work_length > trim_length)
+    {
+        work_length =  trim_length;
+    }
+    memmove(packet_ptr -> nx_packet_prepend_ptr + work_length, packet_ptr -> nx_packet_prepend_ptr, header_length); /* Use case of memmove is verified. */
+    packet_ptr -> nx_packet_prepend_ptr =  packet_ptr -> nx_packet_prepend_ptr + work_length;
+    remaining_bytes =  trim_length - work_length;
+
+    /* Remove the acknowledged data of the chained buffers, releasing the buffers that are
+       fully acknowledged.  The last buffer always keeps data, so it is never released.  */
+    while (remaining_bytes)
+    {
+        work_ptr =     packet_ptr -> nx_packet_next;
+        work_length =  (ULONG)(work_ptr -> nx_packet_append_ptr - work_ptr -> nx_packet_prepend_ptr);
+        if (work_length > remaining_bytes)
+        {
+
+            /* Keep the rest of the buffer.  */
+            work_ptr -> nx_packet_prepend_ptr =  work_ptr -> nx_packet_prepend_ptr + remaining_bytes;
+            remaining_bytes =  0;
+        }
+        else
+        {
+
+            /* Unlink and release the buffer.  */
+            remaining_bytes =  remaining_bytes - work_length;
+            packet_ptr -> nx_packet_next =  work_ptr -> nx_packet_next;
+            work_ptr -> nx_packet_next =  NX_NULL;
+            _nx_packet_release(work_ptr);
+        }
+    }
+
+    /* The remaining data now starts at the ACK number.  */
+    /*lint -e{927} -e{826} suppress cast of pointer to pointer, since it is necessary  */
+    header_ptr =  (NX_TCP_HEADER *)packet_ptr -> nx_packet_prepend_ptr;
+    header_ptr -> nx_tcp_sequence_number =  acknowledgment_number;
+    NX_CHANGE_ULONG_ENDIAN(header_ptr -> nx_tcp_sequence_number);
+    packet_ptr -> nx_packet_length =  packet_ptr -> nx_packet_length - trim_length;
+
+#ifndef NX_DISABLE_TCP_TX_CHECKSUM
+
+    /* The checksum no longer matches the data, clear it and compute it again when the packet
+       is sent.  */
+    temp =  header_ptr -> nx_tcp_header_word_4;
+    NX_CHANGE_ULONG_ENDIAN(temp);
+    temp =  temp & NX_LOWER_16_MASK;
+    NX_CHANGE_ULONG_ENDIAN(temp);
+    header_ptr -> nx_tcp_header_word_4 =  temp;
+    packet_ptr -> nx_packet_interface_capability_flag |=  NX_INTERFACE_CAPABILITY_TCP_TX_CHECKSUM;
+#endif /* NX_DISABLE_TCP_TX_CHECKSUM */
+
+    /* The trimmed data is no longer outstanding.  */
+    if (socket_ptr -> nx_tcp_socket_tx_outstanding_bytes > trim_length)
+    {
+        socket_ptr -> nx_tcp_socket_tx_outstanding_bytes -=  trim_length;
+    }
+    else
+    {
+        socket_ptr -> nx_tcp_socket_tx_outstanding_bytes =  0;
+    }
+
+    /* Return the number of bytes removed.  */
+    return(trim_length);
+}
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
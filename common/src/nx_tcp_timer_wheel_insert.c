@@ -0,0 +1,130 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+#include "nx_tcp.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_timer_wheel_insert                          PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function places a socket on the TCP timer wheel slot that is   */
+/*    the specified number of fast timer ticks ahead of the current tick. */
+/*    If the socket is already on the wheel, it is moved.  The number of  */
+/*    ticks is limited to one revolution of the wheel; sockets with a     */
+/*    longer timer are simply processed again one revolution later.       */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                IP instance pointer           */
+/*    socket_ptr                            Pointer to TCP socket         */
+/*    ticks                                 Fast timer ticks from now     */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_tcp_timer_wheel_remove            Remove from timer wheel       */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_fast_periodic_processing      Fast TCP periodic processing  */
+/*    _nx_tcp_socket_timer_update           Update socket timers          */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_tcp_timer_wheel_insert(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr, ULONG ticks)
+{
+
+ULONG index;
+
+
+    /* Determine if the socket is already on the timer wheel.  */
+    if (socket_ptr -> nx_tcp_socket_timer_next)
+    {
+
+        /* Yes, remove it first.  */
+        _nx_tcp_timer_wheel_remove(ip_ptr, socket_ptr);
+    }
+
+    /* Limit the number of ticks to one revolution of the wheel.  */
+    if (ticks == 0)
+    {
+        ticks =  1;
+    }
+    else if (ticks > NX_TCP_TIMER_WHEEL_MASK)
+    {
+        ticks =  NX_TCP_TIMER_WHEEL_MASK;
+    }
+
+    /* Remember the tick the socket is to be processed on.  */
+    socket_ptr -> nx_tcp_socket_timer_expiration =  ip_ptr -> nx_ip_tcp_timer_tick + ticks;
+
+    /* Calculate the slot of the timer wheel.  */
+    index =  socket_ptr -> nx_tcp_socket_timer_expiration & NX_TCP_TIMER_WHEEL_MASK;
+
+    /* Determine if the list is NULL.  */
+    if (ip_ptr -> nx_ip_tcp_timer_wheel[index])
+    {
+
+        /* There are already sockets on this list... just add this one
+           to the end.  */
+        socket_ptr -> nx_tcp_socket_timer_next =
+            ip_ptr -> nx_ip_tcp_timer_wheel[index];
+        socket_ptr -> nx_tcp_socket_timer_previous =
+            (ip_ptr -> nx_ip_tcp_timer_wheel[index]) -> nx_tcp_socket_timer_previous;
+        ((ip_ptr -> nx_ip_tcp_timer_wheel[index]) -> nx_tcp_socket_timer_previous) -> nx_tcp_socket_timer_next =
+            socket_ptr;
+        (ip_ptr -> nx_ip_tcp_timer_wheel[index]) -> nx_tcp_socket_timer_previous =   socket_ptr;
+    }
+    else
+    {
+
+        /* Nothing is on this slot.  Add this TCP socket to an empty list.  */
+        socket_ptr -> nx_tcp_socket_timer_next =      socket_ptr;
+        socket_ptr -> nx_tcp_socket_timer_previous =  socket_ptr;
+        ip_ptr -> nx_ip_tcp_timer_wheel[index] =      socket_ptr;
+    }
+}
+
@@ -0,0 +1,121 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   Transmission Control Protocol (TCP)                                 */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+#include "nx_tcp.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_tcp_timer_wheel_remove                          PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function removes a socket from the TCP timer wheel.  It does   */
+/*    nothing if the socket is not on the wheel.                          */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    ip_ptr                                IP instance pointer           */
+/*    socket_ptr                            Pointer to TCP socket         */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    None                                                                */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_tcp_fast_periodic_processing      Fast TCP periodic processing  */
+/*    _nx_tcp_socket_delete                 Delete TCP socket             */
+/*    _nx_tcp_timer_wheel_insert            Insert into timer wheel       */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+VOID  _nx_tcp_timer_wheel_remove(NX_IP *ip_ptr, NX_TCP_SOCKET *socket_ptr)
+{
+
+ULONG index;
+
+
+    /* Determine if the socket is on the timer wheel.  */
+    if (socket_ptr -> nx_tcp_socket_timer_next == NX_NULL)
+    {
+
+        /* No, nothing to do.  */
+        return;
+    }
+
+    /* Calculate the slot of the timer wheel the socket is on.  */
+    index =  socket_ptr -> nx_tcp_socket_timer_expiration & NX_TCP_TIMER_WHEEL_MASK;
+
+    /* Determine if this is the only socket on the list.  */
+    if (socket_ptr == socket_ptr -> nx_tcp_socket_timer_next)
+    {
+
+        /* Yes, this is the only socket on the list.  Clear the list head pointer.  */
+        ip_ptr -> nx_ip_tcp_timer_wheel[index] =  NX_NULL;
+    }
+    else
+    {
+
+        /* Otherwise, there are multiple sockets on this list.  Remove just
+           this socket from the list.  */
+        (socket_ptr -> nx_tcp_socket_timer_previous) -> nx_tcp_socket_timer_next =
+            socket_ptr -> nx_tcp_socket_timer_next;
+        (socket_ptr -> nx_tcp_socket_timer_next) -> nx_tcp_socket_timer_previous =
+            socket_ptr -> nx_tcp_socket_timer_previous;
+
+        /* Determine if the head of the list needs to be updated.  */
+        if (ip_ptr -> nx_ip_tcp_timer_wheel[index] == socket_ptr)
+        {
+
+            /* Yes, update the head pointer.  */
+            ip_ptr -> nx_ip_tcp_timer_wheel[index] =  socket_ptr -> nx_tcp_socket_timer_next;
+        }
+    }
+
+    /* Clear the timer wheel list pointers.  */
+    socket_ptr -> nx_tcp_socket_timer_next =      NX_NULL;
+    socket_ptr -> nx_tcp_socket_timer_previous =  NX_NULL;
+}
+
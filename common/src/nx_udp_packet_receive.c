@@ -74,6 +74,9 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            exact match UDP port cache, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 VOID  _nx_udp_packet_receive(NX_IP *ip_ptr, NX_PACKET *packet_ptr)
@@ -148,107 +151,125 @@ NX_UDP_HEADER *udp_header_ptr;
     /* Calculate the hash index in the UDP port array of the associated IP instance.  */
     index =  (UINT)((port + (port >> 8)) & NX_UDP_PORT_TABLE_MASK);
 
-    /* Determine if the caller is a thread. If so, we should use the protection mutex
-       to avoid having the port list examined while we are traversing it. If this routine
-       is called from an ISR nothing needs to be done since bind/unbind are not allowed
-       from ISRs.  */
-    if ((_tx_thread_current_ptr) && (TX_THREAD_GET_SYSTEM_STATE() == 0))
+#ifdef NX_ENABLE_UDP_PORT_CACHE
+
+    /* Pickup the socket last found for this port from the exact match port cache.  */
+    socket_ptr =  ip_ptr -> nx_ip_udp_port_cache[port & NX_UDP_PORT_CACHE_MASK];
+
+    /* Determine if the cached socket is bound to this port.  If so, the port list
+       does not need to be searched.  */
+    if ((socket_ptr == NX_NULL) || (socket_ptr -> nx_udp_socket_port != port))
+#endif /* NX_ENABLE_UDP_PORT_CACHE */
     {
 
-        /* Get mutex protection.  */
-        tx_mutex_get(&(ip_ptr -> nx_ip_protection), NX_WAIT_FOREVER);
-    }
+        /* Determine if the caller is a thread. If so, we should use the protection mutex
+           to avoid having the port list examined while we are traversing it. If this routine
+           is called from an ISR nothing needs to be done since bind/unbind are not allowed
+           from ISRs.  */
+        if ((_tx_thread_current_ptr) && (TX_THREAD_GET_SYSTEM_STATE() == 0))
+        {
 
-    /* Search the bound sockets in this index for the particular port.  */
-    socket_ptr =  ip_ptr -> nx_ip_udp_port_table[index];
+            /* Get mutex protection.  */
+            tx_mutex_get(&(ip_ptr -> nx_ip_protection), NX_WAIT_FOREVER);
+        }
 
-    /* Determine if there are any sockets bound on this port index.  */
-    if (!socket_ptr)
-    {
+        /* Search the bound sockets in this index for the particular port.  */
+        socket_ptr =  ip_ptr -> nx_ip_udp_port_table[index];
+
+        /* Determine if there are any sockets bound on this port index.  */
+        if (!socket_ptr)
+        {
 
 #ifndef NX_DISABLE_UDP_INFO
 
-        /* Increment the no port for delivery count.  */
-        ip_ptr -> nx_ip_udp_no_port_for_delivery++;
+            /* Increment the no port for delivery count.  */
+            ip_ptr -> nx_ip_udp_no_port_for_delivery++;
 
-        /* Increment the total UDP receive packets dropped count.  */
-        ip_ptr -> nx_ip_udp_receive_packets_dropped++;
+            /* Increment the total UDP receive packets dropped count.  */
+            ip_ptr -> nx_ip_udp_receive_packets_dropped++;
 #endif
 
-        /* Determine if the caller is a thread. If so, release the mutex protection previously setup.  */
-        if ((_tx_thread_current_ptr) && (TX_THREAD_GET_SYSTEM_STATE() == 0))
-        {
-
-            /* Release mutex protection.  */
-            tx_mutex_put(&(ip_ptr -> nx_ip_protection));
-        }
+            /* Determine if the caller is a thread. If so, release the mutex protection previously setup.  */
+            if ((_tx_thread_current_ptr) && (TX_THREAD_GET_SYSTEM_STATE() == 0))
+            {
 
-        /* Release the packet.  */
-        _nx_packet_release(packet_ptr);
+                /* Release mutex protection.  */
+                tx_mutex_put(&(ip_ptr -> nx_ip_protection));
+            }
 
-        /* Just return.  */
-        return;
-    }
+            /* Release the packet.  */
+            _nx_packet_release(packet_ptr);
 
-    /*  Loop to examine the list of bound ports on this index.  */
-    do
-    {
+            /* Just return.  */
+            return;
+        }
 
-        /* Determine if the port has been found.  */
-        if (socket_ptr -> nx_udp_socket_port == port)
+        /*  Loop to examine the list of bound ports on this index.  */
+        do
         {
 
-            /* Yes, we have a match.  */
+            /* Determine if the port has been found.  */
+            if (socket_ptr -> nx_udp_socket_port == port)
+            {
 
-#ifndef NX_DISABLE_UDP_INFO
+                /* Yes, we have a match.  */
 
-            /* Increment the total number of packets received for this socket.  */
-            socket_ptr -> nx_udp_socket_packets_received++;
+#ifdef NX_ENABLE_UDP_PORT_CACHE
 
-            /* Increment the total UDP receive bytes.  */
-            ip_ptr -> nx_ip_udp_bytes_received +=          packet_ptr -> nx_packet_length - sizeof(NX_UDP_HEADER);
-            socket_ptr -> nx_udp_socket_bytes_received +=  packet_ptr -> nx_packet_length - sizeof(NX_UDP_HEADER);
-#endif
+                /* Remember the socket in the exact match port cache.  */
+                ip_ptr -> nx_ip_udp_port_cache[port & NX_UDP_PORT_CACHE_MASK] =  socket_ptr;
+#endif /* NX_ENABLE_UDP_PORT_CACHE */
+
+                /* Get out of the search loop.  */
+                break;
+            }
+            else
+            {
 
-            /* If trace is enabled, insert this event into the trace buffer.  */
-            NX_TRACE_IN_LINE_INSERT(NX_TRACE_INTERNAL_UDP_RECEIVE, ip_ptr, socket_ptr, packet_ptr, udp_header_ptr -> nx_udp_header_word_0, NX_TRACE_INTERNAL_EVENTS, 0, 0)
+                /* Move to the next entry in the bound index.  */
+                socket_ptr =  socket_ptr -> nx_udp_socket_bound_next;
+            }
+        } while (socket_ptr != ip_ptr -> nx_ip_udp_port_table[index]);
 
-            /* Get out of the search loop.  */
-            break;
-        }
-        else
+        /* Determine if the caller is a thread. If so, release the mutex protection previously setup.  */
+        if ((_tx_thread_current_ptr) && (TX_THREAD_GET_SYSTEM_STATE() == 0))
         {
 
-            /* Move to the next entry in the bound index.  */
-            socket_ptr =  socket_ptr -> nx_udp_socket_bound_next;
+            /* Release mutex protection.  */
+            tx_mutex_put(&(ip_ptr -> nx_ip_protection));
         }
-    } while (socket_ptr != ip_ptr -> nx_ip_udp_port_table[index]);
 
-    /* Determine if the caller is a thread. If so, release the mutex protection previously setup.  */
-    if ((_tx_thread_current_ptr) && (TX_THREAD_GET_SYSTEM_STATE() == 0))
-    {
+        /* Determine if a match was found.  */
+        if (socket_ptr -> nx_udp_socket_port != port)
+        {
 
-        /* Release mutex protection.  */
-        tx_mutex_put(&(ip_ptr -> nx_ip_protection));
-    }
+#ifndef NX_DISABLE_UDP_INFO
 
-    /* Determine if a match was found.  */
-    if (socket_ptr -> nx_udp_socket_port != port)
-    {
+            /* Increment the no port for delivery count.  */
+            ip_ptr -> nx_ip_udp_no_port_for_delivery++;
+
+            /* Increment the total UDP receive packets dropped count.  */
+            ip_ptr -> nx_ip_udp_receive_packets_dropped++;
+#endif
+
+            /* No socket structure bound to this port, just release the packet.  */
+            _nx_packet_release(packet_ptr);
+            return;
+        }
+    }
 
 #ifndef NX_DISABLE_UDP_INFO
 
-        /* Increment the no port for delivery count.  */
-        ip_ptr -> nx_ip_udp_no_port_for_delivery++;
+    /* Increment the total number of packets received for this socket.  */
+    socket_ptr -> nx_udp_socket_packets_received++;
 
-        /* Increment the total UDP receive packets dropped count.  */
-        ip_ptr -> nx_ip_udp_receive_packets_dropped++;
+    /* Increment the total UDP receive bytes.  */
+    ip_ptr -> nx_ip_udp_bytes_received +=          packet_ptr -> nx_packet_length - sizeof(NX_UDP_HEADER);
+    socket_ptr -> nx_udp_socket_bytes_received +=  packet_ptr -> nx_packet_length - sizeof(NX_UDP_HEADER);
 #endif
 
-        /* No socket structure bound to this port, just release the packet.  */
-        _nx_packet_release(packet_ptr);
-        return;
-    }
+    /* If trace is enabled, insert this event into the trace buffer.  */
+    NX_TRACE_IN_LINE_INSERT(NX_TRACE_INTERNAL_UDP_RECEIVE, ip_ptr, socket_ptr, packet_ptr, udp_header_ptr -> nx_udp_header_word_0, NX_TRACE_INTERNAL_EVENTS, 0, 0)
 
     /* Disable interrupts.  */
     TX_DISABLE
@@ -0,0 +1,173 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   User Datagram Protocol (UDP)                                        */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_packet.h"
+#include "nx_ip.h"
+#include "nx_udp.h"
+
+
+#ifndef NX_DISABLE_UDP_RX_CHECKSUM
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_udp_socket_checksum_verify                      PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function verifies the UDP checksum of a packet taken from the  */
+/*    receive queue of the socket. A packet with a bad checksum is        */
+/*    released and removed from the receive statistics.                   */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to UDP socket         */
+/*    packet_ptr                            Pointer to UDP packet         */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    NX_TRUE                               Packet is valid               */
+/*    NX_FALSE                              Packet is released            */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_ip_checksum_compute               Compute UDP checksum          */
+/*    _nx_packet_release                    Release data packet           */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    _nx_udp_socket_receive                Receive UDP packet            */
+/*    _nx_udp_socket_receive_batch          Receive UDP packets           */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_udp_socket_checksum_verify(NX_UDP_SOCKET *socket_ptr, NX_PACKET *packet_ptr)
+{
+#ifndef NX_DISABLE_UDP_INFO
+TX_INTERRUPT_SAVE_AREA
+#endif
+
+ULONG  checksum;
+ULONG *temp_ptr;
+
+
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+    /* Determine if the interface has already verified the UDP checksum.  */
+    if (packet_ptr -> nx_packet_ip_interface -> nx_interface_capability_flag & NX_INTERFACE_CAPABILITY_UDP_RX_CHECKSUM)
+    {
+
+        /* Yes, the checksum is okay.  */
+        return(NX_TRUE);
+    }
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
+    /* Determine if we need to compute the UDP checksum.  If it is disabled for this socket
+       or if the UDP packet has a zero in the checksum field (indicating it was not computed
+       by the sender, skip the checksum processing.  */
+    temp_ptr =  (ULONG *)packet_ptr -> nx_packet_prepend_ptr;
+    if ((socket_ptr -> nx_udp_socket_disable_checksum) || (!(*(temp_ptr + 1) & NX_LOWER_16_MASK)))
+    {
+
+        /* Checksum logic is either disabled for this socket or the received
+           UDP packet checksum was not calculated.  */
+        return(NX_TRUE);
+    }
+
+    /* Endian swapping logic.  If NX_LITTLE_ENDIAN is specified, these macros will
+       swap the endian of the UDP header.  */
+    NX_CHANGE_ULONG_ENDIAN(*(temp_ptr));
+    NX_CHANGE_ULONG_ENDIAN(*(temp_ptr + 1));
+
+    /* Compute the sum of the pseudo UDP header and the UDP datagram.  The source and
+       destination IP addresses sit right in front of the UDP header.  */
+    checksum =  _nx_ip_checksum_compute(packet_ptr, NX_IP_UDP, packet_ptr -> nx_packet_length,
+                                        *(temp_ptr - 2), *(temp_ptr - 1));
+
+    /* Endian swapping logic.  If NX_LITTLE_ENDIAN is specified, these macros will
+       swap the endian of the UDP header.  */
+    NX_CHANGE_ULONG_ENDIAN(*(temp_ptr));
+    NX_CHANGE_ULONG_ENDIAN(*(temp_ptr + 1));
+
+    /* Perform the one's complement processing on the checksum.  */
+    checksum =  NX_LOWER_16_MASK & ~checksum;
+
+    /* Determine if it is valid.  */
+    if (checksum == 0)
+    {
+
+        /* The checksum is okay.  */
+        return(NX_TRUE);
+    }
+
+#ifndef NX_DISABLE_UDP_INFO
+
+    /* Disable interrupts.  */
+    TX_DISABLE
+
+    /* Increment the UDP checksum error count.  */
+    (socket_ptr -> nx_udp_socket_ip_ptr) -> nx_ip_udp_checksum_errors++;
+
+    /* Increment the UDP invalid packets error count.  */
+    (socket_ptr -> nx_udp_socket_ip_ptr) -> nx_ip_udp_invalid_packets++;
+
+    /* Increment the UDP checksum error count for this socket.  */
+    socket_ptr -> nx_udp_socket_checksum_errors++;
+
+    /* Decrement the total UDP receive packets count.  */
+    (socket_ptr -> nx_udp_socket_ip_ptr) -> nx_ip_udp_packets_received--;
+
+    /* Decrement the total UDP receive bytes.  */
+    (socket_ptr -> nx_udp_socket_ip_ptr) -> nx_ip_udp_bytes_received -=  packet_ptr -> nx_packet_length - sizeof(NX_UDP_HEADER);
+
+    /* Decrement the total UDP receive packets count.  */
+    socket_ptr -> nx_udp_socket_packets_received--;
+
+    /* Decrement the total UDP receive bytes.  */
+    socket_ptr -> nx_udp_socket_bytes_received -=  packet_ptr -> nx_packet_length - sizeof(NX_UDP_HEADER);
+
+    /* Restore interrupts.  */
+    TX_RESTORE
+#endif
+
+    /* Bad UDP checksum.  Release the packet. */
+    _nx_packet_release(packet_ptr);
+
+    return(NX_FALSE);
+}
+#endif /* NX_DISABLE_UDP_RX_CHECKSUM */
+
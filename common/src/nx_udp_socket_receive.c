@@ -28,6 +28,7 @@
 #include "nx_api.h"
 #include "tx_thread.h"
 #include "nx_packet.h"
+#include "nx_ip.h"
 #include "nx_udp.h"
 
 
@@ -58,7 +59,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
-/*    _nx_packet_release                    Release data packet           */
+/*    _nx_udp_socket_checksum_verify        Verify UDP checksum           */
 /*    _tx_thread_system_suspend             Suspend thread                */
 /*                                                                        */
 /*  CALLED BY                                                             */
@@ -72,23 +73,19 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), used     */
+/*                                            shared checksum engine,     */
+/*                                            supported UDP checksum      */
+/*                                            offload, shared checksum    */
+/*                                            verification with batch     */
+/*                                            receive, resulting in       */
+/*                                            version 6.x                 */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_udp_socket_receive(NX_UDP_SOCKET *socket_ptr, NX_PACKET **packet_ptr, ULONG wait_option)
 {
 TX_INTERRUPT_SAVE_AREA
 
-#ifndef NX_DISABLE_UDP_RX_CHECKSUM
-ULONG      checksum;
-ULONG      length;
-ULONG      temp;
-ULONG     *temp_ptr;
-UCHAR     *word_ptr;
-UCHAR     *pad_ptr;
-ULONG      packet_length;
-ULONG      adjusted_packet_length;
-NX_PACKET *current_packet;
-#endif
 TX_THREAD *thread_ptr;
 
 #ifdef TX_ENABLE_EVENT_TRACE
@@ -233,179 +230,11 @@ ULONG                  trace_timestamp;
 
 #ifndef NX_DISABLE_UDP_RX_CHECKSUM
 
-        /* Determine if we need to compute the UDP checksum.  If it is disabled for this socket
-           or if the UDP packet has a zero in the checksum field (indicating it was not computed
-           by the sender, skip the checksum processing.  */
-        temp_ptr =  (ULONG *)(*packet_ptr) -> nx_packet_prepend_ptr;
-        if ((!socket_ptr -> nx_udp_socket_disable_checksum) && (*(temp_ptr + 1) & NX_LOWER_16_MASK))
-        {
-
-            /* Yes, we need to compute the UDP checksum.  */
-
-            /* First calculate the checksum of the pseudo UDP header that includes the source IP
-               address, destination IP address, protocol word, and the UDP length.  */
-            temp =  *(temp_ptr - 2);
-            checksum =  (temp >> NX_SHIFT_BY_16);
-            checksum += (temp & NX_LOWER_16_MASK);
-            temp =  *(temp_ptr - 1);
-            checksum += (temp >> NX_SHIFT_BY_16);
-            checksum += (temp & NX_LOWER_16_MASK);
-            checksum += (NX_IP_UDP >> NX_SHIFT_BY_16);
-            checksum += (*packet_ptr) -> nx_packet_length;
-
-            /* Endian swapping logic.  If NX_LITTLE_ENDIAN is specified, these macros will
-               swap the endian of the UDP header.  */
-            NX_CHANGE_ULONG_ENDIAN(*(temp_ptr));
-            NX_CHANGE_ULONG_ENDIAN(*(temp_ptr + 1));
-
-            /* Setup the length of the packet checksum. */
-            length = (*packet_ptr) -> nx_packet_length;
-
-            /* Initialize the current packet to the input packet pointer.  */
-            current_packet =  *packet_ptr;
-
-            /* Loop to calculate the packet's checksum.  */
-            while (length)
-            {
-                /* Calculate the current packet length.  */
-                packet_length =  (ULONG)(current_packet -> nx_packet_append_ptr - current_packet -> nx_packet_prepend_ptr);
-
-                /* Make the adjusted packet length evenly divisible by sizeof(ULONG).  */
-                adjusted_packet_length =  ((packet_length + (sizeof(ULONG) - 1)) / sizeof(ULONG)) * sizeof(ULONG);
-
-                /* Determine if we need to add padding bytes.  */
-                if (packet_length < adjusted_packet_length)
-                {
-
-                    /* Calculate how many bytes we need to zero at the end of the packet.  */
-                    temp =  adjusted_packet_length - packet_length;
-
-                    /* Setup temporary pointer to the current packet's append pointer.  */
-                    pad_ptr =  current_packet -> nx_packet_append_ptr;
-
-                    /* Loop to pad current packet with 0s so we don't have to worry about a partial last word.  */
-                    while (temp)
-                    {
-
-                        /* Check for the end of the packet.  */
-                        if (pad_ptr >= current_packet -> nx_packet_data_end)
-                        {
-                            break;
-                        }
-
-                        /* Write a 0. */
-                        *pad_ptr++ =  0;
-
-                        /* Decrease the pad count.  */
-                        temp--;
-                    }
-                }
-
-                /* Setup the pointer to the start of the packet.  */
-                word_ptr =  (UCHAR *)current_packet -> nx_packet_prepend_ptr;
-
-                /* Now loop through the current packet to compute the checksum on this packet.  */
-                while (adjusted_packet_length)
-                {
-
-                    /* Pickup a whole ULONG.  */
-                    temp =  *((ULONG *)word_ptr);
-
-                    /* Endian swapping logic.  If NX_LITTLE_ENDIAN is specified, these macros will
-                       swap the endian of the long word in the message.  */
-                    NX_CHANGE_ULONG_ENDIAN(temp);
-
-                    /* Add upper 16-bits into checksum.  */
-                    checksum =  checksum + (temp >> NX_SHIFT_BY_16);
-
-                    /* Add lower 16-bits into checksum.  */
-                    checksum =  checksum + (temp & NX_LOWER_16_MASK);
-
-                    /* Move the word pointer and decrease the length.  */
-                    word_ptr =  word_ptr + sizeof(ULONG);
-                    adjusted_packet_length = adjusted_packet_length - sizeof(ULONG);
-                }
-
-                /* Adjust the checksum length.  */
-                length =  length - packet_length;
-
-                /* Determine if we are at the end of the current packet.  */
-                if ((length) && (word_ptr >= (UCHAR *)current_packet -> nx_packet_append_ptr) &&
-                    (current_packet -> nx_packet_next))
-                {
-
-                    /* We have crossed the packet boundary.  Move to the next packet
-                       structure.  */
-                    current_packet =  current_packet -> nx_packet_next;
-
-                    /* Setup the new word pointer.  */
-                    word_ptr =  (UCHAR *)current_packet -> nx_packet_prepend_ptr;
-                }
-            }
-
-            /* Endian swapping logic.  If NX_LITTLE_ENDIAN is specified, these macros will
-               swap the endian of the UDP header.  */
-            NX_CHANGE_ULONG_ENDIAN(*(temp_ptr));
-            NX_CHANGE_ULONG_ENDIAN(*(temp_ptr + 1));
-
-            /* Add in the carry bits into the checksum.  */
-            checksum = (checksum >> NX_SHIFT_BY_16) + (checksum & NX_LOWER_16_MASK);
-
-            /* Do it again in case previous operation generates an overflow.  */
-            checksum = (checksum >> NX_SHIFT_BY_16) + (checksum & NX_LOWER_16_MASK);
-
-            /* Perform the one's complement processing on the checksum.  */
-            checksum =  NX_LOWER_16_MASK & ~checksum;
-
-            /* Determine if it is valid.  */
-            if (checksum == 0)
-            {
-
-                /* The checksum is okay, so get out of the loop. */
-                break;
-            }
-            else
-            {
-
-#ifndef NX_DISABLE_UDP_INFO
-
-                /* Disable interrupts.  */
-                TX_DISABLE
-
-                /* Increment the UDP checksum error count.  */
-                (socket_ptr -> nx_udp_socket_ip_ptr) -> nx_ip_udp_checksum_errors++;
-
-                /* Increment the UDP invalid packets error count.  */
-                (socket_ptr -> nx_udp_socket_ip_ptr) -> nx_ip_udp_invalid_packets++;
-
-                /* Increment the UDP checksum error count for this socket.  */
-                socket_ptr -> nx_udp_socket_checksum_errors++;
-
-                /* Decrement the total UDP receive packets count.  */
-                (socket_ptr -> nx_udp_socket_ip_ptr) -> nx_ip_udp_packets_received--;
-
-                /* Decrement the total UDP receive bytes.  */
-                (socket_ptr -> nx_udp_socket_ip_ptr) -> nx_ip_udp_bytes_received -=  (*packet_ptr) -> nx_packet_length - sizeof(NX_UDP_HEADER);
-
-                /* Decrement the total UDP receive packets count.  */
-                socket_ptr -> nx_udp_socket_packets_received--;
-
-                /* Decrement the total UDP receive bytes.  */
-                socket_ptr -> nx_udp_socket_bytes_received -=  (*packet_ptr) -> nx_packet_length - sizeof(NX_UDP_HEADER);
-
-                /* Restore interrupts.  */
-                TX_RESTORE
-#endif
-
-                /* Bad UDP checksum.  Release the packet. */
-                _nx_packet_release(*packet_ptr);
-            }
-        }
-        else
+        /* Determine if the UDP checksum is valid, a packet with a bad checksum is released.  */
+        if (_nx_udp_socket_checksum_verify(socket_ptr, *packet_ptr) == NX_TRUE)
         {
 
-            /* Checksum logic is either disabled for this socket or the received
-               UDP packet checksum was not calculated - get out of the loop.  */
+            /* The checksum is okay, so get out of the loop.  */
             break;
         }
 #else
@@ -0,0 +1,253 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   User Datagram Protocol (UDP)                                        */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_ip.h"
+#include "nx_udp.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_udp_socket_receive_batch                        PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function receives up to the specified number of UDP datagrams  */
+/*    from the socket in one call. The queued datagrams are taken off the */
+/*    receive queue of the socket together, with interrupts disabled only */
+/*    once, and their checksums are verified afterwards. Only the first   */
+/*    datagram is waited for, when none is queued. The source IP address, */
+/*    source port, and receive interface of each datagram are returned    */
+/*    with it, so the application does not need to extract them from the */
+/*    packet.                                                             */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to UDP socket         */
+/*    entry_ptr                             Pointer to array of receive   */
+/*                                            entries                     */
+/*    entry_count                           Number of receive entries     */
+/*    received_count                        Destination for the number of */
+/*                                            datagrams received          */
+/*    wait_option                           Suspension option             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_udp_socket_checksum_verify        Verify UDP checksum           */
+/*    _nx_udp_socket_receive                Receive UDP packet            */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_udp_socket_receive_batch(NX_UDP_SOCKET *socket_ptr, NX_UDP_RECEIVE_ENTRY *entry_ptr, UINT entry_count,
+                                    UINT *received_count, ULONG wait_option)
+{
+TX_INTERRUPT_SAVE_AREA
+
+UINT          status;
+UINT          count;
+UINT          queued;
+UINT          i;
+ULONG        *temp_ptr;
+NX_PACKET    *packet_ptr;
+NX_PACKET    *next_packet_ptr;
+NX_IP        *ip_ptr;
+NX_INTERFACE *interface_ptr;
+
+
+    /* Setup the pointer to the associated IP instance.  */
+    ip_ptr =  socket_ptr -> nx_udp_socket_ip_ptr;
+
+    /* Set the number of datagrams received to zero initially.  */
+    *received_count =  0;
+    count =  0;
+
+    /* Loop until the entries are filled or no more datagrams are queued.  */
+    while (count < entry_count)
+    {
+
+        /* Lockout interrupts.  */
+        TX_DISABLE
+
+        /* Determine if the socket is currently bound.  */
+        if (!socket_ptr ->  nx_udp_socket_bound_next)
+        {
+
+            /* Restore interrupts.  */
+            TX_RESTORE
+
+            /* Determine if any datagram was received.  */
+            if (count == 0)
+            {
+
+                /* No, socket is not bound, return an error message.  */
+                return(NX_NOT_BOUND);
+            }
+
+            /* Return the datagrams already received.  */
+            break;
+        }
+
+        /* Take as many queued datagrams as there are entries left off the receive queue.  */
+        packet_ptr =       socket_ptr -> nx_udp_socket_receive_head;
+        next_packet_ptr =  packet_ptr;
+        queued =           0;
+        while ((next_packet_ptr) && (queued < (entry_count - count)))
+        {
+            next_packet_ptr =  next_packet_ptr -> nx_packet_queue_next;
+            queued++;
+        }
+
+        /* Unlink the datagrams taken.  */
+        socket_ptr -> nx_udp_socket_receive_head =  next_packet_ptr;
+        if (next_packet_ptr == NX_NULL)
+        {
+            socket_ptr -> nx_udp_socket_receive_tail =  NX_NULL;
+        }
+        socket_ptr -> nx_udp_socket_receive_count -=  queued;
+
+        /* Restore interrupts.  */
+        TX_RESTORE
+
+        /* Determine if any datagram was queued.  */
+        if (queued == 0)
+        {
+
+            /* Determine if any datagram was received.  */
+            if (count)
+            {
+
+                /* Yes, return the datagrams already received.  */
+                break;
+            }
+
+            /* No, wait for the first datagram.  */
+            status =  _nx_udp_socket_receive(socket_ptr, &packet_ptr, wait_option);
+
+            /* Determine if a datagram was received.  */
+            if (status != NX_SUCCESS)
+            {
+
+                /* No, return the error status.  */
+                return(status);
+            }
+
+            /* Return the datagram, its checksum is verified and the UDP header removed.  */
+            entry_ptr[count].nx_udp_receive_entry_packet =  packet_ptr;
+            count++;
+
+            /* The datagrams queued meanwhile are returned without suspending again.  */
+            continue;
+        }
+
+        /* Loop to verify the datagrams taken.  */
+        for (i = 0; i < queued; i++)
+        {
+
+            /* Pickup the next datagram before this one is released or returned.  */
+            next_packet_ptr =  packet_ptr -> nx_packet_queue_next;
+
+#ifndef NX_DISABLE_UDP_RX_CHECKSUM
+
+            /* Determine if the UDP checksum is valid, a packet with a bad checksum is released.  */
+            if (_nx_udp_socket_checksum_verify(socket_ptr, packet_ptr) == NX_TRUE)
+#endif /* NX_DISABLE_UDP_RX_CHECKSUM */
+            {
+
+                /* If trace is enabled, insert this event into the trace buffer.  */
+                NX_TRACE_IN_LINE_INSERT(NX_TRACE_UDP_SOCKET_RECEIVE, ip_ptr, socket_ptr, packet_ptr, packet_ptr -> nx_packet_length - sizeof(NX_UDP_HEADER), NX_TRACE_UDP_EVENTS, 0, 0)
+
+                /* Remove the UDP header.  */
+                packet_ptr -> nx_packet_length =       packet_ptr -> nx_packet_length - sizeof(NX_UDP_HEADER);
+                packet_ptr -> nx_packet_prepend_ptr =  packet_ptr -> nx_packet_prepend_ptr + sizeof(NX_UDP_HEADER);
+
+                /* Return the datagram.  */
+                entry_ptr[count].nx_udp_receive_entry_packet =  packet_ptr;
+                count++;
+            }
+
+            /* Move to the next datagram.  */
+            packet_ptr =  next_packet_ptr;
+        }
+    }
+
+    /* Loop to return the source and receive interface of each datagram.  */
+    for (i = 0; i < count; i++)
+    {
+
+        /* Build an address to the UDP payload, the UDP and IP headers sit right in front of it.  */
+        packet_ptr =  entry_ptr[i].nx_udp_receive_entry_packet;
+        temp_ptr =    (ULONG *)packet_ptr -> nx_packet_prepend_ptr;
+
+        /* Return the source port and source IP address of the datagram.  */
+        entry_ptr[i].nx_udp_receive_entry_source_port =  (UINT)(*(temp_ptr - 2) >> NX_SHIFT_BY_16);
+        entry_ptr[i].nx_udp_receive_entry_source_ip =    *(temp_ptr - 4);
+
+        /* Pickup the interface the datagram was received on.  */
+        interface_ptr =  packet_ptr -> nx_packet_ip_interface;
+
+        /* Determine if the datagram was received on a physical interface of this IP instance.  */
+        if ((interface_ptr >= &(ip_ptr -> nx_ip_interface[0])) &&
+            (interface_ptr < &(ip_ptr -> nx_ip_interface[NX_MAX_PHYSICAL_INTERFACES])))
+        {
+
+            /* Yes, return the index of the interface.  */
+            entry_ptr[i].nx_udp_receive_entry_interface_index =  (UINT)(interface_ptr - ip_ptr -> nx_ip_interface);
+        }
+        else
+        {
+
+            /* No, return an invalid interface index.  */
+            entry_ptr[i].nx_udp_receive_entry_interface_index =  0xFFFFFFFF;
+        }
+    }
+
+    /* Return the number of datagrams received.  */
+    *received_count =  count;
+
+    /* Return successful completion.  */
+    return(NX_SUCCESS);
+}
+
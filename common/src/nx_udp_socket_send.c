@@ -58,6 +58,7 @@
 /*                                                                        */
 /*  CALLS                                                                 */
 /*                                                                        */
+/*    _nx_ip_checksum_compute               Compute UDP checksum          */
 /*    _nx_ip_packet_send                    Send the UDP packet over IP   */
 /*    nx_ip_route_find                      Find a suitable outgoing      */
 /*                                            interface.                  */
@@ -75,6 +76,11 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), used     */
+/*                                            shared checksum engine,     */
+/*                                            supported UDP checksum      */
+/*                                            offload, resulting in       */
+/*                                            version 6.x                 */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_udp_socket_send(NX_UDP_SOCKET *socket_ptr, NX_PACKET *packet_ptr,
@@ -84,13 +90,6 @@ TX_INTERRUPT_SAVE_AREA
 
 #ifndef NX_DISABLE_UDP_TX_CHECKSUM
 ULONG          checksum;
-ULONG          length;
-ULONG          temp;
-UCHAR         *word_ptr;
-ULONG          packet_length;
-ULONG          adjusted_packet_length;
-NX_PACKET     *current_packet;
-UCHAR         *pad_ptr;
 #endif
 NX_IP         *ip_ptr;
 NX_UDP_HEADER *udp_header_ptr;
@@ -172,118 +171,39 @@ NX_UDP_HEADER *udp_header_ptr;
 
 #ifndef NX_DISABLE_UDP_TX_CHECKSUM
 
+#ifdef NX_ENABLE_INTERFACE_CAPABILITY
+    /* Determine if the interface computes the UDP checksum.  */
+    if ((!socket_ptr -> nx_udp_socket_disable_checksum) &&
+        (packet_ptr -> nx_packet_ip_interface -> nx_interface_capability_flag & NX_INTERFACE_CAPABILITY_UDP_TX_CHECKSUM))
+    {
+
+        /* Yes, leave the checksum to the interface.  */
+        packet_ptr -> nx_packet_interface_capability_flag |=  NX_INTERFACE_CAPABILITY_UDP_TX_CHECKSUM;
+    }
+    else
+#endif /* NX_ENABLE_INTERFACE_CAPABILITY */
+
     /* Determine if we need to compute the UDP checksum.  */
     if (!socket_ptr -> nx_udp_socket_disable_checksum)
     {
 
         /* Yes, we need to compute the UDP checksum.  */
 
-        /* First calculate the checksum of the pseudo UDP header that includes the source IP
-           address, destination IP address, protocol word, and the UDP length.  */
-        temp =  packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_address;
-        checksum =  (temp >> NX_SHIFT_BY_16);
-        checksum += (temp & NX_LOWER_16_MASK);
-        checksum += (ip_address >> NX_SHIFT_BY_16);
-        checksum += (ip_address & NX_LOWER_16_MASK);
-        checksum += (NX_IP_UDP >> NX_SHIFT_BY_16);
-        checksum += packet_ptr -> nx_packet_length;
+        /* Compute the sum of the pseudo UDP header and the UDP datagram.  */
+        checksum =  _nx_ip_checksum_compute(packet_ptr, NX_IP_UDP, packet_ptr -> nx_packet_length,
+                                            packet_ptr -> nx_packet_ip_interface -> nx_interface_ip_address,
+                                            ip_address);
 
-        /* Setup the length of the packet checksum.  */
-        length =  packet_ptr -> nx_packet_length;
-
-        /* Initialize the current packet to the input packet pointer.  */
-        current_packet =  packet_ptr;
-
-        /* Loop to calculate the packet's checksum.  */
-        while (length)
+        /* A computed checksum of zero is transmitted as all ones.  */
+        checksum =  ~checksum & NX_LOWER_16_MASK;
+        if (checksum == 0)
         {
-            /* Calculate the current packet length.  */
-            packet_length =  (ULONG)(current_packet -> nx_packet_append_ptr - current_packet -> nx_packet_prepend_ptr);
-
-            /* Make the adjusted packet length evenly divisible by sizeof(ULONG).  */
-            adjusted_packet_length =  ((packet_length + (sizeof(ULONG) - 1)) / sizeof(ULONG)) * sizeof(ULONG);
-
-            /* Determine if we need to add padding bytes.  */
-            if (packet_length < adjusted_packet_length)
-            {
-
-                /* Calculate how many bytes we need to zero at the end of the packet.  */
-                temp =  adjusted_packet_length - packet_length;
-
-                /* Setup temporary pointer to the current packet's append pointer.  */
-                pad_ptr =  current_packet -> nx_packet_append_ptr;
-
-                /* Loop to pad current packet with 0s so we don't have to worry about a partial last word.  */
-                while (temp)
-                {
-
-                    /* Check for the end of the packet.  */
-                    if (pad_ptr >= current_packet -> nx_packet_data_end)
-                    {
-                        break;
-                    }
-
-                    /* Write a 0. */
-                    *pad_ptr++ =  0;
-
-                    /* Decrease the pad count.  */
-                    temp--;
-                }
-            }
-
-
-            /* Setup the pointer to the start of the packet.  */
-            word_ptr =  (UCHAR *)current_packet -> nx_packet_prepend_ptr;
-
-            /* Now loop through the current packet to compute the checksum on this packet.  */
-            while (adjusted_packet_length)
-            {
-
-                /* Pickup a whole ULONG.  */
-                temp =  *((ULONG *)word_ptr);
-
-                /* Endian swapping logic.  If NX_LITTLE_ENDIAN is specified, these macros will
-                   swap the endian of the long word in the message.  */
-                NX_CHANGE_ULONG_ENDIAN(temp);
-
-                /* Add upper 16-bits into checksum.  */
-                checksum =  checksum + (temp >> NX_SHIFT_BY_16);
-
-                /* Add lower 16-bits into checksum.  */
-                checksum =  checksum + (temp & NX_LOWER_16_MASK);
-
-                /* Move the word pointer and decrease the length.  */
-                word_ptr =  word_ptr + sizeof(ULONG);
-                adjusted_packet_length = adjusted_packet_length - sizeof(ULONG);
-            }
-
-            /* Adjust the checksum length.  */
-            length =  length - packet_length;
-
-            /* Determine if we are at the end of the current packet.  */
-            if ((length) && (word_ptr >= (UCHAR *)current_packet -> nx_packet_append_ptr) &&
-                (current_packet -> nx_packet_next))
-            {
-
-                /* We have crossed the packet boundary.  Move to the next packet
-                   structure.  */
-                current_packet =  current_packet -> nx_packet_next;
-
-                /* Setup the new word pointer.  */
-                word_ptr =  (UCHAR *)current_packet -> nx_packet_prepend_ptr;
-            }
+            checksum =  NX_LOWER_16_MASK;
         }
 
-        /* Add in the carry bits into the checksum.  */
-        checksum = (checksum >> NX_SHIFT_BY_16) + (checksum & NX_LOWER_16_MASK);
-
-        /* Do it again in case previous operation generates an overflow.  */
-        checksum = (checksum >> NX_SHIFT_BY_16) + (checksum & NX_LOWER_16_MASK);
-
         /* Place the packet in the second word of the UDP header.  */
         NX_CHANGE_ULONG_ENDIAN(udp_header_ptr -> nx_udp_header_word_1);
-        udp_header_ptr -> nx_udp_header_word_1 =  udp_header_ptr -> nx_udp_header_word_1 |
-            (~checksum & NX_LOWER_16_MASK);
+        udp_header_ptr -> nx_udp_header_word_1 =  udp_header_ptr -> nx_udp_header_word_1 | checksum;
         NX_CHANGE_ULONG_ENDIAN(udp_header_ptr -> nx_udp_header_word_1);
     }
 #endif
@@ -0,0 +1,137 @@
+/**************************************************************************/
+/*                                                                        */
+/*       Copyright (c) Microsoft Corporation. All rights reserved.        */
+/*                                                                        */
+/*       This software is licensed under the Microsoft Software License   */
+/*       Terms for Microsoft Azure RTOS. Full text of the license can be  */
+/*       found in the LICENSE file at https://aka.ms/AzureRTOS_EULA       */
+/*       and in the root directory of this software.                      */
+/*                                                                        */
+/**************************************************************************/
+
+
+/**************************************************************************/
+/**************************************************************************/
+/**                                                                       */
+/** NetX Component                                                        */
+/**                                                                       */
+/**   User Datagram Protocol (UDP)                                        */
+/**                                                                       */
+/**************************************************************************/
+/**************************************************************************/
+
+#define NX_SOURCE_CODE
+
+
+/* Include necessary system files.  */
+
+#include "nx_api.h"
+#include "nx_packet.h"
+#include "nx_udp.h"
+
+
+/**************************************************************************/
+/*                                                                        */
+/*  FUNCTION                                               RELEASE        */
+/*                                                                        */
+/*    _nx_udp_socket_send_vector                          PORTABLE C      */
+/*                                                           6.x          */
+/*  AUTHOR                                                                */
+/*                                                                        */
+/*    Yuxin Zhou, Microsoft Corporation                                   */
+/*                                                                        */
+/*  DESCRIPTION                                                           */
+/*                                                                        */
+/*    This function sends the specified application buffers as one UDP    */
+/*    datagram without copying them into packets. The buffers are         */
+/*    referenced from packets of the default packet pool of the IP        */
+/*    instance.                                                           */
+/*                                                                        */
+/*    The buffers must not be modified or reused until the release notify */
+/*    function is called, which happens once the driver has transmitted   */
+/*    the datagram, or once it is dropped. If the send fails, the notify  */
+/*    function is called before this service returns.                     */
+/*                                                                        */
+/*  INPUT                                                                 */
+/*                                                                        */
+/*    socket_ptr                            Pointer to socket             */
+/*    vector_ptr                            Pointer to buffer descriptors */
+/*    vector_count                          Number of buffer descriptors  */
+/*    ip_address                            IP address                    */
+/*    port                                  16-bit UDP port number        */
+/*    release_notify                        Buffer release notify         */
+/*                                            function                    */
+/*    context                               Argument of notify function   */
+/*    wait_option                           Suspension option             */
+/*                                                                        */
+/*  OUTPUT                                                                */
+/*                                                                        */
+/*    status                                Completion status             */
+/*                                                                        */
+/*  CALLS                                                                 */
+/*                                                                        */
+/*    _nx_packet_vector_reference           Reference application buffers */
+/*    _nx_udp_socket_send                   Send UDP packet               */
+/*    _nx_packet_release                    Release data packet           */
+/*                                                                        */
+/*  CALLED BY                                                             */
+/*                                                                        */
+/*    Application Code                                                    */
+/*                                                                        */
+/*  RELEASE HISTORY                                                       */
+/*                                                                        */
+/*    DATE              NAME                      DESCRIPTION             */
+/*                                                                        */
+/*  xx-xx-xxxx     Yuxin Zhou               Initial Version 6.x           */
+/*                                                                        */
+/**************************************************************************/
+UINT  _nx_udp_socket_send_vector(NX_UDP_SOCKET *socket_ptr, NX_PACKET_VECTOR *vector_ptr, UINT vector_count,
+                                 ULONG ip_address, UINT port,
+                                 VOID (*release_notify)(VOID *context), VOID *context, ULONG wait_option)
+{
+#ifdef NX_ENABLE_ZERO_COPY_SEND
+NX_PACKET *packet_ptr;
+UINT       status;
+
+
+    /* Reference the application buffers from a packet chain.  */
+    status =  _nx_packet_vector_reference((socket_ptr -> nx_udp_socket_ip_ptr) -> nx_ip_default_packet_pool,
+                                          &packet_ptr, NX_UDP_PACKET, vector_ptr, vector_count,
+                                          release_notify, context, wait_option);
+
+    /* Determine if the buffers were not referenced.  */
+    if (status != NX_SUCCESS)
+    {
+
+        /* Return the error code from the packet vector reference routine.  */
+        return(status);
+    }
+
+    /* Send the packet chain.  */
+    status =  _nx_udp_socket_send(socket_ptr, packet_ptr, ip_address, port);
+
+    /* Determine if the send failed.  */
+    if (status != NX_SUCCESS)
+    {
+
+        /* Release the packet chain, which notifies the application.  */
+        _nx_packet_release(packet_ptr);
+    }
+
+    /* Return completion status.  */
+    return(status);
+#else
+    NX_PARAMETER_NOT_USED(socket_ptr);
+    NX_PARAMETER_NOT_USED(vector_ptr);
+    NX_PARAMETER_NOT_USED(vector_count);
+    NX_PARAMETER_NOT_USED(ip_address);
+    NX_PARAMETER_NOT_USED(port);
+    NX_PARAMETER_NOT_USED(release_notify);
+    NX_PARAMETER_NOT_USED(context);
+    NX_PARAMETER_NOT_USED(wait_option);
+
+    /* Return an error.  */
+    return(NX_NOT_ENABLED);
+#endif /* NX_ENABLE_ZERO_COPY_SEND */
+}
+
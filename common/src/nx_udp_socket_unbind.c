@@ -74,6 +74,9 @@
 /*  05-19-2020     Yuxin Zhou               Initial Version 6.0           */
 /*  09-30-2020     Yuxin Zhou               Modified comment(s),          */
 /*                                            resulting in version 6.1    */
+/*  xx-xx-xxxx     Yuxin Zhou               Modified comment(s), added    */
+/*                                            exact match UDP port cache, */
+/*                                            resulting in version 6.x    */
 /*                                                                        */
 /**************************************************************************/
 UINT  _nx_udp_socket_unbind(NX_UDP_SOCKET *socket_ptr)
@@ -141,6 +144,15 @@ NX_PACKET     *next_packet_ptr;
     /* Disable interrupts while we unlink the current socket.  */
     TX_DISABLE
 
+#ifdef NX_ENABLE_UDP_PORT_CACHE
+
+    /* Remove the socket from the exact match port cache.  */
+    if (ip_ptr -> nx_ip_udp_port_cache[port & NX_UDP_PORT_CACHE_MASK] == socket_ptr)
+    {
+        ip_ptr -> nx_ip_udp_port_cache[port & NX_UDP_PORT_CACHE_MASK] =  NX_NULL;
+    }
+#endif /* NX_ENABLE_UDP_PORT_CACHE */
+
     /* Determine if this is the only socket bound on this port list.  */
     if (socket_ptr -> nx_udp_socket_bound_next == socket_ptr)
     {
@@ -0,0 +1,310 @@
+/* This is a small check and benchmark of the shared IP checksum engine of the NetX TCP/IP stack.
+   The monitor thread builds packet chains of random length, with buffers that start at odd
+   offsets and hold odd numbers of bytes, and compares the result of _nx_ip_checksum_compute with
+   a byte-wise reference that sums the pseudo header and the data as big-endian 16-bit words.  It
+   then times the checksum of 1460-byte TCP segments at an aligned and an odd offset, next to the
+   byte-wise reference.  Comparing a build with NX_ENABLE_IP_CHECKSUM_SIMD and one without shows
+   the gain of the vector loops.  */
+
+#include   <stdio.h>
+#include   "tx_api.h"
+#include   "nx_api.h"
+#include   "nx_ip.h"
+#include   "nx_tcp.h"
+
+#define     DEMO_STACK_SIZE     2048
+#define     DEMO_CHAINS         1000
+#define     DEMO_MAX_BUFFERS    6
+#define     DEMO_SEGMENT_SIZE   1460
+#define     DEMO_SEGMENTS       10000
+#define     PACKET_SIZE         1536
+#define     POOL_SIZE           ((sizeof(NX_PACKET) + PACKET_SIZE) * 16)
+
+
+/* Define the ThreadX and NetX object control blocks.  */
+
+TX_THREAD               monitor_thread;
+NX_PACKET_POOL          pool_0;
+NX_IP                   ip_0;
+UCHAR                   pool_buffer[POOL_SIZE];
+
+
+/* Define the counters used in the demo application...  */
+
+ULONG                   demo_seed =  1;
+ULONG                   mismatch_counter;
+ULONG                   error_counter;
+
+/* Define thread prototypes.  */
+
+void  monitor_thread_entry(ULONG thread_input);
+void  _nx_ram_network_driver(struct NX_IP_DRIVER_STRUCT *driver_req);
+ULONG demo_random(void);
+ULONG demo_reference_checksum(NX_PACKET *packet_ptr, ULONG protocol, ULONG source_ip, ULONG destination_ip);
+NX_PACKET *demo_chain_build(ULONG buffers, ULONG odd_only);
+
+
+/* Define main entry point.  */
+
+int main()
+{
+
+    /* Enter the ThreadX kernel.  */
+    tx_kernel_enter();
+}
+
+
+/* Define what the initial system looks like.  */
+
+void    tx_application_define(void *first_unused_memory)
+{
+
+CHAR *pointer;
+UINT  status;
+
+
+    /* Setup the working pointer.  */
+    pointer =  (CHAR *)first_unused_memory;
+
+    /* Create the monitor thread.  */
+    tx_thread_create(&monitor_thread, "monitor thread", monitor_thread_entry, 0,
+                     pointer, DEMO_STACK_SIZE,
+                     4, 4, TX_NO_TIME_SLICE, TX_AUTO_START);
+    pointer =  pointer + DEMO_STACK_SIZE;
+
+    /* Initialize the NetX system.  */
+    nx_system_initialize();
+
+    /* Create a packet pool.  */
+    status =  nx_packet_pool_create(&pool_0, "NetX Main Packet Pool", PACKET_SIZE, pool_buffer, POOL_SIZE);
+
+    /* Check for pool creation error.  */
+    if (status)
+    {
+        error_counter++;
+    }
+
+    /* Create an IP instance.  */
+    status = nx_ip_create(&ip_0, "NetX IP Instance 0", IP_ADDRESS(10, 0, 0, 1), 0xFF000000UL, &pool_0, _nx_ram_network_driver,
+                          pointer, 2048, 1);
+    pointer =  pointer + 2048;
+
+    /* Check for IP create errors.  */
+    if (status)
+    {
+        error_counter++;
+    }
+}
+
+
+/* Define the pseudo random sequence used for lengths, offsets and data.  */
+
+ULONG   demo_random(void)
+{
+
+    demo_seed =  demo_seed * 1103515245UL + 12345UL;
+    return((demo_seed >> 16) & 0x7FFF);
+}
+
+
+/* Define the byte-wise reference.  The bytes of the chain are taken one at a time as the high or
+   low half of a big-endian 16-bit word, so buffer boundaries and odd lengths need no special
+   handling.  */
+
+ULONG   demo_reference_checksum(NX_PACKET *packet_ptr, ULONG protocol, ULONG source_ip, ULONG destination_ip)
+{
+
+ULONG      sum =  0;
+ULONG      index =  0;
+NX_PACKET *current_packet;
+UCHAR     *byte_ptr;
+
+
+    /* Sum the pseudo header.  */
+    if ((protocol == NX_IP_TCP) || (protocol == NX_IP_UDP))
+    {
+        sum +=  (source_ip >> 16) + (source_ip & 0xFFFF);
+        sum +=  (destination_ip >> 16) + (destination_ip & 0xFFFF);
+        sum +=  (protocol >> 16);
+        sum +=  packet_ptr -> nx_packet_length;
+    }
+
+    /* Sum the data one byte at a time.  */
+    for (current_packet =  packet_ptr; current_packet; current_packet =  current_packet -> nx_packet_next)
+    {
+        for (byte_ptr =  current_packet -> nx_packet_prepend_ptr; byte_ptr < current_packet -> nx_packet_append_ptr; byte_ptr++)
+        {
+            sum +=  (index++ & 1) ? (ULONG)*byte_ptr : ((ULONG)*byte_ptr << 8);
+        }
+    }
+
+    /* Add in the carry bits.  */
+    while (sum >> 16)
+    {
+        sum =  (sum >> 16) + (sum & 0xFFFF);
+    }
+
+    return(sum);
+}
+
+
+/* Build a chain of the specified number of buffers, each starting at a random offset into its
+   payload area and holding a random number of random bytes.  With odd_only set, every offset
+   and length is odd.  */
+
+NX_PACKET   *demo_chain_build(ULONG buffers, ULONG odd_only)
+{
+
+NX_PACKET *head_packet =  NX_NULL;
+NX_PACKET *last_packet =  NX_NULL;
+NX_PACKET *packet_ptr;
+ULONG      offset;
+ULONG      length;
+ULONG      i;
+
+
+    while (buffers--)
+    {
+
+        /* Allocate a buffer.  */
+        if (nx_packet_allocate(&pool_0, &packet_ptr, NX_RECEIVE_PACKET, NX_NO_WAIT))
+        {
+            error_counter++;
+            break;
+        }
+
+        /* Pick the offset and the length of the data.  */
+        offset =  demo_random() % 8;
+        length =  1 + demo_random() % (ULONG)(packet_ptr -> nx_packet_data_end - packet_ptr -> nx_packet_data_start - 8);
+        if (odd_only)
+        {
+            offset |=  1;
+            length |=  1;
+        }
+
+        /* Fill the buffer.  */
+        packet_ptr -> nx_packet_prepend_ptr =  packet_ptr -> nx_packet_data_start + offset;
+        packet_ptr -> nx_packet_append_ptr =   packet_ptr -> nx_packet_prepend_ptr + length;
+        for (i = 0; i < length; i++)
+        {
+            packet_ptr -> nx_packet_prepend_ptr[i] =  (UCHAR)demo_random();
+        }
+
+        /* Link the buffer to the chain.  */
+        if (head_packet == NX_NULL)
+        {
+            head_packet =  packet_ptr;
+            head_packet -> nx_packet_length =  0;
+        }
+        else
+        {
+            last_packet -> nx_packet_next =  packet_ptr;
+            head_packet -> nx_packet_last =  packet_ptr;
+        }
+        last_packet =  packet_ptr;
+        head_packet -> nx_packet_length +=  length;
+    }
+
+    return(head_packet);
+}
+
+
+/* Define the test threads.  */
+
+void    monitor_thread_entry(ULONG thread_input)
+{
+
+NX_PACKET *packet_ptr;
+ULONG      source_ip =  IP_ADDRESS(10, 0, 0, 1);
+ULONG      destination_ip =  IP_ADDRESS(10, 0, 0, 2);
+ULONG      protocol;
+ULONG      checksum;
+ULONG      start;
+ULONG      aligned_ticks;
+ULONG      odd_ticks;
+ULONG      reference_ticks;
+ULONG      sum =  0;
+UINT       i;
+
+    NX_PARAMETER_NOT_USED(thread_input);
+
+    while (1)
+    {
+
+        /* Compare the engine with the reference on random chains.  */
+        for (i = 0; i < DEMO_CHAINS; i++)
+        {
+
+            /* Build a chain of one to DEMO_MAX_BUFFERS buffers, every fourth one with odd
+               offsets and lengths only.  */
+            packet_ptr =  demo_chain_build(1 + demo_random() % DEMO_MAX_BUFFERS, (i & 3) == 0);
+            if (packet_ptr == NX_NULL)
+            {
+                continue;
+            }
+
+            /* Cycle through TCP, UDP and no pseudo header.  */
+            protocol =  (i % 3 == 0) ? NX_IP_TCP : ((i % 3 == 1) ? NX_IP_UDP : NX_IP_ICMP);
+
+            checksum =  _nx_ip_checksum_compute(packet_ptr, protocol, packet_ptr -> nx_packet_length,
+                                                source_ip, destination_ip);
+            if (checksum != demo_reference_checksum(packet_ptr, protocol, source_ip, destination_ip))
+            {
+                mismatch_counter++;
+            }
+
+            nx_packet_release(packet_ptr);
+        }
+
+        /* Build a single 1460-byte segment.  */
+        if (nx_packet_allocate(&pool_0, &packet_ptr, NX_RECEIVE_PACKET, NX_NO_WAIT))
+        {
+            error_counter++;
+            tx_thread_sleep(NX_IP_PERIODIC_RATE);
+            continue;
+        }
+        packet_ptr -> nx_packet_prepend_ptr =  packet_ptr -> nx_packet_data_start;
+        packet_ptr -> nx_packet_append_ptr =   packet_ptr -> nx_packet_prepend_ptr + DEMO_SEGMENT_SIZE;
+        packet_ptr -> nx_packet_length =       DEMO_SEGMENT_SIZE;
+        for (i = 0; i < DEMO_SEGMENT_SIZE + 1; i++)
+        {
+            packet_ptr -> nx_packet_prepend_ptr[i] =  (UCHAR)demo_random();
+        }
+
+        /* Time the TCP checksum of the segment at an aligned offset.  */
+        start =  tx_time_get();
+        for (i = 0; i < DEMO_SEGMENTS; i++)
+        {
+            sum +=  _nx_tcp_checksum(packet_ptr, source_ip, destination_ip);
+        }
+        aligned_ticks =  tx_time_get() - start;
+
+        /* Time the byte-wise reference on the same segment.  */
+        start =  tx_time_get();
+        for (i = 0; i < DEMO_SEGMENTS; i++)
+        {
+            sum +=  demo_reference_checksum(packet_ptr, NX_IP_TCP, source_ip, destination_ip);
+        }
+        reference_ticks =  tx_time_get() - start;
+
+        /* Time the TCP checksum of the segment at an odd offset.  */
+        packet_ptr -> nx_packet_prepend_ptr++;
+        packet_ptr -> nx_packet_append_ptr++;
+        start =  tx_time_get();
+        for (i = 0; i < DEMO_SEGMENTS; i++)
+        {
+            sum +=  _nx_tcp_checksum(packet_ptr, source_ip, destination_ip);
+        }
+        odd_ticks =  tx_time_get() - start;
+
+        nx_packet_release(packet_ptr);
+
+        /* Print the results.  */
+        printf("%u chains: %lu mismatches; %u %u-byte segments: aligned %lu ticks, odd offset %lu ticks, byte-wise %lu ticks (%lx), %lu errors\n",
+               DEMO_CHAINS, mismatch_counter, DEMO_SEGMENTS, DEMO_SEGMENT_SIZE, aligned_ticks, odd_ticks,
+               reference_ticks, sum & 0xFFFF, error_counter);
+
+        /* Wait a second.  */
+        tx_thread_sleep(NX_IP_PERIODIC_RATE);
+    }
+}
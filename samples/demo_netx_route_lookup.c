@@ -0,0 +1,174 @@
+/* This is a small static route lookup benchmark of the NetX TCP/IP stack.  A number of static
+   routes are added to an IP instance, and the monitor thread then times route lookups for
+   destinations that repeat, as with a few hot flows, and for destinations spread over all routes.
+   NetX must be built with NX_ENABLE_IP_STATIC_ROUTING and an NX_IP_ROUTING_TABLE_SIZE that
+   holds DEMO_ROUTES routes.  Comparing the lookup times of a build with NX_ENABLE_IP_ROUTE_TRIE
+   and one without shows the cost of scanning the routing table.  */
+
+#include   <stdio.h>
+#include   "tx_api.h"
+#include   "nx_api.h"
+#include   "nx_ip.h"
+
+#define     DEMO_STACK_SIZE 2048
+#define     DEMO_ROUTES     200
+#define     DEMO_HOT_FLOWS  8
+#define     DEMO_LOOKUPS    100000
+#define     PACKET_SIZE     1536
+#define     POOL_SIZE       ((sizeof(NX_PACKET) + PACKET_SIZE) * 16)
+
+
+/* Define the ThreadX and NetX object control blocks.  */
+
+TX_THREAD               monitor_thread;
+NX_PACKET_POOL          pool_0;
+NX_IP                   ip_0;
+UCHAR                   pool_buffer[POOL_SIZE];
+
+
+/* Define the routes and counters used in the demo application...  */
+
+ULONG                   route_network[DEMO_ROUTES];
+ULONG                   route_count;
+ULONG                   error_counter;
+
+/* Define thread prototypes.  */
+
+void monitor_thread_entry(ULONG thread_input);
+void _nx_ram_network_driver(struct NX_IP_DRIVER_STRUCT *driver_req);
+
+
+/* Define main entry point.  */
+
+int main()
+{
+
+    /* Enter the ThreadX kernel.  */
+    tx_kernel_enter();
+}
+
+
+/* Define what the initial system looks like.  */
+
+void    tx_application_define(void *first_unused_memory)
+{
+
+CHAR *pointer;
+UINT  status;
+
+
+    /* Setup the working pointer.  */
+    pointer =  (CHAR *)first_unused_memory;
+
+    /* Create the monitor thread.  */
+    tx_thread_create(&monitor_thread, "monitor thread", monitor_thread_entry, 0,
+                     pointer, DEMO_STACK_SIZE,
+                     4, 4, TX_NO_TIME_SLICE, TX_AUTO_START);
+    pointer =  pointer + DEMO_STACK_SIZE;
+
+    /* Initialize the NetX system.  */
+    nx_system_initialize();
+
+    /* Create a packet pool.  */
+    status =  nx_packet_pool_create(&pool_0, "NetX Main Packet Pool", PACKET_SIZE, pool_buffer, POOL_SIZE);
+
+    /* Check for pool creation error.  */
+    if (status)
+    {
+        error_counter++;
+    }
+
+    /* Create an IP instance on the 10.0.0.0/8 network.  */
+    status = nx_ip_create(&ip_0, "NetX IP Instance 0", IP_ADDRESS(10, 0, 0, 1), 0xFF000000UL, &pool_0, _nx_ram_network_driver,
+                          pointer, 2048, 1);
+    pointer =  pointer + 2048;
+
+    /* Check for IP create errors.  */
+    if (status)
+    {
+        error_counter++;
+    }
+}
+
+
+/* Define the test threads.  */
+
+void    monitor_thread_entry(ULONG thread_input)
+{
+
+ULONG         seed =  1;
+ULONG         network;
+ULONG         net_mask;
+ULONG         destination;
+ULONG         next_hop;
+ULONG         start;
+ULONG         hot_ticks;
+ULONG         spread_ticks;
+NX_INTERFACE *interface_ptr;
+UINT          status;
+UINT          i;
+
+    NX_PARAMETER_NOT_USED(thread_input);
+
+    /* Add static routes to networks of /16 to /28 outside of the local network, each through
+       a next hop on the local network.  */
+    for (i = 0; i < DEMO_ROUTES; i++)
+    {
+
+        /* Pick a network with a simple pseudo random sequence.  */
+        seed =      seed * 1103515245UL + 12345UL;
+        network =   IP_ADDRESS(192, 0, 0, 0) | ((seed >> 4) & 0x3FFFFFFF);
+        net_mask =  0xFFFFFFFFUL << (4 + (seed % 13));
+
+        /* Add the route.  */
+        status =  nx_ip_static_route_add(&ip_0, network, net_mask, IP_ADDRESS(10, 0, 0, 2 + (i % 200)));
+
+        /* Check status.  */
+        if (status)
+        {
+
+            /* The routing table is full or static routing is not built in.  */
+            break;
+        }
+
+        /* Remember the network.  */
+        route_network[route_count++] =  network & net_mask;
+    }
+
+    while (1)
+    {
+
+        /* Time lookups of a few hot destinations.  */
+        start =  tx_time_get();
+        for (i = 0; i < DEMO_LOOKUPS; i++)
+        {
+            destination =    route_count ? (route_network[i % DEMO_HOT_FLOWS % route_count] | 1) : IP_ADDRESS(192, 0, 0, 1);
+            interface_ptr =  NX_NULL;
+            if (_nx_ip_route_find(&ip_0, destination, &interface_ptr, &next_hop) != NX_SUCCESS)
+            {
+                error_counter++;
+            }
+        }
+        hot_ticks =  tx_time_get() - start;
+
+        /* Time lookups of destinations spread over all routes.  */
+        start =  tx_time_get();
+        for (i = 0; i < DEMO_LOOKUPS; i++)
+        {
+            destination =    route_count ? (route_network[i % route_count] | 1) : IP_ADDRESS(192, 0, 0, 1);
+            interface_ptr =  NX_NULL;
+            if (_nx_ip_route_find(&ip_0, destination, &interface_ptr, &next_hop) != NX_SUCCESS)
+            {
+                error_counter++;
+            }
+        }
+        spread_ticks =  tx_time_get() - start;
+
+        /* Print the lookup times.  */
+        printf("%lu routes: %lu lookups of %u hot destinations in %lu ticks, of all routes in %lu ticks, %lu errors\n",
+               route_count, (ULONG)DEMO_LOOKUPS, DEMO_HOT_FLOWS, hot_ticks, spread_ticks, error_counter);
+
+        /* Wait a second.  */
+        tx_thread_sleep(NX_IP_PERIODIC_RATE);
+    }
+}
@@ -0,0 +1,202 @@
+/* This is a small TCP connection lookup benchmark of the NetX TCP/IP stack.  The monitor thread
+   places 10, 100, 1000 and 10000 connections on the TCP connection table of an IP instance and
+   times the lookups an incoming segment performs to find the socket of its connection.  Each run
+   is done once with the default table of NX_TCP_CONNECTION_TABLE_SIZE buckets and once with a
+   table resized with nx_tcp_connection_table_resize to one bucket per connection.  The
+   connections share a few local ports and peers, as on a busy server, so only the full 4-tuple
+   spreads them over the table.  */
+
+#include   <stdio.h>
+#include   "tx_api.h"
+#include   "nx_api.h"
+#include   "nx_tcp.h"
+
+#define     DEMO_STACK_SIZE     2048
+#define     DEMO_MAX_SOCKETS    10000
+#define     DEMO_TABLE_BUCKETS  16384
+#define     DEMO_LOOKUPS        100000
+#define     PACKET_SIZE         1536
+#define     POOL_SIZE           ((sizeof(NX_PACKET) + PACKET_SIZE) * 16)
+
+
+/* Define the ThreadX and NetX object control blocks.  */
+
+TX_THREAD               monitor_thread;
+NX_PACKET_POOL          pool_0;
+NX_IP                   ip_0;
+UCHAR                   pool_buffer[POOL_SIZE];
+
+
+/* Define the connections, the resized table and the counters used in the demo application...  */
+
+NX_TCP_SOCKET           demo_sockets[DEMO_MAX_SOCKETS];
+NX_TCP_SOCKET          *demo_table[DEMO_TABLE_BUCKETS];
+ULONG                   error_counter;
+
+/* Define thread prototypes.  */
+
+void  monitor_thread_entry(ULONG thread_input);
+void  _nx_ram_network_driver(struct NX_IP_DRIVER_STRUCT *driver_req);
+ULONG demo_lookup_time(ULONG sockets, VOID *table_memory, ULONG table_size);
+
+
+/* Define main entry point.  */
+
+int main()
+{
+
+    /* Enter the ThreadX kernel.  */
+    tx_kernel_enter();
+}
+
+
+/* Define what the initial system looks like.  */
+
+void    tx_application_define(void *first_unused_memory)
+{
+
+CHAR *pointer;
+UINT  status;
+
+
+    /* Setup the working pointer.  */
+    pointer =  (CHAR *)first_unused_memory;
+
+    /* Create the monitor thread.  */
+    tx_thread_create(&monitor_thread, "monitor thread", monitor_thread_entry, 0,
+                     pointer, DEMO_STACK_SIZE,
+                     4, 4, TX_NO_TIME_SLICE, TX_AUTO_START);
+    pointer =  pointer + DEMO_STACK_SIZE;
+
+    /* Initialize the NetX system.  */
+    nx_system_initialize();
+
+    /* Create a packet pool.  */
+    status =  nx_packet_pool_create(&pool_0, "NetX Main Packet Pool", PACKET_SIZE, pool_buffer, POOL_SIZE);
+
+    /* Check for pool creation error.  */
+    if (status)
+    {
+        error_counter++;
+    }
+
+    /* Create an IP instance.  */
+    status = nx_ip_create(&ip_0, "NetX IP Instance 0", IP_ADDRESS(10, 0, 0, 1), 0xFF000000UL, &pool_0, _nx_ram_network_driver,
+                          pointer, 2048, 1);
+    pointer =  pointer + 2048;
+
+    /* Check for IP create errors.  */
+    if (status)
+    {
+        error_counter++;
+    }
+
+    /* Enable TCP processing for IP instance.  */
+    status =  nx_tcp_enable(&ip_0);
+
+    /* Check for TCP enable errors.  */
+    if (status)
+    {
+        error_counter++;
+    }
+}
+
+
+/* Place the specified number of connections on a table in the supplied memory and time lookups
+   of connections spread over all of them.  */
+
+ULONG   demo_lookup_time(ULONG sockets, VOID *table_memory, ULONG table_size)
+{
+
+NX_TCP_SOCKET *socket_ptr;
+ULONG          start;
+ULONG          ticks;
+ULONG          i;
+
+
+    /* Setup the table.  Only the connection fields of the sockets are used, so the sockets
+       are not created and the resize has nothing to move.  */
+    if (nx_tcp_connection_table_resize(&ip_0, table_memory, table_size))
+    {
+        error_counter++;
+        return(0);
+    }
+
+    /* Place the connections on the table, four local ports each with peers on a /16.  */
+    tx_mutex_get(&(ip_0.nx_ip_protection), TX_WAIT_FOREVER);
+    for (i = 0; i < sockets; i++)
+    {
+        socket_ptr =  &demo_sockets[i];
+        socket_ptr -> nx_tcp_socket_port =          80 + (i & 3);
+        socket_ptr -> nx_tcp_socket_connect_ip =    IP_ADDRESS(192, 168, 0, 0) + (i >> 6);
+        socket_ptr -> nx_tcp_socket_connect_port =  49152 + ((i >> 2) & 15);
+        _nx_tcp_connection_table_insert(&ip_0, socket_ptr);
+    }
+    tx_mutex_put(&(ip_0.nx_ip_protection));
+
+    /* Time lookups of connections spread over all sockets.  */
+    start =  tx_time_get();
+    for (i = 0; i < DEMO_LOOKUPS; i++)
+    {
+        socket_ptr =  &demo_sockets[(i * 7919) % sockets];
+        if (_nx_tcp_connection_table_find(&ip_0, socket_ptr -> nx_tcp_socket_port,
+                                          socket_ptr -> nx_tcp_socket_connect_ip,
+                                          socket_ptr -> nx_tcp_socket_connect_port) != socket_ptr)
+        {
+            error_counter++;
+        }
+    }
+    ticks =  tx_time_get() - start;
+
+    /* Take the connections off the table again.  */
+    tx_mutex_get(&(ip_0.nx_ip_protection), TX_WAIT_FOREVER);
+    for (i = 0; i < sockets; i++)
+    {
+        _nx_tcp_connection_table_remove(&ip_0, &demo_sockets[i]);
+    }
+    tx_mutex_put(&(ip_0.nx_ip_protection));
+
+    return(ticks);
+}
+
+
+/* Define the test threads.  */
+
+void    monitor_thread_entry(ULONG thread_input)
+{
+
+ULONG sockets;
+ULONG buckets;
+ULONG default_ticks;
+ULONG resized_ticks;
+
+    NX_PARAMETER_NOT_USED(thread_input);
+
+    while (1)
+    {
+
+        for (sockets = 10; sockets <= DEMO_MAX_SOCKETS; sockets =  sockets * 10)
+        {
+
+            /* Time lookups with the default table.  */
+            default_ticks =  demo_lookup_time(sockets, ip_0.nx_ip_tcp_connection_table_default,
+                                              sizeof(ip_0.nx_ip_tcp_connection_table_default));
+
+            /* Time lookups with a table of about one bucket per connection.  */
+            buckets =  1;
+            while ((buckets < sockets) && (buckets < DEMO_TABLE_BUCKETS))
+            {
+                buckets =  buckets * 2;
+            }
+            resized_ticks =  demo_lookup_time(sockets, demo_table, buckets * sizeof(NX_TCP_SOCKET *));
+
+            /* Print the lookup times.  */
+            printf("%lu sockets: %lu lookups with %u buckets in %lu ticks, with %lu buckets in %lu ticks, %lu errors\n",
+                   sockets, (ULONG)DEMO_LOOKUPS, NX_TCP_CONNECTION_TABLE_SIZE, default_ticks,
+                   buckets, resized_ticks, error_counter);
+        }
+
+        /* Wait a second.  */
+        tx_thread_sleep(NX_IP_PERIODIC_RATE);
+    }
+}
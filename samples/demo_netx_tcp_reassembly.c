@@ -0,0 +1,341 @@
+/* This is a small TCP reassembly stress benchmark of the NetX TCP/IP stack.  A connection is set up
+   between two IP instances, then the monitor thread fills the receive window of the server socket
+   with segments delivered out of order and times their processing by the receive logic.  Three
+   patterns are replayed: 2% of the segments retransmitted at the end of the window with some
+   duplicates, blocks of 32 segments delivered in reverse order, and a fully shuffled window.
+   NetX must be built with NX_ENABLE_TCP_WINDOW_SCALING for the 1 MB window to be used, otherwise
+   the window the socket is given is filled.  Both builds must define NX_TCP_MAX_OUT_OF_ORDER_PACKETS
+   to at least the number of segments in the window, 1024 for the 1 MB window, so that no segment
+   is dropped.  Comparing the times of a build with NX_ENABLE_TCP_REASSEMBLY_INDEX and one without
+   shows the cost of searching the receive queue.  */
+
+#include   <stdio.h>
+#include   "tx_api.h"
+#include   "nx_api.h"
+#include   "nx_tcp.h"
+
+#define     DEMO_STACK_SIZE     4096
+#define     DEMO_WINDOW         (1024 * 1024)
+#define     DEMO_MSS            1460
+#define     DEMO_MAX_SEGMENTS   (DEMO_WINDOW / DEMO_MSS)
+#define     DEMO_MAX_ENTRIES    (DEMO_MAX_SEGMENTS + (DEMO_MAX_SEGMENTS / 97) + 1)
+#define     DEMO_PATTERNS       3
+#define     PACKET_SIZE         1536
+#define     POOL_SIZE           ((sizeof(NX_PACKET) + PACKET_SIZE) * 64)
+#define     SEGMENT_POOL_SIZE   ((sizeof(NX_PACKET) + PACKET_SIZE) * (DEMO_MAX_ENTRIES + 8))
+
+
+/* Define the ThreadX and NetX object control blocks.  */
+
+TX_THREAD               monitor_thread;
+NX_PACKET_POOL          pool_0;
+NX_PACKET_POOL          segment_pool;
+NX_IP                   ip_0;
+NX_IP                   ip_1;
+NX_TCP_SOCKET           client_socket;
+NX_TCP_SOCKET           server_socket;
+UCHAR                   pool_buffer[POOL_SIZE];
+UCHAR                   segment_pool_buffer[SEGMENT_POOL_SIZE];
+
+
+/* Define the delivery order, the segments and the counters used in the demo application...  */
+
+ULONG                   demo_order[DEMO_MAX_ENTRIES];
+NX_PACKET              *demo_segments[DEMO_MAX_ENTRIES];
+ULONG                   demo_seed =  1;
+ULONG                   error_counter;
+
+/* Define thread prototypes.  */
+
+void  monitor_thread_entry(ULONG thread_input);
+void  _nx_ram_network_driver(struct NX_IP_DRIVER_STRUCT *driver_req);
+ULONG demo_order_build(UINT pattern, ULONG segments);
+ULONG demo_window_replay(ULONG entries);
+
+
+/* Define main entry point.  */
+
+int main()
+{
+
+    /* Enter the ThreadX kernel.  */
+    tx_kernel_enter();
+}
+
+
+/* Define what the initial system looks like.  */
+
+void    tx_application_define(void *first_unused_memory)
+{
+
+CHAR *pointer;
+UINT  status;
+
+
+    /* Setup the working pointer.  */
+    pointer =  (CHAR *)first_unused_memory;
+
+    /* Create the monitor thread.  */
+    tx_thread_create(&monitor_thread, "monitor thread", monitor_thread_entry, 0,
+                     pointer, DEMO_STACK_SIZE,
+                     4, 4, TX_NO_TIME_SLICE, TX_AUTO_START);
+    pointer =  pointer + DEMO_STACK_SIZE;
+
+    /* Initialize the NetX system.  */
+    nx_system_initialize();
+
+    /* Create a packet pool for the stack and one for the replayed segments.  */
+    status =  nx_packet_pool_create(&pool_0, "NetX Main Packet Pool", PACKET_SIZE, pool_buffer, POOL_SIZE);
+    status += nx_packet_pool_create(&segment_pool, "Segment Packet Pool", PACKET_SIZE, segment_pool_buffer, SEGMENT_POOL_SIZE);
+
+    /* Check for pool creation error.  */
+    if (status)
+    {
+        error_counter++;
+    }
+
+    /* Create an IP instance.  */
+    status = nx_ip_create(&ip_0, "NetX IP Instance 0", IP_ADDRESS(1, 2, 3, 4), 0xFFFFFF00UL, &pool_0, _nx_ram_network_driver,
+                          pointer, 2048, 1);
+    pointer =  pointer + 2048;
+
+    /* Create another IP instance.  */
+    status += nx_ip_create(&ip_1, "NetX IP Instance 1", IP_ADDRESS(1, 2, 3, 5), 0xFFFFFF00UL, &pool_0, _nx_ram_network_driver,
+                           pointer, 2048, 1);
+    pointer =  pointer + 2048;
+
+    /* Check for IP create errors.  */
+    if (status)
+    {
+        error_counter++;
+    }
+
+    /* Enable ARP and supply ARP cache memory for both IP instances.  */
+    status =  nx_arp_enable(&ip_0, (void *)pointer, 1024);
+    pointer = pointer + 1024;
+    status += nx_arp_enable(&ip_1, (void *)pointer, 1024);
+    pointer = pointer + 1024;
+
+    /* Enable TCP processing for both IP instances.  */
+    status += nx_tcp_enable(&ip_0);
+    status += nx_tcp_enable(&ip_1);
+
+    /* Check ARP and TCP enable status.  */
+    if (status)
+    {
+        error_counter++;
+    }
+}
+
+
+/* Build the order in which the segments of a window are delivered.  Returns the number of
+   entries, which includes the duplicates.  */
+
+ULONG   demo_order_build(UINT pattern, ULONG segments)
+{
+
+ULONG entries =  0;
+ULONG late =     0;
+ULONG temp;
+ULONG i;
+ULONG j;
+
+
+    switch (pattern)
+    {
+
+    case 0:
+
+        /* Deliver 49 of every 50 segments in order, duplicate every 97th and retransmit the
+           others at the end of the window.  */
+        for (i = 0; i < segments; i++)
+        {
+            if ((i % 50) == 49)
+            {
+                late++;
+                continue;
+            }
+            demo_order[entries++] =  i;
+            if ((i % 97) == 96)
+            {
+                demo_order[entries++] =  i;
+            }
+        }
+        for (i = 0; i < late; i++)
+        {
+            demo_order[entries++] =  i * 50 + 49;
+        }
+        break;
+
+    case 1:
+
+        /* Deliver blocks of 32 segments in reverse order.  */
+        for (i = 0; i < segments; i =  j)
+        {
+            j =  (i + 32 < segments) ? (i + 32) : segments;
+            for (temp = j; temp > i; temp--)
+            {
+                demo_order[entries++] =  temp - 1;
+            }
+        }
+        break;
+
+    default:
+
+        /* Deliver the window fully shuffled.  */
+        for (i = 0; i < segments; i++)
+        {
+            demo_order[i] =  i;
+        }
+        for (i = segments - 1; i > 0; i--)
+        {
+            demo_seed =  demo_seed * 1103515245UL + 12345UL;
+            j =  (demo_seed >> 8) % (i + 1);
+            temp =  demo_order[i];
+            demo_order[i] =  demo_order[j];
+            demo_order[j] =  temp;
+        }
+        entries =  segments;
+        break;
+    }
+
+    return(entries);
+}
+
+
+/* Replay the segments of one window in the built order and return the ticks the receive logic
+   of the server socket took.  */
+
+ULONG   demo_window_replay(ULONG entries)
+{
+
+NX_TCP_HEADER *tcp_header_ptr;
+NX_PACKET     *packet_ptr;
+ULONG          rx_sequence;
+ULONG          start;
+ULONG          ticks;
+ULONG          i;
+
+
+    /* Build the segments ahead of time, with the TCP header in host byte order as the receive
+       logic expects.  */
+    rx_sequence =  server_socket.nx_tcp_socket_rx_sequence;
+    for (i = 0; i < entries; i++)
+    {
+
+        if (nx_packet_allocate(&segment_pool, &packet_ptr, NX_RECEIVE_PACKET, NX_NO_WAIT))
+        {
+            error_counter++;
+            break;
+        }
+
+        tcp_header_ptr =  (NX_TCP_HEADER *)packet_ptr -> nx_packet_prepend_ptr;
+        tcp_header_ptr -> nx_tcp_header_word_0 =          (((ULONG)client_socket.nx_tcp_socket_port) << NX_SHIFT_BY_16) |
+                                                          server_socket.nx_tcp_socket_port;
+        tcp_header_ptr -> nx_tcp_sequence_number =        rx_sequence + demo_order[i] * DEMO_MSS;
+        tcp_header_ptr -> nx_tcp_acknowledgment_number =  server_socket.nx_tcp_socket_tx_sequence;
+        tcp_header_ptr -> nx_tcp_header_word_3 =          NX_TCP_HEADER_SIZE | NX_TCP_ACK_BIT | 0xFFFF;
+        tcp_header_ptr -> nx_tcp_header_word_4 =          0;
+        packet_ptr -> nx_packet_length =      sizeof(NX_TCP_HEADER) + DEMO_MSS;
+        packet_ptr -> nx_packet_append_ptr =  packet_ptr -> nx_packet_prepend_ptr + packet_ptr -> nx_packet_length;
+
+        demo_segments[i] =  packet_ptr;
+    }
+    entries =  i;
+
+    /* Obtain the IP protection, as the IP thread does while it processes received segments.  */
+    tx_mutex_get(&(ip_1.nx_ip_protection), TX_WAIT_FOREVER);
+
+    /* Time the receive logic over the window.  Segments that are not queued are released, as
+       the IP thread does.  */
+    start =  tx_time_get();
+    for (i = 0; i < entries; i++)
+    {
+        if (!_nx_tcp_socket_state_data_check(&server_socket, demo_segments[i]))
+        {
+            nx_packet_release(demo_segments[i]);
+        }
+    }
+    ticks =  tx_time_get() - start;
+
+    /* Release the IP protection.  */
+    tx_mutex_put(&(ip_1.nx_ip_protection));
+
+    /* Drain the receive queue to open the window again.  */
+    while (nx_tcp_socket_receive(&server_socket, &packet_ptr, NX_NO_WAIT) == NX_SUCCESS)
+    {
+        nx_packet_release(packet_ptr);
+    }
+
+    return(ticks);
+}
+
+
+/* Define the test threads.  */
+
+void    monitor_thread_entry(ULONG thread_input)
+{
+
+ULONG segments;
+ULONG entries;
+ULONG expected_sequence;
+ULONG ticks[DEMO_PATTERNS];
+UINT  status;
+UINT  pattern;
+
+    NX_PARAMETER_NOT_USED(thread_input);
+
+    /* Create the server socket with a 1 MB receive window and start listening.  */
+    status =  nx_tcp_socket_create(&ip_1, &server_socket, "Server Socket",
+                                   NX_IP_NORMAL, NX_FRAGMENT_OKAY, NX_IP_TIME_TO_LIVE, DEMO_WINDOW,
+                                   NX_NULL, NX_NULL);
+    status += nx_tcp_server_socket_listen(&ip_1, 80, &server_socket, 5, NX_NULL);
+
+    /* Create the client socket and connect it to the server socket.  */
+    status += nx_tcp_socket_create(&ip_0, &client_socket, "Client Socket",
+                                   NX_IP_NORMAL, NX_FRAGMENT_OKAY, NX_IP_TIME_TO_LIVE, 65535,
+                                   NX_NULL, NX_NULL);
+    status += nx_tcp_client_socket_bind(&client_socket, NX_ANY_PORT, NX_WAIT_FOREVER);
+    status += nx_tcp_client_socket_connect(&client_socket, IP_ADDRESS(1, 2, 3, 5), 80, 5 * NX_IP_PERIODIC_RATE);
+    status += nx_tcp_server_socket_accept(&server_socket, 5 * NX_IP_PERIODIC_RATE);
+
+    /* Check for connection errors.  */
+    if (status)
+    {
+        error_counter++;
+        printf("Connection failed, %lu errors\n", error_counter);
+        return;
+    }
+
+    /* Fill the window the server socket was given.  */
+    segments =  server_socket.nx_tcp_socket_rx_window_current / DEMO_MSS;
+    if (segments > DEMO_MAX_SEGMENTS)
+    {
+        segments =  DEMO_MAX_SEGMENTS;
+    }
+
+    while (1)
+    {
+
+        /* Replay one window of each pattern.  */
+        for (pattern = 0; pattern < DEMO_PATTERNS; pattern++)
+        {
+            entries =  demo_order_build(pattern, segments);
+            expected_sequence =  server_socket.nx_tcp_socket_rx_sequence + segments * DEMO_MSS;
+            ticks[pattern] =  demo_window_replay(entries);
+
+            /* Check that the whole window was reassembled.  */
+            if (server_socket.nx_tcp_socket_rx_sequence != expected_sequence)
+            {
+                error_counter++;
+            }
+        }
+
+        /* Print the processing times.  */
+        printf("%lu segments of %u bytes: late retransmits %lu ticks, reversed blocks %lu ticks, shuffled %lu ticks, %lu errors\n",
+               segments, DEMO_MSS, ticks[0], ticks[1], ticks[2], error_counter);
+
+        /* Wait a second.  */
+        tx_thread_sleep(NX_IP_PERIODIC_RATE);
+    }
+}